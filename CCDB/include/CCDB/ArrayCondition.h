@@ -0,0 +1,113 @@
+/// \file ArrayCondition.h
+/// \brief Definition of the ArrayCondition class
+
+#ifndef ALICEO2_CDB_ARRAYCONDITION_H_
+#define ALICEO2_CDB_ARRAYCONDITION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace AliceO2 {
+namespace CDB {
+
+/// Typed condition payload for the dominant calibration case: one float or
+/// int value per channel. The values live in a single contiguous allocation
+/// aligned to 64 bytes, so a vectorized calibration kernel can load them with
+/// aligned SIMD reads straight from the condition, without any TObject or
+/// per-value indirection. The channel mapping id names the channel numbering
+/// scheme the value order refers to (e.g. the pad ordering of a TPC sector).
+/// The payload serializes to a raw byte blob and travels through the raw-blob
+/// path (ObjectHandler/BackendRiak) instead of ROOT streaming; deserialization
+/// copies the values back into aligned storage, so the alignment guarantee
+/// holds on the receiving side as well.
+class ArrayCondition
+{
+  public:
+    /// guaranteed alignment of the value storage in bytes
+    static const std::size_t kAlignment = 64;
+
+    /// type of the stored values
+    enum ElementType : uint32_t {
+      kFloat = 0,
+      kInt32 = 1
+    };
+
+    /// lightweight view over the stored values, cheap to pass by value
+    template <typename T>
+    struct Span {
+      const T* ptr;
+      std::size_t count;
+
+      const T* begin() const { return ptr; }
+      const T* end() const { return ptr + count; }
+      const T& operator[](std::size_t i) const { return ptr[i]; }
+      std::size_t size() const { return count; }
+    };
+
+    /// Empty payload, fill via deserialize
+    ArrayCondition();
+
+    ArrayCondition(ArrayCondition&&) = default;
+    ArrayCondition& operator=(ArrayCondition&&) = default;
+    ArrayCondition(const ArrayCondition&) = delete;
+    ArrayCondition& operator=(const ArrayCondition&) = delete;
+
+    /// Builds a float payload, copying the values into aligned storage
+    ArrayCondition(const float* values, std::size_t count, const std::string& channelMappingId);
+
+    /// Builds an int payload, copying the values into aligned storage
+    ArrayCondition(const int32_t* values, std::size_t count, const std::string& channelMappingId);
+
+    ElementType getElementType() const { return mElementType; }
+
+    /// Number of stored values (channels)
+    std::size_t getCount() const { return mCount; }
+
+    /// Id of the channel numbering scheme the value order refers to
+    const std::string& getChannelMappingId() const { return mChannelMappingId; }
+
+    /// View over the float values; empty when the payload holds ints
+    Span<float> getFloatValues() const
+    {
+      if (mElementType != kFloat) {
+        return Span<float>{nullptr, 0};
+      }
+      return Span<float>{reinterpret_cast<const float*>(mData), mCount};
+    }
+
+    /// View over the int values; empty when the payload holds floats
+    Span<int32_t> getInt32Values() const
+    {
+      if (mElementType != kInt32) {
+        return Span<int32_t>{nullptr, 0};
+      }
+      return Span<int32_t>{reinterpret_cast<const int32_t*>(mData), mCount};
+    }
+
+    /// Serializes the payload into a raw byte blob for the raw-blob path
+    void serialize(std::string& blob) const;
+
+    /// Rebuilds the payload from a raw byte blob, copying the values into
+    /// aligned storage. Returns false when the blob is not an ArrayCondition
+    /// or truncated, leaving the payload empty
+    bool deserialize(const char* blob, std::size_t size);
+
+  private:
+    /// Allocates aligned storage for the given number of payload bytes
+    void allocate(std::size_t bytes);
+
+    /// Size of one value of the stored type in bytes
+    std::size_t elementSize() const { return sizeof(float); } // float and int32 are both 4 bytes
+
+    ElementType mElementType;       ///< type of the stored values
+    std::size_t mCount;             ///< number of stored values
+    std::string mChannelMappingId;  ///< channel numbering scheme of the value order
+    std::unique_ptr<char[]> mStorage; ///< allocation, oversized by kAlignment
+    char* mData;                    ///< aligned start of the values inside mStorage
+};
+}
+}
+
+#endif
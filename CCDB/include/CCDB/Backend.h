@@ -27,9 +27,32 @@ public:
   /// UnPack
   virtual void UnPack(std::unique_ptr<FairMQMessage> msg) = 0;
 
-  /// Serializes a key (and optionally value) to an std::string using Protocol Buffers
+  /// UnPacks a chunked multipart reply; by default the first part is forwarded
+  /// to the single-message UnPack
+  virtual void UnPack(std::vector<std::unique_ptr<FairMQMessage>> msgs);
+
+  /// UnPacks a multiplexed reply to a multi-key request; only meaningful for
+  /// backends supporting batched requests
+  virtual void UnPackMultiple(std::unique_ptr<FairMQMessage> msg);
+
+  /// Serializes a key (and optionally value) to an std::string using Protocol Buffers;
+  /// zip and chunkSize ask the server for a zlib-compressed and/or chunked reply
+  /// (left out of the message when neither is requested, keeping the single-message reply)
   void Serialize(std::string*& messageString, const std::string& key, const std::string& operationType,
-                 const std::string& dataSource, const std::string& object = std::string());
+                 const std::string& dataSource, const std::string& object = std::string(), bool zip = false,
+                 int chunkSize = 0);
+
+  /// Serializes a vector of keys into one request message using Protocol Buffers;
+  /// the reply is expected to multiplex the matching values in the same order
+  /// (see UnPackMultiple)
+  void Serialize(std::string*& messageString, const std::vector<std::string>& keys,
+                 const std::string& operationType, const std::string& dataSource);
+
+  /// Compresses uncompressed_string to compressed_string using zlib
+  static void Compress(const std::string& uncompressed_string, std::string& compressed_string);
+
+  /// Decompresses compressed_string to uncompressed_string using zlib
+  static void Decompress(std::string& uncompressed_string, const std::string& compressed_string);
 };
 }
 }
@@ -25,6 +25,10 @@ public:
 
   /// Parses an incoming message from the CCDB server and prints the metadata of the included object
   void UnPack(std::unique_ptr<FairMQMessage> msg);
+
+  /// Parses a chunked reply from the CCDB server: a ReplyHeader part followed by the
+  /// (optionally zlib-compressed) payload chunks
+  void UnPack(std::vector<std::unique_ptr<FairMQMessage>> msgs);
 };
 }
 }
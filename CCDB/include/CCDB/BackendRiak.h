@@ -16,12 +16,6 @@ private:
   /// Deserializes a message and stores the value to an std::string using Protocol Buffers
   void Deserialize(const std::string& messageString, std::string& object);
 
-  /// Compresses uncompressed_string to compressed_string using zlib
-  void Compress(const std::string& uncompressed_string, std::string& compressed_string);
-
-  /// Decompresses compressed_string to uncompressed_string using zlib
-  void Decompress(std::string& uncompressed_string, const std::string& compressed_string);
-
 public:
   BackendRiak();
   virtual ~BackendRiak(){};
@@ -31,6 +25,10 @@ public:
 
   /// Deserializes and uncompresses an incoming message from the CCDB server
   void UnPack(std::unique_ptr<FairMQMessage> msg);
+
+  /// Deserializes and uncompresses a multiplexed reply carrying one value per
+  /// requested key
+  void UnPackMultiple(std::unique_ptr<FairMQMessage> msg);
 };
 }
 }
@@ -0,0 +1,78 @@
+#ifndef ALICEO2_CDB_CONDITIONDELTA_H_
+#define ALICEO2_CDB_CONDITIONDELTA_H_
+
+//  class ConditionDelta                                           //
+//  binary diff between two versions of a stored condition object  //
+#include "Rtypes.h"
+#include "TObject.h"
+#include "TString.h"
+#include <string>
+#include <vector>
+
+namespace AliceO2 {
+namespace CDB {
+
+/// One stored version of a condition object expressed as a binary diff
+/// against a predecessor version, see LocalStorage::setUseDeltas. A delta
+/// with chain length 0 carries the full serialized object and anchors a
+/// chain; every later version references its predecessor file and carries
+/// only the differing bytes, so run-boundary updates changing few values
+/// cost little storage. The diff is a sequence of copy ranges from the base
+/// and literal byte runs, found by greedy matching of fixed-size base
+/// blocks through a hash table, and is independent of the meaning of the
+/// bytes. A checksum of the base bytes guards every application of a diff
+class ConditionDelta : public TObject
+{
+
+  public:
+    ConditionDelta();
+
+    ConditionDelta(const char *baseFile, Int_t chainLength, const std::string &delta, UInt_t baseChecksum);
+
+    virtual ~ConditionDelta();
+
+    /// File name of the predecessor version within the same path directory,
+    /// empty for a chain anchor
+    const TString &getBaseFile() const
+    {
+      return mBaseFile;
+    }
+
+    /// Number of diffs between this version and the chain anchor
+    Int_t getChainLength() const
+    {
+      return mChainLength;
+    }
+
+    /// Checksum of the base bytes the diff was computed against
+    UInt_t getBaseChecksum() const
+    {
+      return mBaseChecksum;
+    }
+
+    /// The diff, or the full serialized object for a chain anchor
+    const std::vector<char> &getDelta() const
+    {
+      return mDelta;
+    }
+
+    /// Computes the diff turning base into object
+    static void encode(const std::string &base, const std::string &object, std::string &delta);
+
+    /// Applies a diff to the base bytes; returns kFALSE on a malformed diff
+    static Bool_t apply(const std::string &base, const std::string &delta, std::string &object);
+
+    /// Checksum used to validate the base of a diff before application
+    static UInt_t checksum(const std::string &bytes);
+
+  private:
+    TString mBaseFile;          ///< predecessor file name, empty for a chain anchor
+    Int_t mChainLength;         ///< diffs between this version and the chain anchor
+    UInt_t mBaseChecksum;       ///< checksum of the base bytes of the diff
+    std::vector<char> mDelta;   ///< diff against the base, or the full object for an anchor
+
+  ClassDef(ConditionDelta, 1)
+};
+}
+}
+#endif
@@ -0,0 +1,69 @@
+/// \file ConditionShmCache.h
+/// \brief Definition of the ConditionShmCache class
+
+#ifndef ALICEO2_CDB_CONDITIONSHMCACHE_H_
+#define ALICEO2_CDB_CONDITIONSHMCACHE_H_
+
+#include "Rtypes.h"   // for Int_t, Bool_t, UInt_t
+#include "TString.h"  // for TString
+
+namespace AliceO2 {
+namespace CDB {
+
+class Condition;
+
+class ConditionId;
+
+/// Node-local shared-memory cache for condition objects, shared between all the
+/// Manager instances running on one node. The first process asking for a
+/// condition serializes it into a POSIX shared-memory segment named after the
+/// condition path; the identical workers of the same node then deserialize from
+/// that segment instead of downloading and parsing the object again. The
+/// segment header carries the run range and version of the stored object plus a
+/// reference count of the attached readers: a reader finding the requested run
+/// outside the stored validity unlinks the stale segment (the memory itself is
+/// reclaimed by the kernel once the last mapping is gone) so the next query
+/// republishes a fresh object.
+/// Publication is race-free by construction: the creator opens the segment
+/// exclusively and flags it complete only after the payload is fully written,
+/// concurrent readers treat an incomplete segment as a miss
+class ConditionShmCache
+{
+  public:
+    ConditionShmCache();
+
+    ~ConditionShmCache() = default;
+
+    /// Looks the condition up in shared memory; returns a newly deserialized
+    /// Condition owned by the caller or NULL when the segment is missing, still
+    /// being written, or stale for the queried run (stale segments are unlinked)
+    Condition *getCondition(const ConditionId &queryId);
+
+    /// Publishes the condition into shared memory; returns kFALSE when another
+    /// process already created the segment or the segment could not be written
+    Bool_t publishCondition(Condition *entry);
+
+    /// Number of objects this process deserialized from shared memory
+    Int_t getNumberOfHits() const
+    {
+      return mNumberOfHits;
+    }
+
+    /// Number of objects this process published into shared memory
+    Int_t getNumberOfPublished() const
+    {
+      return mNumberOfPublished;
+    }
+
+    /// Builds the shared-memory segment name for the condition path: one segment
+    /// per path and per user, so concurrent users of one node do not collide
+    static TString getSegmentName(const TString &pathString);
+
+  private:
+    Int_t mNumberOfHits;      ///< objects deserialized from shared memory by this process
+    Int_t mNumberOfPublished; ///< objects published into shared memory by this process
+};
+}
+}
+
+#endif
@@ -30,6 +30,9 @@ private:
   std::string fOperationType;
   std::string fDataSource;
   std::string fObjectPath;
+  bool fCompress;  // request zlib-compressed payloads from the server
+  int fChunkSize;  // requested reply chunk size in bytes, 0: single chunk
+  bool fBatch;     // fetch all keys in one multi-key request (Riak only)
 
 };
 }
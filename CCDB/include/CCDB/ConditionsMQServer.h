@@ -8,6 +8,8 @@
 #ifndef ALICEO2_CDB_CONDITIONSMQSERVER_H_
 #define ALICEO2_CDB_CONDITIONSMQSERVER_H_
 
+#include <map>
+#include <memory>
 #include <string>
 
 #include "CCDB/Manager.h"
@@ -29,13 +31,25 @@ public:
 private:
   Manager* fCdbManager;
 
-  void getFromOCDB(std::string key);
+  /// Cache of ROOT-serialized condition payloads, keyed by the condition identifier
+  /// and the compression variant: repeated requests for the same object skip the
+  /// OCDB query and the re-serialization entirely
+  std::map<std::string, std::shared_ptr<const std::string>> fBlobCache;
+
+  /// Replies on the data-get channel with the condition for the key; chunkSize < 0
+  /// means the client did not negotiate chunking and gets a single plain message
+  void getFromOCDB(std::string key, bool zip, int chunkSize);
+
+  /// Returns the serialized (and optionally zlib-compressed) condition for the key,
+  /// serving repeated requests from the blob cache
+  std::shared_ptr<const std::string> getSerializedBlob(const std::string& key, bool zip);
 
   /// Parses a serialized message for a data source entry
   void ParseDataSource(std::string& dataSource, const std::string& data);
 
-  /// Deserializes a message and stores the value to an std::string using Protocol Buffers
-  void Deserialize(const std::string& messageString, std::string& key);
+  /// Deserializes a message, storing the key and the reply options requested by the
+  /// client; chunkSize is set to -1 when the client did not negotiate chunking
+  void Deserialize(const std::string& messageString, std::string& key, bool& zip, int& chunkSize);
 };
 }
 }
@@ -5,6 +5,8 @@
 #include "Rtypes.h"   // for Bool_t, Int_t, ClassDef, kFALSE, etc
 #include "CCDB/Storage.h"  // for Storage
 #include "TString.h"  // for TString
+#include <map>        // for map
+#include <string>     // for string
 
 class TFile;  // lines 8-8
 class TList;
@@ -17,6 +19,18 @@ namespace AliceO2 { namespace CDB { class IdRunRange; }}
 namespace AliceO2 {
 namespace CDB {
 
+/// Read-only view into a memory-mapped raw blob, see FileStorage::getRawBlobSpan.
+/// The memory belongs to the storage and stays valid until it is destroyed
+template <typename T>
+struct RawBlobSpan {
+    RawBlobSpan() : data(0), count(0)
+    {
+    }
+
+    const T *data;  ///< first element of the mapped array
+    Long64_t count; ///< number of elements
+};
+
 class FileStorage : public Storage
 {
     friend class FileStorageFactory;
@@ -38,6 +52,36 @@ class FileStorage : public Storage
 
     virtual void setRetry(Int_t /* nretry */, Int_t /* initsec */);
 
+    /// Element types storable as raw blobs
+    enum ERawBlobType {
+      kRawBlobChar = 1,
+      kRawBlobShort = 2,
+      kRawBlobInt = 3,
+      kRawBlobFloat = 4,
+      kRawBlobDouble = 5
+    };
+
+    /// Stores a flat typed array as a raw blob: a small header followed by the
+    /// bare array in a plain file next to the FileStorage file. Raw blobs are
+    /// meant for large plain-array payloads (pedestals, gain maps) that are
+    /// read back by mmap without constructing ROOT objects
+    template <typename T> Bool_t putRawBlob(const char *key, const T *data, Long64_t count)
+    {
+      return storeRawBlob(key, data, count, rawBlobType((T) 0), sizeof(T));
+    }
+
+    /// Memory-maps the raw blob stored under the key and returns a typed view
+    /// into it; no bytes are copied or deserialized. Returns kFALSE if the blob
+    /// does not exist or was stored with another element type
+    template <typename T> Bool_t getRawBlobSpan(const char *key, RawBlobSpan<T> &span)
+    {
+      Long64_t count = 0;
+      const void *data = mapRawBlob(key, rawBlobType((T) 0), sizeof(T), count);
+      span.data = static_cast<const T *>(data);
+      span.count = count;
+      return data != 0;
+    }
+
   protected:
     virtual Condition *getCondition(const ConditionId &query);
 
@@ -75,9 +119,58 @@ class FileStorage : public Storage
 
     void getEntriesForLevel1(const ConditionId &query, TList *result);
 
+    static Int_t rawBlobType(Char_t)
+    {
+      return kRawBlobChar;
+    }
+
+    static Int_t rawBlobType(Short_t)
+    {
+      return kRawBlobShort;
+    }
+
+    static Int_t rawBlobType(Int_t)
+    {
+      return kRawBlobInt;
+    }
+
+    static Int_t rawBlobType(Float_t)
+    {
+      return kRawBlobFloat;
+    }
+
+    static Int_t rawBlobType(Double_t)
+    {
+      return kRawBlobDouble;
+    }
+
+    // one active raw blob mapping, see mapRawBlob
+    struct RawBlobMapping {
+      void *address;      ///< start of the mapping (the file header)
+      Long64_t length;    ///< mapped length in bytes
+      Int_t type;         ///< stored element type
+      Int_t elementSize;  ///< stored element size
+      Long64_t count;     ///< stored element count
+    };
+
+    /// Writes the blob file for putRawBlob
+    Bool_t storeRawBlob(const char *key, const void *data, Long64_t count, Int_t type, Int_t elementSize);
+
+    /// Memory-maps the blob file for getRawBlobSpan, reusing an existing mapping;
+    /// returns the payload address or NULL
+    const void *mapRawBlob(const char *key, Int_t type, Int_t elementSize, Long64_t &count);
+
+    /// Returns the file name the blob of the key is stored under
+    TString rawBlobFilename(const char *key) const;
+
+    /// Releases all active raw blob mappings
+    void unmapRawBlobs();
+
     TFile *mFile;     // FileStorage file
     Bool_t mReadOnly; // ReadOnly flag
 
+    std::map<std::string, RawBlobMapping> mRawBlobMappings; //! active raw blob mappings per key
+
   ClassDef(FileStorage, 0)
 };
 
@@ -51,6 +51,14 @@ class GridStorage : public Storage
       return mMirrorSEs;
     }
 
+    /// Downloads the files of all objects valid for the current run into the
+    /// local cache folder, transferring up to maxParallel files concurrently
+    /// over the established grid connection instead of one by one on first
+    /// access. Files already complete in the cache are skipped and running
+    /// transfers are staged as .part files, so an interrupted population is
+    /// resumed by calling again. Returns the number of files downloaded
+    Int_t downloadValidFiles(Int_t maxParallel = 4);
+
   protected:
     virtual Condition *getCondition(const ConditionId &queryId);
 
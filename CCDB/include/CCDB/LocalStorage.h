@@ -7,6 +7,9 @@
 #include "Rtypes.h"   // for Bool_t, Int_t, ClassDef, LocalStorage::Class, etc
 #include "CCDB/Storage.h"  // for Storage
 #include "TString.h"  // for TString
+#include <map>        // for map
+#include <string>     // for string
+#include <vector>     // for vector
 
 class TList;
 
@@ -39,6 +42,67 @@ class LocalStorage : public Storage
 
     virtual void setRetry(Int_t /* nretry */, Int_t /* initsec */);
 
+    /// Enables the persistent catalog index: a compact file in the storage root
+    /// mapping path + run range + version to the stored files, consulted instead
+    /// of listing the directories (which takes seconds per path on NFS-mounted
+    /// storages with many files). A path whose directory mtime changed since the
+    /// catalog was built is rescanned and the catalog rewritten automatically
+    void setUseCatalog(Bool_t useCatalog = kTRUE)
+    {
+      mUseCatalog = useCatalog;
+    }
+
+    Bool_t getUseCatalog() const
+    {
+      return mUseCatalog;
+    }
+
+    /// Enables delta storage of new versions: when a predecessor version for
+    /// the same path and run range exists, putCondition stores only a binary
+    /// diff against it and getCondition reconstructs the object transparently.
+    /// Versions anchoring a diff chain keep the full object next to the exact
+    /// serialized bytes, so delta-unaware readers can still open them; once a
+    /// chain reaches the limit (setDeltaChainLimit) the next version is
+    /// automatically stored full again and starts a new chain
+    void setUseDeltas(Bool_t useDeltas = kTRUE)
+    {
+      mUseDeltas = useDeltas;
+    }
+
+    Bool_t getUseDeltas() const
+    {
+      return mUseDeltas;
+    }
+
+    /// Longest accepted diff chain before the next version is rebased
+    void setDeltaChainLimit(Int_t limit)
+    {
+      mDeltaChainLimit = limit < 1 ? 1 : limit;
+    }
+
+    Int_t getDeltaChainLimit() const
+    {
+      return mDeltaChainLimit;
+    }
+
+    /// Enables the sharded layout: files are stored in run-range bucket
+    /// subdirectories of the path directory (shard_N for ranges within bucket
+    /// N = firstRun/size, shard_wide for ranges spanning several buckets),
+    /// each described by a sorted manifest. Queries then read the manifest of
+    /// the queried bucket plus the wide shard instead of decoding every
+    /// filename of the path, so their cost scales with the shard size and not
+    /// with the number of versions accumulated over a campaign.
+    /// 0 (the default) keeps the flat layout
+    void setShardSize(Int_t runsPerShard)
+    {
+      mShardSize = runsPerShard < 0 ? 0 : runsPerShard;
+    }
+
+    Int_t getShardSize() const
+    {
+      return mShardSize;
+    }
+
   protected:
     virtual Condition *getCondition(const ConditionId &queryId);
 
@@ -74,8 +138,74 @@ class LocalStorage : public Storage
 
     void getEntriesForLevel1(const char *level0, const char *Level1, const ConditionId &query, TList *result);
 
+    // one stored file in the catalog index, see setUseCatalog
+    struct CatalogEntry {
+      Int_t firstRun;   ///< first run of the file validity
+      Int_t lastRun;    ///< last run of the file validity
+      Int_t version;    ///< version from the filename
+      Int_t subVersion; ///< subversion from the filename
+    };
+
+    /// Same as getId but resolved from the catalog index instead of a directory listing
+    ConditionId *getIdFromCatalog(const ConditionId &query);
+
+    /// Resolution core shared by the catalog index and the shard manifests:
+    /// applies the getId rules to a list of entries sorted by first run
+    ConditionId *resolveFromEntries(const ConditionId &query, const std::vector<CatalogEntry> &entries);
+
+    /// Shard subdirectory (within the path directory) holding files of the
+    /// run range; empty string when sharding is off, see setShardSize
+    TString shardDirectory(const IdRunRange &runRange) const;
+
+    /// Collects the manifest entries of the shards a query of the run range
+    /// must examine (the buckets it touches plus the wide shard), sorted by
+    /// first run; kFALSE if the path directory does not exist
+    Bool_t getShardEntries(const TString &pathString, const IdRunRange &runRange, std::vector<CatalogEntry> &entries);
+
+    /// Reads the manifest of one shard, rescanning the shard directory and
+    /// rewriting the manifest if the directory mtime changed
+    void loadShardManifest(const TString &pathString, const TString &shard, std::vector<CatalogEntry> &entries);
+
+    /// Returns the catalog entries for the path, rescanning the directory if its
+    /// mtime changed since the catalog was built; NULL if the directory does not exist
+    const std::vector<CatalogEntry> *getCatalogForPath(const TString &pathString);
+
+    /// Lists the directory of the path into entries, sorted by run/version
+    void scanDirectoryForCatalog(const TString &pathString, std::vector<CatalogEntry> &entries);
+
+    /// Reads the catalog file of this storage root
+    void loadCatalogFile();
+
+    /// Rewrites the catalog file of this storage root
+    void saveCatalogFile() const;
+
+    /// Writes the delta-mode file of the entry, see setUseDeltas
+    Bool_t putConditionDelta(Condition *entry, const ConditionId &id, const TString &filename);
+
+    /// Reconstructs the condition of a delta-mode file through its chain
+    Condition *getConditionFromDelta(const TString &filename);
+
+    /// Serialized bytes of the condition stored in the file, reconstructed
+    /// through the delta chain if needed; chainLength returns the number of
+    /// diffs between the file and its chain anchor
+    Bool_t readConditionBytes(const TString &filename, std::string &bytes, Int_t &chainLength);
+
+    /// File name (within the path directory) of the latest stored version a
+    /// new object of the id would be diffed against, kFALSE if none exists
+    Bool_t latestVersionFile(const ConditionId &id, TString &keyName);
+
     TString mBaseDirectory; // path of the DB folder
 
+    Bool_t mUseDeltas;      //! delta storage of new versions enabled
+    Int_t mDeltaChainLimit; //! longest diff chain before a rebase
+
+    Int_t mShardSize; //! runs per shard bucket, 0 = flat layout
+
+    Bool_t mUseCatalog;    //! answer queries from the catalog index
+    Bool_t mCatalogLoaded; //! catalog file has been read
+    std::map<std::string, std::vector<CatalogEntry>> mCatalog; //! catalog entries per path
+    std::map<std::string, Long_t> mCatalogMtime;               //! directory mtime at catalog build per path
+
   ClassDef(LocalStorage, 0) // access class to a DataBase in a local storage
 };
 
@@ -7,6 +7,11 @@
 #include <stddef.h>   // for NULL
 #include "Rtypes.h"   // for Int_t, Bool_t, kFALSE, kTRUE, ClassDef, etc
 #include "TString.h"  // for TString
+#include <map>        // for map
+#include <string>     // for string
+#include <unordered_map> // for unordered_map
+#include <utility>    // for pair
+#include <vector>     // for vector
 
 class TFile;
 namespace AliceO2 { namespace CDB { class Condition; }}  // lines 20-20
@@ -31,8 +36,12 @@ namespace CDB {
 /// different storages (local, alien, file)
 class Condition;
 
+class ConditionCacheIndex;
+
 class ConditionId;
 
+class ConditionShmCache;
+
 class IdPath;
 
 class IdRunRange;
@@ -123,6 +132,12 @@ class Manager : public TObject
       return mOcdbUploadMode;
     }
 
+    /// Concurrently callable: cache hits are resolved through a sharded
+    /// reader-writer index without any global lock, and on a miss only the
+    /// Manager bookkeeping is serialized while the storage query itself runs
+    /// in parallel. Callers driving it from several threads should have
+    /// called ROOT::EnableThreadSafety(); the configuration calls (setRun,
+    /// setDefaultStorage, clearCache, ...) remain single-threaded
     Condition *getObject(const ConditionId &query, Bool_t forceCaching = kFALSE);
 
     Condition *getObject(const IdPath &path, Int_t runNumber = -1, Int_t version = -1, Int_t subVersion = -1);
@@ -131,6 +146,37 @@ class Manager : public TObject
 
     Condition *getConditionFromSnapshot(const char *path);
 
+    /// Resolves and loads the objects for the given paths concurrently on a small
+    /// thread pool, completing into the condition cache: a later getObject finds
+    /// them there without touching the storage. The cold-start latency is thus
+    /// bounded by the slowest object instead of the sum of all of them. Returns
+    /// the number of objects loaded (already cached paths are skipped); run < 0
+    /// means the run set in the Manager
+    Int_t prefetchConditions(const std::vector<IdPath> &paths, Int_t run = -1);
+
+    /// Freezes the conditions of the current run into an immutable in-memory
+    /// snapshot: each path is resolved and loaded upfront (an empty list means
+    /// every path the default and specific storages report valid for the run),
+    /// after which getObject answers from a hash map with zero storage traffic
+    /// and a path outside the snapshot is an error — job behavior thus cannot
+    /// change with storage content changing mid-job. When dumpFileName is
+    /// given, the snapshot is also dumped to a single file for shipping to
+    /// grid jobs (readable there with setSnapshotMode). Returns the number of
+    /// pinned objects, -1 if run, default storage or cache are not configured
+    Int_t freezeConditions(const std::vector<IdPath> &paths = std::vector<IdPath>(), const char *dumpFileName = "");
+
+    Bool_t isFrozen() const
+    {
+      return mFrozen;
+    }
+
+    /// Leaves frozen mode; the pinned objects stay in the regular cache
+    void unfreeze()
+    {
+      mFrozen = kFALSE;
+      mFrozenConditions.clear();
+    }
+
     const char *getUri(const char *path);
 
     TList *getAllObjects(const ConditionId &query);
@@ -153,6 +199,16 @@ class Manager : public TObject
       return mCache;
     }
 
+    /// Enables the node-local shared-memory cache: conditions materialized by one
+    /// process on this node are deserialized from shared memory by the others
+    /// instead of being downloaded again, see ConditionShmCache
+    void setShmCacheFlag(Bool_t shmCacheFlag);
+
+    Bool_t getShmCacheFlag() const
+    {
+      return mShmCache != 0;
+    }
+
     ULong64_t setLock(Bool_t lockFlag = kTRUE, ULong64_t key = 0);
 
     Bool_t getLock() const
@@ -266,6 +322,27 @@ class Manager : public TObject
 
     void cacheCondition(const char *path, Condition *entry);
 
+    /// Drops cached conditions and absence records that are not valid for the
+    /// run; objects whose run range covers the run stay available without a new
+    /// storage query
+    void evictCacheForRun(Int_t run);
+
+    /// Remembers that the storages hold no object for the path and run range of
+    /// the query, so later queries in the same range skip the storage
+    void rememberAbsentObject(const ConditionId &queryId);
+
+    /// Whether a previous query already resolved that no object exists for the
+    /// path and run range of the query
+    Bool_t isKnownAbsent(const ConditionId &queryId) const;
+
+    /// Report a newly cached condition to the memory accountant, at its
+    /// streamed size as a proxy for the in-memory footprint; no-op unless
+    /// accounting is enabled, see MemoryAccountant
+    void accountCachedCondition(const char *path, Condition *entry);
+
+    /// Remove a dropped condition from the cache accounting
+    void forgetCachedCondition(const char *path);
+
     StorageParameters *selectSpecificStorage(const TString &path);
 
     ConditionId *getId(const ConditionId &query);
@@ -279,6 +356,12 @@ class Manager : public TObject
     TMap mSpecificStorages; //! list of detector-specific storages
     TMap mConditionCache;       //! cache of the retrieved objects
 
+    ConditionCacheIndex *mCacheIndex; //! sharded reader-writer index over mConditionCache, see getObject
+
+    ConditionShmCache *mShmCache; //! node-local shared-memory cache, 0 when disabled
+
+    std::map<std::string, std::vector<std::pair<Int_t, Int_t>>> mAbsentRanges; //! run ranges per path known to hold no object
+
     TList *mIds;       //! List of the retrieved object ConditionId's (to be streamed to file)
     TMap *mStorageMap; //! list of storages (to be streamed to file)
 
@@ -294,6 +377,9 @@ class Manager : public TObject
 
     Bool_t mSnapshotMode; //! flag saying if we are in snapshot mode
     TFile *mSnapshotFile;
+
+    Bool_t mFrozen; //! conditions frozen for the job, see freezeConditions
+    std::unordered_map<std::string, Condition *> mFrozenConditions; //! the pinned objects, owned by the cache
     Bool_t mOcdbUploadMode; //! flag for uploads to Official CDBs (upload to cvmfs must follow upload
     // to AliEn)
 
@@ -303,6 +389,9 @@ class Manager : public TObject
     Int_t mEndRunLhcPeriod;   // last run of the LHC period set
     TString mLhcPeriod;       // LHC period alien folder
 
+    std::map<std::string, size_t> mCachedConditionSizes; //! accounted streamed size per cached path
+    Int_t mMemoryScopeId; //! accounting scope of the condition cache
+
   private:
     ULong64_t mKey; //! Key for locking/unlocking
 
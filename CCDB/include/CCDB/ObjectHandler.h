@@ -1,6 +1,8 @@
 #ifndef ALICE_O2_OBJECTHANDLER_H_
 #define ALICE_O2_OBJECTHANDLER_H_
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -15,6 +17,16 @@ public:
   /// Returns the binary payload of a ROOT file as an std::string
   static void GetObject(const std::string& path, std::string& object);
 
+  /// Streams the raw payload of a file to the consumer in fixed-size blocks:
+  /// while the consumer ships block N, a background thread already reads
+  /// block N+1 and folds it into the checksum, so at most two blocks are in
+  /// memory per transfer and the read latency hides behind the send. The
+  /// consumer is called once per block, in order; size receives the total
+  /// payload length and checksum its zlib crc32. Returns false if the file
+  /// could not be read
+  static bool StreamObject(const std::string& path,
+                           const std::function<void(const char* block, std::size_t length)>& consumer,
+                           std::size_t& size, unsigned long& checksum, std::size_t blockSize = 1048576);
 };
 }
 }
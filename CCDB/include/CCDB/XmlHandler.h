@@ -6,6 +6,7 @@
 #include <TObject.h>  // for TObject
 #include "Rtypes.h"   // for Int_t, XmlHandler::Class, ClassDef, etc
 #include "TString.h"  // for TString
+#include <vector>     // for vector
 
 class TList;
 
@@ -70,11 +71,42 @@ class XmlHandler : public TObject
       mRun = run;
     }
 
+    // one OCDB folder <-> run range correspondence collected from the XML
+    struct FolderRange {
+      Int_t mStartRun; // first run of the folder validity
+      Int_t mEndRun;   // last run of the folder validity
+      TString mFolder; // OCDB folder of the range
+    };
+
+    // collect every folder <-> run range entry instead of only the one
+    // matching the requested run, used by compileIndex
+    void setCollectAll(Bool_t collectAll)
+    {
+      mCollectAll = collectAll;
+    }
+
+    const std::vector<FolderRange> &getFolderRanges() const
+    {
+      return mRanges;
+    }
+
+    // One-time XML -> binary compilation: parses the XML once and writes a
+    // compact index (run-range records sorted by start run plus a folder
+    // string table), so later lookups are a binary search on a small flat
+    // file instead of a DOM parse
+    static Bool_t compileIndex(const char *xmlFile, const char *indexFile);
+
+    // Resolves the folder for the run from a compiled index; kFALSE when the
+    // index does not exist, is malformed or does not cover the run
+    static Bool_t lookupIndex(const char *indexFile, Int_t run, TString &folder, Int_t &startRun, Int_t &endRun);
+
   private:
     Int_t mRun;           // run for which the LHC Period Folder has to be found
     Int_t mStartIdRunRange; // start run corresponding to the request
     Int_t mEndIdRunRange;   // end run corresponding to the request
     TString mOCDBFolder;  // OCDB folder corresponding to the request
+    Bool_t mCollectAll;   //! collect every entry instead of only the matching one
+    std::vector<FolderRange> mRanges; //! the collected entries, see setCollectAll
 
   ClassDef(XmlHandler, 0) // The XML file handler for the OCDB
 };
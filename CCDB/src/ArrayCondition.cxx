@@ -0,0 +1,110 @@
+/// \file ArrayCondition.cxx
+/// \brief Implementation of the ArrayCondition class
+
+#include "CCDB/ArrayCondition.h"
+
+#include <cstring>
+
+using namespace AliceO2::CDB;
+
+namespace {
+/// blob layout: this header, the channel mapping id, then the raw values
+struct BlobHeader {
+  char magic[4];        // "O2AC"
+  uint32_t version;
+  uint32_t elementType;
+  uint32_t mappingIdLength;
+  uint64_t count;
+};
+const char kMagic[4] = {'O', '2', 'A', 'C'};
+const uint32_t kVersion = 1;
+}
+
+ArrayCondition::ArrayCondition()
+  : mElementType(kFloat),
+    mCount(0),
+    mChannelMappingId(),
+    mStorage(),
+    mData(nullptr)
+{
+}
+
+ArrayCondition::ArrayCondition(const float* values, std::size_t count,
+                               const std::string& channelMappingId)
+  : mElementType(kFloat),
+    mCount(count),
+    mChannelMappingId(channelMappingId),
+    mStorage(),
+    mData(nullptr)
+{
+  allocate(count * elementSize());
+  std::memcpy(mData, values, count * elementSize());
+}
+
+ArrayCondition::ArrayCondition(const int32_t* values, std::size_t count,
+                               const std::string& channelMappingId)
+  : mElementType(kInt32),
+    mCount(count),
+    mChannelMappingId(channelMappingId),
+    mStorage(),
+    mData(nullptr)
+{
+  allocate(count * elementSize());
+  std::memcpy(mData, values, count * elementSize());
+}
+
+void ArrayCondition::allocate(std::size_t bytes)
+{
+  // over-allocate and round the start up, operator new does not guarantee
+  // more than the fundamental alignment
+  mStorage.reset(new char[bytes + kAlignment]);
+  std::size_t address = reinterpret_cast<std::size_t>(mStorage.get());
+  mData = mStorage.get() + (kAlignment - address % kAlignment) % kAlignment;
+}
+
+void ArrayCondition::serialize(std::string& blob) const
+{
+  BlobHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.elementType = mElementType;
+  header.mappingIdLength = mChannelMappingId.size();
+  header.count = mCount;
+
+  blob.clear();
+  blob.reserve(sizeof(BlobHeader) + mChannelMappingId.size() + mCount * elementSize());
+  blob.append(reinterpret_cast<const char*>(&header), sizeof(BlobHeader));
+  blob.append(mChannelMappingId);
+  blob.append(mData, mCount * elementSize());
+}
+
+bool ArrayCondition::deserialize(const char* blob, std::size_t size)
+{
+  mCount = 0;
+  mChannelMappingId.clear();
+  mStorage.reset();
+  mData = nullptr;
+
+  if (blob == nullptr || size < sizeof(BlobHeader)) {
+    return false;
+  }
+  BlobHeader header;
+  std::memcpy(&header, blob, sizeof(BlobHeader));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+    return false;
+  }
+  if (header.elementType != kFloat && header.elementType != kInt32) {
+    return false;
+  }
+  std::size_t payloadBytes = header.count * sizeof(float);
+  if (size < sizeof(BlobHeader) + header.mappingIdLength + payloadBytes) {
+    return false;
+  }
+
+  mElementType = static_cast<ElementType>(header.elementType);
+  mCount = header.count;
+  mChannelMappingId.assign(blob + sizeof(BlobHeader), header.mappingIdLength);
+  allocate(payloadBytes);
+  std::memcpy(mData, blob + sizeof(BlobHeader) + header.mappingIdLength, payloadBytes);
+  return true;
+}
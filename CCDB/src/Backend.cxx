@@ -4,11 +4,16 @@
 
 #include "CCDB/Backend.h"
 
+#include <zlib.h>
+
+#include "FairMQLogger.h"
+
 using namespace AliceO2::CDB;
 using namespace std;
 
 void Backend::Serialize(std::string*& messageString, const std::string& key, const std::string& operationType,
-                        const std::string& dataSource, const std::string& object /*= std::vector<char>()*/)
+                        const std::string& dataSource, const std::string& object /*= std::vector<char>()*/,
+                        bool zip /*= false*/, int chunkSize /*= 0*/)
 {
   messaging::RequestMessage* requestMessage = new messaging::RequestMessage;
   requestMessage->set_command(operationType);
@@ -19,7 +24,119 @@ void Backend::Serialize(std::string*& messageString, const std::string& key, con
     requestMessage->set_value(object);
   }
 
+  if (zip || chunkSize > 0) {
+    requestMessage->set_zip(zip);
+    requestMessage->set_chunksize(chunkSize);
+  }
+
+  requestMessage->SerializeToString(messageString);
+
+  delete requestMessage;
+}
+
+void Backend::Serialize(std::string*& messageString, const std::vector<std::string>& keys,
+                        const std::string& operationType, const std::string& dataSource)
+{
+  messaging::RequestMessage* requestMessage = new messaging::RequestMessage;
+  requestMessage->set_command(operationType);
+  requestMessage->set_datasource(dataSource);
+
+  for (unsigned int iKey = 0; iKey < keys.size(); ++iKey) {
+    requestMessage->add_keys(keys[iKey]);
+  }
+
   requestMessage->SerializeToString(messageString);
 
   delete requestMessage;
 }
+
+void Backend::UnPack(std::vector<std::unique_ptr<FairMQMessage>> msgs)
+{
+  if (msgs.size() > 0) {
+    UnPack(std::move(msgs.front()));
+  }
+}
+
+void Backend::UnPackMultiple(std::unique_ptr<FairMQMessage> msg)
+{
+  LOG(ERROR) << "Batched requests are not supported for this backend";
+}
+
+// Compression/decompression code taken from https://panthema.net/2007/0328-ZLibString.html
+
+void Backend::Compress(const std::string& uncompressed_string, std::string& compressed_string)
+{
+  // z_stream is zlib's control structure
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+
+  if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    LOG(ERROR) << "deflateInit failed while compressing";
+  }
+
+  zs.next_in = (Bytef*)uncompressed_string.data();
+  zs.avail_in = uncompressed_string.size();
+
+  int ret;
+  char outbuffer[32768];
+  std::string outstring;
+
+  // Get the compressed bytes in blocks of 32768 bytes using repeated calls to deflate
+  do {
+    zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
+    zs.avail_out = sizeof(outbuffer);
+
+    ret = deflate(&zs, Z_FINISH);
+
+    if (outstring.size() < zs.total_out) {
+      // append the block to the output string
+      outstring.append(outbuffer, zs.total_out - outstring.size());
+    }
+  } while (ret == Z_OK);
+
+  deflateEnd(&zs);
+
+  if (ret != Z_STREAM_END) {
+    LOG(ERROR) << "Exception during zlib compression: (" << ret << ") " << zs.msg;
+  }
+
+  compressed_string.assign(outstring);
+}
+
+void Backend::Decompress(std::string& uncompressed_string, const std::string& compressed_string)
+{
+  // z_stream is zlib's control structure
+  z_stream zs;
+  memset(&zs, 0, sizeof(zs));
+
+  if (inflateInit(&zs) != Z_OK) {
+    LOG(ERROR) << "deflateInit failed while decompressing";
+  }
+
+  zs.next_in = (Bytef*)compressed_string.data();
+  zs.avail_in = compressed_string.size();
+
+  int ret;
+  char outbuffer[32768];
+  std::string outstring;
+
+  // Get the decompressed bytes in blocks of 32768 bytes using repeated calls to inflate
+  do {
+    zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
+    zs.avail_out = sizeof(outbuffer);
+
+    ret = inflate(&zs, 0);
+
+    if (outstring.size() < zs.total_out) {
+      outstring.append(outbuffer, zs.total_out - outstring.size());
+    }
+  } while (ret == Z_OK);
+
+  inflateEnd(&zs);
+
+  if (ret != Z_STREAM_END) {
+    LOG(ERROR) << "Exception during zlib compression: (" << ret << ") " << zs.msg;
+  }
+
+  uncompressed_string.assign(outstring);
+}
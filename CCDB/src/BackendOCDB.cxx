@@ -35,3 +35,44 @@ void BackendOCDB::UnPack(std::unique_ptr<FairMQMessage> msg)
   LOG(DEBUG) << "Received a condition from the server:";
   aCondition->printConditionMetaData();
 }
+
+void BackendOCDB::UnPack(std::vector<std::unique_ptr<FairMQMessage>> msgs)
+{
+  if (msgs.size() < 2) {
+    LOG(ERROR) << "Expected a reply header and at least one payload chunk, received " << msgs.size() << " part(s)";
+    return;
+  }
+
+  messaging::ReplyHeader replyHeader;
+  replyHeader.ParseFromArray(msgs[0]->GetData(), msgs[0]->GetSize());
+
+  if (replyHeader.chunkcount() != msgs.size() - 1) {
+    LOG(ERROR) << "Reply header announced " << replyHeader.chunkcount() << " chunks but " << msgs.size() - 1
+               << " were received";
+    return;
+  }
+
+  if (!replyHeader.zipped() && msgs.size() == 2) {
+    // Single uncompressed chunk: deserialize straight from the message memory
+    UnPack(std::move(msgs[1]));
+    return;
+  }
+
+  // Reassemble the payload from the chunks
+  std::string payload;
+  payload.reserve(replyHeader.payloadsize());
+  for (unsigned int iChunk = 1; iChunk < msgs.size(); ++iChunk) {
+    payload.append(static_cast<char*>(msgs[iChunk]->GetData()), msgs[iChunk]->GetSize());
+  }
+
+  if (replyHeader.zipped()) {
+    std::string object;
+    Decompress(object, payload);
+    payload.swap(object);
+  }
+
+  WrapTMessage tmsg(const_cast<char*>(payload.data()), payload.size());
+  Condition* aCondition = (Condition*)(tmsg.ReadObject(tmsg.GetClass()));
+  LOG(DEBUG) << "Received a condition from the server:";
+  aCondition->printConditionMetaData();
+}
@@ -5,8 +5,6 @@
 #include "CCDB/BackendRiak.h"
 #include "CCDB/ObjectHandler.h"
 
-#include <zlib.h>
-
 #include "FairMQLogger.h"
 
 using namespace AliceO2::CDB;
@@ -14,85 +12,6 @@ using namespace std;
 
 BackendRiak::BackendRiak() {}
 
-// Compression/decompression code taken from https://panthema.net/2007/0328-ZLibString.html
-
-void BackendRiak::Compress(const std::string& uncompressed_string, std::string& compressed_string)
-{
-  // z_stream is zlib's control structure
-  z_stream zs;
-  memset(&zs, 0, sizeof(zs));
-
-  if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK) {
-    LOG(ERROR) << "deflateInit failed while compressing";
-  }
-
-  zs.next_in = (Bytef*)uncompressed_string.data();
-  zs.avail_in = uncompressed_string.size();
-
-  int ret;
-  char outbuffer[32768];
-  std::string outstring;
-
-  // Get the compressed bytes in blocks of 32768 bytes using repeated calls to deflate
-  do {
-    zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-    zs.avail_out = sizeof(outbuffer);
-
-    ret = deflate(&zs, Z_FINISH);
-
-    if (outstring.size() < zs.total_out) {
-      // append the block to the output string
-      outstring.append(outbuffer, zs.total_out - outstring.size());
-    }
-  } while (ret == Z_OK);
-
-  deflateEnd(&zs);
-
-  if (ret != Z_STREAM_END) {
-    LOG(ERROR) << "Exception during zlib compression: (" << ret << ") " << zs.msg;
-  }
-
-  compressed_string.assign(outstring);
-}
-
-void BackendRiak::Decompress(std::string& uncompressed_string, const std::string& compressed_string)
-{
-  // z_stream is zlib's control structure
-  z_stream zs;
-  memset(&zs, 0, sizeof(zs));
-
-  if (inflateInit(&zs) != Z_OK) {
-    LOG(ERROR) << "deflateInit failed while decompressing";
-  }
-
-  zs.next_in = (Bytef*)compressed_string.data();
-  zs.avail_in = compressed_string.size();
-
-  int ret;
-  char outbuffer[32768];
-  std::string outstring;
-
-  // Get the decompressed bytes in blocks of 32768 bytes using repeated calls to inflate
-  do {
-    zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-    zs.avail_out = sizeof(outbuffer);
-
-    ret = inflate(&zs, 0);
-
-    if (outstring.size() < zs.total_out) {
-      outstring.append(outbuffer, zs.total_out - outstring.size());
-    }
-  } while (ret == Z_OK);
-
-  inflateEnd(&zs);
-
-  if (ret != Z_STREAM_END) {
-    LOG(ERROR) << "Exception during zlib compression: (" << ret << ") " << zs.msg;
-  }
-
-  uncompressed_string.assign(outstring);
-}
-
 void BackendRiak::Deserialize(const std::string& messageString, std::string& object)
 {
   messaging::RequestMessage* requestMessage = new messaging::RequestMessage;
@@ -128,3 +47,21 @@ void BackendRiak::UnPack(std::unique_ptr<FairMQMessage> msg)
   std::string object;
   Decompress(object, compressedObject);
 }
+
+void BackendRiak::UnPackMultiple(std::unique_ptr<FairMQMessage> msg)
+{
+  std::string brokerString(static_cast<char*>(msg->GetData()), msg->GetSize());
+
+  messaging::RequestMessage* requestMessage = new messaging::RequestMessage;
+  requestMessage->ParseFromString(brokerString);
+
+  // Decompress each value of the multiplexed reply
+  for (int iValue = 0; iValue < requestMessage->values_size(); ++iValue) {
+    std::string object;
+    Decompress(object, requestMessage->values(iValue));
+  }
+
+  LOG(DEBUG) << "Unpacked " << requestMessage->values_size() << " objects from a multiplexed reply";
+
+  delete requestMessage;
+}
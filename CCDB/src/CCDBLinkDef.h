@@ -9,6 +9,7 @@
 #pragma link C++ class AliceO2::CDB::ConditionId+;
 #pragma link C++ class AliceO2::CDB::ConditionMetaData+;
 #pragma link C++ class AliceO2::CDB::Condition+;
+#pragma link C++ class AliceO2::CDB::ConditionDelta+;
 #pragma link C++ class AliceO2::CDB::Storage+;
 #pragma link C++ class AliceO2::CDB::StorageFactory+;
 #pragma link C++ class AliceO2::CDB::Manager+;
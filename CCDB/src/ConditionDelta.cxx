@@ -0,0 +1,190 @@
+//  binary diff between two versions of a stored condition object  //
+
+#include "CCDB/ConditionDelta.h"
+
+#include <cstring>
+#include <unordered_map>
+
+using namespace AliceO2::CDB;
+
+ClassImp(ConditionDelta)
+
+namespace {
+
+// base block size of the matcher; matches shorter than one block are not
+// worth their copy-operation overhead and stay literal
+const size_t kBlockSize = 16;
+
+// diff operation codes
+const char kOpCopy = 0;
+const char kOpLiteral = 1;
+
+void putVarint(std::string &out, ULong64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+Bool_t getVarint(const std::string &in, size_t &pos, ULong64_t &value)
+{
+  value = 0;
+  Int_t shift = 0;
+  while (pos < in.size() && shift <= 63) {
+    const unsigned char byte = in[pos++];
+    value |= static_cast<ULong64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return kTRUE;
+    }
+    shift += 7;
+  }
+  return kFALSE;
+}
+
+UInt_t blockHash(const char *data)
+{
+  // FNV-1a over one block
+  UInt_t hash = 2166136261u;
+  for (size_t i = 0; i < kBlockSize; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void putLiteral(std::string &delta, const std::string &object, size_t begin, size_t end)
+{
+  if (end <= begin) {
+    return;
+  }
+  delta.push_back(kOpLiteral);
+  putVarint(delta, end - begin);
+  delta.append(object, begin, end - begin);
+}
+}
+
+ConditionDelta::ConditionDelta() : TObject(), mBaseFile(""), mChainLength(0), mBaseChecksum(0), mDelta()
+{
+  // default constructor
+}
+
+ConditionDelta::ConditionDelta(const char *baseFile, Int_t chainLength, const std::string &delta, UInt_t baseChecksum)
+  : TObject(), mBaseFile(baseFile), mChainLength(chainLength), mBaseChecksum(baseChecksum),
+    mDelta(delta.begin(), delta.end())
+{
+  // constructor
+}
+
+ConditionDelta::~ConditionDelta()
+{
+  // destructor
+}
+
+UInt_t ConditionDelta::checksum(const std::string &bytes)
+{
+  // FNV-1a over the whole buffer
+  UInt_t hash = 2166136261u;
+  for (size_t i = 0; i < bytes.size(); i++) {
+    hash ^= static_cast<unsigned char>(bytes[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void ConditionDelta::encode(const std::string &base, const std::string &object, std::string &delta)
+{
+  // greedy block matching: every block of the base is indexed by its hash
+  // once, the object is scanned byte by byte, and at each position the
+  // longest verified base match starting on an indexed block is taken.
+  // Unmatched bytes accumulate into literal runs. Since the base blocks are
+  // disjoint, the index stays small and unchanged regions of any alignment
+  // resynchronize after at most one block
+
+  delta.clear();
+  putVarint(delta, object.size());
+
+  std::unordered_map<UInt_t, std::vector<UInt_t>> blockIndex;
+  const size_t nBlocks = base.size() / kBlockSize;
+  for (size_t block = 0; block < nBlocks; block++) {
+    blockIndex[blockHash(base.data() + block * kBlockSize)].push_back(block);
+  }
+
+  size_t literalBegin = 0;
+  size_t pos = 0;
+  while (pos + kBlockSize <= object.size()) {
+    const auto candidates = blockIndex.find(blockHash(object.data() + pos));
+    size_t matchOffset = 0;
+    size_t matchLength = 0;
+    if (candidates != blockIndex.end()) {
+      for (const UInt_t block : candidates->second) {
+        const size_t offset = block * kBlockSize;
+        if (std::memcmp(base.data() + offset, object.data() + pos, kBlockSize) != 0) {
+          continue;
+        }
+        // verified match, extend it forward byte by byte
+        size_t length = kBlockSize;
+        while (offset + length < base.size() && pos + length < object.size() &&
+               base[offset + length] == object[pos + length]) {
+          length++;
+        }
+        if (length > matchLength) {
+          matchOffset = offset;
+          matchLength = length;
+        }
+      }
+    }
+    if (matchLength == 0) {
+      pos++;
+      continue;
+    }
+    putLiteral(delta, object, literalBegin, pos);
+    delta.push_back(kOpCopy);
+    putVarint(delta, matchOffset);
+    putVarint(delta, matchLength);
+    pos += matchLength;
+    literalBegin = pos;
+  }
+  putLiteral(delta, object, literalBegin, object.size());
+}
+
+Bool_t ConditionDelta::apply(const std::string &base, const std::string &delta, std::string &object)
+{
+  object.clear();
+
+  size_t pos = 0;
+  ULong64_t objectSize = 0;
+  if (!getVarint(delta, pos, objectSize)) {
+    return kFALSE;
+  }
+  object.reserve(objectSize);
+
+  while (pos < delta.size()) {
+    const char op = delta[pos++];
+    if (op == kOpCopy) {
+      ULong64_t offset = 0, length = 0;
+      if (!getVarint(delta, pos, offset) || !getVarint(delta, pos, length)) {
+        return kFALSE;
+      }
+      if (offset + length > base.size()) {
+        return kFALSE;
+      }
+      object.append(base, offset, length);
+    } else if (op == kOpLiteral) {
+      ULong64_t length = 0;
+      if (!getVarint(delta, pos, length)) {
+        return kFALSE;
+      }
+      if (pos + length > delta.size()) {
+        return kFALSE;
+      }
+      object.append(delta, pos, length);
+      pos += length;
+    } else {
+      return kFALSE;
+    }
+  }
+
+  return object.size() == objectSize;
+}
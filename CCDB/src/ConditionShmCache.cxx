@@ -0,0 +1,154 @@
+/// \file ConditionShmCache.cxx
+/// \brief Implementation of the ConditionShmCache class
+
+#include "CCDB/ConditionShmCache.h"
+#include "CCDB/Condition.h"
+#include "CCDB/ConditionId.h"
+#include <FairLogger.h>  // for LOG
+#include <TBufferFile.h> // for TBufferFile
+#include <fcntl.h>       // for O_CREAT, O_EXCL, O_RDWR, O_RDONLY
+#include <string.h>      // for memcpy, memcmp
+#include <sys/mman.h>    // for shm_open, shm_unlink, mmap, munmap
+#include <sys/stat.h>    // for fstat
+#include <unistd.h>      // for ftruncate, close, getuid
+
+using namespace AliceO2::CDB;
+
+namespace {
+
+// header preceding the serialized condition in each shared-memory segment
+struct SegmentHeader {
+  char magic[8];       // identifies a condition segment, see kSegmentMagic
+  Int_t layoutVersion; // layout version of this header
+  Int_t firstRun;      // first run of the stored object validity
+  Int_t lastRun;       // last run of the stored object validity
+  Int_t version;       // version of the stored object
+  Int_t subVersion;    // subversion of the stored object
+  Int_t payloadSize;   // size of the serialized condition in bytes
+  Int_t referenceCount; // number of readers that deserialized from this segment
+  Int_t complete;      // set to 1 by the creator once the payload is fully written
+};
+
+const char kSegmentMagic[8] = {'O', '2', 'C', 'D', 'B', 'S', 'H', 'M'};
+const Int_t kSegmentLayoutVersion = 1;
+}
+
+ConditionShmCache::ConditionShmCache() : mNumberOfHits(0), mNumberOfPublished(0)
+{
+}
+
+TString ConditionShmCache::getSegmentName(const TString &pathString)
+{
+  TString name = pathString;
+  name.ReplaceAll("/", "_");
+  return TString::Format("/o2ccdb_%u_%s", UInt_t(getuid()), name.Data());
+}
+
+Condition *ConditionShmCache::getCondition(const ConditionId &queryId)
+{
+  TString segmentName = getSegmentName(queryId.getPathString());
+  int fd = shm_open(segmentName.Data(), O_RDWR, 0600);
+  if (fd < 0) {
+    return NULL; // not published yet
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(SegmentHeader)) {
+    close(fd);
+    return NULL; // creator has not sized the segment yet
+  }
+
+  void *address = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    LOG(WARNING) << "Cannot map shared condition segment " << segmentName.Data() << FairLogger::endl;
+    return NULL;
+  }
+
+  SegmentHeader *header = static_cast<SegmentHeader *>(address);
+  if (memcmp(header->magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 ||
+      header->layoutVersion != kSegmentLayoutVersion || !header->complete) {
+    munmap(address, status.st_size); // foreign content or creator still writing: treat as miss
+    return NULL;
+  }
+
+  if (queryId.getFirstRun() < header->firstRun || queryId.getFirstRun() > header->lastRun) {
+    // stale for the queried run: unlink so the next query republishes; the memory
+    // itself survives until the readers still attached unmap it
+    LOG(DEBUG) << "Shared condition segment " << segmentName.Data() << " valid for runs [" << header->firstRun << ","
+               << header->lastRun << "] is stale for run " << queryId.getFirstRun() << " (" << header->referenceCount
+               << " readers used it), unlinking" << FairLogger::endl;
+    shm_unlink(segmentName.Data());
+    munmap(address, status.st_size);
+    return NULL;
+  }
+
+  __sync_fetch_and_add(&header->referenceCount, 1);
+
+  // the buffer adopts the mapped payload without copying; the deserialized
+  // object owns its own memory, so the mapping can go right after reading
+  TBufferFile buffer(TBuffer::kRead, header->payloadSize, header + 1, kFALSE);
+  Condition *entry = dynamic_cast<Condition *>(buffer.ReadObject(Condition::Class()));
+  munmap(address, status.st_size);
+
+  if (!entry) {
+    LOG(WARNING) << "Cannot deserialize condition from shared segment " << segmentName.Data() << FairLogger::endl;
+    return NULL;
+  }
+
+  mNumberOfHits++;
+  LOG(DEBUG) << "Object " << queryId.getPathString().Data() << " retrieved from shared memory !!" << FairLogger::endl;
+  return entry;
+}
+
+Bool_t ConditionShmCache::publishCondition(Condition *entry)
+{
+  if (!entry) {
+    return kFALSE;
+  }
+  const ConditionId &id = entry->getId();
+  TString segmentName = getSegmentName(id.getPathString());
+
+  int fd = shm_open(segmentName.Data(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return kFALSE; // another process published (or is publishing) this path
+  }
+
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(entry);
+
+  size_t segmentSize = sizeof(SegmentHeader) + buffer.Length();
+  if (ftruncate(fd, segmentSize) != 0) {
+    LOG(WARNING) << "Cannot size shared condition segment " << segmentName.Data() << FairLogger::endl;
+    close(fd);
+    shm_unlink(segmentName.Data());
+    return kFALSE;
+  }
+
+  void *address = mmap(NULL, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED) {
+    LOG(WARNING) << "Cannot map shared condition segment " << segmentName.Data() << FairLogger::endl;
+    shm_unlink(segmentName.Data());
+    return kFALSE;
+  }
+
+  SegmentHeader *header = static_cast<SegmentHeader *>(address);
+  memcpy(header->magic, kSegmentMagic, sizeof(kSegmentMagic));
+  header->layoutVersion = kSegmentLayoutVersion;
+  header->firstRun = id.getFirstRun();
+  header->lastRun = id.getLastRun();
+  header->version = id.getVersion();
+  header->subVersion = id.getSubVersion();
+  header->payloadSize = buffer.Length();
+  header->referenceCount = 0;
+  memcpy(header + 1, buffer.Buffer(), buffer.Length());
+  __sync_synchronize();
+  header->complete = 1; // readers may use the segment from this point on
+
+  munmap(address, segmentSize);
+  mNumberOfPublished++;
+  LOG(DEBUG) << "Object " << id.getPathString().Data() << " published into shared memory (" << buffer.Length()
+             << " bytes)" << FairLogger::endl;
+  return kTRUE;
+}
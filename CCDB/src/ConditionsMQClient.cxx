@@ -26,7 +26,7 @@
 using namespace AliceO2::CDB;
 using namespace std;
 
-ConditionsMQClient::ConditionsMQClient() : fRunId(0), fParameterName() {}
+ConditionsMQClient::ConditionsMQClient() : fRunId(0), fParameterName(), fCompress(false), fChunkSize(0), fBatch(false) {}
 
 ConditionsMQClient::~ConditionsMQClient() {}
 
@@ -38,6 +38,9 @@ void ConditionsMQClient::InitTask()
   fOperationType = fConfig->GetValue<string>("operation-type");
   fDataSource = fConfig->GetValue<string>("data-source");
   fObjectPath = fConfig->GetValue<string>("object-path");
+  fCompress = fConfig->GetValue<bool>("compress");
+  fChunkSize = fConfig->GetValue<int>("chunk-size");
+  fBatch = fConfig->GetValue<bool>("batch");
 }
 
 void ConditionsMQClient::Run()
@@ -61,6 +64,9 @@ void ConditionsMQClient::Run()
     boost::filesystem::path dataPath(fObjectPath);
     boost::filesystem::recursive_directory_iterator endIterator;
 
+    // Keys collected for a single multi-key request when batching is enabled
+    std::vector<std::string> batchedKeys;
+
     // Traverse the filesystem and retrieve the name of each root found
     if (boost::filesystem::exists(dataPath) && boost::filesystem::is_directory(dataPath)) {
       for (static boost::filesystem::recursive_directory_iterator directoryIterator(dataPath);
@@ -73,18 +79,31 @@ void ConditionsMQClient::Run()
           std::size_t pos = str.rfind(".");
           std::string key = str.substr(0, pos);
 
-          if (fOperationType == "GET") {
+          if (fOperationType == "GET" && fBatch) {
+            batchedKeys.push_back(key);
+          } else if (fOperationType == "GET") {
             std::string* messageString = new string();
-            backend->Serialize(messageString, key, fOperationType, fDataSource);
+            backend->Serialize(messageString, key, fOperationType, fDataSource, string(), fCompress, fChunkSize);
 
             unique_ptr<FairMQMessage> request(fTransportFactory->CreateMessage(
               const_cast<char*>(messageString->c_str()), messageString->length(), CustomCleanup, messageString));
-            unique_ptr<FairMQMessage> reply(fTransportFactory->CreateMessage());
 
             if (fChannels.at("data-get").at(0).Send(request) > 0) {
-              if (fChannels.at("data-get").at(0).Receive(reply) > 0) {
-                LOG(DEBUG) << "Received a condition with a size of " << reply->GetSize();
-                backend->UnPack(std::move(reply));
+              if (fCompress || fChunkSize > 0) {
+                // Chunked reply: a header part followed by the payload chunks
+                std::vector<unique_ptr<FairMQMessage>> replyParts;
+
+                if (fChannels.at("data-get").at(0).Receive(replyParts) > 0) {
+                  LOG(DEBUG) << "Received a condition in " << replyParts.size() << " part(s)";
+                  backend->UnPack(std::move(replyParts));
+                }
+              } else {
+                unique_ptr<FairMQMessage> reply(fTransportFactory->CreateMessage());
+
+                if (fChannels.at("data-get").at(0).Receive(reply) > 0) {
+                  LOG(DEBUG) << "Received a condition with a size of " << reply->GetSize();
+                  backend->UnPack(std::move(reply));
+                }
               }
             }
           } else if (fOperationType == "PUT") {
@@ -104,6 +123,24 @@ void ConditionsMQClient::Run()
       LOG(ERROR) << "Path " << fObjectPath << " not existing or not a directory";
     }
 
+    if (batchedKeys.size() > 0) {
+      // Fetch all collected keys in one round trip with a multiplexed reply
+      std::string* messageString = new string();
+      backend->Serialize(messageString, batchedKeys, fOperationType, fDataSource);
+
+      unique_ptr<FairMQMessage> request(fTransportFactory->CreateMessage(
+        const_cast<char*>(messageString->c_str()), messageString->length(), CustomCleanup, messageString));
+      unique_ptr<FairMQMessage> reply(fTransportFactory->CreateMessage());
+
+      if (fChannels.at("data-get").at(0).Send(request) > 0) {
+        if (fChannels.at("data-get").at(0).Receive(reply) > 0) {
+          LOG(DEBUG) << "Received a multiplexed reply for " << batchedKeys.size() << " keys with a size of "
+                     << reply->GetSize();
+          backend->UnPackMultiple(std::move(reply));
+        }
+      }
+    }
+
     boost::posix_time::ptime endTime = boost::posix_time::microsec_clock::local_time();
     LOG(DEBUG) << " Time elapsed: " << (endTime - startTime).total_milliseconds() << "ms";
   }
@@ -15,6 +15,7 @@
 #include "TMessage.h"
 #include "Rtypes.h"
 
+#include "CCDB/Backend.h"
 #include "CCDB/Condition.h"
 #include "CCDB/ConditionsMQServer.h"
 #include "CCDB/IdPath.h"
@@ -32,7 +33,10 @@ using std::endl;
 using std::cout;
 using std::string;
 
-ConditionsMQServer::ConditionsMQServer() : ParameterMQServer(), fCdbManager(AliceO2::CDB::Manager::Instance()) {}
+ConditionsMQServer::ConditionsMQServer()
+  : ParameterMQServer(), fCdbManager(AliceO2::CDB::Manager::Instance()), fBlobCache()
+{
+}
 
 void ConditionsMQServer::InitTask()
 {
@@ -55,7 +59,12 @@ void ConditionsMQServer::InitTask()
   }
 }
 
-void free_tmessage(void* data, void* hint) { delete static_cast<TMessage*>(hint); }
+void free_string(void* data, void* hint) { delete static_cast<std::string*>(hint); }
+
+void free_blob_reference(void* data, void* hint)
+{
+  delete static_cast<std::shared_ptr<const std::string>*>(hint);
+}
 
 void ConditionsMQServer::ParseDataSource(std::string& dataSource, const std::string& data)
 {
@@ -69,12 +78,15 @@ void ConditionsMQServer::ParseDataSource(std::string& dataSource, const std::str
   delete msgReply;
 }
 
-void ConditionsMQServer::Deserialize(const std::string& messageString, std::string& object)
+void ConditionsMQServer::Deserialize(const std::string& messageString, std::string& key, bool& zip, int& chunkSize)
 {
   messaging::RequestMessage* requestMessage = new messaging::RequestMessage;
   requestMessage->ParseFromString(messageString);
 
-  object.assign(requestMessage->key());
+  key.assign(requestMessage->key());
+  zip = requestMessage->has_zip() && requestMessage->zip();
+  // A chunk size < 0 marks a client not aware of the chunked protocol
+  chunkSize = requestMessage->has_chunksize() ? static_cast<int>(requestMessage->chunksize()) : -1;
 
   delete requestMessage;
 }
@@ -100,11 +112,13 @@ void ConditionsMQServer::Run()
         ParseDataSource(dataSource, serialString);
 
         if (dataSource == "OCDB") {
-          // Retrieve the key from the serialized message
+          // Retrieve the key and the reply options from the serialized message
           std::string key;
-          Deserialize(serialString, key);
+          bool zip;
+          int chunkSize;
+          Deserialize(serialString, key, zip, chunkSize);
 
-          getFromOCDB(key);
+          getFromOCDB(key, zip, chunkSize);
         } else if (dataSource == "Riak") {
           // No need to de-serialize, just forward message to the broker
           fChannels.at("broker-get").at(0).Send(input);
@@ -144,35 +158,102 @@ void ConditionsMQServer::Run()
   }
 }
 
-// Query OCDB for the condition
-void ConditionsMQServer::getFromOCDB(std::string key)
+std::shared_ptr<const std::string> ConditionsMQServer::getSerializedBlob(const std::string& key, bool zip)
 {
+  std::string cacheKey = (zip ? "zip:" : "raw:") + key;
+
+  std::map<std::string, std::shared_ptr<const std::string>>::iterator cached = fBlobCache.find(cacheKey);
+  if (cached != fBlobCache.end()) {
+    LOG(DEBUG) << "Serving \"" << key << "\" from the serialized blob cache";
+    return cached->second;
+  }
+
   // Change key from i.e. "/DET/Calib/Histo/Run2008_2008_v1_s0" to (DET/Calib/Histo, 2008)
   // FIXME: This will have to be changed in the future by adapting IdPath and getObject accordingly
   std::size_t pos = key.rfind("/");
   std::string identifier = key.substr(0, pos);
-  key.erase(0, pos + 4);
-  std::size_t pos2 = key.find("_");
-  int runId = atoi(key.substr(0, pos2).c_str());
-
-  Condition* aCondition = nullptr;
+  std::string runString = key.substr(pos + 4);
+  int runId = atoi(runString.substr(0, runString.find("_")).c_str());
 
   fCdbManager->setRun(runId);
-  aCondition = fCdbManager->getObject(IdPath(identifier), runId);
+  Condition* aCondition = fCdbManager->getObject(IdPath(identifier), runId);
+
+  if (!aCondition) {
+    return std::shared_ptr<const std::string>();
+  }
+
+  LOG(DEBUG) << "Caching the serialized form of the following parameter:";
+  aCondition->printConditionMetaData();
+
+  TMessage tmsg(kMESS_OBJECT);
+  tmsg.WriteObject(aCondition);
+
+  std::shared_ptr<std::string> blob;
+  if (zip) {
+    std::string serialized(tmsg.Buffer(), tmsg.BufferSize());
+    blob = std::make_shared<std::string>();
+    Backend::Compress(serialized, *blob);
+  } else {
+    blob = std::make_shared<std::string>(tmsg.Buffer(), tmsg.BufferSize());
+  }
+
+  fBlobCache[cacheKey] = blob;
+  return blob;
+}
 
-  if (aCondition) {
-    LOG(DEBUG) << "Sending following parameter to the client:";
-    aCondition->printConditionMetaData();
-    TMessage* tmsg = new TMessage(kMESS_OBJECT);
-    tmsg->WriteObject(aCondition);
+// Query OCDB for the condition and reply on the data-get channel
+void ConditionsMQServer::getFromOCDB(std::string key, bool zip, int chunkSize)
+{
+  std::shared_ptr<const std::string> blob = getSerializedBlob(key, zip);
+
+  if (!blob) {
+    LOG(ERROR) << "Could not get a condition for \"" << key << "\"!";
+    return;
+  }
 
+  if (chunkSize < 0) {
+    // The client does not know the chunked protocol: whole payload in one plain message.
+    // The message references the cached blob and holds a reference keeping it alive
     std::unique_ptr<FairMQMessage> message(
-      fTransportFactory->CreateMessage(tmsg->Buffer(), tmsg->BufferSize(), free_tmessage, tmsg));
+      fTransportFactory->CreateMessage(const_cast<char*>(blob->data()), blob->size(), free_blob_reference,
+                                       new std::shared_ptr<const std::string>(blob)));
 
     fChannels.at("data-get").at(0).Send(message);
-  } else {
-    LOG(ERROR) << "Could not get a condition for \"" << key << "\" and run " << runId << "!";
+    return;
+  }
+
+  if (chunkSize == 0 || static_cast<std::size_t>(chunkSize) > blob->size()) {
+    chunkSize = blob->size();
   }
+
+  messaging::ReplyHeader replyHeader;
+  replyHeader.set_payloadsize(blob->size());
+  replyHeader.set_chunkcount((blob->size() + chunkSize - 1) / chunkSize);
+  replyHeader.set_zipped(zip);
+  replyHeader.set_id(key);
+
+  std::string* headerString = new std::string();
+  replyHeader.SerializeToString(headerString);
+
+  std::vector<std::unique_ptr<FairMQMessage>> reply;
+  reply.emplace_back(fTransportFactory->CreateMessage(const_cast<char*>(headerString->c_str()),
+                                                      headerString->length(), free_string, headerString));
+
+  // The chunks reference the cached blob directly without copying; each part holds
+  // a reference keeping the blob alive until the transport has sent it
+  for (std::size_t offset = 0; offset < blob->size(); offset += chunkSize) {
+    std::size_t length = blob->size() - offset;
+    if (length > static_cast<std::size_t>(chunkSize)) {
+      length = chunkSize;
+    }
+    reply.emplace_back(fTransportFactory->CreateMessage(const_cast<char*>(blob->data()) + offset, length,
+                                                        free_blob_reference,
+                                                        new std::shared_ptr<const std::string>(blob)));
+  }
+
+  LOG(DEBUG) << "Sending the condition in " << reply.size() - 1 << " chunk(s), " << blob->size()
+             << (zip ? " compressed" : "") << " bytes";
+  fChannels.at("data-get").at(0).Send(reply);
 }
 
 ConditionsMQServer::~ConditionsMQServer() { delete fCdbManager; }
@@ -8,8 +8,31 @@
 #include <TSystem.h>      // for TSystem, gSystem
 #include "CCDB/Condition.h"    // for Condition
 
+#include <fcntl.h>    // for open, O_RDONLY
+#include <stdio.h>    // for fopen, fwrite, fclose
+#include <string.h>   // for memcpy, memcmp
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for close
+
 using namespace AliceO2::CDB;
 
+namespace {
+
+// on-disk header of a raw blob file, directly followed by the bare array
+struct RawBlobFileHeader {
+  char magic[8];       // identifies a raw blob file
+  Int_t headerVersion; // layout version of this header
+  Int_t type;          // element type, see FileStorage::ERawBlobType
+  Int_t elementSize;   // size of one element in bytes
+  Int_t reserved;      // keeps the payload 8-byte aligned
+  Long64_t count;      // number of elements
+};
+
+const char kRawBlobMagic[8] = { 'O', '2', 'C', 'D', 'B', 'R', 'A', 'W' };
+const Int_t kRawBlobHeaderVersion = 1;
+}
+
 ClassImp(FileStorage)
 
 FileStorage::FileStorage(const char *dbFile, Bool_t readOnly) : mFile(NULL), mReadOnly(readOnly)
@@ -34,12 +57,143 @@ FileStorage::~FileStorage()
 {
   // destructor
 
+  unmapRawBlobs();
+
   if (mFile) {
     mFile->Close();
     delete mFile;
   }
 }
 
+TString FileStorage::rawBlobFilename(const char *key) const
+{
+  // blob files live in a plain directory next to the FileStorage file
+
+  TString keyName(key);
+  keyName.ReplaceAll("/", "_");
+  return TString::Format("%s_blobs/%s.blob", mBaseFolder.Data(), keyName.Data());
+}
+
+Bool_t FileStorage::storeRawBlob(const char *key, const void *data, Long64_t count, Int_t type, Int_t elementSize)
+{
+  // write header and bare array to the blob file of the key
+
+  if (mReadOnly) {
+    LOG(ERROR) << "FileStorage is read only!" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  TString filename = rawBlobFilename(key);
+  TString dirName = gSystem->DirName(filename);
+  if (gSystem->AccessPathName(dirName) && gSystem->mkdir(dirName, kTRUE) < 0) {
+    LOG(ERROR) << "Can't create directory \"" << dirName.Data() << "\"!" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  FILE *blobFile = fopen(filename.Data(), "wb");
+  if (!blobFile) {
+    LOG(ERROR) << "Can't open file \"" << filename.Data() << "\" for writing!" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  RawBlobFileHeader header;
+  memcpy(header.magic, kRawBlobMagic, sizeof(header.magic));
+  header.headerVersion = kRawBlobHeaderVersion;
+  header.type = type;
+  header.elementSize = elementSize;
+  header.reserved = 0;
+  header.count = count;
+
+  size_t payloadSize = count * elementSize;
+  if (fwrite(&header, sizeof(header), 1, blobFile) != 1 ||
+      (payloadSize > 0 && fwrite(data, 1, payloadSize, blobFile) != payloadSize)) {
+    LOG(ERROR) << "Can't write blob \"" << key << "\" to \"" << filename.Data() << "\"!" << FairLogger::endl;
+    fclose(blobFile);
+    return kFALSE;
+  }
+
+  fclose(blobFile);
+
+  // drop a stale mapping of the previous content
+  std::map<std::string, RawBlobMapping>::iterator mapped = mRawBlobMappings.find(key);
+  if (mapped != mRawBlobMappings.end()) {
+    munmap(mapped->second.address, mapped->second.length);
+    mRawBlobMappings.erase(mapped);
+  }
+
+  return kTRUE;
+}
+
+const void *FileStorage::mapRawBlob(const char *key, Int_t type, Int_t elementSize, Long64_t &count)
+{
+  // map the blob file of the key read-only and return the payload address,
+  // reusing the mapping across calls
+
+  std::map<std::string, RawBlobMapping>::iterator mapped = mRawBlobMappings.find(key);
+  if (mapped == mRawBlobMappings.end()) {
+
+    TString filename = rawBlobFilename(key);
+    int fd = open(filename.Data(), O_RDONLY);
+    if (fd < 0) {
+      LOG(DEBUG) << "No raw blob stored under \"" << key << "\"." << FairLogger::endl;
+      return NULL;
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) < 0 || (size_t) fileInfo.st_size < sizeof(RawBlobFileHeader)) {
+      LOG(ERROR) << "Blob file \"" << filename.Data() << "\" is truncated!" << FairLogger::endl;
+      close(fd);
+      return NULL;
+    }
+
+    void *address = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+      LOG(ERROR) << "Can't map blob file \"" << filename.Data() << "\"!" << FairLogger::endl;
+      return NULL;
+    }
+
+    const RawBlobFileHeader *header = static_cast<const RawBlobFileHeader *>(address);
+    if (memcmp(header->magic, kRawBlobMagic, sizeof(header->magic)) != 0 ||
+        header->headerVersion != kRawBlobHeaderVersion ||
+        (size_t) fileInfo.st_size < sizeof(RawBlobFileHeader) + header->count * header->elementSize) {
+      LOG(ERROR) << "File \"" << filename.Data() << "\" is not a valid raw blob file!" << FairLogger::endl;
+      munmap(address, fileInfo.st_size);
+      return NULL;
+    }
+
+    RawBlobMapping mapping;
+    mapping.address = address;
+    mapping.length = fileInfo.st_size;
+    mapping.type = header->type;
+    mapping.elementSize = header->elementSize;
+    mapping.count = header->count;
+    mapped = mRawBlobMappings.insert(std::make_pair(std::string(key), mapping)).first;
+  }
+
+  const RawBlobMapping &mapping = mapped->second;
+  if (mapping.type != type || mapping.elementSize != elementSize) {
+    LOG(ERROR) << "Blob \"" << key << "\" was stored with element type " << mapping.type << " (size "
+               << mapping.elementSize << "), queried with type " << type << " (size " << elementSize << ")!"
+               << FairLogger::endl;
+    return NULL;
+  }
+
+  count = mapping.count;
+  return static_cast<const RawBlobFileHeader *>(mapping.address) + 1;
+}
+
+void FileStorage::unmapRawBlobs()
+{
+  // release all active raw blob mappings
+
+  for (std::map<std::string, RawBlobMapping>::iterator it = mRawBlobMappings.begin(); it != mRawBlobMappings.end();
+       ++it) {
+    munmap(it->second.address, it->second.length);
+  }
+  mRawBlobMappings.clear();
+}
+
 Bool_t FileStorage::keyNameToId(const char *keyname, IdRunRange &runRange, Int_t &version, Int_t &subVersion)
 {
   // build  ConditionId from keyname numbers
@@ -11,6 +11,11 @@
 #include "CCDB/Condition.h"          // for Condition
 #include "TSystem.h"            // for TSystem, gSystem
 
+#include <atomic>  // for atomic
+#include <string>  // for string
+#include <thread>  // for thread
+#include <vector>  // for vector
+
 using namespace AliceO2::CDB;
 
 ClassImp(GridStorage)
@@ -1185,6 +1190,105 @@ void GridStorage::queryValidFiles()
   delete res;
 }
 
+Int_t GridStorage::downloadValidFiles(Int_t maxParallel)
+{
+  // download the files of all objects valid for the current run into the local
+  // cache folder, several files at a time over the established grid connection
+
+  if (mCacheFolder == "") {
+    LOG(ERROR) << "No local cache folder set, cannot download!" << FairLogger::endl;
+    return 0;
+  }
+
+  if (mValidFileIds.GetEntriesFast() == 0) {
+    queryValidFiles();
+  }
+
+  // build the transfer list, skipping files already complete in the cache
+  std::vector<std::string> sources;
+  std::vector<std::string> targets;
+  TIter iter(&mValidFileIds);
+  ConditionId *validFileId = 0;
+  while ((validFileId = dynamic_cast<ConditionId *>(iter.Next()))) {
+    TString filename;
+    if (!idToFilename(*validFileId, filename)) {
+      continue;
+    }
+    filename.Prepend("/alien");
+    TString target = mCacheFolder + filename;
+    if (!gSystem->AccessPathName(target.Data())) {
+      LOG(DEBUG) << "File " << target.Data() << " already in cache" << FairLogger::endl;
+      continue;
+    }
+    sources.push_back(filename.Data());
+    targets.push_back(target.Data());
+  }
+
+  if (sources.empty()) {
+    LOG(INFO) << "All " << mValidFileIds.GetEntriesFast() << " valid files already in cache" << FairLogger::endl;
+    return 0;
+  }
+
+  // the workers share the grid connection established by the constructor and
+  // pull the next transfer from a common index
+  ROOT::EnableThreadSafety();
+
+  std::atomic<size_t> nextFile(0);
+  std::atomic<Int_t> nDownloaded(0);
+
+  auto worker = [&]() {
+    while (kTRUE) {
+      size_t iFile = nextFile++;
+      if (iFile >= sources.size()) {
+        break;
+      }
+
+      const std::string &source = sources[iFile];
+      const std::string &target = targets[iFile];
+
+      TString targetDir = gSystem->DirName(target.c_str());
+      if (gSystem->AccessPathName(targetDir.Data()) && gSystem->mkdir(targetDir.Data(), kTRUE) < 0) {
+        LOG(ERROR) << "Can't create cache directory \"" << targetDir.Data() << "\"!" << FairLogger::endl;
+        continue;
+      }
+
+      // stage into a .part file so an interrupted transfer never leaves a
+      // truncated file in the cache and is redone on the next call
+      TString partTarget(target.c_str());
+      partTarget += ".part";
+
+      if (TFile::Cp(source.c_str(), partTarget.Data(), kFALSE)) {
+        if (gSystem->Rename(partTarget.Data(), target.c_str()) == 0) {
+          nDownloaded++;
+        } else {
+          LOG(ERROR) << "Can't rename \"" << partTarget.Data() << "\"!" << FairLogger::endl;
+        }
+      } else {
+        LOG(ERROR) << "Download of \"" << source.c_str() << "\" failed!" << FairLogger::endl;
+        gSystem->Unlink(partTarget.Data());
+      }
+    }
+  };
+
+  if (maxParallel < 1) {
+    maxParallel = 1;
+  }
+  size_t nWorkers = sources.size() < (size_t) maxParallel ? sources.size() : (size_t) maxParallel;
+
+  std::vector<std::thread> pool;
+  for (size_t iWorker = 0; iWorker < nWorkers; iWorker++) {
+    pool.emplace_back(worker);
+  }
+  for (size_t iWorker = 0; iWorker < pool.size(); iWorker++) {
+    pool[iWorker].join();
+  }
+
+  LOG(INFO) << nDownloaded << " of " << sources.size() << " files downloaded into \"" << mCacheFolder.Data()
+            << "\" with " << nWorkers << " parallel transfers" << FairLogger::endl;
+
+  return nDownloaded;
+}
+
 void GridStorage::makeQueryFilter(Int_t firstRun, Int_t lastRun, const ConditionMetaData *md, TString &result) const
 {
   // create filter for file query
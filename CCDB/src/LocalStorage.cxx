@@ -1,18 +1,24 @@
 // access class to a DataBase in a local storage  			                       //
 
 #include "CCDB/LocalStorage.h"
+#include "CCDB/ConditionDelta.h"     // for ConditionDelta
 #include <FairLogger.h>         // for LOG
+#include <TBufferFile.h>        // for TBufferFile
 #include <TFile.h>              // for TFile
 #include <TObjString.h>         // for TObjString
 #include <TRegexp.h>            // for TRegexp
 #include <TSystem.h>            // for TSystem, gSystem
 #include "CCDB/Condition.h"          // for Condition
+#include <algorithm>            // for sort, upper_bound
+#include <stdio.h>              // for fopen, fgets, sscanf, fprintf
 
 using namespace AliceO2::CDB;
 
 ClassImp(LocalStorage)
 
-LocalStorage::LocalStorage(const char *baseDir) : mBaseDirectory(baseDir)
+LocalStorage::LocalStorage(const char *baseDir)
+  : mBaseDirectory(baseDir), mUseDeltas(kFALSE), mDeltaChainLimit(8), mShardSize(0), mUseCatalog(kFALSE),
+    mCatalogLoaded(kFALSE), mCatalog(), mCatalogMtime()
 {
   // constructor
 
@@ -96,37 +102,68 @@ Bool_t LocalStorage::idToFilename(const ConditionId &id, TString &filename) cons
 
   filename = Form("Run%d_%d_v%d_s%d.root", id.getFirstRun(), id.getLastRun(), id.getVersion(), id.getSubVersion());
 
+  TString shard = shardDirectory(id.getIdRunRange());
+  if (!shard.IsNull()) {
+    filename.Prepend(shard + '/');
+  }
   filename.Prepend(mBaseDirectory + '/' + id.getPathString() + '/');
 
   return kTRUE;
 }
 
+TString LocalStorage::shardDirectory(const IdRunRange &runRange) const
+{
+  // shard subdirectory of the run range, see setShardSize; ranges spanning
+  // several buckets (including the open-ended "any run" ranges) go to the
+  // wide shard, which every query examines in addition to its own bucket
+
+  if (mShardSize <= 0) {
+    return "";
+  }
+  Int_t firstBucket = runRange.getFirstRun() / mShardSize;
+  Int_t lastBucket = runRange.getLastRun() / mShardSize;
+  if (runRange.getFirstRun() < 0 || runRange.getLastRun() < 0 || firstBucket != lastBucket) {
+    return "shard_wide";
+  }
+  return Form("shard_%d", firstBucket);
+}
+
 Bool_t LocalStorage::prepareId(ConditionId &id)
 {
   // prepare id (version, subVersion) of the object that will be stored (called by putCondition)
 
   TString dirName = Form("%s/%s", mBaseDirectory.Data(), id.getPathString().Data());
 
-  // go to the path; if directory does not exist, create it
-  void *dirPtr = gSystem->OpenDirectory(dirName);
-  if (!dirPtr) {
-    gSystem->mkdir(dirName, kTRUE);
-    dirPtr = gSystem->OpenDirectory(dirName);
-
-    if (!dirPtr) {
-      LOG(ERROR) << "Can't create directory \"" << dirName.Data() << "\"!" << FairLogger::endl;
-      return kFALSE;
+  // candidate predecessors: the shard manifests in sharded mode, the files
+  // of the path directory otherwise
+  std::vector<CatalogEntry> candidates;
+
+  if (mShardSize > 0) {
+    // make sure the shard subdirectory of the new file exists
+    TString shardDir = Form("%s/%s", dirName.Data(), shardDirectory(id.getIdRunRange()).Data());
+    if (gSystem->AccessPathName(shardDir)) {
+      if (gSystem->mkdir(shardDir, kTRUE)) {
+        LOG(ERROR) << "Can't create directory \"" << shardDir.Data() << "\"!" << FairLogger::endl;
+        return kFALSE;
+      }
     }
-  }
-
-  const char *filename;
-  IdRunRange aIdRunRange;                         // the runRange got from filename
-  IdRunRange lastIdRunRange(-1, -1);              // highest runRange found
-  Int_t aVersion, aSubVersion;                // the version subVersion got from filename
-  Int_t lastVersion = 0, lastSubVersion = -1; // highest version and subVersion found
+    getShardEntries(id.getPathString(), id.getIdRunRange(), candidates);
+  } else {
+    // go to the path; if directory does not exist, create it
+    void *dirPtr = gSystem->OpenDirectory(dirName);
+    if (!dirPtr) {
+      gSystem->mkdir(dirName, kTRUE);
+      dirPtr = gSystem->OpenDirectory(dirName);
 
-  if (!id.hasVersion()) { // version not specified: look for highest version & subVersion
+      if (!dirPtr) {
+        LOG(ERROR) << "Can't create directory \"" << dirName.Data() << "\"!" << FairLogger::endl;
+        return kFALSE;
+      }
+    }
 
+    const char *filename;
+    IdRunRange aIdRunRange;      // the runRange got from filename
+    Int_t aVersion, aSubVersion; // the version subVersion got from filename
     while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on the files
 
       TString aString(filename);
@@ -138,21 +175,38 @@ Bool_t LocalStorage::prepareId(ConditionId &id)
         LOG(DEBUG) << "Bad filename <" << filename << ">! I'll skip it." << FairLogger::endl;
         continue;
       }
+      CatalogEntry candidate;
+      candidate.firstRun = aIdRunRange.getFirstRun();
+      candidate.lastRun = aIdRunRange.getLastRun();
+      candidate.version = aVersion;
+      candidate.subVersion = aSubVersion;
+      candidates.push_back(candidate);
+    }
+    gSystem->FreeDirectory(dirPtr);
+  }
+
+  IdRunRange lastIdRunRange(-1, -1);          // highest runRange found
+  Int_t lastVersion = 0, lastSubVersion = -1; // highest version and subVersion found
+
+  if (!id.hasVersion()) { // version not specified: look for highest version & subVersion
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+      IdRunRange aIdRunRange(candidates[i].firstRun, candidates[i].lastRun);
 
       if (!aIdRunRange.isOverlappingWith(id.getIdRunRange())) {
         continue;
       }
-      if (aVersion < lastVersion) {
+      if (candidates[i].version < lastVersion) {
         continue;
       }
-      if (aVersion > lastVersion) {
+      if (candidates[i].version > lastVersion) {
         lastSubVersion = -1;
       }
-      if (aSubVersion < lastSubVersion) {
+      if (candidates[i].subVersion < lastSubVersion) {
         continue;
       }
-      lastVersion = aVersion;
-      lastSubVersion = aSubVersion;
+      lastVersion = candidates[i].version;
+      lastSubVersion = candidates[i].subVersion;
       lastIdRunRange = aIdRunRange;
     }
 
@@ -161,21 +215,12 @@ Bool_t LocalStorage::prepareId(ConditionId &id)
 
   } else { // version specified, look for highest subVersion only
 
-    while ((filename = gSystem->GetDirEntry(dirPtr))) { // loop on the files
-
-      TString aString(filename);
-      if (aString == "." || aString == "..") {
-        continue;
-      }
-
-      if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
-        LOG(DEBUG) << "Bad filename <" << filename << ">!I'll skip it." << FairLogger::endl;
-        continue;
-      }
+    for (size_t i = 0; i < candidates.size(); i++) {
+      IdRunRange aIdRunRange(candidates[i].firstRun, candidates[i].lastRun);
 
-      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && aVersion == id.getVersion() &&
-          aSubVersion > lastSubVersion) {
-        lastSubVersion = aSubVersion;
+      if (aIdRunRange.isOverlappingWith(id.getIdRunRange()) && candidates[i].version == id.getVersion() &&
+          candidates[i].subVersion > lastSubVersion) {
+        lastSubVersion = candidates[i].subVersion;
         lastIdRunRange = aIdRunRange;
       }
     }
@@ -183,8 +228,6 @@ Bool_t LocalStorage::prepareId(ConditionId &id)
     id.setSubVersion(lastSubVersion + 1);
   }
 
-  gSystem->FreeDirectory(dirPtr);
-
   TString lastStorage = id.getLastStorage();
   if (lastStorage.Contains(TString("grid"), TString::kIgnoreCase) && id.getSubVersion() > 0) {
     LOG(ERROR) << "GridStorage to LocalStorage Storage error! local object with version v" << id.getVersion() << "_s"
@@ -231,6 +274,22 @@ ConditionId *LocalStorage::getId(const ConditionId &query)
     return result;
   }
 
+  // answer from the catalog index instead of listing the directory
+  if (mUseCatalog) {
+    return getIdFromCatalog(query);
+  }
+
+  // sharded layout: resolve from the manifests of the relevant shards
+  if (mShardSize > 0) {
+    std::vector<CatalogEntry> entries;
+    if (!getShardEntries(query.getPathString(), query.getIdRunRange(), entries)) {
+      LOG(DEBUG) << "Directory <" << (query.getPathString()).Data() << "> not found" << FairLogger::endl;
+      LOG(DEBUG) << "in DB folder " << mBaseDirectory.Data() << FairLogger::endl;
+      return NULL;
+    }
+    return resolveFromEntries(query, entries);
+  }
+
   // otherwise browse in the local filesystem CDB storage
   TString dirName = Form("%s/%s", mBaseDirectory.Data(), query.getPathString().Data());
 
@@ -374,6 +433,357 @@ ConditionId *LocalStorage::getId(const ConditionId &query)
   return result;
 }
 
+ConditionId *LocalStorage::getIdFromCatalog(const ConditionId &query)
+{
+  // look for a catalog entry matching query (same resolution rules as getId)
+
+  const std::vector<CatalogEntry> *entries = getCatalogForPath(query.getPathString());
+  if (!entries) {
+    LOG(DEBUG) << "Directory <" << (query.getPathString()).Data() << "> not found" << FairLogger::endl;
+    LOG(DEBUG) << "in DB folder " << mBaseDirectory.Data() << FairLogger::endl;
+    return NULL;
+  }
+
+  return resolveFromEntries(query, *entries);
+}
+
+ConditionId *LocalStorage::resolveFromEntries(const ConditionId &query, const std::vector<CatalogEntry> &entriesRef)
+{
+  // apply the getId resolution rules to entries sorted by first run, the
+  // common core of the catalog index and the shard manifest lookups
+
+  const std::vector<CatalogEntry> *entries = &entriesRef;
+
+  ConditionId *result = new ConditionId();
+  result->setPath(query.getPathString());
+
+  // entries are sorted by first run: files starting after the queried range cannot match
+  std::vector<CatalogEntry>::const_iterator stop =
+    std::upper_bound(entries->begin(), entries->end(), query.getFirstRun(),
+                     [](Int_t run, const CatalogEntry &entry) { return run < entry.firstRun; });
+
+  for (std::vector<CatalogEntry>::const_iterator it = entries->begin(); it != stop; ++it) {
+    IdRunRange aIdRunRange(it->firstRun, it->lastRun);
+    if (!aIdRunRange.isSupersetOf(query.getIdRunRange())) {
+      continue;
+    }
+
+    if (!query.hasVersion()) { // neither version and subversion specified -> look for highest version and subVersion
+      if (result->getVersion() < it->version) {
+        result->setVersion(it->version);
+        result->setSubVersion(it->subVersion);
+        result->setFirstRun(it->firstRun);
+        result->setLastRun(it->lastRun);
+      } else if (result->getVersion() == it->version && result->getSubVersion() < it->subVersion) {
+        result->setSubVersion(it->subVersion);
+        result->setFirstRun(it->firstRun);
+        result->setLastRun(it->lastRun);
+      } else if (result->getVersion() == it->version && result->getSubVersion() == it->subVersion) {
+        LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << it->version << "_"
+                   << it->subVersion << "!" << FairLogger::endl;
+        delete result;
+        return NULL;
+      }
+    } else if (!query.hasSubVersion()) { // version specified but not subversion -> look for highest subVersion
+      result->setVersion(query.getVersion());
+      if (query.getVersion() != it->version) {
+        continue;
+      }
+      if (result->getSubVersion() == it->subVersion) {
+        LOG(ERROR) << "More than one object valid for run " << query.getFirstRun() << " version " << it->version << "_"
+                   << it->subVersion << "!" << FairLogger::endl;
+        delete result;
+        return NULL;
+      }
+      if (result->getSubVersion() < it->subVersion) {
+        result->setSubVersion(it->subVersion);
+        result->setFirstRun(it->firstRun);
+        result->setLastRun(it->lastRun);
+      }
+    } else { // both version and subversion specified
+      if (query.getVersion() != it->version || query.getSubVersion() != it->subVersion) {
+        continue;
+      }
+      result->setVersion(it->version);
+      result->setSubVersion(it->subVersion);
+      result->setFirstRun(it->firstRun);
+      result->setLastRun(it->lastRun);
+      break;
+    }
+  }
+
+  return result;
+}
+
+const std::vector<LocalStorage::CatalogEntry> *LocalStorage::getCatalogForPath(const TString &pathString)
+{
+  if (!mCatalogLoaded) {
+    loadCatalogFile();
+    mCatalogLoaded = kTRUE;
+  }
+
+  TString dirName = Form("%s/%s", mBaseDirectory.Data(), pathString.Data());
+  Long_t id = 0, size = 0, flags = 0, modtime = 0;
+  if (gSystem->GetPathInfo(dirName, &id, &size, &flags, &modtime) != 0) {
+    return NULL; // directory does not exist
+  }
+
+  std::string key = pathString.Data();
+  std::map<std::string, Long_t>::iterator mtime = mCatalogMtime.find(key);
+  if (mtime == mCatalogMtime.end() || mtime->second != modtime) {
+    LOG(DEBUG) << "Catalog for path " << pathString.Data() << " is missing or outdated, rescanning directory"
+               << FairLogger::endl;
+    scanDirectoryForCatalog(pathString, mCatalog[key]);
+    mCatalogMtime[key] = modtime;
+    saveCatalogFile();
+  }
+
+  return &mCatalog[key];
+}
+
+void LocalStorage::scanDirectoryForCatalog(const TString &pathString, std::vector<CatalogEntry> &entries)
+{
+  entries.clear();
+
+  TString dirName = Form("%s/%s", mBaseDirectory.Data(), pathString.Data());
+  void *dirPtr = gSystem->OpenDirectory(dirName);
+  if (!dirPtr) {
+    return;
+  }
+
+  const char *filename;
+  IdRunRange aIdRunRange;
+  Int_t aVersion, aSubVersion;
+  while ((filename = gSystem->GetDirEntry(dirPtr))) {
+    TString aString(filename);
+    if (aString.BeginsWith('.')) {
+      continue;
+    }
+    if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
+      continue;
+    }
+    CatalogEntry entry;
+    entry.firstRun = aIdRunRange.getFirstRun();
+    entry.lastRun = aIdRunRange.getLastRun();
+    entry.version = aVersion;
+    entry.subVersion = aSubVersion;
+    entries.push_back(entry);
+  }
+  gSystem->FreeDirectory(dirPtr);
+
+  std::sort(entries.begin(), entries.end(), [](const CatalogEntry &a, const CatalogEntry &b) {
+    if (a.firstRun != b.firstRun) {
+      return a.firstRun < b.firstRun;
+    }
+    if (a.version != b.version) {
+      return a.version < b.version;
+    }
+    return a.subVersion < b.subVersion;
+  });
+}
+
+Bool_t LocalStorage::getShardEntries(const TString &pathString, const IdRunRange &runRange,
+                                     std::vector<CatalogEntry> &entries)
+{
+  // manifest entries a query of the run range must examine: files of the
+  // buckets the range touches plus the wide shard; kFALSE if the path
+  // directory itself does not exist
+
+  entries.clear();
+
+  TString dirName = Form("%s/%s", mBaseDirectory.Data(), pathString.Data());
+  Long_t id = 0, size = 0, flags = 0, modtime = 0;
+  if (gSystem->GetPathInfo(dirName, &id, &size, &flags, &modtime) != 0) {
+    return kFALSE; // path directory does not exist
+  }
+
+  Int_t firstBucket = runRange.getFirstRun() < 0 ? 0 : runRange.getFirstRun() / mShardSize;
+  Int_t lastBucket = runRange.getLastRun() < 0 ? firstBucket : runRange.getLastRun() / mShardSize;
+  const Int_t kMaxBucketProbe = 1024;
+  if (lastBucket - firstBucket > kMaxBucketProbe) {
+    // open-ended query (e.g. lastRun = infinity): enumerate the shards that
+    // actually exist instead of probing every bucket of the range
+    void *dirPtr = gSystem->OpenDirectory(dirName);
+    const char *sub;
+    while (dirPtr && (sub = gSystem->GetDirEntry(dirPtr))) {
+      TString subStr(sub);
+      if (!subStr.BeginsWith("shard_") || subStr == "shard_wide") {
+        continue;
+      }
+      Int_t bucket = atoi(subStr.Data() + sizeof("shard_") - 1);
+      if (bucket >= firstBucket && bucket <= lastBucket) {
+        loadShardManifest(pathString, subStr, entries);
+      }
+    }
+    if (dirPtr) {
+      gSystem->FreeDirectory(dirPtr);
+    }
+  } else {
+    for (Int_t bucket = firstBucket; bucket <= lastBucket; bucket++) {
+      loadShardManifest(pathString, Form("shard_%d", bucket), entries);
+    }
+  }
+  loadShardManifest(pathString, "shard_wide", entries);
+
+  // keep the sorting contract of the catalog entries for resolveFromEntries
+  std::sort(entries.begin(), entries.end(), [](const CatalogEntry &a, const CatalogEntry &b) {
+    if (a.firstRun != b.firstRun) {
+      return a.firstRun < b.firstRun;
+    }
+    if (a.version != b.version) {
+      return a.version < b.version;
+    }
+    return a.subVersion < b.subVersion;
+  });
+
+  return kTRUE;
+}
+
+void LocalStorage::loadShardManifest(const TString &pathString, const TString &shard,
+                                     std::vector<CatalogEntry> &entries)
+{
+  // the manifest lives next to the shard directory (not inside it, so
+  // rewriting it does not touch the mtime it is validated against)
+
+  TString shardDir = Form("%s/%s/%s", mBaseDirectory.Data(), pathString.Data(), shard.Data());
+  Long_t id = 0, size = 0, flags = 0, modtime = 0;
+  if (gSystem->GetPathInfo(shardDir, &id, &size, &flags, &modtime) != 0) {
+    return; // shard does not exist, nothing stored for this bucket yet
+  }
+
+  TString manifestName = Form("%s/%s/.manifest_%s", mBaseDirectory.Data(), pathString.Data(), shard.Data());
+  FILE *stream = fopen(manifestName.Data(), "r");
+  if (stream) {
+    char line[256];
+    Long_t storedMtime = -1;
+    CatalogEntry entry;
+    Bool_t fresh = kFALSE;
+    while (fgets(line, sizeof(line), stream)) {
+      if (line[0] == '#') {
+        continue;
+      }
+      if (storedMtime < 0) {
+        storedMtime = atol(line);
+        if (storedMtime != modtime) {
+          break; // outdated, rescan below
+        }
+        fresh = kTRUE;
+        continue;
+      }
+      if (sscanf(line, "%d %d %d %d", &entry.firstRun, &entry.lastRun, &entry.version, &entry.subVersion) == 4) {
+        entries.push_back(entry);
+      }
+    }
+    fclose(stream);
+    if (fresh) {
+      return;
+    }
+    LOG(DEBUG) << "Manifest of shard " << shard.Data() << " of path " << pathString.Data()
+               << " is outdated, rescanning" << FairLogger::endl;
+  }
+
+  // missing or outdated manifest: rescan the shard directory and rewrite it
+  void *dirPtr = gSystem->OpenDirectory(shardDir);
+  if (!dirPtr) {
+    return;
+  }
+  std::vector<CatalogEntry> scanned;
+  const char *filename;
+  IdRunRange aIdRunRange;
+  Int_t aVersion, aSubVersion;
+  while ((filename = gSystem->GetDirEntry(dirPtr))) {
+    TString aString(filename);
+    if (aString.BeginsWith('.')) {
+      continue;
+    }
+    if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
+      continue;
+    }
+    CatalogEntry entry;
+    entry.firstRun = aIdRunRange.getFirstRun();
+    entry.lastRun = aIdRunRange.getLastRun();
+    entry.version = aVersion;
+    entry.subVersion = aSubVersion;
+    scanned.push_back(entry);
+  }
+  gSystem->FreeDirectory(dirPtr);
+
+  std::sort(scanned.begin(), scanned.end(), [](const CatalogEntry &a, const CatalogEntry &b) {
+    if (a.firstRun != b.firstRun) {
+      return a.firstRun < b.firstRun;
+    }
+    if (a.version != b.version) {
+      return a.version < b.version;
+    }
+    return a.subVersion < b.subVersion;
+  });
+
+  stream = fopen(manifestName.Data(), "w");
+  if (stream) {
+    fprintf(stream, "# LocalStorage shard manifest: dirMtime, then firstRun lastRun version subVersion per file\n");
+    fprintf(stream, "%ld\n", modtime);
+    for (size_t i = 0; i < scanned.size(); i++) {
+      fprintf(stream, "%d %d %d %d\n", scanned[i].firstRun, scanned[i].lastRun, scanned[i].version,
+              scanned[i].subVersion);
+    }
+    fclose(stream);
+  } else {
+    LOG(WARNING) << "Cannot write shard manifest " << manifestName.Data() << FairLogger::endl;
+  }
+
+  entries.insert(entries.end(), scanned.begin(), scanned.end());
+}
+
+void LocalStorage::loadCatalogFile()
+{
+  TString catalogName = Form("%s/.ccdb_catalog", mBaseDirectory.Data());
+  FILE *stream = fopen(catalogName.Data(), "r");
+  if (!stream) {
+    return; // no catalog yet, will be built on demand
+  }
+
+  char line[600];
+  char path[512];
+  Long_t modtime;
+  CatalogEntry entry;
+  while (fgets(line, sizeof(line), stream)) {
+    if (line[0] == '#') {
+      continue;
+    }
+    if (sscanf(line, "%511s %ld %d %d %d %d", path, &modtime, &entry.firstRun, &entry.lastRun, &entry.version,
+               &entry.subVersion) == 6) {
+      mCatalog[path].push_back(entry);
+      mCatalogMtime[path] = modtime;
+    }
+  }
+  fclose(stream);
+  LOG(DEBUG) << "Loaded catalog index with " << Int_t(mCatalog.size()) << " paths from " << catalogName.Data()
+             << FairLogger::endl;
+}
+
+void LocalStorage::saveCatalogFile() const
+{
+  TString catalogName = Form("%s/.ccdb_catalog", mBaseDirectory.Data());
+  FILE *stream = fopen(catalogName.Data(), "w");
+  if (!stream) {
+    LOG(WARNING) << "Cannot write catalog index " << catalogName.Data() << FairLogger::endl;
+    return;
+  }
+
+  fprintf(stream, "# LocalStorage catalog: path dirMtime firstRun lastRun version subVersion\n");
+  for (std::map<std::string, std::vector<CatalogEntry>>::const_iterator it = mCatalog.begin(); it != mCatalog.end();
+       ++it) {
+    std::map<std::string, Long_t>::const_iterator mtime = mCatalogMtime.find(it->first);
+    Long_t modtime = mtime != mCatalogMtime.end() ? mtime->second : 0;
+    for (size_t i = 0; i < it->second.size(); i++) {
+      const CatalogEntry &entry = it->second[i];
+      fprintf(stream, "%s %ld %d %d %d %d\n", it->first.c_str(), modtime, entry.firstRun, entry.lastRun, entry.version,
+              entry.subVersion);
+    }
+  }
+  fclose(stream);
+}
+
 Condition *LocalStorage::getCondition(const ConditionId &queryId)
 {
   // get  Condition from the storage (the CDB file matching the query is
@@ -408,6 +818,10 @@ Condition *LocalStorage::getCondition(const ConditionId &queryId)
   // the object in the file is an  Condition entry named " Condition"
 
   Condition *anCondition = dynamic_cast<Condition *>(file.Get(" Condition"));
+  if (!anCondition) {
+    // delta-mode file: reconstruct the object through its diff chain
+    anCondition = getConditionFromDelta(filename);
+  }
   if (!anCondition) {
     LOG(ERROR) << "Bad storage data: No  Condition in file!" << FairLogger::endl;
     file.Close();
@@ -549,6 +963,40 @@ void LocalStorage::getEntriesForLevel1(const char *level0, const char *level1, c
 
       ConditionId entryId(entryPath, queryId.getIdRunRange(), queryId.getVersion(), queryId.getSubVersion());
 
+      if (mShardSize > 0) {
+        // sharded layout: match against the shard manifests instead of the filenames
+
+        // skip if result already contains an entry for this path
+        Bool_t alreadyLoaded = kFALSE;
+        Int_t nEntries = result->GetEntries();
+        for (int i = 0; i < nEntries; i++) {
+          Condition *lCondition = (Condition *) result->At(i);
+          ConditionId lId = lCondition->getId();
+          TString lIdPath = lId.getPathString();
+          if (lIdPath.EqualTo(entryPath.getPathString())) {
+            alreadyLoaded = kTRUE;
+            break;
+          }
+        }
+        if (alreadyLoaded)
+          continue;
+
+        std::vector<CatalogEntry> entries;
+        getShardEntries(entryPath.getPathString(), queryId.getIdRunRange(), entries);
+        for (size_t i = 0; i < entries.size(); i++) {
+          IdRunRange rr(entries[i].firstRun, entries[i].lastRun);
+          if (queryId.hasVersion() && entries[i].version != queryId.getVersion())
+            continue;
+          if (queryId.hasSubVersion() && entries[i].subVersion != queryId.getSubVersion())
+            continue;
+          if (rr.isSupersetOf(queryId.getIdRunRange())) {
+            result->Add(getCondition(entryId));
+            break;
+          }
+        }
+        continue;
+      }
+
       // check filenames to see if any includes queryId.getIdRunRange()
       void *level2DirPtr = gSystem->OpenDirectory(fullPath);
       if (!level2DirPtr) {
@@ -737,6 +1185,10 @@ Bool_t LocalStorage::putCondition(Condition *entry, const char *mirrors)
     LOG(WARNING) << " LocalStorage storage cannot take mirror SEs into account. They will be ignored." <<
                  FairLogger::endl;
 
+  if (mUseDeltas) {
+    return putConditionDelta(entry, id, filename);
+  }
+
   // open file
   TFile file(filename, "CREATE");
   if (!file.IsOpen()) {
@@ -763,6 +1215,225 @@ Bool_t LocalStorage::putCondition(Condition *entry, const char *mirrors)
   return result;
 }
 
+namespace {
+
+// exact serialized bytes of a condition entry, the unit the deltas work on
+Bool_t serializeCondition(Condition *entry, std::string &bytes)
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  if (buffer.WriteObjectAny(entry, Condition::Class()) != 1) {
+    return kFALSE;
+  }
+  bytes.assign(buffer.Buffer(), buffer.Length());
+  return kTRUE;
+}
+
+Condition *deserializeCondition(const std::string &bytes)
+{
+  TBufferFile buffer(TBuffer::kRead, bytes.size(), const_cast<char *>(bytes.data()), kFALSE);
+  return static_cast<Condition *>(buffer.ReadObjectAny(Condition::Class()));
+}
+}
+
+Bool_t LocalStorage::putConditionDelta(Condition *entry, const ConditionId &id, const TString &filename)
+{
+  // delta-mode storing, see setUseDeltas: the new object is diffed against
+  // the latest stored version of the same path and run range; when no
+  // predecessor exists, the chain reached its limit or the diff does not
+  // pay off, the version is stored full and anchors a new chain
+
+  entry->setVersion(id.getVersion());
+  entry->setSubVersion(id.getSubVersion());
+
+  std::string objectBytes;
+  if (!serializeCondition(entry, objectBytes)) {
+    LOG(ERROR) << "Can't serialize entry for file: " << filename.Data() << FairLogger::endl;
+    return kFALSE;
+  }
+
+  TString baseKeyName;
+  std::string baseBytes;
+  Int_t baseChain = 0;
+  Bool_t haveBase = latestVersionFile(id, baseKeyName);
+  if (haveBase) {
+    // the base lives in the same directory as the new file (the shard
+    // subdirectory in sharded mode, the path directory otherwise)
+    TString baseFilename = Form("%s/%s", gSystem->DirName(filename.Data()), baseKeyName.Data());
+    haveBase = readConditionBytes(baseFilename, baseBytes, baseChain);
+  }
+
+  ConditionDelta *delta = 0;
+  if (haveBase && baseChain < mDeltaChainLimit) {
+    std::string diff;
+    ConditionDelta::encode(baseBytes, objectBytes, diff);
+    // store the diff only when it actually saves space
+    if (diff.size() < objectBytes.size() / 2) {
+      delta = new ConditionDelta(baseKeyName, baseChain + 1, diff, ConditionDelta::checksum(baseBytes));
+    }
+  }
+  if (!delta) {
+    // rebase: the anchor carries the exact serialized bytes of the object
+    delta = new ConditionDelta("", 0, objectBytes, 0);
+  }
+
+  TFile file(filename, "CREATE");
+  if (!file.IsOpen()) {
+    LOG(ERROR) << "Can't open file <" << filename.Data() << ">!" << FairLogger::endl;
+    delete delta;
+    return kFALSE;
+  }
+
+  Bool_t result = kTRUE;
+  if (delta->getBaseFile().IsNull()) {
+    // anchors also keep the regular object so delta-unaware readers can open them
+    result &= file.WriteTObject(entry, " Condition") > 0;
+  }
+  result &= file.WriteTObject(delta, " ConditionDelta") > 0;
+  file.Close();
+
+  if (result) {
+    if (!(id.getPathString().Contains("SHUTTLE/STATUS"))) {
+      LOG(INFO) << "CDB object stored into file \"" << filename.Data() << "\" as "
+                << (delta->getBaseFile().IsNull() ? "chain anchor" : "delta") << FairLogger::endl;
+    }
+  } else {
+    LOG(DEBUG) << "Can't write entry to file: " << filename.Data() << FairLogger::endl;
+  }
+  delete delta;
+
+  return result;
+}
+
+Condition *LocalStorage::getConditionFromDelta(const TString &filename)
+{
+  std::string bytes;
+  Int_t chainLength = 0;
+  if (!readConditionBytes(filename, bytes, chainLength)) {
+    return NULL;
+  }
+  return deserializeCondition(bytes);
+}
+
+Bool_t LocalStorage::readConditionBytes(const TString &filename, std::string &bytes, Int_t &chainLength)
+{
+  TFile file(filename, "READ");
+  if (!file.IsOpen()) {
+    LOG(DEBUG) << "Can't open file <" << filename.Data() << ">!" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  ConditionDelta *delta = dynamic_cast<ConditionDelta *>(file.Get(" ConditionDelta"));
+  if (!delta) {
+    // regular file: the stored object anchors an implicit chain; its
+    // re-serialized bytes are what a diff against it was computed on
+    Condition *entry = dynamic_cast<Condition *>(file.Get(" Condition"));
+    if (!entry) {
+      return kFALSE;
+    }
+    chainLength = 0;
+    Bool_t result = serializeCondition(entry, bytes);
+    delete entry;
+    return result;
+  }
+
+  chainLength = delta->getChainLength();
+  if (delta->getBaseFile().IsNull()) {
+    // chain anchor, carries the full bytes
+    bytes.assign(delta->getDelta().begin(), delta->getDelta().end());
+    delete delta;
+    return kTRUE;
+  }
+
+  // reconstruct the base through the chain, then apply the diff
+  TString baseFilename = Form("%s/%s", gSystem->DirName(filename.Data()), delta->getBaseFile().Data());
+  std::string baseBytes;
+  Int_t baseChain = 0;
+  if (!readConditionBytes(baseFilename, baseBytes, baseChain)) {
+    delete delta;
+    return kFALSE;
+  }
+  if (ConditionDelta::checksum(baseBytes) != delta->getBaseChecksum()) {
+    LOG(ERROR) << "Delta base <" << baseFilename.Data() << "> does not match the stored checksum!" << FairLogger::endl;
+    delete delta;
+    return kFALSE;
+  }
+  const std::string diff(delta->getDelta().begin(), delta->getDelta().end());
+  Bool_t result = ConditionDelta::apply(baseBytes, diff, bytes);
+  if (!result) {
+    LOG(ERROR) << "Malformed delta in file <" << filename.Data() << ">!" << FairLogger::endl;
+  }
+  delete delta;
+  return result;
+}
+
+Bool_t LocalStorage::latestVersionFile(const ConditionId &id, TString &keyName)
+{
+  // file of the latest stored version overlapping the run range of the id,
+  // the candidate base of a new diff; the file of the id itself does not
+  // exist yet when this is called from putConditionDelta
+
+  if (mShardSize > 0) {
+    // diff chains never cross shards: the base comes from the shard of the
+    // new file itself, so the chain resolves within one directory
+    std::vector<CatalogEntry> entries;
+    loadShardManifest(id.getPathString(), shardDirectory(id.getIdRunRange()), entries);
+
+    Int_t lastVersion = -1, lastSubVersion = -1;
+    Bool_t found = kFALSE;
+    for (size_t i = 0; i < entries.size(); i++) {
+      IdRunRange aIdRunRange(entries[i].firstRun, entries[i].lastRun);
+      if (!aIdRunRange.isOverlappingWith(id.getIdRunRange())) {
+        continue;
+      }
+      if (entries[i].version < lastVersion ||
+          (entries[i].version == lastVersion && entries[i].subVersion <= lastSubVersion)) {
+        continue;
+      }
+      lastVersion = entries[i].version;
+      lastSubVersion = entries[i].subVersion;
+      keyName = Form("Run%d_%d_v%d_s%d.root", entries[i].firstRun, entries[i].lastRun, entries[i].version,
+                     entries[i].subVersion);
+      found = kTRUE;
+    }
+    return found;
+  }
+
+  TString dirName = Form("%s/%s", mBaseDirectory.Data(), id.getPathString().Data());
+  void *dirPtr = gSystem->OpenDirectory(dirName);
+  if (!dirPtr) {
+    return kFALSE;
+  }
+
+  const char *filename;
+  IdRunRange aIdRunRange;
+  Int_t aVersion, aSubVersion;
+  Int_t lastVersion = -1, lastSubVersion = -1;
+  Bool_t found = kFALSE;
+
+  while ((filename = gSystem->GetDirEntry(dirPtr))) {
+    TString aString(filename);
+    if (aString == "." || aString == "..") {
+      continue;
+    }
+    if (!filenameToId(filename, aIdRunRange, aVersion, aSubVersion)) {
+      continue;
+    }
+    if (!aIdRunRange.isOverlappingWith(id.getIdRunRange())) {
+      continue;
+    }
+    if (aVersion < lastVersion || (aVersion == lastVersion && aSubVersion <= lastSubVersion)) {
+      continue;
+    }
+    lastVersion = aVersion;
+    lastSubVersion = aSubVersion;
+    keyName = aString;
+    found = kTRUE;
+  }
+  gSystem->FreeDirectory(dirPtr);
+
+  return found;
+}
+
 TList *LocalStorage::getIdListFromFile(const char *fileName)
 {
 
@@ -874,6 +1545,38 @@ void LocalStorage::queryValidFiles()
             }
 
             if (mPathFilter.doesLevel2Contain(level2)) {
+              if (mShardSize > 0) {
+                // sharded layout: only the shard of the run plus the wide
+                // shard are read, through their manifests
+                TString pathString = Form("%s/%s/%s", level0, level1, level2);
+                IdRunRange runrg(mRun, mRun);
+                std::vector<CatalogEntry> entries;
+                getShardEntries(pathString, runrg, entries);
+
+                IdRunRange hvIdRunRange;
+                Int_t highestV = -1, highestSubV = -1;
+                for (size_t i = 0; i < entries.size(); i++) {
+                  IdRunRange aIdRunRange(entries[i].firstRun, entries[i].lastRun);
+                  if (!aIdRunRange.isSupersetOf(runrg)) {
+                    continue;
+                  }
+                  if (entries[i].version > highestV) {
+                    highestV = entries[i].version;
+                    highestSubV = entries[i].subVersion;
+                    hvIdRunRange = aIdRunRange;
+                  } else if (entries[i].version == highestV && entries[i].subVersion > highestSubV) {
+                    highestSubV = entries[i].subVersion;
+                    hvIdRunRange = aIdRunRange;
+                  }
+                }
+                if (highestV >= 0) {
+                  IdPath validPath(level0, level1, level2);
+                  ConditionId *validId = new ConditionId(validPath, hvIdRunRange, highestV, highestSubV);
+                  mValidFileIds.AddLast(validId);
+                }
+                continue;
+              }
+
               TString dirName = Form("%s/%s/%s/%s", mBaseDirectory.Data(), level0, level1, level2);
 
               void *dirPtr = gSystem->OpenDirectory(dirName);
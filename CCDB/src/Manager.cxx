@@ -8,12 +8,120 @@
 #include <TSAXParser.h>    // for TSAXParser
 #include <TUUID.h>         // for TUUID
 #include "CCDB/Condition.h"     // for Condition
+#include "CCDB/ConditionShmCache.h" // for ConditionShmCache
 #include "CCDB/FileStorage.h"   // for FileStorageFactory
 #include "CCDB/GridStorage.h"   // for GridStorageFactory
 #include "CCDB/LocalStorage.h"  // for LocalStorageFactory
 #include "TFile.h"         // for TFile
+#include "TROOT.h"         // for ROOT::EnableThreadSafety
 #include "TSystem.h"       // for TSystem, gSystem
 #include "CCDB/XmlHandler.h"    // for XmlHandler
+#include "MemoryArena/MemoryAccountant.h" // for MemoryAccountant
+#include <algorithm>       // for min
+#include <atomic>          // for atomic
+#include <mutex>           // for mutex, lock_guard
+#include <thread>          // for thread
+
+namespace AliceO2 {
+namespace CDB {
+
+/// Sharded reader-writer index over the condition cache of the Manager.
+/// The cache-hit path of getObject reads it without any global lock: the
+/// path hash selects a shard and its lock word admits any number of readers
+/// while a writer is exclusive, so concurrent lookups of different (and of
+/// identical) paths never serialize against each other. Writes are rare --
+/// one per first retrieval of a path -- so the lock word is a simple spin
+/// structure. The authoritative TMap of the Manager stays the owner of the
+/// objects (it is what snapshots stream); every mutation of it updates the
+/// index alongside under mManagerGuard
+class ConditionCacheIndex
+{
+  public:
+    Condition *lookup(const TString &path)
+    {
+      Shard &shard = mShards[path.Hash() % kShards];
+      shard.lockShared();
+      std::map<std::string, Condition *>::const_iterator it = shard.mEntries.find(path.Data());
+      Condition *entry = (it == shard.mEntries.end()) ? 0 : it->second;
+      shard.unlockShared();
+      return entry;
+    }
+
+    void insert(const TString &path, Condition *entry)
+    {
+      Shard &shard = mShards[path.Hash() % kShards];
+      shard.lockExclusive();
+      shard.mEntries[path.Data()] = entry;
+      shard.unlockExclusive();
+    }
+
+    void remove(const TString &path)
+    {
+      Shard &shard = mShards[path.Hash() % kShards];
+      shard.lockExclusive();
+      shard.mEntries.erase(path.Data());
+      shard.unlockExclusive();
+    }
+
+    void clear()
+    {
+      for (Int_t i = 0; i < kShards; i++) {
+        mShards[i].lockExclusive();
+        mShards[i].mEntries.clear();
+        mShards[i].unlockExclusive();
+      }
+    }
+
+    std::mutex mManagerGuard; // serializes the slow path of getObject and the cache mutations
+
+  private:
+    static const Int_t kShards = 16;
+
+    struct Shard {
+      Shard() : mLockWord(0)
+      {
+      }
+
+      void lockShared()
+      {
+        for (;;) {
+          Int_t word = mLockWord.load(std::memory_order_relaxed);
+          if (word >= 0 && mLockWord.compare_exchange_weak(word, word + 1, std::memory_order_acquire)) {
+            return;
+          }
+          std::this_thread::yield();
+        }
+      }
+
+      void unlockShared()
+      {
+        mLockWord.fetch_sub(1, std::memory_order_release);
+      }
+
+      void lockExclusive()
+      {
+        for (;;) {
+          Int_t word = 0;
+          if (mLockWord.compare_exchange_weak(word, -1, std::memory_order_acquire)) {
+            return;
+          }
+          std::this_thread::yield();
+        }
+      }
+
+      void unlockExclusive()
+      {
+        mLockWord.store(0, std::memory_order_release);
+      }
+
+      std::atomic<Int_t> mLockWord;                // >0: active readers, -1: a writer
+      std::map<std::string, Condition *> mEntries; // path -> cached object
+    };
+
+    Shard mShards[kShards];
+};
+}
+}
 
 using namespace AliceO2::CDB;
 
@@ -64,6 +172,7 @@ void Manager::initFromCache(TMap *entryCache, Int_t run)
 
   while ((pair = dynamic_cast<TPair *>(iter.Next()))) {
     mConditionCache.Add(pair->Key(), pair->Value());
+    mCacheIndex->insert(pair->Key()->GetName(), dynamic_cast<Condition *>(pair->Value()));
   }
   // mCondition is the new owner of the cache
   mConditionCache.SetOwnerKeyValue(kTRUE, kTRUE);
@@ -244,6 +353,7 @@ Bool_t Manager::initFromSnapshot(const char *snapshotFileName, Bool_t overwrite)
         unloadFromCache(path.Data());
       }
       mConditionCache.Add(pair->Key(), pair->Value());
+      mCacheIndex->insert(path, dynamic_cast<Condition *>(pair->Value()));
       mIds->Add(id);
       nAdded++;
     } else {
@@ -252,6 +362,7 @@ Bool_t Manager::initFromSnapshot(const char *snapshotFileName, Bool_t overwrite)
                      << "\". Not adding this object from snapshot" << FairLogger::endl;
       } else {
         mConditionCache.Add(pair->Key(), pair->Value());
+        mCacheIndex->insert(path, dynamic_cast<Condition *>(pair->Value()));
         mIds->Add(id);
         nAdded++;
       }
@@ -287,6 +398,8 @@ Manager::Manager()
     mActiveStorages(),
     mSpecificStorages(),
     mConditionCache(),
+    mCacheIndex(new ConditionCacheIndex),
+    mShmCache(0),
     mIds(0),
     mStorageMap(0),
     mDefaultStorage(NULL),
@@ -298,12 +411,15 @@ Manager::Manager()
     mLock(kFALSE),
     mSnapshotMode(kFALSE),
     mSnapshotFile(0),
+    mFrozen(kFALSE),
+    mFrozenConditions(),
     mOcdbUploadMode(kFALSE),
     mRaw(kFALSE),
     mCvmfsOcdb(""),
     mStartRunLhcPeriod(-1),
     mEndRunLhcPeriod(-1),
     mLhcPeriod(""),
+    mMemoryScopeId(-1),
     mKey(0)
 {
   // default constuctor
@@ -323,6 +439,8 @@ Manager::~Manager()
 {
   // destructor
   clearCache();
+  delete mCacheIndex;
+  mCacheIndex = 0;
   destroyActiveStorages();
   mFactories.Delete();
   mdrainStorage = 0x0;
@@ -333,12 +451,24 @@ Manager::~Manager()
   mIds = 0;
   delete mOfficialStorageParameters;
   delete mReferenceStorageParameters;
+  delete mShmCache;
+  mShmCache = 0;
   if (mSnapshotMode) {
     mSnapshotFile->Close();
     mSnapshotFile = 0;
   }
 }
 
+void Manager::setShmCacheFlag(Bool_t shmCacheFlag)
+{
+  if (shmCacheFlag && !mShmCache) {
+    mShmCache = new ConditionShmCache();
+  } else if (!shmCacheFlag) {
+    delete mShmCache;
+    mShmCache = 0;
+  }
+}
+
 void Manager::putActiveStorage(StorageParameters *param, Storage *storage)
 {
   // put a storage object into the list of active storages
@@ -733,6 +863,17 @@ void Manager::getLHCPeriodAgainstAlienFile(Int_t run, TString &lhcPeriod, Int_t
 {
   // set LHC period (year + first, last run) comparing run number and AliEn XML file
 
+  // a compiled binary index of the XML resolves the folder with a binary
+  // search, skipping the alien copy and the XML parse after the first call;
+  // a run beyond the compiled ranges falls through to a fresh copy below
+  TString indexFile = Form("%s/OCDBFolderXML.index", gSystem->TempDirectory());
+  if (XmlHandler::lookupIndex(indexFile.Data(), run, lhcPeriod, startRun, endRun)) {
+    LOG(INFO) << " LHC folder = " << lhcPeriod.Data() << " (from compiled index)" << FairLogger::endl;
+    LOG(INFO) << " LHC period start run = " << startRun << FairLogger::endl;
+    LOG(INFO) << " LHC period end run = " << endRun << FairLogger::endl;
+    return;
+  }
+
   // retrieve XML file from alien
   if (!gGrid) {
     TGrid::Connect("alien://", "");
@@ -750,6 +891,14 @@ void Manager::getLHCPeriodAgainstAlienFile(Int_t run, TString &lhcPeriod, Int_t
   if (!TFile::Cp(sOcdbFolderXmlFile.Data(), rndname.Data())) {
     LOG(FATAL) << "Cannot make a local copy of OCDBFolder xml file in " << rndname.Data() << FairLogger::endl;
   }
+  // compile the index from the fresh copy for all later lookups
+  if (XmlHandler::compileIndex(rndname.Data(), indexFile.Data()) &&
+      XmlHandler::lookupIndex(indexFile.Data(), run, lhcPeriod, startRun, endRun)) {
+    LOG(INFO) << " LHC folder = " << lhcPeriod.Data() << FairLogger::endl;
+    LOG(INFO) << " LHC period start run = " << startRun << FairLogger::endl;
+    LOG(INFO) << " LHC period end run = " << endRun << FairLogger::endl;
+    return;
+  }
   XmlHandler *saxcdb = new XmlHandler();
   saxcdb->setRun(run);
   TSAXParser *saxParser = new TSAXParser();
@@ -978,6 +1127,18 @@ Condition *Manager::getObject(const ConditionId &queryId, Bool_t forceCaching)
     return NULL;
   }
 
+  // frozen mode: every lookup is a hash-map read, see freezeConditions
+  if (mFrozen) {
+    std::unordered_map<std::string, Condition *>::const_iterator frozen =
+      mFrozenConditions.find(queryId.getPathString().Data());
+    if (frozen != mFrozenConditions.end()) {
+      return frozen->second;
+    }
+    LOG(ERROR) << "Conditions are frozen and object \"" << queryId.getPathString().Data()
+               << "\" is not part of the snapshot!" << FairLogger::endl;
+    return NULL;
+  }
+
   if (mLock && !(mRun >= queryId.getFirstRun() && mRun <= queryId.getLastRun()))
     LOG(FATAL) << "Lock is ON: cannot use different run number than the internal one!" << FairLogger::endl;
 
@@ -986,56 +1147,70 @@ Condition *Manager::getObject(const ConditionId &queryId, Bool_t forceCaching)
 
   Condition *entry = 0;
 
-  // first look into map of cached objects
+  // first look into map of cached objects; the sharded index makes this
+  // lookup safe against concurrent calls without taking any global lock
   if (mCache && queryId.getFirstRun() == mRun) {
-    entry = (Condition *) mConditionCache.GetValue(queryId.getPathString());
+    entry = mCacheIndex->lookup(queryId.getPathString());
   }
   if (entry) {
     LOG(DEBUG) << "Object " << queryId.getPathString().Data() << " retrieved from cache !!" << FairLogger::endl;
     return entry;
   }
 
-  // if snapshot flag is set, try getting from the snapshot
-  // but in the case a specific storage is specified for this path
-  StorageParameters *aPar = selectSpecificStorage(queryId.getPathString());
-  if (!aPar) {
-    if (mSnapshotMode && queryId.getFirstRun() == mRun) {
-      entry = getConditionFromSnapshot(queryId.getPathString());
-      if (entry) {
-        LOG(INFO) << "Object \"" << queryId.getPathString().Data() << "\" retrieved from the snapshot."
-                  << FairLogger::endl;
-        if (queryId.getFirstRun() == mRun) { // no need to check mCache, mSnapshotMode not possible otherwise
-          cacheCondition(queryId.getPathString(), entry);
-        }
+  Int_t version = -1, subVersion = -1;
+  Storage *aStorage = 0;
+  {
+    // the Manager bookkeeping is not concurrency-safe by itself; only the
+    // storage query, the slow part, runs outside the guard
+    std::lock_guard<std::mutex> lock(mCacheIndex->mManagerGuard);
+
+    // next check whether the absence of the object was already resolved for this run range
+    if (mCache && !queryId.hasVersion() && isKnownAbsent(queryId)) {
+      LOG(DEBUG) << "Object " << queryId.getPathString().Data() << " known to be absent for run "
+                 << queryId.getFirstRun() << ", storage query skipped" << FairLogger::endl;
+      return NULL;
+    }
 
-        if (!mIds->Contains(&entry->getId())) {
-          mIds->Add(entry->getId().Clone());
+    // if snapshot flag is set, try getting from the snapshot
+    // but in the case a specific storage is specified for this path
+    StorageParameters *aPar = selectSpecificStorage(queryId.getPathString());
+    if (!aPar) {
+      if (mSnapshotMode && queryId.getFirstRun() == mRun) {
+        entry = getConditionFromSnapshot(queryId.getPathString());
+        if (entry) {
+          LOG(INFO) << "Object \"" << queryId.getPathString().Data() << "\" retrieved from the snapshot."
+                    << FairLogger::endl;
+          if (queryId.getFirstRun() == mRun) { // no need to check mCache, mSnapshotMode not possible otherwise
+            cacheCondition(queryId.getPathString(), entry);
+          }
+
+          if (!mIds->Contains(&entry->getId())) {
+            mIds->Add(entry->getId().Clone());
+          }
+
+          return entry;
         }
-
-        return entry;
       }
     }
-  }
 
-  // Condition is not in cache (and, in case we are in snapshot mode, not in the snapshot either)
-  // => retrieve it from the storage and cache it!!
-  if (!mDefaultStorage) {
-    LOG(ERROR) << "No storage set!" << FairLogger::endl;
-    return NULL;
-  }
+    // Condition is not in cache (and, in case we are in snapshot mode, not in the snapshot either)
+    // => retrieve it from the storage and cache it!!
+    if (!mDefaultStorage) {
+      LOG(ERROR) << "No storage set!" << FairLogger::endl;
+      return NULL;
+    }
 
-  Int_t version = -1, subVersion = -1;
-  Storage *aStorage = 0;
-  if (aPar) {
-    aStorage = getStorage(aPar);
-    TString str = aPar->getUri();
-    UInt_t uId = aPar->GetUniqueID();
-    version = Int_t(uId & 0xffff) - 1;
-    subVersion = Int_t(uId >> 16) - 1;
-    LOG(DEBUG) << "Looking into storage: " << str.Data() << FairLogger::endl;
-  } else {
-    aStorage = getDefaultStorage();
-    LOG(DEBUG) << "Looking into default storage" << FairLogger::endl;
+    if (aPar) {
+      aStorage = getStorage(aPar);
+      TString str = aPar->getUri();
+      UInt_t uId = aPar->GetUniqueID();
+      version = Int_t(uId & 0xffff) - 1;
+      subVersion = Int_t(uId >> 16) - 1;
+      LOG(DEBUG) << "Looking into storage: " << str.Data() << FairLogger::endl;
+    } else {
+      aStorage = getDefaultStorage();
+      LOG(DEBUG) << "Looking into default storage" << FairLogger::endl;
+    }
   }
 
   ConditionId finalQueryId(queryId);
@@ -1047,19 +1222,221 @@ Condition *Manager::getObject(const ConditionId &queryId, Bool_t forceCaching)
     LOG(DEBUG) << "Specific subversion set to: " << subVersion << FairLogger::endl;
     finalQueryId.setSubVersion(subVersion);
   }
-  entry = aStorage->getObject(finalQueryId);
-
-  if (entry && mCache && (queryId.getFirstRun() == mRun || forceCaching)) {
-    cacheCondition(queryId.getPathString(), entry);
+  // another worker of this node may have materialized the object already
+  if (mShmCache) {
+    entry = mShmCache->getCondition(finalQueryId);
+  }
+  if (!entry) {
+    entry = aStorage->getObject(finalQueryId);
+    if (entry && mShmCache) {
+      mShmCache->publishCondition(entry);
+    }
   }
 
-  if (entry && !mIds->Contains(&entry->getId())) {
-    mIds->Add(entry->getId().Clone());
+  {
+    std::lock_guard<std::mutex> lock(mCacheIndex->mManagerGuard);
+
+    if (!entry && mCache && !queryId.hasVersion() && queryId.getFirstRun() == mRun) {
+      rememberAbsentObject(queryId);
+    }
+
+    if (entry && mCache && (queryId.getFirstRun() == mRun || forceCaching)) {
+      // a concurrent call for the same path may have cached its copy while
+      // we were querying the storage; keep the cached one
+      Condition *raced = mCacheIndex->lookup(queryId.getPathString());
+      if (raced) {
+        delete entry;
+        entry = raced;
+      } else {
+        cacheCondition(queryId.getPathString(), entry);
+      }
+    }
+
+    if (entry && !mIds->Contains(&entry->getId())) {
+      mIds->Add(entry->getId().Clone());
+    }
   }
 
   return entry;
 }
 
+Int_t Manager::prefetchConditions(const std::vector<IdPath> &paths, Int_t run)
+{
+  // resolve and load the objects for the given paths concurrently, completing
+  // into the condition cache
+
+  if (run < 0) {
+    run = mRun;
+  }
+  if (run < 0) {
+    LOG(ERROR) << "Run number neither specified in query nor set in  Manager! Use  Manager::setRun."
+               << FairLogger::endl;
+    return 0;
+  }
+  if (!mCache) {
+    LOG(WARNING) << "Prefetching requires the cache to be enabled!" << FairLogger::endl;
+    return 0;
+  }
+  if (!mDefaultStorage) {
+    LOG(ERROR) << "No storage set!" << FairLogger::endl;
+    return 0;
+  }
+  if (paths.empty()) {
+    return 0;
+  }
+
+  ROOT::EnableThreadSafety();
+
+  std::atomic<size_t> nextPath(0);
+  std::atomic<Int_t> numberOfLoaded(0);
+  // the guard of the cache index protects the storage bookkeeping of this
+  // Manager, consistently with concurrent getObject calls
+  std::mutex &managerGuard = mCacheIndex->mManagerGuard;
+
+  auto worker = [&]() {
+    for (;;) {
+      size_t i = nextPath++;
+      if (i >= paths.size()) {
+        return;
+      }
+      ConditionId queryId(paths[i], run, run, -1, -1);
+      if (!queryId.isValid() || !queryId.isSpecified()) {
+        LOG(ERROR) << "Invalid query: " << queryId.ToString().Data() << FairLogger::endl;
+        continue;
+      }
+
+      Storage *aStorage = 0;
+      Int_t version = -1, subVersion = -1;
+      {
+        std::lock_guard<std::mutex> lock(managerGuard);
+        if (mCacheIndex->lookup(queryId.getPathString())) {
+          continue; // already cached
+        }
+        StorageParameters *aPar = selectSpecificStorage(queryId.getPathString());
+        if (aPar) {
+          aStorage = getStorage(aPar);
+          UInt_t uId = aPar->GetUniqueID();
+          version = Int_t(uId & 0xffff) - 1;
+          subVersion = Int_t(uId >> 16) - 1;
+        } else {
+          aStorage = getDefaultStorage();
+        }
+      }
+
+      ConditionId finalQueryId(queryId);
+      if (version >= 0) {
+        finalQueryId.setVersion(version);
+      }
+      if (subVersion >= 0) {
+        finalQueryId.setSubVersion(subVersion);
+      }
+
+      // the actual resolution and load, concurrent between the workers
+      Condition *entry = aStorage->getObject(finalQueryId);
+
+      if (entry) {
+        std::lock_guard<std::mutex> lock(managerGuard);
+        Condition *raced = mCacheIndex->lookup(queryId.getPathString());
+        if (raced) { // a concurrent getObject cached the path meanwhile
+          delete entry;
+          continue;
+        }
+        cacheCondition(queryId.getPathString(), entry);
+        if (!mIds->Contains(&entry->getId())) {
+          mIds->Add(entry->getId().Clone());
+        }
+        numberOfLoaded++;
+      }
+    }
+  };
+
+  size_t poolSize = std::min<size_t>(paths.size(), 4);
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < poolSize; i++) {
+    pool.emplace_back(worker);
+  }
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  LOG(INFO) << "Prefetched " << Int_t(numberOfLoaded) << " of " << paths.size() << " conditions objects with "
+            << Int_t(poolSize) << " threads" << FairLogger::endl;
+  return numberOfLoaded;
+}
+
+Int_t Manager::freezeConditions(const std::vector<IdPath> &paths, const char *dumpFileName)
+{
+  // freeze the conditions of the run into an immutable in-memory snapshot:
+  // resolve and load everything upfront, then pin the objects so that every
+  // later getObject is a hash-map read without storage traffic
+
+  if (mRun < 0) {
+    LOG(ERROR) << "Run number not yet set! Use  Manager::setRun." << FairLogger::endl;
+    return -1;
+  }
+  if (!mDefaultStorage) {
+    LOG(ERROR) << "Default storage is not set! Use  Manager::setDefaultStorage" << FairLogger::endl;
+    return -1;
+  }
+  if (!mCache) {
+    LOG(ERROR) << "Freezing requires the cache to be enabled!" << FairLogger::endl;
+    return -1;
+  }
+
+  std::vector<IdPath> toLoad(paths);
+  if (toLoad.empty()) {
+    // every path the default and specific storages report valid for the run
+    queryStorages();
+    TIter iter(mDefaultStorage->getQueryStoragesList());
+    ConditionId *anId = 0;
+    while ((anId = dynamic_cast<ConditionId *>(iter.Next()))) {
+      toLoad.push_back(anId->getPath());
+    }
+    TIter typeIter(&mSpecificStorages);
+    TObjString *aCalibType = 0;
+    while ((aCalibType = dynamic_cast<TObjString *>(typeIter.Next()))) {
+      StorageParameters *aPar = (StorageParameters *) mSpecificStorages.GetValue(aCalibType);
+      if (!aPar) {
+        continue;
+      }
+      TIter idIter(getStorage(aPar)->getQueryStoragesList());
+      while ((anId = dynamic_cast<ConditionId *>(idIter.Next()))) {
+        toLoad.push_back(anId->getPath());
+      }
+    }
+  }
+  if (toLoad.empty()) {
+    LOG(WARNING) << "No conditions to freeze for run " << mRun << FairLogger::endl;
+    return 0;
+  }
+
+  prefetchConditions(toLoad, mRun);
+
+  // pin the loaded objects; they stay owned by the condition cache
+  mFrozenConditions.clear();
+  for (size_t i = 0; i < toLoad.size(); i++) {
+    TString pathString = toLoad[i].getPathString();
+    Condition *entry = mCacheIndex->lookup(pathString);
+    if (entry) {
+      mFrozenConditions[pathString.Data()] = entry;
+    } else {
+      LOG(WARNING) << "Object \"" << pathString.Data()
+                   << "\" could not be resolved, it will be missing from the frozen snapshot" << FairLogger::endl;
+    }
+  }
+  mFrozen = kTRUE;
+
+  TString dump(dumpFileName);
+  if (!dump.IsNull()) {
+    // one file for grid shipping, readable there with setSnapshotMode
+    dumpToSnapshotFile(dump.Data(), kFALSE);
+  }
+
+  LOG(INFO) << "Conditions frozen for run " << mRun << ": " << Int_t(mFrozenConditions.size()) << " objects pinned"
+            << FairLogger::endl;
+  return mFrozenConditions.size();
+}
+
 Condition *Manager::getConditionFromSnapshot(const char *path)
 {
   // get the entry from the open snapshot file
@@ -1216,7 +1593,7 @@ ConditionId *Manager::getId(const ConditionId &query)
 
   // first look into map of cached objects
   if (mCache && query.getFirstRun() == mRun) {
-    entry = (Condition *) mConditionCache.GetValue(query.getPathString());
+    entry = mCacheIndex->lookup(query.getPathString());
   }
 
   if (entry) {
@@ -1452,6 +1829,11 @@ Bool_t Manager::putObject(Condition *entry, const char *mirrors)
     result = aStorage->putObject(entry, "");
   }
 
+  if (result) {
+    // a previously recorded absence of the path is no longer true
+    mAbsentRanges.erase(id.getPathString().Data());
+  }
+
   if (mRun >= 0) {
     queryStorages();
   }
@@ -1495,9 +1877,42 @@ void Manager::cacheCondition(const char *path, Condition *entry)
   }
 
   mConditionCache.Add(new TObjString(path), entry);
+  mCacheIndex->insert(path, entry);
+  accountCachedCondition(path, entry);
   LOG(DEBUG) << "Cache entries: " << mConditionCache.GetEntries() << FairLogger::endl;
 }
 
+void Manager::accountCachedCondition(const char *path, Condition *entry)
+{
+  if (!AliceO2::Memory::MemoryAccountant::IsEnabled()) {
+    return;
+  }
+  auto &accountant = AliceO2::Memory::MemoryAccountant::Instance();
+  if (mMemoryScopeId < 0) {
+    mMemoryScopeId = accountant.RegisterScope("CCDB/ConditionCache");
+  }
+
+  // the streamed size is the closest cheap proxy for the in-memory footprint
+  // of the payload; remembered per path so evictions can be subtracted
+  TMessage message(kMESS_OBJECT);
+  message.WriteObject(entry);
+  size_t bytes = message.Length() > 0 ? message.Length() : 0;
+  mCachedConditionSizes[path] = bytes;
+  accountant.Add(mMemoryScopeId, bytes);
+}
+
+void Manager::forgetCachedCondition(const char *path)
+{
+  std::map<std::string, size_t>::iterator sizeIt = mCachedConditionSizes.find(path);
+  if (sizeIt == mCachedConditionSizes.end()) {
+    return;
+  }
+  if (mMemoryScopeId >= 0) {
+    AliceO2::Memory::MemoryAccountant::Instance().Add(mMemoryScopeId, -(long long)sizeIt->second);
+  }
+  mCachedConditionSizes.erase(sizeIt);
+}
+
 void Manager::print(Option_t * /*option*/) const
 {
   // Print list of active storages and their URIs
@@ -1540,6 +1955,12 @@ void Manager::setRun(Int_t run)
     LOG(FATAL) << "Lock is ON, cannot reset run number!" << FairLogger::endl;
   }
 
+  if (mFrozen) {
+    LOG(WARNING) << "Conditions were frozen for run " << mRun << ", the run change unfreezes them!"
+                 << FairLogger::endl;
+    unfreeze();
+  }
+
   mRun = run;
 
   if (mRaw) {
@@ -1555,16 +1976,96 @@ void Manager::setRun(Int_t run)
       return;
     }
   }
-  clearCache();
+  evictCacheForRun(run);
   queryStorages();
 }
 
+void Manager::evictCacheForRun(Int_t run)
+{
+  // drop cached conditions and absence records that are not valid for the run;
+  // objects whose declared run range covers the run stay available, so a run
+  // change no longer costs a storage query for each of them
+
+  TList staleKeys;
+  TIter iter(mConditionCache.GetTable());
+  TPair *pair = 0;
+  while ((pair = dynamic_cast<TPair *>(iter.Next()))) {
+    Condition *entry = dynamic_cast<Condition *>(pair->Value());
+    if (!entry || entry->getId().getFirstRun() > run || entry->getId().getLastRun() < run) {
+      staleKeys.Add(pair->Key());
+    }
+  }
+
+  Int_t dropped = 0;
+  TIter keyIter(&staleKeys);
+  TObject *key = 0;
+  while ((key = keyIter.Next())) {
+    mCacheIndex->remove(key->GetName());
+    forgetCachedCondition(key->GetName());
+    delete mConditionCache.Remove(key);
+    dropped++;
+  }
+
+  std::map<std::string, std::vector<std::pair<Int_t, Int_t>>>::iterator pathIt = mAbsentRanges.begin();
+  while (pathIt != mAbsentRanges.end()) {
+    std::vector<std::pair<Int_t, Int_t>> &ranges = pathIt->second;
+    std::vector<std::pair<Int_t, Int_t>> kept;
+    for (size_t i = 0; i < ranges.size(); i++) {
+      if (ranges[i].first <= run && run <= ranges[i].second) {
+        kept.push_back(ranges[i]);
+      }
+    }
+    ranges.swap(kept);
+    if (ranges.empty()) {
+      mAbsentRanges.erase(pathIt++);
+    } else {
+      ++pathIt;
+    }
+  }
+
+  LOG(DEBUG) << dropped << " cache entries not valid for run " << run << " dropped, "
+             << mConditionCache.GetEntries() << " kept" << FairLogger::endl;
+}
+
+void Manager::rememberAbsentObject(const ConditionId &queryId)
+{
+  // remember that the storages hold no object for the path and run range of the query
+
+  mAbsentRanges[queryId.getPathString().Data()].push_back(
+    std::make_pair(queryId.getFirstRun(), queryId.getLastRun()));
+}
+
+Bool_t Manager::isKnownAbsent(const ConditionId &queryId) const
+{
+  // whether a previous query already resolved that no object exists for the
+  // path and run range of the query
+
+  std::map<std::string, std::vector<std::pair<Int_t, Int_t>>>::const_iterator pathIt =
+    mAbsentRanges.find(queryId.getPathString().Data());
+  if (pathIt == mAbsentRanges.end()) {
+    return kFALSE;
+  }
+
+  const std::vector<std::pair<Int_t, Int_t>> &ranges = pathIt->second;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    if (ranges[i].first <= queryId.getFirstRun() && queryId.getLastRun() <= ranges[i].second) {
+      return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
 void Manager::clearCache()
 {
   // clear  Condition cache
 
   LOG(DEBUG) << "Cache entries to be deleted: " << mConditionCache.GetEntries() << FairLogger::endl;
 
+  // the pinned objects are owned by the cache being cleared
+  unfreeze();
+
+  mAbsentRanges.clear();
+
   /*
   // To clean entries one by one
   TIter iter(mConditionCache.GetTable());
@@ -1578,6 +2079,11 @@ void Manager::clearCache()
   delete mConditionCache.Remove(key);
   }
   */
+  mCacheIndex->clear();
+  mCachedConditionSizes.clear();
+  if (mMemoryScopeId >= 0) {
+    AliceO2::Memory::MemoryAccountant::Instance().Update(mMemoryScopeId, 0);
+  }
   mConditionCache.DeleteAll();
   LOG(DEBUG) << "After deleting - Cache entries: " << mConditionCache.GetEntries() << FairLogger::endl;
 }
@@ -1587,6 +2093,10 @@ void Manager::unloadFromCache(const char *path)
   // unload cached object
   // that is remove the entry from the cache and the id from the list of ids
   //
+  if (mFrozen) {
+    LOG(WARNING) << "Conditions are frozen, object \"" << path << "\" is not unloaded from cache" << FairLogger::endl;
+    return;
+  }
   if (!mActiveStorages.GetEntries()) {
     LOG(DEBUG) << "No active storages. Object \"" << path << "\" is not unloaded from cache" << FairLogger::endl;
     return;
@@ -1601,6 +2111,8 @@ void Manager::unloadFromCache(const char *path)
     if (mConditionCache.Contains(path)) {
       LOG(DEBUG) << "Unloading object \"" << path << "\" from cache and from list of ids" << FairLogger::endl;
       TObjString pathStr(path);
+      mCacheIndex->remove(path);
+      forgetCachedCondition(path);
       delete mConditionCache.Remove(&pathStr);
       // we do not remove from the list of ConditionId's (it's not very coherent but we leave the
       // id for the benefit of the userinfo)
@@ -1629,6 +2141,8 @@ void Manager::unloadFromCache(const char *path)
       LOG(DEBUG) << "Unloading object \"" << entryPath.getPathString().Data() << "\" from cache and from list of ids"
                  << FairLogger::endl;
       TObjString pathStr(entryPath.getPathString());
+      mCacheIndex->remove(entryPath.getPathString());
+      forgetCachedCondition(entryPath.getPathString());
       delete mConditionCache.Remove(&pathStr);
       removed++;
 
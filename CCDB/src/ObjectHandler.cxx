@@ -8,6 +8,11 @@
 
 #include <zlib.h>
 
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
 using namespace AliceO2::CDB;
 
 ObjectHandler::ObjectHandler() {}
@@ -47,3 +52,85 @@ void ObjectHandler::GetObject(const std::string& path, std::string& object)
 
   delete entry;
 }
+
+bool ObjectHandler::StreamObject(const std::string& path,
+                                 const std::function<void(const char* block, std::size_t length)>& consumer,
+                                 std::size_t& size, unsigned long& checksum, std::size_t blockSize)
+{
+  if (blockSize == 0) {
+    blockSize = 1;
+  }
+
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    LOG(ERROR) << "The object was not found at " << path;
+    return false;
+  }
+
+  size = 0;
+  unsigned long crc = crc32(0L, Z_NULL, 0);
+
+  // Double buffer: the reader thread fills one block and folds it into the
+  // checksum while the consumer ships the other one
+  std::vector<char> blocks[2];
+  blocks[0].resize(blockSize);
+  blocks[1].resize(blockSize);
+  std::size_t lengths[2] = { 0, 0 };
+  bool filled[2] = { false, false };
+  bool done = false;
+  std::mutex guard;
+  std::condition_variable stateChange;
+
+  std::thread reader([&]() {
+    int slot = 0;
+    for (;;) {
+      file.read(blocks[slot].data(), blockSize);
+      std::size_t length = static_cast<std::size_t>(file.gcount());
+      if (length > 0) {
+        // The reader owns the running checksum: it sees the blocks in order
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(blocks[slot].data()), length);
+      }
+      std::unique_lock<std::mutex> lock(guard);
+      if (length == 0) {
+        done = true;
+        stateChange.notify_all();
+        return;
+      }
+      lengths[slot] = length;
+      filled[slot] = true;
+      stateChange.notify_all();
+      // Wait until the consumer released the next slot before overwriting it
+      slot = 1 - slot;
+      while (filled[slot]) {
+        stateChange.wait(lock);
+      }
+    }
+  });
+
+  int slot = 0;
+  for (;;) {
+    std::unique_lock<std::mutex> lock(guard);
+    while (!filled[slot] && !done) {
+      stateChange.wait(lock);
+    }
+    if (!filled[slot]) {
+      break;
+    }
+    std::size_t length = lengths[slot];
+    lock.unlock();
+
+    // Ship this block; the reader meanwhile fills and checksums the next one
+    consumer(blocks[slot].data(), length);
+    size += length;
+
+    lock.lock();
+    filled[slot] = false;
+    stateChange.notify_all();
+    slot = 1 - slot;
+  }
+
+  reader.join();
+  checksum = crc;
+
+  return !file.bad();
+}
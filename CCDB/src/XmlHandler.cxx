@@ -2,19 +2,40 @@
 #include "CCDB/XmlHandler.h"
 #include <FairLogger.h>   // for LOG
 #include <TList.h>        // for TList
+#include <TSAXParser.h>   // for TSAXParser
 #include <TXMLAttr.h>     // for TXMLAttr
+#include <algorithm>      // for sort, upper_bound
+#include <cstring>        // for memcmp
+#include <fstream>        // for ifstream, ofstream
+#include <string>         // for string
 
 using namespace AliceO2::CDB;
 ClassImp(XmlHandler)
 
-XmlHandler::XmlHandler() : TObject(), mRun(-1), mStartIdRunRange(-1), mEndIdRunRange(-1), mOCDBFolder("")
+namespace {
+
+// one fixed-size record of the compiled index, sorted by start run; the
+// folder strings follow the record table in one concatenated block
+struct IndexRecord {
+  Int_t startRun;
+  Int_t endRun;
+  UInt_t folderOffset;
+  UInt_t folderLength;
+};
+
+const char kIndexMagic[8] = { 'O', 'C', 'D', 'B', 'I', 'D', 'X', '1' };
+}
+
+XmlHandler::XmlHandler()
+  : TObject(), mRun(-1), mStartIdRunRange(-1), mEndIdRunRange(-1), mOCDBFolder(""), mCollectAll(kFALSE), mRanges()
 {
   //
   // XmlHandler default constructor
   //
 }
 
-XmlHandler::XmlHandler(Int_t run) : TObject(), mRun(run), mStartIdRunRange(-1), mEndIdRunRange(-1), mOCDBFolder("")
+XmlHandler::XmlHandler(Int_t run)
+  : TObject(), mRun(run), mStartIdRunRange(-1), mEndIdRunRange(-1), mOCDBFolder(""), mCollectAll(kFALSE), mRanges()
 {
   //
   // XmlHandler constructor with requested run
@@ -26,7 +47,9 @@ XmlHandler::XmlHandler(const XmlHandler &sh)
     mRun(sh.mRun),
     mStartIdRunRange(sh.mStartIdRunRange),
     mEndIdRunRange(sh.mEndIdRunRange),
-    mOCDBFolder(sh.mOCDBFolder)
+    mOCDBFolder(sh.mOCDBFolder),
+    mCollectAll(sh.mCollectAll),
+    mRanges(sh.mRanges)
 {
   //
   // XmlHandler copy constructor
@@ -89,6 +112,13 @@ void XmlHandler::OnStartElement(const char *name, const TList *attributes)
       LOG(DEBUG) << "endRun = " << endRun << FairLogger::endl;
     }
     if (attrName == "OCDBFolder") {
+      if (mCollectAll && startRun != -1 && endRun != -1) {
+        FolderRange range;
+        range.mStartRun = startRun;
+        range.mEndRun = endRun;
+        range.mFolder = attr->GetValue();
+        mRanges.push_back(range);
+      }
       if (mRun >= startRun && mRun <= endRun && startRun != -1 && endRun != -1) {
         mOCDBFolder = (TString) (attr->GetValue());
         LOG(DEBUG) << "OCDBFolder = " << mOCDBFolder.Data() << FairLogger::endl;
@@ -143,3 +173,106 @@ void XmlHandler::OnCdataBlock(const char * /*text*/, Int_t /*len*/)
   // process character data blocks here
   // not implemented and should not be used here
 }
+
+Bool_t XmlHandler::compileIndex(const char *xmlFile, const char *indexFile)
+{
+  //
+  // one-time XML -> binary compilation, see lookupIndex
+  //
+
+  XmlHandler handler;
+  handler.setCollectAll(kTRUE);
+  TSAXParser saxParser;
+  saxParser.ConnectToHandler(" Handler", &handler);
+  if (saxParser.ParseFile(xmlFile) != 0) {
+    LOG(ERROR) << "Cannot parse XML file " << xmlFile << FairLogger::endl;
+    return kFALSE;
+  }
+
+  std::vector<FolderRange> ranges = handler.getFolderRanges();
+  if (ranges.empty()) {
+    LOG(ERROR) << "No folder <-> run range entries found in " << xmlFile << FairLogger::endl;
+    return kFALSE;
+  }
+  std::sort(ranges.begin(), ranges.end(),
+            [](const FolderRange &a, const FolderRange &b) { return a.mStartRun < b.mStartRun; });
+
+  std::vector<IndexRecord> records(ranges.size());
+  std::string folderTable;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    records[i].startRun = ranges[i].mStartRun;
+    records[i].endRun = ranges[i].mEndRun;
+    records[i].folderOffset = folderTable.size();
+    records[i].folderLength = ranges[i].mFolder.Length();
+    folderTable.append(ranges[i].mFolder.Data(), ranges[i].mFolder.Length());
+  }
+
+  std::ofstream file(indexFile, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG(ERROR) << "Cannot write index file " << indexFile << FairLogger::endl;
+    return kFALSE;
+  }
+  Int_t nRecords = records.size();
+  file.write(kIndexMagic, sizeof(kIndexMagic));
+  file.write(reinterpret_cast<const char *>(&nRecords), sizeof(nRecords));
+  file.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(IndexRecord));
+  file.write(folderTable.data(), folderTable.size());
+  file.close();
+
+  LOG(DEBUG) << "Compiled " << nRecords << " folder <-> run range entries into " << indexFile << FairLogger::endl;
+  return !file.fail();
+}
+
+Bool_t XmlHandler::lookupIndex(const char *indexFile, Int_t run, TString &folder, Int_t &startRun, Int_t &endRun)
+{
+  //
+  // binary search in a compiled index, see compileIndex
+  //
+
+  std::ifstream file(indexFile, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return kFALSE;
+  }
+
+  char magic[sizeof(kIndexMagic)];
+  Int_t nRecords = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&nRecords), sizeof(nRecords));
+  if (!file.good() || memcmp(magic, kIndexMagic, sizeof(magic)) != 0 || nRecords <= 0) {
+    LOG(WARNING) << "Malformed index file " << indexFile << FairLogger::endl;
+    return kFALSE;
+  }
+
+  std::vector<IndexRecord> records(nRecords);
+  file.read(reinterpret_cast<char *>(records.data()), nRecords * sizeof(IndexRecord));
+  if (!file.good()) {
+    LOG(WARNING) << "Malformed index file " << indexFile << FairLogger::endl;
+    return kFALSE;
+  }
+
+  // last record whose start run is not beyond the requested run
+  std::vector<IndexRecord>::const_iterator it =
+    std::upper_bound(records.begin(), records.end(), run,
+                     [](Int_t value, const IndexRecord &record) { return value < record.startRun; });
+  if (it == records.begin()) {
+    return kFALSE;
+  }
+  const IndexRecord &record = *(it - 1);
+  if (run > record.endRun) {
+    return kFALSE;
+  }
+
+  std::vector<char> folderChars(record.folderLength);
+  file.seekg(sizeof(kIndexMagic) + sizeof(nRecords) + static_cast<std::streamoff>(nRecords) * sizeof(IndexRecord) +
+             record.folderOffset);
+  file.read(folderChars.data(), folderChars.size());
+  if (!file.good()) {
+    LOG(WARNING) << "Malformed index file " << indexFile << FairLogger::endl;
+    return kFALSE;
+  }
+
+  folder = TString(folderChars.data(), folderChars.size());
+  startRun = record.startRun;
+  endRun = record.endRun;
+  return kTRUE;
+}
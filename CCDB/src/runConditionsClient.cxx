@@ -12,7 +12,10 @@ void addCustomOptions(bpo::options_description& options)
   options.add_options()("parameter-name", bpo::value<string>()->default_value("DET/Calib/Histo"), "Parameter Name")(
     "operation-type", bpo::value<string>()->default_value("GET"), "Operation Type")(
     "data-source", bpo::value<string>()->default_value("OCDB"), "Data Source")(
-    "object-path", bpo::value<string>()->default_value("OCDB"), "Object Path");
+    "object-path", bpo::value<string>()->default_value("OCDB"), "Object Path")(
+    "compress", bpo::value<bool>()->default_value(false), "Request zlib-compressed payloads")(
+    "chunk-size", bpo::value<int>()->default_value(0), "Reply chunk size in bytes (0: single chunk)")(
+    "batch", bpo::value<bool>()->default_value(false), "Fetch all keys in one multi-key request (Riak only)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config) { return new ConditionsMQClient(); }
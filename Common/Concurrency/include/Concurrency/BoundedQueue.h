@@ -0,0 +1,280 @@
+/// \file BoundedQueue.h
+/// \brief Bounded multi-producer multi-consumer queue with batch operations
+///
+/// Fixed-capacity ring with one sequence counter per cell: TryPush/TryPop
+/// complete with a single compare-and-swap on the shared cursor and never
+/// take a lock. The batch variants claim up to N contiguous cells with one
+/// compare-and-swap, so the synchronization cost per item drops with the
+/// batch size. Push/Pop add a blocking fallback with an optional timeout
+/// for pipeline stages that have to wait; waiting threads are only
+/// signalled when present, the fast path stays lock-free.
+///
+/// The queue is the pipeline primitive between processing stages, e.g.
+/// feeding encoded blocks from worker threads to a writer; the test Fifo
+/// of the DataCompression module and the ad-hoc queues in the device
+/// examples cover the same need with a mutex around every operation.
+
+#ifndef ALICEO2_CONCURRENCY_BOUNDEDQUEUE_H_
+#define ALICEO2_CONCURRENCY_BOUNDEDQUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+template <typename T>
+class BoundedQueue
+{
+ public:
+  /// @param capacity maximum number of queued items, rounded up to the
+  ///        next power of two, minimum 2
+  explicit BoundedQueue(size_t capacity)
+    : mBuffer(), mBufferMask(0), mEnqueuePos(0), mDequeuePos(0), mMutex(),
+      mNotFull(), mNotEmpty(), mWaitingProducers(0), mWaitingConsumers(0)
+  {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mBufferMask = size - 1;
+    mBuffer.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+      mBuffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  size_t GetCapacity() const { return mBufferMask + 1; }
+
+  /// approximate number of queued items, exact only without concurrent access
+  size_t GetSize() const
+  {
+    size_t enqueuePos = mEnqueuePos.load(std::memory_order_acquire);
+    size_t dequeuePos = mDequeuePos.load(std::memory_order_acquire);
+    return (enqueuePos > dequeuePos) ? enqueuePos - dequeuePos : 0;
+  }
+
+  /// push one item, lock-free; @return false if the queue is full
+  bool TryPush(const T& value) { return TryPushN(&value, 1) == 1; }
+
+  /// pop one item, lock-free; @return false if the queue is empty
+  bool TryPop(T& value) { return TryPopN(&value, 1) == 1; }
+
+  /// push up to n items with a single update of the shared cursor
+  /// @return number of items pushed, 0 when the queue is full
+  size_t TryPushN(const T* values, size_t n)
+  {
+    size_t pushed = PushImpl(values, n);
+    if (pushed > 0) {
+      NotifyConsumers();
+    }
+    return pushed;
+  }
+
+  /// pop up to n items with a single update of the shared cursor
+  /// @return number of items popped, 0 when the queue is empty
+  size_t TryPopN(T* values, size_t n)
+  {
+    size_t popped = PopImpl(values, n);
+    if (popped > 0) {
+      NotifyProducers();
+    }
+    return popped;
+  }
+
+  /// push one item, blocking while the queue is full
+  /// @param timeoutMilliseconds maximum wait, negative waits forever
+  /// @return false when the timeout expired
+  bool Push(const T& value, int timeoutMilliseconds = -1)
+  {
+    if (TryPush(value)) {
+      return true;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+    bool pushed = false;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      ++mWaitingProducers;
+      for (;;) {
+        pushed = PushImpl(&value, 1) == 1;
+        if (pushed) {
+          break;
+        }
+        if (timeoutMilliseconds < 0) {
+          mNotFull.wait(lock);
+        } else if (mNotFull.wait_until(lock, deadline) == std::cv_status::timeout) {
+          pushed = PushImpl(&value, 1) == 1;
+          break;
+        }
+      }
+      --mWaitingProducers;
+    }
+    // signalling outside the lock, NotifyConsumers acquires it
+    if (pushed) {
+      NotifyConsumers();
+    }
+    return pushed;
+  }
+
+  /// pop one item, blocking while the queue is empty
+  /// @param timeoutMilliseconds maximum wait, negative waits forever
+  /// @return false when the timeout expired
+  bool Pop(T& value, int timeoutMilliseconds = -1)
+  {
+    if (TryPop(value)) {
+      return true;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+    bool popped = false;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      ++mWaitingConsumers;
+      for (;;) {
+        popped = PopImpl(&value, 1) == 1;
+        if (popped) {
+          break;
+        }
+        if (timeoutMilliseconds < 0) {
+          mNotEmpty.wait(lock);
+        } else if (mNotEmpty.wait_until(lock, deadline) == std::cv_status::timeout) {
+          popped = PopImpl(&value, 1) == 1;
+          break;
+        }
+      }
+      --mWaitingConsumers;
+    }
+    // signalling outside the lock, NotifyProducers acquires it
+    if (popped) {
+      NotifyProducers();
+    }
+    return popped;
+  }
+
+ private:
+  struct Cell {
+    Cell() : sequence(0), value() {}
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  /// claim, fill and publish up to n cells; does not signal waiters
+  size_t PushImpl(const T* values, size_t n)
+  {
+    if (n == 0) {
+      return 0;
+    }
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      intptr_t dif = intptr_t(mBuffer[pos & mBufferMask].sequence.load(std::memory_order_acquire)) - intptr_t(pos);
+      if (dif < 0) {
+        // cell not yet released by the consumer side, the queue is full
+        return 0;
+      }
+      if (dif > 0) {
+        // another producer claimed the cell in between, catch up
+        pos = mEnqueuePos.load(std::memory_order_relaxed);
+        continue;
+      }
+      // extend the batch over the directly available cells
+      size_t count = 1;
+      while (count < n &&
+             mBuffer[(pos + count) & mBufferMask].sequence.load(std::memory_order_acquire) == pos + count) {
+        ++count;
+      }
+      if (mEnqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+        for (size_t i = 0; i < count; ++i) {
+          Cell& cell = mBuffer[(pos + i) & mBufferMask];
+          cell.value = values[i];
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+      }
+      // pos has been reloaded by the failed compare-and-swap, retry
+    }
+  }
+
+  /// claim, read and release up to n cells; does not signal waiters
+  size_t PopImpl(T* values, size_t n)
+  {
+    if (n == 0) {
+      return 0;
+    }
+    size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      intptr_t dif = intptr_t(mBuffer[pos & mBufferMask].sequence.load(std::memory_order_acquire)) - intptr_t(pos + 1);
+      if (dif < 0) {
+        // cell not yet published by the producer side, the queue is empty
+        return 0;
+      }
+      if (dif > 0) {
+        // another consumer claimed the cell in between, catch up
+        pos = mDequeuePos.load(std::memory_order_relaxed);
+        continue;
+      }
+      // extend the batch over the directly available cells
+      size_t count = 1;
+      while (count < n &&
+             mBuffer[(pos + count) & mBufferMask].sequence.load(std::memory_order_acquire) == pos + count + 1) {
+        ++count;
+      }
+      if (mDequeuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+        for (size_t i = 0; i < count; ++i) {
+          Cell& cell = mBuffer[(pos + i) & mBufferMask];
+          values[i] = cell.value;
+          // release the cell for the next lap of the producers
+          cell.sequence.store(pos + i + mBufferMask + 1, std::memory_order_release);
+        }
+        return count;
+      }
+      // pos has been reloaded by the failed compare-and-swap, retry
+    }
+  }
+
+  /// wake blocked consumers; the counter keeps the lock off the fast path.
+  /// Must not be called with mMutex held. The fence orders the publishing
+  /// stores before the counter load, pairing with the waiter incrementing
+  /// the counter before its recheck, so a wakeup is never missed.
+  void NotifyConsumers()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mWaitingConsumers.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mNotEmpty.notify_all();
+    }
+  }
+
+  /// wake blocked producers; the counter keeps the lock off the fast path.
+  /// Must not be called with mMutex held, see NotifyConsumers.
+  void NotifyProducers()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mWaitingProducers.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mNotFull.notify_all();
+    }
+  }
+
+  std::unique_ptr<Cell[]> mBuffer;
+  size_t mBufferMask;
+  // the cursors are the contended words, keep them on separate cache lines
+  alignas(64) std::atomic<size_t> mEnqueuePos;
+  alignas(64) std::atomic<size_t> mDequeuePos;
+  // blocking fallback, only touched when a thread has to wait
+  alignas(64) std::mutex mMutex;
+  std::condition_variable mNotFull;
+  std::condition_variable mNotEmpty;
+  std::atomic<int> mWaitingProducers;
+  std::atomic<int> mWaitingConsumers;
+};
+
+} // namespace Concurrency
+} // namespace AliceO2
+
+#endif // ALICEO2_CONCURRENCY_BOUNDEDQUEUE_H_
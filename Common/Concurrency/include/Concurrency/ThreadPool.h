@@ -0,0 +1,107 @@
+/// \file ThreadPool.h
+/// \brief Shared work-stealing thread pool with task-graph dependencies
+///
+/// One pool per process (ThreadPool::Instance()), so the digitizer, the
+/// trackers and the compression pipeline share the same workers instead of
+/// each spawning its own threads and oversubscribing the cores when chained
+/// in one process. The pool size is taken from the O2_THREAD_POOL_SIZE
+/// environment variable, falling back to the hardware concurrency; local
+/// pools with an explicit size can still be constructed, e.g. for tests.
+///
+/// Tasks are submitted as plain callables, optionally after a set of
+/// previously submitted tasks:
+///
+///   auto& pool = ThreadPool::Instance();
+///   auto decode = pool.Submit([&]{ ... });
+///   auto cluster = pool.Submit([&]{ ... }, {decode});
+///   pool.Wait(cluster);
+///
+/// Each worker owns a deque: it pushes and pops its own work LIFO for cache
+/// locality and steals FIFO from the other workers when it runs dry. Waiting
+/// from inside a pool task does not block a worker: the waiting worker
+/// executes other queued tasks until the dependency completes.
+
+#ifndef ALICEO2_CONCURRENCY_THREADPOOL_H_
+#define ALICEO2_CONCURRENCY_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+class ThreadPool
+{
+ public:
+  /// One node of the task graph. Treat as opaque, only ever held through a
+  /// TaskHandle returned by Submit.
+  struct Task {
+    explicit Task(std::function<void()> w)
+      : work(std::move(w)), pending(0), done(false), mutex(), waitCv(), successors() {}
+    std::function<void()> work;
+    std::atomic<int> pending; ///< unfinished dependencies plus registration guard
+    std::atomic<bool> done;
+    std::mutex mutex; ///< guards successors and the completion wait
+    std::condition_variable waitCv;
+    std::vector<std::shared_ptr<Task>> successors;
+  };
+  using TaskHandle = std::shared_ptr<Task>;
+
+  /// @param numWorkers number of worker threads; 0 selects the size from the
+  ///        O2_THREAD_POOL_SIZE environment variable or, when unset, the
+  ///        hardware concurrency
+  explicit ThreadPool(int numWorkers = 0);
+
+  /// drains the ready tasks, then stops the workers; tasks whose
+  /// dependencies never complete are dropped
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// the process-wide shared pool
+  static ThreadPool& Instance();
+
+  /// submit a task, runnable immediately
+  TaskHandle Submit(std::function<void()> work);
+
+  /// submit a task runnable once all dependencies have completed; the
+  /// dependencies may already be done or still running
+  TaskHandle Submit(std::function<void()> work, const std::vector<TaskHandle>& dependencies);
+
+  /// block until the task has completed; called from inside a pool task it
+  /// executes other queued work instead of idling a worker
+  void Wait(const TaskHandle& task);
+
+  int GetNumWorkers() const { return static_cast<int>(mWorkers.size()); }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<TaskHandle> tasks;
+  };
+
+  void WorkerLoop(int index);
+  void Enqueue(const TaskHandle& task);
+  TaskHandle PopTask(int index);
+  void Execute(const TaskHandle& task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+  std::vector<std::thread> mWorkers;
+  std::mutex mWakeMutex;
+  std::condition_variable mWakeCv;
+  std::atomic<int> mReadyCount;    ///< tasks sitting in the queues
+  std::atomic<unsigned> mNextQueue; ///< round-robin target for external submissions
+  std::atomic<bool> mRunning;
+};
+
+} // namespace Concurrency
+} // namespace AliceO2
+
+#endif /* ALICEO2_CONCURRENCY_THREADPOOL_H_ */
@@ -0,0 +1,129 @@
+/// \file TimeWindowRing.h
+/// \brief Time-indexed rolling store with bulk eviction of expired windows
+///
+/// Continuous-readout detectors keep the data of the last N time bins alive
+/// while the simulation or readout fills the current one: the TPC
+/// continuous-readout digitizer and the ITS DigitWriteoutBuffer both need a
+/// rolling store that appends by time bin and hands complete expired bins
+/// to a writeout step. TimeWindowRing provides that primitive once: a ring
+/// of per-window item vectors whose storage is pooled across laps (an
+/// evicted slot keeps its capacity for its next window), an append that is
+/// a bounds check and a push_back on the producer thread, and bulk
+/// eviction through a callback that receives a whole window at a time.
+///
+/// The ring belongs to its single producer: appends, advancing and the
+/// metrics reads run on that thread, the eviction callback may hand the
+/// window contents to other threads (e.g. a writeout queue).
+
+#ifndef ALICEO2_CONCURRENCY_TIMEWINDOWRING_H_
+#define ALICEO2_CONCURRENCY_TIMEWINDOWRING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+template <typename T>
+class TimeWindowRing
+{
+ public:
+  /// receives the expired window and all its items; the vector is cleared
+  /// (capacity retained) after the call returns
+  using EvictionCallback = std::function<void(uint64_t window, std::vector<T>& items)>;
+
+  /// @param numOfWindows live time bins kept at once, minimum 1
+  explicit TimeWindowRing(size_t numOfWindows)
+    : mSlots(numOfWindows > 0 ? numOfWindows : 1), mFirstWindow(0), mOccupancy(0),
+      mMaxOccupancy(0), mAppendedCount(0), mLateCount(0)
+  {
+  }
+
+  TimeWindowRing(const TimeWindowRing&) = delete;
+  TimeWindowRing& operator=(const TimeWindowRing&) = delete;
+
+  /// called for every window leaving the live range, in window order
+  void SetEvictionCallback(EvictionCallback callback) { mCallback = std::move(callback); }
+
+  size_t GetNumberOfWindows() const { return mSlots.size(); }
+
+  /// oldest live window
+  uint64_t GetFirstWindow() const { return mFirstWindow; }
+
+  /// append one item to its time window. A window beyond the live range
+  /// rolls the ring forward, evicting the expired windows; a window older
+  /// than the live range is rejected and counted
+  /// @return false for a late item
+  bool Append(uint64_t window, const T& item)
+  {
+    if (window < mFirstWindow) {
+      ++mLateCount;
+      return false;
+    }
+    if (window >= mFirstWindow + mSlots.size()) {
+      AdvanceTo(window - mSlots.size() + 1);
+    }
+    mSlots[window % mSlots.size()].push_back(item);
+    ++mOccupancy;
+    ++mAppendedCount;
+    if (mOccupancy > mMaxOccupancy) {
+      mMaxOccupancy = mOccupancy;
+    }
+    return true;
+  }
+
+  /// evict every window older than firstLiveWindow, oldest first; each one
+  /// is handed to the eviction callback as a whole
+  void AdvanceTo(uint64_t firstLiveWindow)
+  {
+    while (mFirstWindow < firstLiveWindow) {
+      std::vector<T>& slot = mSlots[mFirstWindow % mSlots.size()];
+      if (!slot.empty()) {
+        mOccupancy -= slot.size();
+        if (mCallback) {
+          mCallback(mFirstWindow, slot);
+        }
+        // the capacity stays with the slot for its next window
+        slot.clear();
+      }
+      ++mFirstWindow;
+    }
+  }
+
+  /// evict all live windows, e.g. at the end of the run
+  void Flush() { AdvanceTo(mFirstWindow + mSlots.size()); }
+
+  // occupancy metrics
+  /// items currently held over all live windows
+  size_t GetOccupancy() const { return mOccupancy; }
+  /// largest occupancy seen
+  size_t GetMaxOccupancy() const { return mMaxOccupancy; }
+  /// items of one live window; 0 outside the live range
+  size_t GetWindowOccupancy(uint64_t window) const
+  {
+    if (window < mFirstWindow || window >= mFirstWindow + mSlots.size()) {
+      return 0;
+    }
+    return mSlots[window % mSlots.size()].size();
+  }
+  /// items accepted over the lifetime of the ring
+  uint64_t GetAppendedCount() const { return mAppendedCount; }
+  /// items rejected because their window had already been evicted
+  uint64_t GetLateCount() const { return mLateCount; }
+
+ private:
+  std::vector<std::vector<T>> mSlots; ///< one pooled item vector per live window
+  EvictionCallback mCallback;         ///< receives the expired windows
+  uint64_t mFirstWindow;              ///< oldest live window
+  size_t mOccupancy;                  ///< items over all live windows
+  size_t mMaxOccupancy;               ///< largest occupancy seen
+  uint64_t mAppendedCount;            ///< accepted items
+  uint64_t mLateCount;                ///< rejected late items
+};
+
+} // namespace Concurrency
+} // namespace AliceO2
+
+#endif // ALICEO2_CONCURRENCY_TIMEWINDOWRING_H_
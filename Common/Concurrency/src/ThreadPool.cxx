@@ -0,0 +1,223 @@
+/// \file ThreadPool.cxx
+/// \brief Implementation of the shared work-stealing thread pool
+
+#include "Concurrency/ThreadPool.h"
+
+#include <cstdlib>
+
+using namespace AliceO2::Concurrency;
+
+namespace {
+
+// worker identity of the calling thread, for deadlock-free waiting
+thread_local ThreadPool* tWorkerPool = nullptr;
+thread_local int tWorkerIndex = -1;
+
+}
+
+//__________________________________________________________________________________________________
+ThreadPool::ThreadPool(int numWorkers)
+  : mQueues()
+  , mWorkers()
+  , mWakeMutex()
+  , mWakeCv()
+  , mReadyCount(0)
+  , mNextQueue(0)
+  , mRunning(true)
+{
+  if (numWorkers <= 0) {
+    const char* env = getenv("O2_THREAD_POOL_SIZE");
+    if (env != nullptr) {
+      numWorkers = atoi(env);
+    }
+    if (numWorkers <= 0) {
+      numWorkers = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (numWorkers <= 0) {
+      numWorkers = 1;
+    }
+  }
+
+  mQueues.reserve(numWorkers);
+  for (int i = 0; i < numWorkers; ++i) {
+    mQueues.emplace_back(new WorkerQueue);
+  }
+  mWorkers.reserve(numWorkers);
+  for (int i = 0; i < numWorkers; ++i) {
+    mWorkers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+//__________________________________________________________________________________________________
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock{mWakeMutex};
+    mRunning = false;
+  }
+  mWakeCv.notify_all();
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+//__________________________________________________________________________________________________
+ThreadPool& ThreadPool::Instance()
+{
+  static ThreadPool pool{0};
+  return pool;
+}
+
+//__________________________________________________________________________________________________
+ThreadPool::TaskHandle ThreadPool::Submit(std::function<void()> work)
+{
+  TaskHandle task{new Task{std::move(work)}};
+  Enqueue(task);
+  return task;
+}
+
+//__________________________________________________________________________________________________
+ThreadPool::TaskHandle ThreadPool::Submit(std::function<void()> work,
+                                          const std::vector<TaskHandle>& dependencies)
+{
+  TaskHandle task{new Task{std::move(work)}};
+  // the extra count keeps the task from becoming ready while dependencies
+  // are still being registered
+  task->pending.store(1 + static_cast<int>(dependencies.size()), std::memory_order_relaxed);
+
+  int alreadyDone = 0;
+  for (const TaskHandle& dependency : dependencies) {
+    std::lock_guard<std::mutex> lock{dependency->mutex};
+    if (dependency->done.load(std::memory_order_acquire)) {
+      ++alreadyDone;
+    } else {
+      dependency->successors.push_back(task);
+    }
+  }
+
+  // drop the registration guard together with the already completed
+  // dependencies; whoever brings the count to zero enqueues
+  if (task->pending.fetch_sub(1 + alreadyDone, std::memory_order_acq_rel) == 1 + alreadyDone) {
+    Enqueue(task);
+  }
+  return task;
+}
+
+//__________________________________________________________________________________________________
+void ThreadPool::Wait(const TaskHandle& task)
+{
+  if (tWorkerPool == this) {
+    // executing other queued work keeps the pool making progress even when
+    // every worker is waiting on a dependency
+    while (!task->done.load(std::memory_order_acquire)) {
+      TaskHandle other = PopTask(tWorkerIndex);
+      if (other) {
+        Execute(other);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock{task->mutex};
+  task->waitCv.wait(lock, [&task] { return task->done.load(std::memory_order_acquire); });
+}
+
+//__________________________________________________________________________________________________
+void ThreadPool::Enqueue(const TaskHandle& task)
+{
+  // a worker pushes to its own queue (popped LIFO, the data is hot);
+  // external threads distribute round-robin
+  size_t target = (tWorkerPool == this)
+    ? tWorkerIndex
+    : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+  {
+    std::lock_guard<std::mutex> lock{mQueues[target]->mutex};
+    mQueues[target]->tasks.push_back(task);
+  }
+  {
+    // the count is bumped under the wake mutex, so a worker evaluating the
+    // sleep predicate can not miss it
+    std::lock_guard<std::mutex> lock{mWakeMutex};
+    mReadyCount.fetch_add(1, std::memory_order_release);
+  }
+  mWakeCv.notify_one();
+}
+
+//__________________________________________________________________________________________________
+ThreadPool::TaskHandle ThreadPool::PopTask(int index)
+{
+  TaskHandle task;
+  {
+    // own queue from the back: most recently pushed work first
+    std::lock_guard<std::mutex> lock{mQueues[index]->mutex};
+    if (!mQueues[index]->tasks.empty()) {
+      task = std::move(mQueues[index]->tasks.back());
+      mQueues[index]->tasks.pop_back();
+    }
+  }
+  if (!task) {
+    // steal from the front of the other queues, skipping queues that are
+    // busy right now
+    const size_t numQueues = mQueues.size();
+    for (size_t offset = 1; offset < numQueues && !task; ++offset) {
+      WorkerQueue& victim = *mQueues[(index + offset) % numQueues];
+      std::unique_lock<std::mutex> lock{victim.mutex, std::try_to_lock};
+      if (lock.owns_lock() && !victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+      }
+    }
+  }
+  if (task) {
+    mReadyCount.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+//__________________________________________________________________________________________________
+void ThreadPool::Execute(const TaskHandle& task)
+{
+  task->work();
+  task->work = nullptr; // release captured state early
+
+  std::vector<TaskHandle> successors;
+  {
+    std::lock_guard<std::mutex> lock{task->mutex};
+    task->done.store(true, std::memory_order_release);
+    successors.swap(task->successors);
+  }
+  task->waitCv.notify_all();
+
+  for (const TaskHandle& successor : successors) {
+    if (successor->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Enqueue(successor);
+    }
+  }
+}
+
+//__________________________________________________________________________________________________
+void ThreadPool::WorkerLoop(int index)
+{
+  tWorkerPool = this;
+  tWorkerIndex = index;
+
+  while (true) {
+    TaskHandle task = PopTask(index);
+    if (task) {
+      Execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock{mWakeMutex};
+    if (!mRunning && mReadyCount.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+    mWakeCv.wait(lock, [this] {
+      return !mRunning || mReadyCount.load(std::memory_order_acquire) > 0;
+    });
+    if (!mRunning && mReadyCount.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+  }
+}
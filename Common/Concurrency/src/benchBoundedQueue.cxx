@@ -0,0 +1,158 @@
+/// \file benchBoundedQueue.cxx
+/// \brief Contention benchmark for the bounded MPMC queue
+///
+/// Pushes a fixed number of items through the queue with a configurable
+/// number of producer and consumer threads and batch size, and compares
+/// the throughput against a plain mutex+condition-variable queue as used
+/// by the ad-hoc pipeline FIFOs so far.
+///
+/// Usage: benchBoundedQueue [nproducers] [nconsumers] [nitems] [batchsize]
+
+#include "Concurrency/BoundedQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using AliceO2::Concurrency::BoundedQueue;
+
+namespace {
+
+/// the mutex+condition-variable reference, one lock per operation
+class MutexQueue
+{
+ public:
+  explicit MutexQueue(size_t capacity) : mCapacity(capacity) {}
+
+  void Push(int value)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [this] { return mQueue.size() < mCapacity; });
+    mQueue.push(value);
+    mNotEmpty.notify_one();
+  }
+
+  int Pop()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotEmpty.wait(lock, [this] { return !mQueue.empty(); });
+    int value = mQueue.front();
+    mQueue.pop();
+    mNotFull.notify_one();
+    return value;
+  }
+
+ private:
+  size_t mCapacity;
+  std::queue<int> mQueue;
+  std::mutex mMutex;
+  std::condition_variable mNotFull;
+  std::condition_variable mNotEmpty;
+};
+
+double itemsPerSecond(long nItems, std::chrono::steady_clock::duration duration)
+{
+  double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  return (seconds > 0.) ? nItems / seconds : 0.;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  int nProducers = 2;
+  int nConsumers = 2;
+  long nItems = 1000000;
+  int batchSize = 8;
+  if (argc > 1) nProducers = atoi(argv[1]);
+  if (argc > 2) nConsumers = atoi(argv[2]);
+  if (argc > 3) nItems = atol(argv[3]);
+  if (argc > 4) batchSize = atoi(argv[4]);
+  if (nProducers < 1 || nConsumers < 1 || nItems < 1 || batchSize < 1) {
+    std::cerr << "usage: benchBoundedQueue [nproducers] [nconsumers] [nitems] [batchsize]" << std::endl;
+    return 1;
+  }
+  const long nItemsPerProducer = nItems / nProducers;
+  nItems = nItemsPerProducer * nProducers;
+  const size_t capacity = 1024;
+
+  std::cout << nProducers << " producer(s), " << nConsumers << " consumer(s), "
+            << nItems << " item(s), batch size " << batchSize << std::endl;
+
+  // bounded MPMC queue, single-item and batched operation
+  for (int run = 0; run < 2; ++run) {
+    const int batch = (run == 0) ? 1 : batchSize;
+    BoundedQueue<int> queue{capacity};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int producer = 0; producer < nProducers; ++producer) {
+      threads.emplace_back([&queue, batch, nItemsPerProducer] {
+        std::vector<int> values(batch);
+        for (long i = 0; i < nItemsPerProducer;) {
+          long count = batch;
+          if (count > nItemsPerProducer - i) count = nItemsPerProducer - i;
+          for (long k = 0; k < count; ++k) values[k] = int(i + k);
+          long pushed = long(queue.TryPushN(&values[0], count));
+          if (pushed == 0) {
+            queue.Push(values[0]);
+            pushed = 1;
+          }
+          i += pushed;
+        }
+      });
+    }
+    std::atomic<long> nPopped{0};
+    for (int consumer = 0; consumer < nConsumers; ++consumer) {
+      threads.emplace_back([&queue, &nPopped, batch, nItems] {
+        std::vector<int> values(batch);
+        while (nPopped.load() < nItems) {
+          long count = long(queue.TryPopN(&values[0], batch));
+          if (count == 0) {
+            int value = 0;
+            if (!queue.Pop(value, 1)) continue;
+            count = 1;
+          }
+          nPopped.fetch_add(count);
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << "BoundedQueue batch " << batch << ": "
+              << itemsPerSecond(nItems, duration) << " items/s" << std::endl;
+  }
+
+  // mutex+condition-variable reference; consumers run until they receive
+  // a sentinel, pushed after all producers are done
+  {
+    MutexQueue queue{capacity};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+    auto start = std::chrono::steady_clock::now();
+    for (int producer = 0; producer < nProducers; ++producer) {
+      producers.emplace_back([&queue, nItemsPerProducer] {
+        for (long i = 0; i < nItemsPerProducer; ++i) queue.Push(int(i));
+      });
+    }
+    for (int consumer = 0; consumer < nConsumers; ++consumer) {
+      consumers.emplace_back([&queue] {
+        while (queue.Pop() >= 0) {
+        }
+      });
+    }
+    for (auto& thread : producers) thread.join();
+    for (int consumer = 0; consumer < nConsumers; ++consumer) queue.Push(-1);
+    for (auto& thread : consumers) thread.join();
+    auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << "MutexQueue:           "
+              << itemsPerSecond(nItems, duration) << " items/s" << std::endl;
+  }
+
+  return 0;
+}
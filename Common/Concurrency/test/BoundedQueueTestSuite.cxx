@@ -0,0 +1,138 @@
+#define BOOST_TEST_MODULE Test Common Concurrency BoundedQueue
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Concurrency/BoundedQueue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+BOOST_AUTO_TEST_CASE(singleThreaded_test)
+{
+  BoundedQueue<int> queue{4};
+  BOOST_CHECK_EQUAL(queue.GetCapacity(), 4);
+
+  // fill to capacity, the next push must be rejected
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(queue.TryPush(i));
+  }
+  BOOST_CHECK(!queue.TryPush(4));
+  BOOST_CHECK_EQUAL(queue.GetSize(), 4);
+
+  // items come back in order, the pop on the empty queue is rejected
+  for (int i = 0; i < 4; ++i) {
+    int value = -1;
+    BOOST_CHECK(queue.TryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+  int value = -1;
+  BOOST_CHECK(!queue.TryPop(value));
+}
+
+BOOST_AUTO_TEST_CASE(batch_test)
+{
+  BoundedQueue<int> queue{8};
+  const int items[6] = {0, 1, 2, 3, 4, 5};
+
+  BOOST_CHECK_EQUAL(queue.TryPushN(items, 6), 6);
+  // only two cells left, the batch is truncated
+  BOOST_CHECK_EQUAL(queue.TryPushN(items, 6), 2);
+
+  int popped[8] = {0};
+  BOOST_CHECK_EQUAL(queue.TryPopN(popped, 8), 8);
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK_EQUAL(popped[i], i);
+  }
+  BOOST_CHECK_EQUAL(popped[6], 0);
+  BOOST_CHECK_EQUAL(popped[7], 1);
+  BOOST_CHECK_EQUAL(queue.TryPopN(popped, 8), 0);
+}
+
+BOOST_AUTO_TEST_CASE(blockingTimeout_test)
+{
+  BoundedQueue<int> queue{2};
+
+  int value = -1;
+  // empty queue: the timed pop has to return after the timeout
+  BOOST_CHECK(!queue.Pop(value, 10));
+
+  BOOST_CHECK(queue.Push(1));
+  BOOST_CHECK(queue.Push(2));
+  // full queue: the timed push has to return after the timeout
+  BOOST_CHECK(!queue.Push(3, 10));
+
+  // a delayed consumer unblocks the producer
+  std::thread consumer([&queue] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    int popped = -1;
+    queue.Pop(popped);
+  });
+  BOOST_CHECK(queue.Push(3, 1000));
+  consumer.join();
+}
+
+BOOST_AUTO_TEST_CASE(mpmcStress_test)
+{
+  BoundedQueue<int> queue{64};
+  const int nProducers = 4;
+  const int nConsumers = 4;
+  const int nItemsPerProducer = 10000;
+
+  std::atomic<long> sum{0};
+  std::atomic<int> nPopped{0};
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < nProducers; ++producer) {
+    threads.emplace_back([&queue, producer] {
+      int batch[8];
+      for (int i = 0; i < nItemsPerProducer;) {
+        int count = 0;
+        while (count < 8 && i + count < nItemsPerProducer) {
+          batch[count] = producer * nItemsPerProducer + i + count;
+          ++count;
+        }
+        int pushed = int(queue.TryPushN(batch, count));
+        if (pushed == 0) {
+          queue.Push(batch[0]);
+          pushed = 1;
+        }
+        i += pushed;
+      }
+    });
+  }
+  for (int consumer = 0; consumer < nConsumers; ++consumer) {
+    threads.emplace_back([&queue, &sum, &nPopped] {
+      int batch[8];
+      while (nPopped.load() < nProducers * nItemsPerProducer) {
+        size_t count = queue.TryPopN(batch, 8);
+        if (count == 0) {
+          int value = -1;
+          if (!queue.Pop(value, 1)) {
+            continue;
+          }
+          batch[0] = value;
+          count = 1;
+        }
+        long local = 0;
+        for (size_t i = 0; i < count; ++i) {
+          local += batch[i];
+        }
+        sum.fetch_add(local);
+        nPopped.fetch_add(int(count));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const long nItems = long(nProducers) * nItemsPerProducer;
+  BOOST_CHECK_EQUAL(nPopped.load(), nItems);
+  BOOST_CHECK_EQUAL(sum.load(), nItems * (nItems - 1) / 2);
+}
+
+} // namespace Concurrency
+} // namespace AliceO2
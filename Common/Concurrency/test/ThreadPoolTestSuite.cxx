@@ -0,0 +1,106 @@
+#define BOOST_TEST_MODULE Test Common Concurrency
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Concurrency/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+BOOST_AUTO_TEST_CASE(submitAndWait_test)
+{
+  ThreadPool pool{4};
+  BOOST_CHECK_EQUAL(pool.GetNumWorkers(), 4);
+
+  std::atomic<int> sum{0};
+  std::vector<ThreadPool::TaskHandle> tasks;
+  const int nTasks = 1000;
+  for (int i = 0; i < nTasks; ++i) {
+    tasks.push_back(pool.Submit([&sum, i] { sum.fetch_add(i); }));
+  }
+  for (const auto& task : tasks) {
+    pool.Wait(task);
+  }
+  BOOST_CHECK_EQUAL(sum.load(), nTasks * (nTasks - 1) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(dependencyChain_test)
+{
+  ThreadPool pool{2};
+
+  // each link multiplies after its predecessor added, so any reordering
+  // changes the result
+  std::atomic<int> value{1};
+  auto add = pool.Submit([&value] { value.fetch_add(2); });
+  auto multiply = pool.Submit([&value] { value.store(value.load() * 10); }, {add});
+  auto subtract = pool.Submit([&value] { value.fetch_sub(5); }, {multiply});
+
+  pool.Wait(subtract);
+  BOOST_CHECK_EQUAL(value.load(), 25);
+}
+
+BOOST_AUTO_TEST_CASE(diamondGraph_test)
+{
+  ThreadPool pool{4};
+
+  std::atomic<int> forks{0};
+  std::atomic<int> joinSeen{-1};
+  auto top = pool.Submit([] {});
+  auto left = pool.Submit([&forks] { forks.fetch_add(1); }, {top});
+  auto right = pool.Submit([&forks] { forks.fetch_add(1); }, {top});
+  auto join = pool.Submit([&forks, &joinSeen] { joinSeen.store(forks.load()); }, {left, right});
+
+  pool.Wait(join);
+  // the join must have observed both forks
+  BOOST_CHECK_EQUAL(joinSeen.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(dependencyOnFinishedTask_test)
+{
+  ThreadPool pool{2};
+
+  auto first = pool.Submit([] {});
+  pool.Wait(first);
+  // a dependency that already completed must not stall the successor
+  std::atomic<bool> ran{false};
+  auto second = pool.Submit([&ran] { ran.store(true); }, {first});
+  pool.Wait(second);
+  BOOST_CHECK(ran.load());
+}
+
+BOOST_AUTO_TEST_CASE(waitInsideTask_test)
+{
+  // fewer workers than nested waits: progress requires the waiting workers
+  // to execute other queued tasks instead of blocking
+  ThreadPool pool{2};
+
+  std::atomic<int> completed{0};
+  std::vector<ThreadPool::TaskHandle> outer;
+  for (int i = 0; i < 8; ++i) {
+    outer.push_back(pool.Submit([&pool, &completed] {
+      auto inner = pool.Submit([&completed] { completed.fetch_add(1); });
+      pool.Wait(inner);
+      completed.fetch_add(1);
+    }));
+  }
+  for (const auto& task : outer) {
+    pool.Wait(task);
+  }
+  BOOST_CHECK_EQUAL(completed.load(), 16);
+}
+
+BOOST_AUTO_TEST_CASE(sharedInstance_test)
+{
+  ThreadPool& pool = ThreadPool::Instance();
+  BOOST_CHECK(&pool == &ThreadPool::Instance());
+  BOOST_CHECK(pool.GetNumWorkers() >= 1);
+
+  auto task = pool.Submit([] {});
+  pool.Wait(task);
+}
+
+} // namespace Concurrency
+} // namespace AliceO2
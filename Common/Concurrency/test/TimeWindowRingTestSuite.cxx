@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Test Common Concurrency TimeWindowRing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Concurrency/TimeWindowRing.h"
+
+#include <vector>
+
+namespace AliceO2 {
+namespace Concurrency {
+
+BOOST_AUTO_TEST_CASE(appendAndAdvance_test)
+{
+  TimeWindowRing<int> ring{4};
+  std::vector<uint64_t> evictedWindows;
+  std::vector<int> evictedItems;
+  ring.SetEvictionCallback([&](uint64_t window, std::vector<int>& items) {
+    evictedWindows.push_back(window);
+    evictedItems.insert(evictedItems.end(), items.begin(), items.end());
+  });
+
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(ring.Append(i, 10 * i));
+  }
+  BOOST_CHECK_EQUAL(ring.GetOccupancy(), 4);
+  BOOST_CHECK_EQUAL(ring.GetWindowOccupancy(2), 1);
+
+  // advancing evicts the expired windows in order, as whole windows
+  ring.AdvanceTo(2);
+  BOOST_CHECK_EQUAL(evictedWindows.size(), 2);
+  BOOST_CHECK_EQUAL(evictedWindows[0], 0);
+  BOOST_CHECK_EQUAL(evictedWindows[1], 1);
+  BOOST_CHECK_EQUAL(evictedItems[0], 0);
+  BOOST_CHECK_EQUAL(evictedItems[1], 10);
+  BOOST_CHECK_EQUAL(ring.GetOccupancy(), 2);
+  BOOST_CHECK_EQUAL(ring.GetFirstWindow(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(autoRollAndLate_test)
+{
+  TimeWindowRing<int> ring{2};
+  std::vector<uint64_t> evictedWindows;
+  ring.SetEvictionCallback(
+    [&](uint64_t window, std::vector<int>&) { evictedWindows.push_back(window); });
+
+  BOOST_CHECK(ring.Append(0, 1));
+  BOOST_CHECK(ring.Append(1, 2));
+  // a window beyond the live range rolls the ring, evicting window 0
+  BOOST_CHECK(ring.Append(2, 3));
+  BOOST_CHECK_EQUAL(evictedWindows.size(), 1);
+  BOOST_CHECK_EQUAL(evictedWindows[0], 0);
+  BOOST_CHECK_EQUAL(ring.GetFirstWindow(), 1);
+
+  // an item for the evicted window is late
+  BOOST_CHECK(!ring.Append(0, 4));
+  BOOST_CHECK_EQUAL(ring.GetLateCount(), 1);
+  BOOST_CHECK_EQUAL(ring.GetAppendedCount(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(flush_test)
+{
+  TimeWindowRing<int> ring{3};
+  size_t evictedItems = 0;
+  ring.SetEvictionCallback(
+    [&](uint64_t, std::vector<int>& items) { evictedItems += items.size(); });
+
+  for (int i = 0; i < 6; ++i) {
+    BOOST_CHECK(ring.Append(i / 2, i));
+  }
+  BOOST_CHECK_EQUAL(ring.GetMaxOccupancy(), 6);
+
+  ring.Flush();
+  BOOST_CHECK_EQUAL(evictedItems, 6);
+  BOOST_CHECK_EQUAL(ring.GetOccupancy(), 0);
+  BOOST_CHECK_EQUAL(ring.GetWindowOccupancy(0), 0);
+}
+
+} // namespace Concurrency
+} // namespace AliceO2
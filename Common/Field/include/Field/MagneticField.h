@@ -7,6 +7,7 @@
 
 #include "FairField.h"         // for FairField
 #include "Field/MagFieldParam.h"
+#include "Field/MagneticFieldCache.h"       // for MagneticFieldCache
 #include "Field/MagneticWrapperChebyshev.h" // for MagneticWrapperChebyshev
 #include "TSystem.h"
 #include "Rtypes.h"            // for Double_t, Char_t, Int_t, Float_t, etc
@@ -63,6 +64,10 @@ class MagneticField : public FairField
     /// real field creation is here
     void CreateField();
 
+    /// Builds the optional grid cache for the solenoid volume, see enableFieldCache;
+    /// called once by the framework after the field is attached to the run
+    virtual void Init();
+
     /// Virtual methods from FairField
 
     /// X component, avoid using since slow
@@ -91,6 +96,12 @@ class MagneticField : public FairField
     /// 3d field query alias for Alias Method to calculate the field at point xyz
     virtual void GetBxyz(const Double_t p[3], Double_t* b) {Field(p,b);}
 
+    /// Same as GetBxyz but with a per-caller segment memo, see
+    /// MagneticWrapperChebyshev::CachedSegment: the segment of the previous query is
+    /// tried first, making the lookup O(1) for consecutive points of a propagating
+    /// track. Each caller (e.g. each tracking thread) owns its handle
+    void GetBxyz(const Double_t p[3], Double_t *b, MagneticWrapperChebyshev::CachedSegment &memo) const;
+
     /// Fill Paramater
     virtual void FillParContainer();
     
@@ -110,8 +121,54 @@ class MagneticField : public FairField
     /// Method to calculate the field at point xyz
     Double_t getBz(const Double_t *xyz) const;
 
+    /// Inline Bz fast path for per-propagation-step queries: no virtual
+    /// dispatch, a direct grid-cache lookup when the cache covers the point
+    /// (see enableFieldCache) and the exact getBz path otherwise. Cheap
+    /// enough to replace the constant-solenoid approximation in the trackers
+    Double_t getBzFast(const Double_t *xyz) const
+    {
+      if (mFieldCache.isBuilt() && mFieldCache.isInside(xyz)) {
+        return mFieldCache.getBz(xyz) * mMultipicativeFactorSolenoid;
+      }
+      return getBz(xyz);
+    }
+
+    /// Cheap bounding-volume test for the barrel region. The bounds are a
+    /// conservative subset of the solenoid coverage of every production map
+    /// (-550<Z<550 cm, R<500 cm), so a point passing the test can go straight
+    /// to the solenoid parameterization: no dipole dispatch, no map range
+    /// checks, no dipole/solenoid factor decision. Barrel tracking never
+    /// touches the dipole but pays its dispatch on every query otherwise
+    static constexpr Bool_t isBarrelPoint(const Double_t *xyz)
+    {
+      return xyz[2] > sBarrelZMin && xyz[2] < sBarrelZMax &&
+             xyz[0] * xyz[0] + xyz[1] * xyz[1] < sBarrelRadiusMax2;
+    }
+
     MagneticWrapperChebyshev *getMeasuredMap() const { return mMeasuredMap.get();}
 
+    /// Requests the precomputed grid cache for solenoid-volume queries with the given
+    /// node spacing in cm; the grid itself is filled at Init. GetFieldValue then answers
+    /// from the cache by trilinear interpolation instead of the exact Chebyshev
+    /// evaluation, trading memory (~13 MB at 10 cm, see MagneticFieldCache) for an
+    /// order of magnitude cheaper per-step lookup. Bz and integral queries stay exact
+    void enableFieldCache(Double_t spacing = 10.)
+    {
+      mFieldCacheSpacing = spacing;
+    }
+
+    /// Disables the cache and frees its memory
+    void disableFieldCache()
+    {
+      mFieldCacheSpacing = 0;
+      mFieldCache.clear();
+    }
+
+    Bool_t isFieldCacheEnabled() const
+    {
+      return mFieldCacheSpacing > 0;
+    }
+
     // Former MagF methods or their aliases
 
     /// Sets the sign/scale of the current in the L3 according to sPolarityConvention
@@ -244,6 +301,8 @@ class MagneticField : public FairField
 
   protected:
     std::unique_ptr<MagneticWrapperChebyshev> mMeasuredMap; //! Measured part of the field map
+    MagneticFieldCache mFieldCache;         //! optional grid cache for solenoid-volume queries
+    Double_t mFieldCacheSpacing;            ///< requested cache node spacing in cm, 0 = cache disabled
     MagFieldParam::BMap_t mMapType;         ///< field map type
     Double_t mSolenoid;                     ///< Solenoid field setting
     MagFieldParam::BeamType_t mBeamType;    ///< Beam type: A-A (mBeamType=0) or p-p (mBeamType=1)
@@ -267,6 +326,10 @@ class MagneticField : public FairField
     static const Double_t sSolenoidToDipoleZ;  ///< conventional Z of transition from L3 to Dipole field
     static const UShort_t sPolarityConvention; ///< convention for the mapping of the curr.sign on main component sign
 
+    static constexpr Double_t sBarrelZMin = -500.;          ///< barrel bounding volume, inside the solenoid coverage
+    static constexpr Double_t sBarrelZMax = 500.;           ///< barrel bounding volume, inside the solenoid coverage
+    static constexpr Double_t sBarrelRadiusMax2 = 500. * 500.; ///< barrel bounding volume, R^2
+
     FairLogger *mLogger;
 
    private:
@@ -275,7 +338,7 @@ class MagneticField : public FairField
 
     
     ClassDef(AliceO2::Field::MagneticField,
-    3) // Class for all Alice MagField wrapper for measured data + Tosca parameterization
+    4) // Class for all Alice MagField wrapper for measured data + Tosca parameterization
 };
 }
 }
@@ -0,0 +1,106 @@
+/// \file MagneticFieldCache.h
+/// \brief Definition of the MagneticFieldCache class
+
+#ifndef ALICEO2_FIELD_MAGNETICFIELDCACHE_H_
+#define ALICEO2_FIELD_MAGNETICFIELDCACHE_H_
+
+#include <vector>
+#include "Rtypes.h"  // for Float_t, Double_t, Int_t, Bool_t
+
+namespace AliceO2 {
+namespace Field {
+
+class MagneticWrapperChebyshev;
+
+/// Precomputed cartesian grid cache in front of the Chebyshev field parameterization.
+/// The grid covers the solenoid volume where the central trackers live; lookups
+/// interpolate trilinearly between the 8 surrounding nodes, replacing the segment
+/// search plus Chebyshev evaluation of the exact path with a handful of
+/// multiply-adds. The spacing is configurable: the memory cost is
+/// 12 bytes per node, i.e. ~13 MB for the default 10 cm spacing and ~1.6 GB for
+/// 2 cm, to be traded against the interpolation error (sub-Gauss at 10 cm for
+/// the smooth solenoid map). Points outside the grid must be handled by the
+/// caller through the exact path
+class MagneticFieldCache
+{
+  public:
+    MagneticFieldCache();
+
+    ~MagneticFieldCache() = default;
+
+    /// Fills the grid from the measured map with the given node spacing (cm).
+    /// Nodes outside of the parameterized volume hold zero field, so the
+    /// interpolation degrades gracefully at the volume boundary
+    void buildGrid(const MagneticWrapperChebyshev &map, Double_t spacing);
+
+    /// Frees the grid content
+    void clear();
+
+    Bool_t isBuilt() const
+    {
+      return !mContent.empty();
+    }
+
+    /// Checks whether the cartesian point is covered by the grid
+    Bool_t isInside(const Double_t *xyz) const
+    {
+      return isBuilt() && xyz[0] >= mOrigin[0] && xyz[0] <= mOrigin[0] + mSpacing * (mNumberOfNodes[0] - 1) &&
+             xyz[1] >= mOrigin[1] && xyz[1] <= mOrigin[1] + mSpacing * (mNumberOfNodes[1] - 1) &&
+             xyz[2] >= mOrigin[2] && xyz[2] <= mOrigin[2] + mSpacing * (mNumberOfNodes[2] - 1);
+    }
+
+    /// Computes the field at the cartesian point by trilinear interpolation.
+    /// The point must be inside the grid, see isInside
+    void Field(const Double_t *xyz, Double_t *b) const;
+
+    /// Bz-only variant of Field, inlined for per-propagation-step queries:
+    /// interpolates the single z component instead of all three.
+    /// The point must be inside the grid, see isInside
+    Double_t getBz(const Double_t *xyz) const
+    {
+      Int_t index[3];
+      Double_t fraction[3];
+      for (int i = 3; i--;) {
+        Double_t cell = (xyz[i] - mOrigin[i]) * mInverseSpacing;
+        index[i] = Int_t(cell);
+        if (index[i] > mNumberOfNodes[i] - 2) { // point on the upper grid face
+          index[i] = mNumberOfNodes[i] - 2;
+        }
+        fraction[i] = cell - index[i];
+      }
+      const size_t strideY = mNumberOfNodes[0];
+      const size_t strideZ = strideY * mNumberOfNodes[1];
+      // offset 2 selects the z component of the 3 floats per node
+      const Float_t *node000 = &mContent[3 * (index[0] + strideY * index[1] + strideZ * index[2]) + 2];
+      const Double_t wx1 = fraction[0], wx0 = 1. - wx1;
+      const Double_t wy1 = fraction[1], wy0 = 1. - wy1;
+      const Double_t wz1 = fraction[2], wz0 = 1. - wz1;
+      Double_t c00 = node000[0] * wx0 + node000[3] * wx1;
+      Double_t c10 = node000[3 * strideY] * wx0 + node000[3 * strideY + 3] * wx1;
+      Double_t c01 = node000[3 * strideZ] * wx0 + node000[3 * strideZ + 3] * wx1;
+      Double_t c11 = node000[3 * (strideY + strideZ)] * wx0 + node000[3 * (strideY + strideZ) + 3] * wx1;
+      return (c00 * wy0 + c10 * wy1) * wz0 + (c01 * wy0 + c11 * wy1) * wz1;
+    }
+
+    Double_t getSpacing() const
+    {
+      return mSpacing;
+    }
+
+    /// Returns the memory used by the grid content in bytes
+    size_t getCacheSize() const
+    {
+      return mContent.size() * sizeof(Float_t);
+    }
+
+  private:
+    Double_t mSpacing;            ///< node spacing in cm
+    Double_t mInverseSpacing;     ///< 1/spacing, cached for the lookup
+    Double_t mOrigin[3];          ///< coordinates of the grid node (0,0,0)
+    Int_t mNumberOfNodes[3];      ///< number of grid nodes per dimension
+    std::vector<Float_t> mContent; ///< 3 field components per node, x index fastest
+};
+}
+}
+
+#endif
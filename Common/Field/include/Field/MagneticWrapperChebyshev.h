@@ -42,6 +42,20 @@ class MagneticWrapperChebyshev : public TNamed
 {
 
   public:
+    /// Per-caller memo for the segment search, see the cached Field overload.
+    /// Each caller (e.g. each propagator thread) owns its handle; the wrapper
+    /// itself is not modified by the cached queries, so concurrent callers with
+    /// separate handles are safe
+    struct CachedSegment
+    {
+      CachedSegment() : solenoid(-1), dipole(-1)
+      {
+      }
+
+      Int_t solenoid; ///< last solenoid segment used, -1 when unknown
+      Int_t dipole;   ///< last dipole segment used, -1 when unknown
+    };
+
     /// Default constructor
     MagneticWrapperChebyshev();
 
@@ -199,10 +213,33 @@ class MagneticWrapperChebyshev : public TNamed
     /// it gets it at closest valid point
     virtual void Field(const Double_t *xyz, Double_t *b) const;
 
+    /// Computes the field for a batch of n points in cartesian coordinates;
+    /// xyz holds n (x,y,z) triplets and b receives n (bx,by,bz) triplets.
+    /// Runs of consecutive points falling into the same solenoid segment,
+    /// the common case for a propagating track, are evaluated together
+    /// through the vectorized Chebyshev batch evaluation; the other points
+    /// fall back to the scalar path
+    void Field(const Double_t *xyz, Int_t n, Double_t *b) const;
+
+    /// Same as the scalar Field but with a per-caller segment memo: the segment
+    /// used for the previous query is tried first and the binary segment search
+    /// runs only when the point left it. Consecutive queries of a propagating
+    /// track land in the same segment almost always, making the lookup O(1) on
+    /// that path. The parameterizations overlap slightly at segment borders, so
+    /// evaluating through any parameterization containing the point is valid
+    /// (findSolenoidSegment itself relies on this for its neighbour-bin fallback)
+    void Field(const Double_t *xyz, Double_t *b, CachedSegment &memo) const;
+
     /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
     /// it gets it at closest valid point
     Double_t getBz(const Double_t *xyz) const;
 
+    /// Solenoid-only variants of Field and getBz for points the caller already
+    /// knows to be in the barrel (see MagneticField::isBarrelPoint): they go
+    /// straight to the solenoid parameterization without considering the dipole
+    void FieldSolenoid(const Double_t *xyz, Double_t *b) const;
+    Double_t getBzSolenoid(const Double_t *xyz) const;
+
     void fieldCylindrical(const Double_t *rphiz, Double_t *b) const;
 
     /// Computes TPC region field integral in cartesian coordinates.
@@ -255,6 +292,16 @@ class MagneticWrapperChebyshev : public TNamed
     /// Writes coefficients data to output text file
     void saveData(const char* outfile) const;
 
+    /// Writes the full set of coefficient tables in the raw binary snapshot
+    /// format, with version and endianness tags, see loadBinary
+    void saveBinary(const char* outfile) const;
+
+    /// Reads the coefficient tables from the binary snapshot written by saveBinary:
+    /// a single sequential read of the raw arrays instead of the line-by-line text
+    /// parsing of loadData. The snapshot is rejected if version or endianness do
+    /// not match, in the latter case it must be regenerated on this architecture
+    void loadBinary(const char* inpfile);
+
     /// Finds all boundaries in dimension dim for boxes in given region.
     /// if mn > mx for given projection the check is not done for it.
     Int_t segmentDimension(Float_t** seg, const TObjArray* par, int npar, int dim, Float_t xmn, Float_t xmx, Float_t ymn,
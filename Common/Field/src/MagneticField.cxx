@@ -18,6 +18,10 @@ ClassImp(MagneticField)
   const
 Double_t MagneticField::sSolenoidToDipoleZ = -700.;
 
+constexpr Double_t MagneticField::sBarrelZMin;
+constexpr Double_t MagneticField::sBarrelZMax;
+constexpr Double_t MagneticField::sBarrelRadiusMax2;
+
 /// Explanation for polarity conventions: these are the mapping between the
 /// current signs and main field components in L3 (Bz) and Dipole (Bx) (in Alice frame)
 /// 1) kConvMap2005: used for the field mapping in 2005
@@ -55,6 +59,8 @@ const UShort_t MagneticField::sPolarityConvention = MagneticField::kConvLHC;
 MagneticField::MagneticField()
   : FairField(),
     mMeasuredMap(nullptr),
+    mFieldCache(),
+    mFieldCacheSpacing(0),
     mMapType(MagFieldParam::k5kG),
     mSolenoid(0),
     mBeamType(MagFieldParam::kNoBeamField),
@@ -81,6 +87,8 @@ MagneticField::MagneticField(const char *name, const char *title, Double_t facto
 			     Double_t be, Int_t integ, Double_t fmax,const std::string path)
   : FairField(name,title),
     mMeasuredMap(nullptr),
+    mFieldCache(),
+    mFieldCacheSpacing(0),
     mMapType(maptype),
     mSolenoid(0),
     mBeamType(bt),
@@ -106,6 +114,8 @@ MagneticField::MagneticField(const char *name, const char *title, Double_t facto
 MagneticField::MagneticField(const MagFieldParam& param)
   : FairField(param.GetName(),param.GetTitle()),
     mMeasuredMap(nullptr),
+    mFieldCache(),
+    mFieldCacheSpacing(0),
     mMapType(param.GetMapType()),
     mSolenoid(0),
     mBeamType(param.GetBeamType()),
@@ -225,9 +235,33 @@ Bool_t MagneticField::loadParameterization()
   return kTRUE;
 }
 
+void MagneticField::Init()
+{
+  FairField::Init();
+  if (mFieldCacheSpacing > 0 && mMeasuredMap && !mFieldCache.isBuilt()) {
+    mFieldCache.buildGrid(*mMeasuredMap, mFieldCacheSpacing);
+  }
+}
+
 void MagneticField::GetFieldValue(const Double_t *xyz, Double_t *b)
 {
   //  b[0]=b[1]=b[2]=0.0;
+  // the cache covers only the solenoid volume, so its points always scale with the solenoid factor
+  if (mFieldCache.isBuilt() && mFieldCache.isInside(xyz)) {
+    mFieldCache.Field(xyz, b);
+    for (int i = 3; i--;) {
+      b[i] *= mMultipicativeFactorSolenoid;
+    }
+    return;
+  }
+  if (mMeasuredMap && isBarrelPoint(xyz)) {
+    // barrel bounding volume: straight to the solenoid parameterization
+    mMeasuredMap->FieldSolenoid(xyz, b);
+    for (int i = 3; i--;) {
+      b[i] *= mMultipicativeFactorSolenoid;
+    }
+    return;
+  }
   if (mMeasuredMap && xyz[2] > mMeasuredMap->getMinZ() && xyz[2] < mMeasuredMap->getMaxZ()) {
     mMeasuredMap->Field(xyz, b);
     if (xyz[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) {
@@ -244,8 +278,46 @@ void MagneticField::GetFieldValue(const Double_t *xyz, Double_t *b)
   }
 }
 
+void MagneticField::GetBxyz(const Double_t *xyz, Double_t *b, MagneticWrapperChebyshev::CachedSegment &memo) const
+{
+  if (mFieldCache.isBuilt() && mFieldCache.isInside(xyz)) {
+    mFieldCache.Field(xyz, b);
+    for (int i = 3; i--;) {
+      b[i] *= mMultipicativeFactorSolenoid;
+    }
+    return;
+  }
+  if (mMeasuredMap && isBarrelPoint(xyz)) {
+    // barrel bounding volume: the memoized lookup takes the solenoid branch
+    // directly and only the solenoid factor can apply
+    mMeasuredMap->Field(xyz, b, memo);
+    for (int i = 3; i--;) {
+      b[i] *= mMultipicativeFactorSolenoid;
+    }
+    return;
+  }
+  if (mMeasuredMap && xyz[2] > mMeasuredMap->getMinZ() && xyz[2] < mMeasuredMap->getMaxZ()) {
+    mMeasuredMap->Field(xyz, b, memo);
+    if (xyz[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) {
+      for (int i = 3; i--;) {
+        b[i] *= mMultipicativeFactorSolenoid;
+      }
+    } else {
+      for (int i = 3; i--;) {
+        b[i] *= mMultipicativeFactorDipole;
+      }
+    }
+  } else {
+    MachineField(xyz, b);
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t *xyz) const
 {
+  if (mMeasuredMap && isBarrelPoint(xyz)) {
+    // barrel bounding volume: straight to the solenoid parameterization
+    return mMeasuredMap->getBzSolenoid(xyz) * mMultipicativeFactorSolenoid;
+  }
   if (mMeasuredMap && xyz[2] > mMeasuredMap->getMinZ() && xyz[2] < mMeasuredMap->getMaxZ()) {
     double bz = mMeasuredMap->getBz(xyz);
     return (xyz[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? bz * mMultipicativeFactorSolenoid
@@ -272,6 +344,8 @@ MagneticField &MagneticField::operator=(const MagneticField &src)
     mMaxField = src.mMaxField;
     mDipoleOnOffFlag = src.mDipoleOnOffFlag;
     mParameterNames = src.mParameterNames;
+    mFieldCacheSpacing = src.mFieldCacheSpacing;
+    mFieldCache.clear(); // the copy rebuilds its own grid at Init
   }
   return *this;
 }
@@ -0,0 +1,111 @@
+/// \file MagneticFieldCache.cxx
+/// \brief Implementation of the MagneticFieldCache class
+
+#include "Field/MagneticFieldCache.h"
+#include "Field/MagneticWrapperChebyshev.h"
+#include "FairLogger.h"  // for FairLogger, MESSAGE_ORIGIN
+#include "TMath.h"       // for Nint
+
+using namespace AliceO2::Field;
+
+MagneticFieldCache::MagneticFieldCache()
+  : mSpacing(0),
+    mInverseSpacing(0),
+    mContent()
+{
+  for (int i = 3; i--;) {
+    mOrigin[i] = 0;
+    mNumberOfNodes[i] = 0;
+  }
+}
+
+void MagneticFieldCache::buildGrid(const MagneticWrapperChebyshev &map, Double_t spacing)
+{
+  if (spacing <= 0) {
+    FairLogger::GetLogger()->Error(MESSAGE_ORIGIN, "Invalid cache grid spacing %f cm, cache not built", spacing);
+    return;
+  }
+  clear();
+
+  // bounding box of the solenoid cylinder in cartesian coordinates
+  const Double_t rMax = map.getMaxRSol();
+  const Double_t zMin = map.getMinZSol();
+  const Double_t zMax = map.getMaxZSol();
+
+  mSpacing = spacing;
+  mInverseSpacing = 1. / spacing;
+  mOrigin[0] = -rMax;
+  mOrigin[1] = -rMax;
+  mOrigin[2] = zMin;
+  mNumberOfNodes[0] = TMath::Nint(2. * rMax / spacing) + 1;
+  mNumberOfNodes[1] = mNumberOfNodes[0];
+  mNumberOfNodes[2] = TMath::Nint((zMax - zMin) / spacing) + 1;
+
+  const size_t nNodes = size_t(mNumberOfNodes[0]) * mNumberOfNodes[1] * mNumberOfNodes[2];
+  mContent.resize(3 * nNodes, 0.f);
+
+  size_t node = 0;
+  for (Int_t iz = 0; iz < mNumberOfNodes[2]; iz++) {
+    for (Int_t iy = 0; iy < mNumberOfNodes[1]; iy++) {
+      for (Int_t ix = 0; ix < mNumberOfNodes[0]; ix++, node++) {
+        Double_t xyz[3] = {mOrigin[0] + ix * mSpacing, mOrigin[1] + iy * mSpacing, mOrigin[2] + iz * mSpacing};
+        Double_t b[3] = {0, 0, 0};
+        map.Field(xyz, b);
+        mContent[3 * node] = b[0];
+        mContent[3 * node + 1] = b[1];
+        mContent[3 * node + 2] = b[2];
+      }
+    }
+  }
+
+  FairLogger::GetLogger()->Info(MESSAGE_ORIGIN, "Built %dx%dx%d field cache grid with %.1f cm spacing (%.1f MB)",
+                                mNumberOfNodes[0], mNumberOfNodes[1], mNumberOfNodes[2], mSpacing,
+                                getCacheSize() / (1024. * 1024.));
+}
+
+void MagneticFieldCache::clear()
+{
+  mContent.clear();
+  mContent.shrink_to_fit();
+  mSpacing = mInverseSpacing = 0;
+  for (int i = 3; i--;) {
+    mOrigin[i] = 0;
+    mNumberOfNodes[i] = 0;
+  }
+}
+
+void MagneticFieldCache::Field(const Double_t *xyz, Double_t *b) const
+{
+  Int_t index[3];
+  Double_t fraction[3];
+  for (int i = 3; i--;) {
+    Double_t cell = (xyz[i] - mOrigin[i]) * mInverseSpacing;
+    index[i] = Int_t(cell);
+    if (index[i] > mNumberOfNodes[i] - 2) { // point on the upper grid face
+      index[i] = mNumberOfNodes[i] - 2;
+    }
+    fraction[i] = cell - index[i];
+  }
+
+  const size_t strideY = mNumberOfNodes[0];
+  const size_t strideZ = strideY * mNumberOfNodes[1];
+  const Float_t *node000 = &mContent[3 * (index[0] + strideY * index[1] + strideZ * index[2])];
+  const Float_t *node001 = node000 + 3 * strideZ;
+  const Float_t *node010 = node000 + 3 * strideY;
+  const Float_t *node011 = node010 + 3 * strideZ;
+  const Float_t *node100 = node000 + 3;
+  const Float_t *node101 = node100 + 3 * strideZ;
+  const Float_t *node110 = node100 + 3 * strideY;
+  const Float_t *node111 = node110 + 3 * strideZ;
+
+  const Double_t wx1 = fraction[0], wx0 = 1. - wx1;
+  const Double_t wy1 = fraction[1], wy0 = 1. - wy1;
+  const Double_t wz1 = fraction[2], wz0 = 1. - wz1;
+  for (int i = 3; i--;) {
+    Double_t c00 = node000[i] * wx0 + node100[i] * wx1;
+    Double_t c10 = node010[i] * wx0 + node110[i] * wx1;
+    Double_t c01 = node001[i] * wx0 + node101[i] * wx1;
+    Double_t c11 = node011[i] * wx0 + node111[i] * wx1;
+    b[i] = (c00 * wy0 + c10 * wy1) * wz0 + (c01 * wy0 + c11 * wy1) * wz1;
+  }
+}
@@ -8,6 +8,7 @@
 #include <TSystem.h>     // for TSystem, gSystem
 #include <stdio.h>       // for printf, fprintf, fclose, fopen, FILE
 #include <string.h>      // for memcpy
+#include <vector>        // for vector
 #include "FairLogger.h"  // for FairLogger, MESSAGE_ORIGIN
 #include "TMath.h"       // for BinarySearch, Sort
 #include "TMathBase.h"   // for Abs
@@ -20,6 +21,13 @@ using namespace AliceO2::MathUtils;
 
 ClassImp(MagneticWrapperChebyshev)
 
+namespace {
+// layout tags of the binary snapshot format, see saveBinary/loadBinary
+const char kBinarySnapshotMagic[8] = {'O', '2', 'F', 'L', 'D', 'C', 'H', 'B'};
+const Int_t kBinarySnapshotVersion = 1;
+const UInt_t kBinarySnapshotEndianTag = 0x01020304;
+}
+
 MagneticWrapperChebyshev::MagneticWrapperChebyshev()
   : mNumberOfParameterizationSolenoid(0),
     mNumberOfDistinctZSegmentsSolenoid(0),
@@ -436,6 +444,152 @@ void MagneticWrapperChebyshev::Field(const Double_t *xyz, Double_t *b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(const Double_t *xyz, Int_t n, Double_t *b) const
+{
+  if (n < 1) {
+    return;
+  }
+  std::vector<Double_t> rpz(3 * n); // cylindrical coordinates of the solenoid points
+  std::vector<Int_t> segment(n);    // solenoid parameterization per point, -1 when not applicable
+
+  for (Int_t i = 0; i < n; i++) {
+    const Double_t *point = xyz + 3 * i;
+    segment[i] = -1;
+    if (point[2] <= mMinZSolenoid) { // dipole region, keep the scalar path
+      Field(point, b + 3 * i);
+      continue;
+    }
+    Double_t *rphiz = &rpz[3 * i];
+    cartesianToCylindrical(point, rphiz);
+    b[3 * i] = b[3 * i + 1] = b[3 * i + 2] = 0;
+    int id = findSolenoidSegment(rphiz);
+    if (id < 0) {
+      continue;
+    }
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+    if (!getParameterSolenoid(id)->isInside(rphiz)) {
+      continue;
+    }
+#endif
+    segment[i] = id;
+  }
+
+  // evaluate runs of consecutive points sharing a parameterization in one batch
+  std::vector<Float_t> rpzF(3 * n);
+  std::vector<Float_t> component(n);
+  Int_t i = 0;
+  while (i < n) {
+    if (segment[i] < 0) {
+      i++;
+      continue;
+    }
+    Int_t runEnd = i + 1;
+    while (runEnd < n && segment[runEnd] == segment[i]) {
+      runEnd++;
+    }
+    Int_t runLength = runEnd - i;
+    Chebyshev3D *par = getParameterSolenoid(segment[i]);
+    if (runLength == 1) {
+      Double_t *field = b + 3 * i;
+      par->Eval(&rpz[3 * i], field);
+      cylindricalToCartesianCylB(&rpz[3 * i], field, field);
+      i = runEnd;
+      continue;
+    }
+    for (Int_t j = 0; j < 3 * runLength; j++) {
+      rpzF[j] = rpz[3 * i + j];
+    }
+    for (int dim = 0; dim < 3; dim++) {
+      par->Eval(&rpzF[0], runLength, dim, &component[0]);
+      for (Int_t k = 0; k < runLength; k++) {
+        b[3 * (i + k) + dim] = component[k];
+      }
+    }
+    for (Int_t k = 0; k < runLength; k++) {
+      Double_t *field = b + 3 * (i + k);
+      cylindricalToCartesianCylB(&rpz[3 * (i + k)], field, field);
+    }
+    i = runEnd;
+  }
+}
+
+void MagneticWrapperChebyshev::Field(const Double_t *xyz, Double_t *b, CachedSegment &memo) const
+{
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+  b[0] = b[1] = b[2] = 0;
+#endif
+
+  if (xyz[2] > mMinZSolenoid) {
+    Double_t rphiz[3];
+    cartesianToCylindrical(xyz, rphiz);
+    Chebyshev3D *par = 0;
+    if (memo.solenoid >= 0 && memo.solenoid < mNumberOfParameterizationSolenoid &&
+        getParameterSolenoid(memo.solenoid)->isInside(rphiz)) { // still in the previous segment
+      par = getParameterSolenoid(memo.solenoid);
+    } else {
+      int id = findSolenoidSegment(rphiz);
+      if (id < 0) {
+        memo.solenoid = -1;
+        return;
+      }
+      par = getParameterSolenoid(id);
+#ifndef _BRING_TO_BOUNDARY_
+      if (!par->isInside(rphiz)) {
+        memo.solenoid = -1;
+        return;
+      }
+#endif
+      memo.solenoid = id;
+    }
+    par->Eval(rphiz, b);
+    cylindricalToCartesianCylB(rphiz, b, b);
+    return;
+  }
+
+  Chebyshev3D *par = 0;
+  if (memo.dipole >= 0 && memo.dipole < mNumberOfParameterizationDipole &&
+      getParameterDipole(memo.dipole)->isInside(xyz)) { // still in the previous segment
+    par = getParameterDipole(memo.dipole);
+  } else {
+    int id = findDipoleSegment(xyz);
+    if (id < 0) {
+      memo.dipole = -1;
+      return;
+    }
+    par = getParameterDipole(id);
+#ifndef _BRING_TO_BOUNDARY_
+    if (!par->isInside(xyz)) {
+      memo.dipole = -1;
+      return;
+    }
+#endif
+    memo.dipole = id;
+  }
+  par->Eval(xyz, b);
+}
+
+void MagneticWrapperChebyshev::FieldSolenoid(const Double_t *xyz, Double_t *b) const
+{
+  Double_t rphiz[3];
+
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+  b[0] = b[1] = b[2] = 0;
+#endif
+
+  cartesianToCylindrical(xyz, rphiz);
+  fieldCylindricalSolenoid(rphiz, b);
+  // convert field to cartesian system
+  cylindricalToCartesianCylB(rphiz, b, b);
+}
+
+Double_t MagneticWrapperChebyshev::getBzSolenoid(const Double_t *xyz) const
+{
+  Double_t rphiz[3];
+
+  cartesianToCylindrical(xyz, rphiz);
+  return fieldCylindricalSolenoidBz(rphiz);
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t *xyz) const
 {
   Double_t rphiz[3];
@@ -929,6 +1083,141 @@ void MagneticWrapperChebyshev::loadData(const char* inpfile)
   printf("Loaded magnetic field \"%s\" from %s\n", GetName(), strf.Data());
 }
 
+void MagneticWrapperChebyshev::saveBinary(const char* outfile) const
+{
+  TString strf = outfile;
+  gSystem->ExpandPathName(strf);
+  FILE* stream = fopen(strf, "wb");
+
+  if (!stream) {
+    printf("Failed to open output file %s\n", strf.Data());
+    return;
+  }
+
+  Chebyshev3DCalc::writeBinaryBlock(kBinarySnapshotMagic, sizeof(char), sizeof(kBinarySnapshotMagic), stream);
+  Chebyshev3DCalc::writeBinaryBlock(&kBinarySnapshotVersion, sizeof(Int_t), 1, stream);
+  Chebyshev3DCalc::writeBinaryBlock(&kBinarySnapshotEndianTag, sizeof(UInt_t), 1, stream);
+
+  UShort_t nameLength = strlen(GetName());
+  Chebyshev3DCalc::writeBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  Chebyshev3DCalc::writeBinaryBlock(GetName(), sizeof(char), nameLength, stream);
+
+  // Solenoid part
+  Int_t nparSol = mNumberOfParameterizationSolenoid;
+  Chebyshev3DCalc::writeBinaryBlock(&nparSol, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparSol; ip++) {
+    getParameterSolenoid(ip)->saveBinary(stream);
+  }
+
+  // TPCInt part
+  Int_t nparTPCInt = mNumberOfParameterizationTPC;
+  Chebyshev3DCalc::writeBinaryBlock(&nparTPCInt, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparTPCInt; ip++) {
+    getParameterTPCIntegral(ip)->saveBinary(stream);
+  }
+
+  // TPCRatInt part
+  Int_t nparTPCRatInt = mNumberOfParameterizationTPCRat;
+  Chebyshev3DCalc::writeBinaryBlock(&nparTPCRatInt, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparTPCRatInt; ip++) {
+    getParameterTPCRatIntegral(ip)->saveBinary(stream);
+  }
+
+  // Dipole part
+  Int_t nparDip = mNumberOfParameterizationDipole;
+  Chebyshev3DCalc::writeBinaryBlock(&nparDip, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparDip; ip++) {
+    getParameterDipole(ip)->saveBinary(stream);
+  }
+
+  fclose(stream);
+  printf("Saved magnetic field \"%s\" into binary snapshot %s\n", GetName(), strf.Data());
+}
+
+void MagneticWrapperChebyshev::loadBinary(const char* inpfile)
+{
+  TString strf = inpfile;
+  gSystem->ExpandPathName(strf);
+  FILE* stream = fopen(strf, "rb");
+
+  if (!stream) {
+    printf("Did not find input file %s\n", strf.Data());
+    return;
+  }
+
+  char magic[sizeof(kBinarySnapshotMagic)];
+  Chebyshev3DCalc::readBinaryBlock(magic, sizeof(char), sizeof(magic), stream);
+  if (memcmp(magic, kBinarySnapshotMagic, sizeof(magic))) {
+    Error("LoadBinary", "%s is not a field binary snapshot\nStop\n", strf.Data());
+    exit(1);
+  }
+
+  Int_t version = 0;
+  Chebyshev3DCalc::readBinaryBlock(&version, sizeof(Int_t), 1, stream);
+  if (version != kBinarySnapshotVersion) {
+    Error("LoadBinary", "Unsupported snapshot version %d in %s, expected %d\nStop\n", version, strf.Data(),
+          kBinarySnapshotVersion);
+    exit(1);
+  }
+
+  UInt_t endianTag = 0;
+  Chebyshev3DCalc::readBinaryBlock(&endianTag, sizeof(UInt_t), 1, stream);
+  if (endianTag != kBinarySnapshotEndianTag) {
+    Error("LoadBinary", "Endianness mismatch in %s, regenerate the snapshot on this architecture\nStop\n", strf.Data());
+    exit(1);
+  }
+
+  UShort_t nameLength = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  std::vector<char> name(nameLength + 1, 0);
+  Chebyshev3DCalc::readBinaryBlock(&name[0], sizeof(char), nameLength, stream);
+  SetName(&name[0]);
+
+  // Solenoid part
+  Int_t nparSol = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nparSol, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparSol; ip++) {
+    Chebyshev3D* cheb = new Chebyshev3D();
+    cheb->loadBinary(stream);
+    addParameterSolenoid(cheb);
+  }
+
+  // TPCInt part
+  Int_t nparTPCInt = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nparTPCInt, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparTPCInt; ip++) {
+    Chebyshev3D* cheb = new Chebyshev3D();
+    cheb->loadBinary(stream);
+    addParameterTPCIntegral(cheb);
+  }
+
+  // TPCRatInt part
+  Int_t nparTPCRatInt = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nparTPCRatInt, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparTPCRatInt; ip++) {
+    Chebyshev3D* cheb = new Chebyshev3D();
+    cheb->loadBinary(stream);
+    addParameterTPCRatIntegral(cheb);
+  }
+
+  // Dipole part
+  Int_t nparDip = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nparDip, sizeof(Int_t), 1, stream);
+  for (int ip = 0; ip < nparDip; ip++) {
+    Chebyshev3D* cheb = new Chebyshev3D();
+    cheb->loadBinary(stream);
+    addParameterDipole(cheb);
+  }
+
+  fclose(stream);
+  buildTableSolenoid();
+  buildTableDipole();
+  buildTableTPCIntegral();
+  buildTableTPCRatIntegral();
+
+  printf("Loaded magnetic field \"%s\" from binary snapshot %s\n", GetName(), strf.Data());
+}
+
 void MagneticWrapperChebyshev::buildTableSolenoid()
 {
   buildTable(mNumberOfParameterizationSolenoid, mParameterizationSolenoid, mNumberOfDistinctZSegmentsSolenoid,
@@ -0,0 +1,121 @@
+/// \file Probe.cxx
+/// \brief Registry and snapshot aggregation of instrumentation probe sites
+
+#include "Instrumentation/Probe.h"
+
+#include <cstring>
+#include <mutex>
+
+using namespace AliceO2::Instrumentation;
+
+// definitions for odr-use of the class constants
+constexpr int ProbeSite::kMaxThreads;
+constexpr size_t ProbeSite::kRingSize;
+
+namespace {
+
+// global site registry; only touched on site construction/destruction and
+// snapshot collection, never on the recording hot path
+std::mutex& RegistryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<ProbeSite*>& Registry()
+{
+  static std::vector<ProbeSite*> sites;
+  return sites;
+}
+
+}
+
+//__________________________________________________________________________________________________
+ProbeSite::ProbeSite(const char* name)
+  : mName(name)
+{
+  for (auto& buffer : mBuffers) {
+    buffer.store(nullptr, std::memory_order_relaxed);
+  }
+  std::lock_guard<std::mutex> lock{RegistryMutex()};
+  Registry().push_back(this);
+}
+
+//__________________________________________________________________________________________________
+ProbeSite::~ProbeSite()
+{
+  {
+    std::lock_guard<std::mutex> lock{RegistryMutex()};
+    auto& sites = Registry();
+    for (auto site = sites.begin(); site != sites.end(); ++site) {
+      if (*site == this) {
+        sites.erase(site);
+        break;
+      }
+    }
+  }
+  for (auto& buffer : mBuffers) {
+    delete buffer.load(std::memory_order_acquire);
+  }
+}
+
+//__________________________________________________________________________________________________
+ProbeSite::Snapshot ProbeSite::GetSnapshot() const
+{
+  Snapshot snapshot{mName, 0, 0, UINT64_MAX, 0};
+  for (const auto& slot : mBuffers) {
+    const ThreadBuffer* buffer = slot.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+      continue;
+    }
+    snapshot.count += buffer->count;
+    snapshot.totalCycles += buffer->total;
+    if (buffer->min < snapshot.minCycles) snapshot.minCycles = buffer->min;
+    if (buffer->max > snapshot.maxCycles) snapshot.maxCycles = buffer->max;
+  }
+  if (snapshot.count == 0) {
+    snapshot.minCycles = 0;
+  }
+  return snapshot;
+}
+
+//__________________________________________________________________________________________________
+size_t ProbeSite::CollectSamples(std::vector<uint64_t>& samples) const
+{
+  size_t appended = 0;
+  for (const auto& slot : mBuffers) {
+    const ThreadBuffer* buffer = slot.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+      continue;
+    }
+    size_t valid = (buffer->head < kRingSize) ? buffer->head : kRingSize;
+    samples.insert(samples.end(), buffer->samples, buffer->samples + valid);
+    appended += valid;
+  }
+  return appended;
+}
+
+//__________________________________________________________________________________________________
+std::vector<ProbeSite::Snapshot> ProbeSite::SnapshotAll()
+{
+  std::lock_guard<std::mutex> lock{RegistryMutex()};
+  std::vector<Snapshot> snapshots;
+  snapshots.reserve(Registry().size());
+  for (const ProbeSite* site : Registry()) {
+    snapshots.push_back(site->GetSnapshot());
+  }
+  return snapshots;
+}
+
+//__________________________________________________________________________________________________
+size_t ProbeSite::CollectSamplesFor(const char* name, std::vector<uint64_t>& samples)
+{
+  std::lock_guard<std::mutex> lock{RegistryMutex()};
+  size_t appended = 0;
+  for (const ProbeSite* site : Registry()) {
+    if (std::strcmp(site->GetName(), name) == 0) {
+      appended += site->CollectSamples(samples);
+    }
+  }
+  return appended;
+}
@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE Test Common Instrumentation
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Instrumentation/Probe.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AliceO2 {
+namespace Instrumentation {
+
+BOOST_AUTO_TEST_CASE(scopedProbe_test)
+{
+  ProbeSite site{"test site"};
+
+  const int nIntervals = 1000;
+  for (int i = 0; i < nIntervals; ++i) {
+    ScopedProbe<true> probe{site};
+  }
+
+  ProbeSite::Snapshot snapshot = site.GetSnapshot();
+  BOOST_CHECK_EQUAL(snapshot.count, nIntervals);
+  BOOST_CHECK(snapshot.minCycles <= snapshot.maxCycles);
+  BOOST_CHECK(snapshot.totalCycles >= nIntervals * snapshot.minCycles);
+  BOOST_CHECK_EQUAL(std::string(snapshot.name), "test site");
+
+  // the ring retains at most kRingSize samples per thread
+  std::vector<uint64_t> samples;
+  BOOST_CHECK_EQUAL(site.CollectSamples(samples), ProbeSite::kRingSize);
+}
+
+BOOST_AUTO_TEST_CASE(multiThreadedRecording_test)
+{
+  ProbeSite site{"threaded site"};
+
+  const int nThreads = 4;
+  const int nIntervalsPerThread = 100;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&site]() {
+      for (int i = 0; i < nIntervalsPerThread; ++i) {
+        ScopedProbe<true> probe{site};
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(site.GetSnapshot().count, nThreads * nIntervalsPerThread);
+}
+
+BOOST_AUTO_TEST_CASE(disabledProbe_test)
+{
+  ProbeSite site{"disabled site"};
+  {
+    ScopedProbe<false> probe{site};
+  }
+  // a disabled probe records nothing and carries no state
+  BOOST_CHECK_EQUAL(site.GetSnapshot().count, 0);
+  BOOST_CHECK(sizeof(ScopedProbe<false>) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(collectSamplesFor_test)
+{
+  ProbeSite site{"named site"};
+  ProbeSite other{"other site"};
+  {
+    ScopedProbe<true> probe{site};
+  }
+  {
+    ScopedProbe<true> probe{other};
+  }
+
+  std::vector<uint64_t> samples;
+  BOOST_CHECK_EQUAL(ProbeSite::CollectSamplesFor("named site", samples), 1);
+  BOOST_CHECK_EQUAL(samples.size(), 1);
+  BOOST_CHECK_EQUAL(ProbeSite::CollectSamplesFor("no such site", samples), 0);
+}
+
+BOOST_AUTO_TEST_CASE(snapshotAll_test)
+{
+  ProbeSite first{"first"};
+  ProbeSite second{"second"};
+  {
+    ScopedProbe<true> probe{second};
+  }
+
+  bool seenFirst = false;
+  bool seenSecond = false;
+  for (const auto& snapshot : ProbeSite::SnapshotAll()) {
+    if (std::string(snapshot.name) == "first") {
+      seenFirst = true;
+      BOOST_CHECK_EQUAL(snapshot.count, 0);
+    }
+    if (std::string(snapshot.name) == "second") {
+      seenSecond = true;
+      BOOST_CHECK_EQUAL(snapshot.count, 1);
+    }
+  }
+  BOOST_CHECK(seenFirst);
+  BOOST_CHECK(seenSecond);
+}
+
+} // namespace Instrumentation
+} // namespace AliceO2
@@ -126,6 +126,12 @@ class Chebyshev3D : public TNamed
 
     Double_t Eval(const Double_t *par, int idim);
 
+    /// Evaluates the idim-th output dimension for a batch of n points.
+    /// par holds n (x,y,z) triplets in external coordinates, out receives
+    /// n values; the points are mapped and handed to the vectorized
+    /// Chebyshev3DCalc batch evaluation
+    void Eval(const Float_t *par, Int_t n, int idim, Float_t *out);
+
     void evaluateDerivative(int dimd, const Float_t *par, Float_t *res);
 
     void evaluateDerivative2(int dimd1, int dimd2, const Float_t *par, Float_t *res);
@@ -140,6 +146,14 @@ class Chebyshev3D : public TNamed
 
     void Print(const Option_t *opt = "") const;
 
+    /// Prunes the coefficients of every output dimension, see
+    /// Chebyshev3DCalc::pruneCoefficients: coefficients with magnitude below
+    /// the threshold are dropped, the evaluation loops shrink and small
+    /// parameterizations switch to the fused fixed-bounds evaluation.
+    /// Returns the largest per-dimension error bound (sum of the dropped
+    /// magnitudes), which is also added to the stored precision
+    Double_t pruneCoefficients(Float_t threshold, Bool_t verbose = kFALSE);
+
     Bool_t isInside(const Float_t *par) const;
 
     Bool_t isInside(const Double_t *par) const;
@@ -180,6 +194,9 @@ class Chebyshev3D : public TNamed
 
     void loadData(FILE *stream);
 
+    /// Loads the parameterization from the raw binary stream written by saveBinary
+    void loadBinary(FILE *stream);
+
 #ifdef _INC_CREATION_Chebyshev3D_
     void invertSign();
     int* getNcNeeded(float xyz[3], int dimVar, float mn, float mx, float prec, Int_t npCheck = 30);
@@ -187,6 +204,9 @@ class Chebyshev3D : public TNamed
     void saveData(const char* outfile, Bool_t append = kFALSE) const;
     void saveData(FILE* stream = stdout) const;
 
+    /// Writes the parameterization in the raw binary format, see loadBinary
+    void saveBinary(FILE* stream) const;
+
     void setuserFunction(const char* name);
     void setuserFunction(void (*ptr)(float*, float*));
     void evaluateUserFunction(const Float_t* x, Float_t* res);
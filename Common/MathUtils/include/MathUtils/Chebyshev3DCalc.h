@@ -50,6 +50,9 @@ class Chebyshev3DCalc : public TNamed
     /// Loads coefficients from the stream
     void loadData(FILE *stream);
 
+    /// Loads coefficients from the raw binary stream written by saveBinary
+    void loadBinary(FILE *stream);
+
     /// Evaluates Chebyshev parameterization derivative in given dimension for 3D function.
     /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
     Float_t evaluateDerivative(int dim, const Float_t *par) const;
@@ -68,6 +71,10 @@ class Chebyshev3DCalc : public TNamed
     // during the loading of this file
     void saveData(FILE *stream = stdout) const;
 
+    // Writes coefficients data in the raw binary format, the same derived quantities
+    // as for saveData are recomputed during the loading
+    void saveBinary(FILE *stream) const;
+
 #endif
 
     /// Sets maximum number of significant rows in the coefficients matrix
@@ -154,11 +161,50 @@ class Chebyshev3DCalc : public TNamed
     /// Reads single line from the stream, skipping empty and commented lines. EOF is not expected
     static void readLine(TString &str, FILE *stream);
 
+    /// Writes a raw binary block to the stream, aborting on failure
+    static void writeBinaryBlock(const void *data, size_t size, size_t n, FILE *stream);
+
+    /// Reads a raw binary block from the stream, aborting on failure. EOF is not expected
+    static void readBinaryBlock(void *data, size_t size, size_t n, FILE *stream);
+
     Float_t Eval(const Float_t *par) const;
 
     Double_t Eval(const Double_t *par) const;
 
+    /// Evaluates the parameterization for a batch of n points. par holds n
+    /// (x,y,z) triplets ALREADY MAPPED to the [-1:1] interval, out receives
+    /// n values. The Clenshaw recurrences run lane-parallel over blocks of
+    /// points so the compiler can vectorize them
+    void Eval(const Float_t *par, Int_t n, Float_t *out) const;
+
+    /// Drops trailing coefficients with magnitude below the threshold and
+    /// tightens the significance bounds accordingly, shrinking the evaluation
+    /// loops. Returns the sum of the dropped magnitudes, which bounds the
+    /// error added to any evaluation (every Chebyshev basis term is bounded
+    /// by 1 in modulus); the bound is also added to the stored precision.
+    /// Afterwards the fused evaluation block is (re)built, see
+    /// buildFusedEvaluation
+    Double_t pruneCoefficients(Float_t threshold);
+
+    Bool_t usesFusedEvaluation() const
+    {
+      return mFusedCoefficients != 0;
+    }
+
   protected:
+    /// Repacks the surviving coefficients into a dense rows x columns x order
+    /// block with the loop bounds fixed at setup: Eval then runs plain nested
+    /// loops over contiguous memory instead of chasing the four significance
+    /// bound arrays. Built only when the dense block stays small (low-order
+    /// parameterizations, e.g. the field map's outer regions after pruning);
+    /// the padding zeros do not change the result. The block is transient,
+    /// a parameterization restored from a ROOT stream falls back to the
+    /// general path until it is pruned again
+    void buildFusedEvaluation();
+
+    Float_t evalFused(const Float_t *par) const;
+    Double_t evalFused(const Double_t *par) const;
+
     Int_t mNumberOfCoefficients;    ///< total number of coeeficients
     Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
     Int_t mNumberOfColumns;         ///< max number of significant cols in the 3D coeffs matrix
@@ -179,8 +225,15 @@ class Chebyshev3DCalc : public TNamed
     Float_t *mTemporaryCoefficients2D; //[mNumberOfColumns] temp. coeffs for 2d summation
     Float_t *mTemporaryCoefficients1D; //[mNumberOfRows] temp. coeffs for 1d summation
 
+    static const Int_t kMaxFusedBlockSize = 1024; ///< dense block size limit, in coefficients
+
+    Int_t mFusedRows;            //!< fixed row bound of the fused block
+    Int_t mFusedColumns;         //!< fixed column bound of the fused block
+    Int_t mFusedOrder;           //!< fixed coefficient count per column of the fused block
+    Float_t *mFusedCoefficients; //! dense fused block, built by pruneCoefficients, not streamed
+
     ClassDef(AliceO2::MathUtils::Chebyshev3DCalc,
-    2) // Class for interpolation of 3D->1 function by Chebyshev parametrization
+    3) // Class for interpolation of 3D->1 function by Chebyshev parametrization
 };
 
 /// Evaluates 1D Chebyshev parameterization. x is the argument mapped to [-1:1] interval
@@ -206,6 +259,9 @@ inline Float_t Chebyshev3DCalc::chebyshevEvaluation1D(Float_t x, const Float_t *
 /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
 inline Float_t Chebyshev3DCalc::Eval(const Float_t *par) const
 {
+  if (mFusedCoefficients) {
+    return evalFused(par);
+  }
   if (!mNumberOfRows) {
     return 0.;
   }
@@ -228,6 +284,9 @@ inline Float_t Chebyshev3DCalc::Eval(const Float_t *par) const
 /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
 inline Double_t Chebyshev3DCalc::Eval(const Double_t *par) const
 {
+  if (mFusedCoefficients) {
+    return evalFused(par);
+  }
   if (!mNumberOfRows) {
     return 0.;
   }
@@ -245,6 +304,34 @@ inline Double_t Chebyshev3DCalc::Eval(const Double_t *par) const
   }
   return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
 }
+
+/// Fused evaluation over the dense coefficient block: all loop bounds are
+/// fixed members set at setup and the coefficients are read sequentially
+inline Float_t Chebyshev3DCalc::evalFused(const Float_t *par) const
+{
+  for (int id0 = mFusedRows; id0--;) {
+    const Float_t *row = mFusedCoefficients + id0 * mFusedColumns * mFusedOrder;
+    for (int id1 = mFusedColumns; id1--;) {
+      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], row + id1 * mFusedOrder, mFusedOrder);
+    }
+    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, mFusedColumns);
+  }
+  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mFusedRows);
+}
+
+/// Fused evaluation over the dense coefficient block: all loop bounds are
+/// fixed members set at setup and the coefficients are read sequentially
+inline Double_t Chebyshev3DCalc::evalFused(const Double_t *par) const
+{
+  for (int id0 = mFusedRows; id0--;) {
+    const Float_t *row = mFusedCoefficients + id0 * mFusedColumns * mFusedOrder;
+    for (int id1 = mFusedColumns; id1--;) {
+      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], row + id1 * mFusedOrder, mFusedOrder);
+    }
+    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, mFusedColumns);
+  }
+  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mFusedRows);
+}
 }
 }
 
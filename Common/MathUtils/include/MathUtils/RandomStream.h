@@ -0,0 +1,121 @@
+/// \file RandomStream.h
+/// \brief Counter-based random number streams for deterministic parallel code
+
+#ifndef ALICEO2_MATHUTILS_RANDOMSTREAM_H_
+#define ALICEO2_MATHUTILS_RANDOMSTREAM_H_
+
+#include "Rtypes.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace AliceO2 {
+namespace MathUtils {
+
+/// Deterministic random stream keyed by (event, subsystem, element).
+///
+/// The shared gRandom makes parallel digitization both contended (one
+/// global generator behind every call) and non-reproducible (the draw
+/// order depends on the thread interleaving). A RandomStream is counter
+/// based: the n-th number of a stream is a pure function of the key and
+/// n, so two runs draw identical numbers for the same (event, subsystem,
+/// element) regardless of the number of threads or the order in which
+/// the elements are processed. Streams carry no shared state, a worker
+/// constructs them on the stack for the element it processes.
+///
+/// The generator is the splitmix64 counter construction: 64-bit mixing
+/// of key + n * golden gamma. One mix is a handful of arithmetic
+/// instructions, so bulk filling a buffer costs a few cycles per number.
+class RandomStream
+{
+  public:
+    /// \param event     event number of the stream
+    /// \param subsystem caller-chosen tag separating the streams of one event
+    /// \param element   id of the digitized element (chip, pad, electron, ...)
+    RandomStream(ULong64_t event, UInt_t subsystem, ULong64_t element)
+      : mKey(deriveKey(event, subsystem, element)), mCounter(0), mSpare(0), mHasSpare(kFALSE)
+    {
+    }
+
+    /// next uniform deviate in [0, 1)
+    Double_t uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    /// next standard normal deviate
+    Double_t gaus()
+    {
+      if (mHasSpare) {
+        mHasSpare = kFALSE;
+        return mSpare;
+      }
+      Double_t radius, phi;
+      boxMuller(radius, phi);
+      mSpare = radius * std::sin(phi);
+      mHasSpare = kTRUE;
+      return radius * std::cos(phi);
+    }
+
+    /// fill a caller buffer with uniform deviates in [0, 1)
+    void fillUniform(Float_t* buffer, size_t n)
+    {
+      for (size_t i = 0; i < n; ++i) {
+        buffer[i] = static_cast<Float_t>(uniform());
+      }
+    }
+
+    /// fill a caller buffer with normal deviates
+    void fillGaus(Float_t* buffer, size_t n, Float_t mean = 0.f, Float_t sigma = 1.f)
+    {
+      for (size_t i = 0; i < n; i += 2) {
+        Double_t radius, phi;
+        boxMuller(radius, phi);
+        buffer[i] = mean + sigma * static_cast<Float_t>(radius * std::cos(phi));
+        if (i + 1 < n) {
+          buffer[i + 1] = mean + sigma * static_cast<Float_t>(radius * std::sin(phi));
+        }
+      }
+    }
+
+    /// deterministic seed for code still driving a TRandom; never 0, which
+    /// TRandom3 treats as "seed from the clock"
+    static UInt_t deriveSeed(ULong64_t event, UInt_t subsystem, ULong64_t element)
+    {
+      const UInt_t seed = static_cast<UInt_t>(mix(deriveKey(event, subsystem, element)));
+      return seed != 0 ? seed : 0x9E3779B9;
+    }
+
+  private:
+    /// 64-bit finalization mix of splitmix64
+    static ULong64_t mix(ULong64_t z)
+    {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+    static ULong64_t deriveKey(ULong64_t event, UInt_t subsystem, ULong64_t element)
+    {
+      ULong64_t key = mix(event + 0x9E3779B97F4A7C15ULL * (subsystem + 1));
+      return mix(key ^ element);
+    }
+
+    /// the n-th raw 64-bit value of the stream
+    ULong64_t next() { return mix(mKey + 0x9E3779B97F4A7C15ULL * ++mCounter); }
+
+    /// one Box-Muller transform: radius and angle of a pair of normals
+    void boxMuller(Double_t& radius, Double_t& phi)
+    {
+      // 1 - uniform() is in (0, 1], safe under the log
+      radius = std::sqrt(-2.0 * std::log(1.0 - uniform()));
+      phi = 2.0 * M_PI * uniform();
+    }
+
+    ULong64_t mKey;     ///< stream key, derived from (event, subsystem, element)
+    ULong64_t mCounter; ///< numbers drawn so far
+    Double_t mSpare;    ///< second normal of the last Box-Muller pair
+    Bool_t mHasSpare;   ///< spare normal valid
+};
+
+}
+}
+
+#endif
@@ -11,6 +11,8 @@
 #include <TString.h>          // for TString
 #include <TSystem.h>          // for TSystem, gSystem
 #include <stdio.h>            // for printf, fprintf, FILE, fclose, fflush, etc
+#include <string.h>           // for strlen
+#include <vector>             // for vector
 #include "MathUtils/Chebyshev3DCalc.h"  // for Chebyshev3DCalc, etc
 #include "FairLogger.h"       // for FairLogger, MESSAGE_ORIGIN
 #include "TMathBase.h"        // for Max, Abs
@@ -305,6 +307,38 @@ void Chebyshev3D::Clear(const Option_t *)
   mChebyshevParameter.Delete();
 }
 
+void Chebyshev3D::Eval(const Float_t *par, Int_t n, int idim, Float_t *out)
+{
+  // batched evaluation: map the n points to the internal [-1:1] intervals
+  // and hand them to the vectorized calculator
+  std::vector<Float_t> mapped(3 * n);
+  for (Int_t i = 0; i < n; i++) {
+    for (int d = 3; d--;) {
+      mapped[3 * i + d] = mapToInternal(par[3 * i + d], d);
+    }
+  }
+  getChebyshevCalc(idim)->Eval(mapped.data(), n, out);
+}
+
+Double_t Chebyshev3D::pruneCoefficients(Float_t threshold, Bool_t verbose)
+{
+  Double_t worstBound = 0;
+  for (int i = 0; i < mOutputArrayDimension; i++) {
+    Chebyshev3DCalc *calc = getChebyshevCalc(i);
+    Double_t bound = calc->pruneCoefficients(threshold);
+    if (verbose) {
+      printf("%s: dim %d: pruned below %.2e, max added error %.3e, %s evaluation path\n",
+             GetName(), i + 1, threshold, bound,
+             calc->usesFusedEvaluation() ? "fused fixed-bounds" : "general");
+    }
+    if (bound > worstBound) {
+      worstBound = bound;
+    }
+  }
+  mPrecision += worstBound;
+  return worstBound;
+}
+
 void Chebyshev3D::Print(const Option_t *opt) const
 {
   // print info
@@ -760,6 +794,57 @@ void Chebyshev3D::invertSign()
 }
 #endif
 
+#ifdef _INC_CREATION_Chebyshev3D_
+void Chebyshev3D::saveBinary(FILE* stream) const
+{
+  // writes the parameterization in the raw binary format
+  UShort_t nameLength = strlen(GetName());
+  Chebyshev3DCalc::writeBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  Chebyshev3DCalc::writeBinaryBlock(GetName(), sizeof(char), nameLength, stream);
+  Int_t dimOut = mOutputArrayDimension;
+  Chebyshev3DCalc::writeBinaryBlock(&dimOut, sizeof(Int_t), 1, stream);
+  Chebyshev3DCalc::writeBinaryBlock(&mPrecision, sizeof(Float_t), 1, stream);
+  Chebyshev3DCalc::writeBinaryBlock(mMinBoundaries, sizeof(Float_t), 3, stream);
+  Chebyshev3DCalc::writeBinaryBlock(mMaxBoundaries, sizeof(Float_t), 3, stream);
+  for (int i = 0; i < mOutputArrayDimension; i++) {
+    getChebyshevCalc(i)->saveBinary(stream);
+  }
+}
+#endif
+
+void Chebyshev3D::loadBinary(FILE *stream)
+{
+  // load the parameterization from the raw binary stream written by saveBinary
+  if (!stream) {
+    mLogger->Fatal(MESSAGE_ORIGIN, "No stream provided.\nStop");
+  }
+  Clear();
+
+  UShort_t nameLength = 0;
+  Chebyshev3DCalc::readBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  std::vector<char> name(nameLength + 1, 0);
+  Chebyshev3DCalc::readBinaryBlock(&name[0], sizeof(char), nameLength, stream);
+  SetName(&name[0]);
+
+  Int_t dimOut = 0;
+  Chebyshev3DCalc::readBinaryBlock(&dimOut, sizeof(Int_t), 1, stream);
+  if (dimOut < 1) {
+    mLogger->Fatal(MESSAGE_ORIGIN, "Invalid number of output dimensions %d in \"%s\"\nStop\n", dimOut, GetName());
+  }
+  mOutputArrayDimension = dimOut;
+  setDimOut(mOutputArrayDimension);
+
+  Chebyshev3DCalc::readBinaryBlock(&mPrecision, sizeof(Float_t), 1, stream);
+  Chebyshev3DCalc::readBinaryBlock(mMinBoundaries, sizeof(Float_t), 3, stream);
+  Chebyshev3DCalc::readBinaryBlock(mMaxBoundaries, sizeof(Float_t), 3, stream);
+  prepareBoundaries(mMinBoundaries, mMaxBoundaries);
+
+  // data for each output dimension
+  for (int i = 0; i < mOutputArrayDimension; i++) {
+    getChebyshevCalc(i)->loadBinary(stream);
+  }
+}
+
 void Chebyshev3D::loadData(const char *inpFile)
 {
   // load coefficients data from txt file
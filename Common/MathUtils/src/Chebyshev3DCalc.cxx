@@ -3,14 +3,123 @@
 /// \author ruben.shahoyan@cern.ch 09/09/2006
 
 #include "MathUtils/Chebyshev3DCalc.h"
+#include <TMath.h>    // for TMath::Abs
 #include <TSystem.h>  // for TSystem, gSystem
+#include <string.h>   // for strlen
 #include "TNamed.h"   // for TNamed
 #include "TString.h"  // for TString, TString::EStripType::kBoth
 
+#include <vector>
+
 using namespace AliceO2::MathUtils;
 
 ClassImp(Chebyshev3DCalc)
 
+namespace {
+
+// number of points evaluated per pass of the batched Eval; the lane loops
+// below are written over this fixed width so the compiler can vectorize them
+const int kVecWidth = 8;
+
+// Clenshaw recurrence for kVecWidth points sharing one coefficient array
+inline void clenshawShared(const Float_t *x, const Float_t *array, int ncf, Float_t *out)
+{
+  Float_t b0[kVecWidth], b1[kVecWidth], b2[kVecWidth], x2[kVecWidth];
+  for (int l = 0; l < kVecWidth; l++) {
+    b0[l] = array[ncf - 1];
+    b1[l] = b2[l] = 0;
+    x2[l] = x[l] + x[l];
+  }
+  for (int i = ncf - 1; i--;) {
+    Float_t c = array[i];
+    for (int l = 0; l < kVecWidth; l++) {
+      b2[l] = b1[l];
+      b1[l] = b0[l];
+      b0[l] = c + x2[l] * b1[l] - b2[l];
+    }
+  }
+  for (int l = 0; l < kVecWidth; l++) {
+    out[l] = b0[l] - x[l] * b1[l];
+  }
+}
+
+// Clenshaw recurrence with one coefficient per lane at each order
+// (lane-major layout: array[i * kVecWidth + l])
+inline void clenshawLanes(const Float_t *x, const Float_t *array, int ncf, Float_t *out)
+{
+  Float_t b0[kVecWidth], b1[kVecWidth], b2[kVecWidth], x2[kVecWidth];
+  for (int l = 0; l < kVecWidth; l++) {
+    b0[l] = array[(ncf - 1) * kVecWidth + l];
+    b1[l] = b2[l] = 0;
+    x2[l] = x[l] + x[l];
+  }
+  for (int i = ncf - 1; i--;) {
+    const Float_t *c = array + i * kVecWidth;
+    for (int l = 0; l < kVecWidth; l++) {
+      b2[l] = b1[l];
+      b1[l] = b0[l];
+      b0[l] = c[l] + x2[l] * b1[l] - b2[l];
+    }
+  }
+  for (int l = 0; l < kVecWidth; l++) {
+    out[l] = b0[l] - x[l] * b1[l];
+  }
+}
+}
+
+void Chebyshev3DCalc::Eval(const Float_t *par, Int_t n, Float_t *out) const
+{
+  if (!mNumberOfRows) {
+    for (Int_t i = 0; i < n; i++) {
+      out[i] = 0.;
+    }
+    return;
+  }
+  // lane-major scratch: one slot per (coefficient, lane) pair
+  std::vector<Float_t> tmp2D(mNumberOfColumns * kVecWidth);
+  std::vector<Float_t> tmp1D(mNumberOfRows * kVecWidth);
+  Float_t px[kVecWidth], py[kVecWidth], pz[kVecWidth], res[kVecWidth];
+
+  for (Int_t first = 0; first < n; first += kVecWidth) {
+    Int_t nLanes = (n - first < kVecWidth) ? n - first : kVecWidth;
+    // pad incomplete blocks by replicating the last point
+    for (int l = 0; l < kVecWidth; l++) {
+      const Float_t *point = par + 3 * (first + (l < nLanes ? l : nLanes - 1));
+      px[l] = point[0];
+      py[l] = point[1];
+      pz[l] = point[2];
+    }
+    for (int id0 = mNumberOfRows; id0--;) {
+      int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
+      int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+      for (int id1 = nCLoc; id1--;) {
+        int id = id1 + col0;
+        int ncfRC = mCoefficientBound2D0[id];
+        Float_t *dst = &tmp2D[id1 * kVecWidth];
+        if (ncfRC) {
+          clenshawShared(pz, mCoefficients + mCoefficientBound2D1[id], ncfRC, dst);
+        } else {
+          for (int l = 0; l < kVecWidth; l++) {
+            dst[l] = 0.;
+          }
+        }
+      }
+      Float_t *dst = &tmp1D[id0 * kVecWidth];
+      if (nCLoc > 0) {
+        clenshawLanes(py, tmp2D.data(), nCLoc, dst);
+      } else {
+        for (int l = 0; l < kVecWidth; l++) {
+          dst[l] = 0.;
+        }
+      }
+    }
+    clenshawLanes(px, tmp1D.data(), mNumberOfRows, res);
+    for (int l = 0; l < nLanes; l++) {
+      out[first + l] = res[l];
+    }
+  }
+}
+
 Chebyshev3DCalc::Chebyshev3DCalc()
   : mNumberOfCoefficients(0),
     mNumberOfRows(0),
@@ -23,7 +132,11 @@ Chebyshev3DCalc::Chebyshev3DCalc()
     mCoefficientBound2D1(0),
     mCoefficients(0),
     mTemporaryCoefficients2D(0),
-    mTemporaryCoefficients1D(0)
+    mTemporaryCoefficients1D(0),
+    mFusedRows(0),
+    mFusedColumns(0),
+    mFusedOrder(0),
+    mFusedCoefficients(0)
 {
 }
 
@@ -40,7 +153,11 @@ Chebyshev3DCalc::Chebyshev3DCalc(const Chebyshev3DCalc &src)
     mCoefficientBound2D1(0),
     mCoefficients(0),
     mTemporaryCoefficients2D(0),
-    mTemporaryCoefficients1D(0)
+    mTemporaryCoefficients1D(0),
+    mFusedRows(0),
+    mFusedColumns(0),
+    mFusedOrder(0),
+    mFusedCoefficients(0)
 {
   if (src.mNumberOfColumnsAtRow) {
     mNumberOfColumnsAtRow = new UShort_t[mNumberOfRows];
@@ -78,6 +195,9 @@ Chebyshev3DCalc::Chebyshev3DCalc(const Chebyshev3DCalc &src)
   if (src.mTemporaryCoefficients1D) {
     mTemporaryCoefficients1D = new Float_t[mNumberOfRows];
   }
+  if (src.mFusedCoefficients) {
+    buildFusedEvaluation();
+  }
 }
 
 Chebyshev3DCalc::Chebyshev3DCalc(FILE *stream)
@@ -92,7 +212,11 @@ Chebyshev3DCalc::Chebyshev3DCalc(FILE *stream)
     mCoefficientBound2D1(0),
     mCoefficients(0),
     mTemporaryCoefficients2D(0),
-    mTemporaryCoefficients1D(0)
+    mTemporaryCoefficients1D(0),
+    mFusedRows(0),
+    mFusedColumns(0),
+    mFusedOrder(0),
+    mFusedCoefficients(0)
 {
   loadData(stream);
 }
@@ -143,6 +267,9 @@ Chebyshev3DCalc &Chebyshev3DCalc::operator=(const Chebyshev3DCalc &rhs)
     if (rhs.mTemporaryCoefficients1D) {
       mTemporaryCoefficients1D = new Float_t[mNumberOfRows];
     }
+    if (rhs.mFusedCoefficients) {
+      buildFusedEvaluation();
+    }
   }
   return *this;
 }
@@ -177,6 +304,98 @@ void Chebyshev3DCalc::Clear(const Option_t *)
     delete[] mColumnAtRowBeginning;
     mColumnAtRowBeginning = 0;
   }
+  if (mFusedCoefficients) {
+    delete[] mFusedCoefficients;
+    mFusedCoefficients = 0;
+  }
+  mFusedRows = mFusedColumns = mFusedOrder = 0;
+}
+
+Double_t Chebyshev3DCalc::pruneCoefficients(Float_t threshold)
+{
+  if (!mNumberOfRows || !mCoefficients) {
+    return 0.;
+  }
+  Double_t droppedSum = 0;
+  // Only trailing coefficients of each (row,column) run can be dropped, the
+  // significance bounds describe contiguous runs. Each dropped coefficient
+  // adds at most its magnitude to the evaluation error
+  for (int id0 = mNumberOfRows; id0--;) {
+    int nCLoc = mNumberOfColumnsAtRow[id0];
+    int col0 = mColumnAtRowBeginning[id0];
+    for (int id1 = nCLoc; id1--;) {
+      int id = id1 + col0;
+      int ncf = mCoefficientBound2D0[id];
+      const Float_t *coefs = mCoefficients + mCoefficientBound2D1[id];
+      while (ncf > 0 && TMath::Abs(coefs[ncf - 1]) < threshold) {
+        droppedSum += TMath::Abs(coefs[ncf - 1]);
+        ncf--;
+      }
+      mCoefficientBound2D0[id] = ncf;
+    }
+    // columns whose whole run was pruned away shrink the row
+    while (nCLoc > 0 && mCoefficientBound2D0[col0 + nCLoc - 1] == 0) {
+      nCLoc--;
+    }
+    mNumberOfColumnsAtRow[id0] = nCLoc;
+  }
+  // trailing rows without any surviving column shrink the outer loop
+  while (mNumberOfRows > 0 && mNumberOfColumnsAtRow[mNumberOfRows - 1] == 0) {
+    mNumberOfRows--;
+  }
+  mPrecision += droppedSum;
+  buildFusedEvaluation();
+  return droppedSum;
+}
+
+void Chebyshev3DCalc::buildFusedEvaluation()
+{
+  if (mFusedCoefficients) {
+    delete[] mFusedCoefficients;
+    mFusedCoefficients = 0;
+  }
+  mFusedRows = mFusedColumns = mFusedOrder = 0;
+  if (!mNumberOfRows || !mCoefficients) {
+    return;
+  }
+
+  int maxColumns = 0, maxOrder = 0;
+  for (int id0 = mNumberOfRows; id0--;) {
+    int nCLoc = mNumberOfColumnsAtRow[id0];
+    if (nCLoc > maxColumns) {
+      maxColumns = nCLoc;
+    }
+    for (int id1 = nCLoc; id1--;) {
+      int ncf = mCoefficientBound2D0[id1 + mColumnAtRowBeginning[id0]];
+      if (ncf > maxOrder) {
+        maxOrder = ncf;
+      }
+    }
+  }
+  if (maxColumns == 0 || maxOrder == 0 || mNumberOfRows * maxColumns * maxOrder > kMaxFusedBlockSize) {
+    return; // high-order parameterization, the dense block would not pay off
+  }
+
+  mFusedRows = mNumberOfRows;
+  mFusedColumns = maxColumns;
+  mFusedOrder = maxOrder;
+  mFusedCoefficients = new Float_t[mFusedRows * mFusedColumns * mFusedOrder];
+  for (int i = mFusedRows * mFusedColumns * mFusedOrder; i--;) {
+    mFusedCoefficients[i] = 0.f; // padding beyond each run evaluates to zero
+  }
+  for (int id0 = mFusedRows; id0--;) {
+    int nCLoc = mNumberOfColumnsAtRow[id0];
+    int col0 = mColumnAtRowBeginning[id0];
+    for (int id1 = nCLoc; id1--;) {
+      int id = id1 + col0;
+      int ncf = mCoefficientBound2D0[id];
+      const Float_t *coefs = mCoefficients + mCoefficientBound2D1[id];
+      Float_t *dense = mFusedCoefficients + (id0 * mFusedColumns + id1) * mFusedOrder;
+      for (int i = ncf; i--;) {
+        dense[i] = coefs[i];
+      }
+    }
+  }
 }
 
 void Chebyshev3DCalc::Print(const Option_t *) const
@@ -302,6 +521,70 @@ void Chebyshev3DCalc::saveData(FILE* stream) const
 }
 #endif
 
+#ifdef _INC_CREATION_Chebyshev3D_
+void Chebyshev3DCalc::saveBinary(FILE* stream) const
+{
+  UShort_t nameLength = strlen(GetName());
+  writeBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  writeBinaryBlock(GetName(), sizeof(char), nameLength, stream);
+  Int_t numberOfRows = mNumberOfRows;
+  writeBinaryBlock(&numberOfRows, sizeof(Int_t), 1, stream);
+  writeBinaryBlock(mNumberOfColumnsAtRow, sizeof(UShort_t), mNumberOfRows, stream);
+  writeBinaryBlock(mCoefficientBound2D0, sizeof(UShort_t), mNumberOfElementsBound2D, stream);
+  writeBinaryBlock(mCoefficients, sizeof(Float_t), mNumberOfCoefficients, stream);
+  writeBinaryBlock(&mPrecision, sizeof(Float_t), 1, stream);
+}
+#endif
+
+void Chebyshev3DCalc::loadBinary(FILE *stream)
+{
+  if (!stream) {
+    Error("LoadBinary", "No stream provided.\nStop");
+    exit(1);
+  }
+  Clear();
+
+  UShort_t nameLength = 0;
+  readBinaryBlock(&nameLength, sizeof(UShort_t), 1, stream);
+  std::vector<char> name(nameLength + 1, 0);
+  readBinaryBlock(&name[0], sizeof(char), nameLength, stream);
+  SetName(&name[0]);
+
+  Int_t numberOfRows = 0;
+  readBinaryBlock(&numberOfRows, sizeof(Int_t), 1, stream);
+  if (numberOfRows < 0) {
+    Error("LoadBinary", "Invalid number of rows %d in \"%s\"\nStop\n", numberOfRows, GetName());
+    exit(1);
+  }
+  mNumberOfRows = numberOfRows;
+  mNumberOfColumns = 0;
+  mNumberOfElementsBound2D = 0;
+  initializeRows(mNumberOfRows);
+
+  readBinaryBlock(mNumberOfColumnsAtRow, sizeof(UShort_t), mNumberOfRows, stream);
+  for (int id0 = 0; id0 < mNumberOfRows; id0++) {
+    mColumnAtRowBeginning[id0] = mNumberOfElementsBound2D; // begining of this row in 2D boundary surface
+    mNumberOfElementsBound2D += mNumberOfColumnsAtRow[id0];
+    if (mNumberOfColumns < mNumberOfColumnsAtRow[id0]) {
+      mNumberOfColumns = mNumberOfColumnsAtRow[id0];
+    }
+  }
+  initializeColumns(mNumberOfColumns);
+
+  mNumberOfCoefficients = 0;
+  initializeElementBound2D(mNumberOfElementsBound2D);
+
+  readBinaryBlock(mCoefficientBound2D0, sizeof(UShort_t), mNumberOfElementsBound2D, stream);
+  for (int i = 0; i < mNumberOfElementsBound2D; i++) {
+    mCoefficientBound2D1[i] = mNumberOfCoefficients;
+    mNumberOfCoefficients += mCoefficientBound2D0[i];
+  }
+
+  initializeCoefficients(mNumberOfCoefficients);
+  readBinaryBlock(mCoefficients, sizeof(Float_t), mNumberOfCoefficients, stream);
+  readBinaryBlock(&mPrecision, sizeof(Float_t), 1, stream);
+}
+
 void Chebyshev3DCalc::loadData(FILE *stream)
 {
   if (!stream) {
@@ -384,6 +667,22 @@ void Chebyshev3DCalc::readLine(TString &str, FILE *stream)
   exit(1); // normally, should not reach here
 }
 
+void Chebyshev3DCalc::writeBinaryBlock(const void *data, size_t size, size_t n, FILE *stream)
+{
+  if (fwrite(data, size, n, stream) != n) {
+    fprintf(stderr, "Chebyshev3DCalc::writeBinaryBlock: Failed to write to stream.\nStop");
+    exit(1); // normally, should not reach here
+  }
+}
+
+void Chebyshev3DCalc::readBinaryBlock(void *data, size_t size, size_t n, FILE *stream)
+{
+  if (fread(data, size, n, stream) != n) {
+    fprintf(stderr, "Chebyshev3DCalc::readBinaryBlock: Failed to read from stream.\nStop");
+    exit(1); // normally, should not reach here
+  }
+}
+
 void Chebyshev3DCalc::initializeRows(int nr)
 {
   if (mNumberOfColumnsAtRow) {
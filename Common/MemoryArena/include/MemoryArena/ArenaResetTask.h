@@ -0,0 +1,39 @@
+/// \file ArenaResetTask.h
+/// \brief FairTask hooking the event arena reset into the Exec cycle
+
+#ifndef ALICEO2_MEMORY_ARENARESETTASK_H_
+#define ALICEO2_MEMORY_ARENARESETTASK_H_
+
+#include "FairTask.h"
+#include "Rtypes.h"
+
+namespace AliceO2 {
+namespace Memory {
+
+/// \class ArenaResetTask
+/// \brief Bulk-resets every registered event arena at the end of each event
+///
+/// FairTasks execute in registration order, so adding this task last in the
+/// run makes its Exec the end-of-event hook: all arena memory handed out
+/// during the event is recycled in one sweep. FinishTask prints the
+/// per-subsystem usage report.
+class ArenaResetTask : public FairTask
+{
+ public:
+  ArenaResetTask();
+  virtual ~ArenaResetTask();
+
+  /// resets every registered arena; register this task after all
+  /// arena-using tasks
+  virtual void Exec(Option_t* option);
+
+  /// prints the per-subsystem arena usage report
+  virtual void FinishTask();
+
+  ClassDef(ArenaResetTask, 1)
+};
+
+} // namespace Memory
+} // namespace AliceO2
+
+#endif /* ALICEO2_MEMORY_ARENARESETTASK_H_ */
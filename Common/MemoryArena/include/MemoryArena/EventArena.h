@@ -0,0 +1,132 @@
+/// \file EventArena.h
+/// \brief Per-event memory arenas with bulk end-of-event reset
+///
+/// Per-event allocation (particle stacks, digit containers, clusterers,
+/// message assembly buffers) hits the glibc malloc arenas from every worker
+/// thread. An EventArena hands out memory by bumping a pointer through
+/// preallocated slabs; at the end of the event the whole region is recycled
+/// with a single reset, nothing is freed per object. Arenas are scoped to
+/// one detector task and are not thread-safe: a task allocates from its own
+/// region, so concurrent tasks never contend on a lock or a malloc arena.
+///
+/// Regions are obtained by subsystem name from the ArenaRegistry, which also
+/// provides the end-of-event bulk reset of every region and a per-subsystem
+/// usage report. The reset is hooked into the FairTask Exec cycle by adding
+/// an ArenaResetTask (see ArenaResetTask.h) as the last task of the run.
+
+#ifndef ALICEO2_MEMORY_EVENTARENA_H_
+#define ALICEO2_MEMORY_EVENTARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AliceO2 {
+namespace Memory {
+
+/// \class EventArena
+/// \brief Bump allocator over chained slabs, reset wholesale per event
+class EventArena
+{
+ public:
+  /// default slab size, big enough that a typical event stays in one slab
+  static constexpr size_t kDefaultSlabSize = 1024 * 1024;
+
+  explicit EventArena(const std::string& name, size_t slabSize = kDefaultSlabSize);
+  ~EventArena() = default;
+  EventArena(const EventArena&) = delete;
+  EventArena& operator=(const EventArena&) = delete;
+
+  /// allocate uninitialized storage; never freed individually, the memory
+  /// stays valid until the next Reset
+  void* Allocate(size_t bytes, size_t alignment = alignof(long double));
+
+  /// recycle the whole arena: the slabs are kept for the next event, no
+  /// memory is returned to the system
+  void Reset();
+
+  const std::string& GetName() const { return mName; }
+  size_t GetBytesInUse() const { return mBytesInUse; }
+  size_t GetPeakBytes() const { return mPeakBytes; }
+  size_t GetLastEventBytes() const { return mLastEventBytes; }
+  size_t GetNumSlabs() const { return mSlabs.size(); }
+  uint64_t GetNumAllocations() const { return mNumAllocations; }
+
+ private:
+  struct Slab {
+    std::unique_ptr<unsigned char[]> memory;
+    size_t size;
+    size_t offset;
+  };
+
+  Slab& AddSlab(size_t minimumSize);
+
+  std::string mName;
+  size_t mSlabSize;
+  std::vector<Slab> mSlabs;
+  size_t mCurrentSlab;        ///< slab the bump pointer lives in
+  size_t mBytesInUse;         ///< bytes handed out since the last Reset
+  size_t mPeakBytes;          ///< largest in-use volume ever seen
+  size_t mLastEventBytes;     ///< in-use volume at the last Reset
+  uint64_t mNumAllocations;   ///< lifetime number of Allocate calls
+};
+
+/// \class ArenaAllocator
+/// \brief STL allocator adapter placing container storage in an EventArena
+///
+/// Deallocation is a no-op, the memory is recycled by the arena reset; use
+/// only for containers whose lifetime ends with the event.
+template <typename T>
+class ArenaAllocator
+{
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(EventArena& arena) : mArena(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : mArena(other.GetArena()) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(mArena->Allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T*, size_t) {}
+
+  EventArena* GetArena() const { return mArena; }
+
+  bool operator==(const ArenaAllocator& other) const { return mArena == other.mArena; }
+  bool operator!=(const ArenaAllocator& other) const { return mArena != other.mArena; }
+
+ private:
+  EventArena* mArena;
+};
+
+/// \class ArenaRegistry
+/// \brief Process-wide registry of the per-subsystem event arenas
+class ArenaRegistry
+{
+ public:
+  static ArenaRegistry& Instance();
+
+  /// the arena of a subsystem, created on first use
+  EventArena& GetArena(const std::string& subsystem, size_t slabSize = EventArena::kDefaultSlabSize);
+
+  /// end-of-event bulk reset of every registered arena
+  void ResetAll();
+
+  /// per-subsystem usage report (in-use/last event/peak volume, slabs,
+  /// lifetime allocations), one line per arena
+  std::string Report() const;
+
+ private:
+  ArenaRegistry() = default;
+
+  mutable std::mutex mMutex; ///< guards the map, not the arenas themselves
+  std::map<std::string, std::unique_ptr<EventArena>> mArenas;
+};
+
+} // namespace Memory
+} // namespace AliceO2
+
+#endif /* ALICEO2_MEMORY_EVENTARENA_H_ */
@@ -0,0 +1,91 @@
+/// \file MemoryAccountant.h
+/// \brief Opt-in per-container memory accounting with high-water marks
+///
+/// RSS growth of a processing node is hard to attribute: the process-level
+/// numbers lump every subsystem together. The MemoryAccountant gives the
+/// major containers (digit and cluster containers, the simulation stack,
+/// the condition cache, device message pools) a place to report their byte
+/// counts: a container registers a named scope once and updates it at its
+/// natural synchronization points (end-of-event fill, reset, cache insert).
+/// Current volume and high-water mark per scope are queryable at runtime,
+/// devices publish them through the QC metrics path, so capacity planning
+/// works with per-subsystem numbers instead of process-level guesses.
+///
+/// Accounting is opt-in: it is off unless enabled programmatically or via
+/// the O2_MEMORY_ACCOUNTING environment variable, and containers guard the
+/// footprint computation with IsEnabled so nothing is paid while it is off.
+
+#ifndef ALICEO2_MEMORY_MEMORYACCOUNTANT_H_
+#define ALICEO2_MEMORY_MEMORYACCOUNTANT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AliceO2 {
+namespace Memory {
+
+/// \class MemoryAccountant
+/// \brief Process-wide registry of the per-container byte counts
+class MemoryAccountant
+{
+ public:
+  /// one scope as seen by a reader, see GetStats
+  struct ScopeStats {
+    std::string name;  ///< scope name, "subsystem/container"
+    size_t bytes;      ///< current volume
+    size_t highWater;  ///< largest volume ever seen
+  };
+
+  static MemoryAccountant& Instance();
+
+  /// turn accounting on or off; overrides the environment
+  static void Enable(bool enable = true);
+
+  /// whether accounting is on; consults the O2_MEMORY_ACCOUNTING
+  /// environment variable on first use unless Enable was called before
+  static bool IsEnabled();
+
+  /// register a scope by name, created on first use; registering the same
+  /// name again returns the existing scope
+  int RegisterScope(const std::string& name);
+
+  /// set the current volume of a scope, raising its high-water mark
+  void Update(int scopeId, size_t bytes);
+
+  /// adjust the current volume of a scope by a signed delta
+  void Add(int scopeId, long long delta);
+
+  size_t GetBytes(int scopeId) const;
+  size_t GetHighWater(int scopeId) const;
+
+  /// current volume summed over all scopes
+  size_t GetTotalBytes() const;
+
+  /// snapshot of all scopes, for publishing through the metrics path
+  std::vector<ScopeStats> GetStats() const;
+
+  /// per-scope usage report (current and high-water volume), one line
+  /// per scope
+  std::string Report() const;
+
+ private:
+  struct Scope {
+    std::string name;
+    size_t bytes;
+    size_t highWater;
+  };
+
+  MemoryAccountant() = default;
+
+  mutable std::mutex mMutex;  ///< guards the scope table
+  std::vector<Scope> mScopes;
+  static std::atomic<int> sEnabled;  ///< -1 until the environment is consulted
+};
+
+} // namespace Memory
+} // namespace AliceO2
+
+#endif /* ALICEO2_MEMORY_MEMORYACCOUNTANT_H_ */
@@ -0,0 +1,35 @@
+/// \file ArenaResetTask.cxx
+/// \brief Implementation of the end-of-event arena reset task
+
+#include "MemoryArena/ArenaResetTask.h"
+#include "MemoryArena/EventArena.h"
+
+#include "FairLogger.h"
+
+using namespace AliceO2::Memory;
+
+ClassImp(AliceO2::Memory::ArenaResetTask)
+
+//__________________________________________________________________________________________________
+ArenaResetTask::ArenaResetTask()
+  : FairTask("ArenaResetTask")
+{
+}
+
+//__________________________________________________________________________________________________
+ArenaResetTask::~ArenaResetTask()
+{
+}
+
+//__________________________________________________________________________________________________
+void ArenaResetTask::Exec(Option_t* /*option*/)
+{
+  ArenaRegistry::Instance().ResetAll();
+}
+
+//__________________________________________________________________________________________________
+void ArenaResetTask::FinishTask()
+{
+  LOG(INFO) << "Event arena usage:" << FairLogger::endl
+            << ArenaRegistry::Instance().Report() << FairLogger::endl;
+}
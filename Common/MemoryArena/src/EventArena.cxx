@@ -0,0 +1,123 @@
+/// \file EventArena.cxx
+/// \brief Implementation of the per-event memory arenas
+
+#include "MemoryArena/EventArena.h"
+
+#include <cstdio>
+
+using namespace AliceO2::Memory;
+
+constexpr size_t EventArena::kDefaultSlabSize;
+
+//__________________________________________________________________________________________________
+EventArena::EventArena(const std::string& name, size_t slabSize)
+  : mName(name)
+  , mSlabSize(slabSize)
+  , mSlabs()
+  , mCurrentSlab(0)
+  , mBytesInUse(0)
+  , mPeakBytes(0)
+  , mLastEventBytes(0)
+  , mNumAllocations(0)
+{
+  AddSlab(mSlabSize);
+}
+
+//__________________________________________________________________________________________________
+EventArena::Slab& EventArena::AddSlab(size_t minimumSize)
+{
+  size_t size = (minimumSize > mSlabSize) ? minimumSize : mSlabSize;
+  mSlabs.emplace_back();
+  Slab& slab = mSlabs.back();
+  slab.memory.reset(new unsigned char[size]);
+  slab.size = size;
+  slab.offset = 0;
+  return slab;
+}
+
+//__________________________________________________________________________________________________
+void* EventArena::Allocate(size_t bytes, size_t alignment)
+{
+  // alignment applies to the absolute address, the slab base itself is only
+  // guaranteed the fundamental alignment
+  Slab* slab = &mSlabs[mCurrentSlab];
+  uintptr_t base = reinterpret_cast<uintptr_t>(slab->memory.get());
+  uintptr_t address = (base + slab->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  if (address - base + bytes > slab->size) {
+    // current slab exhausted: reuse the next one kept from an earlier event
+    // or chain a new one (oversized requests get a slab of their own size)
+    if (mCurrentSlab + 1 < mSlabs.size() && bytes + alignment <= mSlabs[mCurrentSlab + 1].size) {
+      ++mCurrentSlab;
+      slab = &mSlabs[mCurrentSlab];
+    } else {
+      slab = &AddSlab(bytes + alignment);
+      mCurrentSlab = mSlabs.size() - 1;
+    }
+    base = reinterpret_cast<uintptr_t>(slab->memory.get());
+    address = (base + slab->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  }
+  slab->offset = address - base + bytes;
+
+  mBytesInUse += bytes;
+  if (mBytesInUse > mPeakBytes) {
+    mPeakBytes = mBytesInUse;
+  }
+  ++mNumAllocations;
+  return reinterpret_cast<void*>(address);
+}
+
+//__________________________________________________________________________________________________
+void EventArena::Reset()
+{
+  for (auto& slab : mSlabs) {
+    slab.offset = 0;
+  }
+  mCurrentSlab = 0;
+  mLastEventBytes = mBytesInUse;
+  mBytesInUse = 0;
+}
+
+//__________________________________________________________________________________________________
+ArenaRegistry& ArenaRegistry::Instance()
+{
+  static ArenaRegistry registry;
+  return registry;
+}
+
+//__________________________________________________________________________________________________
+EventArena& ArenaRegistry::GetArena(const std::string& subsystem, size_t slabSize)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  auto& arena = mArenas[subsystem];
+  if (!arena) {
+    arena.reset(new EventArena(subsystem, slabSize));
+  }
+  return *arena;
+}
+
+//__________________________________________________________________________________________________
+void ArenaRegistry::ResetAll()
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  for (auto& entry : mArenas) {
+    entry.second->Reset();
+  }
+}
+
+//__________________________________________________________________________________________________
+std::string ArenaRegistry::Report() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  std::string report;
+  char line[256];
+  for (const auto& entry : mArenas) {
+    const EventArena& arena = *entry.second;
+    snprintf(line, sizeof(line),
+             "%-12s in use %8zu B, last event %8zu B, peak %8zu B, %zu slab(s), %llu allocations\n",
+             arena.GetName().c_str(), arena.GetBytesInUse(), arena.GetLastEventBytes(),
+             arena.GetPeakBytes(), arena.GetNumSlabs(),
+             (unsigned long long)arena.GetNumAllocations());
+    report += line;
+  }
+  return report;
+}
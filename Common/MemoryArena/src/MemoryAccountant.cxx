@@ -0,0 +1,138 @@
+/// \file MemoryAccountant.cxx
+/// \brief Implementation of the opt-in memory accounting registry
+
+#include "MemoryArena/MemoryAccountant.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace AliceO2::Memory;
+
+std::atomic<int> MemoryAccountant::sEnabled{-1};
+
+//__________________________________________________________________________________________________
+MemoryAccountant& MemoryAccountant::Instance()
+{
+  static MemoryAccountant accountant;
+  return accountant;
+}
+
+//__________________________________________________________________________________________________
+void MemoryAccountant::Enable(bool enable)
+{
+  sEnabled.store(enable ? 1 : 0, std::memory_order_relaxed);
+}
+
+//__________________________________________________________________________________________________
+bool MemoryAccountant::IsEnabled()
+{
+  int state = sEnabled.load(std::memory_order_relaxed);
+  if (state < 0) {
+    const char* env = getenv("O2_MEMORY_ACCOUNTING");
+    state = (env != nullptr && env[0] != '\0' && env[0] != '0') ? 1 : 0;
+    sEnabled.store(state, std::memory_order_relaxed);
+  }
+  return state == 1;
+}
+
+//__________________________________________________________________________________________________
+int MemoryAccountant::RegisterScope(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  for (size_t i = 0; i < mScopes.size(); i++) {
+    if (mScopes[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  mScopes.push_back(Scope{name, 0, 0});
+  return static_cast<int>(mScopes.size() - 1);
+}
+
+//__________________________________________________________________________________________________
+void MemoryAccountant::Update(int scopeId, size_t bytes)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (scopeId < 0 || static_cast<size_t>(scopeId) >= mScopes.size()) {
+    return;
+  }
+  Scope& scope = mScopes[scopeId];
+  scope.bytes = bytes;
+  if (bytes > scope.highWater) {
+    scope.highWater = bytes;
+  }
+}
+
+//__________________________________________________________________________________________________
+void MemoryAccountant::Add(int scopeId, long long delta)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (scopeId < 0 || static_cast<size_t>(scopeId) >= mScopes.size()) {
+    return;
+  }
+  Scope& scope = mScopes[scopeId];
+  if (delta < 0 && static_cast<size_t>(-delta) > scope.bytes) {
+    scope.bytes = 0;
+  } else {
+    scope.bytes += delta;
+  }
+  if (scope.bytes > scope.highWater) {
+    scope.highWater = scope.bytes;
+  }
+}
+
+//__________________________________________________________________________________________________
+size_t MemoryAccountant::GetBytes(int scopeId) const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (scopeId < 0 || static_cast<size_t>(scopeId) >= mScopes.size()) {
+    return 0;
+  }
+  return mScopes[scopeId].bytes;
+}
+
+//__________________________________________________________________________________________________
+size_t MemoryAccountant::GetHighWater(int scopeId) const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  if (scopeId < 0 || static_cast<size_t>(scopeId) >= mScopes.size()) {
+    return 0;
+  }
+  return mScopes[scopeId].highWater;
+}
+
+//__________________________________________________________________________________________________
+size_t MemoryAccountant::GetTotalBytes() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  size_t total = 0;
+  for (const auto& scope : mScopes) {
+    total += scope.bytes;
+  }
+  return total;
+}
+
+//__________________________________________________________________________________________________
+std::vector<MemoryAccountant::ScopeStats> MemoryAccountant::GetStats() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  std::vector<ScopeStats> stats;
+  stats.reserve(mScopes.size());
+  for (const auto& scope : mScopes) {
+    stats.push_back(ScopeStats{scope.name, scope.bytes, scope.highWater});
+  }
+  return stats;
+}
+
+//__________________________________________________________________________________________________
+std::string MemoryAccountant::Report() const
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  std::string report;
+  char line[256];
+  for (const auto& scope : mScopes) {
+    snprintf(line, sizeof(line), "%-24s in use %10zu B, high water %10zu B\n",
+             scope.name.c_str(), scope.bytes, scope.highWater);
+    report += line;
+  }
+  return report;
+}
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE Test Common MemoryArena
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MemoryArena/EventArena.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace AliceO2 {
+namespace Memory {
+
+BOOST_AUTO_TEST_CASE(bumpAllocation_test)
+{
+  EventArena arena{"test", 1024};
+
+  void* first = arena.Allocate(100);
+  void* second = arena.Allocate(100);
+  BOOST_REQUIRE(first != nullptr);
+  BOOST_REQUIRE(second != nullptr);
+  BOOST_CHECK(first != second);
+  BOOST_CHECK_EQUAL(arena.GetBytesInUse(), 200);
+  BOOST_CHECK_EQUAL(arena.GetNumAllocations(), 2);
+
+  // alignment is honored
+  arena.Allocate(1);
+  void* aligned = arena.Allocate(8, 64);
+  BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+}
+
+BOOST_AUTO_TEST_CASE(resetRecyclesSlabs_test)
+{
+  EventArena arena{"test", 1024};
+
+  void* first = arena.Allocate(100);
+  arena.Reset();
+  BOOST_CHECK_EQUAL(arena.GetBytesInUse(), 0);
+  BOOST_CHECK_EQUAL(arena.GetLastEventBytes(), 100);
+
+  // after the reset the same memory is handed out again, nothing was freed
+  void* again = arena.Allocate(100);
+  BOOST_CHECK_EQUAL(first, again);
+}
+
+BOOST_AUTO_TEST_CASE(slabGrowth_test)
+{
+  EventArena arena{"test", 256};
+
+  // spills into chained slabs, oversized requests get a slab of their own
+  arena.Allocate(200);
+  arena.Allocate(200);
+  arena.Allocate(5000);
+  BOOST_CHECK(arena.GetNumSlabs() >= 3);
+  BOOST_CHECK_EQUAL(arena.GetPeakBytes(), 5400);
+
+  // the grown arena keeps its slabs across events
+  size_t slabs = arena.GetNumSlabs();
+  arena.Reset();
+  arena.Allocate(200);
+  arena.Allocate(200);
+  arena.Allocate(5000);
+  BOOST_CHECK_EQUAL(arena.GetNumSlabs(), slabs);
+}
+
+BOOST_AUTO_TEST_CASE(arenaAllocator_test)
+{
+  EventArena arena{"test"};
+
+  std::vector<int, ArenaAllocator<int>> digits{ArenaAllocator<int>{arena}};
+  for (int i = 0; i < 1000; ++i) {
+    digits.push_back(i);
+  }
+  BOOST_CHECK_EQUAL(digits[999], 999);
+  BOOST_CHECK(arena.GetBytesInUse() >= 1000 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(registry_test)
+{
+  ArenaRegistry& registry = ArenaRegistry::Instance();
+
+  EventArena& tpc = registry.GetArena("TPC");
+  EventArena& its = registry.GetArena("ITS");
+  BOOST_CHECK(&tpc == &registry.GetArena("TPC"));
+  BOOST_CHECK(&tpc != &its);
+
+  tpc.Allocate(123);
+  its.Allocate(456);
+  registry.ResetAll();
+  BOOST_CHECK_EQUAL(tpc.GetBytesInUse(), 0);
+  BOOST_CHECK_EQUAL(tpc.GetLastEventBytes(), 123);
+  BOOST_CHECK_EQUAL(its.GetLastEventBytes(), 456);
+
+  std::string report = registry.Report();
+  BOOST_CHECK(report.find("TPC") != std::string::npos);
+  BOOST_CHECK(report.find("ITS") != std::string::npos);
+}
+
+} // namespace Memory
+} // namespace AliceO2
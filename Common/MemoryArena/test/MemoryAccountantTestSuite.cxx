@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Test Common MemoryAccountant
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MemoryArena/MemoryAccountant.h"
+
+namespace AliceO2 {
+namespace Memory {
+
+BOOST_AUTO_TEST_CASE(enableSwitch_test)
+{
+  MemoryAccountant::Enable();
+  BOOST_CHECK(MemoryAccountant::IsEnabled());
+  MemoryAccountant::Enable(false);
+  BOOST_CHECK(!MemoryAccountant::IsEnabled());
+  MemoryAccountant::Enable();
+}
+
+BOOST_AUTO_TEST_CASE(scopeRegistration_test)
+{
+  auto& accountant = MemoryAccountant::Instance();
+
+  int first = accountant.RegisterScope("test/first");
+  int second = accountant.RegisterScope("test/second");
+  BOOST_CHECK(first != second);
+
+  // registering the same name again returns the existing scope
+  BOOST_CHECK_EQUAL(accountant.RegisterScope("test/first"), first);
+}
+
+BOOST_AUTO_TEST_CASE(updateAndHighWater_test)
+{
+  auto& accountant = MemoryAccountant::Instance();
+  int scope = accountant.RegisterScope("test/highwater");
+
+  accountant.Update(scope, 1000);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(scope), 1000);
+  BOOST_CHECK_EQUAL(accountant.GetHighWater(scope), 1000);
+
+  // the high-water mark survives a shrink
+  accountant.Update(scope, 200);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(scope), 200);
+  BOOST_CHECK_EQUAL(accountant.GetHighWater(scope), 1000);
+
+  accountant.Add(scope, 300);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(scope), 500);
+  accountant.Add(scope, -500);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(scope), 0);
+
+  // an underflowing delta clamps at zero
+  accountant.Add(scope, -100);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(scope), 0);
+}
+
+BOOST_AUTO_TEST_CASE(statsSnapshot_test)
+{
+  auto& accountant = MemoryAccountant::Instance();
+  int scope = accountant.RegisterScope("test/snapshot");
+  accountant.Update(scope, 4096);
+
+  bool found = false;
+  for (const auto& stats : accountant.GetStats()) {
+    if (stats.name == "test/snapshot") {
+      BOOST_CHECK_EQUAL(stats.bytes, 4096);
+      BOOST_CHECK_EQUAL(stats.highWater, 4096);
+      found = true;
+    }
+  }
+  BOOST_CHECK(found);
+  BOOST_CHECK(accountant.GetTotalBytes() >= 4096);
+  BOOST_CHECK(!accountant.Report().empty());
+
+  // out-of-range ids are ignored
+  accountant.Update(-1, 1);
+  BOOST_CHECK_EQUAL(accountant.GetBytes(-1), 0);
+}
+
+} // namespace Memory
+} // namespace AliceO2
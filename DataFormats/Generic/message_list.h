@@ -161,6 +161,124 @@ class messageList {
   };
   */
 
+  /**
+   * @class validatedView
+   * Bulk-validated access to the list.
+   *
+   * One pass over the list applies a validator to every header and caches
+   * the payload pointers of the passing entries in a flat index. Iterating
+   * the view afterwards is plain pointer arithmetic over that index with a
+   * software prefetch of the payload one slot ahead; no validation and no
+   * std::function dispatch runs per element anymore, which matters for
+   * devices walking thousand-part messages.
+   *
+   * The validator is a template parameter of @ref createView, so a trivial
+   * word comparison (e.g. of the DataHeader magic word) inlines into the
+   * validation loop and can be vectorized by the compiler.
+   *
+   * The view stores raw pointers, it is invalidated by any modification of
+   * the underlying list.
+   */
+  class validatedView {
+   public:
+    validatedView() : mIndex() {}
+
+    /** one validated entry: header and payload location in the list */
+    struct entry {
+      const HdrT* mHeader;
+      MsgT* mPayload;
+    };
+
+    class const_iterator {
+     public:
+      typedef const_iterator self_type;
+      typedef MsgT value_type;
+
+      const_iterator(const entry* position, const entry* end)
+        : mPosition(position), mEnd(end)
+      { }
+
+      // prefix increment, prefetches the payload of the following entry so
+      // it is cache resident when the loop body gets there
+      self_type& operator++() {
+        ++mPosition;
+        if (mPosition != mEnd && mPosition + 1 != mEnd) {
+          __builtin_prefetch((mPosition + 1)->mPayload);
+        }
+        return *this;
+      }
+      // postfix increment
+      self_type operator++(int unused) {self_type copy(*this); ++*this; return copy;}
+
+      MsgT& operator*() const { return *(mPosition->mPayload); }
+      MsgT* operator->() const { return mPosition->mPayload; }
+
+      /** return header at iterator position */
+      const HdrT& getHdr() const { return *(mPosition->mHeader); }
+
+      /** return size of payload */
+      size_t size() const { return mPosition->mHeader->mPayloadSize; }
+
+      bool operator==(const self_type& other) const { return mPosition == other.mPosition; }
+      bool operator!=(const self_type& other) const { return mPosition != other.mPosition; }
+
+     private:
+      const entry* mPosition;
+      const entry* mEnd;
+    };
+
+    const_iterator begin() const {
+      const entry* first = mIndex.empty() ? nullptr : &mIndex[0];
+      if (mIndex.size() > 1) {
+        __builtin_prefetch(first->mPayload);
+      }
+      return const_iterator(first, first + mIndex.size());
+    }
+    const_iterator end() const {
+      const entry* first = mIndex.empty() ? nullptr : &mIndex[0];
+      return const_iterator(first + mIndex.size(), first + mIndex.size());
+    }
+
+    /** number of entries that passed validation */
+    size_t size() const { return mIndex.size(); }
+    bool empty() const { return mIndex.empty(); }
+
+   private:
+    friend class messageList;
+    std::vector<entry> mIndex;
+  };
+
+  /**
+   * create a bulk-validated view of the list
+   * The validation runs in two tight passes: the first one only evaluates
+   * the validator on the contiguous header array and records a flag, the
+   * second one gathers the accepted entries into the flat index. Keeping
+   * the first loop free of pointer chasing lets simple validators, like a
+   * magic word comparison, run vectorized over all headers.
+   */
+  template<typename HdrValidator>
+  validatedView createView(HdrValidator validate) {
+    validatedView view;
+    const size_t count = mDataArray.size();
+    std::vector<unsigned char> accepted(count);
+    for (size_t i = 0; i < count; i++) {
+      accepted[i] = validate(static_cast<const HdrT&>(mDataArray[i].mHeader)) ? 1 : 0;
+    }
+    view.mIndex.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      if (accepted[i]) {
+        view.mIndex.push_back(typename validatedView::entry{&mDataArray[i].mHeader, mDataArray[i].mPayload});
+      }
+    }
+    return view;
+  }
+
+  /** create a view accepting all entries, iteration without any per-element
+   *  logic */
+  validatedView createView() {
+    return createView([](const HdrT&) { return true; });
+  }
+
   iterator begin(const HdrComparison hdrsel = HdrComparison()) {
     iterator ret(mDataArray.begin(), mDataArray.end(), hdrsel);
     // if the std::function container has an assigned target, this is
@@ -180,6 +298,105 @@ class messageList {
   std::vector<messagePair> mDataArray;
 };
 
+/**
+ * @class arenaMessageList
+ * Header/payload list backed by one contiguous slab of memory.
+ *
+ * A multipart transfer often arrives in a single allocation holding all
+ * header and payload parts back to back. Instead of wrapping every part in
+ * an individually owned message object, this list adopts the whole slab
+ * once and stores plain offsets into it; destruction is one slab release
+ * instead of N deallocations, which matters at multi-kHz multipart rates.
+ *
+ * The slab is released through the function handed to the constructor, so
+ * any allocator (including a transport-owned buffer) can be plugged in.
+ * Entries reference the slab, they are valid as long as the list lives.
+ */
+template<class HdrT>
+class arenaMessageList {
+ public:
+  typedef HdrT header_type;
+  /// release function for the slab, called once from the destructor
+  typedef std::function<void(uint8_t*)> SlabRelease;
+
+  /// adopt a slab; the list owns it from here on
+  arenaMessageList(uint8_t* slab, size_t slabSize, SlabRelease release)
+    : mSlab(slab), mSlabSize(slabSize), mRelease(release), mEntries()
+  { }
+  /// convenience constructor for slabs allocated with new[]
+  arenaMessageList(uint8_t* slab, size_t slabSize)
+    : mSlab(slab), mSlabSize(slabSize), mRelease([](uint8_t* buffer){delete[] buffer;}), mEntries()
+  { }
+  arenaMessageList(const arenaMessageList& other) = delete;
+  arenaMessageList& operator=(const arenaMessageList& other) = delete;
+  ~arenaMessageList() {
+    if (mSlab && mRelease) mRelease(mSlab);
+  }
+
+  /// add a data block described by its offsets inside the slab
+  /// returns the new number of entries, -1 if the block does not fit the slab
+  int add(size_t headerOffset, size_t payloadOffset, size_t payloadSize) {
+    if (headerOffset + sizeof(HdrT) > mSlabSize || payloadOffset + payloadSize > mSlabSize) {
+      return -1;
+    }
+    mEntries.push_back(entry{headerOffset, payloadOffset, payloadSize});
+    return mEntries.size();
+  }
+
+  /** number of data blocks in the list */
+  size_t size() const {return mEntries.size();}
+  /** check if list is empty */
+  bool empty() const {return mEntries.empty();}
+
+  /** offset triple describing one data block inside the slab */
+  struct entry {
+    size_t mHeaderOffset;
+    size_t mPayloadOffset;
+    size_t mPayloadSize;
+  };
+
+  class iterator {
+   public:
+    typedef iterator self_type;
+
+    iterator(const arenaMessageList* list, size_t position)
+      : mList(list), mPosition(position)
+    { }
+
+    // prefix increment
+    self_type& operator++() {++mPosition; return *this;}
+    // postfix increment
+    self_type operator++(int unused) {self_type copy(*this); ++*this; return copy;}
+
+    /** payload pointer at iterator position */
+    uint8_t* operator*() const {
+      return mList->mSlab + mList->mEntries[mPosition].mPayloadOffset;
+    }
+    /** return header at iterator position */
+    const HdrT& getHdr() const {
+      return *reinterpret_cast<const HdrT*>(mList->mSlab + mList->mEntries[mPosition].mHeaderOffset);
+    }
+    /** return size of payload */
+    size_t size() const {return mList->mEntries[mPosition].mPayloadSize;}
+
+    bool operator==(const self_type& other) const {return mPosition == other.mPosition;}
+    bool operator!=(const self_type& other) const {return mPosition != other.mPosition;}
+
+   private:
+    const arenaMessageList* mList;
+    size_t mPosition;
+  };
+
+  iterator begin() const {return iterator(this, 0);}
+  iterator end() const {return iterator(this, mEntries.size());}
+
+ private:
+  uint8_t* mSlab;              /// the one allocation backing all entries
+  size_t mSlabSize;            /// size of the slab in byte
+  SlabRelease mRelease;        /// called once on destruction
+  std::vector<entry> mEntries; /// offsets instead of owning pointers
+};
+
 }; // namespace Format
 }; // namespace AliceO2
 #endif
@@ -10,7 +10,9 @@
 #include "memory-format.h"
 
 #include <cstring> // memset
+#include <cstdio>  // snprintf
 #include <iostream>
+#include <new>     // placement new
 
 using namespace AliceO2;
 using namespace Format;
@@ -119,5 +121,78 @@ int main(int argc, char** argv)
   print_list(msglist, [](const TestMsgList_t::header_type& hdr){return hdr.specification==0xf00;} );
   std::cout << std::endl;
 
-  return 0;
+  // bulk-validated view: one validation pass, then flat iteration
+  SimpleList_t::validatedView view =
+    input.createView([](const SimpleHeader_t& hdr){return hdr.specification==0xdeadbeef;});
+  std::cout << "validated view (specification 0xdeadbeef): "
+            << view.size() << " of " << input.size() << " entries" << std::endl;
+  if (view.size() != 1) {
+    std::cout << "error: expected 1 validated entry" << std::endl;
+    iResult = -1;
+  }
+  for (SimpleList_t::validatedView::const_iterator it = view.begin();
+       it != view.end();
+       ++it) {
+    std::cout << it.getHdr() << std::endl;
+    std::cout << *it << std::endl;
+    if (it.getHdr().id != 1) {
+      std::cout << "error: unexpected entry in validated view" << std::endl;
+      iResult = -1;
+    }
+  }
+
+  // accept-all view keeps the full list
+  if (input.createView().size() != input.size()) {
+    std::cout << "error: accept-all view dropped entries" << std::endl;
+    iResult = -1;
+  }
+
+  // arena-owned list: all parts live in one slab, released exactly once
+  {
+    const unsigned nParts = 4;
+    const size_t partSize = sizeof(SimpleHeader_t) + 16;
+    uint8_t* slab = new uint8_t[nParts * partSize];
+    int releaseCount = 0;
+
+    typedef arenaMessageList<SimpleHeader_t> ArenaList_t;
+    ArenaList_t arenaList(slab, nParts * partSize,
+                          [&releaseCount](uint8_t* buffer){releaseCount++; delete[] buffer;});
+
+    for (unsigned part = 0; part < nParts; part++) {
+      size_t headerOffset = part * partSize;
+      size_t payloadOffset = headerOffset + sizeof(SimpleHeader_t);
+      new (slab + headerOffset) SimpleHeader_t(part, 0xbeef);
+      snprintf(reinterpret_cast<char*>(slab + payloadOffset), 16, "part %u", part);
+      if (arenaList.add(headerOffset, payloadOffset, 16) < 0) {
+        std::cout << "error: arena add rejected a fitting block" << std::endl;
+        iResult = -1;
+      }
+    }
+    // an out-of-bounds block has to be rejected
+    if (arenaList.add(nParts * partSize, 0, 16) >= 0) {
+      std::cout << "error: arena add accepted an out-of-bounds block" << std::endl;
+      iResult = -1;
+    }
+
+    std::cout << "arena list:" << std::endl;
+    unsigned expectedId = 0;
+    for (ArenaList_t::iterator it = arenaList.begin(); it != arenaList.end(); ++it, ++expectedId) {
+      std::cout << it.getHdr() << std::endl;
+      std::cout << *it << std::endl;
+      if (it.getHdr().id != expectedId || it.size() != 16) {
+        std::cout << "error: unexpected arena entry" << std::endl;
+        iResult = -1;
+      }
+    }
+
+    // destruction of the list releases the slab exactly once
+    { ArenaList_t emptyList(new uint8_t[8], 8,
+                            [&releaseCount](uint8_t* buffer){releaseCount++; delete[] buffer;}); }
+    if (releaseCount != 1) {
+      std::cout << "error: expected exactly one slab release, got " << releaseCount << std::endl;
+      iResult = -1;
+    }
+  }
+
+  return iResult;
 }
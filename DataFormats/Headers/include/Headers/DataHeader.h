@@ -21,9 +21,11 @@
 #define ALICEO2_BASE_DATA_HEADER_
 
 #include <cstdint>
+#include <cstring>
 #include <stdio.h>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 
 // enum class byte : unsigned char
 // {
@@ -233,8 +235,11 @@ struct Descriptor {
   }
   // note: no operator=(const char*) as this potentially runs into trouble with this
   // general pointer type, use: somedescriptor = Descriptor("DESCRIPTION")
+  // printer is initialized along with the value: a constexpr constructor has
+  // to initialize every member, otherwise the instances cannot be constant
+  // expressions (e.g. the origin constants used as switch case labels)
   template<std::size_t NN>
-  constexpr Descriptor(const char (&origin)[NN]) : itg(String2<ItgType>(origin)) {};
+  constexpr Descriptor(const char (&origin)[NN]) : itg(String2<ItgType>(origin)), printer() {};
   bool operator==(const Descriptor& other) const {return itg == other.itg;}
   bool operator!=(const Descriptor& other) const {return not this->operator==(other);}
   // print function needs to be implemented for every derivation
@@ -387,6 +392,27 @@ const HeaderType* get(const byte* buffer, size_t /*len*/=0) {
   return nullptr;
 }
 
+//__________________________________________________________________________________________________
+/// typed error codes for validateStack
+/// kept as plain values so callers can count/histogram them without string handling
+/// @ingroup aliceo2_dataformats_dataheader
+enum class StackValidationError : uint32_t {
+  kValid = 0,          //the complete chain is consistent
+  kEmpty,              //null buffer or zero size
+  kTruncatedBase,      //fewer bytes left than a BaseHeader
+  kBadMagic,           //magic string mismatch at the current position
+  kBadHeaderSize,      //headerSize smaller than sizeof(BaseHeader)
+  kTruncatedHeader     //headerSize extends past the end of the buffer
+};
+
+/// walk a header stack and check its consistency without producing any output
+/// cheap enough for the receive hot path: pure pointer arithmetic and integer
+/// compares, no I/O and no allocation. Returns kValid or the error of the first
+/// inconsistent header; forward progress is guaranteed by the headerSize check
+/// so a corrupted chain can not loop.
+/// @ingroup aliceo2_dataformats_dataheader
+StackValidationError validateStack(const byte* buffer, size_t bufferSize) noexcept;
+
 //__________________________________________________________________________________________________
 /// @struct Block
 /// @brief a move-only header block with serialized headers
@@ -447,6 +473,22 @@ struct Block {
     return b;
   }
 
+  /// like compose, but serializes into the provided preallocated buffer of the
+  /// given capacity (taking ownership of it); falls back to a fresh allocation
+  /// when the headers do not fit. Lets callers recycle buffers, e.g. from a pool
+  template<typename... Args>
+  static Block composeInto(Buffer preallocated, size_t capacity, const Args... args) {
+    Block b;
+    b.bufferSize = size(args...);
+    if (b.bufferSize <= capacity) {
+      b.buffer = std::move(preallocated);
+    } else {
+      b.buffer.reset(new byte[b.bufferSize]);
+    }
+    inject(b.buffer.get(), args...);
+    return b;
+  }
+
   template<typename T, typename... Args>
   static size_t size(const T& h, const Args... args) noexcept {
     return size(h) + size(args...);
@@ -472,6 +514,64 @@ private:
   }
 };
 
+//__________________________________________________________________________________________________
+/// @struct HeaderStack
+/// @brief a header stack composed at compile time
+/// For devices sending the same fixed header layout with every message: the
+/// member headers are laid out contiguously in declaration order, the total
+/// size is a compile-time constant and the next-header chaining flags are set
+/// on construction, so building (or copying) the stack is a single
+/// memcpy-sized operation instead of the chained runtime logic of Block.
+/// The resulting bytes follow the usual chain convention and are readable
+/// with get<HeaderType>(buffer).
+/// intended use:
+///   HeaderStack<DataHeader, NameHeader<16>> stack{dh, nh};
+///   memcpy(target, stack.data(), stack.size());
+/// @ingroup aliceo2_dataformats_dataheader
+template<typename... Headers>
+struct HeaderStack;
+
+template<typename HeaderT>
+struct HeaderStack<HeaderT> {
+  static_assert(std::is_base_of<BaseHeader, HeaderT>::value,
+                "HeaderStack members must derive from BaseHeader");
+
+  HeaderT header;
+
+  static constexpr size_t stackSize = sizeof(HeaderT);
+
+  HeaderStack(const HeaderT& h) : header{h} {
+    // terminate the chain
+    header.flagsNextHeader = false;
+  }
+
+  const byte* data() const noexcept {return reinterpret_cast<const byte*>(this);}
+  static constexpr size_t size() noexcept {return stackSize;}
+};
+
+template<typename HeaderT, typename... Tail>
+struct HeaderStack<HeaderT, Tail...> {
+  static_assert(std::is_base_of<BaseHeader, HeaderT>::value,
+                "HeaderStack members must derive from BaseHeader");
+
+  HeaderT header;
+  HeaderStack<Tail...> tail;
+
+  static constexpr size_t stackSize = sizeof(HeaderT) + HeaderStack<Tail...>::stackSize;
+
+  HeaderStack(const HeaderT& h, const Tail&... t) : header{h}, tail{t...} {
+    // chain to the following header
+    header.flagsNextHeader = true;
+  }
+
+  const byte* data() const noexcept {
+    // next() walks by headerSize, so no padding may sit between the members
+    static_assert(sizeof(HeaderStack) == stackSize, "padding between stacked headers would break the chain");
+    return reinterpret_cast<const byte*>(this);
+  }
+  static constexpr size_t size() noexcept {return stackSize;}
+};
+
 //__________________________________________________________________________________________________
 /// @struct NameHeader
 /// @brief an example data header containing a name of an object as a null terminated char arr.
@@ -524,6 +624,44 @@ const SerializationMethod NameHeader<N>::sSerializationMethod = gSerializationMe
 template <size_t N>
 const uint32_t NameHeader<N>::sVersion = 1;
 
+//__________________________________________________________________________________________________
+/// @struct TelemetryHeader
+/// @brief per-hop backpressure telemetry carried in the header stack
+/// Each forwarding device appends one of these when composing its outgoing
+/// header stack: its index in the chain, occupancy and capacity of its send
+/// queue at the moment the message was queued, and a steady clock timestamp.
+/// The cost per stamped message is filling these few words. The receiver can
+/// attribute queue growth and per-hop latency to a stage without external
+/// tooling (see TelemetryAnalyzer); the timestamps are steady clock values
+/// and only comparable between hops running on the same host.
+/// @ingroup aliceo2_dataformats_dataheader
+struct TelemetryHeader : public BaseHeader
+{
+  static const uint32_t sVersion;
+  static const AliceO2::Header::HeaderType sHeaderType;
+  static const AliceO2::Header::SerializationMethod sSerializationMethod;
+
+  /// index of the stamping device within the chain (e.g. flp index)
+  uint32_t deviceIndex;
+  /// send-queue occupancy when the message was queued
+  uint32_t queueOccupancy;
+  /// configured capacity of the send queue
+  uint32_t queueCapacity;
+  /// for alignment, reserved for future use
+  uint32_t reserved;
+  /// steady clock at stamping, in microseconds (see nowUs())
+  uint64_t timestampUs;
+
+  TelemetryHeader();
+  /// stamping constructor, records the current steady clock
+  TelemetryHeader(uint32_t device, uint32_t occupancy, uint32_t capacity);
+
+  /// the steady clock in microseconds, the epoch the stamps use
+  static uint64_t nowUs();
+
+  void print() const;
+};
+
 //__________________________________________________________________________________________________
 /// this 128 bit type for a header field describing the payload data type
 struct DataDescription {
@@ -647,20 +785,43 @@ struct DataHeader : public BaseHeader
 
 //__________________________________________________________________________________________________
 //possible data origins
-extern const AliceO2::Header::DataOrigin gDataOriginAny;
-extern const AliceO2::Header::DataOrigin gDataOriginInvalid;
-extern const AliceO2::Header::DataOrigin gDataOriginTPC;
-extern const AliceO2::Header::DataOrigin gDataOriginTRD;
-extern const AliceO2::Header::DataOrigin gDataOriginTOF;
+//defined constexpr: the values are evaluated at compile time and live in
+//rodata, no dynamic initialization happens at library load
+constexpr AliceO2::Header::DataOrigin gDataOriginAny    ("***");
+constexpr AliceO2::Header::DataOrigin gDataOriginInvalid("   ");
+constexpr AliceO2::Header::DataOrigin gDataOriginTPC    ("TPC");
+constexpr AliceO2::Header::DataOrigin gDataOriginTRD    ("TRD");
+constexpr AliceO2::Header::DataOrigin gDataOriginTOF    ("TOF");
 
 //possible data types
-extern const AliceO2::Header::DataDescription gDataDescriptionAny;
-extern const AliceO2::Header::DataDescription gDataDescriptionInvalid;
-extern const AliceO2::Header::DataDescription gDataDescriptionRawData;
-extern const AliceO2::Header::DataDescription gDataDescriptionClusters;
-extern const AliceO2::Header::DataDescription gDataDescriptionTracks;
-extern const AliceO2::Header::DataDescription gDataDescriptionConfig;
-extern const AliceO2::Header::DataDescription gDataDescriptionInfo;
+constexpr AliceO2::Header::DataDescription gDataDescriptionAny     ("***************");
+constexpr AliceO2::Header::DataDescription gDataDescriptionInvalid ("               ");
+constexpr AliceO2::Header::DataDescription gDataDescriptionRawData ("RAWDATA        ");
+constexpr AliceO2::Header::DataDescription gDataDescriptionClusters("CLUSTERS       ");
+constexpr AliceO2::Header::DataDescription gDataDescriptionTracks  ("TRACKS         ");
+constexpr AliceO2::Header::DataDescription gDataDescriptionConfig  ("CONFIG         ");
+constexpr AliceO2::Header::DataDescription gDataDescriptionInfo    ("INFO           ");
+
+//__________________________________________________________________________________________________
+//integer views of the constants above, usable as switch case labels: device
+//dispatch over message types becomes a switch the compiler can compile to a
+//jump table instead of a chain of 64/128 bit Descriptor comparisons.
+//An origin fits its full 32 bit value; the 128 bit data description is
+//dispatched on its first 64 bit word, which is unique across the defined
+//descriptions, i.e. switch (header.dataDescription.itg[0])
+constexpr uint32_t gDataOriginIntAny     = gDataOriginAny.itg;
+constexpr uint32_t gDataOriginIntInvalid = gDataOriginInvalid.itg;
+constexpr uint32_t gDataOriginIntTPC     = gDataOriginTPC.itg;
+constexpr uint32_t gDataOriginIntTRD     = gDataOriginTRD.itg;
+constexpr uint32_t gDataOriginIntTOF     = gDataOriginTOF.itg;
+
+constexpr uint64_t gDataDescriptionIntAny      = gDataDescriptionAny.itg[0];
+constexpr uint64_t gDataDescriptionIntInvalid  = gDataDescriptionInvalid.itg[0];
+constexpr uint64_t gDataDescriptionIntRawData  = gDataDescriptionRawData.itg[0];
+constexpr uint64_t gDataDescriptionIntClusters = gDataDescriptionClusters.itg[0];
+constexpr uint64_t gDataDescriptionIntTracks   = gDataDescriptionTracks.itg[0];
+constexpr uint64_t gDataDescriptionIntConfig   = gDataDescriptionConfig.itg[0];
+constexpr uint64_t gDataDescriptionIntInfo     = gDataDescriptionInfo.itg[0];
 /// @} // end of doxygen group
 
 //__________________________________________________________________________________________________
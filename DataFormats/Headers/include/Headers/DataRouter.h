@@ -0,0 +1,152 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @file DataRouter.h
+/// @brief Constant-time routing of messages by their DataHeader
+///
+/// Devices that fan out messages by type typically walk a list of known
+/// (origin, description) pairs and compare descriptors one by one. The
+/// DataRouter replaces the linear walk with a single hash lookup over the
+/// integer representation of the descriptors, so the routing cost stays
+/// constant as the number of registered routes grows.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+
+#ifndef ALICEO2_HEADER_DATAROUTER_H
+#define ALICEO2_HEADER_DATAROUTER_H
+
+#include "Headers/DataHeader.h"
+#include <unordered_map>
+
+namespace AliceO2 {
+namespace Header {
+
+//__________________________________________________________________________________________________
+/// @struct DataRouteKey
+/// @brief Integer key identifying a (origin, description, subSpecification) triple
+///
+/// The key is built from the integer representation of the descriptors, so
+/// comparison and hashing are plain integer operations without any character
+/// handling. Comparing two keys touches four machine words laid out
+/// contiguously, which the compiler can combine or vectorize.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+struct DataRouteKey
+{
+  uint64_t descriptionInt0;
+  uint64_t descriptionInt1;
+  uint64_t subSpecification;
+  uint64_t originInt;
+
+  DataRouteKey(const DataOrigin& origin, const DataDescription& description,
+               uint64_t subSpec)
+    : descriptionInt0(description.itg[0])
+    , descriptionInt1(description.itg[1])
+    , subSpecification(subSpec)
+    , originInt(origin.itg)
+  {
+  }
+
+  DataRouteKey(const DataHeader& header)
+    : DataRouteKey(header.dataOrigin, header.dataDescription, header.subSpecification)
+  {
+  }
+
+  bool operator==(const DataRouteKey& other) const
+  {
+    return descriptionInt0 == other.descriptionInt0
+      && descriptionInt1 == other.descriptionInt1
+      && subSpecification == other.subSpecification
+      && originInt == other.originInt;
+  }
+};
+
+//__________________________________________________________________________________________________
+/// hash over the four words of a DataRouteKey, combined in the usual
+/// boost::hash_combine manner
+struct DataRouteKeyHash
+{
+  size_t operator()(const DataRouteKey& key) const
+  {
+    size_t seed = std::hash<uint64_t>()(key.descriptionInt0);
+    combine(seed, key.descriptionInt1);
+    combine(seed, key.subSpecification);
+    combine(seed, key.originInt);
+    return seed;
+  }
+
+private:
+  static void combine(size_t& seed, uint64_t value)
+  {
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+};
+
+//__________________________________________________________________________________________________
+/// @class DataRouter
+/// @brief Match table from (origin, description, subSpecification) to a route value
+///
+/// RouteT is whatever the device routes by: a channel index, a channel name,
+/// a handler. Routes are registered once during setup with addRoute, either
+/// for a specific sub specification or for SubSpecificationAny to match the
+/// triple regardless of the sub specification. findRoute performs at most two
+/// hash lookups (exact triple first, then the any-subSpec entry) independent
+/// of the number of registered routes.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+template <typename RouteT>
+class DataRouter
+{
+public:
+  /// sub specification wildcard for addRoute; a real sub specification of this
+  /// value can not be routed by wildcard entries
+  static const uint64_t SubSpecificationAny = ~uint64_t(0);
+
+  /// register a route for the triple, overwriting a previous registration
+  void addRoute(const DataOrigin& origin, const DataDescription& description,
+                uint64_t subSpecification, RouteT route)
+  {
+    mRoutes[DataRouteKey(origin, description, subSpecification)] = route;
+  }
+
+  /// register a route matching any sub specification of (origin, description)
+  void addRoute(const DataOrigin& origin, const DataDescription& description,
+                RouteT route)
+  {
+    addRoute(origin, description, SubSpecificationAny, route);
+  }
+
+  /// look up the route for a header, nullptr if nothing matches; an exact
+  /// triple match takes precedence over an any-subSpec entry
+  const RouteT* findRoute(const DataHeader& header) const
+  {
+    auto route = mRoutes.find(DataRouteKey(header));
+    if (route == mRoutes.end()) {
+      route = mRoutes.find(DataRouteKey(header.dataOrigin, header.dataDescription,
+                                        SubSpecificationAny));
+      if (route == mRoutes.end()) return nullptr;
+    }
+    return &(route->second);
+  }
+
+  size_t getNRoutes() const { return mRoutes.size(); }
+
+  void clear() { mRoutes.clear(); }
+
+private:
+  std::unordered_map<DataRouteKey, RouteT, DataRouteKeyHash> mRoutes;
+};
+
+} //namespace Header
+} //namespace AliceO2
+
+#endif
@@ -0,0 +1,148 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @file TelemetryAnalyzer.h
+/// @brief Per-hop latency and queue statistics from TelemetryHeader stacks
+///
+/// Each forwarding device of a chain stamps a TelemetryHeader into the
+/// header stack of the messages it sends on. The analyzer runs at (or after)
+/// the end of the chain: it walks the received stacks, accumulates queue
+/// occupancy per hop and the latency between consecutive hops, and reports
+/// which stage of the chain queues up or delays. The timestamps are steady
+/// clock values, so the hop latencies are only meaningful between devices
+/// running on the same host; queue occupancies are always meaningful.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+
+#ifndef ALICEO2_HEADER_TELEMETRYANALYZER_H
+#define ALICEO2_HEADER_TELEMETRYANALYZER_H
+
+#include "Headers/DataHeader.h"
+#include <cstdio>
+#include <vector>
+
+namespace AliceO2 {
+namespace Header {
+
+//__________________________________________________________________________________________________
+/// @class TelemetryAnalyzer
+/// @brief Accumulates TelemetryHeader stamps per hop position in the chain
+///
+/// Hops are identified by their position in the stack (the first stamping
+/// device is hop 0), so the devices do not need globally unique indices;
+/// the device index of the last message is kept per hop for the report.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+class TelemetryAnalyzer
+{
+public:
+  /// accumulated statistics of one hop position
+  struct HopStats
+  {
+    uint64_t messages = 0; ///< stamped messages seen at this hop
+    uint64_t occupancySum = 0; ///< sum of the send-queue occupancies
+    uint32_t occupancyMax = 0; ///< largest send-queue occupancy seen
+    uint32_t queueCapacity = 0; ///< capacity of the send queue (last message)
+    uint64_t latencySumUs = 0; ///< sum of the latencies from the previous hop
+    uint64_t latencyMaxUs = 0; ///< largest latency from the previous hop
+    uint32_t deviceIndex = 0; ///< device index of the last message
+  };
+
+  /// walks the header stack of a received message and accumulates every
+  /// TelemetryHeader found; stacks without telemetry are counted separately
+  void addStack(const byte* buffer, size_t bufferSize)
+  {
+    if (buffer == nullptr || bufferSize < sizeof(BaseHeader)) {
+      ++mStacksWithout;
+      return;
+    }
+    size_t hop = 0;
+    uint64_t previousStampUs = 0;
+    for (const BaseHeader* current = BaseHeader::get(buffer); current != nullptr;
+         current = current->next()) {
+      if (!(current->description == TelemetryHeader::sHeaderType)) {
+        continue;
+      }
+      const TelemetryHeader& telemetry = *reinterpret_cast<const TelemetryHeader*>(current);
+      if (hop >= mHops.size()) {
+        mHops.resize(hop + 1);
+      }
+      HopStats& stats = mHops[hop];
+      ++stats.messages;
+      stats.occupancySum += telemetry.queueOccupancy;
+      if (telemetry.queueOccupancy > stats.occupancyMax) {
+        stats.occupancyMax = telemetry.queueOccupancy;
+      }
+      stats.queueCapacity = telemetry.queueCapacity;
+      stats.deviceIndex = telemetry.deviceIndex;
+      if (hop > 0 && telemetry.timestampUs >= previousStampUs) {
+        uint64_t latency = telemetry.timestampUs - previousStampUs;
+        stats.latencySumUs += latency;
+        if (latency > stats.latencyMaxUs) {
+          stats.latencyMaxUs = latency;
+        }
+      }
+      previousStampUs = telemetry.timestampUs;
+      ++hop;
+    }
+    if (hop == 0) {
+      ++mStacksWithout;
+    }
+  }
+
+  /// number of hop positions seen so far
+  size_t getNHops() const { return mHops.size(); }
+
+  /// statistics of one hop position, the first stamping device is hop 0
+  const HopStats& getHop(size_t hop) const { return mHops.at(hop); }
+
+  /// stacks without any telemetry header
+  uint64_t getStacksWithoutTelemetry() const { return mStacksWithout; }
+
+  void clear()
+  {
+    mHops.clear();
+    mStacksWithout = 0;
+  }
+
+  /// report mean/max queue occupancy and latency per hop
+  void print() const
+  {
+    printf("telemetry report, %zu hops:\n", mHops.size());
+    for (size_t hop = 0; hop < mHops.size(); ++hop) {
+      const HopStats& stats = mHops[hop];
+      if (stats.messages == 0) continue;
+      printf("  hop %zu (device %u): %llu messages, queue mean %.1f max %u of %u",
+             hop, stats.deviceIndex, (long long unsigned int)stats.messages,
+             static_cast<double>(stats.occupancySum) / stats.messages,
+             stats.occupancyMax, stats.queueCapacity);
+      if (hop > 0) {
+        printf(", latency mean %.1f us max %llu us",
+               static_cast<double>(stats.latencySumUs) / stats.messages,
+               (long long unsigned int)stats.latencyMaxUs);
+      }
+      printf("\n");
+    }
+    if (mStacksWithout > 0) {
+      printf("  %llu stacks without telemetry\n", (long long unsigned int)mStacksWithout);
+    }
+  }
+
+private:
+  std::vector<HopStats> mHops;
+  uint64_t mStacksWithout = 0;
+};
+
+} //namespace Header
+} //namespace AliceO2
+
+#endif
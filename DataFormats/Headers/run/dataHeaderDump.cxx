@@ -0,0 +1,84 @@
+/// \file dataHeaderDump.cxx
+/// \brief Offline dump of a serialized O2 header stack
+///
+/// Reads a raw header stack from a file (or stdin with "-"), validates it with
+/// validateStack and prints each header in human readable form. Unknown header
+/// types are shown as a hex dump. This tool carries all the formatted I/O so
+/// that the validation entry point itself can stay free of it.
+
+#include "Headers/DataHeader.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace AliceO2::Header;
+
+namespace {
+  const char* errorName(StackValidationError error)
+  {
+    switch (error) {
+    case StackValidationError::kValid:           return "valid";
+    case StackValidationError::kEmpty:           return "empty buffer";
+    case StackValidationError::kTruncatedBase:   return "truncated base header";
+    case StackValidationError::kBadMagic:        return "bad magic string";
+    case StackValidationError::kBadHeaderSize:   return "header size below base header size";
+    case StackValidationError::kTruncatedHeader: return "header extends past end of buffer";
+    }
+    return "unknown error";
+  }
+
+  std::vector<byte> readInput(const char* fileName)
+  {
+    std::vector<byte> buffer;
+    FILE* input = stdin;
+    if (fileName[0] != '-' || fileName[1] != 0) {
+      input = fopen(fileName, "rb");
+      if (input == NULL) {
+        fprintf(stderr, "error: can not open input file %s\n", fileName);
+        return buffer;
+      }
+    }
+    byte chunk[4096];
+    size_t read = 0;
+    while ((read = fread(chunk, 1, sizeof(chunk), input)) > 0) {
+      buffer.insert(buffer.end(), chunk, chunk+read);
+    }
+    if (input != stdin) fclose(input);
+    return buffer;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <file with serialized header stack, '-' for stdin>\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<byte> buffer = readInput(argv[1]);
+  StackValidationError error = validateStack(buffer.data(), buffer.size());
+  printf("stack of %zu bytes: %s\n", buffer.size(), errorName(error));
+  if (error != StackValidationError::kValid) {
+    // show the raw bytes to help locating the inconsistency
+    hexDump("raw buffer", buffer.data(), buffer.size());
+    return 1;
+  }
+
+  int position = 0;
+  for (const BaseHeader* current = BaseHeader::get(buffer.data());
+       current != nullptr;
+       current = current->next(), position++) {
+    printf("header %i at offset %zu:\n", position,
+           (size_t)(current->data()-buffer.data()));
+    if (const DataHeader* dataHeader = DataHeader::Get(current)) {
+      dataHeader->print();
+    } else {
+      printf("  type         : %.8s\n", current->description.str);
+      printf("  serialization: %.8s\n", current->serialization.str);
+      printf("  header size  : %i\n", current->headerSize);
+      hexDump("  contents", current->data(), current->size());
+    }
+  }
+  return 0;
+}
@@ -11,6 +11,7 @@
 /// or submit itself to any jurisdiction.
 
 #include "Headers/DataHeader.h"
+#include <chrono> // TelemetryHeader timestamps
 #include <cstdio> // printf
 #include <cstring> // strncpy
 
@@ -24,22 +25,7 @@ const AliceO2::Header::SerializationMethod AliceO2::Header::gSerializationMethod
 const AliceO2::Header::SerializationMethod AliceO2::Header::gSerializationMethodROOT   ("ROOT   ");
 const AliceO2::Header::SerializationMethod AliceO2::Header::gSerializationMethodFlatBuf("FLATBUF");
 
-//__________________________________________________________________________________________________
-//possible data origins
-const AliceO2::Header::DataOrigin AliceO2::Header::gDataOriginAny    ("***");
-const AliceO2::Header::DataOrigin AliceO2::Header::gDataOriginInvalid("   ");
-const AliceO2::Header::DataOrigin AliceO2::Header::gDataOriginTPC    ("TPC");
-const AliceO2::Header::DataOrigin AliceO2::Header::gDataOriginTRD    ("TRD");
-const AliceO2::Header::DataOrigin AliceO2::Header::gDataOriginTOF    ("TOF");
-
-//possible data types
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionAny     ("***************");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionInvalid ("               ");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionRawData ("RAWDATA        ");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionClusters("CLUSTERS       ");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionTracks  ("TRACKS         ");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionConfig  ("CONFIG         ");
-const AliceO2::Header::DataDescription AliceO2::Header::gDataDescriptionInfo    ("INFO           ");
+//data origins and data descriptions are constexpr and defined in the header
 
 //definitions for Block statics
 std::default_delete<byte[]> AliceO2::Header::Block::sDeleter;
@@ -58,6 +44,11 @@ const AliceO2::Header::SerializationMethod AliceO2::Header::DataHeader::sSeriali
 template <>
 const AliceO2::Header::HeaderType AliceO2::Header::NameHeader<0>::sHeaderType = "NameHead";
 
+//storage for TelemetryHeader static members
+const uint32_t AliceO2::Header::TelemetryHeader::sVersion = 1;
+const AliceO2::Header::HeaderType AliceO2::Header::TelemetryHeader::sHeaderType = String2<uint64_t>("Telemtry");
+const AliceO2::Header::SerializationMethod AliceO2::Header::TelemetryHeader::sSerializationMethod = AliceO2::Header::gSerializationMethodNone;
+
 using namespace AliceO2::Header;
 
 //__________________________________________________________________________________________________
@@ -175,6 +166,64 @@ bool AliceO2::Header::DataHeader::operator==(const DataHeader& that) const
           subSpecification == that.subSpecification );
 }
 
+//__________________________________________________________________________________________________
+AliceO2::Header::StackValidationError AliceO2::Header::validateStack(const byte* buffer,
+                                                                     size_t bufferSize) noexcept
+{
+  if (buffer==nullptr || bufferSize==0) return StackValidationError::kEmpty;
+
+  size_t position = 0;
+  while (true) {
+    if (bufferSize-position < sizeof(BaseHeader)) return StackValidationError::kTruncatedBase;
+    const BaseHeader* current = reinterpret_cast<const BaseHeader*>(buffer+position);
+    if (current->magicStringInt != BaseHeader::sMagicString) return StackValidationError::kBadMagic;
+    if (current->headerSize < sizeof(BaseHeader)) return StackValidationError::kBadHeaderSize;
+    if (current->headerSize > bufferSize-position) return StackValidationError::kTruncatedHeader;
+    if (!current->flagsNextHeader) break;
+    position += current->headerSize;
+  }
+  return StackValidationError::kValid;
+}
+
+//__________________________________________________________________________________________________
+AliceO2::Header::TelemetryHeader::TelemetryHeader()
+  : BaseHeader(sizeof(TelemetryHeader), sHeaderType, sSerializationMethod, sVersion)
+  , deviceIndex(0)
+  , queueOccupancy(0)
+  , queueCapacity(0)
+  , reserved(0)
+  , timestampUs(0)
+{
+}
+
+//__________________________________________________________________________________________________
+AliceO2::Header::TelemetryHeader::TelemetryHeader(uint32_t device, uint32_t occupancy,
+                                                  uint32_t capacity)
+  : BaseHeader(sizeof(TelemetryHeader), sHeaderType, sSerializationMethod, sVersion)
+  , deviceIndex(device)
+  , queueOccupancy(occupancy)
+  , queueCapacity(capacity)
+  , reserved(0)
+  , timestampUs(nowUs())
+{
+}
+
+//__________________________________________________________________________________________________
+uint64_t AliceO2::Header::TelemetryHeader::nowUs()
+{
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+//__________________________________________________________________________________________________
+void AliceO2::Header::TelemetryHeader::print() const
+{
+  printf("Telemetry header version %i\n", headerVersion);
+  printf("  device index : %u\n", deviceIndex);
+  printf("  queue        : %u/%u\n", queueOccupancy, queueCapacity);
+  printf("  timestamp    : %llu us\n", (long long unsigned int)timestampUs);
+}
+
 //__________________________________________________________________________________________________
 void AliceO2::Header::printDataOrigin::operator()(const char* str) const
 {
@@ -22,6 +22,43 @@ namespace AliceO2 {
 
       BOOST_CHECK(desc2 == "ITSRAW");
     }
-  } 
+
+    BOOST_AUTO_TEST_CASE(validateStack_test)
+    {
+      DataHeader dh;
+      NameHeader<16> nh("somename");
+      Block block{dh, nh};
+
+      BOOST_CHECK(validateStack(block.data(), block.size())
+                  == StackValidationError::kValid);
+
+      // null and empty buffers
+      BOOST_CHECK(validateStack(nullptr, block.size())
+                  == StackValidationError::kEmpty);
+      BOOST_CHECK(validateStack(block.data(), 0)
+                  == StackValidationError::kEmpty);
+
+      // buffer cut inside the first header
+      BOOST_CHECK(validateStack(block.data(), sizeof(BaseHeader)-1)
+                  == StackValidationError::kTruncatedBase);
+      BOOST_CHECK(validateStack(block.data(), sizeof(DataHeader)-1)
+                  == StackValidationError::kTruncatedHeader);
+
+      // buffer cut inside the chained header
+      BOOST_CHECK(validateStack(block.data(), block.size()-1)
+                  == StackValidationError::kTruncatedHeader);
+
+      // corrupted magic string of the chained header
+      block.data()[sizeof(DataHeader)] ^= 0xff;
+      BOOST_CHECK(validateStack(block.data(), block.size())
+                  == StackValidationError::kBadMagic);
+      block.data()[sizeof(DataHeader)] ^= 0xff;
+
+      // corrupted header size
+      reinterpret_cast<BaseHeader*>(block.data())->headerSize = sizeof(BaseHeader)-1;
+      BOOST_CHECK(validateStack(block.data(), block.size())
+                  == StackValidationError::kBadHeaderSize);
+    }
+  }
 }
 
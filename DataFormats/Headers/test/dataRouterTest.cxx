@@ -0,0 +1,49 @@
+#define BOOST_TEST_MODULE Test Headers DataRouterTest
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Headers/DataRouter.h"
+
+namespace AliceO2 {
+  namespace Header {
+
+    BOOST_AUTO_TEST_CASE(DataRouter_test)
+    {
+      DataRouter<int> router;
+      router.addRoute(DataOrigin("TPC"), DataDescription("CLUSTERS"), 0, 1);
+      router.addRoute(DataOrigin("TPC"), DataDescription("CLUSTERS"), 1, 2);
+      router.addRoute(DataOrigin("ITS"), DataDescription("RAWDATA"), 3);
+
+      DataHeader header;
+      header.dataOrigin = DataOrigin("TPC");
+      header.dataDescription = DataDescription("CLUSTERS");
+      header.subSpecification = 0;
+
+      const int* route = router.findRoute(header);
+      BOOST_REQUIRE(route != nullptr);
+      BOOST_CHECK(*route == 1);
+
+      // exact sub specification match
+      header.subSpecification = 1;
+      route = router.findRoute(header);
+      BOOST_REQUIRE(route != nullptr);
+      BOOST_CHECK(*route == 2);
+
+      // no wildcard registered for TPC/CLUSTERS
+      header.subSpecification = 2;
+      BOOST_CHECK(router.findRoute(header) == nullptr);
+
+      // wildcard entry matches any sub specification
+      header.dataOrigin = DataOrigin("ITS");
+      header.dataDescription = DataDescription("RAWDATA");
+      header.subSpecification = 42;
+      route = router.findRoute(header);
+      BOOST_REQUIRE(route != nullptr);
+      BOOST_CHECK(*route == 3);
+
+      // unregistered triple
+      header.dataDescription = DataDescription("TRACKS");
+      BOOST_CHECK(router.findRoute(header) == nullptr);
+    }
+  }
+}
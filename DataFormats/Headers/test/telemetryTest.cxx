@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Test Headers TelemetryTest
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Headers/DataHeader.h"
+#include "Headers/TelemetryAnalyzer.h"
+
+namespace AliceO2 {
+  namespace Header {
+
+    static TelemetryHeader makeStamp(uint32_t device, uint32_t occupancy,
+                                     uint32_t capacity, uint64_t timestampUs)
+    {
+      // fixed timestamps instead of the stamping constructor, so the
+      // latencies below are deterministic
+      TelemetryHeader stamp(device, occupancy, capacity);
+      stamp.timestampUs = timestampUs;
+      return stamp;
+    }
+
+    BOOST_AUTO_TEST_CASE(TelemetryHeader_test)
+    {
+      TelemetryHeader stamp(7, 12, 256);
+      BOOST_CHECK(stamp.deviceIndex == 7);
+      BOOST_CHECK(stamp.queueOccupancy == 12);
+      BOOST_CHECK(stamp.queueCapacity == 256);
+      BOOST_CHECK(stamp.timestampUs > 0);
+
+      // the stamp must be locatable in a composed stack
+      DataHeader dh;
+      Block block{dh, stamp};
+      BOOST_CHECK(validateStack(block.data(), block.size())
+                  == StackValidationError::kValid);
+      const TelemetryHeader* found = get<TelemetryHeader>(block.data());
+      BOOST_REQUIRE(found != nullptr);
+      BOOST_CHECK(found->deviceIndex == 7);
+      BOOST_CHECK(found->queueOccupancy == 12);
+    }
+
+    BOOST_AUTO_TEST_CASE(TelemetryAnalyzer_test)
+    {
+      TelemetryAnalyzer analyzer;
+
+      // two-hop chain: the first device queued at occupancy 10 and 20,
+      // the second 100 us resp. 300 us later at occupancy 3 and 5
+      DataHeader dh;
+      Block first{dh, makeStamp(0, 10, 256, 1000), makeStamp(1, 3, 64, 1100)};
+      Block second{dh, makeStamp(0, 20, 256, 2000), makeStamp(1, 5, 64, 2300)};
+      analyzer.addStack(first.data(), first.size());
+      analyzer.addStack(second.data(), second.size());
+
+      // a stack without telemetry is counted, not attributed to a hop
+      Block plain{dh};
+      analyzer.addStack(plain.data(), plain.size());
+
+      BOOST_REQUIRE(analyzer.getNHops() == 2);
+      BOOST_CHECK(analyzer.getStacksWithoutTelemetry() == 1);
+
+      const TelemetryAnalyzer::HopStats& hop0 = analyzer.getHop(0);
+      BOOST_CHECK(hop0.messages == 2);
+      BOOST_CHECK(hop0.occupancySum == 30);
+      BOOST_CHECK(hop0.occupancyMax == 20);
+      BOOST_CHECK(hop0.queueCapacity == 256);
+      BOOST_CHECK(hop0.latencySumUs == 0);
+
+      const TelemetryAnalyzer::HopStats& hop1 = analyzer.getHop(1);
+      BOOST_CHECK(hop1.messages == 2);
+      BOOST_CHECK(hop1.occupancySum == 8);
+      BOOST_CHECK(hop1.occupancyMax == 5);
+      BOOST_CHECK(hop1.deviceIndex == 1);
+      BOOST_CHECK(hop1.latencySumUs == 400);
+      BOOST_CHECK(hop1.latencyMaxUs == 300);
+
+      analyzer.clear();
+      BOOST_CHECK(analyzer.getNHops() == 0);
+      BOOST_CHECK(analyzer.getStacksWithoutTelemetry() == 0);
+    }
+  }
+}
@@ -115,6 +115,12 @@ class MCTrack : public TObject
     /// Accessors to the number of MCPoints in the detectors
     Int_t getNumberOfPoints(DetectorId detId) const;
 
+    /// Raw packed point-count bitvector (see mNumberOfPoints)
+    Int_t getNumberOfPoints() const
+    {
+      return mNumberOfPoints;
+    }
+
     ///  Modifiers
     void SetMotherTrackId(Int_t id)
     {
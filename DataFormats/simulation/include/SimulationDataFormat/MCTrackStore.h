@@ -0,0 +1,132 @@
+/// \file MCTrackStore.h
+/// \brief Definition of the MCTrackStore class
+
+#ifndef ALICEO2_DATA_MCTRACKSTORE_H_
+#define ALICEO2_DATA_MCTRACKSTORE_H_
+
+#include <vector>
+
+#include "TObject.h"
+#include "Rtypes.h"
+
+#include "SimulationDataFormat/MCTrack.h"
+
+/// Columnar storage for Monte Carlo tracks. Instead of streaming one
+/// MCTrack object per track, the track quantities are kept as one vector
+/// per column (momentum components, PDG code, mother index, start vertex,
+/// point counts), so a job that touches only the kinematics reads only
+/// those columns and deserializes no TObjects. MCTrack-compatible views
+/// are constructed on demand with getTrack(); the energy is derived from
+/// the PDG mass exactly as MCTrack does, so no energy column is stored.
+class MCTrackStore : public TObject
+{
+
+  public:
+    ///  Default constructor
+    MCTrackStore();
+
+    ///  Destructor
+    virtual ~MCTrackStore();
+
+    /// Append a track to the columns
+    void addTrack(Int_t pdgCode, Int_t motherTrackId, Double_t px, Double_t py, Double_t pz, Double_t x, Double_t y,
+                  Double_t z, Double_t t, Int_t nPoints);
+
+    /// Append a copy of an existing MCTrack
+    void addTrack(const MCTrack &track);
+
+    /// Number of stored tracks
+    Int_t getNumberOfTracks() const
+    {
+      return (Int_t) mPdgCode.size();
+    }
+
+    /// Construct an MCTrack-compatible view of the i-th track
+    MCTrack getTrack(Int_t i) const;
+
+    /// Scalar accessors
+    Int_t getPdgCode(Int_t i) const
+    {
+      return mPdgCode[i];
+    }
+
+    Int_t getMotherTrackId(Int_t i) const
+    {
+      return mMotherTrackId[i];
+    }
+
+    /// Column accessors
+    const std::vector<Int_t> &getPdgCodes() const
+    {
+      return mPdgCode;
+    }
+
+    const std::vector<Int_t> &getMotherTrackIds() const
+    {
+      return mMotherTrackId;
+    }
+
+    const std::vector<Double_t> &getStartVertexMomentumX() const
+    {
+      return mStartVertexMomentumX;
+    }
+
+    const std::vector<Double_t> &getStartVertexMomentumY() const
+    {
+      return mStartVertexMomentumY;
+    }
+
+    const std::vector<Double_t> &getStartVertexMomentumZ() const
+    {
+      return mStartVertexMomentumZ;
+    }
+
+    const std::vector<Double_t> &getStartVertexCoordinatesX() const
+    {
+      return mStartVertexCoordinatesX;
+    }
+
+    const std::vector<Double_t> &getStartVertexCoordinatesY() const
+    {
+      return mStartVertexCoordinatesY;
+    }
+
+    const std::vector<Double_t> &getStartVertexCoordinatesZ() const
+    {
+      return mStartVertexCoordinatesZ;
+    }
+
+    const std::vector<Double_t> &getStartVertexCoordinatesT() const
+    {
+      return mStartVertexCoordinatesT;
+    }
+
+    const std::vector<Int_t> &getNumbersOfPoints() const
+    {
+      return mNumberOfPoints;
+    }
+
+    /// Drop all stored tracks
+    void clear();
+
+  private:
+    ///  PDG particle codes
+    std::vector<Int_t> mPdgCode;
+
+    ///  Indices of mother tracks, -1 for primary particles
+    std::vector<Int_t> mMotherTrackId;
+
+    /// Momentum components at start vertex [GeV]
+    std::vector<Double_t> mStartVertexMomentumX, mStartVertexMomentumY, mStartVertexMomentumZ;
+
+    /// Coordinates of start vertex [cm, ns]
+    std::vector<Double_t> mStartVertexCoordinatesX, mStartVertexCoordinatesY, mStartVertexCoordinatesZ,
+      mStartVertexCoordinatesT;
+
+    /// Per detector point counts, packed as in MCTrack
+    std::vector<Int_t> mNumberOfPoints;
+
+  ClassDef(MCTrackStore, 1);
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include "TMCProcess.h"
 
 #include <map>
+#include <set>
 #include <stack>
 #include <utility>
 
@@ -76,6 +77,30 @@ class Stack : public FairGenericStack
                            Double_t poly,
                            Double_t polz, TMCProcess proc, Int_t &ntr, Double_t weight, Int_t is, Int_t secondParentId);
 
+    /// One particle in the bulk transfer format. Plain data, so a generator
+    /// can assemble a whole event in a flat array before handing it over
+    struct ParticleRecord
+    {
+      Int_t pdgCode;        ///< particle type (PDG encoding)
+      Int_t parentId;       ///< index of mother particle, -1 for primaries
+      Double_t px, py, pz;  ///< momentum components at start vertex [GeV]
+      Double_t e;           ///< total energy at start vertex [GeV]
+      Double_t vx, vy, vz;  ///< coordinates of start vertex [cm]
+      Double_t time;        ///< start time of track [s]
+      Double_t weight;      ///< particle weight
+      Bool_t toBeDone;      ///< flag for tracking
+    };
+
+    /// Bulk transfer of a whole generated event. The TParticle array is
+    /// grown once to its final size and the records are materialized in
+    /// place, avoiding the per-particle virtual PushTrack call and the
+    /// stepwise TClonesArray growth. The in-line push filter is applied as
+    /// in PushTrack; the production mechanism is kPPrimary for all records
+    /// \param records Block of particles to push
+    /// \param numberOfRecords Number of particles in the block
+    /// \return Track number of the first pushed particle, -1 if none
+    Int_t PushTracks(const ParticleRecord *records, Int_t numberOfRecords);
+
     /// Get next particle for tracking from the stack.
     /// Declared in TVirtualMCStack
     /// Returns a pointer to the TParticle of the track
@@ -166,6 +191,43 @@ class Stack : public FairGenericStack
       mStoreMothers = choice;
     }
 
+    /// Enable the in-line filter: secondaries failing the push criteria
+    /// (kinetic energy cut, production region, discarded PDG set) are
+    /// dropped at PushTrack time, before a TParticle is materialized, and
+    /// are not tracked. Since they never get a stack slot, the track
+    /// numbering stays dense and no remapping pass is needed for them.
+    /// The end-of-event selection (minimal points etc.) is unchanged
+    void EnablePushFilter(Bool_t choice = kTRUE)
+    {
+      mPushFilterEnabled = choice;
+    }
+
+    /// Minimal kinetic energy for secondaries at push time [GeV]
+    void SetPushEnergyCut(Double_t eMin)
+    {
+      mPushEnergyCut = eMin;
+    }
+
+    /// Production region for secondaries at push time; secondaries produced
+    /// outside the cylinder (rMax, zMax) [cm] are dropped (0 = no cut)
+    void SetPushRegion(Double_t rMax, Double_t zMax)
+    {
+      mPushRegionRmax = rMax;
+      mPushRegionZmax = zMax;
+    }
+
+    /// Add a PDG code to the set of particle types dropped at push time
+    void AddPushDiscardPdg(Int_t pdg)
+    {
+      mPushDiscardPdg.insert(pdg);
+    }
+
+    /// Number of secondaries dropped by the in-line filter in this event
+    Int_t GetNumberOfDiscardedParticles() const
+    {
+      return mNumberOfDiscardedParticles;
+    }
+
     /// Increment number of points for the current track in a given detector
     /// \param iDet  Detector unique identifier
 
@@ -224,6 +286,26 @@ class Stack : public FairGenericStack
     Int_t mMinPoints;
     Double32_t mEnergyCut;
 
+    /// Variables defining the in-line filter applied at PushTrack time
+    Bool_t mPushFilterEnabled;           //! filter off by default
+    Double32_t mPushEnergyCut;           //! minimal kinetic energy at push time
+    Double32_t mPushRegionRmax;          //! production region radius, 0 = no cut
+    Double32_t mPushRegionZmax;          //! production region half length, 0 = no cut
+    std::set<Int_t> mPushDiscardPdg;     //! PDG codes dropped at push time
+    Int_t mNumberOfDiscardedParticles;   //! secondaries dropped in this event
+
+    Int_t mMemoryScopeId; //! accounting scope of the stack, see accountMemory
+
+    /// Evaluate the push criteria for a secondary; returns kTRUE if it
+    /// is to be kept
+    Bool_t selectAtPush(Int_t pdgCode, Double_t px, Double_t py, Double_t pz, Double_t e, Double_t vx, Double_t vy,
+                        Double_t vz) const;
+
+    /// Report the stack footprint (particle and track array slots plus the
+    /// bookkeeping maps) to the memory accountant; no-op unless accounting
+    /// is enabled, see MemoryAccountant
+    void accountMemory();
+
     /// Mark tracks for output using selection criteria
     void SelectTracks();
 
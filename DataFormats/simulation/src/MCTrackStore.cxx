@@ -0,0 +1,69 @@
+/// \file MCTrackStore.cxx
+/// \brief Implementation of the MCTrackStore class
+
+#include "SimulationDataFormat/MCTrackStore.h"
+
+MCTrackStore::MCTrackStore()
+  : TObject(),
+    mPdgCode(),
+    mMotherTrackId(),
+    mStartVertexMomentumX(),
+    mStartVertexMomentumY(),
+    mStartVertexMomentumZ(),
+    mStartVertexCoordinatesX(),
+    mStartVertexCoordinatesY(),
+    mStartVertexCoordinatesZ(),
+    mStartVertexCoordinatesT(),
+    mNumberOfPoints()
+{
+}
+
+MCTrackStore::~MCTrackStore()
+{
+}
+
+void MCTrackStore::addTrack(Int_t pdgCode, Int_t motherTrackId, Double_t px, Double_t py, Double_t pz, Double_t x,
+                            Double_t y, Double_t z, Double_t t, Int_t nPoints)
+{
+  mPdgCode.push_back(pdgCode);
+  mMotherTrackId.push_back(motherTrackId);
+  mStartVertexMomentumX.push_back(px);
+  mStartVertexMomentumY.push_back(py);
+  mStartVertexMomentumZ.push_back(pz);
+  mStartVertexCoordinatesX.push_back(x);
+  mStartVertexCoordinatesY.push_back(y);
+  mStartVertexCoordinatesZ.push_back(z);
+  mStartVertexCoordinatesT.push_back(t);
+  mNumberOfPoints.push_back(nPoints);
+}
+
+void MCTrackStore::addTrack(const MCTrack &track)
+{
+  addTrack(track.GetPdgCode(), track.getMotherTrackId(), track.GetStartVertexMomentumX(),
+           track.GetStartVertexMomentumY(), track.GetStartVertexMomentumZ(), track.GetStartVertexCoordinatesX(),
+           track.GetStartVertexCoordinatesY(), track.GetStartVertexCoordinatesZ(), track.GetStartVertexCoordinatesT(),
+           track.getNumberOfPoints());
+}
+
+MCTrack MCTrackStore::getTrack(Int_t i) const
+{
+  return MCTrack(mPdgCode[i], mMotherTrackId[i], mStartVertexMomentumX[i], mStartVertexMomentumY[i],
+                 mStartVertexMomentumZ[i], mStartVertexCoordinatesX[i], mStartVertexCoordinatesY[i],
+                 mStartVertexCoordinatesZ[i], mStartVertexCoordinatesT[i], mNumberOfPoints[i]);
+}
+
+void MCTrackStore::clear()
+{
+  mPdgCode.clear();
+  mMotherTrackId.clear();
+  mStartVertexMomentumX.clear();
+  mStartVertexMomentumY.clear();
+  mStartVertexMomentumZ.clear();
+  mStartVertexCoordinatesX.clear();
+  mStartVertexCoordinatesY.clear();
+  mStartVertexCoordinatesZ.clear();
+  mStartVertexCoordinatesT.clear();
+  mNumberOfPoints.clear();
+}
+
+ClassImp(MCTrackStore)
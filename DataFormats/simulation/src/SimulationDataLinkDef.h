@@ -14,5 +14,6 @@
 
 #pragma link C++ class AliceO2::Data::Stack+;
 #pragma link C++ class MCTrack+;
+#pragma link C++ class MCTrackStore+;
 
 #endif
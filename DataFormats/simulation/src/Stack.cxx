@@ -5,6 +5,8 @@
 #include "include/SimulationDataFormat/Stack.h"
 #include "include/SimulationDataFormat/MCTrack.h"
 
+#include "MemoryArena/MemoryAccountant.h"
+
 #include "FairDetector.h"     // for FairDetector
 #include "FairLogger.h"       // for MESSAGE_ORIGIN, FairLogger
 #include "FairMCPoint.h"      // for FairMCPoint
@@ -13,6 +15,7 @@
 #include "TClonesArray.h"     // for TClonesArray
 #include "TIterator.h"        // for TIterator
 #include "TLorentzVector.h"   // for TLorentzVector
+#include "TMath.h"            // for Sqrt, Abs
 #include "TParticle.h"        // for TParticle
 #include "TRefArray.h"        // for TRefArray
 
@@ -42,6 +45,13 @@ Stack::Stack(Int_t size)
     mStoreSecondaries(kTRUE),
     mMinPoints(1),
     mEnergyCut(0.),
+    mPushFilterEnabled(kFALSE),
+    mPushEnergyCut(0.),
+    mPushRegionRmax(0.),
+    mPushRegionZmax(0.),
+    mPushDiscardPdg(),
+    mNumberOfDiscardedParticles(0),
+    mMemoryScopeId(-1),
     mLogger(FairLogger::GetLogger())
 {
 }
@@ -65,6 +75,13 @@ Stack::Stack(const Stack &rhs)
     mStoreSecondaries(rhs.mStoreSecondaries),
     mMinPoints(rhs.mMinPoints),
     mEnergyCut(rhs.mEnergyCut),
+    mPushFilterEnabled(rhs.mPushFilterEnabled),
+    mPushEnergyCut(rhs.mPushEnergyCut),
+    mPushRegionRmax(rhs.mPushRegionRmax),
+    mPushRegionZmax(rhs.mPushRegionZmax),
+    mPushDiscardPdg(rhs.mPushDiscardPdg),
+    mNumberOfDiscardedParticles(0),
+    mMemoryScopeId(-1),
     mLogger(0)
 {
   mParticles = new TClonesArray("TParticle", rhs.mParticles->GetSize());
@@ -103,6 +120,12 @@ Stack &Stack::operator=(const Stack &rhs)
   mStoreSecondaries = rhs.mStoreSecondaries;
   mMinPoints = rhs.mMinPoints;
   mEnergyCut = rhs.mEnergyCut;
+  mPushFilterEnabled = rhs.mPushFilterEnabled;
+  mPushEnergyCut = rhs.mPushEnergyCut;
+  mPushRegionRmax = rhs.mPushRegionRmax;
+  mPushRegionZmax = rhs.mPushRegionZmax;
+  mPushDiscardPdg = rhs.mPushDiscardPdg;
+  mNumberOfDiscardedParticles = 0;
   mLogger = 0;
 
   return *this;
@@ -121,6 +144,17 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
                       TMCProcess proc, Int_t &ntr, Double_t weight, Int_t is, Int_t secondparentID)
 {
 
+  // In-line filter: drop soft secondaries before a TParticle is
+  // materialized. The dropped particle never gets a stack slot and is not
+  // tracked, so the numbering of the kept particles stays dense and no
+  // remapping pass is needed for it (points referencing the flag value -2
+  // are tolerated by the index map, see FillTrackArray)
+  if (mPushFilterEnabled && parentId >= 0 && !selectAtPush(pdgCode, px, py, pz, e, vx, vy, vz)) {
+    mNumberOfDiscardedParticles++;
+    ntr = -2;
+    return;
+  }
+
   // Get TParticle array
   TClonesArray &partArray = *mParticles;
 
@@ -149,6 +183,51 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
   }
 }
 
+Int_t Stack::PushTracks(const ParticleRecord *records, Int_t numberOfRecords)
+{
+
+  // Get TParticle array and grow it once to the final size instead of
+  // letting it double repeatedly while the event is injected
+  TClonesArray &partArray = *mParticles;
+  if (mNumberOfEntriesInParticles + numberOfRecords > partArray.GetSize()) {
+    partArray.Expand(mNumberOfEntriesInParticles + numberOfRecords);
+  }
+
+  Int_t firstTrackId = -1;
+
+  for (Int_t ndx = 0; ndx < numberOfRecords; ndx++) {
+    const ParticleRecord &record = records[ndx];
+
+    // Same in-line filter as in PushTrack; a dropped particle never gets a
+    // stack slot, so the numbering of the kept particles stays dense
+    if (mPushFilterEnabled && record.parentId >= 0 &&
+        !selectAtPush(record.pdgCode, record.px, record.py, record.pz, record.e, record.vx, record.vy, record.vz)) {
+      mNumberOfDiscardedParticles++;
+      continue;
+    }
+
+    Int_t trackId = mNumberOfEntriesInParticles;
+    TParticle *particle = new(partArray[mNumberOfEntriesInParticles++])
+      TParticle(record.pdgCode, trackId, record.parentId, 0, -1, -1, record.px, record.py, record.pz, record.e,
+                record.vx, record.vy, record.vz, record.time);
+    particle->SetPolarisation(0., 0., 0.);
+    particle->SetWeight(record.weight);
+    particle->SetUniqueID(kPPrimary);
+
+    if (record.parentId < 0) {
+      mNumberOfPrimaryParticles++;
+    }
+    if (firstTrackId < 0) {
+      firstTrackId = trackId;
+    }
+    if (record.toBeDone) {
+      mStack.push(particle);
+    }
+  }
+
+  return firstTrackId;
+}
+
 TParticle *Stack::PopNextTrack(Int_t &iTrack)
 {
 
@@ -262,8 +341,11 @@ void Stack::FillTrackArray()
     }
   }
 
-  // Map index for primary mothers
+  // Map index for primary mothers and for secondaries dropped at push time
   mIndexMap[-1] = -1;
+  mIndexMap[-2] = -2;
+
+  accountMemory();
 
   // Screen output
   // Print(1);
@@ -335,17 +417,47 @@ void Stack::UpdateTrackIndex(TRefArray *detList)
   }
 }
 
+Bool_t Stack::selectAtPush(Int_t pdgCode, Double_t px, Double_t py, Double_t pz, Double_t e, Double_t vx, Double_t vy,
+                           Double_t vz) const
+{
+  // Discarded particle types
+  if (mPushDiscardPdg.find(pdgCode) != mPushDiscardPdg.end()) {
+    return kFALSE;
+  }
+
+  // Kinetic energy cut
+  if (mPushEnergyCut > 0.) {
+    Double_t mass2 = e * e - (px * px + py * py + pz * pz);
+    Double_t eKin = e - TMath::Sqrt(mass2 > 0. ? mass2 : 0.);
+    if (eKin < mPushEnergyCut) {
+      return kFALSE;
+    }
+  }
+
+  // Production region
+  if (mPushRegionRmax > 0. && vx * vx + vy * vy > mPushRegionRmax * mPushRegionRmax) {
+    return kFALSE;
+  }
+  if (mPushRegionZmax > 0. && TMath::Abs(vz) > mPushRegionZmax) {
+    return kFALSE;
+  }
+
+  return kTRUE;
+}
+
 void Stack::Reset()
 {
   mIndex = 0;
   mIndexOfCurrentTrack = -1;
   mNumberOfPrimaryParticles = mNumberOfEntriesInParticles = mNumberOfEntriesInTracks = 0;
+  mNumberOfDiscardedParticles = 0;
   while (!mStack.empty()) {
     mStack.pop();
   }
   mParticles->Clear();
   mTracks->Clear();
   mPointsMap.clear();
+  accountMemory();
 }
 
 void Stack::Register()
@@ -353,6 +465,28 @@ void Stack::Register()
   FairRootManager::Instance()->Register("MCTrack", "Stack", mTracks, kTRUE);
 }
 
+void Stack::accountMemory()
+{
+  if (!AliceO2::Memory::MemoryAccountant::IsEnabled()) {
+    return;
+  }
+  auto &accountant = AliceO2::Memory::MemoryAccountant::Instance();
+  if (mMemoryScopeId < 0) {
+    mMemoryScopeId = accountant.RegisterScope("Sim/Stack");
+  }
+
+  // allocated array slots at the element size plus the bookkeeping maps
+  // (node payload and the usual three-pointer tree overhead per entry)
+  const size_t mapNode = 3 * sizeof(void *);
+  size_t bytes = 0;
+  bytes += mParticles->GetSize() * mParticles->GetClass()->Size();
+  bytes += mTracks->GetSize() * mTracks->GetClass()->Size();
+  bytes += mStoreMap.size() * (sizeof(pair<Int_t, Bool_t>) + mapNode);
+  bytes += mIndexMap.size() * (sizeof(pair<Int_t, Int_t>) + mapNode);
+  bytes += mPointsMap.size() * (sizeof(pair<pair<Int_t, Int_t>, Int_t>) + mapNode);
+  accountant.Update(mMemoryScopeId, bytes);
+}
+
 void Stack::Print(Int_t iVerbose) const
 {
   cout << "-I- Stack: Number of primaries        = " << mNumberOfPrimaryParticles << endl;
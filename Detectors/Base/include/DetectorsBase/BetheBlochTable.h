@@ -0,0 +1,76 @@
+/// \file BetheBlochTable.h
+/// \brief Per-material energy loss lookup tables over beta-gamma
+///
+/// CorrectForMaterial evaluates the full Bethe-Bloch parameterization (two
+/// logarithms plus the density-effect branch) for every layer of every track
+/// candidate, and those transcendentals dominate the correction cost.
+/// BetheBlochTable precomputes one log-spaced table per registered material
+/// at init; a lookup is then a single logf and a linear interpolation. The
+/// batched API corrects a whole set of candidates crossing the same layer,
+/// mirroring the per-layer structure of the trackers.
+
+#ifndef ALICEO2_BASE_BETHEBLOCHTABLE
+#define ALICEO2_BASE_BETHEBLOCHTABLE
+
+#include <cmath>
+#include <vector>
+
+#include "DetectorsBase/Track.h"
+
+namespace AliceO2 {
+  namespace Base {
+    namespace Track {
+
+      class BetheBlochTable {
+        public:
+          // table granularity: log-spaced bins over the tracking beta-gamma range
+          static constexpr int kNBins = 512;
+          static constexpr float kBGMin = 0.1f;
+          static constexpr float kBGMax = 1.e4f;
+
+          BetheBlochTable() : mLogBGMin(std::log(kBGMin)),
+            mInvLogStep((kNBins - 1) / (std::log(kBGMax) - std::log(kBGMin))) {}
+
+          /// Registers a material and builds its table from BetheBlochSolid;
+          /// the parameters and defaults follow that function (silicon).
+          /// Returns the material id to use in the query calls
+          int addMaterial(float rho = 2.33f, float kp1 = 0.20f, float kp2 = 3.00f,
+                          float meanI = 173e-9f, float meanZA = 0.49848f);
+
+          int getNumberOfMaterials() const { return static_cast<int>(mTables.size()); }
+
+          /// Mean energy loss [GeV/(g/cm^2)] for the given material and
+          /// beta-gamma; clamped to the table range at the ends
+          float dEdx(int materialId, float bg) const
+          {
+            const float *table = mTables[materialId].data();
+            float u = (std::log(bg) - mLogBGMin) * mInvLogStep;
+            if (u <= 0.f) {
+              return table[0];
+            }
+            if (u >= kNBins - 1) {
+              return table[kNBins - 1];
+            }
+            int bin = static_cast<int>(u);
+            float frac = u - bin;
+            return table[bin] + frac * (table[bin + 1] - table[bin]);
+          }
+
+          /// Corrects n candidates crossing the same material layer, the dedx
+          /// taken from the table (same x2x0/xrho/mass conventions as
+          /// TrackParCov::CorrectForMaterial, including negative mass for z=2
+          /// particles). status, when given, receives the per-track outcome.
+          /// Returns the number of successfully corrected tracks
+          int correctForMaterial(int materialId, TrackParCov *tracks, int n, float x2x0, float xrho,
+                                 float mass, bool anglecorr = false, bool *status = nullptr) const;
+
+        private:
+          float mLogBGMin;   ///< log of the first bin's beta-gamma
+          float mInvLogStep; ///< bins per unit of log(beta-gamma)
+          std::vector<std::vector<float>> mTables; ///< one table per registered material
+      };
+
+    }
+  }
+}
+#endif
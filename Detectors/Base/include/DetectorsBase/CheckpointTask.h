@@ -0,0 +1,39 @@
+/// \file CheckpointTask.h
+/// \brief FairTask hooking the simulation checkpoint into the Exec cycle
+
+#ifndef ALICEO2_BASE_CHECKPOINTTASK_H_
+#define ALICEO2_BASE_CHECKPOINTTASK_H_
+
+#include "FairTask.h"
+#include "Rtypes.h"
+
+namespace AliceO2 {
+namespace Base {
+
+/// \class CheckpointTask
+/// \brief Records every completed event with the SimulationCheckpoint
+///
+/// FairTasks execute in registration order, so adding this task last in the
+/// run makes its Exec the end-of-event hook: the checkpoint service counts
+/// the event as completed and publishes a snapshot at its interval. Without
+/// an enabled SimulationCheckpoint the task is a no-op.
+class CheckpointTask : public FairTask
+{
+ public:
+  CheckpointTask();
+  virtual ~CheckpointTask();
+
+  /// marks the event as completed with the checkpoint service; register
+  /// this task after all other tasks
+  virtual void Exec(Option_t* option);
+
+  /// publishes a final snapshot, so a follow-up job sees the batch as done
+  virtual void FinishTask();
+
+  ClassDef(CheckpointTask, 1)
+};
+
+} // namespace Base
+} // namespace AliceO2
+
+#endif /* ALICEO2_BASE_CHECKPOINTTASK_H_ */
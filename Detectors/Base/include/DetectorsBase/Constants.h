@@ -25,6 +25,16 @@ namespace AliceO2 {
       // conversion from B(kGaus) to curvature for 1GeV pt
       constexpr float kB2C     = -0.299792458e-3;
 
+      // select the polynomial fast-math variants of sincos/asin in the
+      // rotation-heavy track manipulation paths (Utils::sincosf,
+      // TrackParBase::GetPhi). The approximations are good to a few 1e-7 rad,
+      // well below the angular resolution of the detectors.
+#ifdef ALICEO2_BASE_FAST_TRIG
+      constexpr bool kUseFastTrig = true;
+#else
+      constexpr bool kUseFastTrig = false;
+#endif
+
     }
   }
 }
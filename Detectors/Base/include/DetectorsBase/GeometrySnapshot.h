@@ -0,0 +1,64 @@
+/// \file GeometrySnapshot.h
+/// \brief Definition of the shared geometry snapshot service
+
+#ifndef ALICEO2_BASE_GEOMETRYSNAPSHOT_H_
+#define ALICEO2_BASE_GEOMETRYSNAPSHOT_H_
+
+#include "Rtypes.h"
+
+namespace AliceO2 {
+namespace Base {
+
+/// Shares one closed TGeo geometry between the simulation workers of a node.
+/// Every worker builds the same geometry from the ConstructGeometry
+/// implementations; with the snapshot the first worker of a job wave exports
+/// the closed geometry once and the others import it from the file. The
+/// builder is elected with an exclusive lock file and the snapshot is
+/// published with an atomic rename, so a worker never imports a half-written
+/// file. The snapshot lives on a path visible to all workers of the node
+/// (shared memory mount or local disk).
+///
+/// The intended use in a worker, before the run is initialized:
+///
+///   if (!GeometrySnapshot::acquire(path)) {
+///     // elected builder: construct the geometry as usual, then
+///     GeometrySnapshot::publish(path);
+///   }
+class GeometrySnapshot
+{
+  public:
+    /// Loads the geometry from the snapshot if one is published, otherwise
+    /// elects this worker as the builder or waits for the elected one.
+    /// Returns kTRUE when the geometry was imported; kFALSE means the caller
+    /// must construct the geometry itself and, if it holds the build lock,
+    /// publish it afterwards. On a wait timeout the worker falls back to
+    /// building locally, without the lock.
+    static Bool_t acquire(const char* path, Int_t timeout = 600);
+
+    /// Exports the closed geometry and releases the build lock
+    static Bool_t publish(const char* path);
+
+    /// kTRUE when a complete snapshot is published at the path
+    static Bool_t isAvailable(const char* path);
+
+    /// Imports a published snapshot into the current geometry manager
+    static Bool_t load(const char* path);
+
+    /// Exports the closed geometry atomically: the file appears under its
+    /// final name only when complete
+    static Bool_t save(const char* path);
+
+  protected:
+    /// Tries to become the builder; at most one worker per path succeeds
+    static Bool_t tryLock(const char* path);
+
+    /// Releases the build lock taken with tryLock
+    static void unlock(const char* path);
+
+    /// Waits until a snapshot is published, at most timeout seconds
+    static Bool_t waitFor(const char* path, Int_t timeout);
+};
+}
+}
+
+#endif
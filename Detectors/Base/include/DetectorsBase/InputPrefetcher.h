@@ -0,0 +1,79 @@
+/// \file InputPrefetcher.h
+/// \brief Definition of the background input read-ahead service
+
+#ifndef ALICEO2_BASE_INPUTPREFETCHER_H_
+#define ALICEO2_BASE_INPUTPREFETCHER_H_
+
+#include "Rtypes.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class TFile;
+class TTree;
+
+namespace AliceO2 {
+namespace Base {
+
+/// Reads the input of a FairRoot analysis run ahead of the processing.
+/// The run reads the branch baskets of event N on demand, so between two
+/// events it stalls on the storage latency; on network storage these stalls
+/// dominate the wall time of light tasks. The prefetcher opens a shadow
+/// connection to the input file of the running FairRootManager and a
+/// background thread reads the baskets of the next events through it,
+/// bounded by a read-ahead window and a cache budget. The shadow file has
+/// its own buffers, so the reader never touches the state of the processing
+/// thread; the baskets it pulls warm the storage path and page cache, and
+/// the on-demand reads of the run hit memory.
+///
+/// The intended use in a task: call init() from Init() after the input is
+/// connected, notifyEntry(event) at the top of Exec(). stop() is implied
+/// by destruction.
+class InputPrefetcher
+{
+  public:
+    InputPrefetcher();
+    ~InputPrefetcher();
+
+    InputPrefetcher(const InputPrefetcher&) = delete;
+    InputPrefetcher& operator=(const InputPrefetcher&) = delete;
+
+    /// Opens the shadow connection to the input of the FairRootManager and
+    /// starts the reader thread. Returns kFALSE (prefetch disabled) when
+    /// there is no file-based input to shadow.
+    /// @param readAhead events to read ahead of the processing
+    /// @param cacheSize cache budget of the shadow tree in bytes
+    Bool_t init(Int_t readAhead = 10, Long64_t cacheSize = 100000000);
+
+    /// Tells the reader which entry the processing reached; the reader keeps
+    /// the next readAhead entries warm
+    void notifyEntry(Long64_t entry);
+
+    /// Stops and joins the reader thread and closes the shadow file
+    void stop();
+
+    /// Entries read ahead so far
+    Long64_t getPrefetchedEntries() const { return mPrefetchedEntries; }
+
+  private:
+    /// reader thread: keep the window [current+1, current+readAhead] warm
+    void loop();
+
+    std::unique_ptr<TFile> mFile;      ///< shadow input file, owned
+    TTree* mTree;                      ///< shadow tree, owned by mFile
+    std::thread mThread;               ///< reader thread
+    std::mutex mMutex;                 ///< guards the window state
+    std::condition_variable mCondition;///< wakes the reader on new entries
+    Long64_t mCurrentEntry;            ///< entry the processing reached
+    Long64_t mNextToPrefetch;          ///< next entry the reader will pull
+    Long64_t mPrefetchedEntries;       ///< entries read ahead so far
+    Int_t mReadAhead;                  ///< read-ahead window in events
+    Bool_t mStop;                      ///< reader termination flag
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,104 @@
+/// \file MaterialBudgetMap.h
+/// \brief Voxelized material budget of the barrel for fast track corrections
+
+#ifndef ALICEO2_BASE_MATERIALBUDGETMAP_H_
+#define ALICEO2_BASE_MATERIALBUDGETMAP_H_
+
+#include <vector>
+
+#include "Rtypes.h"
+
+#include "DetectorsBase/Constants.h"
+
+namespace AliceO2 {
+namespace Base {
+
+/// CorrectForMaterial takes caller-provided x/X0 and x*rho, and the callers
+/// hardcode averaged numbers because querying the TGeo geometry during the
+/// tracking is far too slow. MaterialBudgetMap integrates the material once
+/// at init into an (r, phi, z) voxel grid: every voxel keeps the mean 1/X0
+/// [1/cm] and the mean density [g/cm^3] of the geometry inside it, sampled
+/// on a regular sub-grid. A lookup is then three bin computations and one
+/// indexed load, so the propagation can fold in locally correct material at
+/// every step. The filled map can be cached in a flat binary file and
+/// reloaded, skipping the geometry scan of the following jobs.
+class MaterialBudgetMap
+{
+  public:
+    /// per-voxel budget; multiply by the crossed path length to obtain the
+    /// x/X0 and x*rho arguments of TrackParCov::CorrectForMaterial
+    struct Budget {
+      Float_t invX0 = 0.f; ///< mean 1/X0 of the voxel [1/cm]
+      Float_t rho = 0.f;   ///< mean density of the voxel [g/cm^3]
+    };
+
+    MaterialBudgetMap() = default;
+
+    /// Fills the grid from the closed TGeo geometry: every voxel is sampled
+    /// on an nSamples^3 sub-grid in (r, phi, z) and the material properties
+    /// are averaged. The grid spans rMin..rMax in radius, -zHalf..zHalf
+    /// along the beam and the full azimuth. Returns kFALSE without a closed
+    /// geometry
+    Bool_t init(Int_t nBinsR, Int_t nBinsPhi, Int_t nBinsZ,
+                Float_t rMin, Float_t rMax, Float_t zHalf, Int_t nSamples = 3);
+
+    Bool_t isInitialized() const { return !mBudget.empty(); }
+
+    /// budget of the voxel containing (r, phi, z); r and z are clamped to
+    /// the grid, phi is wrapped into [0,2pi). Lab frame, cm
+    const Budget& getBudget(Float_t r, Float_t phi, Float_t z) const
+    {
+      Int_t ir = Int_t((r - mRMin) * mInvDR);
+      if (ir < 0) {
+        ir = 0;
+      } else if (ir >= mNBinsR) {
+        ir = mNBinsR - 1;
+      }
+      if (phi < 0.f) {
+        phi += Constants::k2PI;
+      } else if (phi >= Constants::k2PI) {
+        phi -= Constants::k2PI;
+      }
+      Int_t ip = Int_t(phi * mInvDPhi);
+      if (ip >= mNBinsPhi) {
+        ip = mNBinsPhi - 1;
+      }
+      Int_t iz = Int_t((z + mZHalf) * mInvDZ);
+      if (iz < 0) {
+        iz = 0;
+      } else if (iz >= mNBinsZ) {
+        iz = mNBinsZ - 1;
+      }
+      return mBudget[(ir * mNBinsPhi + ip) * mNBinsZ + iz];
+    }
+
+    /// Writes the filled grid to a flat binary cache file
+    Bool_t save(const char* path) const;
+
+    /// Loads a grid cached with save; kFALSE when the file is missing or
+    /// does not carry a complete map
+    Bool_t load(const char* path);
+
+    Int_t getNBinsR() const { return mNBinsR; }
+    Int_t getNBinsPhi() const { return mNBinsPhi; }
+    Int_t getNBinsZ() const { return mNBinsZ; }
+    Float_t getRMin() const { return mRMin; }
+    Float_t getRMax() const { return mRMax; }
+    Float_t getZHalf() const { return mZHalf; }
+
+  private:
+    Int_t mNBinsR = 0;    ///< radial bins
+    Int_t mNBinsPhi = 0;  ///< azimuthal bins
+    Int_t mNBinsZ = 0;    ///< longitudinal bins
+    Float_t mRMin = 0.f;  ///< inner radius of the grid [cm]
+    Float_t mRMax = 0.f;  ///< outer radius of the grid [cm]
+    Float_t mZHalf = 0.f; ///< half length of the grid along the beam [cm]
+    Float_t mInvDR = 0.f;   ///< bins per cm of radius
+    Float_t mInvDPhi = 0.f; ///< bins per radian
+    Float_t mInvDZ = 0.f;   ///< bins per cm along the beam
+    std::vector<Budget> mBudget; ///< voxel budgets, r-major then phi then z
+};
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+/// \file PointArena.h
+/// \brief Definition of the PointArena class template
+
+#ifndef ALICEO2_BASE_POINTARENA_H_
+#define ALICEO2_BASE_POINTARENA_H_
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Rtypes.h"
+#include "TClonesArray.h"
+
+namespace AliceO2 {
+namespace Base {
+
+/// Chunked arena for the MC points produced in the stepping hot path.
+/// The points are constructed into fixed-size chunks, so storing a point
+/// never relocates the ones stored before (the returned pointers stay
+/// valid for the whole event) and growing the arena never triggers the
+/// expansion stalls of a placement-new into a growing TClonesArray.
+/// clear() only rewinds the chunk cursor and is O(1); the chunks are kept
+/// and reused for the next event, so after the first few events the
+/// stepping allocates nothing at all. The points are copied once per
+/// event into the registered output container via fillOutputContainer().
+///
+/// PointType must not own resources: clear() does not run destructors.
+template <class PointType> class PointArena
+{
+  public:
+    PointArena() : mChunks(), mUsedChunks(0), mNumOfPoints(0) { }
+    ~PointArena() = default;
+
+    PointArena(const PointArena &) = delete;
+    PointArena &operator=(const PointArena &) = delete;
+
+    /// Constructs a point in the arena and returns it
+    template <class... Args> PointType *construct(Args &&... args)
+    {
+      Int_t inChunk = mNumOfPoints - (mUsedChunks - 1) * kChunkCapacity;
+      if (mUsedChunks == 0 || inChunk == kChunkCapacity) {
+        if (mUsedChunks == (Int_t) mChunks.size()) {
+          mChunks.emplace_back(new Chunk);
+        }
+        mUsedChunks++;
+        inChunk = 0;
+      }
+      PointType *point = new (&mChunks[mUsedChunks - 1]->mSlots[inChunk]) PointType(std::forward<Args>(args)...);
+      mNumOfPoints++;
+      return point;
+    }
+
+    /// Number of points stored since the last clear()
+    Int_t size() const { return mNumOfPoints; }
+
+    /// Access to the i-th stored point
+    PointType &operator[](Int_t i)
+    {
+      return *reinterpret_cast<PointType *>(&mChunks[i / kChunkCapacity]->mSlots[i % kChunkCapacity]);
+    }
+
+    /// Copies the stored points, in storage order, into the output container
+    void fillOutputContainer(TClonesArray *output)
+    {
+      TClonesArray &clref = *output;
+      for (Int_t i = 0; i < mNumOfPoints; i++) {
+        new (clref[clref.GetEntriesFast()]) PointType((*this)[i]);
+      }
+    }
+
+    /// Forgets the stored points; the chunks are kept for reuse
+    void clear()
+    {
+      mUsedChunks = 0;
+      mNumOfPoints = 0;
+    }
+
+  private:
+    enum { kChunkCapacity = 1024 };
+
+    struct Chunk {
+      typename std::aligned_storage<sizeof(PointType), alignof(PointType)>::type mSlots[kChunkCapacity];
+    };
+
+    std::vector<std::unique_ptr<Chunk>> mChunks; //!< chunk pool, grown on demand and reused between events
+    Int_t mUsedChunks;                           //!< number of chunks in use
+    Int_t mNumOfPoints;                          //!< number of points stored since the last clear()
+};
+}
+}
+
+#endif
@@ -0,0 +1,105 @@
+/// \file Propagator.h
+/// \brief Track propagation engine with adaptive steps and field reuse
+///
+/// Trackers drive TrackParCov::PropagateTo in fixed steps and fetch the field
+/// for every call, although the solenoid field varies slowly over most of the
+/// barrel: the ITS-TPC matching prototype spends about half of its
+/// propagation time in redundant small steps and field queries. Propagator
+/// integrates to a target X in one call: the sub-step length follows the
+/// track curvature (bounded sagitta per step), and the cached field value is
+/// reused across sub-steps as long as the locally observed field variation
+/// stays small, shrinking the reuse radius automatically where the gradient
+/// grows (cache ends, outer regions). A material-crossing hook is invoked
+/// after every sub-step so the caller can fold in energy loss and multiple
+/// scattering at the granularity of the integration.
+///
+/// The engine is stateful only through its diagnostics counters: use one
+/// instance per tracking thread, like the CachedSegment field memos.
+
+#ifndef ALICEO2_BASE_PROPAGATOR
+#define ALICEO2_BASE_PROPAGATOR
+
+#include <array>
+#include <functional>
+
+#include "DetectorsBase/Constants.h"
+#include "DetectorsBase/Track.h"
+
+namespace AliceO2 {
+  namespace Base {
+    namespace Track {
+
+      class Propagator {
+        public:
+          /// field query: position (lab frame, cm) to {Bx,By,Bz} (lab frame, kG)
+          using FieldFunction = std::function<void(const std::array<float,3> &xyz, std::array<float,3> &bxyz)>;
+
+          /// called after every sub-step with the covered local X interval;
+          /// return false to abort the propagation (e.g. track left the setup)
+          using MaterialHook = std::function<bool(TrackParCov &track, float xStart, float xEnd)>;
+
+          explicit Propagator(FieldFunction field) : mField(std::move(field)) {}
+
+          /// uniform solenoid field shortcut, bZ in kG
+          explicit Propagator(float bZ) : mField([bZ](const std::array<float,3>&, std::array<float,3> &b) {
+            b[0] = b[1] = 0.f;
+            b[2] = bZ;
+          }) {}
+
+          /// Integrates the track to the plane X=xToGo (tracking frame, cm)
+          bool PropagateToX(TrackParCov &track, float xToGo);
+
+          /// Same for a parameters-only track; the material hook does not apply
+          bool PropagateParamToX(TrackParBase &track, float xToGo);
+
+          void SetMaterialHook(MaterialHook hook) { mMaterialHook = std::move(hook); }
+
+          void SetMaxStep(float step)          { mMaxStep = step; }
+          void SetMinStep(float step)          { mMinStep = step; }
+          /// sub-step bound: largest sagitta allowed per helix sub-step, cm
+          void SetSagittaTolerance(float tol)  { mSagittaTolerance = tol; }
+          /// largest field change [kG] accepted without shrinking the reuse radius
+          void SetFieldReuseTolerance(float b) { mFieldReuseTolerance = b; }
+          /// starting (and largest) distance over which a fetched field value is reused, cm
+          void SetFieldReuseDistance(float d)  { mFieldReuseDistance = d; }
+
+          float GetMaxStep()             const { return mMaxStep; }
+          float GetMinStep()             const { return mMinStep; }
+          float GetSagittaTolerance()    const { return mSagittaTolerance; }
+          float GetFieldReuseTolerance() const { return mFieldReuseTolerance; }
+          float GetFieldReuseDistance()  const { return mFieldReuseDistance; }
+
+          // diagnostics for tuning the reuse parameters
+          long GetFieldQueries() const { return mFieldQueries; }
+          long GetSteps()        const { return mSteps; }
+          void ResetCounters()         { mFieldQueries = mSteps = 0; }
+
+        private:
+          /// per-propagation field cache with the adaptive reuse radius
+          struct FieldState {
+            std::array<float,3> position = {{0.f, 0.f, 0.f}}; ///< lab position of the last query
+            std::array<float,3> value = {{0.f, 0.f, 0.f}};    ///< field of the last query
+            float reuseDistance = 0.f;                        ///< current reuse radius
+            bool valid = false;
+          };
+
+          void refreshField(const TrackParBase &track, FieldState &state);
+          float computeStep(const TrackParBase &track, float bz) const;
+
+          FieldFunction mField;       ///< field provider
+          MaterialHook mMaterialHook; ///< optional per-sub-step material treatment
+
+          float mMaxStep = 20.f;              ///< largest sub-step, cm
+          float mMinStep = 0.1f;              ///< smallest sub-step, cm
+          float mSagittaTolerance = 0.01f;    ///< per-step sagitta bound, cm
+          float mFieldReuseTolerance = 0.05f; ///< acceptable field drift within the reuse radius, kG
+          float mFieldReuseDistance = 20.f;   ///< largest reuse radius, cm
+
+          long mFieldQueries = 0; ///< field provider invocations
+          long mSteps = 0;        ///< sub-steps taken
+      };
+
+    }
+  }
+}
+#endif
@@ -0,0 +1,72 @@
+/// \file SimulationCheckpoint.h
+/// \brief Definition of the simulation checkpoint/restart service
+
+#ifndef ALICEO2_BASE_SIMULATIONCHECKPOINT_H_
+#define ALICEO2_BASE_SIMULATIONCHECKPOINT_H_
+
+#include "Rtypes.h"
+
+#include <string>
+
+namespace AliceO2 {
+namespace Base {
+
+/// Checkpoint/restart for long transport jobs. A preempted job loses the
+/// whole event batch; with the checkpoint it loses at most the events since
+/// the last snapshot. After every N completed events the service publishes
+/// a compact binary snapshot holding the number of completed events and the
+/// full state of the random generator; the snapshot appears under its final
+/// name only through an atomic rename, so a restart never reads a
+/// half-written file. Event boundaries are the checkpoint granularity: the
+/// stack and the ProcessHits buffers of the detectors are flushed to the
+/// output there, so the snapshot does not need to carry them, and restoring
+/// the generator state reproduces the remaining events exactly as the
+/// uninterrupted run would have produced them.
+///
+/// The intended use in a run macro, before Init():
+///
+///   auto& checkpoint = SimulationCheckpoint::instance();
+///   checkpoint.enable(checkpointPath);
+///   Int_t nDone = checkpoint.eventsCompleted();
+///   if (nDone > 0) { checkpoint.restore(); /* segment output file */ }
+///   run->AddTask(new CheckpointTask);  // registered last
+///   ...
+///   run->Run(nEvents - nDone);
+class SimulationCheckpoint
+{
+  public:
+    static SimulationCheckpoint& instance();
+
+    /// Enables checkpointing to the path, one snapshot every interval
+    /// completed events. An existing snapshot at the path is picked up as
+    /// the restart point.
+    void enable(const char* path, Int_t interval = 1);
+
+    Bool_t isEnabled() const { return !mPath.empty(); }
+
+    /// Events recorded as completed in the published snapshot, 0 without one
+    Int_t eventsCompleted() const { return mEventsCompleted; }
+
+    /// Restores the random generator state from the snapshot, so the
+    /// remaining events draw the same numbers as in the uninterrupted run
+    Bool_t restore();
+
+    /// Called by CheckpointTask after each completed event; publishes a
+    /// snapshot every interval events
+    void eventFinished();
+
+    /// Publishes a snapshot of the current state, atomically
+    Bool_t save();
+
+  private:
+    SimulationCheckpoint() : mPath(), mInterval(1), mEventsCompleted(0) {}
+
+    std::string mPath;      ///< snapshot path, empty when disabled
+    Int_t mInterval;        ///< events between snapshots
+    Int_t mEventsCompleted; ///< completed events, including restored ones
+};
+
+}
+}
+
+#endif
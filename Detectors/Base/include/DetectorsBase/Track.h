@@ -47,6 +47,43 @@ namespace AliceO2 {
 			    float meanI=173e-9f,float meanZA=0.49848f);
       void g3helx3(float qfield, float step,std::array<float,7> &vect);
 
+      // Compile-time precision policies for the covariance arithmetic. The
+      // tracks always store float parameters and covariance; the policy
+      // selects the type of the transport/update intermediates (Inter) and
+      // the accumulator type (Acc) the working parameters and covariance are
+      // kept in for the duration of an operation. FastFloat is for the mass
+      // tracking passes, ExactDouble (the historical behaviour and what the
+      // non-template methods do) for the final fits, CompensatedFloat
+      // recovers most of the double accuracy from float-only arithmetic via
+      // Neumaier-compensated accumulation, for targets where double is
+      // expensive. The compensation pays off where the working state spans
+      // several updates, i.e. in UpdateBulk.
+      namespace Precision {
+
+        // float value carrying the compensation of its summation errors
+        struct KahanFloat {
+          KahanFloat() = default;
+          KahanFloat(float v) : mSum{v} {}
+          KahanFloat& operator=(float v) { mSum=v; mComp=0.f; return *this; }
+          KahanFloat& operator+=(float v) {
+            // Neumaier two-sum, valid also for |v| > |mSum|
+            const float t = mSum + v;
+            mComp += (fabsf(mSum)>=fabsf(v)) ? (mSum-t)+v : (v-t)+mSum;
+            mSum = t;
+            return *this;
+          }
+          KahanFloat& operator-=(float v) { return operator+=(-v); }
+          operator float() const { return mSum + mComp; }
+
+          float mSum  = 0.f; /// running sum
+          float mComp = 0.f; /// bits the sum lost so far
+        };
+
+        struct FastFloat        { using Inter = float;  using Acc = float;      };
+        struct ExactDouble      { using Inter = double; using Acc = double;     };
+        struct CompensatedFloat { using Inter = float;  using Acc = KahanFloat; };
+      }
+
 
       class TrackParBase { // track parameterization, kinematics only. This base class cannot be instantiated
         public:
@@ -63,7 +100,9 @@ namespace AliceO2 {
           // derived getters
           float GetCurvature(float b)          const { return mP[kQ2Pt]*b*Constants::kB2C;}
           float GetSign()                      const { return mP[kQ2Pt]>0 ? 1.f:-1.f;}
-          float GetPhi()                       const { return asinf(GetSnp()) + GetAlpha();}
+          float GetPhi()                       const {
+            return (Constants::kUseFastTrig ? Utils::FastASinf(GetSnp()) : asinf(GetSnp())) + GetAlpha();
+          }
           float GetPhiPos()                    const;
 
           float GetP()                         const;
@@ -127,15 +166,39 @@ namespace AliceO2 {
           bool  PropagateTo(float xk, const std::array<float,3> &b);
           void  Invert();
 
+          // precision-policy variant of the transport: same code, the policy
+          // (see namespace Precision) fixes the intermediates type at compile
+          // time. The plain PropagateTo is the ExactDouble instance
+          template <class P> bool PropagateTo(float xk, float b);
+
           float GetPredictedChi2(const std::array<float,2> &p, const std::array<float,3> &cov) const;
           bool  Update(const std::array<float,2> &p, const std::array<float,3> &cov);
 
+          // precision-policy variant of the Kalman update; the plain Update
+          // is the ExactDouble instance
+          template <class P> bool Update(const std::array<float,2> &p, const std::array<float,3> &cov);
+
+          // perform nUpd consecutive updates with the covariance sanity clamps
+          // deferred to a single CheckCovariance pass at the end. To be used
+          // in refit loops where the points are trusted; saves the branchy
+          // per-update validation.
+          bool  UpdateBulk(const std::array<float,2> *p, const std::array<float,3> *cov, int nUpd);
+
+          // precision-policy variant of the bulk update: the working
+          // parameters and covariance are held in the policy accumulator for
+          // the whole sequence, so CompensatedFloat carries its summation
+          // compensation across the updates of a refit
+          template <class P> bool UpdateBulk(const std::array<float,2> *p, const std::array<float,3> *cov, int nUpd);
+
           bool  CorrectForMaterial(float x2x0,float xrho,float mass,bool anglecorr=false,float dedx=kCalcdEdxAuto);
 
           void  ResetCovariance(float s2=0);
           void  CheckCovariance();
 
         protected:
+          // Kalman update arithmetic without the trailing CheckCovariance
+          bool  UpdateNoCheck(const std::array<float,2> &p, const std::array<float,3> &cov);
+
           float mC[kCovMatSize] = {0.f};  // 15 covariance matrix elements
 
       };
@@ -0,0 +1,329 @@
+/// \file TrackBlock
+/// \brief Structure-of-arrays block of N TrackParCov for vectorized propagation
+/// \author ruben.shahoyan@cern.ch
+
+#ifndef ALICEO2_BASE_TRACKBLOCK
+#define ALICEO2_BASE_TRACKBLOCK
+
+#include "DetectorsBase/Track.h"
+
+namespace AliceO2 {
+  namespace Base {
+    namespace Track {
+
+      /// Structure-of-arrays storage of N tracks with covariance.
+      ///
+      /// The parameters and covariance elements of the N tracks are stored
+      /// component-wise in contiguous arrays, so the propagation and update
+      /// kernels below process all lanes of the block in stride-1 loops which
+      /// the compiler auto-vectorizes. Lanes whose track failed a precondition
+      /// (|snp|>1, vanishing curvature radius, singular measurement
+      /// covariance) are deactivated via the per-lane status mask and simply
+      /// carry their last valid state; the scalar TrackParCov methods return
+      /// false in the same situations.
+      ///
+      /// Intended use in the trackers: gather N seeds with SetTrack, call
+      /// PropagateTo/Update on the whole block, scatter back with GetTrack
+      /// and drop the lanes flagged as failed.
+      template <int N=8>
+      class TrackParCovBlock {
+        public:
+          TrackParCovBlock() = default;
+
+          static constexpr int GetSize() { return N; }
+
+          /// load the scalar track into lane i and mark the lane active
+          void SetTrack(int i, const TrackParCov &trc) {
+            mX[i] = trc.GetX();
+            mAlpha[i] = trc.GetAlpha();
+            mP[kY][i] = trc.GetY();
+            mP[kZ][i] = trc.GetZ();
+            mP[kSnp][i] = trc.GetSnp();
+            mP[kTgl][i] = trc.GetTgl();
+            mP[kQ2Pt][i] = trc.GetQ2Pt();
+            mC[kSigY2][i] = trc.GetSigmaY2();
+            mC[kSigZY][i] = trc.GetSigmaZY();
+            mC[kSigZ2][i] = trc.GetSigmaZ2();
+            mC[kSigSnpY][i] = trc.GetSigmaSnpY();
+            mC[kSigSnpZ][i] = trc.GetSigmaSnpZ();
+            mC[kSigSnp2][i] = trc.GetSigmaSnp2();
+            mC[kSigTglY][i] = trc.GetSigmaTglY();
+            mC[kSigTglZ][i] = trc.GetSigmaTglZ();
+            mC[kSigTglSnp][i] = trc.GetSigmaTglSnp();
+            mC[kSigTgl2][i] = trc.GetSigmaTgl2();
+            mC[kSigQ2PtY][i] = trc.GetSigma1PtY();
+            mC[kSigQ2PtZ][i] = trc.GetSigma1PtZ();
+            mC[kSigQ2PtSnp][i] = trc.GetSigma1PtSnp();
+            mC[kSigQ2PtTgl][i] = trc.GetSigma1PtTgl();
+            mC[kSigQ2Pt2][i] = trc.GetSigma1Pt2();
+            mOK[i] = true;
+          }
+
+          /// scatter lane i back to a scalar track
+          /// @return false if the lane failed during block processing
+          bool GetTrack(int i, TrackParCov &trc) const {
+            std::array<float,kNParams> par;
+            std::array<float,kCovMatSize> cov;
+            for (int j=kNParams;j--;)    par[j] = mP[j][i];
+            for (int j=kCovMatSize;j--;) cov[j] = mC[j][i];
+            trc = TrackParCov(mX[i],mAlpha[i],par,cov);
+            return mOK[i];
+          }
+
+          float GetX(int i)      const { return mX[i]; }
+          float GetAlpha(int i)  const { return mAlpha[i]; }
+          float GetY(int i)      const { return mP[kY][i]; }
+          float GetZ(int i)      const { return mP[kZ][i]; }
+          float GetSnp(int i)    const { return mP[kSnp][i]; }
+          float GetTgl(int i)    const { return mP[kTgl][i]; }
+          float GetQ2Pt(int i)   const { return mP[kQ2Pt][i]; }
+          bool  IsOK(int i)      const { return mOK[i]; }
+          void  Deactivate(int i)      { mOK[i] = false; }
+
+          /// propagate all active lanes to the plane X=xk (cm) in the field b (kG)
+          /// Lanes failing a precondition are deactivated, the others advance.
+          /// @return true if at least one lane is still active
+          bool PropagateTo(float xk, float b);
+
+          /// update all active lanes with their measurement (p[0..1][lane],
+          /// cov[0..2][lane]), same convention as TrackParCov::Update
+          /// @return true if at least one lane is still active
+          bool Update(const float p[2][N], const float cov[3][N]);
+
+        private:
+          /// lane-wise equivalent of TrackParCov::CheckCovariance
+          void CheckCovariance();
+
+          float mX[N] = {0.f};                 /// X of track evaluation
+          float mAlpha[N] = {0.f};             /// track frame angle
+          float mP[kNParams][N] = {{0.f}};     /// 5 parameters, component-major
+          float mC[kCovMatSize][N] = {{0.f}};  /// 15 covariance elements, component-major
+          bool  mOK[N] = {false};              /// per-lane status mask
+      };
+
+      //____________________________________________________________
+      template <int N>
+      bool TrackParCovBlock<N>::PropagateTo(float xk, float b) {
+        // transcription of TrackParCov::PropagateTo with the early returns
+        // replaced by lane deactivation, so the loops stay branch-free inside
+        const float crvC = (fabs(b)<Constants::kAlmost0) ? 0.f : b*Constants::kB2C;
+
+        float dx[N],x2r[N],f1[N],f2[N],r1[N],r2[N];
+        bool  move[N];
+        for (int i=0;i<N;++i) {
+          dx[i]  = xk - mX[i];
+          x2r[i] = mP[kQ2Pt][i]*crvC*dx[i];
+          f1[i]  = mP[kSnp][i];
+          f2[i]  = f1[i] + x2r[i];
+          move[i] = mOK[i] && fabs(dx[i])>=Constants::kAlmost0;
+          if (move[i] && (fabs(f1[i])>Constants::kAlmost1 || fabs(f2[i])>Constants::kAlmost1 ||
+                          fabs(mP[kQ2Pt][i])<Constants::kAlmost0)) {
+            mOK[i] = move[i] = false;
+          }
+          r1[i] = sqrtf((1.f-f1[i])*(1.f+f1[i]));
+          r2[i] = sqrtf((1.f-f2[i])*(1.f+f2[i]));
+          if (move[i] && (fabs(r1[i])<Constants::kAlmost0 || fabs(r2[i])<Constants::kAlmost0)) {
+            mOK[i] = move[i] = false;
+          }
+        }
+
+        float dy2dx[N];
+        for (int i=0;i<N;++i) {
+          dy2dx[i] = (f1[i]+f2[i])/(r1[i]+r2[i]);
+          if (!move[i]) continue;
+          mX[i] = xk;
+          mP[kY][i]   += dx[i]*dy2dx[i];
+          mP[kSnp][i] += x2r[i];
+          if (fabs(x2r[i])<0.05f) {
+            mP[kZ][i] += dx[i]*(r2[i] + f2[i]*dy2dx[i])*mP[kTgl][i];
+          }
+          else {
+            // same large-rotation treatment as the scalar version
+            float rot = asinf(r1[i]*f2[i] - r2[i]*f1[i]);
+            if (f1[i]*f1[i]+f2[i]*f2[i]>1.f && f1[i]*f2[i]<0.f) {
+              if (f2[i]>0.f) rot =  Constants::kPI - rot;
+              else           rot = -Constants::kPI - rot;
+            }
+            mP[kZ][i] += mP[kTgl][i]/(mP[kQ2Pt][i]*crvC)*rot;
+          }
+        }
+
+        // covariance transport, all lanes in lock-step; inactive lanes are
+        // transported too (cheap) but their result is never read back
+        for (int i=0;i<N;++i) {
+          const float dxm = move[i] ? dx[i] : 0.f;
+          const float rinv  = 1.f/r1[i];
+          const float r3inv = rinv*rinv*rinv;
+          const float f24   = dxm*b*Constants::kB2C;
+          const float f02   = dxm*r3inv;
+          const float f04   = 0.5f*f24*f02;
+          const float f12   = f02*mP[kTgl][i]*f1[i];
+          const float f14   = 0.5f*f24*f12;
+          const float f13   = dxm*rinv;
+
+          const float c20=mC[kSigSnpY][i], c21=mC[kSigSnpZ][i], c22=mC[kSigSnp2][i];
+          const float c30=mC[kSigTglY][i], c31=mC[kSigTglZ][i], c32=mC[kSigTglSnp][i], c33=mC[kSigTgl2][i];
+          const float c40=mC[kSigQ2PtY][i], c41=mC[kSigQ2PtZ][i], c42=mC[kSigQ2PtSnp][i],
+                      c43=mC[kSigQ2PtTgl][i], c44=mC[kSigQ2Pt2][i];
+
+          const float b00=f02*c20 + f04*c40, b01=f12*c20 + f14*c40 + f13*c30, b02=f24*c40;
+          const float b10=f02*c21 + f04*c41, b11=f12*c21 + f14*c41 + f13*c31, b12=f24*c41;
+          const float b20=f02*c22 + f04*c42, b21=f12*c22 + f14*c42 + f13*c32, b22=f24*c42;
+          const float b40=f02*c42 + f04*c44, b41=f12*c42 + f14*c44 + f13*c43, b42=f24*c44;
+          const float b30=f02*c32 + f04*c43, b31=f12*c32 + f14*c43 + f13*c33, b32=f24*c43;
+
+          const float a00=f02*b20+f04*b40, a01=f02*b21+f04*b41, a02=f02*b22+f04*b42;
+          const float a11=f12*b21+f14*b41+f13*b31, a12=f12*b22+f14*b42+f13*b32;
+          const float a22=f24*b42;
+
+          mC[kSigY2][i]      += b00 + b00 + a00;
+          mC[kSigZY][i]      += b10 + b01 + a01;
+          mC[kSigSnpY][i]    += b20 + b02 + a02;
+          mC[kSigTglY][i]    += b30;
+          mC[kSigQ2PtY][i]   += b40;
+          mC[kSigZ2][i]      += b11 + b11 + a11;
+          mC[kSigSnpZ][i]    += b21 + b12 + a12;
+          mC[kSigTglZ][i]    += b31;
+          mC[kSigQ2PtZ][i]   += b41;
+          mC[kSigSnp2][i]    += b22 + b22 + a22;
+          mC[kSigTglSnp][i]  += b32;
+          mC[kSigQ2PtSnp][i] += b42;
+        }
+
+        CheckCovariance();
+
+        bool any = false;
+        for (int i=0;i<N;++i) any |= mOK[i];
+        return any;
+      }
+
+      //____________________________________________________________
+      template <int N>
+      bool TrackParCovBlock<N>::Update(const float p[2][N], const float cov[3][N]) {
+        // transcription of TrackParCov::Update, lane-wise
+        float k00[N],k01[N],k10[N],k11[N],k20[N],k21[N],k30[N],k31[N],k40[N],k41[N];
+        float dy[N],dz[N];
+        bool  upd[N];
+
+        for (int i=0;i<N;++i) {
+          float r00=cov[0][i]+mC[kSigY2][i], r01=cov[1][i]+mC[kSigZY][i], r11=cov[2][i]+mC[kSigZ2][i];
+          const float det = r00*r11 - r01*r01;
+          upd[i] = mOK[i] && fabs(det)>=Constants::kAlmost0;
+          if (mOK[i] && !upd[i]) mOK[i] = false;
+          const float detI = upd[i] ? 1.f/det : 0.f;
+          const float tmp = r00;
+          r00 =  r11*detI;
+          r11 =  tmp*detI;
+          r01 = -r01*detI;
+
+          k00[i] = mC[kSigY2][i]*r00+mC[kSigZY][i]*r01;    k01[i] = mC[kSigY2][i]*r01+mC[kSigZY][i]*r11;
+          k10[i] = mC[kSigZY][i]*r00+mC[kSigZ2][i]*r01;    k11[i] = mC[kSigZY][i]*r01+mC[kSigZ2][i]*r11;
+          k20[i] = mC[kSigSnpY][i]*r00+mC[kSigSnpZ][i]*r01;  k21[i] = mC[kSigSnpY][i]*r01+mC[kSigSnpZ][i]*r11;
+          k30[i] = mC[kSigTglY][i]*r00+mC[kSigTglZ][i]*r01;  k31[i] = mC[kSigTglY][i]*r01+mC[kSigTglZ][i]*r11;
+          k40[i] = mC[kSigQ2PtY][i]*r00+mC[kSigQ2PtZ][i]*r01; k41[i] = mC[kSigQ2PtY][i]*r01+mC[kSigQ2PtZ][i]*r11;
+
+          dy[i] = p[0][i] - mP[kY][i];
+          dz[i] = p[1][i] - mP[kZ][i];
+          const float sf = mP[kSnp][i] + k20[i]*dy[i] + k21[i]*dz[i];
+          if (upd[i] && fabs(sf)>Constants::kAlmost1) {
+            mOK[i] = upd[i] = false;
+          }
+        }
+
+        for (int i=0;i<N;++i) {
+          if (!upd[i]) continue;
+          mP[kY][i]    += k00[i]*dy[i] + k01[i]*dz[i];
+          mP[kZ][i]    += k10[i]*dy[i] + k11[i]*dz[i];
+          mP[kSnp][i]  += k20[i]*dy[i] + k21[i]*dz[i];
+          mP[kTgl][i]  += k30[i]*dy[i] + k31[i]*dz[i];
+          mP[kQ2Pt][i] += k40[i]*dy[i] + k41[i]*dz[i];
+
+          const float c01=mC[kSigZY][i], c02=mC[kSigSnpY][i], c03=mC[kSigTglY][i], c04=mC[kSigQ2PtY][i];
+          const float c12=mC[kSigSnpZ][i], c13=mC[kSigTglZ][i], c14=mC[kSigQ2PtZ][i];
+
+          mC[kSigY2][i]     -= k00[i]*mC[kSigY2][i]+k01[i]*mC[kSigZY][i];
+          mC[kSigZY][i]     -= k00[i]*c01+k01[i]*mC[kSigZ2][i];
+          mC[kSigSnpY][i]   -= k00[i]*c02+k01[i]*c12;
+          mC[kSigTglY][i]   -= k00[i]*c03+k01[i]*c13;
+          mC[kSigQ2PtY][i]  -= k00[i]*c04+k01[i]*c14;
+
+          mC[kSigZ2][i]     -= k10[i]*c01+k11[i]*mC[kSigZ2][i];
+          mC[kSigSnpZ][i]   -= k10[i]*c02+k11[i]*c12;
+          mC[kSigTglZ][i]   -= k10[i]*c03+k11[i]*c13;
+          mC[kSigQ2PtZ][i]  -= k10[i]*c04+k11[i]*c14;
+
+          mC[kSigSnp2][i]   -= k20[i]*c02+k21[i]*c12;
+          mC[kSigTglSnp][i] -= k20[i]*c03+k21[i]*c13;
+          mC[kSigQ2PtSnp][i]-= k20[i]*c04+k21[i]*c14;
+
+          mC[kSigTgl2][i]   -= k30[i]*c03+k31[i]*c13;
+          mC[kSigQ2PtTgl][i]-= k30[i]*c04+k31[i]*c14;
+
+          mC[kSigQ2Pt2][i]  -= k40[i]*c04+k41[i]*c14;
+        }
+
+        CheckCovariance();
+
+        bool any = false;
+        for (int i=0;i<N;++i) any |= mOK[i];
+        return any;
+      }
+
+      //____________________________________________________________
+      template <int N>
+      void TrackParCovBlock<N>::CheckCovariance() {
+        // same clamps as TrackParCov::CheckCovariance, vectorizable form:
+        // the scale factor is computed unconditionally and selected to 1
+        // where the diagonal element is within bounds
+        for (int i=0;i<N;++i) {
+          mC[kSigY2][i] = fabs(mC[kSigY2][i]);
+          float scl = (mC[kSigY2][i]>kCY2max) ? sqrtf(kCY2max/mC[kSigY2][i]) : 1.f;
+          if (mC[kSigY2][i]>kCY2max) mC[kSigY2][i] = kCY2max;
+          mC[kSigZY][i]    *= scl;
+          mC[kSigSnpY][i]  *= scl;
+          mC[kSigTglY][i]  *= scl;
+          mC[kSigQ2PtY][i] *= scl;
+        }
+        for (int i=0;i<N;++i) {
+          mC[kSigZ2][i] = fabs(mC[kSigZ2][i]);
+          float scl = (mC[kSigZ2][i]>kCZ2max) ? sqrtf(kCZ2max/mC[kSigZ2][i]) : 1.f;
+          if (mC[kSigZ2][i]>kCZ2max) mC[kSigZ2][i] = kCZ2max;
+          mC[kSigZY][i]    *= scl;
+          mC[kSigSnpZ][i]  *= scl;
+          mC[kSigTglZ][i]  *= scl;
+          mC[kSigQ2PtZ][i] *= scl;
+        }
+        for (int i=0;i<N;++i) {
+          mC[kSigSnp2][i] = fabs(mC[kSigSnp2][i]);
+          float scl = (mC[kSigSnp2][i]>kCSnp2max) ? sqrtf(kCSnp2max/mC[kSigSnp2][i]) : 1.f;
+          if (mC[kSigSnp2][i]>kCSnp2max) mC[kSigSnp2][i] = kCSnp2max;
+          mC[kSigSnpY][i]   *= scl;
+          mC[kSigSnpZ][i]   *= scl;
+          mC[kSigTglSnp][i] *= scl;
+          mC[kSigQ2PtSnp][i]*= scl;
+        }
+        for (int i=0;i<N;++i) {
+          mC[kSigTgl2][i] = fabs(mC[kSigTgl2][i]);
+          float scl = (mC[kSigTgl2][i]>kCTgl2max) ? sqrtf(kCTgl2max/mC[kSigTgl2][i]) : 1.f;
+          if (mC[kSigTgl2][i]>kCTgl2max) mC[kSigTgl2][i] = kCTgl2max;
+          mC[kSigTglY][i]   *= scl;
+          mC[kSigTglZ][i]   *= scl;
+          mC[kSigTglSnp][i] *= scl;
+          mC[kSigQ2PtTgl][i]*= scl;
+        }
+        for (int i=0;i<N;++i) {
+          mC[kSigQ2Pt2][i] = fabs(mC[kSigQ2Pt2][i]);
+          float scl = (mC[kSigQ2Pt2][i]>kC1Pt2max) ? sqrtf(kC1Pt2max/mC[kSigQ2Pt2][i]) : 1.f;
+          if (mC[kSigQ2Pt2][i]>kC1Pt2max) mC[kSigQ2Pt2][i] = kC1Pt2max;
+          mC[kSigQ2PtY][i]   *= scl;
+          mC[kSigQ2PtZ][i]   *= scl;
+          mC[kSigQ2PtSnp][i] *= scl;
+          mC[kSigQ2PtTgl][i] *= scl;
+        }
+      }
+
+    }
+  }
+}
+
+#endif
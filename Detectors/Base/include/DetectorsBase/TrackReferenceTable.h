@@ -0,0 +1,57 @@
+/// \file TrackReferenceTable.h
+/// \brief Sorted flat storage of track references with per-track lookup
+///
+/// During transport the TrackReference objects are appended to a
+/// TClonesArray in creation order, so a consumer interested in one track
+/// has to scan all references of the event. The table is built once after
+/// transport: the references are copied into a flat array sorted by track
+/// id, keeping the creation order along the trajectory within a track,
+/// with a CSR-style offset table over the sorted unique track ids. The
+/// references of one track are then a contiguous range found by a binary
+/// search over the track ids.
+
+#ifndef ALICEO2_BASE_TRACKREFERENCETABLE_H_
+#define ALICEO2_BASE_TRACKREFERENCETABLE_H_
+
+#include "DetectorsBase/TrackReference.h"
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+namespace Base {
+
+class TrackReferenceTable
+{
+  public:
+    TrackReferenceTable() = default;
+
+    /// Drop the content but keep the allocations
+    void clear()
+    {
+      mReferences.clear();
+      mTrackIds.clear();
+      mOffsets.clear();
+    }
+
+    /// Build the table from the unsorted array filled during transport
+    void build(const TClonesArray& references);
+
+    Int_t getNumberOfTracks() const { return mTrackIds.size(); }
+    Int_t getNumberOfReferences() const { return mReferences.size(); }
+
+    /// References of one track as a contiguous range, binary search over
+    /// the track ids
+    /// @return pointer to the first reference, nullptr and n = 0 if the
+    ///         track has none
+    const TrackReference* getReferences(Int_t trackId, Int_t& n) const;
+
+  private:
+    std::vector<TrackReference> mReferences; ///< references sorted by track id, back to back
+    std::vector<Int_t> mTrackIds;            ///< sorted unique track ids
+    std::vector<Int_t> mOffsets;             ///< CSR-style offsets per track id, nTracks+1 entries
+};
+}
+}
+
+#endif /* ALICEO2_BASE_TRACKREFERENCETABLE_H_ */
@@ -35,8 +35,49 @@ namespace AliceO2 {
         while(phi> Constants::kPI)   {phi -= Constants::k2PI;}
       }
 
+      template <bool HighPrecision=true>
+      inline float FastASinf(float x) {
+        // polynomial approximation of asin, Abramowitz&Stegun style:
+        // asin(x) = pi/2 - sqrt(1-x)*poly(x) for x>=0, odd continuation below.
+        // HighPrecision uses the 8-term polynomial (|err|<2e-8 rad), the
+        // 4-term one (|err|<7e-5 rad) is enough for sector-level decisions.
+        const float xa = fabsf(x);
+        float p;
+        if (HighPrecision) {
+          p = 1.5707963050f + xa*(-0.2145988016f + xa*(0.0889789874f + xa*(-0.0501743046f
+            + xa*(0.0308918810f + xa*(-0.0170881256f + xa*(0.0066700901f - xa*0.0012624911f))))));
+        }
+        else {
+          p = 1.5707288f + xa*(-0.2121144f + xa*(0.0742610f - xa*0.0187293f));
+        }
+        const float r = Constants::kPIHalf - sqrtf(1.f-xa)*p;
+        return x<0 ? -r : r;
+      }
+
+      inline void FastSinCosf(float ang, float& s, float &c) {
+        // minimax polynomial sin/cos after quadrant reduction, |err|<4e-7.
+        // The reduction is exact for the |ang|<~2pi range seen in the
+        // tracking frame rotations.
+        const float quadF = ang*(2.f/Constants::kPI);
+        const int   quad  = static_cast<int>(quadF>=0 ? quadF+0.5f : quadF-0.5f);
+        const float x  = ang - quad*Constants::kPIHalf;
+        const float x2 = x*x;
+        const float sn = x*(1.f + x2*(-0.16666656684f + x2*(8.3330251385e-3f - x2*1.950727e-4f)));
+        const float cs = 1.f + x2*(-0.4999999963f + x2*(0.04166573f - x2*1.3854e-3f));
+        switch (quad & 3) {
+          case 0: s = sn;  c = cs;  break;
+          case 1: s = cs;  c = -sn; break;
+          case 2: s = -sn; c = -cs; break;
+          default:s = -cs; c = sn;  break;
+        }
+      }
+
       inline void sincosf(float ang, float& s, float &c) {
-        // consider speedup for simultaneus calculation
+        // simultaneus calculation, optionally via the polynomial fast path
+        if (Constants::kUseFastTrig) {
+          FastSinCosf(ang,s,c);
+          return;
+        }
         s = sinf(ang);
         c = cosf(ang);
       }
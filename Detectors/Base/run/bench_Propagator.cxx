@@ -0,0 +1,126 @@
+/// \file bench_Propagator.cxx
+/// \brief Benchmark of the adaptive Propagator against fixed-step propagation
+///
+/// Propagates a batch of barrel-like tracks from the ITS radius to the TPC
+/// outer radius through a synthetic slowly-varying solenoid field. The
+/// baseline fetches the field and calls TrackParCov::PropagateTo for every
+/// fixed 2 cm step, the way the trackers drive the propagation today; the
+/// engine integrates with curvature-bound steps and the adaptive field reuse.
+/// The parameter agreement between the two paths is reported along with the
+/// timings and field-query counts.
+
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/Track.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace AliceO2::Base::Track;
+
+namespace {
+  constexpr int kNTracks = 20000;
+  constexpr int kNRepetitions = 10;
+  constexpr float kStartX = 40.f;
+  constexpr float kTargetX = 240.f;
+  constexpr float kFixedStep = 2.f;
+
+  // slowly varying solenoid-like field, kG
+  void syntheticField(const std::array<float,3> &xyz, std::array<float,3> &b)
+  {
+    float r2 = xyz[0]*xyz[0] + xyz[1]*xyz[1];
+    b[0] = 1e-5f * xyz[0];
+    b[1] = 1e-5f * xyz[1];
+    b[2] = -5.0068f * (1.f - 2e-7f*r2 - 1e-4f*std::fabs(xyz[2]));
+  }
+
+  TrackParCov makeSeed(int i)
+  {
+    float q2pt = ((i % 2) ? 1.f : -1.f) / (0.3f + 0.01f*(i % 100));
+    std::array<float,kNParams> par{0.1f, 2.f + 0.01f*(i % 50), 0.05f, 0.4f, q2pt};
+    std::array<float,kCovMatSize> cov{0.f};
+    cov[kSigY2]    = 0.01f;
+    cov[kSigZ2]    = 0.01f;
+    cov[kSigSnp2]  = 0.001f;
+    cov[kSigTgl2]  = 0.001f;
+    cov[kSigQ2Pt2] = 0.1f;
+    return TrackParCov(kStartX, 0.f, par, cov);
+  }
+
+  double secondsSince(std::chrono::high_resolution_clock::time_point start)
+  {
+    const auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(stop-start).count();
+  }
+}
+
+int main()
+{
+  // ===| fixed steps, field fetched per step |=================================
+  double checksum = 0;
+  long baselineQueries = 0;
+  std::vector<TrackParCov> baseline;
+  baseline.reserve(kNTracks);
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int rep = 0; rep < kNRepetitions; ++rep) {
+    baseline.clear();
+    for (int itr = 0; itr < kNTracks; ++itr) {
+      TrackParCov trc = makeSeed(itr);
+      bool ok = true;
+      while (ok && trc.GetX() < kTargetX) {
+        float xNext = trc.GetX() + kFixedStep;
+        if (xNext > kTargetX) {
+          xNext = kTargetX;
+        }
+        std::array<float,3> xyz{0.f}, b{0.f};
+        trc.GetXYZ(xyz);
+        syntheticField(xyz, b);
+        baselineQueries++;
+        ok = trc.PropagateTo(xNext, b);
+      }
+      if (ok) {
+        checksum += trc.GetY();
+        baseline.push_back(trc);
+      }
+    }
+  }
+  const double fixedTime = secondsSince(start);
+  printf("fixed %4.1f cm steps : %.3f s, %ld field queries, checksum %f\n",
+         kFixedStep, fixedTime, baselineQueries, checksum);
+
+  // ===| adaptive engine |=====================================================
+  Propagator engine{Propagator::FieldFunction(syntheticField)};
+  checksum = 0;
+  size_t idx = 0;
+  double worstY = 0, worstSnp = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int rep = 0; rep < kNRepetitions; ++rep) {
+    idx = 0;
+    for (int itr = 0; itr < kNTracks; ++itr) {
+      TrackParCov trc = makeSeed(itr);
+      if (engine.PropagateToX(trc, kTargetX)) {
+        checksum += trc.GetY();
+        if (idx < baseline.size()) {
+          float dY = std::fabs(trc.GetY() - baseline[idx].GetY());
+          float dSnp = std::fabs(trc.GetSnp() - baseline[idx].GetSnp());
+          if (dY > worstY) {
+            worstY = dY;
+          }
+          if (dSnp > worstSnp) {
+            worstSnp = dSnp;
+          }
+          idx++;
+        }
+      }
+    }
+  }
+  const double adaptiveTime = secondsSince(start);
+  printf("adaptive engine    : %.3f s, %ld field queries, %ld steps, checksum %f\n",
+         adaptiveTime, engine.GetFieldQueries(), engine.GetSteps(), checksum);
+  printf("agreement vs fixed : worst dY %.4g cm, worst dSnp %.4g\n", worstY, worstSnp);
+  printf("speedup            : x%.2f\n", fixedTime/adaptiveTime);
+
+  return 0;
+}
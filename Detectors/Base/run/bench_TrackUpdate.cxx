@@ -0,0 +1,89 @@
+/// \file bench_TrackUpdate.cxx
+/// \brief Benchmark of per-update vs deferred covariance checking
+///
+/// Compares TrackParCov::Update (CheckCovariance after every cluster) against
+/// TrackParCov::UpdateBulk (single CheckCovariance per refit) on a synthetic
+/// refit workload of K consecutive cluster updates per track.
+
+#include "DetectorsBase/Track.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace AliceO2::Base::Track;
+
+namespace {
+  constexpr int kClustersPerTrack = 7;   // ITS-like refit length
+  constexpr int kNTracks = 200000;
+  constexpr int kNRepetitions = 20;
+
+  TrackParCov makeSeed(float y, float z)
+  {
+    std::array<float,kNParams> par{y, z, 0.1f, 0.5f, 1.f/0.8f};
+    std::array<float,kCovMatSize> cov{0.f};
+    cov[kSigY2]    = 0.01f;
+    cov[kSigZ2]    = 0.01f;
+    cov[kSigSnp2]  = 0.001f;
+    cov[kSigTgl2]  = 0.001f;
+    cov[kSigQ2Pt2] = 0.1f;
+    return TrackParCov(10.f, 0.f, par, cov);
+  }
+
+  double secondsSince(std::chrono::high_resolution_clock::time_point start)
+  {
+    const auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(stop-start).count();
+  }
+}
+
+int main()
+{
+  // pre-generate measurement points scattered around the seed position so the
+  // loops measure only the update arithmetic
+  std::vector<std::array<float,2>> points(kNTracks*kClustersPerTrack);
+  std::vector<std::array<float,3>> pointCov(kNTracks*kClustersPerTrack);
+  srand48(12345);
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i] = {1.f + 0.01f*static_cast<float>(drand48()-0.5),
+                 2.f + 0.01f*static_cast<float>(drand48()-0.5)};
+    pointCov[i] = {0.0001f, 0.f, 0.0001f};
+  }
+
+  // ===| per-update checking |=================================================
+  double checksum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int rep = 0; rep < kNRepetitions; ++rep) {
+    for (int itr = 0; itr < kNTracks; ++itr) {
+      TrackParCov trc = makeSeed(1.f, 2.f);
+      const size_t offset = static_cast<size_t>(itr)*kClustersPerTrack;
+      for (int icl = 0; icl < kClustersPerTrack; ++icl) {
+        trc.Update(points[offset+icl], pointCov[offset+icl]);
+      }
+      checksum += trc.GetY();
+    }
+  }
+  const double tPerUpdate = secondsSince(start);
+  const double nUpdates = static_cast<double>(kNRepetitions)*kNTracks*kClustersPerTrack;
+  printf("Update       (checked):  %8.3f s  %10.3e updates/s  (checksum %f)\n",
+         tPerUpdate, nUpdates/tPerUpdate, checksum);
+
+  // ===| deferred checking |===================================================
+  checksum = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int rep = 0; rep < kNRepetitions; ++rep) {
+    for (int itr = 0; itr < kNTracks; ++itr) {
+      TrackParCov trc = makeSeed(1.f, 2.f);
+      const size_t offset = static_cast<size_t>(itr)*kClustersPerTrack;
+      trc.UpdateBulk(&points[offset], &pointCov[offset], kClustersPerTrack);
+      checksum += trc.GetY();
+    }
+  }
+  const double tBulk = secondsSince(start);
+  printf("UpdateBulk  (deferred):  %8.3f s  %10.3e updates/s  (checksum %f)\n",
+         tBulk, nUpdates/tBulk, checksum);
+  printf("speedup: %.2fx\n", tPerUpdate/tBulk);
+
+  return 0;
+}
@@ -5,6 +5,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
+#pragma link C++ class AliceO2::Base::CheckpointTask+;
 #pragma link C++ class AliceO2::Base::Detector+;
 #pragma link C++ class AliceO2::Base::Track::TrackParBase+;
 #pragma link C++ class AliceO2::Base::Track::TrackPar+;
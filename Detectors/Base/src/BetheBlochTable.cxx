@@ -0,0 +1,49 @@
+/// \file BetheBlochTable.cxx
+/// \brief Implementation of the per-material energy loss tables
+
+#include "DetectorsBase/BetheBlochTable.h"
+
+using namespace AliceO2::Base::Track;
+
+constexpr int BetheBlochTable::kNBins;
+constexpr float BetheBlochTable::kBGMin;
+constexpr float BetheBlochTable::kBGMax;
+
+//__________________________________________________________________________________________________
+int BetheBlochTable::addMaterial(float rho, float kp1, float kp2, float meanI, float meanZA)
+{
+  mTables.emplace_back(kNBins);
+  std::vector<float> &table = mTables.back();
+  float logStep = 1.f / mInvLogStep;
+  for (int bin = 0; bin < kNBins; bin++) {
+    float bg = std::exp(mLogBGMin + bin * logStep);
+    table[bin] = BetheBlochSolid(bg, rho, kp1, kp2, meanI, meanZA);
+  }
+  return static_cast<int>(mTables.size()) - 1;
+}
+
+//__________________________________________________________________________________________________
+int BetheBlochTable::correctForMaterial(int materialId, TrackParCov *tracks, int n, float x2x0,
+                                        float xrho, float mass, bool anglecorr, bool *status) const
+{
+  int nCorrected = 0;
+  float massAbs = std::fabs(mass);
+  for (int i = 0; i < n; i++) {
+    float p = tracks[i].GetP();
+    if (mass < 0) {
+      p += p; // z=2 particle, as in CorrectForMaterial
+    }
+    float dedx = dEdx(materialId, p / massAbs);
+    if (mass < 0) {
+      dedx *= 4.f;
+    }
+    bool ok = tracks[i].CorrectForMaterial(x2x0, xrho, mass, anglecorr, dedx);
+    if (status) {
+      status[i] = ok;
+    }
+    if (ok) {
+      nCorrected++;
+    }
+  }
+  return nCorrected;
+}
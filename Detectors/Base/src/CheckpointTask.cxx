@@ -0,0 +1,22 @@
+/// \file CheckpointTask.cxx
+/// \brief Implementation of the simulation checkpoint task
+
+#include "DetectorsBase/CheckpointTask.h"
+#include "DetectorsBase/SimulationCheckpoint.h"
+
+ClassImp(AliceO2::Base::CheckpointTask)
+
+using namespace AliceO2::Base;
+
+CheckpointTask::CheckpointTask() : FairTask("CheckpointTask") {}
+
+CheckpointTask::~CheckpointTask() {}
+
+void CheckpointTask::Exec(Option_t* option) { SimulationCheckpoint::instance().eventFinished(); }
+
+void CheckpointTask::FinishTask()
+{
+  if (SimulationCheckpoint::instance().isEnabled()) {
+    SimulationCheckpoint::instance().save();
+  }
+}
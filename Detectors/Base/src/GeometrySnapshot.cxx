@@ -0,0 +1,120 @@
+/// \file GeometrySnapshot.cxx
+/// \brief Implementation of the shared geometry snapshot service
+
+#include "DetectorsBase/GeometrySnapshot.h"
+
+#include <string>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <TGeoManager.h>
+
+#include "FairLogger.h"
+
+using namespace AliceO2::Base;
+
+namespace {
+std::string lockPath(const char* path) { return std::string(path) + ".lock"; }
+}
+
+Bool_t GeometrySnapshot::isAvailable(const char* path)
+{
+  // the snapshot appears under its final name only after the atomic rename,
+  // so an existing file is always complete
+  return ::access(path, R_OK) == 0;
+}
+
+Bool_t GeometrySnapshot::load(const char* path)
+{
+  if (!isAvailable(path)) {
+    return kFALSE;
+  }
+  TGeoManager* geom = TGeoManager::Import(path);
+  if (!geom || !geom->IsClosed()) {
+    LOG(WARNING) << "GeometrySnapshot: import of " << path << " failed" << FairLogger::endl;
+    return kFALSE;
+  }
+  LOG(INFO) << "GeometrySnapshot: geometry imported from " << path << FairLogger::endl;
+  return kTRUE;
+}
+
+Bool_t GeometrySnapshot::save(const char* path)
+{
+  if (!gGeoManager || !gGeoManager->IsClosed()) {
+    LOG(WARNING) << "GeometrySnapshot: no closed geometry to export" << FairLogger::endl;
+    return kFALSE;
+  }
+  // export to a worker-private name first; the rename publishes the complete
+  // file in one step
+  std::string tmp = std::string(path) + ".tmp." + std::to_string(::getpid());
+  if (gGeoManager->Export(tmp.c_str()) <= 0) {
+    ::unlink(tmp.c_str());
+    return kFALSE;
+  }
+  if (::rename(tmp.c_str(), path) != 0) {
+    ::unlink(tmp.c_str());
+    return kFALSE;
+  }
+  LOG(INFO) << "GeometrySnapshot: geometry exported to " << path << FairLogger::endl;
+  return kTRUE;
+}
+
+Bool_t GeometrySnapshot::tryLock(const char* path)
+{
+  Int_t fd = ::open(lockPath(path).c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+  if (fd < 0) {
+    return kFALSE;
+  }
+  std::string pid = std::to_string(::getpid());
+  ssize_t ignored = ::write(fd, pid.c_str(), pid.size());
+  (void)ignored;
+  ::close(fd);
+  return kTRUE;
+}
+
+void GeometrySnapshot::unlock(const char* path) { ::unlink(lockPath(path).c_str()); }
+
+Bool_t GeometrySnapshot::waitFor(const char* path, Int_t timeout)
+{
+  for (Int_t elapsed = 0; elapsed < timeout; elapsed++) {
+    if (isAvailable(path)) {
+      return kTRUE;
+    }
+    ::sleep(1);
+  }
+  return isAvailable(path);
+}
+
+Bool_t GeometrySnapshot::acquire(const char* path, Int_t timeout)
+{
+  if (load(path)) {
+    return kTRUE;
+  }
+  if (tryLock(path)) {
+    // double check: the builder may have published between the load attempt
+    // and the lock
+    if (load(path)) {
+      unlock(path);
+      return kTRUE;
+    }
+    LOG(INFO) << "GeometrySnapshot: elected builder for " << path << FairLogger::endl;
+    return kFALSE;
+  }
+  // another worker is building; wait for its snapshot
+  LOG(INFO) << "GeometrySnapshot: waiting for the builder of " << path << FairLogger::endl;
+  if (waitFor(path, timeout) && load(path)) {
+    return kTRUE;
+  }
+  LOG(WARNING) << "GeometrySnapshot: snapshot " << path
+               << " did not appear, building locally" << FairLogger::endl;
+  return kFALSE;
+}
+
+Bool_t GeometrySnapshot::publish(const char* path)
+{
+  Bool_t ok = save(path);
+  unlock(path);
+  return ok;
+}
@@ -0,0 +1,126 @@
+/// \file InputPrefetcher.cxx
+/// \brief Implementation of the background input read-ahead service
+
+#include "DetectorsBase/InputPrefetcher.h"
+
+#include <algorithm>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TTree.h>
+
+#include "FairLogger.h"
+#include "FairRootManager.h"
+
+using namespace AliceO2::Base;
+
+InputPrefetcher::InputPrefetcher()
+  : mFile(),
+    mTree(nullptr),
+    mThread(),
+    mMutex(),
+    mCondition(),
+    mCurrentEntry(0),
+    mNextToPrefetch(0),
+    mPrefetchedEntries(0),
+    mReadAhead(0),
+    mStop(kFALSE)
+{
+}
+
+InputPrefetcher::~InputPrefetcher() { stop(); }
+
+Bool_t InputPrefetcher::init(Int_t readAhead, Long64_t cacheSize)
+{
+  if (readAhead <= 0) {
+    return kFALSE;
+  }
+  FairRootManager* mgr = FairRootManager::Instance();
+  if (!mgr) {
+    return kFALSE;
+  }
+  TChain* chain = mgr->GetInChain();
+  if (!chain || !chain->GetFile()) {
+    LOG(WARNING) << "InputPrefetcher: no file-based input to shadow, prefetch disabled"
+                 << FairLogger::endl;
+    return kFALSE;
+  }
+
+  // shadow connection: own file, own tree, own buffers; the reader never
+  // touches the state of the processing thread
+  mFile.reset(TFile::Open(chain->GetFile()->GetName()));
+  if (!mFile || mFile->IsZombie()) {
+    LOG(WARNING) << "InputPrefetcher: cannot reopen input " << chain->GetFile()->GetName()
+                 << ", prefetch disabled" << FairLogger::endl;
+    mFile.reset();
+    return kFALSE;
+  }
+  mTree = dynamic_cast<TTree*>(mFile->Get(chain->GetName()));
+  if (!mTree) {
+    LOG(WARNING) << "InputPrefetcher: no tree '" << chain->GetName() << "' in the input, "
+                 << "prefetch disabled" << FairLogger::endl;
+    mFile.reset();
+    return kFALSE;
+  }
+  mTree->SetCacheSize(cacheSize);
+  mTree->AddBranchToCache("*", kTRUE);
+
+  mReadAhead = readAhead;
+  mCurrentEntry = 0;
+  mNextToPrefetch = 0;
+  mPrefetchedEntries = 0;
+  mStop = kFALSE;
+  mThread = std::thread(&InputPrefetcher::loop, this);
+  LOG(INFO) << "InputPrefetcher: reading ahead " << mReadAhead << " events of "
+            << chain->GetFile()->GetName() << FairLogger::endl;
+  return kTRUE;
+}
+
+void InputPrefetcher::notifyEntry(Long64_t entry)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (entry <= mCurrentEntry) {
+      return;
+    }
+    mCurrentEntry = entry;
+  }
+  mCondition.notify_one();
+}
+
+void InputPrefetcher::stop()
+{
+  if (!mThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = kTRUE;
+  }
+  mCondition.notify_one();
+  mThread.join();
+  LOG(DEBUG) << "InputPrefetcher: stopped after " << mPrefetchedEntries << " prefetched entries"
+             << FairLogger::endl;
+  mTree = nullptr;
+  mFile.reset();
+}
+
+void InputPrefetcher::loop()
+{
+  const Long64_t numOfEntries = mTree->GetEntries();
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (!mStop) {
+    const Long64_t last = std::min(mCurrentEntry + mReadAhead, numOfEntries - 1);
+    if (mNextToPrefetch <= last) {
+      const Long64_t entry = mNextToPrefetch++;
+      lock.unlock();
+      // pulls the baskets of every branch of the entry through the shadow
+      // tree, warming the storage path for the on-demand read of the run
+      mTree->GetEntry(entry);
+      lock.lock();
+      ++mPrefetchedEntries;
+      continue;
+    }
+    mCondition.wait(lock);
+  }
+}
@@ -0,0 +1,147 @@
+/// \file MaterialBudgetMap.cxx
+/// \brief Implementation of the voxelized material budget map
+
+#include "DetectorsBase/MaterialBudgetMap.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoNode.h>
+#include <TMath.h>
+
+#include "FairLogger.h"
+
+using namespace AliceO2::Base;
+
+namespace {
+// file magic and layout version of the binary cache
+const char kMagic[8] = { 'O', '2', 'M', 'A', 'T', 'B', 'U', 'D' };
+const Int_t kVersion = 1;
+}
+
+Bool_t MaterialBudgetMap::init(Int_t nBinsR, Int_t nBinsPhi, Int_t nBinsZ,
+                               Float_t rMin, Float_t rMax, Float_t zHalf, Int_t nSamples)
+{
+  if (!gGeoManager || !gGeoManager->IsClosed()) {
+    LOG(WARNING) << "MaterialBudgetMap: no closed geometry to integrate" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  mNBinsR = nBinsR;
+  mNBinsPhi = nBinsPhi;
+  mNBinsZ = nBinsZ;
+  mRMin = rMin;
+  mRMax = rMax;
+  mZHalf = zHalf;
+  mInvDR = nBinsR / (rMax - rMin);
+  mInvDPhi = nBinsPhi / Constants::k2PI;
+  mInvDZ = nBinsZ / (2.f * zHalf);
+  mBudget.assign(size_t(nBinsR) * nBinsPhi * nBinsZ, Budget());
+
+  const Double_t dR = (rMax - rMin) / nBinsR;
+  const Double_t dPhi = Double_t(Constants::k2PI) / nBinsPhi;
+  const Double_t dZ = 2. * Double_t(zHalf) / nBinsZ;
+  const Double_t subStep = 1. / nSamples;
+  const Int_t samplesPerVoxel = nSamples * nSamples * nSamples;
+
+  size_t voxel = 0;
+  for (Int_t ir = 0; ir < nBinsR; ir++) {
+    for (Int_t ip = 0; ip < nBinsPhi; ip++) {
+      for (Int_t iz = 0; iz < nBinsZ; iz++, voxel++) {
+        Double_t sumInvX0 = 0., sumRho = 0.;
+        for (Int_t sr = 0; sr < nSamples; sr++) {
+          Double_t r = rMin + (ir + (sr + 0.5) * subStep) * dR;
+          for (Int_t sp = 0; sp < nSamples; sp++) {
+            Double_t phi = (ip + (sp + 0.5) * subStep) * dPhi;
+            Double_t x = r * TMath::Cos(phi);
+            Double_t y = r * TMath::Sin(phi);
+            for (Int_t sz = 0; sz < nSamples; sz++) {
+              Double_t z = -zHalf + (iz + (sz + 0.5) * subStep) * dZ;
+              TGeoNode* node = gGeoManager->FindNode(x, y, z);
+              if (!node) {
+                continue;
+              }
+              TGeoMaterial* material = node->GetMedium()->GetMaterial();
+              Double_t radLen = material->GetRadLen();
+              if (radLen > 0.) {
+                sumInvX0 += 1. / radLen;
+              }
+              sumRho += material->GetDensity();
+            }
+          }
+        }
+        mBudget[voxel].invX0 = sumInvX0 / samplesPerVoxel;
+        mBudget[voxel].rho = sumRho / samplesPerVoxel;
+      }
+    }
+  }
+
+  LOG(INFO) << "MaterialBudgetMap: integrated " << nBinsR << "x" << nBinsPhi << "x" << nBinsZ
+            << " voxels, r " << rMin << ".." << rMax << " cm, |z| < " << zHalf << " cm"
+            << FairLogger::endl;
+  return kTRUE;
+}
+
+Bool_t MaterialBudgetMap::save(const char* path) const
+{
+  if (!isInitialized()) {
+    return kFALSE;
+  }
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return kFALSE;
+  }
+  file.write(kMagic, sizeof(kMagic));
+  file.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+  file.write(reinterpret_cast<const char*>(&mNBinsR), sizeof(mNBinsR));
+  file.write(reinterpret_cast<const char*>(&mNBinsPhi), sizeof(mNBinsPhi));
+  file.write(reinterpret_cast<const char*>(&mNBinsZ), sizeof(mNBinsZ));
+  file.write(reinterpret_cast<const char*>(&mRMin), sizeof(mRMin));
+  file.write(reinterpret_cast<const char*>(&mRMax), sizeof(mRMax));
+  file.write(reinterpret_cast<const char*>(&mZHalf), sizeof(mZHalf));
+  file.write(reinterpret_cast<const char*>(mBudget.data()), mBudget.size() * sizeof(Budget));
+  if (!file) {
+    return kFALSE;
+  }
+  LOG(INFO) << "MaterialBudgetMap: cached to " << path << FairLogger::endl;
+  return kTRUE;
+}
+
+Bool_t MaterialBudgetMap::load(const char* path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return kFALSE;
+  }
+  char magic[sizeof(kMagic)];
+  Int_t version = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+    LOG(WARNING) << "MaterialBudgetMap: " << path << " is not a material budget cache"
+                 << FairLogger::endl;
+    return kFALSE;
+  }
+  file.read(reinterpret_cast<char*>(&mNBinsR), sizeof(mNBinsR));
+  file.read(reinterpret_cast<char*>(&mNBinsPhi), sizeof(mNBinsPhi));
+  file.read(reinterpret_cast<char*>(&mNBinsZ), sizeof(mNBinsZ));
+  file.read(reinterpret_cast<char*>(&mRMin), sizeof(mRMin));
+  file.read(reinterpret_cast<char*>(&mRMax), sizeof(mRMax));
+  file.read(reinterpret_cast<char*>(&mZHalf), sizeof(mZHalf));
+  if (!file || mNBinsR <= 0 || mNBinsPhi <= 0 || mNBinsZ <= 0) {
+    return kFALSE;
+  }
+  mInvDR = mNBinsR / (mRMax - mRMin);
+  mInvDPhi = mNBinsPhi / Constants::k2PI;
+  mInvDZ = mNBinsZ / (2.f * mZHalf);
+  mBudget.resize(size_t(mNBinsR) * mNBinsPhi * mNBinsZ);
+  file.read(reinterpret_cast<char*>(mBudget.data()), mBudget.size() * sizeof(Budget));
+  if (!file) {
+    mBudget.clear();
+    return kFALSE;
+  }
+  LOG(INFO) << "MaterialBudgetMap: loaded from " << path << FairLogger::endl;
+  return kTRUE;
+}
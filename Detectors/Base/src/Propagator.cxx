@@ -0,0 +1,119 @@
+/// \file Propagator.cxx
+/// \brief Implementation of the adaptive track propagation engine
+
+#include "DetectorsBase/Propagator.h"
+
+#include <cmath>
+
+using namespace AliceO2::Base::Track;
+using namespace AliceO2::Base::Constants;
+
+namespace {
+  // propagation convergence window and the snp headroom kept per sub-step:
+  // the single-step extrapolation fails when |snp| approaches 1, so the step
+  // is bounded to keep the turn well inside the validity range
+  constexpr float kEpsX = 1e-4f;
+  constexpr float kSnpLimit = 0.9f;
+  // the reuse radius never shrinks below this, a query per few mm is already
+  // integration-step territory
+  constexpr float kMinReuseDistance = 1.f;
+}
+
+//__________________________________________________________________________________________________
+void Propagator::refreshField(const TrackParBase &track, FieldState &state)
+{
+  std::array<float,3> xyz{0.f};
+  track.GetXYZ(xyz);
+  if (state.valid) {
+    float dx = xyz[0] - state.position[0], dy = xyz[1] - state.position[1], dz = xyz[2] - state.position[2];
+    if (dx * dx + dy * dy + dz * dz < state.reuseDistance * state.reuseDistance) {
+      return; // still within the reuse radius of the cached value
+    }
+  }
+  std::array<float,3> fresh{0.f};
+  mField(xyz, fresh);
+  mFieldQueries++;
+  if (state.valid) {
+    // adapt the reuse radius to the locally observed field variation
+    float drift = std::max(std::fabs(fresh[0] - state.value[0]),
+                           std::max(std::fabs(fresh[1] - state.value[1]), std::fabs(fresh[2] - state.value[2])));
+    if (drift > mFieldReuseTolerance) {
+      state.reuseDistance = std::max(0.5f * state.reuseDistance, kMinReuseDistance);
+    } else if (drift < 0.25f * mFieldReuseTolerance && state.reuseDistance < mFieldReuseDistance) {
+      state.reuseDistance = std::min(2.f * state.reuseDistance, mFieldReuseDistance);
+    }
+  } else {
+    state.reuseDistance = mFieldReuseDistance;
+    state.valid = true;
+  }
+  state.position = xyz;
+  state.value = fresh;
+}
+
+//__________________________________________________________________________________________________
+float Propagator::computeStep(const TrackParBase &track, float bz) const
+{
+  float step = mMaxStep;
+  float crv = std::fabs(track.GetCurvature(bz));
+  if (crv > kAlmost0) {
+    // bound the per-step sagitta: s ~ crv*step^2/8
+    float sagittaStep = std::sqrt(8.f * mSagittaTolerance / crv);
+    if (sagittaStep < step) {
+      step = sagittaStep;
+    }
+    // keep the turn inside the snp validity range of the single step
+    float snpMargin = (kSnpLimit - std::fabs(track.GetSnp())) / crv;
+    if (snpMargin < step) {
+      step = snpMargin;
+    }
+  }
+  return step < mMinStep ? mMinStep : step;
+}
+
+//__________________________________________________________________________________________________
+bool Propagator::PropagateToX(TrackParCov &track, float xToGo)
+{
+  float dx = xToGo - track.GetX();
+  if (std::fabs(dx) < kEpsX) {
+    return true;
+  }
+  float direction = dx > 0.f ? 1.f : -1.f;
+  FieldState field;
+  while (std::fabs(dx) > kEpsX) {
+    refreshField(track, field);
+    float step = computeStep(track, field.value[2]);
+    float xNext = (std::fabs(dx) <= step) ? xToGo : track.GetX() + direction * step;
+    float xStart = track.GetX();
+    if (!track.PropagateTo(xNext, field.value)) {
+      return false;
+    }
+    mSteps++;
+    if (mMaterialHook && !mMaterialHook(track, xStart, xNext)) {
+      return false;
+    }
+    dx = xToGo - track.GetX();
+  }
+  return true;
+}
+
+//__________________________________________________________________________________________________
+bool Propagator::PropagateParamToX(TrackParBase &track, float xToGo)
+{
+  float dx = xToGo - track.GetX();
+  if (std::fabs(dx) < kEpsX) {
+    return true;
+  }
+  float direction = dx > 0.f ? 1.f : -1.f;
+  FieldState field;
+  while (std::fabs(dx) > kEpsX) {
+    refreshField(track, field);
+    float step = computeStep(track, field.value[2]);
+    float xNext = (std::fabs(dx) <= step) ? xToGo : track.GetX() + direction * step;
+    if (!track.PropagateParamTo(xNext, field.value)) {
+      return false;
+    }
+    mSteps++;
+    dx = xToGo - track.GetX();
+  }
+  return true;
+}
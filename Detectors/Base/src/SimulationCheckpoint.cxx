@@ -0,0 +1,132 @@
+/// \file SimulationCheckpoint.cxx
+/// \brief Implementation of the simulation checkpoint/restart service
+
+#include "DetectorsBase/SimulationCheckpoint.h"
+
+#include <fstream>
+#include <vector>
+
+#include <cstdio>
+#include <cstring>
+
+#include <TBufferFile.h>
+#include <TRandom.h>
+
+#include "FairLogger.h"
+
+using namespace AliceO2::Base;
+
+namespace {
+const char kMagic[8] = {'O', '2', 'S', 'I', 'M', 'C', 'K', 'P'};
+const Int_t kVersion = 1;
+}
+
+SimulationCheckpoint& SimulationCheckpoint::instance()
+{
+  static SimulationCheckpoint checkpoint;
+  return checkpoint;
+}
+
+void SimulationCheckpoint::enable(const char* path, Int_t interval)
+{
+  mPath = path;
+  mInterval = interval > 0 ? interval : 1;
+  mEventsCompleted = 0;
+
+  // pick up an existing snapshot as the restart point
+  std::ifstream in(mPath, std::ios::in | std::ios::binary);
+  if (!in.good()) {
+    return;
+  }
+  char magic[8];
+  Int_t version = 0;
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!in.good() || std::memcmp(magic, kMagic, sizeof(magic)) != 0 || version != kVersion) {
+    LOG(WARNING) << "SimulationCheckpoint: unusable snapshot at " << mPath
+                 << ", starting from scratch" << FairLogger::endl;
+    return;
+  }
+  in.read(reinterpret_cast<char*>(&mEventsCompleted), sizeof(mEventsCompleted));
+  if (!in.good()) {
+    mEventsCompleted = 0;
+    return;
+  }
+  LOG(INFO) << "SimulationCheckpoint: found snapshot with " << mEventsCompleted
+            << " completed events at " << mPath << FairLogger::endl;
+}
+
+Bool_t SimulationCheckpoint::restore()
+{
+  std::ifstream in(mPath, std::ios::in | std::ios::binary);
+  if (!in.good()) {
+    return kFALSE;
+  }
+  in.seekg(sizeof(kMagic) + sizeof(Int_t) + sizeof(Int_t));
+  Int_t rngBytes = 0;
+  in.read(reinterpret_cast<char*>(&rngBytes), sizeof(rngBytes));
+  if (!in.good() || rngBytes <= 0) {
+    return kFALSE;
+  }
+  std::vector<char> state(rngBytes);
+  in.read(state.data(), rngBytes);
+  if (!in.good()) {
+    return kFALSE;
+  }
+  // the generator restores itself from its ROOT streamer bytes
+  TBufferFile buffer(TBuffer::kRead, rngBytes, state.data(), kFALSE);
+  gRandom->Streamer(buffer);
+  LOG(INFO) << "SimulationCheckpoint: random generator state restored, resuming after event "
+            << mEventsCompleted << FairLogger::endl;
+  return kTRUE;
+}
+
+void SimulationCheckpoint::eventFinished()
+{
+  if (!isEnabled()) {
+    return;
+  }
+  ++mEventsCompleted;
+  if (mEventsCompleted % mInterval == 0) {
+    save();
+  }
+}
+
+Bool_t SimulationCheckpoint::save()
+{
+  if (!isEnabled()) {
+    return kFALSE;
+  }
+  // the generator state is the part of the snapshot that cannot be
+  // reconstructed; the stack and the detector hit buffers are empty at the
+  // event boundary, their content lives in the run output already
+  TBufferFile buffer(TBuffer::kWrite);
+  gRandom->Streamer(buffer);
+  const Int_t rngBytes = buffer.Length();
+
+  // write to a private name first; the rename publishes the complete
+  // snapshot in one step
+  std::string tmp = mPath + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+      LOG(WARNING) << "SimulationCheckpoint: cannot write snapshot to " << tmp << FairLogger::endl;
+      return kFALSE;
+    }
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    out.write(reinterpret_cast<const char*>(&mEventsCompleted), sizeof(mEventsCompleted));
+    out.write(reinterpret_cast<const char*>(&rngBytes), sizeof(rngBytes));
+    out.write(buffer.Buffer(), rngBytes);
+    if (!out.good()) {
+      return kFALSE;
+    }
+  }
+  if (std::rename(tmp.c_str(), mPath.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    return kFALSE;
+  }
+  LOG(DEBUG) << "SimulationCheckpoint: snapshot published after " << mEventsCompleted
+             << " events" << FairLogger::endl;
+  return kTRUE;
+}
@@ -4,6 +4,7 @@ using std::array;
 using AliceO2::Base::Track::TrackParBase;
 using AliceO2::Base::Track::TrackPar;
 using AliceO2::Base::Track::TrackParCov;
+using namespace AliceO2::Base::Track;
 using namespace AliceO2::Base::Constants;
 
 //______________________________________________________________
@@ -321,6 +322,18 @@ bool TrackParCov::PropagateTo(float xk, float b)
   //----------------------------------------------------------------
   // Propagate this track to the plane X=xk (cm) in the field "b" (kG)
   //----------------------------------------------------------------
+  return PropagateTo<Precision::ExactDouble>(xk,b);
+}
+
+//______________________________________________________________
+template <class P>
+bool TrackParCov::PropagateTo(float xk, float b)
+{
+  //----------------------------------------------------------------
+  // Propagate this track to the plane X=xk (cm) in the field "b" (kG);
+  // the precision policy fixes the type of the intermediates
+  //----------------------------------------------------------------
+  using Inter = typename P::Inter;
   float dx=xk-GetX();
   if (fabs(dx)< kAlmost0)  return true;
   float crv = (fabs(b)<kAlmost0) ? 0.f : GetCurvature(b);
@@ -333,7 +346,7 @@ bool TrackParCov::PropagateTo(float xk, float b)
   if (fabs(r1)<kAlmost0)  return false;
   if (fabs(r2)<kAlmost0)  return false;
   mX = xk;
-  double dy2dx = (f1+f2)/(r1+r2);
+  Inter dy2dx = (f1+f2)/(r1+r2);
   mP[kY] += dx*dy2dx;
   mP[kSnp] += x2r;
   if (fabs(x2r)<0.05f) mP[kZ] += dx*(r2 + f2*dy2dx)*GetTgl();
@@ -361,32 +374,32 @@ bool TrackParCov::PropagateTo(float xk, float b)
     &c30=mC[kSigTglY],  &c31=mC[kSigTglZ],  &c32=mC[kSigTglSnp],  &c33=mC[kSigTgl2],
     &c40=mC[kSigQ2PtY], &c41=mC[kSigQ2PtZ], &c42=mC[kSigQ2PtSnp], &c43=mC[kSigQ2PtTgl], &c44=mC[kSigQ2Pt2];
 
-  // evaluate matrix in double prec.
-  double rinv  = 1./r1;
-  double r3inv = rinv*rinv*rinv;
-  double f24   = dx*b*kB2C; // x2r/mC[kQ2Pt];
-  double f02   = dx*r3inv;
-  double f04   = 0.5*f24*f02;
-  double f12   = f02*GetTgl()*f1;
-  double f14   = 0.5*f24*f12; //0.5*f24*f02*GetTgl()*f1;
-  double f13   = dx*rinv;
+  // evaluate matrix in the policy precision
+  Inter rinv  = Inter(1)/r1;
+  Inter r3inv = rinv*rinv*rinv;
+  Inter f24   = dx*b*kB2C; // x2r/mC[kQ2Pt];
+  Inter f02   = dx*r3inv;
+  Inter f04   = Inter(0.5)*f24*f02;
+  Inter f12   = f02*GetTgl()*f1;
+  Inter f14   = Inter(0.5)*f24*f12; //0.5*f24*f02*GetTgl()*f1;
+  Inter f13   = dx*rinv;
 
   //b = C*ft
-  double b00=f02*c20 + f04*c40, b01=f12*c20 + f14*c40 + f13*c30;
-  double b02=f24*c40;
-  double b10=f02*c21 + f04*c41, b11=f12*c21 + f14*c41 + f13*c31;
-  double b12=f24*c41;
-  double b20=f02*c22 + f04*c42, b21=f12*c22 + f14*c42 + f13*c32;
-  double b22=f24*c42;
-  double b40=f02*c42 + f04*c44, b41=f12*c42 + f14*c44 + f13*c43;
-  double b42=f24*c44;
-  double b30=f02*c32 + f04*c43, b31=f12*c32 + f14*c43 + f13*c33;
-  double b32=f24*c43;
+  Inter b00=f02*c20 + f04*c40, b01=f12*c20 + f14*c40 + f13*c30;
+  Inter b02=f24*c40;
+  Inter b10=f02*c21 + f04*c41, b11=f12*c21 + f14*c41 + f13*c31;
+  Inter b12=f24*c41;
+  Inter b20=f02*c22 + f04*c42, b21=f12*c22 + f14*c42 + f13*c32;
+  Inter b22=f24*c42;
+  Inter b40=f02*c42 + f04*c44, b41=f12*c42 + f14*c44 + f13*c43;
+  Inter b42=f24*c44;
+  Inter b30=f02*c32 + f04*c43, b31=f12*c32 + f14*c43 + f13*c33;
+  Inter b32=f24*c43;
 
   //a = f*b = f*C*ft
-  double a00=f02*b20+f04*b40,a01=f02*b21+f04*b41,a02=f02*b22+f04*b42;
-  double a11=f12*b21+f14*b41+f13*b31,a12=f12*b22+f14*b42+f13*b32;
-  double a22=f24*b42;
+  Inter a00=f02*b20+f04*b40,a01=f02*b21+f04*b41,a02=f02*b22+f04*b42;
+  Inter a11=f12*b21+f14*b41+f13*b31,a12=f12*b22+f14*b42+f13*b32;
+  Inter a22=f24*b42;
 
   //F*C*Ft = C + (b + bt + a)
   c00 += b00 + b00 + a00;
@@ -859,62 +872,142 @@ bool TrackParCov::Update(const array<float,2> &p, const array<float,3> &cov)
 {
   // Update the track parameters with the space point "p" having
   // the covariance matrix "cov"
+  if (!UpdateNoCheck(p,cov)) return false;
+  CheckCovariance();
+  return true;
+}
 
-  float
-    &cm00=mC[kSigY2],
-    &cm10=mC[kSigZY],    &cm11=mC[kSigZ2],
-    &cm20=mC[kSigSnpY],  &cm21=mC[kSigSnpZ],  &cm22=mC[kSigSnp2],
-    &cm30=mC[kSigTglY],  &cm31=mC[kSigTglZ],  &cm32=mC[kSigTglSnp],  &cm33=mC[kSigTgl2],
-    &cm40=mC[kSigQ2PtY], &cm41=mC[kSigQ2PtZ], &cm42=mC[kSigQ2PtSnp], &cm43=mC[kSigQ2PtTgl], &cm44=mC[kSigQ2Pt2];
+//______________________________________________
+bool TrackParCov::UpdateBulk(const array<float,2> *p, const array<float,3> *cov, int nUpd)
+{
+  // Update the track with nUpd consecutive space points, running the
+  // covariance sanity clamps only once at the end instead of after every
+  // update. The clamps only ever fire on pathological tracks, so deferring
+  // them does not change the result on the healthy ones while removing the
+  // branchy validation from the inner refit loop.
+  for (int i=0;i<nUpd;i++) {
+    if (!UpdateNoCheck(p[i],cov[i])) return false;
+  }
+  CheckCovariance();
+  return true;
+}
 
-  // use double precision?
-  double r00=cov[0]+cm00, r01=cov[1]+cm10, r11=cov[2]+cm11;
-  double det=r00*r11 - r01*r01;
+//______________________________________________
+namespace {
+
+// Kalman update arithmetic shared by all the Update entry points: operates
+// on the working parameter/covariance arrays the caller keeps in the policy
+// accumulator type for the duration of the operation (one update for Update,
+// the whole sequence for UpdateBulk)
+template <class P>
+bool UpdateWork(typename P::Acc *par, typename P::Acc *cv, const array<float,2> &p, const array<float,3> &cov)
+{
+  using Inter = typename P::Inter;
+
+  const Inter
+    cm00=cv[kSigY2],
+    cm10=cv[kSigZY],    cm11=cv[kSigZ2],
+    cm20=cv[kSigSnpY],  cm21=cv[kSigSnpZ],
+    cm30=cv[kSigTglY],  cm31=cv[kSigTglZ],
+    cm40=cv[kSigQ2PtY], cm41=cv[kSigQ2PtZ];
+
+  Inter r00=cov[0]+cm00, r01=cov[1]+cm10, r11=cov[2]+cm11;
+  Inter det=r00*r11 - r01*r01;
 
   if (fabs(det) < kAlmost0) return false;
-  double detI = 1./det;
-  double tmp=r00;
+  Inter detI = Inter(1)/det;
+  Inter tmp=r00;
   r00 = r11*detI;
   r11 = tmp*detI;
   r01 = -r01*detI;
 
-  double k00 = cm00*r00+cm10*r01, k01 = cm00*r01+cm10*r11;
-  double k10 = cm10*r00+cm11*r01, k11 = cm10*r01+cm11*r11;
-  double k20 = cm20*r00+cm21*r01, k21 = cm20*r01+cm21*r11;
-  double k30 = cm30*r00+cm31*r01, k31 = cm30*r01+cm31*r11;
-  double k40 = cm40*r00+cm41*r01, k41 = cm40*r01+cm41*r11;
+  Inter k00 = cm00*r00+cm10*r01, k01 = cm00*r01+cm10*r11;
+  Inter k10 = cm10*r00+cm11*r01, k11 = cm10*r01+cm11*r11;
+  Inter k20 = cm20*r00+cm21*r01, k21 = cm20*r01+cm21*r11;
+  Inter k30 = cm30*r00+cm31*r01, k31 = cm30*r01+cm31*r11;
+  Inter k40 = cm40*r00+cm41*r01, k41 = cm40*r01+cm41*r11;
 
-  double dy = p[kY] - GetY(), dz=p[kZ] - GetZ();
-  double sf= GetSnp() + k20*dy + k21*dz;
+  Inter dy = p[kY] - Inter(par[kY]), dz = p[kZ] - Inter(par[kZ]);
+  Inter sf = Inter(par[kSnp]) + k20*dy + k21*dz;
   if (fabs(sf) > kAlmost1) return false;
 
-  mP[kY]    += k00*dy + k01*dz;
-  mP[kZ]    += k10*dy + k11*dz;
-  mP[kSnp]   = sf;
-  mP[kTgl]  += k30*dy + k31*dz;
-  mP[kQ2Pt] += k40*dy + k41*dz;
+  par[kY]    += k00*dy + k01*dz;
+  par[kZ]    += k10*dy + k11*dz;
+  par[kSnp]   = sf;
+  par[kTgl]  += k30*dy + k31*dz;
+  par[kQ2Pt] += k40*dy + k41*dz;
+
+  cv[kSigY2]     -= k00*cm00+k01*cm10;
+  cv[kSigZY]     -= k00*cm10+k01*cm11;
+  cv[kSigSnpY]   -= k00*cm20+k01*cm21;
+  cv[kSigTglY]   -= k00*cm30+k01*cm31;
+  cv[kSigQ2PtY]  -= k00*cm40+k01*cm41;
 
-  double c01=cm10, c02=cm20, c03=cm30, c04=cm40;
-  double c12=cm21, c13=cm31, c14=cm41;
+  cv[kSigZ2]     -= k10*cm10+k11*cm11;
+  cv[kSigSnpZ]   -= k10*cm20+k11*cm21;
+  cv[kSigTglZ]   -= k10*cm30+k11*cm31;
+  cv[kSigQ2PtZ]  -= k10*cm40+k11*cm41;
 
-  cm00-=k00*cm00+k01*cm10; cm10-=k00*c01+k01*cm11;
-  cm20-=k00*c02+k01*c12;   cm30-=k00*c03+k01*c13;
-  cm40-=k00*c04+k01*c14;
+  cv[kSigSnp2]   -= k20*cm20+k21*cm21;
+  cv[kSigTglSnp] -= k20*cm30+k21*cm31;
+  cv[kSigQ2PtSnp]-= k20*cm40+k21*cm41;
 
-  cm11-=k10*c01+k11*cm11;
-  cm21-=k10*c02+k11*c12;   cm31-=k10*c03+k11*c13;
-  cm41-=k10*c04+k11*c14;
+  cv[kSigTgl2]   -= k30*cm30+k31*cm31;
+  cv[kSigQ2PtTgl]-= k30*cm40+k31*cm41;
 
-  cm22-=k20*c02+k21*c12;   cm32-=k20*c03+k21*c13;
-  cm42-=k20*c04+k21*c14;
+  cv[kSigQ2Pt2]  -= k40*cm40+k41*cm41;
+
+  return true;
+}
 
-  cm33-=k30*c03+k31*c13;
-  cm43-=k30*c04+k31*c14;
+} // anonymous namespace
 
-  cm44-=k40*c04+k41*c14;
+//______________________________________________
+bool TrackParCov::UpdateNoCheck(const array<float,2> &p, const array<float,3> &cov)
+{
+  // Kalman update arithmetic shared by Update and UpdateBulk, the caller is
+  // responsible for running CheckCovariance afterwards
+  double par[kNParams], cv[kCovMatSize];
+  for (int i=kNParams;i--;)   par[i] = mP[i];
+  for (int i=kCovMatSize;i--;) cv[i] = mC[i];
+  if (!UpdateWork<Precision::ExactDouble>(par,cv,p,cov)) return false;
+  for (int i=kNParams;i--;)   mP[i] = float(par[i]);
+  for (int i=kCovMatSize;i--;) mC[i] = float(cv[i]);
+  return true;
+}
 
+//______________________________________________
+template <class P>
+bool TrackParCov::Update(const array<float,2> &p, const array<float,3> &cov)
+{
+  // Kalman update in the chosen precision policy
+  typename P::Acc par[kNParams], cv[kCovMatSize];
+  for (int i=kNParams;i--;)   par[i] = mP[i];
+  for (int i=kCovMatSize;i--;) cv[i] = mC[i];
+  if (!UpdateWork<P>(par,cv,p,cov)) return false;
+  for (int i=kNParams;i--;)   mP[i] = float(par[i]);
+  for (int i=kCovMatSize;i--;) mC[i] = float(cv[i]);
   CheckCovariance();
+  return true;
+}
 
+//______________________________________________
+template <class P>
+bool TrackParCov::UpdateBulk(const array<float,2> *p, const array<float,3> *cov, int nUpd)
+{
+  // Bulk update in the chosen precision policy: the working parameters and
+  // covariance stay in the policy accumulator across the whole sequence, so
+  // the CompensatedFloat compensation (or the ExactDouble precision) is not
+  // rounded back to float between the updates
+  typename P::Acc par[kNParams], cv[kCovMatSize];
+  for (int i=kNParams;i--;)   par[i] = mP[i];
+  for (int i=kCovMatSize;i--;) cv[i] = mC[i];
+  for (int i=0;i<nUpd;i++) {
+    if (!UpdateWork<P>(par,cv,p[i],cov[i])) return false;
+  }
+  for (int i=kNParams;i--;)   mP[i] = float(par[i]);
+  for (int i=kCovMatSize;i--;) mC[i] = float(cv[i]);
+  CheckCovariance();
   return true;
 }
 
@@ -1127,3 +1220,17 @@ float AliceO2::Base::Track::BetheBlochSolid(float bg, float rho,float kp1,float
   }
   return mK*meanZA*(1+bg2)/bg2*(0.5*log(2*me*bg2*maxT/(meanI*meanI)) - bg2/(1+bg2) - d2);
 }
+
+//______________________________________________________________
+// instantiate the precision-policy variants for the trackers
+namespace AliceO2 { namespace Base { namespace Track {
+template bool TrackParCov::PropagateTo<Precision::FastFloat>(float xk, float b);
+template bool TrackParCov::PropagateTo<Precision::ExactDouble>(float xk, float b);
+template bool TrackParCov::PropagateTo<Precision::CompensatedFloat>(float xk, float b);
+template bool TrackParCov::Update<Precision::FastFloat>(const array<float,2> &p, const array<float,3> &cov);
+template bool TrackParCov::Update<Precision::ExactDouble>(const array<float,2> &p, const array<float,3> &cov);
+template bool TrackParCov::Update<Precision::CompensatedFloat>(const array<float,2> &p, const array<float,3> &cov);
+template bool TrackParCov::UpdateBulk<Precision::FastFloat>(const array<float,2> *p, const array<float,3> *cov, int nUpd);
+template bool TrackParCov::UpdateBulk<Precision::ExactDouble>(const array<float,2> *p, const array<float,3> *cov, int nUpd);
+template bool TrackParCov::UpdateBulk<Precision::CompensatedFloat>(const array<float,2> *p, const array<float,3> *cov, int nUpd);
+}}}
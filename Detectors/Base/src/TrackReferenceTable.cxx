@@ -0,0 +1,52 @@
+/// \file TrackReferenceTable.cxx
+/// \brief Implementation of the sorted track reference storage
+
+#include "DetectorsBase/TrackReferenceTable.h"
+
+#include <TClonesArray.h>
+#include <algorithm>
+
+using namespace AliceO2::Base;
+
+void TrackReferenceTable::build(const TClonesArray& references)
+{
+  clear();
+  Int_t numOfReferences = references.GetEntriesFast();
+  if (numOfReferences < 1) {
+    return;
+  }
+
+  // sort indices instead of the objects, the stable sort keeps the
+  // creation order along the trajectory within a track
+  std::vector<Int_t> order(numOfReferences);
+  for (Int_t i = 0; i < numOfReferences; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&references](Int_t a, Int_t b) {
+    return static_cast<TrackReference*>(references.UncheckedAt(a))->GetTrack() <
+           static_cast<TrackReference*>(references.UncheckedAt(b))->GetTrack();
+  });
+
+  mReferences.reserve(numOfReferences);
+  for (Int_t i = 0; i < numOfReferences; i++) {
+    TrackReference* ref = static_cast<TrackReference*>(references.UncheckedAt(order[i]));
+    if (mTrackIds.empty() || mTrackIds.back() != ref->GetTrack()) {
+      mTrackIds.push_back(ref->GetTrack());
+      mOffsets.push_back(i);
+    }
+    mReferences.push_back(*ref);
+  }
+  mOffsets.push_back(numOfReferences);
+}
+
+const TrackReference* TrackReferenceTable::getReferences(Int_t trackId, Int_t& n) const
+{
+  auto it = std::lower_bound(mTrackIds.begin(), mTrackIds.end(), trackId);
+  if (it == mTrackIds.end() || *it != trackId) {
+    n = 0;
+    return nullptr;
+  }
+  Int_t position = it - mTrackIds.begin();
+  n = mOffsets[position + 1] - mOffsets[position];
+  return mReferences.data() + mOffsets[position];
+}
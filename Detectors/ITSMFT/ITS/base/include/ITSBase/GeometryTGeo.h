@@ -6,6 +6,8 @@
 #ifndef ALICEO2_ITS_GEOMETRYTGEO_H_
 #define ALICEO2_ITS_GEOMETRYTGEO_H_
 
+#include <vector>
+
 #include <TGeoMatrix.h> // for TGeoHMatrix
 #include <TObjArray.h>  // for TObjArray
 #include <TObject.h>    // for TObject
@@ -198,13 +200,24 @@ class GeometryTGeo : public TObject
 
   Bool_t getTrackingMatrix(Int_t lay, Int_t sta, Int_t det, TGeoHMatrix& m);
 
+  /// Extract the transformations of all sensors into a flat array of 3x4
+  /// matrices (row-major rotation with the translation as the 4th column),
+  /// indexed by chip index. The Float_t transformation overloads below apply
+  /// the cached matrices inline, without going through the TGeoHMatrix
+  /// machinery; the cache is filled on their first use
+  void fillMatrixCache();
+
   // Attention: these are transformations wrt sensitive volume!
   void localToGlobal(Int_t index, const Double_t* loc, Double_t* glob);
 
+  void localToGlobal(Int_t index, const Float_t* loc, Float_t* glob);
+
   void localToGlobal(Int_t lay, Int_t sta, Int_t det, const Double_t* loc, Double_t* glob);
 
   void globalToLocal(Int_t index, const Double_t* glob, Double_t* loc);
 
+  void globalToLocal(Int_t index, const Float_t* glob, Float_t* loc);
+
   void globalToLocal(Int_t lay, Int_t sta, Int_t det, const Double_t* glob, Double_t* loc);
 
   void localToGlobalVector(Int_t index, const Double_t* loc, Double_t* glob);
@@ -342,6 +355,7 @@ class GeometryTGeo : public TObject
   TObjArray* mSensorMatrices;          ///< Sensor's matrices pointers in the geometry
   TObjArray* mTrackingToLocalMatrices; ///< Tracking to Local matrices pointers in the geometry
   TObjArray* mSegmentations;           ///< segmentations
+  std::vector<Float_t> mMatrixCache;   //!< flat 3x4 sensor matrices, 12 floats per chip
 
   static UInt_t mUIDShift;                   ///< bit shift to go from mod.id to modUUID for TGeo
   static TString mVolumeName;                ///< Mother volume name
@@ -441,6 +455,32 @@ inline void GeometryTGeo::globalToLocal(Int_t index, const Double_t* glob, Doubl
   getMatrixSensor(index)->MasterToLocal(glob, loc);
 }
 
+/// Sensor local to global, applying the flat matrix cache
+inline void GeometryTGeo::localToGlobal(Int_t index, const Float_t* loc, Float_t* glob)
+{
+  if (mMatrixCache.empty()) {
+    fillMatrixCache();
+  }
+  const Float_t* m = &mMatrixCache[12 * index];
+  glob[0] = m[0] * loc[0] + m[1] * loc[1] + m[2] * loc[2] + m[3];
+  glob[1] = m[4] * loc[0] + m[5] * loc[1] + m[6] * loc[2] + m[7];
+  glob[2] = m[8] * loc[0] + m[9] * loc[1] + m[10] * loc[2] + m[11];
+}
+
+/// Global to sensor local, applying the flat matrix cache
+inline void GeometryTGeo::globalToLocal(Int_t index, const Float_t* glob, Float_t* loc)
+{
+  if (mMatrixCache.empty()) {
+    fillMatrixCache();
+  }
+  const Float_t* m = &mMatrixCache[12 * index];
+  // the rotation is orthogonal, so the inverse is the transpose
+  Float_t d0 = glob[0] - m[3], d1 = glob[1] - m[7], d2 = glob[2] - m[11];
+  loc[0] = m[0] * d0 + m[4] * d1 + m[8] * d2;
+  loc[1] = m[1] * d0 + m[5] * d1 + m[9] * d2;
+  loc[2] = m[2] * d0 + m[6] * d1 + m[10] * d2;
+}
+
 /// Sensor local to global
 inline void GeometryTGeo::localToGlobalVector(Int_t index, const Double_t* loc, Double_t* glob)
 {
@@ -189,6 +189,7 @@ GeometryTGeo& GeometryTGeo::operator=(const GeometryTGeo& src)
     mVersion = src.mVersion;
     mNumberOfLayers = src.mNumberOfLayers;
     mNumberOfChips = src.mNumberOfChips;
+    mMatrixCache = src.mMatrixCache;
     if (src.mSensorMatrices) {
       delete mSensorMatrices;
       mSensorMatrices = new TObjArray(mNumberOfChips);
@@ -942,6 +943,27 @@ void GeometryTGeo::fetchMatrices()
   createT2LMatrices();
 }
 
+void GeometryTGeo::fillMatrixCache()
+{
+  mMatrixCache.resize(12 * mNumberOfChips);
+  for (int i = 0; i < mNumberOfChips; i++) {
+    const TGeoHMatrix* matSens = getMatrixSensor(i);
+    if (!matSens) {
+      LOG(FATAL) << "Failed to get matrix for sensor " << i << FairLogger::endl;
+      return;
+    }
+    const Double_t* rot = matSens->GetRotationMatrix();
+    const Double_t* tra = matSens->GetTranslation();
+    Float_t* m = &mMatrixCache[12 * i];
+    for (int r = 0; r < 3; r++) {
+      m[4 * r + 0] = rot[3 * r + 0];
+      m[4 * r + 1] = rot[3 * r + 1];
+      m[4 * r + 2] = rot[3 * r + 2];
+      m[4 * r + 3] = tra[r];
+    }
+  }
+}
+
 void GeometryTGeo::createT2LMatrices()
 {
   // create tracking to local (Sensor!) matrices
@@ -33,10 +33,13 @@ namespace AliceO2 {
           // Possibly, other public functions
           float    GetMaterialBudget(const double* p0, const double* p1, double& x2x0, double& rhol) const;
           bool     GetSAonly() const { return mSAonly; }
+          void     SetBz(float bz) { mBz = bz; }
           void     SetChi2Cut(float cut) { mChi2Cut = cut; }
           void     SetPhiCut(float cut) { mPhiCut = cut; }
           void     SetSAonly(bool sa = true) { mSAonly = sa; }
           void     SetZCut(float cut) { mZCut = cut; }
+          void     SetNumberOfThreads(int n) { mNumOfThreads = n; }
+          int      GetNumberOfThreads() const { return mNumOfThreads; }
           //
           float    GetX() const { return mVertex[0]; }
           float    GetY() const { return mVertex[1]; }
@@ -61,8 +64,15 @@ namespace AliceO2 {
           float                 mZCut;
           std::vector<Doublets>      mDoublets[6];
           std::vector<Cell>          mCells[5];
+          // CSR adjacency between consecutive cell layers: the neighbours of
+          // mCells[l+1][i] - indices into mCells[l] - are the entries
+          // mCellNeighbours[l][mCellNeighbourStart[l][i]] up to (excluded)
+          // mCellNeighbours[l][mCellNeighbourStart[l][i+1]]
+          std::vector<int>           mCellNeighbourStart[4];
+          std::vector<int>           mCellNeighbours[4];
           std::vector<Track>         mCandidates[4];
           bool                  mSAonly;             // true if the standalone tracking only
+          int                   mNumOfThreads;       // number of threads used by MakeCells
           // Cuts
           float mCPhi;
           float mCDTanL;
@@ -59,9 +59,14 @@ namespace AliceO2 {
           void GetBinZPhi(int ipz,int &iz,int &iphi) const {iz = GetBinZ(ipz); iphi=GetBinPhi(ipz);}
           //
           int  SelectClusters(float zmin,float zmax,float phimin,float phimax);
+          // reentrant variant: the occupied bins of the query zone go to the
+          // caller-provided vector, no iterator state is touched, so several
+          // threads can query the same station concurrently
+          int  SelectClusters(float zmin,float zmax,float phimin,float phimax, std::vector<int> &foundBins) const;
           int  GetNFoundBins()                  const {return mFoundBins.size();}
           int  GetFoundBin(int i)               const {return mFoundBins[i];}
           int  GetFoundBinClusters(int i, int &first)  const;
+          int  GetBinClusters(int binID, int &first)   const;
           void ResetFoundIterator();
           const ClsInfo_t& GetClusterInfo(int i) const {return mSortedClInfo[i];}
           ClsInfo_t* GetNextClusterInfo();
@@ -115,6 +120,14 @@ namespace AliceO2 {
         return bin.ncl;
       }
 
+      inline int TrackingStation::GetBinClusters(int binID, int &first)  const {
+        // set the entry of the first cl.info of the given bin and return its
+        // number of clusters
+        ClBinInfo_t& bin = mBins[binID];
+        first = bin.first;
+        return bin.ncl;
+      }
+
       inline ClsInfo_t* TrackingStation::GetNextClusterInfo() {
         // return cluster info for next matching cluster
         int id = GetNextClusterInfoID();
@@ -11,33 +11,32 @@ namespace AliceO2 {
   namespace ITS {
     namespace CA {
 
+      // A cell is a fixed-size record: the links to the neighbouring cells of
+      // the previous layer live in the flat CSR adjacency owned by the
+      // tracker, not in the cell itself, so a vector of cells is one
+      // contiguous block of memory.
       class Cell {
         public:
           Cell(int xx = 0u,int yy = 0u, int zz = 0u, int dd0 = 0,
               int dd1 = 0, float curv = 0.f, std::array<float,3> n = {0.f});
 
-          int x() const { return mVector[0]; }
-          int y() const { return mVector[1]; }
-          int z() const { return mVector[2]; }
+          int x() const { return mX; }
+          int y() const { return mY; }
+          int z() const { return mZ; }
           int d0() const { return md0; }
           int d1() const { return md1; }
-          int GetLevel() const { return mVector[3]; }
+          int GetLevel() const { return mLevel; }
           float GetCurvature() const { return m1OverR; }
-          std::array<float,3>& GetN() { return mN; }
+          const std::array<float,3>& GetN() const { return mN; }
 
-          void SetLevel(int lev) { mVector[3] = lev; }
-
-          int operator()(const int i) { return mVector[4 + i]; }
-
-          std::vector<int>::size_type NumberOfNeighbours() { return (mVector.size() - 4u); }
-
-          bool Combine(Cell &neigh, int idd);
+          void SetLevel(int lev) { mLevel = lev; }
 
         private:
           float m1OverR;
           int md0,md1;
           std::array<float,3> mN;
-          std::vector<int> mVector;
+          int mX,mY,mZ;
+          int mLevel;
       };
 
       class Road {
@@ -0,0 +1,76 @@
+/// \file ClusterErrorTable.h
+/// \brief Parameterized position errors of the ITS clusters
+#ifndef ALICEO2_ITS_CLUSTERERRORTABLE_H
+#define ALICEO2_ITS_CLUSTERERRORTABLE_H
+
+#include <vector>
+
+#include "Rtypes.h"
+
+namespace AliceO2
+{
+namespace ITS
+{
+class Cluster;
+class GeometryTGeo;
+
+/// Error tables replacing the fixed pitch/sqrt(12) constants assigned by the
+/// clusterers: per layer, the sigma^2 of the cluster position is tabulated in
+/// bins of the cluster span and of the track incidence angle, the latter
+/// estimated from the cluster position assuming a primary track. The tables
+/// are filled with a pitch-based default parameterization at init and can be
+/// overwritten bin by bin with tuned values. The application is one batched
+/// pass over the contiguous cluster output of the clusterer, with clamped
+/// bin arithmetic instead of per-cluster branching, so it stays off the
+/// clusterization critical path.
+class ClusterErrorTable
+{
+ public:
+  enum {
+    kNLayers = 7,   ///< ITS layers
+    kNSizeBins = 4, ///< cluster span bins: 1, 2, 3 and >=4 pixels
+    kNAngleBins = 8 ///< |tan(lambda)| bins over 0..kMaxTanLambda
+  };
+
+  ClusterErrorTable();
+
+  /// geometry for the chip-to-layer mapping and the chip positions entering
+  /// the incidence angle estimate; must be built before apply
+  void setGeometry(GeometryTGeo* geom) { mGeom = geom; }
+
+  /// Fills every bin from the pitch-based default parameterization
+  void init(Float_t pitchX, Float_t pitchZ);
+
+  Bool_t isInitialized() const { return !mSigmaY2.empty(); }
+
+  /// Overwrites one bin, e.g. with values tuned on data
+  void setEntry(Int_t layer, Int_t sizeBin, Int_t angleBin, Float_t sigmaY2, Float_t sigmaZ2);
+
+  Float_t getSigmaY2(Int_t layer, Int_t sizeBin, Int_t angleBin) const
+  {
+    return mSigmaY2[binIndex(layer, sizeBin, angleBin)];
+  }
+  Float_t getSigmaZ2(Int_t layer, Int_t sizeBin, Int_t angleBin) const
+  {
+    return mSigmaZ2[binIndex(layer, sizeBin, angleBin)];
+  }
+
+  /// Rewrites the errors of n contiguous local-frame clusters, grouped by
+  /// chip as the clusterers emit them
+  void apply(Cluster* clusters, Int_t n) const;
+
+ private:
+  Int_t binIndex(Int_t layer, Int_t sizeBin, Int_t angleBin) const
+  {
+    return (layer * kNSizeBins + sizeBin) * kNAngleBins + angleBin;
+  }
+
+  GeometryTGeo* mGeom;          ///< geometry for layers and chip positions, not owned
+  Float_t mInvAngleStep;        ///< angle bins per unit of |tan(lambda)|
+  std::vector<Float_t> mSigmaY2; ///< sigma^2 along the rows, (layer, size, angle) bins
+  std::vector<Float_t> mSigmaZ2; ///< sigma^2 along the beam, (layer, size, angle) bins
+};
+}
+}
+
+#endif /* ALICEO2_ITS_CLUSTERERRORTABLE_H */
@@ -0,0 +1,66 @@
+/// \file ClusterLabels.h
+/// \brief Compact MC truth container for cluster-to-track matching
+///
+/// The Monte Carlo labels of all clusters of an event are copied once into
+/// a flat array with a CSR-style index from the cluster id. The truth
+/// matching of candidate tracks then runs over contiguous memory, without
+/// getting the cluster objects out of the TClonesArray again for every
+/// candidate.
+
+#ifndef ALICEO2_ITS_CLUSTERLABELS_H
+#define ALICEO2_ITS_CLUSTERLABELS_H
+
+#include "Rtypes.h"
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2
+{
+namespace ITS
+{
+
+class ClusterLabels
+{
+ public:
+  ClusterLabels() = default;
+
+  /// Drop the content but keep the allocations
+  void clear()
+  {
+    mLabels.clear();
+    mOffsets.clear();
+  }
+
+  /// Extract the label triplets of all clusters in one pass; the cluster
+  /// id is the position in the array, unset labels (negative) are skipped
+  void fill(const TClonesArray& clusters);
+
+  /// Append the labels of the next cluster
+  /// @return the id assigned to the cluster
+  Int_t addCluster(const Int_t* labels, Int_t n);
+
+  Int_t getNumberOfClusters() const { return mOffsets.empty() ? 0 : mOffsets.size() - 1; }
+  Int_t getNumberOfLabels(Int_t clusterId) const { return mOffsets[clusterId + 1] - mOffsets[clusterId]; }
+  const Int_t* getLabels(Int_t clusterId) const { return mLabels.data() + mOffsets[clusterId]; }
+
+  /// Majority label over the clusters of one candidate, with the semantics
+  /// of CookedTracker::cookLabel: the first label of every cluster votes,
+  /// the other labels of the triplet count as correct assignments, and a
+  /// label returned negative indicates that the fraction of clusters not
+  /// matching the majority exceeds wrong
+  Int_t cookLabel(const Int_t* clusterIds, Int_t n, Float_t wrong) const;
+
+  /// Majority labels for a batch of candidate tracks in CSR form: offsets
+  /// has one entry per track plus one, indices holds the concatenated
+  /// cluster ids, as stored by the columnar track output
+  void cookLabels(const std::vector<Int_t>& offsets, const std::vector<Int_t>& indices,
+                  Float_t wrong, std::vector<Int_t>& labels) const;
+
+ private:
+  std::vector<Int_t> mLabels;  ///< valid labels of all clusters, back to back
+  std::vector<Int_t> mOffsets; ///< CSR-style offsets from the cluster id, nClusters+1 entries
+};
+}
+}
+#endif /* ALICEO2_ITS_CLUSTERLABELS_H */
@@ -0,0 +1,218 @@
+/// \file ColumnarRecoIO.h
+/// \brief Columnar, TClonesArray-free I/O for the ITS reconstruction products
+///
+/// Parallel output path next to the FairRootManager branches: the tracks and
+/// clusters of an event are split into per-quantity column blocks on the
+/// processing thread, queued, and compressed and written as pages by a
+/// dedicated I/O thread, so the branch-fill cost leaves the main thread.
+/// The reader decompresses a column on first access and hands it out as a
+/// span (pointer + count) into contiguous memory.
+///
+/// File layout (all fields host byte order):
+///   [8 byte magic]
+///   [PageHeader][compressed column bytes] ...      one page per column block
+///   [directory: page count, one PageRecord per page]
+///   [8 byte directory offset][8 byte magic]        fixed-size trailer
+/// A page whose compressed size equals its raw size is stored uncompressed.
+/// The directory is written on close; a file without trailer (crashed job)
+/// is rejected by the reader.
+
+#ifndef ALICEO2_ITS_COLUMNARRECOIO_H
+#define ALICEO2_ITS_COLUMNARRECOIO_H
+
+#include "Rtypes.h"
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2
+{
+namespace ITS
+{
+/// product a column belongs to
+enum EColumnProduct { kProductTracks = 0, kProductClusters = 1 };
+
+/// track columns; par and cov blocks follow the TrackParCov conventions
+/// (5 parameters Y, Z, sin(phi), tg(lambda), q/pT; 15 lower-triangle
+/// covariance elements), so a track can be rebuilt via the CookedTrack
+/// constructor. Cluster attachments are a CSR pair: offsets has one entry
+/// per track plus one, indices holds the concatenated cluster indices
+enum ETrackColumn {
+  kTrackX = 0,          ///< Float_t, X of the track frame
+  kTrackAlpha,          ///< Float_t, track frame angle
+  kTrackPar,            ///< Float_t, 5 per track
+  kTrackCov,            ///< Float_t, 15 per track
+  kTrackChi2,           ///< Float_t
+  kTrackLabel,          ///< Int_t, Monte Carlo label
+  kTrackClusterOffsets, ///< Int_t, nTracks+1 offsets into the indices column
+  kTrackClusterIndices, ///< Int_t, concatenated cluster indices
+  kNTrackColumns
+};
+
+/// cluster columns, tracking-frame coordinates as stored in the cluster
+enum EClusterColumn {
+  kClusterX = 0,    ///< Float_t
+  kClusterY,        ///< Float_t
+  kClusterZ,        ///< Float_t
+  kClusterSigmaY2,  ///< Float_t
+  kClusterSigmaZ2,  ///< Float_t
+  kClusterSigmaYZ,  ///< Float_t
+  kClusterVolumeId, ///< UShort_t
+  kClusterLabel,    ///< Int_t, first Monte Carlo label
+  kNClusterColumns
+};
+
+/// \class ColumnarRecoWriter
+/// \brief Asynchronous columnar writer for track/cluster products
+///
+/// writeTracks/writeClusters only copy the product fields into column
+/// blocks and enqueue them; compression (zlib, fastest level - the column
+/// data still shrinks well) and file writes happen on the writer thread.
+/// The queue holds at most kMaxQueuedEvents events, so a slow disk
+/// backpressures the producer instead of growing memory without bound.
+/// close() drains the queue, writes the directory and joins the thread.
+class ColumnarRecoWriter
+{
+ public:
+  ColumnarRecoWriter();
+  ~ColumnarRecoWriter();
+
+  ColumnarRecoWriter(const ColumnarRecoWriter&) = delete;
+  ColumnarRecoWriter& operator=(const ColumnarRecoWriter&) = delete;
+
+  /// opens the output file and starts the writer thread
+  Bool_t open(const char* filename);
+
+  /// queue the track columns of one event (array of CookedTrack)
+  void writeTracks(Int_t event, const TClonesArray& tracks);
+
+  /// queue the cluster columns of one event (array of Cluster)
+  void writeClusters(Int_t event, const TClonesArray& clusters);
+
+  /// drain the queue, write the directory and close the file;
+  /// kFALSE when any write failed
+  Bool_t close();
+
+ private:
+  /// one column of one event, as handed to the writer thread
+  struct ColumnBlock {
+    UShort_t product;       ///< EColumnProduct
+    UShort_t column;        ///< ETrackColumn or EClusterColumn
+    UInt_t count;           ///< number of elements
+    std::vector<char> data; ///< raw column bytes
+  };
+  struct EventBlock {
+    UInt_t event;
+    std::vector<ColumnBlock> columns;
+  };
+  /// directory record of one written page
+  struct PageRecord {
+    UInt_t event;
+    UShort_t product;
+    UShort_t column;
+    UInt_t count;
+    UInt_t rawSize;
+    UInt_t compressedSize; ///< equal to rawSize when stored uncompressed
+    ULong64_t offset;      ///< file offset of the page payload
+  };
+
+  static const size_t kMaxQueuedEvents = 4;
+
+  void queueEvent(EventBlock&& block);
+  void writerLoop();
+  void writeEvent(const EventBlock& block);
+
+  std::ofstream mFile;                 ///< output file, writer thread only after open
+  std::vector<PageRecord> mDirectory;  ///< written pages, writer thread only
+  std::thread mWriterThread;           ///< compresses and writes queued events
+  std::mutex mMutex;                   ///< guards the queue and flags
+  std::condition_variable mStateChange; ///< queue became non-empty/non-full, or done
+  std::deque<EventBlock> mQueue;       ///< events waiting for the writer thread
+  Bool_t mDone;                        ///< no more events will be queued
+  Bool_t mFailed;                      ///< a file write failed
+};
+
+/// \class ColumnarRecoReader
+/// \brief Span-returning reader for files written by ColumnarRecoWriter
+///
+/// column() decompresses a page on first access and caches it, so the
+/// spans of one event (e.g. x, y and z of the clusters) can be held
+/// simultaneously; they stay valid until close(). Typed accessors below
+/// wrap the raw lookup for the defined columns.
+class ColumnarRecoReader
+{
+ public:
+  ColumnarRecoReader();
+  ~ColumnarRecoReader();
+
+  ColumnarRecoReader(const ColumnarRecoReader&) = delete;
+  ColumnarRecoReader& operator=(const ColumnarRecoReader&) = delete;
+
+  /// opens a file and reads its page directory
+  Bool_t open(const char* filename);
+  void close();
+
+  /// number of events with at least one page
+  Int_t getNEvents() const { return mNEvents; }
+
+  /// span of one column of one event
+  /// \param count On output the number of elements
+  /// \return Pointer to the first element, nullptr if absent or corrupt
+  const void* column(UInt_t event, UShort_t product, UShort_t column, UInt_t& count);
+
+  const Float_t* trackX(UInt_t event, UInt_t& n) { return floats(event, kProductTracks, kTrackX, n); }
+  const Float_t* trackAlpha(UInt_t event, UInt_t& n) { return floats(event, kProductTracks, kTrackAlpha, n); }
+  const Float_t* trackPar(UInt_t event, UInt_t& n) { return floats(event, kProductTracks, kTrackPar, n); }
+  const Float_t* trackCov(UInt_t event, UInt_t& n) { return floats(event, kProductTracks, kTrackCov, n); }
+  const Float_t* trackChi2(UInt_t event, UInt_t& n) { return floats(event, kProductTracks, kTrackChi2, n); }
+  const Int_t* trackLabel(UInt_t event, UInt_t& n) { return ints(event, kProductTracks, kTrackLabel, n); }
+  const Int_t* trackClusterOffsets(UInt_t event, UInt_t& n) { return ints(event, kProductTracks, kTrackClusterOffsets, n); }
+  const Int_t* trackClusterIndices(UInt_t event, UInt_t& n) { return ints(event, kProductTracks, kTrackClusterIndices, n); }
+
+  const Float_t* clusterX(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterX, n); }
+  const Float_t* clusterY(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterY, n); }
+  const Float_t* clusterZ(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterZ, n); }
+  const Float_t* clusterSigmaY2(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterSigmaY2, n); }
+  const Float_t* clusterSigmaZ2(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterSigmaZ2, n); }
+  const Float_t* clusterSigmaYZ(UInt_t event, UInt_t& n) { return floats(event, kProductClusters, kClusterSigmaYZ, n); }
+  const UShort_t* clusterVolumeId(UInt_t event, UInt_t& n) {
+    return static_cast<const UShort_t*>(column(event, kProductClusters, kClusterVolumeId, n));
+  }
+  const Int_t* clusterLabel(UInt_t event, UInt_t& n) { return ints(event, kProductClusters, kClusterLabel, n); }
+
+ private:
+  struct PageRecord {
+    UInt_t event;
+    UShort_t product;
+    UShort_t column;
+    UInt_t count;
+    UInt_t rawSize;
+    UInt_t compressedSize;
+    ULong64_t offset;
+  };
+
+  const Float_t* floats(UInt_t event, UShort_t product, UShort_t col, UInt_t& n) {
+    return static_cast<const Float_t*>(column(event, product, col, n));
+  }
+  const Int_t* ints(UInt_t event, UShort_t product, UShort_t col, UInt_t& n) {
+    return static_cast<const Int_t*>(column(event, product, col, n));
+  }
+  static ULong64_t pageKey(UInt_t event, UShort_t product, UShort_t column) {
+    return (static_cast<ULong64_t>(event) << 32) | (static_cast<ULong64_t>(product) << 16) | column;
+  }
+
+  std::ifstream mFile;                          ///< input file
+  std::map<ULong64_t, PageRecord> mPages;       ///< directory, keyed by (event, product, column)
+  std::map<ULong64_t, std::vector<char>> mLoaded; ///< decompressed columns
+  Int_t mNEvents;                               ///< number of distinct events in the directory
+};
+}
+}
+
+#endif /* ALICEO2_ITS_COLUMNARRECOIO_H */
@@ -26,11 +26,18 @@ class CookedTrack : public TObject
   CookedTrack& operator=(const CookedTrack& tr);
   virtual ~CookedTrack();
 
-  // These functions must be provided
+  // These functions must be provided. The transport/update run in the fast
+  // float precision policy, enough for the cluster attachment decisions
   Double_t getPredictedChi2(const Cluster* c) const;
   Bool_t propagate(Double_t alpha, Double_t x, Double_t bz);
   Bool_t correctForMeanMaterial(Double_t x2x0, Double_t xrho, Bool_t anglecorr = kTRUE);
   Bool_t update(const Cluster* c, Double_t chi2, Int_t idx);
+  // same operations on a cached measurement, without the cluster
+  Double_t getPredictedChi2(Float_t y, Float_t z, const Float_t cov[3]) const;
+  Bool_t update(Float_t y, Float_t z, const Float_t cov[3], Double_t chi2, Int_t idx);
+  // double-precision variants of the same code, for the final refit
+  Bool_t propagatePrecise(Double_t alpha, Double_t x, Double_t bz);
+  Bool_t updatePrecise(Float_t y, Float_t z, const Float_t cov[3], Double_t chi2, Int_t idx);
 
   // Other functions
   Int_t getChi2() const { return mChi2; }
@@ -42,10 +49,13 @@ class CookedTrack : public TObject
 
   void setClusterIndex(Int_t layer, Int_t index);
   void setExternalClusterIndex(Int_t layer, Int_t idx);
+  /// Append an already packed cluster index, for rebuilding from a pool
+  void addClusterIndex(Int_t idx) { mIndex.push_back(idx); }
   void resetClusters();
 
   void setLabel(Int_t lab) { mLabel = lab; }
   Int_t getLabel() const { return mLabel; }
+  void setChi2(Double_t chi2) { mChi2 = chi2; }
   Bool_t isBetter(const CookedTrack& best, Double_t maxChi2) const;
 
   Double_t getCurvature(Double_t bz) const { return mTrack.GetCurvature(float(bz)); }
@@ -58,6 +68,7 @@ class CookedTrack : public TObject
   Double_t getPt() const { return mTrack.GetPt(); }
   Bool_t getPxPyPz(std::array<float,3> &pxyz) const { return mTrack.GetPxPyPz(pxyz); }
   void resetCovariance(Double_t s2 = 0.) { mTrack.ResetCovariance(float(s2)); }
+  const AliceO2::Base::Track::TrackParCov& getTrackParCov() const { return mTrack; }
   
  private:
   AliceO2::Base::Track::TrackParCov mTrack; ///< Base track
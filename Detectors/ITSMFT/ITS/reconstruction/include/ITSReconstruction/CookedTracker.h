@@ -10,12 +10,18 @@
 //    The pattern recongintion based on the "cooked covariance" approach
 //-------------------------------------------------------------------------
 
+#include <atomic>
+#include <future>
 #include <vector>
 
 class TClonesArray;
 
 namespace AliceO2
 {
+namespace Field
+{
+class MagneticField;
+}
 namespace ITS
 {
 class Cluster;
@@ -49,30 +55,56 @@ class CookedTracker
   void cookLabel(CookedTrack& t, Float_t wrong) const;
   void setExternalIndices(CookedTrack& t) const;
   Double_t getBz() const;
+  // z-dependent Bz on the beam axis, used instead of the constant mBz
+  // wherever the track position is at hand; falls back to mBz when no
+  // field object is attached
+  Double_t getBz(Double_t z) const;
   void setBz(Double_t bz) { mBz = bz; }
+  // attaches the field object and refreshes mBz with the on-axis value at
+  // the origin, so the legacy constant-field callers stay consistent
+  void setMagneticField(const AliceO2::Field::MagneticField* fld);
 
   void setNumberOfThreads(Int_t n) { mNumOfThreads=n; }
   Int_t getNumberOfThreads() const { return mNumOfThreads; }
+  Int_t getNumberOfSeeds() const { return mNumberOfSeeds; }
+
+  // vertex-constrained seeding: with the compatibility windows precomputed
+  // for the current vertex, makeSeeds enumerates only bin-compatible
+  // cluster combinations instead of scanning the full z windows
+  void setVertexConstrainedSeeding(Bool_t on) { mVertexConstrainedSeeding = on; }
+  Bool_t getVertexConstrainedSeeding() const { return mVertexConstrainedSeeding; }
   
   // These functions must be implemented
   void process(const TClonesArray& clusters, TClonesArray& tracks);
+  // pipelined interface: loadClusters indexes the seeding layers and kicks
+  // the inner-layer indexing to background threads; processLoadedClusters
+  // starts the seed finding right away and waits for the inner layers only
+  // when the seed extension needs them
+  void loadClusters(const TClonesArray& clusters);
+  void processLoadedClusters(TClonesArray& tracks);
+  void unloadClusters();
+  // outward refit of the tracks stored by processLoadedClusters, in the
+  // order they were stored; runs on the attachment caches recorded during
+  // the inward pass, without touching the layer structures
+  Int_t refitOutward(std::vector<CookedTrack>& tracks);
   // Int_t propagateBack(std::vector<CookedTrack> *event);
   // Int_t RefitInward(std::vector<CookedTrack> *event);
   // Bool_t refitAt(Double_t x, CookedTrack *seed, const CookedTrack *t);
   Cluster* getCluster(Int_t index) const;
 
   // internal helper classes
+  class SeedPool;
+  class RefitEngine;
   class ThreadData;
   class Layer;
 
  protected:
   enum {kNLayers=7};
-  void loadClusters(const TClonesArray& clusters);
-  void unloadClusters();
-  
-  std::vector<CookedTrack> trackInThread(Int_t first, Int_t last);
-  void makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_t last);
-  void trackSeeds(std::vector<CookedTrack> &seeds);
+
+  SeedPool trackInThread(std::atomic<Int_t> *nextChunk, Int_t numOfClusters, ThreadData *data);
+  void prepareSeedingWindows();
+  void makeSeeds(SeedPool &seeds, Int_t first, Int_t last);
+  void trackSeeds(SeedPool &seeds, ThreadData &data);
 
   Bool_t attachCluster(Int_t& volID, Int_t nl, Int_t ci, CookedTrack& t, const CookedTrack& o) const;
 
@@ -80,6 +112,7 @@ class CookedTracker
   Int_t mNumOfThreads; ///< Number of tracking threads
   
   Double_t mBz;///< Effective Z-component of the magnetic field (kG)
+  const AliceO2::Field::MagneticField* mField; ///< Field object for the z-dependent Bz queries, may be nullptr
   Double_t mX; ///< X-coordinate of the primary vertex
   Double_t mY; ///< Y-coordinate of the primary vertex
   Double_t mZ; ///< Z-coordinate of the primary vertex
@@ -88,8 +121,122 @@ class CookedTracker
   Double_t mSigmaY; ///< error of the primary vertex position in Y
   Double_t mSigmaZ; ///< error of the primary vertex position in Z
 
-  static Layer sLayers[kNLayers];  ///< Layers filled with clusters
-  std::vector<CookedTrack> mSeeds; ///< Track seeds
+  Int_t mNumberOfSeeds; ///< Number of seeds made during the last process() call
+
+  // bin-compatibility windows between the seeding layers, rebuilt by
+  // prepareSeedingWindows() for the current vertex
+  Bool_t mVertexConstrainedSeeding; ///< enumerate only bin-compatible seeding combinations
+  Int_t mSectorWindow12;            ///< +- sectors compatible between the two outermost seeding layers
+  Int_t mSectorWindow3;             ///< +- sectors around the predicted third-layer crossing
+  std::vector<Int_t> mZBinFirst12;  ///< per layer-1 z-bin: first compatible layer-2 z-bin
+  std::vector<Int_t> mZBinLast12;   ///< per layer-1 z-bin: last compatible layer-2 z-bin
+
+  static Layer sLayers[kNLayers];   ///< Layers filled with clusters
+  std::vector<CookedTrack> mSeeds;  ///< Track seeds
+  std::vector<ThreadData*> mThreadData; ///< Per-thread scratch data, reused across events
+  std::shared_future<void> mInnerLayersReady; ///< Completion of the background inner-layer indexing
+};
+
+/// Value-type storage of the seeds of one thread. The track parameters live
+/// in SoA arrays and the attached cluster indices in fixed-capacity inline
+/// slots (a track has at most kNLayers clusters), so neither the seeding nor
+/// the result write-back allocates per seed. The processing order groups the
+/// seeds into phi sectors (descending pt within a sector), so consecutive
+/// seeds query neighboring layer bins.
+class CookedTracker::SeedPool
+{
+ public:
+  /// Drop the seeds but keep the allocations
+  void clear();
+  void reserve(Int_t n);
+  Int_t size() const { return Int_t(mPhi.size()); }
+
+  /// Append a cooked seed; phi is the azimuth of the seed position
+  void addSeed(const CookedTrack& t, Float_t phi);
+  /// Rebuild the i-th entry as a CookedTrack, with its label and clusters
+  void getSeed(Int_t i, CookedTrack& t) const;
+  /// Overwrite the i-th entry with the tracking result of its seed
+  void setResult(Int_t i, const CookedTrack& t);
+
+  Int_t getNumberOfClusters(Int_t i) const { return mNumOfClusters[i]; }
+  Int_t getLabel(Int_t i) const { return mLabel[i]; }
+
+  /// Sort the seeds into processing order: phi sectors scanned in order,
+  /// descending pt within a sector
+  void sortForProcessing();
+  const std::vector<Int_t>& getProcessingOrder() const { return mOrder; }
+
+ protected:
+  enum { kNPar = 5, kNCov = 15, kSortSectors = 64 };
+
+  std::vector<Float_t> mX;           ///< track reference X per seed
+  std::vector<Float_t> mAlpha;       ///< tracking-frame angle per seed
+  std::vector<Float_t> mPhi;         ///< azimuth of the seed position, the ordering key
+  std::vector<Float_t> mPt;          ///< transverse momentum, the in-sector priority
+  std::vector<Float_t> mChi2;        ///< chi2 of the entry
+  std::vector<Float_t> mPar;         ///< kNPar track parameters per seed, back to back
+  std::vector<Float_t> mCov;         ///< kNCov covariance elements per seed, back to back
+  std::vector<Int_t> mLabel;         ///< MC label of the entry
+  std::vector<Int_t> mNumOfClusters; ///< clusters attached to the entry
+  std::vector<Int_t> mIndex;         ///< kNLayers inline cluster index slots per seed
+  std::vector<Int_t> mOrder;         ///< seed indices in processing order
+};
+
+class CookedTracker::RefitEngine
+{
+ public:
+  RefitEngine() = default;
+  RefitEngine(const RefitEngine&) = delete;
+  RefitEngine& operator=(const RefitEngine& e) = delete;
+
+  /// Drop the recorded footprints but keep the allocations
+  void clear()
+  {
+    mClusters.clear();
+    mTrackStart.clear();
+  }
+  /// Record the attachment list of a fitted track; must be called while the
+  /// clusters are still loaded and the track indices are still internal
+  void recordFootprint(const CookedTracker& tracker, const CookedTrack& t);
+  Int_t getNumberOfTracks() const { return mTrackStart.empty() ? 0 : mTrackStart.size() - 1; }
+  /// Refit the i-th recorded track outwards, using only the cache
+  Bool_t refitTrack(Int_t i, CookedTrack& t, Double_t bz) const;
+
+ protected:
+  /// Everything the refit needs about one attached cluster: the reference
+  /// plane, the measurement in the tracking frame and the packed index
+  struct AttachedCluster {
+    Float_t xRef;     ///< x of the cluster reference plane
+    Float_t alphaRef; ///< alpha of the cluster reference plane
+    Float_t y;        ///< measured y in the tracking frame
+    Float_t z;        ///< measured z in the tracking frame
+    Float_t cov[3];   ///< measurement covariance (sigmaY2, sigmaYZ, sigmaZ2)
+    Int_t index;      ///< packed cluster index, (layer<<28) + local index
+  };
+
+  std::vector<AttachedCluster> mClusters; ///< footprints of all tracks, back to back
+  std::vector<Int_t> mTrackStart;         ///< CSR-style per-track offsets, ntracks+1 entries
+};
+
+class CookedTracker::ThreadData
+{
+ public:
+  ThreadData() = default;
+  ThreadData(const ThreadData&) = delete;
+  ThreadData& operator=(const ThreadData& tr) = delete;
+
+  /// Drop the event-specific content of one layer but keep the allocations
+  void prepare(Int_t layer, Int_t nClusters)
+  {
+    mUsed[layer].clear();
+    mUsed[layer].resize(nClusters, false);
+    mSelected[layer].clear();
+    mSelected[layer].reserve(nClusters / 100 + 1);
+  }
+
+  std::vector<bool> mUsed[kNLayers];      ///< flags of the clusters attached by this thread
+  std::vector<Int_t> mSelected[kNLayers]; ///< clusters selected within the road, per layer
+  RefitEngine mRefit;                     ///< footprints of the accepted tracks, in acceptance order
 };
 
 class CookedTracker::Layer
@@ -105,23 +252,56 @@ class CookedTracker::Layer
   void unloadClusters();
   void selectClusters(std::vector<Int_t> &s, Float_t phi, Float_t dy, Float_t z, Float_t dz);
   Int_t findClusterIndex(Double_t z) const;
+  // grid access for the precomputed seeding windows
+  Int_t getNumberOfZBins() const { return kNZBins; }
+  Int_t getNumberOfSectors() const { return kNSectors; }
+  Float_t getZBinLowEdge(Int_t zb) const { return mZMin + (mZBinInv > 0.f ? zb / mZBinInv : 0.f); }
+  Int_t zToBin(Float_t z) const
+  {
+    Int_t zb = (z - mZMin) * mZBinInv;
+    if (zb < 0)
+      return 0;
+    return (zb < kNZBins) ? zb : kNZBins - 1;
+  }
+  Int_t phiToSector(Float_t phi) const;
+  void selectBinRange(std::vector<Int_t>& selec, Int_t sMin, Int_t sMax, Int_t zbMin, Int_t zbMax) const;
   Float_t getR() const { return mR; }
   Cluster* getCluster(Int_t i) const { return mClusters[i]; }
   Float_t getXRef(Int_t i) const { return mXRef[i]; }
   Float_t getAlphaRef(Int_t i) const { return mAlphaRef[i]; }
   Float_t getClusterPhi(Int_t i) const { return mPhi[i]; }
+  Float_t getClusterX(Int_t i) const { return mX[i]; }
+  Float_t getClusterY(Int_t i) const { return mY[i]; }
+  Float_t getClusterZ(Int_t i) const { return mZ[i]; }
+  Float_t getClusterTrackingY(Int_t i) const { return mTrkY[i]; }
+  Float_t getClusterTrackingZ(Int_t i) const { return mTrkZ[i]; }
+  Int_t getClusterLabel(Int_t i) const { return mLabel[i]; }
   Int_t getNumberOfClusters() const { return mClusters.size(); }
 
  protected:
-  enum {kNSectors=21};
+  enum {kNSectors=21, kNZBins=64, kNBins=kNSectors*kNZBins};
 
   Float_t mR; ///< mean radius of this layer
 
+  // by-value copies of the cluster fields used during seeding, so the hot
+  // loops never dereference into the TClonesArray. The vectors keep their
+  // allocations across events, only the content is rebuilt per event.
   std::vector<Cluster*>mClusters;          ///< All clusters
   std::vector<Float_t> mXRef;              ///< x of the reference plane
   std::vector<Float_t> mAlphaRef;          ///< alpha of the reference plane
   std::vector<Float_t> mPhi;               ///< cluster phi
-  std::vector<Int_t> mSectors[kNSectors];  ///< Cluster indices sector-by-sector
+  std::vector<Float_t> mX;                 ///< cluster global x
+  std::vector<Float_t> mY;                 ///< cluster global y
+  std::vector<Float_t> mZ;                 ///< cluster z
+  std::vector<Float_t> mTrkY;              ///< cluster y in the tracking frame
+  std::vector<Float_t> mTrkZ;              ///< cluster z in the tracking frame
+  std::vector<Int_t>   mLabel;             ///< first MC label of the cluster
+
+  // fixed phi x z grid with contiguous per-bin cluster index ranges
+  Float_t mZMin = 0.f;                     ///< z of the lower edge of the grid
+  Float_t mZBinInv = 0.f;                  ///< inverse z bin width
+  std::vector<Int_t> mBinStart;            ///< CSR-style offsets of the bins, kNBins+1 entries
+  std::vector<Int_t> mBinIndex;            ///< cluster indices ordered bin-by-bin, z-sorted within a bin
 };
 }
 }
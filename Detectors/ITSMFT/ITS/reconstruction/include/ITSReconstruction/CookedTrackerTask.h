@@ -14,8 +14,14 @@ class TClonesArray;
 
 namespace AliceO2
 {
+namespace Base
+{
+class InputPrefetcher;
+}
 namespace ITS
 {
+class ColumnarRecoWriter;
+
 class CookedTrackerTask : public FairTask
 {
  public:
@@ -24,8 +30,18 @@ class CookedTrackerTask : public FairTask
 
   virtual InitStatus Init();
   virtual void Exec(Option_t* option);
+  /// prints the percentile summary of the per-stage latency probes
+  virtual void FinishTask();
   void setBz(Double_t bz) { mTracker.setBz(bz); }
 
+  /// optional parallel columnar output of the tracks (see ColumnarRecoIO.h);
+  /// the writer must be open and outlive the task
+  void setColumnarWriter(ColumnarRecoWriter* writer) { mColumnarWriter = writer; }
+
+  /// read the input this many events ahead of the processing in the
+  /// background (see DetectorsBase/InputPrefetcher.h); 0 disables
+  void setInputPrefetch(Int_t numOfEvents) { mPrefetchEvents = numOfEvents; }
+
  private:
   Int_t mNumOfThreads;    ///< Number of threads
   GeometryTGeo mGeometry; ///< ITS geometry
@@ -33,6 +49,10 @@ class CookedTrackerTask : public FairTask
 
   const TClonesArray* mClustersArray;   ///< Array of clusters
   TClonesArray* mTracksArray; ///< Array of tracks
+  ColumnarRecoWriter* mColumnarWriter; //!< optional columnar track output
+  Int_t mEventCounter;                 //!< events processed, numbers the columnar output
+  Int_t mPrefetchEvents;               //!< input read-ahead window, 0 disables
+  Base::InputPrefetcher* mPrefetcher;  //!< background input reader, owned
 
   ClassDef(CookedTrackerTask, 1)
 };
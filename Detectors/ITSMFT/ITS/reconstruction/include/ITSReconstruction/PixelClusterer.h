@@ -0,0 +1,82 @@
+/// \file PixelClusterer.h
+/// \brief Definition of the connected-component ITS pixel cluster finder
+#ifndef ALICEO2_ITS_PIXELCLUSTERER_H
+#define ALICEO2_ITS_PIXELCLUSTERER_H
+
+#include <vector>
+
+#include "Rtypes.h"
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace ITSMFT {
+    class Digit;
+    class SegmentationPixel;
+  }
+}
+
+namespace AliceO2
+{
+namespace ITS
+{
+class Cluster;
+class ClusterErrorTable;
+class TopologyDictionary;
+
+/// Connected-component pixel cluster finder. The digits of a chip, sorted by
+/// (row, col), are run-length encoded row by row; the runs of adjacent rows
+/// are merged with a union-find over the run indices and every component is
+/// emitted as one cluster at the charge-weighted center of gravity. The chip
+/// is clusterized in one linear pass over its digits and the chips are
+/// independent, so they are split between the threads.
+class PixelClusterer
+{
+ public:
+  PixelClusterer(Int_t numOfThreads = 1);
+  ~PixelClusterer();
+
+  PixelClusterer(const PixelClusterer&) = delete;
+  PixelClusterer& operator=(const PixelClusterer&) = delete;
+
+  void setNumberOfThreads(Int_t n) { mNumOfThreads = n; }
+  Int_t getNumberOfThreads() const { return mNumOfThreads; }
+
+  /// Topology dictionary correcting the position and the errors of the
+  /// tabulated cluster shapes; may be nullptr
+  void setDictionary(const TopologyDictionary* d) { mDictionary = d; }
+  const TopologyDictionary* getDictionary() const { return mDictionary; }
+
+  /// Parameterized cluster errors, applied in a batched pass over the
+  /// clusterized output; may be nullptr, the pitch/sqrt(12) defaults (or the
+  /// dictionary errors) then stay in place
+  void setErrorTable(const ClusterErrorTable* t) { mErrorTable = t; }
+  const ClusterErrorTable* getErrorTable() const { return mErrorTable; }
+
+  /// Converts the digits to clusters of touching pixels
+  void process(const AliceO2::ITSMFT::SegmentationPixel* seg, const TClonesArray* digits,
+               TClonesArray* clusters);
+
+ private:
+  /// One run of column-consecutive pixels of a row
+  struct PixelRun {
+    Int_t row;         ///< chip row of the run
+    Int_t colStart;    ///< first column of the run
+    Int_t colEnd;      ///< last column of the run
+    Int_t firstDigit;  ///< first digit of the run within the sorted chip list
+    Int_t numOfDigits; ///< digits of the run, contiguous in the sorted list
+  };
+
+  /// Clusterize one chip given its digits sorted by (row, col)
+  void processChip(const AliceO2::ITSMFT::SegmentationPixel* seg,
+                   const AliceO2::ITSMFT::Digit* const* digits, Int_t n,
+                   std::vector<Cluster>& clusters) const;
+
+  Int_t mNumOfThreads;                  ///< Number of clustering threads
+  const TopologyDictionary* mDictionary; ///< Topology corrections, not owned
+  const ClusterErrorTable* mErrorTable;  ///< Parameterized errors, not owned
+};
+}
+}
+
+#endif /* ALICEO2_ITS_PIXELCLUSTERER_H */
@@ -0,0 +1,91 @@
+/// \file TopologyDictionary.h
+/// \brief Definition of the cluster topology dictionary
+#ifndef ALICEO2_ITS_TOPOLOGYDICTIONARY_H
+#define ALICEO2_ITS_TOPOLOGYDICTIONARY_H
+
+#include <map>
+
+#include "Rtypes.h"
+
+namespace AliceO2
+{
+namespace ITS
+{
+
+/// Dictionary of frequent cluster topologies with precomputed position
+/// corrections. A topology - the pixel pattern of a cluster, normalized to
+/// its bounding box - is hashed to a 64-bit id; the dictionary maps the
+/// frequent ids to the mean residual of the center of gravity with respect
+/// to the true crossing point and to the RMS position errors, extracted
+/// offline from simulation with account()/write(). At reconstruction time
+/// the dictionary is a flat open-addressing table mapped read-only into
+/// memory, so assigning the position of a known topology is one hash and
+/// one table probe instead of a per-cluster fit.
+class TopologyDictionary
+{
+ public:
+  enum {
+    kMaxRowSpan = 16,                              ///< topologies wider than this are not tabulated
+    kMaxColSpan = 16,
+    kPatternBytes = kMaxRowSpan * kMaxColSpan / 8  ///< maximal bitmap size
+  };
+  // a pattern is the row-major bitmap of the rowSpan x colSpan bounding box:
+  // bit (r*colSpan + c), packed into (rowSpan*colSpan + 7)/8 bytes with the
+  // trailing bits zero
+
+  TopologyDictionary();
+  ~TopologyDictionary();
+
+  TopologyDictionary(const TopologyDictionary&) = delete;
+  TopologyDictionary& operator=(const TopologyDictionary&) = delete;
+
+  /// 64-bit FNV-1a over the spans and the bitmap; never returns the
+  /// empty-slot sentinel 0
+  static ULong64_t computeHash(UShort_t rowSpan, UShort_t colSpan, const UChar_t* pattern);
+
+  // ===| offline building |====================================================
+  /// Accumulates one simulated cluster of the given topology; dx/dz is the
+  /// residual of the center of gravity to the true crossing point [cm]
+  void account(UShort_t rowSpan, UShort_t colSpan, const UChar_t* pattern, Float_t dx, Float_t dz);
+  /// Writes the topologies seen at least minCount times as a flat table
+  Bool_t write(const char* path, Int_t minCount = 100) const;
+
+  // ===| lookup |==============================================================
+  /// Maps an existing dictionary file read-only
+  Bool_t open(const char* path);
+  void close();
+  Bool_t isOpen() const { return mTable != nullptr; }
+  ULong64_t getNumberOfEntries() const { return mNumberOfEntries; }
+  /// Correction and errors of the topology; kFALSE for unknown topologies
+  Bool_t getCorrection(ULong64_t hash, Float_t& dx, Float_t& dz, Float_t& sigmaY2,
+                       Float_t& sigmaZ2) const;
+
+ private:
+  /// One slot of the flat table; hash 0 marks an empty slot
+  struct Entry {
+    ULong64_t hash;   ///< topology id
+    Float_t dx;       ///< correction to add to the center of gravity [cm]
+    Float_t dz;       ///< correction to add to the center of gravity [cm]
+    Float_t sigmaY2;  ///< position error of the topology
+    Float_t sigmaZ2;  ///< position error of the topology
+    Float_t reserved; ///< padding, keeps the slot at 32 bytes
+  };
+
+  /// Partial sums of one topology during the offline accumulation
+  struct Accumulator {
+    ULong64_t count = 0;
+    Double_t sumDx = 0., sumDz = 0.;
+    Double_t sumDx2 = 0., sumDz2 = 0.;
+  };
+
+  const void* mMapping;       ///< base address of the mapped file
+  const Entry* mTable;        ///< mapped table, slot count mTableSize
+  ULong64_t mTableSize;       ///< number of slots, power of two
+  ULong64_t mNumberOfEntries; ///< occupied slots
+  Int_t mFileDescriptor;      ///< descriptor of the mapped file
+  std::map<ULong64_t, Accumulator> mAccumulators; ///< offline accumulation
+};
+}
+}
+
+#endif /* ALICEO2_ITS_TOPOLOGYDICTIONARY_H */
@@ -9,6 +9,7 @@ class TClonesArray;
 
 namespace AliceO2 {
   namespace ITSMFT {
+    class FiredChipIndex;
     class SegmentationPixel;
   }
 }
@@ -31,6 +32,11 @@ namespace ITS
   /// @return digits container
   void process(const AliceO2::ITSMFT::SegmentationPixel *seg, const TClonesArray* digits, TClonesArray* clusters);
 
+  /// Same, iterating the digit array chip by chip through the fired-chip
+  /// index of the digitizer; only the occupied chips are touched
+  void process(const AliceO2::ITSMFT::SegmentationPixel *seg, const TClonesArray* digits,
+               const AliceO2::ITSMFT::FiredChipIndex* index, TClonesArray* clusters);
+
 };
 }
 }
@@ -13,8 +13,18 @@ class TClonesArray;
 
 namespace AliceO2
 {
+namespace Base
+{
+class InputPrefetcher;
+}
+namespace ITSMFT
+{
+class FiredChipIndex;
+}
 namespace ITS
 {
+class ColumnarRecoWriter;
+
 class TrivialClustererTask : public FairTask
 {
  public:
@@ -24,12 +34,25 @@ class TrivialClustererTask : public FairTask
   virtual InitStatus Init();
   virtual void Exec(Option_t* option);
 
+  /// optional parallel columnar output of the clusters (see ColumnarRecoIO.h);
+  /// the writer must be open and outlive the task
+  void setColumnarWriter(ColumnarRecoWriter* writer) { mColumnarWriter = writer; }
+
+  /// read the input this many events ahead of the processing in the
+  /// background (see DetectorsBase/InputPrefetcher.h); 0 disables
+  void setInputPrefetch(Int_t numOfEvents) { mPrefetchEvents = numOfEvents; }
+
  private:
   GeometryTGeo mGeometry; ///< ITS geometry
   TrivialClusterer mTrivialClusterer;   ///< Cluster finder
 
   TClonesArray* mDigitsArray;   ///< Array of digits
+  ITSMFT::FiredChipIndex* mFiredChips; ///< Fired-chip index of the digitizer, may be absent
   TClonesArray* mClustersArray; ///< Array of clusters
+  ColumnarRecoWriter* mColumnarWriter; //!< optional columnar cluster output
+  Int_t mEventCounter;                 //!< events processed, numbers the columnar output
+  Int_t mPrefetchEvents;               //!< input read-ahead window, 0 disables
+  Base::InputPrefetcher* mPrefetcher;  //!< background input reader, owned
 
   ClassDef(TrivialClustererTask, 2)
 };
@@ -0,0 +1,319 @@
+/// \file benchITSReco.cxx
+/// \brief Standalone benchmark of the ITS reconstruction chain
+///
+/// Generates synthetic events of straight tracks from the nominal vertex at a
+/// configurable multiplicity, maps the layer crossings onto the pixel chips of
+/// the actual geometry (SegmentationPixel + GeometryTGeo) and pushes them
+/// through the chain: digits -> TrivialClusterer -> clusters -> CookedTracker,
+/// plus the CA tracker fed with the equivalent points. For every stage the
+/// wall time, the throughput (digits/clusters/seeds/tracks per second) and the
+/// process peak RSS reached so far are reported.
+///
+/// Usage: benchITSReco [multiplicity] [events] [threads] [geometry file]
+/// The geometry file is either a parameter file containing a FairGeoParSet
+/// (AliceO2_TGeant3.params_*.root) or a plain TGeoManager export.
+
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TGeoManager.h>
+#include <TMath.h>
+#include <TVector3.h>
+
+#include "ITSMFTBase/Digit.h"
+#include "ITSMFTBase/SegmentationPixel.h"
+#include "ITSMFTSimulation/Point.h"
+#include "ITSBase/GeometryTGeo.h"
+#include "ITSReconstruction/CATracker.h"
+#include "ITSReconstruction/CATrackingStation.h"
+#include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/ClusterLabels.h"
+#include "ITSReconstruction/CookedTrack.h"
+#include "ITSReconstruction/CookedTracker.h"
+#include "ITSReconstruction/TrivialClusterer.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using AliceO2::ITSMFT::Digit;
+using AliceO2::ITSMFT::Point;
+using AliceO2::ITSMFT::SegmentationPixel;
+using namespace AliceO2::ITS;
+
+namespace {
+  constexpr Int_t kNLayers = 7;
+  constexpr Double_t kBz = 5.;            // kG, nominal solenoid field
+  constexpr Float_t kSmearSigma = 0.0005; // cm, cluster position smearing
+
+  // chip centers of one layer, phi-sorted for the nearest-chip queries
+  struct ChipLUT {
+    Float_t r = 0.f;                  // mean layer radius
+    Float_t zMin = 0.f, zMax = 0.f;   // z extent of the chip centers
+    std::vector<Float_t> phi, z;
+    std::vector<Int_t> id;
+  };
+
+  // one layer crossing of a generated track
+  struct Crossing {
+    Int_t chip, row, col, label;
+    Float_t gx, gy, gz; // smeared global position
+  };
+
+  double peakRSSMB()
+  {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.; // ru_maxrss is in kB on Linux
+  }
+
+  double secondsSince(std::chrono::high_resolution_clock::time_point start)
+  {
+    const auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(stop-start).count();
+  }
+
+  Float_t gauss(Float_t sigma)
+  {
+    const Double_t u1 = 1. - drand48(), u2 = drand48();
+    return sigma * TMath::Sqrt(-2.*TMath::Log(u1)) * TMath::Cos(TMath::TwoPi()*u2);
+  }
+
+  void buildChipLUT(GeometryTGeo& geom, ChipLUT lut[kNLayers])
+  {
+    for (Int_t chip = 0; chip < geom.getNumberOfChips(); chip++) {
+      Int_t layer = geom.getLayer(chip);
+      Double_t loc[3]{ 0., 0., 0. }, glo[3];
+      geom.localToGlobal(chip, loc, glo);
+      ChipLUT& l = lut[layer];
+      Float_t phi = TMath::ATan2(glo[1], glo[0]);
+      if (phi < 0) phi += TMath::TwoPi();
+      l.phi.push_back(phi);
+      l.z.push_back(glo[2]);
+      l.id.push_back(chip);
+      l.r += TMath::Sqrt(glo[0]*glo[0] + glo[1]*glo[1]);
+    }
+    for (Int_t i = 0; i < kNLayers; i++) {
+      ChipLUT& l = lut[i];
+      l.r /= l.phi.size();
+      std::vector<Int_t> idx(l.phi.size());
+      for (size_t j = 0; j < idx.size(); j++) idx[j] = j;
+      std::sort(idx.begin(), idx.end(),
+        [&l](Int_t a, Int_t b){ return l.phi[a] < l.phi[b]; });
+      ChipLUT s;
+      s.r = l.r;
+      for (Int_t j : idx) {
+        s.phi.push_back(l.phi[j]);
+        s.z.push_back(l.z[j]);
+        s.id.push_back(l.id[j]);
+      }
+      s.zMin = *std::min_element(s.z.begin(), s.z.end());
+      s.zMax = *std::max_element(s.z.begin(), s.z.end());
+      l = std::move(s);
+    }
+  }
+
+  // nearest chip of one layer in (r*phi, z) metric, searched within a phi
+  // window around the crossing point (with the 0/2pi wrap handled)
+  Int_t findChip(const ChipLUT& l, Float_t phi, Float_t z)
+  {
+    constexpr Float_t kPhiWin = 0.4f;
+    Int_t best = -1;
+    Float_t bestD2 = 1.e30f;
+    for (Int_t wrap = -1; wrap <= 1; wrap++) {
+      Float_t q = phi + wrap*Float_t(TMath::TwoPi());
+      auto lo = std::lower_bound(l.phi.begin(), l.phi.end(), q - kPhiWin);
+      auto hi = std::upper_bound(l.phi.begin(), l.phi.end(), q + kPhiWin);
+      for (auto it = lo; it != hi; ++it) {
+        size_t j = it - l.phi.begin();
+        Float_t dphi = l.phi[j] - q, dz = l.z[j] - z;
+        Float_t d2 = l.r*dphi * l.r*dphi + dz*dz;
+        if (d2 < bestD2) { bestD2 = d2; best = j; }
+      }
+    }
+    return best;
+  }
+
+  // generate one event: straight tracks from the origin, one crossing per
+  // layer, snapped to the closest chip and smeared on the sensor plane.
+  // Crossings whose smeared position falls outside the sensor are dropped.
+  void generateEvent(Int_t multiplicity, GeometryTGeo& geom, const SegmentationPixel* seg,
+                     const ChipLUT lut[kNLayers], std::vector<Crossing> crossings[kNLayers])
+  {
+    for (Int_t i = 0; i < kNLayers; i++) {
+      crossings[i].clear();
+      crossings[i].reserve(multiplicity);
+    }
+    for (Int_t t = 0; t < multiplicity; t++) {
+      Float_t phi = Float_t(TMath::TwoPi()*drand48());
+      Float_t tgl = Float_t(drand48()) - 0.5f; // tan(lambda) in [-0.5,0.5)
+      for (Int_t i = 0; i < kNLayers; i++) {
+        const ChipLUT& l = lut[i];
+        Double_t glo[3]{ l.r*TMath::Cos(phi), l.r*TMath::Sin(phi), l.r*tgl };
+        Int_t j = findChip(l, phi, glo[2]);
+        if (j < 0) continue;
+        Int_t chip = l.id[j];
+        Double_t loc[3];
+        geom.globalToLocal(chip, glo, loc);
+        loc[0] += gauss(kSmearSigma);
+        loc[1] = 0.; // snap onto the sensor plane
+        loc[2] += gauss(kSmearSigma);
+        Int_t row, col;
+        if (!seg->localToDetector(loc[0], loc[2], row, col)) continue;
+        geom.localToGlobal(chip, loc, glo);
+        crossings[i].push_back(Crossing{chip, row, col, t,
+                                        Float_t(glo[0]), Float_t(glo[1]), Float_t(glo[2])});
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const Int_t multiplicity = (argc > 1) ? atoi(argv[1]) : 2000;
+  const Int_t nEvents = (argc > 2) ? atoi(argv[2]) : 10;
+  const Int_t nThreads = (argc > 3) ? atoi(argv[3]) : 1;
+  const char* geomFile = (argc > 4) ? argv[4] : "AliceO2_TGeant3.params_10.root";
+
+  // ===| geometry |============================================================
+  TFile* f = TFile::Open(geomFile);
+  if (f) {
+    f->Get("FairGeoParSet"); // registers gGeoManager, as in the display macros
+    f->Close();
+  }
+  if (!gGeoManager && !TGeoManager::Import(geomFile)) {
+    fprintf(stderr, "cannot get the geometry from %s\n", geomFile);
+    return 1;
+  }
+  GeometryTGeo geom;
+  geom.Build(kTRUE);
+  Cluster::setGeom(&geom);
+  const SegmentationPixel* seg =
+    (SegmentationPixel*)geom.getSegmentationById(0);
+
+  ChipLUT lut[kNLayers];
+  buildChipLUT(geom, lut);
+
+  printf("benchITSReco: multiplicity %d, %d events, %d threads\n",
+         multiplicity, nEvents, nThreads);
+  printf("initial peak RSS: %.1f MB\n", peakRSSMB());
+
+  srand48(12345);
+  std::vector<Crossing> crossings[kNLayers];
+
+  CookedTracker cookedTracker(nThreads);
+  cookedTracker.setBz(kBz);
+  TrivialClusterer clusterer;
+
+  double tClusterer = 0., tCooked = 0., tTruth = 0., tCAInit = 0., tCATracking = 0.;
+  Long64_t nDigits = 0, nClusters = 0, nSeeds = 0, nCookedTracks = 0, nCAClusters = 0;
+  Long64_t nPureTracks = 0, nLabelMismatches = 0;
+
+  // compact truth matching scratch, reused across events
+  ClusterLabels clusterLabels;
+  std::vector<Int_t> trackOffsets, trackIndices, cookedLabels;
+
+  for (Int_t event = 0; event < nEvents; event++) {
+    generateEvent(multiplicity, geom, seg, lut, crossings);
+
+    // ===| digits -> clusters |================================================
+    TClonesArray digits("AliceO2::ITSMFT::Digit");
+    for (Int_t i = 0; i < kNLayers; i++)
+      for (const Crossing& c : crossings[i]) {
+        Digit* d = new (digits[digits.GetEntriesFast()])
+          Digit(c.chip, c.row, c.col, 100., 0.);
+        d->setLabel(0, c.label);
+      }
+    TClonesArray clusters("AliceO2::ITS::Cluster");
+    auto start = std::chrono::high_resolution_clock::now();
+    clusterer.process(seg, &digits, &clusters);
+    tClusterer += secondsSince(start);
+    nDigits += digits.GetEntriesFast();
+    nClusters += clusters.GetEntriesFast();
+
+    // ===| clusters -> tracks, "cooked matrix" tracker |=======================
+    TClonesArray tracks("AliceO2::ITS::CookedTrack");
+    start = std::chrono::high_resolution_clock::now();
+    cookedTracker.process(clusters, tracks);
+    tCooked += secondsSince(start);
+    nSeeds += cookedTracker.getNumberOfSeeds();
+    nCookedTracks += tracks.GetEntriesFast();
+
+    // ===| truth matching over the compact label container |===================
+    // the labels of all clusters are pulled into the flat container once,
+    // the majority computation then runs over the CSR structures only
+    start = std::chrono::high_resolution_clock::now();
+    clusterLabels.fill(clusters);
+    trackOffsets.clear();
+    trackIndices.clear();
+    trackOffsets.push_back(0);
+    for (Int_t i = 0; i < tracks.GetEntriesFast(); i++) {
+      CookedTrack* t = static_cast<CookedTrack*>(tracks.UncheckedAt(i));
+      for (Int_t j = 0; j < t->getNumberOfClusters(); j++)
+        trackIndices.push_back(t->getClusterIndex(j));
+      trackOffsets.push_back(trackIndices.size());
+    }
+    clusterLabels.cookLabels(trackOffsets, trackIndices, 0.f, cookedLabels);
+    tTruth += secondsSince(start);
+    for (size_t i = 0; i < cookedLabels.size(); i++) {
+      if (cookedLabels[i] >= 0)
+        nPureTracks++;
+      CookedTrack* t = static_cast<CookedTrack*>(tracks.UncheckedAt(i));
+      if (t->getLabel() != cookedLabels[i])
+        nLabelMismatches++;
+    }
+
+    // ===| points -> CA tracker |==============================================
+    // the CA stations take simulation points grouped by chip
+    TClonesArray points[kNLayers];
+    for (Int_t i = 0; i < kNLayers; i++) {
+      points[i].SetClass("AliceO2::ITSMFT::Point");
+      std::sort(crossings[i].begin(), crossings[i].end(),
+        [](const Crossing& a, const Crossing& b){ return a.chip < b.chip; });
+      for (const Crossing& c : crossings[i]) {
+        TVector3 pos(c.gx, c.gy, c.gz);
+        TVector3 mom = pos.Unit();
+        new (points[i][points[i].GetEntriesFast()])
+          Point(c.label, c.chip, pos, pos, mom, 0., 0., 0., 1.e-6, 0, 0, 0);
+      }
+      nCAClusters += points[i].GetEntriesFast();
+    }
+    start = std::chrono::high_resolution_clock::now();
+    CA::TrackingStation* stations[kNLayers];
+    for (Int_t i = 0; i < kNLayers; i++) {
+      stations[i] = new CA::TrackingStation(i, lut[i].zMin - 2.f, lut[i].zMax + 2.f, 20, 20);
+      stations[i]->Init(&points[i], &geom);
+    }
+    tCAInit += secondsSince(start);
+
+    CA::Tracker caTracker(stations);
+    caTracker.SetBz(kBz);
+    Float_t vtx[3]{ 0.f, 0.f, 0.f };
+    caTracker.SetVertex(vtx);
+    start = std::chrono::high_resolution_clock::now();
+    caTracker.LoadClusters();
+    caTracker.Clusters2Tracks();
+    caTracker.UnloadClusters();
+    tCATracking += secondsSince(start);
+    for (Int_t i = 0; i < kNLayers; i++)
+      delete stations[i];
+  }
+
+  printf("\n");
+  printf("TrivialClusterer:  %8.3f s  %10.3e clusters/s  (%lld digits)  peak RSS %.1f MB\n",
+         tClusterer, nClusters/tClusterer, (Long64_t)nDigits, peakRSSMB());
+  printf("CookedTracker:     %8.3f s  %10.3e seeds/s  %10.3e tracks/s  (%lld tracks)  peak RSS %.1f MB\n",
+         tCooked, nSeeds/tCooked, nCookedTracks/tCooked, (Long64_t)nCookedTracks, peakRSSMB());
+  printf("Truth matching:    %8.3f s  %10.3e tracks/s  (%lld pure, %lld mismatches)  peak RSS %.1f MB\n",
+         tTruth, nCookedTracks/tTruth, nPureTracks, nLabelMismatches, peakRSSMB());
+  printf("CA station init:   %8.3f s  %10.3e clusters/s  peak RSS %.1f MB\n",
+         tCAInit, nCAClusters/tCAInit, peakRSSMB());
+  printf("CA tracking:       %8.3f s  %10.3e clusters/s  peak RSS %.1f MB\n",
+         tCATracking, nCAClusters/tCATracking, peakRSSMB());
+
+  return 0;
+}
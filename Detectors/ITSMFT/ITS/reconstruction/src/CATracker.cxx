@@ -21,6 +21,8 @@
 // STD
 #include <algorithm>
 #include <cassert>
+#include <thread>
+#include <utility>
 // ROOT
 #include <TMath.h>
 #include <Riostream.h>
@@ -68,6 +70,7 @@ const float kDoublPhi1 = 0.2f;
   ,mZCut(0.5f)
   ,mCandidates()
   ,mSAonly(true)
+  ,mNumOfThreads(1)
   ,mCPhi()
   ,mCDTanL()
   ,mCDPhi()
@@ -76,7 +79,9 @@ const float kDoublPhi1 = 0.2f;
   ,mCDCAxy()
   ,mCDN()
    ,mCDP()
-   ,mCDZ() {
+   ,mCDZ()
+   ,mVertex{0.f,0.f,0.f}
+   ,mBz(0.f) {
      // This default constructor needs to be provided
    }
 
@@ -139,18 +144,23 @@ void Tracker::CellsTreeTraversal(vector<Road> &roads,
   // We want the right number of elements in the roads also in the case of multiple neighbours
   const int currentN = roads.back().N;
 
-  // [2] loop on the neighbours of the current cell
-  for (size_t iN = 0; iN < mCells[doubl][iD].NumberOfNeighbours(); ++iN) {
-    const int currD = doubl - 1;
-    const int neigh = mCells[doubl][iD](iN);
-
-    // [3] for each neighbour one road
-    if (iN > 0) {
-      roads.push_back(roads.back());
-      roads.back().N = currentN;
+  // [2] loop on the neighbours of the current cell: a contiguous slice of the
+  // flat adjacency array, read sequentially
+  if (doubl > 0) {
+    const int first = mCellNeighbourStart[doubl - 1][iD];
+    const int last = mCellNeighbourStart[doubl - 1][iD + 1];
+    for (int iN = first; iN < last; ++iN) {
+      const int currD = doubl - 1;
+      const int neigh = mCellNeighbours[doubl - 1][iN];
+
+      // [3] for each neighbour one road
+      if (iN > first) {
+        roads.push_back(roads.back());
+        roads.back().N = currentN;
+      }
+      // [4] play this game again until the end of the road
+      CellsTreeTraversal(roads,neigh,currD);
     }
-    // [4] play this game again until the end of the road
-    CellsTreeTraversal(roads,neigh,currD);
   }
 
   mCells[doubl][iD].SetLevel(0u); // Level = -1
@@ -254,11 +264,13 @@ void Tracker::FindTracksCA(int iteration) {
         // [1] Add current cell to road
         roads.push_back(Road(iCL,iCell));
         // [2] Loop on current cell neighbours
-        for(size_t iN = 0; iN < mCells[iCL][iCell].NumberOfNeighbours(); ++iN) {
+        const int first = mCellNeighbourStart[iCL - 1][iCell];
+        const int last = mCellNeighbourStart[iCL - 1][iCell + 1];
+        for(int iN = first; iN < last; ++iN) {
           const int currD = iCL - 1;
-          const int neigh = mCells[iCL][iCell](iN);
+          const int neigh = mCellNeighbours[iCL - 1][iN];
           // [3] if more than one neighbour => more than one road, one road for each neighbour
-          if(iN > 0) {
+          if(iN > first) {
             roads.push_back(Road(iCL,iCell));
           }
           // [4] Essentially the neighbour became the current cell and then go to [1]
@@ -335,65 +347,88 @@ void Tracker::MakeCells(int iteration) {
       vector<Doublets>().swap(mDoublets[i]);
   }
 
+  // The doublets of one layer are built by contiguous cluster slices: each
+  // worker fills its own output buffer through the reentrant station query,
+  // the buffers are then concatenated in slice order, so the result is
+  // identical to the serial pass and no locking is needed.
+  auto buildDoublets = [this](int iL, int first, int last, vector<Doublets> &out) {
+    vector<int> foundBins;
+    for (int iC = first; iC < last; ++iC) {
+      const ClsInfo_t& cls = mLayer[iL]->GetClusterInfo(iC);
+      if (mUsedClusters[iL][iC]) {
+        continue;
+      }
+      const float tanL = (cls.z - GetZ()) / cls.r;
+      const float extz = tanL * (mkR[iL + 1] - cls.r) + cls.z;
+      if (!mLayer[iL + 1]->SelectClusters(extz - 2 * mCZ, extz + 2 * mCZ,
+            cls.phi - mCPhi, cls.phi + mCPhi, foundBins))
+        continue;
+
+      int iC2 = 0;
+      for (int bin : foundBins) {
+        int firstCl;
+        const int ncl = mLayer[iL + 1]->GetBinClusters(bin, firstCl);
+        for (int icl = 0; icl < ncl; ++icl, ++iC2) {
+          const int iD2 = firstCl + icl;
+          const ClsInfo_t& cls2 = mLayer[iL + 1]->GetClusterInfo(iD2);
+          if (mUsedClusters[iL + 1][iC2]) {
+            continue;
+          }
+          const float dz = tanL * (cls2.r - cls.r) + cls.z - cls2.z;
+          if (fabs(dz) < mCDZ[iL] && CompareAngles(cls.phi, cls2.phi, mCPhi)) {
+            const float dTanL = (cls.z - cls2.z) / (cls.r - cls2.r);
+            const float phi = atan2(cls.y - cls2.y, cls.x - cls2.x);
+            out.push_back(Doublets(iC,iD2,dTanL,phi));
+          }
+        }
+      }
+    }
+  };
+
   // Trick to speed up the navigation of the doublets array. The lookup table is build like:
   // dLUT[l][i] = n;
   // where n is the index inside mDoublets[l+1] of the first doublets that uses the point
   // mLayer[l+1][i]
   vector<int> dLUT[5];
   for (int iL = 0; iL < 6; ++iL) {
-    if (mLayer[iL]->GetNClusters() == 0) continue;
+    const int nCl = mLayer[iL]->GetNClusters();
+    if (nCl == 0) continue;
     if (iL < 5)
       dLUT[iL].resize((*mLayer[iL + 1]).GetNClusters(),-1);
-    if (dLUT[iL - 1].size() == 0u)
+    if (iL > 0 && dLUT[iL - 1].size() == 0u)
       continue;
-    for (int iC = 0; iC < mLayer[iL]->GetNClusters(); ++iC) {
-      const ClsInfo_t& cls = mLayer[iL]->GetClusterInfo(iC);
-      if (mUsedClusters[iL][iC]) {
-        continue;
+
+    const int nThreads = (mNumOfThreads < nCl) ? mNumOfThreads : 1;
+    if (nThreads > 1) {
+      vector<vector<Doublets>> slices(nThreads);
+      vector<std::thread> workers;
+      for (int t = 0; t < nThreads; ++t) {
+        const int first = t * nCl / nThreads;
+        const int last = (t + 1) * nCl / nThreads;
+        workers.emplace_back(buildDoublets, iL, first, last, std::ref(slices[t]));
       }
-      const float tanL = (cls.z - GetZ()) / cls.r;
-      const float extz = tanL * (mkR[iL + 1] - cls.r) + cls.z;
-      const int nClust = mLayer[iL + 1]->SelectClusters(extz - 2 * mCZ, extz + 2 * mCZ,
-          cls.phi - mCPhi, cls.phi + mCPhi);
-      bool first = true;
-
-      for (int iC2 = 0; iC2 < nClust; ++iC2) {
-        const int iD2 = mLayer[iL + 1]->GetNextClusterInfoID();
-        const ClsInfo_t& cls2 = mLayer[iL + 1]->GetClusterInfo(iD2);
-        if (mUsedClusters[iL + 1][iC2]) {
-          continue;
-        }
-        const float dz = tanL * (cls2.r - cls.r) + cls.z - cls2.z;
-        if (fabs(dz) < mCDZ[iL] && CompareAngles(cls.phi, cls2.phi, mCPhi)) {
-          if (first && iL > 0) {
-            dLUT[iL - 1][iC] = mDoublets[iL].size();
-            first = false;
-          }
-          const float dTanL = (cls.z - cls2.z) / (cls.r - cls2.r);
-          const float phi = atan2(cls.y - cls2.y, cls.x - cls2.x);
-          mDoublets[iL].push_back(Doublets(iC,iD2,dTanL,phi));
-        }
+      for (auto &w : workers) w.join();
+      for (auto &slice : slices)
+        mDoublets[iL].insert(mDoublets[iL].end(), slice.begin(), slice.end());
+    } else {
+      buildDoublets(iL, 0, nCl, mDoublets[iL]);
+    }
+
+    // rebuild the lookup table in a single pass over the merged doublets
+    if (iL > 0) {
+      for (size_t j = 0; j < mDoublets[iL].size(); ++j) {
+        const int x = mDoublets[iL][j].x;
+        if (dLUT[iL - 1][x] == -1)
+          dLUT[iL - 1][x] = j;
       }
-      mLayer[iL + 1]->ResetFoundIterator();
     }
   }
 
-  // Trick to speed up the navigation of the cells array. The lookup table is build like:
-  // tLUT[l][i] = n;
-  // where n is the index inside mCells[l+1] of the first cells that uses the doublet
-  // mDoublets[l+1][i]
-  vector<int> tLUT[4];
-  tLUT[0].resize(mDoublets[1].size(),-1);
-  tLUT[1].resize(mDoublets[2].size(),-1);
-  tLUT[2].resize(mDoublets[3].size(),-1);
-  tLUT[3].resize(mDoublets[4].size(),-1);
-
-  for (int iD = 0; iD < 5; ++iD) {
-    if (mDoublets[iD + 1].size() == 0u || mDoublets[iD].size() == 0u) continue;
-
-    for (size_t iD0 = 0; iD0 < mDoublets[iD].size(); ++iD0) {
+  // Cell building parallelized the same way as the doublets: disjoint slices
+  // of the doublet array per worker, private buffers concatenated in order.
+  auto buildCells = [this, &dLUT](int iD, size_t first, size_t last, vector<Cell> &out) {
+    for (size_t iD0 = first; iD0 < last; ++iD0) {
       const int idx = mDoublets[iD][iD0].y;
-      bool first = true;
       if (dLUT[iD][idx] == -1) continue;
       for (size_t iD1 = dLUT[iD][idx]; iD1 < mDoublets[iD + 1].size(); ++iD1) {
         if (idx != mDoublets[iD + 1][iD1].x) break;
@@ -407,17 +442,53 @@ void Tracker::MakeCells(int iteration) {
             array<float,3> n {0.f};
             if (CellParams(iD,(*mLayer[iD])[mDoublets[iD][iD0].x],(*mLayer[iD + 1])[mDoublets[iD][iD0].y],
                   (*mLayer[iD + 2])[mDoublets[iD + 1][iD1].y],curv,n)) {
-              if (first && iD > 0) {
-                tLUT[iD - 1][iD0] = mCells[iD].size();
-                first = false;
-              }
-              mCells[iD].push_back(Cell(mDoublets[iD][iD0].x,mDoublets[iD][iD0].y,
+              out.push_back(Cell(mDoublets[iD][iD0].x,mDoublets[iD][iD0].y,
                     mDoublets[iD + 1][iD1].y,iD0,iD1,curv,n));
             }
           }
         }
       }
     }
+  };
+
+  // Trick to speed up the navigation of the cells array. The lookup table is build like:
+  // tLUT[l][i] = n;
+  // where n is the index inside mCells[l+1] of the first cells that uses the doublet
+  // mDoublets[l+1][i]
+  vector<int> tLUT[4];
+  tLUT[0].resize(mDoublets[1].size(),-1);
+  tLUT[1].resize(mDoublets[2].size(),-1);
+  tLUT[2].resize(mDoublets[3].size(),-1);
+  tLUT[3].resize(mDoublets[4].size(),-1);
+
+  for (int iD = 0; iD < 5; ++iD) {
+    if (mDoublets[iD + 1].size() == 0u || mDoublets[iD].size() == 0u) continue;
+
+    const size_t nDoub = mDoublets[iD].size();
+    const size_t nThreads = (size_t(mNumOfThreads) < nDoub) ? mNumOfThreads : 1;
+    if (nThreads > 1) {
+      vector<vector<Cell>> slices(nThreads);
+      vector<std::thread> workers;
+      for (size_t t = 0; t < nThreads; ++t) {
+        const size_t first = t * nDoub / nThreads;
+        const size_t last = (t + 1) * nDoub / nThreads;
+        workers.emplace_back(buildCells, iD, first, last, std::ref(slices[t]));
+      }
+      for (auto &w : workers) w.join();
+      for (auto &slice : slices)
+        mCells[iD].insert(mCells[iD].end(), slice.begin(), slice.end());
+    } else {
+      buildCells(iD, 0, nDoub, mCells[iD]);
+    }
+
+    // rebuild the lookup table in a single pass over the merged cells
+    if (iD > 0) {
+      for (size_t j = 0; j < mCells[iD].size(); ++j) {
+        const int d0 = mCells[iD][j].d0();
+        if (tLUT[iD - 1][d0] == -1)
+          tLUT[iD - 1][d0] = j;
+      }
+    }
   }
 
   // Adjacent cells: cells that share 2 points. In the following code adjacent cells are combined.
@@ -425,8 +496,14 @@ void Tracker::MakeCells(int iteration) {
   // to the list of neighbours of the outermost cell. When the cell is added to the neighbours of
   // the outermost cell the "level" of the latter is set to the level of the innermost one + 1.
   // ( only if $(level of the innermost) + 1 > $(level of the outermost) )
+  // The pairs are first collected and then packed into the CSR arrays, so the
+  // neighbours of one cell are contiguous and the propagation sweep reads the
+  // adjacency sequentially.
   for (int iD = 0; iD < 4; ++iD) {
+    mCellNeighbours[iD].clear();
+    mCellNeighbourStart[iD].assign(mCells[iD + 1].size() + 1, 0);
     if (mCells[iD + 1].size() == 0u || tLUT[iD].size() == 0u) continue; // TODO: dealing with holes
+    vector<std::pair<int,int>> pairs; // (outer cell, inner cell)
     for (size_t c0 = 0; c0 < mCells[iD].size(); ++c0) {
       const int idx = mCells[iD][c0].d1();
       if (tLUT[iD][idx] == -1) continue;
@@ -437,11 +514,26 @@ void Tracker::MakeCells(int iteration) {
         const float dn2 = ((n0[0] - n1[0]) * (n0[0] - n1[0]) + (n0[1] - n1[1]) * (n0[1] - n1[1]) +
             (n0[2] - n1[2]) * (n0[2] - n1[2]));
         const float dp = fabs(mCells[iD][c0].GetCurvature() - mCells[iD + 1][c1].GetCurvature());
-        if (dn2 < mCDN[iD] && dp < mCDP[iD]) {
-          mCells[iD + 1][c1].Combine(mCells[iD][c0], c0);
+        if (dn2 < mCDN[iD] && dp < mCDP[iD] &&
+            mCells[iD + 1][c1].x() == mCells[iD][c0].y() && // cells sharing two points
+            mCells[iD + 1][c1].y() == mCells[iD][c0].z()) {
+          pairs.push_back(std::make_pair(int(c1), int(c0)));
+          mCellNeighbourStart[iD][c1 + 1]++;
+          if (mCells[iD][c0].GetLevel() + 1 > mCells[iD + 1][c1].GetLevel()) {
+            mCells[iD + 1][c1].SetLevel(mCells[iD][c0].GetLevel() + 1);
+          }
         }
       }
     }
+    // prefix sums turn the counts into slice offsets ...
+    for (size_t i = 1; i < mCellNeighbourStart[iD].size(); ++i)
+      mCellNeighbourStart[iD][i] += mCellNeighbourStart[iD][i - 1];
+    // ... and the pairs are scattered to their slices; within a slice the
+    // inner cells keep their ascending order
+    mCellNeighbours[iD].resize(pairs.size());
+    vector<int> next(mCellNeighbourStart[iD].begin(), mCellNeighbourStart[iD].end() - 1);
+    for (const auto &pair : pairs)
+      mCellNeighbours[iD][next[pair.first]++] = pair.second;
   }
 }
 
@@ -614,7 +706,10 @@ void Tracker::UnloadClusters() {
     mDoublets[i].clear();
   for (int i = 0; i < 5; ++i)
     mCells[i].clear();
-  for (int i = 0; i < 4; ++i)
+  for (int i = 0; i < 4; ++i) {
+    mCellNeighbourStart[i].clear();
+    mCellNeighbours[i].clear();
     mCandidates[i].clear();
+  }
 }
 
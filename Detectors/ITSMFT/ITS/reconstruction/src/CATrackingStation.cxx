@@ -292,6 +292,67 @@ int TrackingStation::SelectClusters(float zmin,float zmax,float phimin,float phi
   return mNFoundClusters;
 }
 
+int TrackingStation::SelectClusters(float zmin,float zmax,float phimin,float phimax,
+    std::vector<int> &foundBins) const {
+  // reentrant version of the query above: the occupied bins go to the
+  // caller-provided vector and no member state is modified
+  foundBins.clear();
+  if (!mNOccBins) return 0;
+  if (zmax < mZMin || zmin > mZMax || zmin > zmax) return 0;
+  int queryZBmin = GetZBin(zmin);
+  if (queryZBmin < 0) queryZBmin = 0;
+  int queryZBmax = GetZBin(zmax);
+  if (queryZBmax >= mNZBins) queryZBmax = mNZBins - 1;
+  BringTo02Pi(phimin);
+  BringTo02Pi(phimax);
+  const int queryPhiBmin = GetPhiBin(phimin);
+  const int queryPhiBmax = GetPhiBin(phimax);
+  int dbz = 0;
+  int nFoundClusters = 0;
+  int nbcheck = queryPhiBmax - queryPhiBmin + 1;
+  if (nbcheck > 0) { // no wrapping around 0-2pi, fast case
+    for (int ip = queryPhiBmin;ip <= queryPhiBmax;ip++) {
+      int binID = GetBinIndex(queryZBmin,ip);
+      if ( !(dbz = (queryZBmax-queryZBmin)) ) { // just one Z bin in the query range
+        ClBinInfo_t& binInfo = mBins[binID];
+        if (!binInfo.ncl) continue;
+        nFoundClusters += binInfo.ncl;
+        foundBins.push_back(binID);
+        continue;
+      }
+      int binMax = binID + dbz;
+      for ( ; binID <= binMax; binID++) {
+        ClBinInfo_t& binInfo = mBins[binID];
+        if (!binInfo.ncl) continue;
+        nFoundClusters += binInfo.ncl;
+        foundBins.push_back(binID);
+      }
+    }
+  } else {  // wrapping
+    nbcheck += mNPhiBins;
+    for (int ip0 = 0;ip0 <= nbcheck;ip0++) {
+      int ip = queryPhiBmin + ip0;
+      if (ip >= mNPhiBins) ip -= mNPhiBins;
+      int binID = GetBinIndex(queryZBmin,ip);
+      if ( !(dbz = (queryZBmax - queryZBmin)) ) { // just one Z bin in the query range
+        ClBinInfo_t& binInfo = mBins[binID];
+        if (!binInfo.ncl) continue;
+        nFoundClusters += binInfo.ncl;
+        foundBins.push_back(binID);
+        continue;
+      }
+      int binMax = binID + dbz;
+      for (;binID <= binMax;binID++) {
+        ClBinInfo_t& binInfo = mBins[binID];
+        if (!binInfo.ncl) continue;
+        nFoundClusters += binInfo.ncl;
+        foundBins.push_back(binID);
+      }
+    }
+  }
+  return nFoundClusters;
+}
+
 int TrackingStation::GetNextClusterInfoID() {
   if (mFoundBinIterator < 0) return 0;
   int currBin = mFoundBins[mFoundBinIterator];
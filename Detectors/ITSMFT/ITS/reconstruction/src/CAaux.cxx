@@ -10,19 +10,10 @@ Cell::Cell(int xx,int yy, int zz, int dd0, int dd1, float curv, array<float,3> n
   md0{dd0},
   md1{dd1},
   mN{n[0],n[1],n[2]},
-  mVector{xx,yy,zz,1u} {
-}
-
-bool Cell::Combine(Cell &neigh, int idd) {
-  // From outside inward
-  if (this->y() == neigh.z() && this->x() == neigh.y()) { // Cells sharing two points
-    mVector.push_back(idd);
-    if (neigh.GetLevel() + 1 > GetLevel()) {
-      SetLevel(neigh.GetLevel() + 1u);
-    }
-    return true;
-  }
-  return false;
+  mX{xx},
+  mY{yy},
+  mZ{zz},
+  mLevel{1} {
 }
 
 Track::Track(float x, float a, array<float,Base::Track::kNParams> p, array<float,Base::Track::kCovMatSize> c, int *cl) :
@@ -0,0 +1,100 @@
+/// \file ClusterErrorTable.cxx
+/// \brief Implementation of the parameterized ITS cluster errors
+#include <algorithm>
+#include <cmath>
+
+#include "ITSBase/GeometryTGeo.h"
+#include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/ClusterErrorTable.h"
+
+using namespace AliceO2::ITS;
+
+namespace {
+// range of the incidence angle binning; primaries at the outermost layer
+// stay well below this
+const Float_t kMaxTanLambda = 2.f;
+}
+
+ClusterErrorTable::ClusterErrorTable()
+  : mGeom(nullptr), mInvAngleStep(kNAngleBins / kMaxTanLambda)
+{
+}
+
+void ClusterErrorTable::init(Float_t pitchX, Float_t pitchZ)
+{
+  mSigmaY2.resize(kNLayers * kNSizeBins * kNAngleBins);
+  mSigmaZ2.resize(kNLayers * kNSizeBins * kNAngleBins);
+
+  // default parameterization: the binary pitch*span/sqrt(12) resolution,
+  // improved for multi-pixel clusters by the center-of-gravity interpolation
+  // and, along the beam, with the incidence angle as the charge sharing
+  // between the crossed pixels grows. The factors are a starting point;
+  // tuned tables overwrite them via setEntry
+  const Float_t angleStep = kMaxTanLambda / kNAngleBins;
+  for (Int_t layer = 0; layer < kNLayers; layer++) {
+    for (Int_t sizeBin = 0; sizeBin < kNSizeBins; sizeBin++) {
+      const Int_t span = sizeBin + 1;
+      const Float_t cog = span > 1 ? 0.35f : 1.f;
+      const Float_t sy = pitchX * span;
+      const Float_t sz = pitchZ * span;
+      const Float_t sigmaY2 = sy * sy / 12.f * cog;
+      const Float_t sigmaZ2 = sz * sz / 12.f * cog;
+      for (Int_t angleBin = 0; angleBin < kNAngleBins; angleBin++) {
+        const Float_t tanL = (angleBin + 0.5f) * angleStep;
+        mSigmaY2[binIndex(layer, sizeBin, angleBin)] = sigmaY2;
+        mSigmaZ2[binIndex(layer, sizeBin, angleBin)] = sigmaZ2 / (1.f + 0.5f * tanL);
+      }
+    }
+  }
+}
+
+void ClusterErrorTable::setEntry(Int_t layer, Int_t sizeBin, Int_t angleBin,
+                                 Float_t sigmaY2, Float_t sigmaZ2)
+{
+  mSigmaY2[binIndex(layer, sizeBin, angleBin)] = sigmaY2;
+  mSigmaZ2[binIndex(layer, sizeBin, angleBin)] = sigmaZ2;
+}
+
+void ClusterErrorTable::apply(Cluster* clusters, Int_t n) const
+{
+  if (!mGeom || !isInitialized()) {
+    return;
+  }
+
+  // the clusterers emit the clusters chip by chip, so the layer and the chip
+  // position are resolved once per contiguous chip group
+  Int_t first = 0;
+  while (first < n) {
+    const UShort_t chip = clusters[first].getVolumeId();
+    Int_t last = first + 1;
+    while (last < n && clusters[last].getVolumeId() == chip) {
+      last++;
+    }
+
+    Int_t layer = mGeom->getLayer(chip);
+    if (layer >= kNLayers) {
+      layer = kNLayers - 1;
+    }
+    const Double_t center[3] = { 0., 0., 0. };
+    Double_t glo[3];
+    mGeom->localToGlobal(chip, center, glo);
+    const Float_t r = std::sqrt(glo[0] * glo[0] + glo[1] * glo[1]);
+    const Float_t zChip = glo[2];
+    const Float_t* tableY = &mSigmaY2[layer * kNSizeBins * kNAngleBins];
+    const Float_t* tableZ = &mSigmaZ2[layer * kNSizeBins * kNAngleBins];
+
+    // clamped bin arithmetic only, no per-cluster branching; the sensor
+    // local z runs along the beam, so chip center plus local z approximates
+    // the global z of the primary-track incidence estimate
+    for (Int_t i = first; i < last; i++) {
+      Cluster& c = clusters[i];
+      const Float_t tanL = std::abs(zChip + c.getZ()) / r;
+      const Int_t angleBin = std::min(Int_t(tanL * mInvAngleStep), Int_t(kNAngleBins) - 1);
+      const Int_t binY = std::min(std::max(c.getNx() - 1, 0), Int_t(kNSizeBins) - 1);
+      const Int_t binZ = std::min(std::max(c.getNz() - 1, 0), Int_t(kNSizeBins) - 1);
+      c.setSigmaY2(tableY[binY * kNAngleBins + angleBin]);
+      c.setSigmaZ2(tableZ[binZ * kNAngleBins + angleBin]);
+    }
+    first = last;
+  }
+}
@@ -0,0 +1,109 @@
+/// \file ClusterLabels.cxx
+/// \brief Implementation of the compact MC truth container
+
+#include <TClonesArray.h>
+
+#include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/ClusterLabels.h"
+
+using namespace AliceO2::ITS;
+
+//__________________________________________________________________________
+void ClusterLabels::fill(const TClonesArray& clusters)
+{
+  clear();
+  Int_t numOfClusters = clusters.GetEntriesFast();
+  mOffsets.reserve(numOfClusters + 1);
+  mLabels.reserve(numOfClusters); // most clusters carry a single label
+  mOffsets.push_back(0);
+  for (Int_t i = 0; i < numOfClusters; i++) {
+    Cluster* c = static_cast<Cluster*>(clusters.UncheckedAt(i));
+    Int_t labels[3];
+    Int_t n = 0;
+    for (Int_t j = 0; j < 3; j++) {
+      Int_t label = c->getLabel(j);
+      if (label < 0)
+        break;
+      labels[n++] = label;
+    }
+    addCluster(labels, n);
+  }
+}
+
+//__________________________________________________________________________
+Int_t ClusterLabels::addCluster(const Int_t* labels, Int_t n)
+{
+  if (mOffsets.empty())
+    mOffsets.push_back(0);
+  mLabels.insert(mLabels.end(), labels, labels + n);
+  mOffsets.push_back(mLabels.size());
+  return mOffsets.size() - 2;
+}
+
+//__________________________________________________________________________
+Int_t ClusterLabels::cookLabel(const Int_t* clusterIds, Int_t n, Float_t wrong) const
+{
+  //--------------------------------------------------------------------
+  // "Cook" the label of a candidate out of its cluster labels.
+  // A label<0 indicates that some of the clusters are wrongly assigned.
+  //--------------------------------------------------------------------
+  if (n < 1)
+    return -1;
+  std::vector<Int_t> lb(n, -1);
+  std::vector<Int_t> mx(n, 0);
+
+  Int_t lab = -1;
+  for (Int_t i = 0; i < n; i++) {
+    // a cluster without truth information does not vote
+    if (getNumberOfLabels(clusterIds[i]) < 1)
+      continue;
+    lab = getLabels(clusterIds[i])[0];
+    Int_t j;
+    for (j = 0; j < n; j++)
+      if (lb[j] == lab || mx[j] == 0)
+        break;
+    if (j < n) {
+      lb[j] = lab;
+      (mx[j])++;
+    }
+  }
+
+  Int_t max = 0;
+  for (Int_t i = 0; i < n; i++)
+    if (mx[i] > max) {
+      max = mx[i];
+      lab = lb[i];
+    }
+  if (max == 0)
+    return -1;
+
+  // the other labels of the triplet count as correct assignments
+  for (Int_t i = 0; i < n; i++) {
+    Int_t nl = getNumberOfLabels(clusterIds[i]);
+    if (nl < 1)
+      continue;
+    const Int_t* labels = getLabels(clusterIds[i]);
+    if (labels[0] == lab)
+      continue;
+    for (Int_t j = 1; j < nl; j++)
+      if (labels[j] == lab) {
+        max++;
+        break;
+      }
+  }
+
+  if ((1. - Float_t(max) / n) > wrong)
+    lab = -lab;
+  return lab;
+}
+
+//__________________________________________________________________________
+void ClusterLabels::cookLabels(const std::vector<Int_t>& offsets, const std::vector<Int_t>& indices,
+                               Float_t wrong, std::vector<Int_t>& labels) const
+{
+  Int_t numOfTracks = offsets.empty() ? 0 : offsets.size() - 1;
+  labels.resize(numOfTracks);
+  for (Int_t i = 0; i < numOfTracks; i++) {
+    labels[i] = cookLabel(indices.data() + offsets[i], offsets[i + 1] - offsets[i], wrong);
+  }
+}
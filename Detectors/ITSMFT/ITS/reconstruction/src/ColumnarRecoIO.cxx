@@ -0,0 +1,375 @@
+/// \file ColumnarRecoIO.cxx
+/// \brief Implementation of the columnar I/O for the ITS reconstruction products
+
+#include "ITSReconstruction/ColumnarRecoIO.h"
+#include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/CookedTrack.h"
+
+#include "FairLogger.h"
+#include "TClonesArray.h"
+
+#include <zlib.h>
+#include <cstring>
+
+using namespace AliceO2::ITS;
+
+namespace
+{
+const char kMagic[8] = { 'O', '2', 'I', 'T', 'S', 'C', 'O', 'L' };
+
+// append the raw bytes of a value or vector to a column block
+template <typename T>
+void appendValue(std::vector<char>& data, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+}
+
+//_____________________________________________________________________
+ColumnarRecoWriter::ColumnarRecoWriter()
+  : mFile(), mDirectory(), mWriterThread(), mMutex(), mStateChange(), mQueue(), mDone(kFALSE), mFailed(kFALSE)
+{
+}
+
+//_____________________________________________________________________
+ColumnarRecoWriter::~ColumnarRecoWriter() { close(); }
+
+//_____________________________________________________________________
+Bool_t ColumnarRecoWriter::open(const char* filename)
+{
+  if (mFile.is_open()) {
+    LOG(ERROR) << "ColumnarRecoWriter: already open" << FairLogger::endl;
+    return kFALSE;
+  }
+  mFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!mFile.is_open()) {
+    LOG(ERROR) << "ColumnarRecoWriter: cannot open " << filename << FairLogger::endl;
+    return kFALSE;
+  }
+  mFile.write(kMagic, sizeof(kMagic));
+  mDirectory.clear();
+  mDone = kFALSE;
+  mFailed = !mFile.good();
+  mWriterThread = std::thread(&ColumnarRecoWriter::writerLoop, this);
+  return kTRUE;
+}
+
+//_____________________________________________________________________
+void ColumnarRecoWriter::writeTracks(Int_t event, const TClonesArray& tracks)
+{
+  const Int_t numOfTracks = tracks.GetEntriesFast();
+  EventBlock block;
+  block.event = event;
+  block.columns.resize(kNTrackColumns);
+  for (Int_t c = 0; c < kNTrackColumns; c++) {
+    block.columns[c].product = kProductTracks;
+    block.columns[c].column = c;
+    block.columns[c].count = numOfTracks;
+  }
+
+  std::vector<char>& offsets = block.columns[kTrackClusterOffsets].data;
+  std::vector<char>& indices = block.columns[kTrackClusterIndices].data;
+  Int_t indexCount = 0;
+  appendValue(offsets, indexCount);
+
+  for (Int_t i = 0; i < numOfTracks; i++) {
+    const CookedTrack* track = static_cast<const CookedTrack*>(tracks.UncheckedAt(i));
+    const AliceO2::Base::Track::TrackParCov& par = track->getTrackParCov();
+    appendValue(block.columns[kTrackX].data, par.GetX());
+    appendValue(block.columns[kTrackAlpha].data, par.GetAlpha());
+    std::vector<char>& parData = block.columns[kTrackPar].data;
+    appendValue(parData, par.GetY());
+    appendValue(parData, par.GetZ());
+    appendValue(parData, par.GetSnp());
+    appendValue(parData, par.GetTgl());
+    appendValue(parData, par.GetQ2Pt());
+    std::vector<char>& covData = block.columns[kTrackCov].data;
+    appendValue(covData, par.GetSigmaY2());
+    appendValue(covData, par.GetSigmaZY());
+    appendValue(covData, par.GetSigmaZ2());
+    appendValue(covData, par.GetSigmaSnpY());
+    appendValue(covData, par.GetSigmaSnpZ());
+    appendValue(covData, par.GetSigmaSnp2());
+    appendValue(covData, par.GetSigmaTglY());
+    appendValue(covData, par.GetSigmaTglZ());
+    appendValue(covData, par.GetSigmaTglSnp());
+    appendValue(covData, par.GetSigmaTgl2());
+    appendValue(covData, par.GetSigma1PtY());
+    appendValue(covData, par.GetSigma1PtZ());
+    appendValue(covData, par.GetSigma1PtSnp());
+    appendValue(covData, par.GetSigma1PtTgl());
+    appendValue(covData, par.GetSigma1Pt2());
+    appendValue(block.columns[kTrackChi2].data, Float_t(track->getChi2()));
+    appendValue(block.columns[kTrackLabel].data, Int_t(track->getLabel()));
+
+    const Int_t numOfClusters = track->getNumberOfClusters();
+    for (Int_t c = 0; c < numOfClusters; c++) {
+      appendValue(indices, Int_t(track->getClusterIndex(c)));
+      indexCount++;
+    }
+    appendValue(offsets, indexCount);
+  }
+  block.columns[kTrackClusterOffsets].count = numOfTracks + 1;
+  block.columns[kTrackClusterIndices].count = indexCount;
+
+  queueEvent(std::move(block));
+}
+
+//_____________________________________________________________________
+void ColumnarRecoWriter::writeClusters(Int_t event, const TClonesArray& clusters)
+{
+  const Int_t numOfClusters = clusters.GetEntriesFast();
+  EventBlock block;
+  block.event = event;
+  block.columns.resize(kNClusterColumns);
+  for (Int_t c = 0; c < kNClusterColumns; c++) {
+    block.columns[c].product = kProductClusters;
+    block.columns[c].column = c;
+    block.columns[c].count = numOfClusters;
+  }
+
+  for (Int_t i = 0; i < numOfClusters; i++) {
+    const Cluster* cluster = static_cast<const Cluster*>(clusters.UncheckedAt(i));
+    appendValue(block.columns[kClusterX].data, cluster->getX());
+    appendValue(block.columns[kClusterY].data, cluster->getY());
+    appendValue(block.columns[kClusterZ].data, cluster->getZ());
+    appendValue(block.columns[kClusterSigmaY2].data, cluster->getSigmaY2());
+    appendValue(block.columns[kClusterSigmaZ2].data, cluster->getSigmaZ2());
+    appendValue(block.columns[kClusterSigmaYZ].data, cluster->getSigmaYZ());
+    appendValue(block.columns[kClusterVolumeId].data, cluster->getVolumeId());
+    appendValue(block.columns[kClusterLabel].data, Int_t(cluster->getLabel(0)));
+  }
+
+  queueEvent(std::move(block));
+}
+
+//_____________________________________________________________________
+void ColumnarRecoWriter::queueEvent(EventBlock&& block)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  if (mDone || !mWriterThread.joinable()) {
+    LOG(WARNING) << "ColumnarRecoWriter: not open, event " << block.event << " dropped" << FairLogger::endl;
+    return;
+  }
+  // backpressure: a slow disk stalls the producer here instead of
+  // accumulating events in memory
+  while (mQueue.size() >= kMaxQueuedEvents) {
+    mStateChange.wait(lock);
+  }
+  mQueue.push_back(std::move(block));
+  mStateChange.notify_all();
+}
+
+//_____________________________________________________________________
+void ColumnarRecoWriter::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  for (;;) {
+    while (mQueue.empty() && !mDone) {
+      mStateChange.wait(lock);
+    }
+    if (mQueue.empty()) {
+      return;
+    }
+    EventBlock block(std::move(mQueue.front()));
+    mQueue.pop_front();
+    mStateChange.notify_all(); // a producer may be waiting for queue space
+
+    lock.unlock();
+    writeEvent(block);
+    lock.lock();
+  }
+}
+
+//_____________________________________________________________________
+void ColumnarRecoWriter::writeEvent(const EventBlock& block)
+{
+  std::vector<char> compressed;
+  for (const auto& column : block.columns) {
+    PageRecord record;
+    record.event = block.event;
+    record.product = column.product;
+    record.column = column.column;
+    record.count = column.count;
+    record.rawSize = column.data.size();
+
+    // fastest zlib level: the columns are homogeneous and shrink well
+    // even at level 1, and the writer thread must keep up with the
+    // producer
+    uLongf compressedSize = compressBound(record.rawSize);
+    compressed.resize(compressedSize);
+    const Bool_t ok =
+      record.rawSize > 0 &&
+      compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                reinterpret_cast<const Bytef*>(column.data.data()), record.rawSize, Z_BEST_SPEED) == Z_OK &&
+      compressedSize < record.rawSize;
+    const char* payload = ok ? compressed.data() : column.data.data();
+    record.compressedSize = ok ? compressedSize : record.rawSize;
+
+    mFile.write(reinterpret_cast<const char*>(&record.event), sizeof(record.event));
+    mFile.write(reinterpret_cast<const char*>(&record.product), sizeof(record.product));
+    mFile.write(reinterpret_cast<const char*>(&record.column), sizeof(record.column));
+    mFile.write(reinterpret_cast<const char*>(&record.count), sizeof(record.count));
+    mFile.write(reinterpret_cast<const char*>(&record.rawSize), sizeof(record.rawSize));
+    mFile.write(reinterpret_cast<const char*>(&record.compressedSize), sizeof(record.compressedSize));
+    record.offset = mFile.tellp();
+    if (record.compressedSize > 0) {
+      mFile.write(payload, record.compressedSize);
+    }
+    mDirectory.push_back(record);
+  }
+  if (!mFile.good()) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFailed = kTRUE;
+  }
+}
+
+//_____________________________________________________________________
+Bool_t ColumnarRecoWriter::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mWriterThread.joinable()) {
+      return !mFailed;
+    }
+    mDone = kTRUE;
+    mStateChange.notify_all();
+  }
+  mWriterThread.join();
+
+  const ULong64_t directoryOffset = mFile.tellp();
+  const UInt_t numOfPages = mDirectory.size();
+  mFile.write(reinterpret_cast<const char*>(&numOfPages), sizeof(numOfPages));
+  for (const auto& record : mDirectory) {
+    mFile.write(reinterpret_cast<const char*>(&record.event), sizeof(record.event));
+    mFile.write(reinterpret_cast<const char*>(&record.product), sizeof(record.product));
+    mFile.write(reinterpret_cast<const char*>(&record.column), sizeof(record.column));
+    mFile.write(reinterpret_cast<const char*>(&record.count), sizeof(record.count));
+    mFile.write(reinterpret_cast<const char*>(&record.rawSize), sizeof(record.rawSize));
+    mFile.write(reinterpret_cast<const char*>(&record.compressedSize), sizeof(record.compressedSize));
+    mFile.write(reinterpret_cast<const char*>(&record.offset), sizeof(record.offset));
+  }
+  mFile.write(reinterpret_cast<const char*>(&directoryOffset), sizeof(directoryOffset));
+  mFile.write(kMagic, sizeof(kMagic));
+  if (!mFile.good()) {
+    mFailed = kTRUE;
+  }
+  mFile.close();
+  mDirectory.clear();
+  if (mFailed) {
+    LOG(ERROR) << "ColumnarRecoWriter: file writes failed, output incomplete" << FairLogger::endl;
+  }
+  return !mFailed;
+}
+
+//_____________________________________________________________________
+ColumnarRecoReader::ColumnarRecoReader() : mFile(), mPages(), mLoaded(), mNEvents(0) {}
+
+//_____________________________________________________________________
+ColumnarRecoReader::~ColumnarRecoReader() { close(); }
+
+//_____________________________________________________________________
+Bool_t ColumnarRecoReader::open(const char* filename)
+{
+  close();
+  mFile.open(filename, std::ios::in | std::ios::binary);
+  if (!mFile.is_open()) {
+    LOG(ERROR) << "ColumnarRecoReader: cannot open " << filename << FairLogger::endl;
+    return kFALSE;
+  }
+
+  char magic[8];
+  ULong64_t directoryOffset = 0;
+  mFile.read(magic, sizeof(magic));
+  const Bool_t headerOk = mFile.good() && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+  mFile.seekg(-static_cast<std::streamoff>(sizeof(directoryOffset) + sizeof(magic)), std::ios::end);
+  mFile.read(reinterpret_cast<char*>(&directoryOffset), sizeof(directoryOffset));
+  mFile.read(magic, sizeof(magic));
+  if (!headerOk || !mFile.good() || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    LOG(ERROR) << "ColumnarRecoReader: " << filename << " is not a complete columnar file" << FairLogger::endl;
+    close();
+    return kFALSE;
+  }
+
+  mFile.seekg(directoryOffset);
+  UInt_t numOfPages = 0;
+  mFile.read(reinterpret_cast<char*>(&numOfPages), sizeof(numOfPages));
+  UInt_t lastEvent = 0;
+  Bool_t first = kTRUE;
+  for (UInt_t i = 0; i < numOfPages && mFile.good(); i++) {
+    PageRecord record;
+    mFile.read(reinterpret_cast<char*>(&record.event), sizeof(record.event));
+    mFile.read(reinterpret_cast<char*>(&record.product), sizeof(record.product));
+    mFile.read(reinterpret_cast<char*>(&record.column), sizeof(record.column));
+    mFile.read(reinterpret_cast<char*>(&record.count), sizeof(record.count));
+    mFile.read(reinterpret_cast<char*>(&record.rawSize), sizeof(record.rawSize));
+    mFile.read(reinterpret_cast<char*>(&record.compressedSize), sizeof(record.compressedSize));
+    mFile.read(reinterpret_cast<char*>(&record.offset), sizeof(record.offset));
+    mPages[pageKey(record.event, record.product, record.column)] = record;
+    if (first || record.event != lastEvent) {
+      mNEvents++;
+      lastEvent = record.event;
+      first = kFALSE;
+    }
+  }
+  if (!mFile.good()) {
+    LOG(ERROR) << "ColumnarRecoReader: truncated directory in " << filename << FairLogger::endl;
+    close();
+    return kFALSE;
+  }
+  return kTRUE;
+}
+
+//_____________________________________________________________________
+void ColumnarRecoReader::close()
+{
+  if (mFile.is_open()) {
+    mFile.close();
+  }
+  mFile.clear();
+  mPages.clear();
+  mLoaded.clear();
+  mNEvents = 0;
+}
+
+//_____________________________________________________________________
+const void* ColumnarRecoReader::column(UInt_t event, UShort_t product, UShort_t column, UInt_t& count)
+{
+  count = 0;
+  const ULong64_t key = pageKey(event, product, column);
+  auto page = mPages.find(key);
+  if (page == mPages.end()) {
+    return nullptr;
+  }
+
+  auto loaded = mLoaded.find(key);
+  if (loaded == mLoaded.end()) {
+    const PageRecord& record = page->second;
+    std::vector<char> data(record.rawSize);
+    mFile.seekg(record.offset);
+    if (record.rawSize == 0) {
+      // empty column (e.g. no attached clusters), nothing to read
+    } else if (record.compressedSize == record.rawSize) { // stored uncompressed
+      mFile.read(data.data(), record.rawSize);
+      if (!mFile.good()) {
+        LOG(ERROR) << "ColumnarRecoReader: short read of page at " << record.offset << FairLogger::endl;
+        return nullptr;
+      }
+    } else {
+      std::vector<char> compressed(record.compressedSize);
+      mFile.read(compressed.data(), record.compressedSize);
+      uLongf rawSize = record.rawSize;
+      if (!mFile.good() ||
+          uncompress(reinterpret_cast<Bytef*>(data.data()), &rawSize,
+                     reinterpret_cast<const Bytef*>(compressed.data()), record.compressedSize) != Z_OK ||
+          rawSize != record.rawSize) {
+        LOG(ERROR) << "ColumnarRecoReader: corrupt page at " << record.offset << FairLogger::endl;
+        return nullptr;
+      }
+    }
+    loaded = mLoaded.emplace(key, std::move(data)).first;
+  }
+  count = page->second.count;
+  return loaded->second.data();
+}
@@ -142,7 +142,19 @@ Double_t CookedTrack::getPredictedChi2(const Cluster* c) const
 Bool_t CookedTrack::propagate(Double_t alpha, Double_t x, Double_t bz)
 {
   if (mTrack.Rotate(float(alpha)))
-    if (mTrack.PropagateTo(float(x), float(bz)))
+    if (mTrack.PropagateTo<Precision::FastFloat>(float(x), float(bz)))
+      return kTRUE;
+
+  return kFALSE;
+}
+
+Bool_t CookedTrack::propagatePrecise(Double_t alpha, Double_t x, Double_t bz)
+{
+  //--------------------------------------------------------------------
+  // Same transport with double intermediates, for the final refit
+  //--------------------------------------------------------------------
+  if (mTrack.Rotate(float(alpha)))
+    if (mTrack.PropagateTo<Precision::ExactDouble>(float(x), float(bz)))
       return kTRUE;
 
   return kFALSE;
@@ -161,7 +173,51 @@ Bool_t CookedTrack::update(const Cluster* c, Double_t chi2, Int_t idx)
   std::array<float,2> p{ c->getY(), c->getZ() };
   std::array<float,3> cov{ c->getSigmaY2(), c->getSigmaYZ(), c->getSigmaZ2() };
 
-  if (!mTrack.Update(p, cov))
+  if (!mTrack.Update<Precision::FastFloat>(p, cov))
+    return kFALSE;
+
+  mChi2 += chi2;
+  mIndex.push_back(idx);
+
+  return kTRUE;
+}
+
+Double_t CookedTrack::getPredictedChi2(Float_t y, Float_t z, const Float_t cov[3]) const
+{
+  //-----------------------------------------------------------------
+  // Chi2 increment predicted from a cached measurement
+  //-----------------------------------------------------------------
+  std::array<float,2> p{ y, z };
+  std::array<float,3> c{ cov[0], cov[1], cov[2] };
+  return mTrack.GetPredictedChi2(p, c);
+}
+
+Bool_t CookedTrack::update(Float_t y, Float_t z, const Float_t cov[3], Double_t chi2, Int_t idx)
+{
+  //--------------------------------------------------------------------
+  // Update track params with a cached measurement
+  //--------------------------------------------------------------------
+  std::array<float,2> p{ y, z };
+  std::array<float,3> c{ cov[0], cov[1], cov[2] };
+
+  if (!mTrack.Update<Precision::FastFloat>(p, c))
+    return kFALSE;
+
+  mChi2 += chi2;
+  mIndex.push_back(idx);
+
+  return kTRUE;
+}
+
+Bool_t CookedTrack::updatePrecise(Float_t y, Float_t z, const Float_t cov[3], Double_t chi2, Int_t idx)
+{
+  //--------------------------------------------------------------------
+  // Same update with double intermediates, for the final refit
+  //--------------------------------------------------------------------
+  std::array<float,2> p{ y, z };
+  std::array<float,3> c{ cov[0], cov[1], cov[2] };
+
+  if (!mTrack.Update<Precision::ExactDouble>(p, c))
     return kFALSE;
 
   mChi2 += chi2;
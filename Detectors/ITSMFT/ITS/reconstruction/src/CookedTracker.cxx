@@ -17,6 +17,7 @@
 
 #include "DetectorsBase/Constants.h"
 #include "Field/MagneticField.h"
+#include "Instrumentation/Probe.h"
 #include "ITSReconstruction/Cluster.h"
 #include "ITSReconstruction/CookedTrack.h"
 #include "ITSReconstruction/CookedTracker.h"
@@ -24,6 +25,16 @@
 using namespace AliceO2::ITS;
 using namespace AliceO2::Base::Constants;
 using AliceO2::Field::MagneticField;
+using AliceO2::Instrumentation::ProbeSite;
+using AliceO2::Instrumentation::ScopedProbe;
+
+// stage probes of the tracking latency budget; summarized by name in
+// CookedTrackerTask::FinishTask, compiled out with O2_DISABLE_PROBES
+static ProbeSite sLoadProbe{"its.tracking.load"};
+static ProbeSite sSeedProbe{"its.tracking.seed"};
+static ProbeSite sTrackProbe{"its.tracking.track"};
+static ProbeSite sRefitProbe{"its.tracking.refit"};
+static ProbeSite sLabelProbe{"its.tracking.label"};
 
 //************************************************
 // Constants hardcoded for the moment:
@@ -46,6 +57,8 @@ const Double_t kRoadY = 0.2;
 const Double_t kRoadZ = 0.7;
 // Minimal number of attached clusters
 const Int_t kminNumberOfClusters = 4;
+// Seeding clusters claimed at once from the shared work counter
+const Int_t kSeedChunkSize = 16;
 
 //************************************************
 // TODO:
@@ -56,7 +69,9 @@ const Int_t kminNumberOfClusters = 4;
 
 CookedTracker::Layer CookedTracker::sLayers[CookedTracker::kNLayers];
 
-CookedTracker::CookedTracker(Int_t n) : mNumOfThreads(n), mBz(0.)
+CookedTracker::CookedTracker(Int_t n)
+  : mNumOfThreads(n), mBz(0.), mField(nullptr), mNumberOfSeeds(0), mVertexConstrainedSeeding(kFALSE),
+    mSectorWindow12(0), mSectorWindow3(0)
 {
   //--------------------------------------------------------------------
   // This default constructor needs to be provided
@@ -78,6 +93,8 @@ CookedTracker::~CookedTracker()
   //--------------------------------------------------------------------
   // Virtual destructor
   //--------------------------------------------------------------------
+  for (auto *data : mThreadData)
+    delete data;
 }
 
 //__________________________________________________________________________
@@ -87,6 +104,7 @@ void CookedTracker::cookLabel(CookedTrack& t, Float_t wrong) const
   // This function "cooks" a track label.
   // A label<0 indicates that some of the clusters are wrongly assigned.
   //--------------------------------------------------------------------
+  ScopedProbe<> probe{sLabelProbe};
   Int_t noc = t.getNumberOfClusters();
   if (noc < 1)
     return;
@@ -165,6 +183,28 @@ Double_t CookedTracker::getBz() const
   */
 }
 
+Double_t CookedTracker::getBz(Double_t z) const
+{
+  //--------------------------------------------------------------------
+  // Z-dependent Bz on the beam axis. The propagator takes a constant
+  // field per step anyway, so the on-axis value at the current z is the
+  // right constant to hand it.
+  //--------------------------------------------------------------------
+  if (!mField)
+    return mBz;
+  Double_t xyz[3] = { 0., 0., z };
+  return mField->getBzFast(xyz);
+}
+
+void CookedTracker::setMagneticField(const MagneticField* fld)
+{
+  mField = fld;
+  if (mField) {
+    Double_t origin[3] = { 0., 0., 0. };
+    mBz = mField->getBzFast(origin);
+  }
+}
+
 static Double_t f1(Double_t x1, Double_t y1, Double_t x2, Double_t y2, Double_t x3, Double_t y3)
 {
   //-----------------------------------------------------------------
@@ -267,7 +307,184 @@ static CookedTrack cookSeed
   return CookedTrack(x3, alpha, par, cov);
 }
 
-void CookedTracker::makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_t last)
+void CookedTracker::SeedPool::clear()
+{
+  mX.clear();
+  mAlpha.clear();
+  mPhi.clear();
+  mPt.clear();
+  mChi2.clear();
+  mPar.clear();
+  mCov.clear();
+  mLabel.clear();
+  mNumOfClusters.clear();
+  mIndex.clear();
+  mOrder.clear();
+}
+
+void CookedTracker::SeedPool::reserve(Int_t n)
+{
+  mX.reserve(n);
+  mAlpha.reserve(n);
+  mPhi.reserve(n);
+  mPt.reserve(n);
+  mChi2.reserve(n);
+  mPar.reserve(n * kNPar);
+  mCov.reserve(n * kNCov);
+  mLabel.reserve(n);
+  mNumOfClusters.reserve(n);
+  mIndex.reserve(n * kNLayers);
+}
+
+void CookedTracker::SeedPool::addSeed(const CookedTrack& t, Float_t phi)
+{
+  const AliceO2::Base::Track::TrackParCov& tp = t.getTrackParCov();
+  mX.push_back(tp.GetX());
+  mAlpha.push_back(tp.GetAlpha());
+  mPhi.push_back(phi);
+  mPt.push_back(t.getPt());
+  mChi2.push_back(t.getChi2());
+  mPar.push_back(tp.GetY());
+  mPar.push_back(tp.GetZ());
+  mPar.push_back(tp.GetSnp());
+  mPar.push_back(tp.GetTgl());
+  mPar.push_back(tp.GetQ2Pt());
+  mCov.push_back(tp.GetSigmaY2());
+  mCov.push_back(tp.GetSigmaZY());
+  mCov.push_back(tp.GetSigmaZ2());
+  mCov.push_back(tp.GetSigmaSnpY());
+  mCov.push_back(tp.GetSigmaSnpZ());
+  mCov.push_back(tp.GetSigmaSnp2());
+  mCov.push_back(tp.GetSigmaTglY());
+  mCov.push_back(tp.GetSigmaTglZ());
+  mCov.push_back(tp.GetSigmaTglSnp());
+  mCov.push_back(tp.GetSigmaTgl2());
+  mCov.push_back(tp.GetSigma1PtY());
+  mCov.push_back(tp.GetSigma1PtZ());
+  mCov.push_back(tp.GetSigma1PtSnp());
+  mCov.push_back(tp.GetSigma1PtTgl());
+  mCov.push_back(tp.GetSigma1Pt2());
+  mLabel.push_back(t.getLabel());
+  Int_t noc = t.getNumberOfClusters();
+  if (noc > Int_t(kNLayers))
+    noc = kNLayers;
+  mNumOfClusters.push_back(noc);
+  size_t base = mIndex.size();
+  mIndex.resize(base + kNLayers, -1);
+  for (Int_t k = 0; k < noc; k++)
+    mIndex[base + k] = t.getClusterIndex(k);
+}
+
+void CookedTracker::SeedPool::getSeed(Int_t i, CookedTrack& t) const
+{
+  const Float_t* par = &mPar[i * kNPar];
+  const Float_t* cov = &mCov[i * kNCov];
+  std::array<float, kNPar> p{ par[0], par[1], par[2], par[3], par[4] };
+  std::array<float, kNCov> c{ cov[0], cov[1], cov[2], cov[3], cov[4], cov[5], cov[6], cov[7],
+                              cov[8], cov[9], cov[10], cov[11], cov[12], cov[13], cov[14] };
+  t = CookedTrack(mX[i], mAlpha[i], p, c);
+  t.setLabel(mLabel[i]);
+  t.setChi2(mChi2[i]);
+  const Int_t* index = &mIndex[i * kNLayers];
+  for (Int_t k = 0; k < mNumOfClusters[i]; k++)
+    t.addClusterIndex(index[k]);
+}
+
+void CookedTracker::SeedPool::setResult(Int_t i, const CookedTrack& t)
+{
+  const AliceO2::Base::Track::TrackParCov& tp = t.getTrackParCov();
+  mX[i] = tp.GetX();
+  mAlpha[i] = tp.GetAlpha();
+  mPt[i] = t.getPt();
+  mChi2[i] = t.getChi2();
+  Float_t* par = &mPar[i * kNPar];
+  par[0] = tp.GetY();
+  par[1] = tp.GetZ();
+  par[2] = tp.GetSnp();
+  par[3] = tp.GetTgl();
+  par[4] = tp.GetQ2Pt();
+  Float_t* cov = &mCov[i * kNCov];
+  cov[0] = tp.GetSigmaY2();
+  cov[1] = tp.GetSigmaZY();
+  cov[2] = tp.GetSigmaZ2();
+  cov[3] = tp.GetSigmaSnpY();
+  cov[4] = tp.GetSigmaSnpZ();
+  cov[5] = tp.GetSigmaSnp2();
+  cov[6] = tp.GetSigmaTglY();
+  cov[7] = tp.GetSigmaTglZ();
+  cov[8] = tp.GetSigmaTglSnp();
+  cov[9] = tp.GetSigmaTgl2();
+  cov[10] = tp.GetSigma1PtY();
+  cov[11] = tp.GetSigma1PtZ();
+  cov[12] = tp.GetSigma1PtSnp();
+  cov[13] = tp.GetSigma1PtTgl();
+  cov[14] = tp.GetSigma1Pt2();
+  mLabel[i] = t.getLabel();
+  Int_t noc = t.getNumberOfClusters();
+  if (noc > Int_t(kNLayers))
+    noc = kNLayers;
+  mNumOfClusters[i] = noc;
+  Int_t* index = &mIndex[i * kNLayers];
+  for (Int_t k = 0; k < noc; k++)
+    index[k] = t.getClusterIndex(k);
+}
+
+void CookedTracker::SeedPool::sortForProcessing()
+{
+  const Int_t n = size();
+  mOrder.resize(n);
+  for (Int_t i = 0; i < n; i++)
+    mOrder[i] = i;
+  const Float_t toSector = kSortSectors / Float_t(2. * TMath::Pi());
+  std::sort(mOrder.begin(), mOrder.end(), [this, toSector](Int_t a, Int_t b) {
+    const Int_t sa = Int_t(mPhi[a] * toSector);
+    const Int_t sb = Int_t(mPhi[b] * toSector);
+    if (sa != sb)
+      return sa < sb;
+    return mPt[a] > mPt[b];
+  });
+}
+
+void CookedTracker::prepareSeedingWindows()
+{
+  //--------------------------------------------------------------------
+  // Precompute, for the current vertex, the bin-compatibility windows
+  // between the seeding layers over the Layer grids. The windows are
+  // conservative for the kminPt curvature range: they only restrict which
+  // bins the pair search visits, the exact cuts of makeSeeds stay in place.
+  //--------------------------------------------------------------------
+  Layer& layer1 = sLayers[kSeedingLayer1];
+  Layer& layer2 = sLayers[kSeedingLayer2];
+
+  const Double_t pi2 = 2. * TMath::Pi();
+  const Double_t zv = getZ();
+  const Double_t r1 = layer1.getR();
+  const Double_t r2 = layer2.getR();
+  const Int_t ns = layer2.getNumberOfSectors();
+
+  // the same phi windows the pair loops cut on
+  const Double_t maxC = TMath::Abs(getBz() * kB2C / kminPt);
+  const Double_t kpWin = TMath::ASin(0.5 * maxC * r1) - TMath::ASin(0.5 * maxC * r2);
+  mSectorWindow12 = Int_t(kpWin * ns / pi2) + 1;
+  // the third-layer window is centered with the mean layer radius; the extra
+  // sector covers the radius spread of the staves up to the kminPt curvature
+  mSectorWindow3 = Int_t((kpWin / 100) * ns / pi2) + 2;
+
+  // per layer-1 z-bin range of layer-2 z-bins compatible with the projection
+  // zr2 = zv + r2/r1*(z1 - zv) +- kzWin through the vertex
+  const Int_t nzb = layer1.getNumberOfZBins();
+  mZBinFirst12.resize(nzb);
+  mZBinLast12.resize(nzb);
+  const Double_t scale = r2 / r1;
+  for (Int_t zb = 0; zb < nzb; zb++) {
+    Double_t z1lo = layer1.getZBinLowEdge(zb);
+    Double_t z1hi = layer1.getZBinLowEdge(zb + 1);
+    mZBinFirst12[zb] = layer2.zToBin(zv + scale * (z1lo - zv) - kzWin);
+    mZBinLast12[zb] = layer2.zToBin(zv + scale * (z1hi - zv) + kzWin);
+  }
+}
+
+void CookedTracker::makeSeeds(SeedPool &seeds, Int_t first, Int_t last)
 {
   //--------------------------------------------------------------------
   // This is the main pattern recongition function.
@@ -286,48 +503,79 @@ void CookedTracker::makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_
   Int_t nClusters2 = layer2.getNumberOfClusters();
   Int_t nClusters3 = layer3.getNumberOfClusters();
 
+  // candidate buffers of the vertex-constrained mode
+  std::vector<Int_t> sel2, sel3;
+
   for (Int_t n1 = first; n1 < last; n1++) {
-    Cluster* c1 = layer1.getCluster(n1);
     //
-    // Int_t lab=c1->getLabel(0);
+    // Int_t lab=layer1.getClusterLabel(n1);
     //
-    Double_t z1 = c1->getZ();
-    Float_t xyz1[3];
-    c1->getGlobalXYZ(xyz1);
+    Double_t z1 = layer1.getClusterZ(n1);
+    Float_t xyz1[3]{ layer1.getClusterX(n1), layer1.getClusterY(n1), Float_t(z1) };
     Double_t r1 = TMath::Sqrt(xyz1[0] * xyz1[0] + xyz1[1] * xyz1[1]);
     Double_t phi1 = layer1.getClusterPhi(n1);
 
     Double_t zr2 = zv + layer2.getR() / r1 * (z1 - zv);
-    Int_t start2 = layer2.findClusterIndex(zr2 - kzWin);
-    for (Int_t n2 = start2; n2 < nClusters2; n2++) {
-      Cluster* c2 = layer2.getCluster(n2);
+    Int_t start2 = 0, nCand2 = 0;
+    if (mVertexConstrainedSeeding) {
+      Int_t s1 = layer2.phiToSector(phi1);
+      Int_t zb1 = layer1.zToBin(z1);
+      sel2.clear();
+      layer2.selectBinRange(sel2, s1 - mSectorWindow12, s1 + mSectorWindow12,
+                            mZBinFirst12[zb1], mZBinLast12[zb1]);
+      nCand2 = sel2.size();
+    } else {
+      start2 = layer2.findClusterIndex(zr2 - kzWin);
+      nCand2 = nClusters2 - start2;
+    }
+    for (Int_t j2 = 0; j2 < nCand2; j2++) {
+      Int_t n2 = mVertexConstrainedSeeding ? sel2[j2] : start2 + j2;
       //
-      // if (c2->getLabel(0)!=lab) continue;
+      // if (layer2.getClusterLabel(n2)!=lab) continue;
       //
-      Double_t z2 = c2->getZ();
-      if (z2 > (zr2 + kzWin))
+      Double_t z2 = layer2.getClusterZ(n2);
+      if (z2 > (zr2 + kzWin)) {
+        if (mVertexConstrainedSeeding)
+          continue; // the bins are not globally z-ordered
         break; // check in Z
+      }
+      if (mVertexConstrainedSeeding && z2 <= (zr2 - kzWin))
+        continue;
 
       Double_t phi2 = layer2.getClusterPhi(n2);
       if (TMath::Abs(phi2 - phi1) > kpWin)
         continue; // check in Phi
 
-      Float_t xyz2[4];
-      c2->getGlobalXYZ(xyz2);
+      Float_t xyz2[4]{ layer2.getClusterX(n2), layer2.getClusterY(n2), Float_t(z2), 0.f };
       Double_t r2 = TMath::Sqrt(xyz2[0] * xyz2[0] + xyz2[1] * xyz2[1]);
       Double_t crv = f1(xyz1[0], xyz1[1], xyz2[0], xyz2[1], getX(), getY());
 
       Double_t zr3 = z1 + (layer3.getR() - r1) / (r2 - r1) * (z2 - z1);
       Double_t dz = kzWin / 2;
-      Int_t start3 = layer3.findClusterIndex(zr3 - dz);
-      for (Int_t n3 = start3; n3 < nClusters3; n3++) {
-        Cluster* c3 = layer3.getCluster(n3);
+      Int_t start3 = 0, nCand3 = 0;
+      if (mVertexConstrainedSeeding) {
+        Int_t s3 = layer3.phiToSector(phi1 + 0.5 * crv * (layer3.getR() - r1));
+        sel3.clear();
+        layer3.selectBinRange(sel3, s3 - mSectorWindow3, s3 + mSectorWindow3,
+                              layer3.zToBin(zr3 - dz), layer3.zToBin(zr3 + dz));
+        nCand3 = sel3.size();
+      } else {
+        start3 = layer3.findClusterIndex(zr3 - dz);
+        nCand3 = nClusters3 - start3;
+      }
+      for (Int_t j3 = 0; j3 < nCand3; j3++) {
+        Int_t n3 = mVertexConstrainedSeeding ? sel3[j3] : start3 + j3;
         //
-        // if (c3->getLabel(0)!=lab) continue;
+        // if (layer3.getClusterLabel(n3)!=lab) continue;
         //
-        Double_t z3 = c3->getZ();
-        if (z3 > (zr3 + dz))
+        Double_t z3 = layer3.getClusterZ(n3);
+        if (z3 > (zr3 + dz)) {
+          if (mVertexConstrainedSeeding)
+            continue; // the bins are not globally z-ordered
           break; // check in Z
+        }
+        if (mVertexConstrainedSeeding && z3 <= (zr3 - dz))
+          continue;
 
         Double_t r3 = layer3.getXRef(n3);
         Double_t phir3 = phi1 + 0.5 * crv * (r3 - r1);
@@ -335,19 +583,15 @@ void CookedTracker::makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_
         if (TMath::Abs(phir3 - phi3) > kpWin / 100)
           continue; // check in Phi
 
-        Float_t txyz2[4];
-        c2->getTrackingXYZ(txyz2);
-        txyz2[0]= layer2.getXRef(n2);
-        txyz2[3]= layer2.getR();
+        Float_t txyz2[4]{ layer2.getXRef(n2), layer2.getClusterTrackingY(n2), layer2.getClusterTrackingZ(n2),
+                          layer2.getR() };
 
-        Float_t xyz3[4];
-        c3->getGlobalXYZ(xyz3);
-	xyz3[3] = layer3.getR();
+        Float_t xyz3[4]{ layer3.getClusterX(n3), layer3.getClusterY(n3), Float_t(z3), layer3.getR() };
 
-	CookedTrack seed = cookSeed(xyz1, xyz3, txyz2, layer2.getAlphaRef(n2), getBz());
+	CookedTrack seed = cookSeed(xyz1, xyz3, txyz2, layer2.getAlphaRef(n2), getBz(txyz2[2]));
 
 	Double_t ip[2];
-        seed.getImpactParams(getX(), getY(), getZ(), getBz(), ip);
+        seed.getImpactParams(getX(), getY(), getZ(), getBz(getZ()), ip);
         if (TMath::Abs(ip[0]) > kmaxDCAxy) continue;
         if (TMath::Abs(ip[1]) > kmaxDCAz ) continue;
 	{
@@ -360,7 +604,13 @@ void CookedTracker::makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_
         seed.setClusterIndex(kSeedingLayer3, n3);
         seed.setClusterIndex(kSeedingLayer2, n2);
 
-        seeds.push_back(seed);
+        Float_t phi = seed.getAlpha() + TMath::ATan2(seed.getY(), seed.getX());
+        const Float_t pi2 = 2. * TMath::Pi();
+        if (phi < 0.)
+          phi += pi2;
+        else if (phi >= pi2)
+          phi -= pi2;
+        seeds.addSeed(seed, phi);
       }
     }
   }
@@ -380,20 +630,20 @@ void CookedTracker::makeSeeds(std::vector<CookedTrack> &seeds, Int_t first, Int_
   */
 }
 
-void CookedTracker::trackSeeds(std::vector<CookedTrack> &seeds)
+void CookedTracker::trackSeeds(SeedPool &seeds, ThreadData &data)
 {
   //--------------------------------------------------------------------
-  // Loop over a subset of track seeds
+  // Loop over a subset of track seeds, in the phi-grouped pool order
   //--------------------------------------------------------------------
-  std::vector<bool>  used[kSeedingLayer2];
-  std::vector<Int_t> selec[kSeedingLayer2];
-  for (Int_t l = kSeedingLayer2 - 1; l >= 0; l--) {
-    Int_t n=sLayers[l].getNumberOfClusters();
-    used[l].resize(n,false);
-    selec[l].reserve(n/100);
-  }
-
-  for (auto &track : seeds) {
+  std::vector<bool>  *used  = data.mUsed;
+  std::vector<Int_t> *selec = data.mSelected;
+  for (Int_t l = kSeedingLayer2 - 1; l >= 0; l--)
+    data.prepare(l, sLayers[l].getNumberOfClusters());
+  data.mRefit.clear();
+
+  CookedTrack track;
+  for (Int_t si : seeds.getProcessingOrder()) {
+    seeds.getSeed(si, track);
     Double_t x = track.getX();
     Double_t y = track.getY();
     Double_t phi = track.getAlpha() + TMath::ATan2(y, x);
@@ -404,7 +654,7 @@ void CookedTracker::trackSeeds(std::vector<CookedTrack> &seeds)
       phi -= pi2;
 
     Double_t z = track.getZ();
-    Double_t crv = track.getCurvature(getBz());
+    Double_t crv = track.getCurvature(getBz(z));
     Double_t tgl = track.getTgl();
     Double_t r1 = sLayers[kSeedingLayer2].getR();
 
@@ -461,26 +711,46 @@ void CookedTracker::trackSeeds(std::vector<CookedTrack> &seeds)
         Int_t l = (index & 0xf0000000) >> 28, c = (index & 0x0fffffff);
         used[l][c]=true;
       }
+      data.mRefit.recordFootprint(*this, best);
       setExternalIndices(best);
     }
-    track = best;
+    seeds.setResult(si, best);
   }
 
 }
 
-std::vector<CookedTrack> CookedTracker::trackInThread(Int_t first, Int_t last)
+CookedTracker::SeedPool CookedTracker::trackInThread(std::atomic<Int_t> *nextChunk, Int_t numOfClusters, ThreadData *data)
 {
   //--------------------------------------------------------------------
   // This function is passed to a tracking thread
   //--------------------------------------------------------------------
-  std::vector<CookedTrack> seeds;
-  seeds.reserve(last-first+1);
-  
-  makeSeeds(seeds, first, last);
-  std::sort(seeds.begin(), seeds.end());
+  SeedPool seeds;
+  seeds.reserve(numOfClusters/mNumOfThreads + 1);
+
+  // The threads claim fixed-size chunks of seeding clusters from the shared
+  // counter, so a thread done with a sparse azimuthal region steals the work
+  // left over by the ones stuck in a dense region instead of idling.
+  {
+    ScopedProbe<> probe{sSeedProbe};
+    while (true) {
+      Int_t first = nextChunk->fetch_add(kSeedChunkSize);
+      if (first >= numOfClusters)
+        break;
+      makeSeeds(seeds, first, TMath::Min(first + kSeedChunkSize, numOfClusters));
+    }
+    seeds.sortForProcessing();
+  }
+
+  // the seed extension needs the inner layers, whose indexing has been
+  // running in the background since loadClusters
+  if (mInnerLayersReady.valid())
+    mInnerLayersReady.wait();
+
+  {
+    ScopedProbe<> probe{sTrackProbe};
+    trackSeeds(seeds, *data);
+  }
 
-  trackSeeds(seeds);
-  
   return seeds;
 }
 
@@ -495,9 +765,30 @@ void CookedTracker::process(const TClonesArray& clusters, TClonesArray& tracks)
 
   loadClusters(clusters);
 
+  auto end = std::chrono::system_clock::now();
+  std::chrono::duration<double> diff = end-start;
+  LOG(INFO)<<"Loading time: "<<diff.count()<<" s"<<FairLogger::endl;
+
+  processLoadedClusters(tracks);
+
+  end = std::chrono::system_clock::now();
+  diff = end-start;
+  LOG(INFO)<<"Processing time: "<<diff.count()<<" s"<<FairLogger::endl;
+
+  unloadClusters();
+
+}
+
+void CookedTracker::processLoadedClusters(TClonesArray& tracks)
+{
+  //--------------------------------------------------------------------
+  // Tracking of the already loaded clusters
+  //--------------------------------------------------------------------
   // Seeding with the triggered primary vertex
   Double_t xyz[3]{ 0, 0, 0 }; // FIXME
   setVertex(xyz);
+  if (mVertexConstrainedSeeding)
+    prepareSeedingWindows();
   //mSeeds = makeSeeds(0, sLayers[kSeedingLayer1].getNumberOfClusters());
 
   // Seeding with the pileup primary vertices
@@ -513,43 +804,78 @@ void CookedTracker::process(const TClonesArray& clusters, TClonesArray& tracks)
   }
   */
 
-  auto end = std::chrono::system_clock::now();
-  std::chrono::duration<double> diff = end-start;
-  LOG(INFO)<<"Loading time: "<<diff.count()<<" s"<<FairLogger::endl;
+  std::vector<std::future<SeedPool>> futures(mNumOfThreads);
+  std::vector<SeedPool> seedArray(mNumOfThreads);
 
+  // the scratch data survive across events, only the allocations missing for
+  // additional threads are made here
+  while (mThreadData.size() < static_cast<size_t>(mNumOfThreads))
+    mThreadData.push_back(new ThreadData);
 
-  std::vector<std::future<std::vector<CookedTrack>>> futures(mNumOfThreads);
-  std::vector<std::vector<CookedTrack>> seedArray(mNumOfThreads);
-  
   Int_t numOfClusters = sLayers[kSeedingLayer1].getNumberOfClusters();
-  for (Int_t t=0,first=0; t<mNumOfThreads; t++) {
-    Int_t rem = t < (numOfClusters % mNumOfThreads) ? 1 : 0;
-    Int_t last = first + (numOfClusters/mNumOfThreads) + rem;
-    futures[t] = std::async(std::launch::async, &CookedTracker::trackInThread, this, first, last);
-    first = last;
+  std::atomic<Int_t> nextChunk(0);
+  for (Int_t t=0; t<mNumOfThreads; t++) {
+    futures[t] = std::async(std::launch::async, &CookedTracker::trackInThread, this, &nextChunk, numOfClusters, mThreadData[t]);
   }
   
   Int_t nSeeds = 0, ngood=0;
+  CookedTrack track;
   for (Int_t t=0; t<mNumOfThreads; t++) {
     seedArray[t] = futures[t].get();
-    nSeeds += seedArray[t].size();
-    for (auto &track : seedArray[t]) {
-      if (track.getNumberOfClusters() < kminNumberOfClusters) continue;
-      Int_t label = track.getLabel();
-      if (label >= 0) ngood++;
+    const SeedPool &pool = seedArray[t];
+    nSeeds += pool.size();
+    // walk the pool in its processing order, so that the stored tracks stay
+    // aligned with the refit footprints recorded by the thread
+    for (Int_t si : pool.getProcessingOrder()) {
+      if (pool.getNumberOfClusters(si) < kminNumberOfClusters) continue;
+      pool.getSeed(si, track);
+      if (track.getLabel() >= 0) ngood++;
       new (tracks[tracks.GetEntriesFast()]) CookedTrack(track);
     }
   }
 
-  end = std::chrono::system_clock::now();
-  diff = end-start;
-  LOG(INFO)<<"Processing time: "<<diff.count()<<" s"<<FairLogger::endl;
+  mNumberOfSeeds = nSeeds;
 
   if (nSeeds)
     LOG(INFO)<<"CookedTracker::process(), good_tracks/seeds: "<<Float_t(ngood)/nSeeds<<'\n'<<FairLogger::endl;
 
-  unloadClusters();
-  
+}
+
+Int_t CookedTracker::refitOutward(std::vector<CookedTrack>& tracks)
+{
+  //--------------------------------------------------------------------
+  // Outward refit of the tracks stored by processLoadedClusters, in the
+  // order they were stored. The refit runs entirely on the attachment
+  // caches recorded during the inward pass: no layer structure is touched,
+  // so the threads just split the tracks between themselves.
+  //--------------------------------------------------------------------
+  ScopedProbe<> probe{sRefitProbe};
+  std::vector<std::future<Int_t>> futures;
+  Int_t base = 0;
+  for (size_t t = 0; t < mThreadData.size() && t < static_cast<size_t>(mNumOfThreads); t++) {
+    const RefitEngine& engine = mThreadData[t]->mRefit;
+    Int_t n = engine.getNumberOfTracks();
+    if (base + n > static_cast<Int_t>(tracks.size()))
+      n = static_cast<Int_t>(tracks.size()) - base;
+    if (n <= 0)
+      break;
+    futures.push_back(std::async(std::launch::async, [this, &engine, &tracks, base, n]() {
+      Int_t nok = 0;
+      for (Int_t i = 0; i < n; i++)
+        if (engine.refitTrack(i, tracks[base + i], getBz(tracks[base + i].getZ())))
+          nok++;
+      return nok;
+    }));
+    base += n;
+  }
+
+  Int_t ntrk = 0;
+  for (auto& f : futures)
+    ntrk += f.get();
+
+  LOG(INFO) << "CookedTracker::refitOutward(), refitted tracks: " << ntrk << FairLogger::endl;
+
+  return ntrk;
 }
 
 /*
@@ -693,6 +1019,7 @@ void CookedTracker::loadClusters(const TClonesArray& clusters)
   // This function reads the ITSU clusters from the tree,
   // sort them, distribute over the internal tracker arrays, etc
   //--------------------------------------------------------------------
+  ScopedProbe<> probe{sLoadProbe};
   Int_t numOfClusters = clusters.GetEntriesFast();
   if (numOfClusters == 0) {
     LOG(FATAL) << "No clusters to load !" << FairLogger::endl;
@@ -712,15 +1039,24 @@ void CookedTracker::loadClusters(const TClonesArray& clusters)
       continue;
   }
 
+  // The seeding layers are indexed right away since the seed finding starts
+  // on them; the indexing of the inner layers overlaps with the seed finding
+  // and is waited for only when the seed extension needs them.
   std::vector<std::future<void>> fut;
-  for (Int_t l = 0; l < kNLayers; l+=mNumOfThreads) {
-    for (Int_t t = 0; t < mNumOfThreads; t++) {
-      if (l+t >= kNLayers) break;
-      auto f=std::async(std::launch::async, &CookedTracker::Layer::init, sLayers+(l+t));
-      fut.push_back(std::move(f));
-    }
-    for (Int_t t = 0; t < fut.size(); t++) fut[t].wait();
+  for (Int_t l = kSeedingLayer2; l < kNLayers; l++) {
+    auto f=std::async(std::launch::async, &CookedTracker::Layer::init, sLayers+l);
+    fut.push_back(std::move(f));
   }
+  for (Int_t t = 0; t < fut.size(); t++) fut[t].wait();
+
+  mInnerLayersReady = std::async(std::launch::async, []() {
+    std::vector<std::future<void>> innerFut;
+    for (Int_t l = 0; l < kSeedingLayer2; l++) {
+      auto f=std::async(std::launch::async, &CookedTracker::Layer::init, sLayers+l);
+      innerFut.push_back(std::move(f));
+    }
+    for (Int_t t = 0; t < innerFut.size(); t++) innerFut[t].wait();
+  }).share();
 }
 
 void CookedTracker::unloadClusters()
@@ -742,6 +1078,69 @@ Cluster* CookedTracker::getCluster(Int_t index) const
   return sLayers[l].getCluster(c);
 }
 
+void CookedTracker::RefitEngine::recordFootprint(const CookedTracker& tracker, const CookedTrack& t)
+{
+  //--------------------------------------------------------------------
+  // Record the attachment list of a fitted track, innermost layer first.
+  // This is the only place dereferencing the clusters; the refit itself
+  // runs on the compact cache.
+  //--------------------------------------------------------------------
+  if (mTrackStart.empty())
+    mTrackStart.push_back(0);
+
+  AttachedCluster acc[kNLayers];
+  Bool_t filled[kNLayers] = { kFALSE };
+  Int_t noc = t.getNumberOfClusters();
+  for (Int_t k = 0; k < noc; k++) {
+    Int_t index = t.getClusterIndex(k);
+    Int_t l = (index & 0xf0000000) >> 28;
+    const Cluster* c = tracker.getCluster(index);
+    AttachedCluster& a = acc[l];
+    c->getXAlphaRefPlane(a.xRef, a.alphaRef);
+    Float_t txyz[3]; // the seeding-layer clusters stay in the global frame
+    c->getTrackingXYZ(txyz);
+    a.y = txyz[1];
+    a.z = txyz[2];
+    a.cov[0] = c->getSigmaY2();
+    a.cov[1] = c->getSigmaYZ();
+    a.cov[2] = c->getSigmaZ2();
+    a.index = index;
+    filled[l] = kTRUE;
+  }
+  for (Int_t l = 0; l < kNLayers; l++)
+    if (filled[l])
+      mClusters.push_back(acc[l]);
+
+  mTrackStart.push_back(mClusters.size());
+}
+
+Bool_t CookedTracker::RefitEngine::refitTrack(Int_t i, CookedTrack& t, Double_t bz) const
+{
+  //--------------------------------------------------------------------
+  // Refit the i-th recorded track outwards, using only the cache
+  //--------------------------------------------------------------------
+  t.resetCovariance(10.);
+  t.resetClusters();
+
+  for (Int_t k = mTrackStart[i]; k < mTrackStart[i + 1]; k++) {
+    const AttachedCluster& a = mClusters[k];
+    if (!t.propagatePrecise(a.alphaRef, a.xRef, bz))
+      return kFALSE;
+    Double_t chi2 = t.getPredictedChi2(a.y, a.z, a.cov);
+    if (chi2 < kmaxChi2PerCluster)
+      if (!t.updatePrecise(a.y, a.z, a.cov, chi2, a.index))
+        return kFALSE;
+
+    Int_t l = (a.index & 0xf0000000) >> 28;
+    Double_t xx0 = (l > 2) ? 0.008 : 0.003; // Rough layer thickness
+    Double_t x0 = 9.36;                     // Radiation length of Si [cm]
+    Double_t rho = 2.33;                    // Density of Si [g/cm^3]
+    t.correctForMeanMaterial(xx0, -xx0 * x0 * rho, kTRUE);
+  }
+
+  return t.getNumberOfClusters() >= kminNumberOfClusters;
+}
+
 CookedTracker::Layer::Layer() : mR(0)
 {
   //--------------------------------------------------------------------
@@ -763,7 +1162,7 @@ void CookedTracker::Layer::init()
   Int_t m=mClusters.size();
   for (Int_t i = 0; i < m; i++) {
     Cluster* c = mClusters[i];
-    Float_t xRef, aRef; 
+    Float_t xRef, aRef;
     c->getXAlphaRefPlane(xRef, aRef);
     mXRef.push_back(xRef);
     mAlphaRef.push_back(aRef);
@@ -776,11 +1175,40 @@ void CookedTracker::Layer::init()
     else if (phi >= pi2)
       phi -= pi2;
     mPhi.push_back(phi);
-    Int_t s=phi*kNSectors/pi2;
-    mSectors[s].push_back(i);
+    mX.push_back(xyz[0]);
+    mY.push_back(xyz[1]);
+    mZ.push_back(c->getZ());
+    Float_t txyz[3];
+    c->getTrackingXYZ(txyz);
+    mTrkY.push_back(txyz[1]);
+    mTrkZ.push_back(txyz[2]);
+    mLabel.push_back(c->getLabel(0));
   }
 
   if (m) mR = r/m;
+
+  // Sort the cluster indices into the fixed phi x z grid with CSR-style
+  // contiguous per-bin ranges. The clusters are visited in z order, so the
+  // counting sort keeps each bin z-sorted.
+  mZMin = m ? mZ.front() : 0.f;
+  const Float_t zMax = m ? mZ.back() : 0.f;
+  mZBinInv = (zMax - mZMin) > 0.f ? kNZBins/(zMax - mZMin) : 0.f;
+
+  mBinStart.assign(kNBins + 1, 0);
+  mBinIndex.resize(m);
+  auto binOf = [this, pi2](Int_t i) {
+    Int_t s = mPhi[i]*kNSectors/pi2;
+    Int_t zb = (mZ[i] - mZMin)*mZBinInv;
+    if (zb >= kNZBins) zb = kNZBins - 1;
+    return s*kNZBins + zb;
+  };
+  for (Int_t i = 0; i < m; i++)
+    mBinStart[binOf(i) + 1]++;
+  for (Int_t b = 0; b < kNBins; b++)
+    mBinStart[b + 1] += mBinStart[b];
+  std::vector<Int_t> cursor(mBinStart.begin(), mBinStart.end() - 1);
+  for (Int_t i = 0; i < m; i++)
+    mBinIndex[cursor[binOf(i)]++] = i;
 }
 
 void CookedTracker::Layer::unloadClusters()
@@ -792,7 +1220,14 @@ void CookedTracker::Layer::unloadClusters()
   mXRef.clear();
   mAlphaRef.clear();
   mPhi.clear();
-  for (Int_t s=0; s<kNSectors; s++) mSectors[s].clear();
+  mX.clear();
+  mY.clear();
+  mZ.clear();
+  mTrkY.clear();
+  mTrkZ.clear();
+  mLabel.clear();
+  mBinStart.clear();
+  mBinIndex.clear();
 }
 
 Bool_t CookedTracker::Layer::insertCluster(Cluster* c)
@@ -826,31 +1261,79 @@ CookedTracker::Layer::selectClusters(std::vector<Int_t>&selec, Float_t phi, Floa
 
   const Float_t pi2 = 2. * TMath::Pi();
   Float_t dphi = dy / mR;
-  
+
   Float_t phiMin = phi - dphi;
   Float_t phiMax = phi + dphi;
-  Float_t phiRange[2]{phiMin, phiMax};
-
-  Int_t n=0;
-  Int_t sector=-1;
-  for (auto phiM : phiRange) {
-    Int_t s = phiM*kNSectors/pi2;
-    if (s<0) s+=kNSectors;
-    else if (s>=kNSectors) s-=kNSectors;
-    
-    if (s==sector) break;
-    sector=s;
-
-    auto cmp = [this](Double_t zc, Int_t ic){ return (zc < mClusters[ic]->getZ()); };
-    auto imin = std::upper_bound(std::begin(mSectors[s]), std::end(mSectors[s]), zMin, cmp); 
-    auto imax = std::upper_bound(imin, std::end(mSectors[s]), zMax, cmp);
-    for ( ; imin != imax; imin++) {
-      Int_t i = *imin; 
-      Float_t cphi = mPhi[i];
-      if (cphi <= phiMin) continue;
-      if (cphi > phiMax) continue;
-    
-      selec.push_back(i);
+
+  if (mBinIndex.empty())
+    return;
+
+  // the road maps to a small rectangle of grid bins; the candidates come
+  // from the contiguous per-bin ranges, only the edge test remains exact
+  Int_t zbMin = (zMin - mZMin)*mZBinInv;
+  Int_t zbMax = (zMax - mZMin)*mZBinInv;
+  if (zbMin < 0) zbMin = 0;
+  if (zbMax >= kNZBins) zbMax = kNZBins - 1;
+  if (zbMin > zbMax) return;
+
+  const Int_t sMin = TMath::FloorNint(phiMin*kNSectors/pi2);
+  const Int_t sMax = TMath::FloorNint(phiMax*kNSectors/pi2);
+
+  for (Int_t is = sMin; is <= sMax; is++) {
+    Int_t s = is % kNSectors;
+    if (s < 0) s += kNSectors;
+    for (Int_t zb = zbMin; zb <= zbMax; zb++) {
+      const Int_t bin = s*kNZBins + zb;
+      for (Int_t k = mBinStart[bin]; k < mBinStart[bin + 1]; k++) {
+        Int_t i = mBinIndex[k];
+        Float_t cz = mZ[i];
+        if (cz <= zMin) continue;
+        if (cz > zMax) break; // z-sorted within the bin
+        Float_t cphi = mPhi[i];
+        if (cphi <= phiMin) continue;
+        if (cphi > phiMax) continue;
+
+        selec.push_back(i);
+      }
+    }
+  }
+}
+
+Int_t CookedTracker::Layer::phiToSector(Float_t phi) const
+{
+  //--------------------------------------------------------------------
+  // The phi sector of the grid containing the given azimuth
+  //--------------------------------------------------------------------
+  return TMath::FloorNint(phi * kNSectors / (2. * TMath::Pi()));
+}
+
+void
+CookedTracker::Layer::selectBinRange(std::vector<Int_t>& selec, Int_t sMin, Int_t sMax, Int_t zbMin, Int_t zbMax) const
+{
+  //--------------------------------------------------------------------
+  // Collect the cluster indices of a rectangle of grid bins; the exact
+  // cuts on the collected candidates remain with the caller
+  //--------------------------------------------------------------------
+  if (mBinIndex.empty())
+    return;
+
+  if (zbMin < 0)
+    zbMin = 0;
+  if (zbMax >= kNZBins)
+    zbMax = kNZBins - 1;
+  if (sMax - sMin >= kNSectors) {
+    sMin = 0;
+    sMax = kNSectors - 1;
+  }
+
+  for (Int_t is = sMin; is <= sMax; is++) {
+    Int_t s = is % kNSectors;
+    if (s < 0)
+      s += kNSectors;
+    for (Int_t zb = zbMin; zb <= zbMax; zb++) {
+      const Int_t bin = s*kNZBins + zb;
+      for (Int_t k = mBinStart[bin]; k < mBinStart[bin + 1]; k++)
+        selec.push_back(mBinIndex[k]);
     }
   }
 }
@@ -870,7 +1353,7 @@ Bool_t CookedTracker::attachCluster(Int_t& volID, Int_t nl, Int_t ci, CookedTrac
     t = o;
     Double_t x = layer.getXRef(ci);
     Double_t alpha = layer.getAlphaRef(ci);
-    if (!t.propagate(alpha, x, getBz()))
+    if (!t.propagate(alpha, x, getBz(t.getZ())))
       return kFALSE;
   }
 
@@ -4,21 +4,35 @@
 
 #include "ITSReconstruction/CookedTrackerTask.h"
 #include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/ColumnarRecoIO.h"
+#include "DetectorsBase/InputPrefetcher.h"
+
+#include "Field/MagneticField.h"
+#include "Instrumentation/Probe.h"
 
 #include "FairLogger.h"      // for LOG
 #include "FairRootManager.h" // for FairRootManager
-#include "TClonesArray.h"    // for TClonesArray
+#include "TClonesArray.h"        // for TClonesArray
+#include "TGeoGlobalMagField.h"  // for TGeoGlobalMagField
+
+#include <algorithm>
 
 ClassImp(AliceO2::ITS::CookedTrackerTask)
 
   using namespace AliceO2::ITS;
 
+// the load/seed/track/refit/label stages are recorded by the probes sitting
+// in CookedTracker.cxx; the output writing is the only stage of the budget
+// owned by the task itself
+static AliceO2::Instrumentation::ProbeSite sStoreProbe{"its.tracking.store"};
+
 //_____________________________________________________________________
-CookedTrackerTask::CookedTrackerTask(Int_t n) : FairTask("ITSCookedTrackerTask"), mNumOfThreads(n), mClustersArray(nullptr), mTracksArray(nullptr) {}
+CookedTrackerTask::CookedTrackerTask(Int_t n) : FairTask("ITSCookedTrackerTask"), mNumOfThreads(n), mClustersArray(nullptr), mTracksArray(nullptr), mColumnarWriter(nullptr), mEventCounter(0), mPrefetchEvents(0), mPrefetcher(nullptr) {}
 
 //_____________________________________________________________________
 CookedTrackerTask::~CookedTrackerTask()
 {
+  delete mPrefetcher;
   if (mTracksArray) {
     mTracksArray->Delete();
     delete mTracksArray;
@@ -50,15 +64,67 @@ InitStatus CookedTrackerTask::Init()
   Cluster::setGeom(&mGeometry);
 
   mTracker.setNumberOfThreads(mNumOfThreads);
-  
+
+  // attach the field for the z-dependent Bz queries; without it the tracker
+  // keeps using the constant Bz set via setBz
+  auto* fld = dynamic_cast<AliceO2::Field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
+  if (fld) {
+    mTracker.setMagneticField(fld);
+  } else {
+    LOG(WARNING) << "Magnetic field is not loaded, the tracker will use the constant Bz" << FairLogger::endl;
+  }
+
+  if (mPrefetchEvents > 0) {
+    mPrefetcher = new Base::InputPrefetcher;
+    if (!mPrefetcher->init(mPrefetchEvents)) {
+      delete mPrefetcher;
+      mPrefetcher = nullptr;
+    }
+  }
+
   return kSUCCESS;
 }
 
 //_____________________________________________________________________
 void CookedTrackerTask::Exec(Option_t* option)
 {
+  if (mPrefetcher) {
+    mPrefetcher->notifyEntry(mEventCounter);
+  }
   mTracksArray->Clear();
   LOG(DEBUG) << "Running digitization on new event" << FairLogger::endl;
 
   mTracker.process(*mClustersArray, *mTracksArray);
+
+  if (mColumnarWriter) {
+    AliceO2::Instrumentation::ScopedProbe<> probe{sStoreProbe};
+    mColumnarWriter->writeTracks(mEventCounter, *mTracksArray);
+  }
+  mEventCounter++;
+}
+
+//_____________________________________________________________________
+void CookedTrackerTask::FinishTask()
+{
+  using AliceO2::Instrumentation::ProbeSite;
+  if (!AliceO2::Instrumentation::kProbesEnabled)
+    return;
+
+  // percentiles over the retained probe samples (the most recent
+  // ProbeSite::kRingSize records per stage and recording thread)
+  static const char* stages[] = { "its.tracking.load",  "its.tracking.seed",  "its.tracking.track",
+                                  "its.tracking.refit", "its.tracking.label", "its.tracking.store" };
+  LOG(INFO) << "CookedTrackerTask stage latencies over " << mEventCounter
+            << " events, in probe cycles:" << FairLogger::endl;
+  std::vector<uint64_t> samples;
+  for (const char* stage : stages) {
+    samples.clear();
+    if (ProbeSite::CollectSamplesFor(stage, samples) == 0)
+      continue;
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) { return samples[size_t(p * (samples.size() - 1))]; };
+    LOG(INFO) << "  " << stage << ": n=" << samples.size() << " p50=" << percentile(0.50)
+              << " p90=" << percentile(0.90) << " p99=" << percentile(0.99)
+              << " max=" << samples.back() << FairLogger::endl;
+  }
 }
@@ -0,0 +1,255 @@
+/// \file PixelClusterer.cxx
+/// \brief Implementation of the connected-component ITS pixel cluster finder
+#include <algorithm>
+#include <future>
+
+#include "ITSMFTBase/Digit.h"
+#include "ITSMFTBase/SegmentationPixel.h"
+#include "ITSReconstruction/Cluster.h"
+#include "ITSReconstruction/ClusterErrorTable.h"
+#include "ITSReconstruction/PixelClusterer.h"
+#include "ITSReconstruction/TopologyDictionary.h"
+
+#include "TClonesArray.h"
+
+using AliceO2::ITSMFT::SegmentationPixel;
+using AliceO2::ITSMFT::Digit;
+using namespace AliceO2::ITS;
+
+namespace {
+Int_t findRoot(std::vector<Int_t>& parent, Int_t i)
+{
+  // find with path halving
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/// Partial sums of one component of touching runs
+struct Component {
+  Double_t charge = 0.; ///< summed charge
+  Double_t x = 0.;      ///< charge-weighted local x sum
+  Double_t z = 0.;      ///< charge-weighted local z sum
+  Int_t numOfPixels = 0;
+  Int_t rowMin = 0, rowMax = 0;
+  Int_t colMin = 0, colMax = 0;
+  Int_t labels[3] = { -1, -1, -1 }; ///< first distinct digit labels
+  Int_t numOfLabels = 0;
+};
+}
+
+PixelClusterer::PixelClusterer(Int_t numOfThreads)
+  : mNumOfThreads(numOfThreads), mDictionary(nullptr), mErrorTable(nullptr)
+{
+}
+
+PixelClusterer::~PixelClusterer() {}
+
+void PixelClusterer::processChip(const SegmentationPixel* seg, const Digit* const* digits, Int_t n,
+                                 std::vector<Cluster>& clusters) const
+{
+  if (n == 0)
+    return;
+
+  // run-length encode the rows; the runs inherit the (row, col) order
+  std::vector<PixelRun> runs;
+  std::vector<Int_t> parent;
+  for (Int_t i = 0; i < n;) {
+    Int_t row = digits[i]->getRow();
+    Int_t j = i + 1;
+    while (j < n && digits[j]->getRow() == row &&
+           digits[j]->getColumn() == digits[j - 1]->getColumn() + 1)
+      j++;
+    runs.push_back({ row, digits[i]->getColumn(), digits[j - 1]->getColumn(), i, j - i });
+    parent.push_back(Int_t(parent.size()));
+    i = j;
+  }
+
+  // merge the runs sharing a column with a run of the previous row; p trails
+  // behind the current run and never backs up, so the pass stays linear
+  const Int_t numOfRuns = runs.size();
+  Int_t p = 0;
+  for (Int_t r = 1; r < numOfRuns; r++) {
+    const PixelRun& cur = runs[r];
+    while (p < r && (runs[p].row < cur.row - 1 ||
+                     (runs[p].row == cur.row - 1 && runs[p].colEnd < cur.colStart)))
+      p++;
+    for (Int_t q = p; q < r; q++) {
+      if (runs[q].row != cur.row - 1 || runs[q].colStart > cur.colEnd)
+        break;
+      Int_t a = findRoot(parent, q), b = findRoot(parent, r);
+      if (a < b)
+        parent[b] = a;
+      else if (b < a)
+        parent[a] = b;
+    }
+  }
+
+  // accumulate the components; every root keeps the creation order of its
+  // first run, so the output order is deterministic
+  std::vector<Component> components;
+  std::vector<Int_t> componentOf(numOfRuns, -1);
+  for (Int_t r = 0; r < numOfRuns; r++) {
+    const PixelRun& run = runs[r];
+    Int_t root = findRoot(parent, r);
+    Int_t ic = componentOf[root];
+    if (ic < 0) {
+      ic = components.size();
+      componentOf[root] = ic;
+      components.push_back(Component());
+      components[ic].rowMin = components[ic].rowMax = run.row;
+      components[ic].colMin = components[ic].colMax = run.colStart;
+    }
+    Component& comp = components[ic];
+    if (run.row < comp.rowMin)
+      comp.rowMin = run.row;
+    if (run.row > comp.rowMax)
+      comp.rowMax = run.row;
+    if (run.colStart < comp.colMin)
+      comp.colMin = run.colStart;
+    if (run.colEnd > comp.colMax)
+      comp.colMax = run.colEnd;
+
+    for (Int_t k = 0; k < run.numOfDigits; k++) {
+      const Digit* dig = digits[run.firstDigit + k];
+      Float_t x = 0., z = 0.;
+      seg->detectorToLocal(run.row, run.colStart + k, x, z);
+      Double_t charge = dig->getCharge();
+      comp.charge += charge;
+      comp.x += charge * x;
+      comp.z += charge * z;
+      comp.numOfPixels++;
+      Int_t lab = dig->getLabel(0);
+      Int_t l = 0;
+      while (l < comp.numOfLabels && comp.labels[l] != lab)
+        l++;
+      if (l == comp.numOfLabels && l < 3)
+        comp.labels[comp.numOfLabels++] = lab;
+    }
+  }
+
+  // the dictionary works on the topology - the pixel bitmap of the bounding
+  // box - so the bitmaps are filled in a second pass, once the bounds are known
+  std::vector<UChar_t> patterns;
+  const Bool_t useDictionary = mDictionary && mDictionary->isOpen();
+  if (useDictionary) {
+    patterns.resize(components.size() * TopologyDictionary::kPatternBytes, 0);
+    for (Int_t r = 0; r < numOfRuns; r++) {
+      const PixelRun& run = runs[r];
+      Int_t ic = componentOf[findRoot(parent, r)];
+      const Component& comp = components[ic];
+      Int_t colSpan = comp.colMax - comp.colMin + 1;
+      if (comp.rowMax - comp.rowMin + 1 > TopologyDictionary::kMaxRowSpan ||
+          colSpan > TopologyDictionary::kMaxColSpan)
+        continue;
+      UChar_t* pattern = patterns.data() + ic * TopologyDictionary::kPatternBytes;
+      for (Int_t col = run.colStart; col <= run.colEnd; col++) {
+        Int_t bit = (run.row - comp.rowMin) * colSpan + (col - comp.colMin);
+        pattern[bit >> 3] |= 1 << (bit & 7);
+      }
+    }
+  }
+
+  // emit one cluster per component at the charge-weighted center of gravity
+  const UShort_t chip = digits[0]->getChipIndex();
+  for (size_t ic = 0; ic < components.size(); ic++) {
+    const Component& comp = components[ic];
+    Int_t nx = comp.rowMax - comp.rowMin + 1;
+    Int_t nz = comp.colMax - comp.colMin + 1;
+    Float_t sx = nx * seg->cellSizeX();
+    Float_t sz = nz * seg->cellSizeZ(comp.colMin);
+
+    Float_t x = comp.charge > 0. ? comp.x / comp.charge : 0.f;
+    Float_t z = comp.charge > 0. ? comp.z / comp.charge : 0.f;
+    Float_t sigmaY2 = sx * sx / 12.;
+    Float_t sigmaZ2 = sz * sz / 12.;
+    if (useDictionary && nx <= TopologyDictionary::kMaxRowSpan &&
+        nz <= TopologyDictionary::kMaxColSpan) {
+      ULong64_t hash = TopologyDictionary::computeHash(
+        nx, nz, patterns.data() + ic * TopologyDictionary::kPatternBytes);
+      Float_t dx, dz, sy2, sz2;
+      if (mDictionary->getCorrection(hash, dx, dz, sy2, sz2)) {
+        x += dx;
+        z += dz;
+        sigmaY2 = sy2;
+        sigmaZ2 = sz2;
+      }
+    }
+
+    Cluster c;
+    c.setVolumeId(chip);
+    c.setX(x);
+    c.setY(0.);
+    c.setZ(z);
+    c.setSigmaY2(sigmaY2);
+    c.setSigmaZ2(sigmaZ2);
+    c.setNxNzN(nx, nz, comp.numOfPixels);
+    c.setFrameLoc();
+    for (Int_t l = 0; l < comp.numOfLabels; l++)
+      c.setLabel(comp.labels[l], l);
+
+    clusters.push_back(c);
+  }
+}
+
+void PixelClusterer::process(const SegmentationPixel* seg, const TClonesArray* digits,
+                             TClonesArray* clusters)
+{
+  Int_t numOfDigits = digits->GetEntriesFast();
+  if (numOfDigits == 0)
+    return;
+
+  // order the digit pointers chip by chip, by (row, col) within a chip
+  std::vector<const Digit*> sorted(numOfDigits);
+  for (Int_t i = 0; i < numOfDigits; i++)
+    sorted[i] = static_cast<const Digit*>(digits->UncheckedAt(i));
+  std::sort(sorted.begin(), sorted.end(), [](const Digit* a, const Digit* b) {
+    if (a->getChipIndex() != b->getChipIndex())
+      return a->getChipIndex() < b->getChipIndex();
+    if (a->getRow() != b->getRow())
+      return a->getRow() < b->getRow();
+    return a->getColumn() < b->getColumn();
+  });
+
+  // chip boundaries within the sorted list
+  std::vector<Int_t> chipStart;
+  chipStart.push_back(0);
+  for (Int_t i = 1; i < numOfDigits; i++)
+    if (sorted[i]->getChipIndex() != sorted[i - 1]->getChipIndex())
+      chipStart.push_back(i);
+  chipStart.push_back(numOfDigits);
+  const Int_t numOfChips = chipStart.size() - 1;
+
+  // the chips are independent: each thread clusterizes a contiguous block of
+  // chips into its own buffer and the TClonesArray is filled serially, so the
+  // output stays ordered by chip
+  Int_t numOfThreads = mNumOfThreads < 1 ? 1 : mNumOfThreads;
+  if (numOfThreads > numOfChips)
+    numOfThreads = numOfChips;
+  std::vector<std::vector<Cluster>> buffers(numOfThreads);
+  std::vector<std::future<void>> futures;
+  for (Int_t t = 0; t < numOfThreads; t++) {
+    Int_t firstChip = t * numOfChips / numOfThreads;
+    Int_t lastChip = (t + 1) * numOfChips / numOfThreads;
+    futures.push_back(std::async(std::launch::async, [&, firstChip, lastChip, t]() {
+      for (Int_t chip = firstChip; chip < lastChip; chip++)
+        processChip(seg, sorted.data() + chipStart[chip], chipStart[chip + 1] - chipStart[chip],
+                    buffers[t]);
+    }));
+  }
+  for (auto& f : futures)
+    f.get();
+
+  // batched error parameterization over the per-thread buffers, which keep
+  // the clusters contiguous and grouped by chip
+  if (mErrorTable && mErrorTable->isInitialized())
+    for (auto& buffer : buffers)
+      mErrorTable->apply(buffer.data(), Int_t(buffer.size()));
+
+  TClonesArray& clref = *clusters;
+  for (const auto& buffer : buffers)
+    for (const auto& c : buffer)
+      new (clref[clref.GetEntriesFast()]) Cluster(c);
+}
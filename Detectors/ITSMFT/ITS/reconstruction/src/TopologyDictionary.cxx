@@ -0,0 +1,197 @@
+/// \file TopologyDictionary.cxx
+/// \brief Implementation of the cluster topology dictionary
+#include <algorithm>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ITSReconstruction/TopologyDictionary.h"
+
+using namespace AliceO2::ITS;
+
+namespace {
+const UInt_t kMagic = 0x4454324f; ///< "O2TD", little endian
+const UInt_t kVersion = 1;
+
+/// File header, one page so the table starts page-aligned
+struct FileHeader {
+  UInt_t magic;
+  UInt_t version;
+  ULong64_t tableSize;       ///< number of table slots, power of two
+  ULong64_t numberOfEntries; ///< occupied slots
+  UChar_t reserved[4072];
+};
+static_assert(sizeof(FileHeader) == 4096, "the dictionary header must be one page");
+
+ULong64_t roundUpToPowerOfTwo(ULong64_t n)
+{
+  ULong64_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+}
+
+TopologyDictionary::TopologyDictionary()
+  : mMapping(nullptr), mTable(nullptr), mTableSize(0), mNumberOfEntries(0), mFileDescriptor(-1)
+{
+}
+
+TopologyDictionary::~TopologyDictionary() { close(); }
+
+ULong64_t TopologyDictionary::computeHash(UShort_t rowSpan, UShort_t colSpan, const UChar_t* pattern)
+{
+  // FNV-1a over the spans and the packed bitmap
+  ULong64_t hash = 14695981039346656037ULL;
+  const ULong64_t prime = 1099511628211ULL;
+  UChar_t head[4] = { UChar_t(rowSpan & 0xff), UChar_t(rowSpan >> 8), UChar_t(colSpan & 0xff),
+                      UChar_t(colSpan >> 8) };
+  for (Int_t i = 0; i < 4; i++) {
+    hash ^= head[i];
+    hash *= prime;
+  }
+  Int_t numOfBytes = (rowSpan * colSpan + 7) / 8;
+  for (Int_t i = 0; i < numOfBytes; i++) {
+    hash ^= pattern[i];
+    hash *= prime;
+  }
+  return hash ? hash : 1; // 0 marks an empty table slot
+}
+
+void TopologyDictionary::account(UShort_t rowSpan, UShort_t colSpan, const UChar_t* pattern,
+                                 Float_t dx, Float_t dz)
+{
+  if (rowSpan > kMaxRowSpan || colSpan > kMaxColSpan)
+    return;
+  Accumulator& acc = mAccumulators[computeHash(rowSpan, colSpan, pattern)];
+  acc.count++;
+  acc.sumDx += dx;
+  acc.sumDz += dz;
+  acc.sumDx2 += Double_t(dx) * dx;
+  acc.sumDz2 += Double_t(dz) * dz;
+}
+
+Bool_t TopologyDictionary::write(const char* path, Int_t minCount) const
+{
+  ULong64_t numOfFrequent = 0;
+  for (const auto& acc : mAccumulators)
+    if (acc.second.count >= static_cast<ULong64_t>(minCount))
+      numOfFrequent++;
+
+  // half-full table keeps the probe sequences short
+  ULong64_t tableSize = roundUpToPowerOfTwo(2 * numOfFrequent);
+  if (tableSize < 64)
+    tableSize = 64;
+
+  std::vector<Entry> table(tableSize); // value-initialized, all slots empty
+
+  for (const auto& pair : mAccumulators) {
+    const Accumulator& acc = pair.second;
+    if (acc.count < static_cast<ULong64_t>(minCount))
+      continue;
+    Double_t meanDx = acc.sumDx / acc.count;
+    Double_t meanDz = acc.sumDz / acc.count;
+    ULong64_t slot = pair.first & (tableSize - 1);
+    while (table[slot].hash)
+      slot = (slot + 1) & (tableSize - 1);
+    table[slot].hash = pair.first;
+    table[slot].dx = meanDx;
+    table[slot].dz = meanDz;
+    table[slot].sigmaY2 = acc.sumDx2 / acc.count - meanDx * meanDx;
+    table[slot].sigmaZ2 = acc.sumDz2 / acc.count - meanDz * meanDz;
+  }
+
+  FileHeader header;
+  std::fill(header.reserved, header.reserved + sizeof(header.reserved), 0);
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.tableSize = tableSize;
+  header.numberOfEntries = numOfFrequent;
+
+  Int_t fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return kFALSE;
+  Bool_t ok = ::write(fd, &header, sizeof(header)) == ssize_t(sizeof(header));
+  ok = ok && ::write(fd, table.data(), tableSize * sizeof(Entry)) == ssize_t(tableSize * sizeof(Entry));
+  ::close(fd);
+  return ok;
+}
+
+Bool_t TopologyDictionary::open(const char* path)
+{
+  close();
+
+  Int_t fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return kFALSE;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+    ::close(fd);
+    return kFALSE;
+  }
+
+  void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    ::close(fd);
+    return kFALSE;
+  }
+
+  const FileHeader* header = static_cast<const FileHeader*>(mapping);
+  ULong64_t tableSize = header->tableSize;
+  Bool_t valid = header->magic == kMagic && header->version == kVersion && tableSize != 0 &&
+                 (tableSize & (tableSize - 1)) == 0 &&
+                 st.st_size == static_cast<off_t>(sizeof(FileHeader) + tableSize * sizeof(Entry));
+  if (!valid) {
+    munmap(mapping, st.st_size);
+    ::close(fd);
+    return kFALSE;
+  }
+
+  mMapping = mapping;
+  mTable = reinterpret_cast<const Entry*>(static_cast<const char*>(mapping) + sizeof(FileHeader));
+  mTableSize = tableSize;
+  mNumberOfEntries = header->numberOfEntries;
+  mFileDescriptor = fd;
+  return kTRUE;
+}
+
+void TopologyDictionary::close()
+{
+  if (mMapping) {
+    munmap(const_cast<void*>(mMapping), sizeof(FileHeader) + mTableSize * sizeof(Entry));
+    mMapping = nullptr;
+    mTable = nullptr;
+  }
+  if (mFileDescriptor >= 0) {
+    ::close(mFileDescriptor);
+    mFileDescriptor = -1;
+  }
+  mTableSize = 0;
+  mNumberOfEntries = 0;
+}
+
+Bool_t TopologyDictionary::getCorrection(ULong64_t hash, Float_t& dx, Float_t& dz, Float_t& sigmaY2,
+                                         Float_t& sigmaZ2) const
+{
+  if (!mTable)
+    return kFALSE;
+  ULong64_t slot = hash & (mTableSize - 1);
+  for (ULong64_t probe = 0; probe < mTableSize; probe++) {
+    const Entry& e = mTable[slot];
+    if (e.hash == hash) {
+      dx = e.dx;
+      dz = e.dz;
+      sigmaY2 = e.sigmaY2;
+      sigmaZ2 = e.sigmaZ2;
+      return kTRUE;
+    }
+    if (e.hash == 0)
+      return kFALSE;
+    slot = (slot + 1) & (mTableSize - 1);
+  }
+  return kFALSE;
+}
@@ -1,6 +1,7 @@
 /// \file TrivialClusterer.cxx
 /// \brief Implementation of the ITS cluster finder
 #include "ITSMFTBase/Digit.h"
+#include "ITSMFTBase/FiredChipIndex.h"
 #include "ITSMFTBase/SegmentationPixel.h"
 #include "ITSReconstruction/TrivialClusterer.h"
 #include "ITSReconstruction/Cluster.h"
@@ -8,10 +9,34 @@
 #include "FairLogger.h"   // for LOG
 #include "TClonesArray.h" // for TClonesArray
 
+using AliceO2::ITSMFT::FiredChipIndex;
 using AliceO2::ITSMFT::SegmentationPixel;
 using AliceO2::ITSMFT::Digit;
 using namespace AliceO2::ITS;
 
+namespace {
+/// one cluster per digit, at the center of the pixel
+void makeCluster(const SegmentationPixel* seg, const Digit* dig, Float_t sigma2, TClonesArray& clref)
+{
+  Int_t ix = dig->getRow(), iz = dig->getColumn();
+  Int_t lab = dig->getLabel(0);
+
+  Float_t x = 0., y = 0., z = 0.;
+  seg->detectorToLocal(ix, iz, x, z);
+  Cluster c;
+  c.setVolumeId(dig->getChipIndex());
+  c.setX(x);
+  c.setY(y);
+  c.setZ(z);
+  c.setSigmaY2(sigma2);
+  c.setSigmaZ2(sigma2);
+  c.setFrameLoc();
+  c.setLabel(lab, 0);
+
+  new (clref[clref.GetEntriesFast()]) Cluster(c);
+}
+}
+
 TrivialClusterer::TrivialClusterer() {}
 
 TrivialClusterer::~TrivialClusterer() {}
@@ -23,23 +48,25 @@ TrivialClusterer::process(const SegmentationPixel *seg, const TClonesArray* digi
 
   TClonesArray& clref = *clusters;
   for (TIter digP = TIter(digits).Begin(); digP != TIter::End(); ++digP) {
-    Digit* dig = static_cast<Digit*>(*digP);
-    Int_t ix = dig->getRow(), iz = dig->getColumn();
-    Double_t charge = dig->getCharge();
-    Int_t lab = dig->getLabel(0);
-
-    Float_t x = 0., y = 0., z = 0.;
-    seg->detectorToLocal(ix, iz, x, z);
-    Cluster c;
-    c.setVolumeId(dig->getChipIndex());
-    c.setX(x);
-    c.setY(y);
-    c.setZ(z);
-    c.setSigmaY2(sigma2);
-    c.setSigmaZ2(sigma2);
-    c.setFrameLoc();
-    c.setLabel(lab, 0);
-
-    new (clref[clref.GetEntriesFast()]) Cluster(c);
+    makeCluster(seg, static_cast<Digit*>(*digP), sigma2, clref);
+  }
+}
+
+void
+TrivialClusterer::process(const SegmentationPixel *seg, const TClonesArray* digits,
+                          const FiredChipIndex* index, TClonesArray* clusters)
+{
+  Float_t sigma2 = seg->cellSizeX() * seg->cellSizeX() / 12.;
+
+  // the digits are grouped by chip in the index order, so the accumulated
+  // counts slice the array chip by chip and the quiet chips never show up
+  TClonesArray& clref = *clusters;
+  Int_t offset = 0;
+  for (Int_t c = 0; c < index->getNumberOfChips(); c++) {
+    const Int_t numOfDigits = index->getNumberOfDigits(c);
+    for (Int_t d = 0; d < numOfDigits; d++) {
+      makeCluster(seg, static_cast<Digit*>(digits->UncheckedAt(offset + d)), sigma2, clref);
+    }
+    offset += numOfDigits;
   }
 }
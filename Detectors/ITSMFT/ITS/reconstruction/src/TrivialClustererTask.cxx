@@ -2,6 +2,9 @@
 /// \brief Implementation of the ITS cluster finder task
 
 #include "ITSReconstruction/TrivialClustererTask.h"
+#include "ITSReconstruction/ColumnarRecoIO.h"
+#include "ITSMFTBase/FiredChipIndex.h"
+#include "DetectorsBase/InputPrefetcher.h"
 
 #include "FairLogger.h"      // for LOG
 #include "FairRootManager.h" // for FairRootManager
@@ -13,11 +16,12 @@ using AliceO2::ITSMFT::SegmentationPixel;
 using namespace AliceO2::ITS;
 
 //_____________________________________________________________________
-TrivialClustererTask::TrivialClustererTask() : FairTask("ITSTrivialClustererTask"), mDigitsArray(nullptr), mClustersArray(nullptr) {}
+TrivialClustererTask::TrivialClustererTask() : FairTask("ITSTrivialClustererTask"), mDigitsArray(nullptr), mFiredChips(nullptr), mClustersArray(nullptr), mColumnarWriter(nullptr), mEventCounter(0), mPrefetchEvents(0), mPrefetcher(nullptr) {}
 
 //_____________________________________________________________________
 TrivialClustererTask::~TrivialClustererTask()
 {
+  delete mPrefetcher;
   if (mClustersArray) {
     mClustersArray->Delete();
     delete mClustersArray;
@@ -41,22 +45,46 @@ InitStatus TrivialClustererTask::Init()
     return kERROR;
   }
 
+  // fired-chip index of the digitizer; absent on old inputs, the clustering
+  // then falls back to the plain digit iteration
+  mFiredChips = dynamic_cast<ITSMFT::FiredChipIndex*>(mgr->GetObject("ITSFiredChip"));
+
   // Register output container
   mClustersArray = new TClonesArray("AliceO2::ITS::Cluster");
   mgr->Register("ITSCluster", "ITS", mClustersArray, kTRUE);
 
   mGeometry.Build(kTRUE);
 
+  if (mPrefetchEvents > 0) {
+    mPrefetcher = new Base::InputPrefetcher;
+    if (!mPrefetcher->init(mPrefetchEvents)) {
+      delete mPrefetcher;
+      mPrefetcher = nullptr;
+    }
+  }
+
   return kSUCCESS;
 }
 
 //_____________________________________________________________________
 void TrivialClustererTask::Exec(Option_t* option)
 {
+  if (mPrefetcher) {
+    mPrefetcher->notifyEntry(mEventCounter);
+  }
   mClustersArray->Clear();
   LOG(DEBUG) << "Running digitization on new event" << FairLogger::endl;
 
   const SegmentationPixel* seg = (SegmentationPixel*)mGeometry.getSegmentationById(0);
 
-  mTrivialClusterer.process(seg, mDigitsArray, mClustersArray);
+  if (mFiredChips) {
+    mTrivialClusterer.process(seg, mDigitsArray, mFiredChips, mClustersArray);
+  } else {
+    mTrivialClusterer.process(seg, mDigitsArray, mClustersArray);
+  }
+
+  if (mColumnarWriter) {
+    mColumnarWriter->writeClusters(mEventCounter, *mClustersArray);
+  }
+  mEventCounter++;
 }
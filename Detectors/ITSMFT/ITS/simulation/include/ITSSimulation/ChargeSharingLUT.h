@@ -0,0 +1,92 @@
+/// \file ChargeSharingLUT.h
+/// \brief Precomputed pixel charge-sharing coupling template
+
+#ifndef ALICEO2_ITS_CHARGESHARINGLUT_H
+#define ALICEO2_ITS_CHARGESHARINGLUT_H
+
+#include "Rtypes.h"
+#include <vector>
+
+namespace AliceO2
+{
+  namespace ITS
+  {
+    /// \class ChargeSharingLUT
+    /// \brief Lookup table of the pixel charge-sharing fractions
+    ///
+    /// The fraction of a deposit collected by the 3x3 stencil of pixels
+    /// around the entry pixel is precomputed on a grid of fractional entry
+    /// positions within the pixel: Gaussian diffusion integrated with erf
+    /// over the neighbor cells, like the TPC PadResponseLUT does for the
+    /// pads. Applying the sharing in the digitizer is then one table lookup
+    /// per point and a fixed stencil of multiply-adds instead of per-pixel
+    /// erf evaluations.
+    class ChargeSharingLUT
+    {
+    public:
+      /// Stencil extent in pixels around the entry pixel
+      enum { StencilHalfWidth = 1, StencilSize = 9 };
+
+      ChargeSharingLUT();
+      ~ChargeSharingLUT();
+
+      /// Set the diffusion widths, to be called before init()
+      /// @param sigmaX Gaussian width along the rows (cm)
+      /// @param sigmaZ Gaussian width along the columns (cm)
+      void setSigma(Float_t sigmaX, Float_t sigmaZ)
+      {
+        mSigmaX = sigmaX;
+        mSigmaZ = sigmaZ;
+      }
+
+      /// Set the granularity of the fractional-position grid, to be called before init()
+      /// @param nSubBins Number of sub-bins per pixel in each direction
+      void setNSubBins(Int_t nSubBins) { mNSubBins = nSubBins; }
+
+      /// Precompute the coupling fractions for the pixel pitches
+      /// @param pitchX Pixel pitch along the rows (cm)
+      /// @param pitchZ Pixel pitch along the columns (cm)
+      void init(Float_t pitchX, Float_t pitchZ);
+
+      Bool_t isInitialized() const { return !mFractions.empty(); }
+
+      /// Stencil weights below this value are to be dropped by the caller
+      Float_t getMinWeight() const { return mMinWeight; }
+
+      /// Get the stencil weights for an entry at a fractional pixel position,
+      /// row-major over (dRow, dColumn) in [-1,1]x[-1,1]
+      /// @param fracX Fractional position within the pixel along the row [0,1)
+      /// @param fracZ Fractional position within the pixel along the column [0,1)
+      /// @return The StencilSize coupling fractions
+      const Float_t* getFractions(Float_t fracX, Float_t fracZ) const;
+
+    private:
+      /// Index into the fraction table of the first stencil weight
+      Int_t tableIndex(Int_t subX, Int_t subZ) const { return (subX * mNSubBins + subZ) * StencilSize; }
+
+      Float_t mSigmaX;    /// Gaussian diffusion width along the rows (cm)
+      Float_t mSigmaZ;    /// Gaussian diffusion width along the columns (cm)
+      Int_t mNSubBins;    /// number of sub-bins per pixel in each direction
+      Float_t mMinWeight; /// weights below this value are negligible
+
+      std::vector<Float_t> mFractions; /// coupling fractions, indexed by (subX, subZ, stencil cell)
+    };
+
+    inline const Float_t* ChargeSharingLUT::getFractions(Float_t fracX, Float_t fracZ) const
+    {
+      Int_t subX = static_cast<Int_t>(fracX * mNSubBins);
+      Int_t subZ = static_cast<Int_t>(fracZ * mNSubBins);
+      if (subX < 0)
+        subX = 0;
+      if (subZ < 0)
+        subZ = 0;
+      if (subX > mNSubBins - 1)
+        subX = mNSubBins - 1;
+      if (subZ > mNSubBins - 1)
+        subZ = mNSubBins - 1;
+      return &mFractions[tableIndex(subX, subZ)];
+    }
+  }
+}
+
+#endif /* ALICEO2_ITS_CHARGESHARINGLUT_H */
@@ -5,10 +5,13 @@
 #define ALICEO2_ITS_DETECTOR_H_
 
 #include "DetectorsBase/Detector.h"   // for Detector
+#include "DetectorsBase/PointArena.h" // for PointArena
+#include "ITSMFTSimulation/Point.h"   // for Point
 #include "Rtypes.h"          // for Int_t, Double_t, Float_t, Bool_t, etc
 #include "TArrayD.h"         // for TArrayD
 #include "TGeoManager.h"     // for gGeoManager, TGeoManager (ptr only)
 #include "TLorentzVector.h"  // for TLorentzVector
+#include "TString.h"         // for TString
 #include "TVector3.h"        // for TVector3
 
 class FairModule;
@@ -79,6 +82,13 @@ class Detector : public AliceO2::Base::Detector
     /// Base class to create the detector geometry
     void ConstructGeometry();
 
+    /// Use a serialized geometry snapshot: when the file exists, the closed
+    /// detector subtree is imported from it instead of being rebuilt shape by
+    /// shape; after a first construction the subtree is dumped there
+    void setGeometryCacheFile(const char *fname) { mGeometryCacheFile = fname; }
+
+    const char *getGeometryCacheFile() const { return mGeometryCacheFile.Data(); }
+
     /// Creates the Service Barrel (as a simple cylinder) for IB and OB
     /// \param innerBarrel if true, build IB service barrel, otherwise for OB
     /// \param dest the mother volume holding the service barrel
@@ -166,6 +176,10 @@ class Detector : public AliceO2::Base::Detector
 
     virtual void EndOfEvent();
 
+    /// Copies the points accumulated in the arena into the registered
+    /// container; called before the output tree is filled
+    virtual void FinishEvent();
+
     virtual void FinishPrimary()
     {
       ;
@@ -319,6 +333,10 @@ class Detector : public AliceO2::Base::Detector
     /// Container for data points
     TClonesArray *mPointCollection;
 
+    /// Arena the points are constructed into during the stepping; flushed
+    /// into mPointCollection once per event (see FinishEvent)
+    Base::PointArena<AliceO2::ITSMFT::Point> mPointArena; //!
+
     /// Creates an air-filled wrapper cylindrical volume
     TGeoVolume *createWrapperVolume(const Int_t nLay);
 
@@ -328,6 +346,13 @@ class Detector : public AliceO2::Base::Detector
     /// Construct the detector geometry
     void constructDetectorGeometry();
 
+    /// Import the detector subtree from the geometry snapshot file.
+    /// Returns kFALSE when the snapshot is missing or unusable
+    Bool_t importDetectorGeometry();
+
+    /// Dump the constructed detector subtree to the geometry snapshot file
+    void exportDetectorGeometry();
+
     /// Define the sensitive volumes of the geometry
     void defineSensitiveVolumes();
 
@@ -342,6 +367,8 @@ class Detector : public AliceO2::Base::Detector
     Model mStaveModelInnerBarrel; //! The stave model for the Inner Barrel
     Model mStaveModelOuterBarrel; //! The stave model for the Outer Barrel
 
+    TString mGeometryCacheFile; //! geometry snapshot file, empty if caching is disabled
+
   ClassDef(Detector, 1)
 };
 
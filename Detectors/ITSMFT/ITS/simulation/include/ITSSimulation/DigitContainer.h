@@ -4,9 +4,10 @@
 #ifndef ALICEO2_ITS_DIGITCONTAINER
 #define ALICEO2_ITS_DIGITCONTAINER
 
+#include <memory>
 #include <vector>
 
-#include "ITSSimulation/DigitChip.h"
+#include "ITSMFTBase/Digit.h"
 #include "Rtypes.h"
 
 class TClonesArray;
@@ -15,28 +16,60 @@ namespace AliceO2
 {
   namespace ITSMFT
   {
-    class Digit;
+    class FiredChipIndex;
   }
-}
 
-namespace AliceO2
-{
   namespace ITS
   {
+    /// Flat digit store of the digitizer. A chip that fires grabs a
+    /// fixed-capacity buffer of digit records from a pool; the pool and the
+    /// per-chip buffer chains survive the events, so at the second event no
+    /// allocations are made at all. The fired chips are tracked in an
+    /// activation bitmap plus a compact list, keeping the per-event reset
+    /// proportional to the number of fired chips instead of the number of
+    /// chips.
     class DigitContainer
     {
     public:
       DigitContainer() {}
       ~DigitContainer() {}
       void reset();
-      void resize(Int_t n) { mChips.resize(n); }
+      void resize(Int_t n)
+      {
+        mChipHead.resize(n, -1);
+        mChipActive.resize(n, false);
+      }
       AliceO2::ITSMFT::Digit* addDigit(UShort_t chipid, UShort_t row, UShort_t col, Double_t charge, Double_t timestamp);
       AliceO2::ITSMFT::Digit* getDigit(Int_t chipID, UShort_t row, UShort_t col);
 
-      void fillOutputContainer(TClonesArray* output);
+      /// Copy the digits to the output, grouped by ascending chip; when an
+      /// index is given it records the fired chips with their digit counts
+      void fillOutputContainer(TClonesArray* output,
+                               AliceO2::ITSMFT::FiredChipIndex* index = nullptr);
 
     private:
-      std::vector<DigitChip> mChips; ///< Vector of DigitChips
+      enum { kChipCapacity = 256 }; ///< Digit records per pooled buffer
+
+      /// Fixed-capacity buffer of digit records; chips with more digits
+      /// chain several buffers
+      struct ChipBuffer {
+        AliceO2::ITSMFT::Digit mDigits[kChipCapacity]; ///< Digit records
+        Int_t mNumOfDigits = 0; ///< Number of records in use
+        Int_t mNext = -1;       ///< Next buffer of the same chip, -1 if none
+      };
+
+      Int_t allocateBuffer();
+
+      /// Report the pool footprint to the memory accountant; no-op unless
+      /// accounting is enabled, see MemoryAccountant
+      void accountMemory();
+
+      std::vector<std::unique_ptr<ChipBuffer>> mPool; ///< Buffer pool, reused across events
+      Int_t mPoolUsed = 0;           ///< Number of pool buffers in use
+      Int_t mMemoryScopeId = -1;     ///< Accounting scope, see accountMemory
+      std::vector<Int_t> mChipHead;  ///< First pooled buffer of each chip, -1 if quiet
+      std::vector<bool> mChipActive; ///< Activation bitmap of the chips
+      std::vector<Int_t> mFiredChips;///< Fired chips, in activation order
     };
   }
 }
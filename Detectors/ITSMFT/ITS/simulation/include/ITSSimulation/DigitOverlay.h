@@ -0,0 +1,50 @@
+/// \file DigitOverlay.h
+/// \brief Definition of the ITS DigitOverlay class
+
+#ifndef ALICEO2_ITS_DIGITOVERLAY_H_
+#define ALICEO2_ITS_DIGITOVERLAY_H_
+
+#include <vector>
+
+#include "Rtypes.h"
+
+class TClonesArray;
+
+namespace AliceO2
+{
+  namespace ITSMFT
+  {
+    class Digit;
+  }
+}
+
+namespace AliceO2
+{
+  namespace ITS
+  {
+    /// Overlay engine for digit pile-up: merges the digits of several
+    /// signal/background events into one readout frame. The digits are first
+    /// binned by chip ID into contiguous batches, then the chips are merged
+    /// concurrently (pixels fired by more than one event have their charges
+    /// summed), and the frame is filled chip by chip. This replaces routing
+    /// the embedding through the one-event-at-a-time write-out buffer.
+    class DigitOverlay
+    {
+    public:
+      DigitOverlay(Int_t nThreads = 1) : mNumOfThreads(nThreads) {}
+      ~DigitOverlay() {}
+
+      void setNumberOfThreads(Int_t n) { mNumOfThreads = n; }
+      Int_t getNumberOfThreads() const { return mNumOfThreads; }
+
+      /// Merge the digits of the given events into one readout frame.
+      /// The output is ordered by chip and, within a chip, by (column, row)
+      void overlay(const std::vector<const TClonesArray*>& events, TClonesArray& frame);
+
+    private:
+      Int_t mNumOfThreads; ///< Number of merging threads
+    };
+  }
+}
+
+#endif /* ALICEO2_ITS_DIGITOVERLAY_H_ */
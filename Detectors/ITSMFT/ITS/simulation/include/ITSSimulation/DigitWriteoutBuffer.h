@@ -9,12 +9,18 @@
 #ifndef ALICEO2_ITS_DIGITWRITEOUTBUFFER_H_
 #define ALICEO2_ITS_DIGITWRITEOUTBUFFER_H_
 
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <TString.h>             // for TString
 #include "FairWriteoutBuffer.h"  // for FairWriteoutBuffer
 #include "Rtypes.h"              // for DigitWriteoutBuffer::Class, Bool_t, etc
 #include "ITSMFTBase/Digit.h"            // for Digit
 
+class TClonesArray;
+
 namespace AliceO2 {
 namespace ITS {
 class DigitWriteoutBuffer : public FairWriteoutBuffer
@@ -35,10 +41,46 @@ class DigitWriteoutBuffer : public FairWriteoutBuffer
 
     virtual void EraseDataFromDataMap(FairTimeStamp *data);
 
+    /// Enable the double-buffered writeout: the timed-out digits of a
+    /// closed time window are prepared by a background thread while the
+    /// event loop fills the active window, see WriteOutData
+    void SetDoubleBuffering(Bool_t enable);
+    Bool_t GetDoubleBuffering() const { return fDoubleBuffered; }
+
+    /// Write out the data of the closed time window
+    ///
+    /// In double-buffered mode the timed-out digits are drained into a
+    /// plain vector, handed to the background thread which constructs the
+    /// output objects in a staging array, and the staging array of the
+    /// previous window is absorbed into the branch array by cheap pointer
+    /// moves. The object construction thus overlaps with the simulation
+    /// of the next window; the branch array itself is only touched on the
+    /// calling thread, synchronized at time-window granularity.
+    virtual void WriteOutData(double time);
+
+    virtual void WriteOutAllData();
+
   protected:
+    /// hand the drained window to the background thread
+    void submitClosedWindow();
+    /// wait for the background thread and absorb the staging array
+    void flushPreparedWindow();
+    /// background loop constructing the staged output objects
+    void workerLoop();
+
     std::map<AliceO2::ITSMFT::Digit, double> fData_map;
 
-  ClassDef(DigitWriteoutBuffer, 1);
+    Bool_t fDoubleBuffered;                               ///< double-buffered writeout enabled
+    std::vector<AliceO2::ITSMFT::Digit> fClosedWindow;    //!<! timed-out digits drained from the maps
+    std::vector<AliceO2::ITSMFT::Digit> fPreparingWindow; //!<! window under preparation by the worker
+    TClonesArray *fPreparedDigits;                        //!<! staging array filled by the worker
+    std::thread fWorker;                                  //!<! background preparation thread
+    std::mutex fMutex;                                    //!<! protects the window hand-over
+    std::condition_variable fCondition;                   //!<! hand-over and completion signalling
+    bool fWindowPending;                                  //!<! a window is queued for or under preparation
+    bool fTerminate;                                      //!<! worker shutdown flag
+
+  ClassDef(DigitWriteoutBuffer, 2);
 };
 }
 }
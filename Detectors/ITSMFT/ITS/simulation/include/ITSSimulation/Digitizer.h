@@ -8,9 +8,11 @@
 #include "Rtypes.h"  // for Digitizer::Class, Double_t, ClassDef, etc
 #include "TObject.h" // for TObject
 
+#include "ITSMFTBase/SegmentationPixelFast.h"
 #include "ITSMFTSimulation/Chip.h"
 #include "ITSMFTSimulation/SimulationAlpide.h"
 #include "ITSBase/GeometryTGeo.h"
+#include "ITSSimulation/ChargeSharingLUT.h"
 #include "ITSSimulation/DigitContainer.h"
 
 class TClonesArray;
@@ -33,15 +35,33 @@ namespace AliceO2
       DigitContainer& process(TClonesArray* points);
       void process(TClonesArray* points, TClonesArray* digits);
 
+      /// Enable diffusion-based charge sharing over the pixel stencil,
+      /// to be called before init(); widths in cm
+      void setChargeSharing(Double_t sigmaX, Double_t sigmaZ)
+      {
+        mChargeSharing.setSigma(sigmaX, sigmaZ);
+        mUseChargeSharing = kTRUE;
+      }
+
     private:
       Digitizer(const Digitizer&);
       Digitizer& operator=(const Digitizer&);
 
+      /// Convert the chip batches of points to digits; templated on the
+      /// segmentation type, so a concrete fast segmentation binds the
+      /// per-pixel coordinate math without virtual dispatch
+      template <class SegmentationType>
+      void convertChipBatches(const SegmentationType& seg, TClonesArray* points,
+                              const std::vector<Int_t>& batchStart, const std::vector<Int_t>& batch);
+
       GeometryTGeo mGeometry;                     ///< ITS upgrade geometry
       Int_t mNumOfChips;                          ///< Number of chips
       std::vector<AliceO2::ITSMFT::Chip> mChips;  ///< Array of chips
       std::vector<AliceO2::ITSMFT::SimulationAlpide> mSimulations; ///< Array of chips response simulations
       DigitContainer mDigitContainer;             ///< Internal digit storage
+      AliceO2::ITSMFT::SegmentationPixelFast mSegmentationFast; //!< non-virtual segmentation snapshot
+      ChargeSharingLUT mChargeSharing;            //!< precomputed charge-sharing template
+      Bool_t mUseChargeSharing;                   ///< spread the deposits over the pixel stencil
 
       ClassDef(Digitizer, 2);
     };
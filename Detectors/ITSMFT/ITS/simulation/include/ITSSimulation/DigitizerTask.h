@@ -18,6 +18,10 @@
 class TClonesArray;
 namespace AliceO2
 {
+  namespace ITSMFT
+  {
+    class FiredChipIndex;
+  }
   namespace ITS
   {
     class Digitizer;
@@ -48,6 +52,7 @@ namespace AliceO2
 
       TClonesArray* mPointsArray; ///< Array of MC hits
       TClonesArray* mDigitsArray; ///< Array of digits
+      AliceO2::ITSMFT::FiredChipIndex* mFiredChips; ///< Fired chips of the event with digit counts
 
       ClassDef(DigitizerTask, 1)
     };
@@ -9,6 +9,8 @@
 #include "TObject.h" // for TObject
 #include "TString.h" // for TString
 
+#include <vector> // for the chip lookup table
+
 class TGeoBBox;
 
 class TGeoVolume;
@@ -18,6 +20,8 @@ class TGeoHMatrix;
 namespace AliceO2 {
 namespace ITS {
 
+class GeometryTGeo;
+
 /// Helper class to extract information from the GeoManager which is needed in many other TOF
 /// classes. This helper class should be a single place to hold all these functions.
 class GeometryHandler : public TObject
@@ -67,9 +71,62 @@ class GeometryHandler : public TObject
 
     void localToGlobal(Double_t *local, Double_t *global, Int_t detectorId);
 
+    /// Build the table mapping the sensor volume ids to the per-layer
+    /// constants of the chip indexing, once after the geometry is closed.
+    /// The per-hit resolution then works on copy numbers and integer
+    /// arithmetic only, see resolveChipIndex
+    /// @return number of table entries
+    Int_t buildChipLookupTable(const GeometryTGeo *geom, const Int_t *sensorVolumeIds, Int_t numberOfLayers);
+
+    Bool_t hasChipLookupTable() const { return !mChipTable.empty(); }
+
+    /// Resolve the chip index from the sensor volume id and the copy
+    /// numbers of the stepping levels; plain table lookup plus integer
+    /// arithmetic, equivalent to GeometryTGeo::getChipIndex
+    /// @return chip index, -1 if the volume id is no sensor
+    Int_t resolveChipIndex(Int_t sensorVolumeId, Int_t stave, Int_t halfStave, Int_t module,
+                           Int_t chipInModule) const
+    {
+      if (sensorVolumeId < 0 || sensorVolumeId >= static_cast<Int_t>(mVolumeToEntry.size())) {
+        return -1;
+      }
+      Int_t entry = mVolumeToEntry[sensorVolumeId];
+      if (entry < 0) {
+        return -1;
+      }
+      const ChipLookupEntry &e = mChipTable[entry];
+      Int_t n = e.firstChipIndex + e.chipsPerStave * stave + chipInModule;
+      if (e.chipsPerHalfStave && halfStave > 0) {
+        n += e.chipsPerHalfStave * halfStave;
+      }
+      if (e.chipsPerModule && module > 0) {
+        n += e.chipsPerModule * module;
+      }
+      return n;
+    }
+
+    /// Layer of a sensor volume id, direct lookup
+    /// @return layer number, -1 if the volume id is no sensor
+    Int_t resolveLayer(Int_t sensorVolumeId) const
+    {
+      if (sensorVolumeId < 0 || sensorVolumeId >= static_cast<Int_t>(mVolumeToEntry.size())) {
+        return -1;
+      }
+      return mVolumeToEntry[sensorVolumeId];
+    }
+
     //  Int_t CheckGeometryVersion();
 
   private:
+    /// per-layer constants of the chip indexing, see resolveChipIndex
+    struct ChipLookupEntry
+    {
+        Int_t firstChipIndex;    ///< index of the first chip of the layer
+        Int_t chipsPerStave;     ///< chips per stave of the layer
+        Int_t chipsPerHalfStave; ///< chips per half stave, 0 without half staves
+        Int_t chipsPerModule;    ///< chips per module, 0 without modules
+    };
+
     Bool_t mIsSimulation; //!
 
     Int_t mLastUsedDetectorId; //!
@@ -80,6 +137,9 @@ class GeometryHandler : public TObject
     Double_t mGlobalCentre[3];  //! Global centre of volume
     TGeoHMatrix *mGlobalMatrix; //!
 
+    std::vector<Int_t> mVolumeToEntry;       //! table entry (== layer) per volume id, -1 for non-sensors
+    std::vector<ChipLookupEntry> mChipTable; //! chip indexing constants per layer
+
     TString constructFullPathFromDetectorId(Int_t detectorId);
 
     GeometryHandler(const GeometryHandler &);
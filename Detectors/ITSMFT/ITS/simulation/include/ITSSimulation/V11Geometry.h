@@ -29,10 +29,14 @@ class V11Geometry : public TObject
 
   public:
     V11Geometry() : mDebug()
-    { };
+    {
+      clearTrigCache();
+    };
 
     V11Geometry(Int_t debug) : mDebug(debug)
-    { };
+    {
+      clearTrigCache();
+    };
 
     virtual ~V11Geometry()
     { };
@@ -58,24 +62,50 @@ class V11Geometry : public TObject
     // Static functions
 
     /// Define Trig functions for use with degrees (standerd TGeo angles).
+    /// The values are memoized per instance: building the stave shapes
+    /// evaluates the same few angles thousands of times, a hit costs one
+    /// table probe instead of a libm call and sine and cosine of an angle
+    /// come from the same entry.
     /// Sine function
     Double_t sinD(Double_t deg) const
     {
-      return TMath::Sin(deg * TMath::DegToRad());
+      Double_t sine, cosine;
+      cachedSinCosD(deg, sine, cosine);
+      return sine;
     }
 
     /// Cosine function
     Double_t cosD(Double_t deg) const
     {
-      return TMath::Cos(deg * TMath::DegToRad());
+      Double_t sine, cosine;
+      cachedSinCosD(deg, sine, cosine);
+      return cosine;
     }
 
     /// Tangent function
     Double_t tanD(Double_t deg) const
     {
-      return TMath::Tan(deg * TMath::DegToRad());
+      Double_t sine, cosine;
+      cachedSinCosD(deg, sine, cosine);
+      return sine / cosine;
     }
 
+    /// Tabulates n points of a circular arc in one pass: point i lies at
+    /// angle thetaFirst + i*step (degrees) on the circle of radius r
+    /// centered at (xc,yc) and is written into x[i], y[i]. Sine and cosine
+    /// are evaluated once for the first point and once for the step, the
+    /// remaining points follow from the angle-addition rotation, so the
+    /// cost per vertex is four multiplies instead of two trig calls. Meant
+    /// for filling polygon tables (TGeoXtru, stave placement rings)
+    /// \param Int_t n Number of points
+    /// \param Double_t thetaFirst Angle of the first point (degrees)
+    /// \param Double_t step Angle increment between points (degrees)
+    /// \param Double_t r Radius of the arc
+    /// \param Double_t xc,yc Center of the arc
+    /// \param Double_t *x,*y Output arrays of n coordinates
+    void arcPoints(Int_t n, Double_t thetaFirst, Double_t step, Double_t r, Double_t xc,
+                   Double_t yc, Double_t *x, Double_t *y) const;
+
     /// Determine the intersection of two lines
     /// Given the two lines, one passing by (x0,y0) with slope m and
     /// the other passing by (x1,y1) with slope n, returns the coordinates
@@ -440,7 +470,47 @@ class V11Geometry : public TObject
     /// \param Double_t sdr difference or sum of the circle radii
     Double_t angleForRoundedCorners1(Double_t dx, Double_t dy, Double_t sdr) const;
 
+    /// One entry of the trigonometry memoization table
+    struct TrigCacheEntry {
+      Double_t deg;    ///< the angle of the cached values
+      Double_t sine;   ///< sin of the angle
+      Double_t cosine; ///< cos of the angle
+      Bool_t valid;    ///< entry has been filled
+    };
+
+    static const Int_t sTrigCacheSize = 256; ///< number of cache entries, power of two
+
+    /// Direct-mapped lookup on the bit pattern of the angle; a collision
+    /// simply recomputes and replaces the entry, correctness never depends
+    /// on the cache
+    void cachedSinCosD(Double_t deg, Double_t &sine, Double_t &cosine) const
+    {
+      union {
+        Double_t degrees;
+        ULong64_t bits;
+      } key;
+      key.degrees = deg;
+      TrigCacheEntry &entry = mTrigCache[(key.bits ^ (key.bits >> 17)) & (sTrigCacheSize - 1)];
+      if (!entry.valid || entry.deg != deg) {
+        entry.deg = deg;
+        entry.sine = TMath::Sin(deg * TMath::DegToRad());
+        entry.cosine = TMath::Cos(deg * TMath::DegToRad());
+        entry.valid = kTRUE;
+      }
+      sine = entry.sine;
+      cosine = entry.cosine;
+    }
+
+    /// Marks all cache entries as empty
+    void clearTrigCache()
+    {
+      for (Int_t i = 0; i < sTrigCacheSize; i++) {
+        mTrigCache[i].valid = kFALSE;
+      }
+    }
+
     Int_t mDebug;            //! Debug flag/level
+    mutable TrigCacheEntry mTrigCache[sTrigCacheSize]; //! memoized sin/cos pairs per angle
   ClassDef(V11Geometry, 1) // Base class for ITS v11 geometry
 };
 }
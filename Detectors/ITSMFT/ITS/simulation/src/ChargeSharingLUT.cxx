@@ -0,0 +1,58 @@
+/// \file ChargeSharingLUT.cxx
+/// \brief Implementation of the pixel charge-sharing lookup table
+
+#include "ITSSimulation/ChargeSharingLUT.h"
+
+#include <cmath>
+
+using namespace AliceO2::ITS;
+
+ChargeSharingLUT::ChargeSharingLUT()
+  : mSigmaX(0.f),
+    mSigmaZ(0.f),
+    mNSubBins(10),
+    mMinWeight(1e-4f),
+    mFractions()
+{
+}
+
+ChargeSharingLUT::~ChargeSharingLUT() = default;
+
+void ChargeSharingLUT::init(Float_t pitchX, Float_t pitchZ)
+{
+  mFractions.assign(mNSubBins * mNSubBins * StencilSize, 0.f);
+
+  if (mSigmaX <= 0.f || mSigmaZ <= 0.f) {
+    // no diffusion: the entry pixel collects everything
+    for (size_t i = StencilSize / 2; i < mFractions.size(); i += StencilSize) {
+      mFractions[i] = 1.f;
+    }
+    return;
+  }
+
+  const Double_t normX = 1. / (std::sqrt(2.) * mSigmaX);
+  const Double_t normZ = 1. / (std::sqrt(2.) * mSigmaZ);
+
+  // fraction of a Gaussian centered at the fractional position collected by
+  // the cell at offset d, in units of the pitch
+  auto cellFraction = [](Double_t frac, Int_t d, Double_t pitch, Double_t norm) {
+    const Double_t low = (d - frac) * pitch;
+    const Double_t high = (d + 1. - frac) * pitch;
+    return 0.5 * (std::erf(high * norm) - std::erf(low * norm));
+  };
+
+  for (Int_t subX = 0; subX < mNSubBins; ++subX) {
+    const Double_t fracX = (subX + 0.5) / mNSubBins;
+    for (Int_t subZ = 0; subZ < mNSubBins; ++subZ) {
+      const Double_t fracZ = (subZ + 0.5) / mNSubBins;
+      Float_t* fractions = &mFractions[tableIndex(subX, subZ)];
+      Int_t cell = 0;
+      for (Int_t dx = -StencilHalfWidth; dx <= StencilHalfWidth; ++dx) {
+        const Double_t wx = cellFraction(fracX, dx, pitchX, normX);
+        for (Int_t dz = -StencilHalfWidth; dz <= StencilHalfWidth; ++dz, ++cell) {
+          fractions[cell] = wx * cellFraction(fracZ, dz, pitchZ, normZ);
+        }
+      }
+    }
+  }
+}
@@ -25,6 +25,7 @@
 #include "TGeoTube.h"               // for TGeoTube
 #include "TGeoVolume.h"             // for TGeoVolume, TGeoVolumeAssembly
 #include "TString.h"                // for TString, operator+
+#include "TSystem.h"                // for gSystem
 #include "TVirtualMC.h"             // for gMC, TVirtualMC
 #include "TVirtualMCStack.h"        // for TVirtualMCStack
 
@@ -242,7 +243,8 @@ Detector::Detector(const Detector &rhs)
 
     mGeometry(0),
     mStaveModelInnerBarrel(rhs.mStaveModelInnerBarrel),
-    mStaveModelOuterBarrel(rhs.mStaveModelInnerBarrel)
+    mStaveModelOuterBarrel(rhs.mStaveModelInnerBarrel),
+    mGeometryCacheFile(rhs.mGeometryCacheFile)
 {
   mLayerName = new TString[mNumberLayers];
 
@@ -380,6 +382,11 @@ void Detector::Initialize()
 
   mGeometryTGeo = new GeometryTGeo(kTRUE);
 
+  // the stepping resolves the chip index via the volume-id table
+  if (mGeometryHandler) {
+    mGeometryHandler->buildChipLookupTable(mGeometryTGeo, mLayerID, mNumberLayers);
+  }
+
   FairDetector::Initialize();
 
   //  FairRuntimeDb* rtdb= FairRun::Instance()->GetRuntimeDb();
@@ -420,12 +427,6 @@ Bool_t Detector::ProcessHits(FairVolume *vol)
   // FIXME: Is copy actually needed?
   Int_t copy = vol->getCopyNo();
   Int_t id = vol->getMCid();
-  Int_t lay = 0;
-
-  // FIXME: Determine the layer number. Is this information available directly from the FairVolume?
-  while ((lay < mNumberLayers) && id != mLayerID[lay]) {
-    ++lay;
-  }
 
   // FIXME: Is it needed to keep a track reference when the outer ITS volume is encountered?
   // if(TVirtualMC::GetMC()->IsTrackExiting()) {
@@ -438,7 +439,19 @@ Bool_t Detector::ProcessHits(FairVolume *vol)
   TVirtualMC::GetMC()->CurrentVolOffID(2, module);
   TVirtualMC::GetMC()->CurrentVolOffID(3, halfstave);
   TVirtualMC::GetMC()->CurrentVolOffID(4, stave);
-  int chipindex = mGeometryTGeo->getChipIndex(lay, stave, halfstave, module, chipinmodule);
+
+  int chipindex;
+  if (mGeometryHandler && mGeometryHandler->hasChipLookupTable()) {
+    // volume-id table lookup plus integer arithmetic, no layer search
+    chipindex = mGeometryHandler->resolveChipIndex(id, stave, halfstave, module, chipinmodule);
+  } else {
+    // FIXME: Determine the layer number. Is this information available directly from the FairVolume?
+    Int_t lay = 0;
+    while ((lay < mNumberLayers) && id != mLayerID[lay]) {
+      ++lay;
+    }
+    chipindex = mGeometryTGeo->getChipIndex(lay, stave, halfstave, module, chipinmodule);
+  }
 
   // Record information on the points
   mEnergyLoss = TVirtualMC::GetMC()->Edep();
@@ -626,6 +639,14 @@ void Detector::EndOfEvent()
   if (mPointCollection) { mPointCollection->Clear(); }
 }
 
+void Detector::FinishEvent()
+{
+  // flush the points accumulated during the stepping into the registered
+  // container; called by FairMCApplication before the output tree is filled
+  if (mPointCollection) { mPointArena.fillOutputContainer(mPointCollection); }
+  mPointArena.clear();
+}
+
 void Detector::Register()
 {
   // This will create a branch in the output tree called Point, setting the last
@@ -649,6 +670,7 @@ TClonesArray *Detector::GetCollection(Int_t iColl) const
 void Detector::Reset()
 {
   mPointCollection->Clear();
+  mPointArena.clear();
 }
 
 void Detector::setNumberOfWrapperVolumes(Int_t n)
@@ -846,13 +868,64 @@ void Detector::ConstructGeometry()
   // Create the detector materials
   createMaterials();
 
-  // Construct the detector geometry
-  constructDetectorGeometry();
+  // With a geometry cache configured, try the snapshot before the expensive
+  // shape construction; after a first construction, dump the snapshot
+  if (mGeometryCacheFile.IsNull() || !importDetectorGeometry()) {
+    // Construct the detector geometry
+    constructDetectorGeometry();
+
+    if (!mGeometryCacheFile.IsNull()) {
+      exportDetectorGeometry();
+    }
+  }
 
   // Define the list of sensitive volumes
   defineSensitiveVolumes();
 }
 
+Bool_t Detector::importDetectorGeometry()
+{
+  if (gSystem->AccessPathName(mGeometryCacheFile.Data())) {
+    return kFALSE; // no snapshot yet
+  }
+
+  TGeoVolume *vALIC = gGeoManager->GetVolume("cave");
+
+  if (!vALIC) {
+    LOG(FATAL) << "Could not find the top volume" << FairLogger::endl;
+  }
+
+  TGeoVolume *vITSV = TGeoVolume::Import(mGeometryCacheFile.Data(), GeometryTGeo::getITSVolPattern());
+
+  if (!vITSV) {
+    LOG(WARNING) << "Could not import the detector subtree from "
+                 << mGeometryCacheFile.Data() << ", rebuilding it" << FairLogger::endl;
+    return kFALSE;
+  }
+
+  vITSV->SetUniqueID(GeometryTGeo::getUIDShift()); // store modID -> midUUID bitshift
+  vALIC->AddNode(vITSV, 2, 0); // Copy number is 2 to cheat AliGeoManager::CheckSymNamesLUT
+
+  LOG(INFO) << "Geometry imported from the snapshot " << mGeometryCacheFile.Data()
+            << FairLogger::endl;
+
+  return kTRUE;
+}
+
+void Detector::exportDetectorGeometry()
+{
+  TGeoVolume *vITSV = gGeoManager->GetVolume(GeometryTGeo::getITSVolPattern());
+
+  if (!vITSV) {
+    LOG(WARNING) << "No detector subtree to dump" << FairLogger::endl;
+    return;
+  }
+
+  vITSV->Export(mGeometryCacheFile.Data());
+
+  LOG(INFO) << "Geometry snapshot dumped to " << mGeometryCacheFile.Data() << FairLogger::endl;
+}
+
 void Detector::constructDetectorGeometry()
 {
   // Create the geometry and insert it in the mother volume ITSV
@@ -1054,10 +1127,8 @@ Point *Detector::addHit(Int_t trackID, Int_t detID, TVector3 startPos, TVector3
                         Double_t length, Double_t eLoss, Int_t shunt,
                         Int_t status, Int_t statusStart)
 {
-  TClonesArray &clref = *mPointCollection;
-  Int_t size = clref.GetEntriesFast();
-  return new(clref[size])
-    Point(trackID, detID, startPos, pos, mom, startTime, time, length, eLoss, shunt, status, statusStart);
+  return mPointArena.construct(trackID, detID, startPos, pos, mom, startTime, time, length, eLoss, shunt, status,
+                               statusStart);
 }
 
 TParticle *Detector::GetParticle() const
@@ -3,28 +3,117 @@
 //
 #include "ITSSimulation/DigitContainer.h"
 #include "ITSMFTBase/Digit.h"
+#include "ITSMFTBase/FiredChipIndex.h"
+#include "MemoryArena/MemoryAccountant.h"
+
+#include <algorithm>
 
 #include "FairLogger.h" // for LOG
 
+#include "TClonesArray.h"
+
 using AliceO2::ITSMFT::Digit;
 using namespace AliceO2::ITS;
 
 void DigitContainer::reset()
 {
-  for (Int_t i = 0; i < mChips.size(); i++)
-    mChips[i].reset();
+  // drop the content of the fired chips but keep the pool allocations
+  for (Int_t chip : mFiredChips) {
+    mChipHead[chip] = -1;
+    mChipActive[chip] = false;
+  }
+  mFiredChips.clear();
+  mPoolUsed = 0;
+}
+
+Int_t DigitContainer::allocateBuffer()
+{
+  if (mPoolUsed == (Int_t)mPool.size())
+    mPool.emplace_back(new ChipBuffer);
+  ChipBuffer& buffer = *mPool[mPoolUsed];
+  buffer.mNumOfDigits = 0;
+  buffer.mNext = -1;
+  return mPoolUsed++;
 }
 
-Digit* DigitContainer::getDigit(Int_t chipID, UShort_t row, UShort_t col) { return mChips[chipID].getDigit(row, col); }
+Digit* DigitContainer::getDigit(Int_t chipID, UShort_t row, UShort_t col)
+{
+  for (Int_t i = mChipHead[chipID]; i >= 0; i = mPool[i]->mNext) {
+    ChipBuffer& buffer = *mPool[i];
+    for (Int_t d = 0; d < buffer.mNumOfDigits; d++) {
+      if (buffer.mDigits[d].getRow() == row && buffer.mDigits[d].getColumn() == col)
+        return &buffer.mDigits[d];
+    }
+  }
+  return nullptr;
+}
 
 Digit* DigitContainer::addDigit(UShort_t chipID, UShort_t row, UShort_t col, Double_t charge, Double_t timestamp)
 {
-  return mChips[chipID].addDigit(chipID, row, col, charge, timestamp);
+  Digit* digit = getDigit(chipID, row, col);
+  if (digit) {
+    LOG(DEBUG) << "Adding charge to pixel..." << FairLogger::endl;
+    digit->setCharge(charge + digit->getCharge());
+    digit->SetTimeStamp(timestamp);
+    return digit;
+  }
+
+  if (!mChipActive[chipID]) {
+    mChipActive[chipID] = true;
+    mFiredChips.push_back(chipID);
+    mChipHead[chipID] = allocateBuffer();
+  }
+
+  // append to the last buffer of the chain, chaining a fresh one when full
+  Int_t i = mChipHead[chipID];
+  while (mPool[i]->mNext >= 0)
+    i = mPool[i]->mNext;
+  if (mPool[i]->mNumOfDigits == kChipCapacity) {
+    Int_t next = allocateBuffer();
+    mPool[i]->mNext = next;
+    i = next;
+  }
+  ChipBuffer& buffer = *mPool[i];
+  digit = &buffer.mDigits[buffer.mNumOfDigits++];
+  *digit = Digit(chipID, row, col, charge, timestamp);
+
+  return digit;
 }
 
-void DigitContainer::fillOutputContainer(TClonesArray* output)
+void DigitContainer::fillOutputContainer(TClonesArray* output, AliceO2::ITSMFT::FiredChipIndex* index)
 {
-  for (Int_t i = 0; i < mChips.size(); i++) {
-    mChips[i].fillOutputContainer(output);
+  TClonesArray& clref = *output;
+  if (index)
+    index->clear();
+  std::vector<Int_t> chips(mFiredChips);
+  std::sort(chips.begin(), chips.end());
+  for (Int_t chip : chips) {
+    Int_t numOfDigits = 0;
+    for (Int_t i = mChipHead[chip]; i >= 0; i = mPool[i]->mNext) {
+      ChipBuffer& buffer = *mPool[i];
+      for (Int_t d = 0; d < buffer.mNumOfDigits; d++) {
+        new (clref[clref.GetEntriesFast()]) Digit(buffer.mDigits[d]);
+      }
+      numOfDigits += buffer.mNumOfDigits;
+    }
+    if (index)
+      index->addChip(chip, numOfDigits);
   }
+  accountMemory();
+}
+
+void DigitContainer::accountMemory()
+{
+  if (!AliceO2::Memory::MemoryAccountant::IsEnabled())
+    return;
+  auto& accountant = AliceO2::Memory::MemoryAccountant::Instance();
+  if (mMemoryScopeId < 0)
+    mMemoryScopeId = accountant.RegisterScope("ITS/DigitContainer");
+
+  // the pool dominates; the chip bookkeeping is counted at its capacity
+  size_t bytes = mPool.size() * sizeof(ChipBuffer);
+  bytes += mChipHead.capacity() * sizeof(Int_t);
+  bytes += mChipActive.capacity() / 8;
+  bytes += mFiredChips.capacity() * sizeof(Int_t);
+  accountant.Update(mMemoryScopeId, bytes);
 }
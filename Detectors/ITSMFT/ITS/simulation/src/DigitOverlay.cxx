@@ -0,0 +1,96 @@
+/// \file DigitOverlay.cxx
+/// \brief Implementation of the ITS DigitOverlay class
+
+#include "ITSSimulation/DigitOverlay.h"
+#include "ITSMFTBase/Digit.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+#include "TClonesArray.h"
+
+using AliceO2::ITSMFT::Digit;
+using namespace AliceO2::ITS;
+
+void DigitOverlay::overlay(const std::vector<const TClonesArray*>& events, TClonesArray& frame)
+{
+  // Phase 1: bin the digits of all events by chip ID into contiguous batches
+  // (counting sort), shared input for the merging threads
+  Int_t numOfChips = 0;
+  for (const TClonesArray* event : events) {
+    for (Int_t i = 0; i < event->GetEntriesFast(); i++) {
+      const Digit* digit = static_cast<const Digit*>(event->UncheckedAt(i));
+      if (digit->getChipIndex() >= numOfChips)
+        numOfChips = digit->getChipIndex() + 1;
+    }
+  }
+  std::vector<Int_t> batchStart(numOfChips + 1, 0);
+  for (const TClonesArray* event : events) {
+    for (Int_t i = 0; i < event->GetEntriesFast(); i++) {
+      const Digit* digit = static_cast<const Digit*>(event->UncheckedAt(i));
+      batchStart[digit->getChipIndex() + 1]++;
+    }
+  }
+  for (Int_t c = 0; c < numOfChips; c++)
+    batchStart[c + 1] += batchStart[c];
+  std::vector<const Digit*> batch(batchStart[numOfChips]);
+  std::vector<Int_t> next(batchStart.begin(), batchStart.end() - 1);
+  for (const TClonesArray* event : events) {
+    for (Int_t i = 0; i < event->GetEntriesFast(); i++) {
+      const Digit* digit = static_cast<const Digit*>(event->UncheckedAt(i));
+      batch[next[digit->getChipIndex()]++] = digit;
+    }
+  }
+
+  // Phase 2: merge the chips concurrently. The threads take chips off a
+  // shared chunk counter and write into per-chip output slots, so no locking
+  // is needed and the result is independent of the thread count
+  const Int_t kChipChunkSize = 64;
+  std::vector<std::vector<Digit>> merged(numOfChips);
+  std::atomic<Int_t> nextChunk(0);
+  auto mergeChips = [&]() {
+    while (true) {
+      Int_t first = nextChunk.fetch_add(kChipChunkSize);
+      if (first >= numOfChips)
+        break;
+      Int_t last = std::min(first + kChipChunkSize, numOfChips);
+      for (Int_t chip = first; chip < last; chip++) {
+        Int_t nd = batchStart[chip + 1] - batchStart[chip];
+        if (!nd)
+          continue;
+        // sort the records of the chip by pixel, then sum the charge of
+        // records landing on the same pixel
+        std::vector<const Digit*> records(&batch[batchStart[chip]], &batch[batchStart[chip]] + nd);
+        std::sort(records.begin(), records.end(), [](const Digit* a, const Digit* b) {
+          return (a->getColumn() != b->getColumn()) ? (a->getColumn() < b->getColumn())
+                                                    : (a->getRow() < b->getRow());
+        });
+        std::vector<Digit>& out = merged[chip];
+        out.reserve(nd);
+        for (Int_t i = 0; i < nd; i++) {
+          if (!out.empty() && out.back().getColumn() == records[i]->getColumn() &&
+              out.back().getRow() == records[i]->getRow()) {
+            out.back() += *records[i];
+          } else {
+            out.push_back(*records[i]);
+          }
+        }
+      }
+    }
+  };
+  std::vector<std::future<void>> futures(mNumOfThreads);
+  for (Int_t t = 0; t < mNumOfThreads; t++)
+    futures[t] = std::async(std::launch::async, mergeChips);
+  for (Int_t t = 0; t < mNumOfThreads; t++)
+    futures[t].wait();
+
+  // Phase 3: fill the frame chip by chip (TClonesArray filling is not
+  // thread safe)
+  TClonesArray& clref = frame;
+  for (Int_t chip = 0; chip < numOfChips; chip++) {
+    for (const Digit& digit : merged[chip]) {
+      new (clref[clref.GetEntriesFast()]) Digit(digit);
+    }
+  }
+}
@@ -19,25 +19,50 @@ using namespace AliceO2::ITS;
 
 DigitWriteoutBuffer::DigitWriteoutBuffer() :
   FairWriteoutBuffer(),
-  fData_map()
+  fData_map(),
+  fDoubleBuffered(kFALSE),
+  fClosedWindow(),
+  fPreparingWindow(),
+  fPreparedDigits(nullptr),
+  fWorker(),
+  fMutex(),
+  fCondition(),
+  fWindowPending(false),
+  fTerminate(false)
 {
 
 }
 
 DigitWriteoutBuffer::DigitWriteoutBuffer(TString branchname, TString foldername, Bool_t persistance) :
   FairWriteoutBuffer(branchname, "AliceO2::ITSMFT::Digit", foldername, persistance),
-  fData_map()
+  fData_map(),
+  fDoubleBuffered(kFALSE),
+  fClosedWindow(),
+  fPreparingWindow(),
+  fPreparedDigits(nullptr),
+  fWorker(),
+  fMutex(),
+  fCondition(),
+  fWindowPending(false),
+  fTerminate(false)
 {
 
 }
 
 DigitWriteoutBuffer::~DigitWriteoutBuffer()
 {
-
+  SetDoubleBuffering(kFALSE);
+  delete fPreparedDigits;
 }
 
 void DigitWriteoutBuffer::AddNewDataToTClonesArray(FairTimeStamp *timestamp)
 {
+  if (fDoubleBuffered) {
+    // the timed-out digit goes to the closed window, the output objects
+    // are constructed later by the background thread
+    fClosedWindow.push_back(*(static_cast<Digit *>(timestamp)));
+    return;
+  }
   FairRootManager *iohandler = FairRootManager::Instance();
   TClonesArray *outputarray = iohandler->GetTClonesArray(fBranchName);
 
@@ -67,3 +92,107 @@ void DigitWriteoutBuffer::EraseDataFromDataMap(FairTimeStamp *data)
     fData_map.erase(itsdigit);
   }
 }
+
+void DigitWriteoutBuffer::SetDoubleBuffering(Bool_t enable)
+{
+  if (enable == fDoubleBuffered) {
+    return;
+  }
+  if (enable) {
+    if (!fPreparedDigits) {
+      fPreparedDigits = new TClonesArray("AliceO2::ITSMFT::Digit");
+    }
+    fTerminate = false;
+    fWorker = std::thread(&DigitWriteoutBuffer::workerLoop, this);
+    fDoubleBuffered = kTRUE;
+  } else {
+    // write whatever is still staged before the worker goes away
+    if (fWorker.joinable()) {
+      flushPreparedWindow();
+      {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fTerminate = true;
+      }
+      fCondition.notify_all();
+      fWorker.join();
+    }
+    fDoubleBuffered = kFALSE;
+  }
+}
+
+void DigitWriteoutBuffer::WriteOutData(double time)
+{
+  if (!fDoubleBuffered) {
+    FairWriteoutBuffer::WriteOutData(time);
+    return;
+  }
+  // previous window into the branch array, cheap pointer moves
+  flushPreparedWindow();
+  // drain the timed-out digits of this window into the closed window,
+  // via the AddNewDataToTClonesArray hook of the base class
+  FairWriteoutBuffer::WriteOutData(time);
+  submitClosedWindow();
+}
+
+void DigitWriteoutBuffer::WriteOutAllData()
+{
+  if (!fDoubleBuffered) {
+    FairWriteoutBuffer::WriteOutAllData();
+    return;
+  }
+  // end of run, nothing left to overlap with
+  flushPreparedWindow();
+  FairWriteoutBuffer::WriteOutAllData();
+  submitClosedWindow();
+  flushPreparedWindow();
+}
+
+void DigitWriteoutBuffer::submitClosedWindow()
+{
+  if (fClosedWindow.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fClosedWindow.swap(fPreparingWindow);
+    fWindowPending = true;
+  }
+  fCondition.notify_all();
+}
+
+void DigitWriteoutBuffer::flushPreparedWindow()
+{
+  {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fCondition.wait(lock, [this] { return !fWindowPending; });
+  }
+  // the worker is idle here, the staging array is safe to access
+  if (fPreparedDigits && fPreparedDigits->GetEntriesFast() > 0) {
+    FairRootManager *iohandler = FairRootManager::Instance();
+    TClonesArray *outputarray = iohandler->GetTClonesArray(fBranchName);
+    outputarray->AbsorbObjects(fPreparedDigits);
+    fPreparedDigits->Clear();
+  }
+}
+
+void DigitWriteoutBuffer::workerLoop()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  for (;;) {
+    fCondition.wait(lock, [this] { return fWindowPending || fTerminate; });
+    if (!fWindowPending) {
+      break;
+    }
+    std::vector<Digit> window;
+    window.swap(fPreparingWindow);
+    // the object construction runs outside the lock, the main thread
+    // synchronizes on fWindowPending
+    lock.unlock();
+    for (const auto &digit : window) {
+      new ((*fPreparedDigits)[fPreparedDigits->GetEntriesFast()]) Digit(digit);
+    }
+    lock.lock();
+    fWindowPending = false;
+    fCondition.notify_all();
+  }
+}
@@ -4,7 +4,6 @@
 #include "ITSMFTBase/Digit.h"
 #include "ITSMFTBase/SegmentationPixel.h"
 #include "ITSMFTSimulation/Point.h"
-#include "ITSSimulation/DigitChip.h"
 #include "ITSSimulation/Digitizer.h"
 
 #include "FairLogger.h"   // for LOG
@@ -20,7 +19,10 @@ using AliceO2::ITSMFT::SegmentationPixel;
 
 using namespace AliceO2::ITS;
 
-Digitizer::Digitizer() : mGeometry(), mNumOfChips(0), mChips(), mSimulations(), mDigitContainer() {}
+Digitizer::Digitizer()
+  : mGeometry(), mNumOfChips(0), mChips(), mSimulations(), mDigitContainer(), mChargeSharing(), mUseChargeSharing(kFALSE)
+{
+}
 
 Digitizer::~Digitizer() {}
 
@@ -34,7 +36,11 @@ void Digitizer::init(Bool_t build)
   mDigitContainer.resize(mNumOfChips);
 
   SegmentationPixel* seg = (SegmentationPixel*)mGeometry.getSegmentationById(0);
-  DigitChip::setNumberOfRows(seg->getNumberOfRows());
+  mSegmentationFast = AliceO2::ITSMFT::SegmentationPixelFast(*seg);
+
+  if (mUseChargeSharing) {
+    mChargeSharing.init(mSegmentationFast.cellSizeX(), mSegmentationFast.cellSizeZ(1));
+  }
 
   Double_t param[] = {
     50,     // ALPIDE threshold
@@ -64,38 +70,94 @@ void Digitizer::process(TClonesArray* points, TClonesArray* digits)
   }
 }
 
+template <class SegmentationType>
+void Digitizer::convertChipBatches(const SegmentationType& seg, TClonesArray* points,
+                                   const std::vector<Int_t>& batchStart, const std::vector<Int_t>& batch)
+{
+  for (Int_t chipID = 0; chipID < mNumOfChips; chipID++) {
+    for (Int_t b = batchStart[chipID]; b < batchStart[chipID + 1]; b++) {
+      Point* point = static_cast<Point*>(points->UncheckedAt(batch[b]));
+
+      LOG(DEBUG) << "Processing next point: " << FairLogger::endl;
+      LOG(DEBUG) << "=======================" << FairLogger::endl;
+      LOG(DEBUG) << *point << FairLogger::endl;
+
+      Double_t x = 0.5 * (point->GetX() + point->GetStartX());
+      Double_t y = 0.5 * (point->GetY() + point->GetStartY());
+      Double_t z = 0.5 * (point->GetZ() + point->GetStartZ());
+      Double_t charge = point->GetEnergyLoss();
+      Int_t label = point->GetTrackID();
+
+      LOG(DEBUG) << "Creating new digit" << FairLogger::endl;
+      const Double_t glo[3] = { x, y, z };
+      Double_t loc[3] = { 0., 0., 0. };
+      mGeometry.globalToLocal(chipID, glo, loc);
+      Int_t ix, iz;
+      seg.localToDetector(loc[0], loc[2], ix, iz);
+      if ((ix < 0) || (iz < 0)) {
+        LOG(DEBUG) << "Out of the chip" << FairLogger::endl;
+        continue;
+      }
+
+      if (mUseChargeSharing) {
+        // spread the deposit over the pixel stencil via the precomputed template
+        Float_t xCenter, zCenter;
+        seg.detectorToLocal(ix, iz, xCenter, zCenter);
+        const Float_t fracX = 0.5f + (loc[0] - xCenter) / seg.cellSizeX();
+        const Float_t fracZ = 0.5f + (loc[2] - zCenter) / seg.cellSizeZ(iz);
+        const Float_t* w = mChargeSharing.getFractions(fracX, fracZ);
+        const Float_t minWeight = mChargeSharing.getMinWeight();
+        Int_t cell = 0;
+        for (Int_t dx = -ChargeSharingLUT::StencilHalfWidth; dx <= ChargeSharingLUT::StencilHalfWidth; dx++) {
+          for (Int_t dz = -ChargeSharingLUT::StencilHalfWidth; dz <= ChargeSharingLUT::StencilHalfWidth; dz++, cell++) {
+            if (w[cell] < minWeight)
+              continue;
+            const Int_t row = ix + dx, col = iz + dz;
+            if (row < 0 || row >= seg.getNumberOfRows() || col < 0 || col >= seg.getNumberOfColumns())
+              continue;
+            Digit* digit = mDigitContainer.addDigit(chipID, row, col, charge * w[cell], point->GetTime());
+            digit->setLabel(0, label);
+          }
+        }
+        continue;
+      }
+
+      Digit* digit = mDigitContainer.addDigit(chipID, ix, iz, charge, point->GetTime());
+      digit->setLabel(0, label);
+    }
+  }
+}
+
 DigitContainer& Digitizer::process(TClonesArray* points)
 {
   mDigitContainer.reset();
 
-  // Convert points to digits
-  for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter) {
-    Point* point = dynamic_cast<Point*>(*pointiter);
-
-    LOG(DEBUG) << "Processing next point: " << FairLogger::endl;
-    LOG(DEBUG) << "=======================" << FairLogger::endl;
-    LOG(DEBUG) << *point << FairLogger::endl;
-
-    Double_t x = 0.5 * (point->GetX() + point->GetStartX());
-    Double_t y = 0.5 * (point->GetY() + point->GetStartY());
-    Double_t z = 0.5 * (point->GetZ() + point->GetStartZ());
-    Double_t charge = point->GetEnergyLoss();
-    Int_t label = point->GetTrackID();
+  // Phase 1: bin the points of the event by chip ID into contiguous batches
+  // (counting sort), so that phase 2 works chip by chip on cache-resident
+  // data and can later be distributed over chip-level workers
+  Int_t numOfPoints = points->GetEntriesFast();
+  std::vector<Int_t> batchStart(mNumOfChips + 1, 0);
+  for (Int_t i = 0; i < numOfPoints; i++) {
+    Point* point = static_cast<Point*>(points->UncheckedAt(i));
     Int_t chipID = point->GetDetectorID();
-
-    LOG(DEBUG) << "Creating new digit" << FairLogger::endl;
-    const Double_t glo[3] = { x, y, z };
-    Double_t loc[3] = { 0., 0., 0. };
-    mGeometry.globalToLocal(chipID, glo, loc);
-    const SegmentationPixel* seg = (SegmentationPixel*)mGeometry.getSegmentationById(0);
-    Int_t ix, iz;
-    seg->localToDetector(loc[0], loc[2], ix, iz);
-    if ((ix < 0) || (iz < 0)) {
-      LOG(DEBUG) << "Out of the chip" << FairLogger::endl;
+    if (chipID >= mNumOfChips)
       continue;
-    }
-    Digit* digit = mDigitContainer.addDigit(chipID, ix, iz, charge, point->GetTime());
-    digit->setLabel(0, label);
+    batchStart[chipID + 1]++;
   }
+  for (Int_t c = 0; c < mNumOfChips; c++)
+    batchStart[c + 1] += batchStart[c];
+  std::vector<Int_t> batch(batchStart[mNumOfChips]);
+  std::vector<Int_t> next(batchStart.begin(), batchStart.end() - 1);
+  for (Int_t i = 0; i < numOfPoints; i++) {
+    Point* point = static_cast<Point*>(points->UncheckedAt(i));
+    Int_t chipID = point->GetDetectorID();
+    if (chipID >= mNumOfChips)
+      continue;
+    batch[next[chipID]++] = i;
+  }
+
+  // Phase 2: convert the points chip by chip through the fast segmentation
+  convertChipBatches(mSegmentationFast, points, batchStart, batch);
+
   return mDigitContainer;
 }
@@ -8,6 +8,7 @@
 
 #include "ITSSimulation/DigitizerTask.h"
 #include "ITSSimulation/DigitContainer.h"
+#include "ITSMFTBase/FiredChipIndex.h"
 
 #include "FairLogger.h"      // for LOG
 #include "FairRootManager.h" // for FairRootManager
@@ -19,7 +20,8 @@ ClassImp(AliceO2::ITS::DigitizerTask)
   using namespace AliceO2::ITS;
 
 DigitizerTask::DigitizerTask(Bool_t useAlpide)
-  : FairTask("ITSDigitizerTask"), mUseAlpideSim(useAlpide), mDigitizer(), mPointsArray(nullptr), mDigitsArray(nullptr)
+  : FairTask("ITSDigitizerTask"), mUseAlpideSim(useAlpide), mDigitizer(), mPointsArray(nullptr), mDigitsArray(nullptr),
+    mFiredChips(nullptr)
 {
 }
 
@@ -29,6 +31,7 @@ DigitizerTask::~DigitizerTask()
     mDigitsArray->Delete();
     delete mDigitsArray;
   }
+  delete mFiredChips;
 }
 
 /// \brief Init function
@@ -52,6 +55,11 @@ InitStatus DigitizerTask::Init()
   mDigitsArray = new TClonesArray("AliceO2::ITSMFT::Digit");
   mgr->Register("ITSDigit", "ITS", mDigitsArray, kTRUE);
 
+  // fired-chip index of the event, lets the consumers iterate only the
+  // occupied chips of the digit array
+  mFiredChips = new AliceO2::ITSMFT::FiredChipIndex;
+  mgr->Register("ITSFiredChip", "ITS", mFiredChips, kTRUE);
+
   mDigitizer.init(kTRUE);
 
   return kSUCCESS;
@@ -63,8 +71,9 @@ void DigitizerTask::Exec(Option_t* option)
   LOG(DEBUG) << "Running digitization on new event" << FairLogger::endl;
   if (!mUseAlpideSim) {
     DigitContainer& digits = mDigitizer.process(mPointsArray);
-    digits.fillOutputContainer(mDigitsArray);
+    digits.fillOutputContainer(mDigitsArray, mFiredChips);
   } else {
     mDigitizer.process(mPointsArray, mDigitsArray); // ALPIDE response
+    mFiredChips->buildFrom(mDigitsArray); // the chip simulations emit chip by chip
   }
 }
@@ -4,6 +4,8 @@
 
 #include "ITSSimulation/GeometryHandler.h"
 
+#include "ITSBase/GeometryTGeo.h" // for the chip indexing constants
+
 #include "FairLogger.h" // for FairLogger, etc
 
 #include "TGeoBBox.h"    // for TGeoBBox
@@ -33,10 +35,41 @@ GeometryHandler::GeometryHandler()
     mCurrentVolume(NULL),
     mVolumeShape(NULL),
     mGlobalCentre(),
-    mGlobalMatrix(NULL)
+    mGlobalMatrix(NULL),
+    mVolumeToEntry(),
+    mChipTable()
 {
 }
 
+Int_t GeometryHandler::buildChipLookupTable(const GeometryTGeo *geom, const Int_t *sensorVolumeIds,
+                                            Int_t numberOfLayers)
+{
+  mVolumeToEntry.clear();
+  mChipTable.clear();
+  if (!geom || !sensorVolumeIds || numberOfLayers < 1) {
+    return 0;
+  }
+
+  Int_t maxVolumeId = 0;
+  for (Int_t lay = 0; lay < numberOfLayers; lay++) {
+    if (sensorVolumeIds[lay] > maxVolumeId) {
+      maxVolumeId = sensorVolumeIds[lay];
+    }
+  }
+  mVolumeToEntry.assign(maxVolumeId + 1, -1);
+  mChipTable.resize(numberOfLayers);
+
+  for (Int_t lay = 0; lay < numberOfLayers; lay++) {
+    mVolumeToEntry[sensorVolumeIds[lay]] = lay;
+    ChipLookupEntry &e = mChipTable[lay];
+    e.firstChipIndex = geom->getFirstChipIndex(lay);
+    e.chipsPerStave = geom->getNumberOfChipsPerStave(lay);
+    e.chipsPerHalfStave = geom->getNumberOfHalfStaves(lay) ? geom->getNumberOfChipsPerHalfStave(lay) : 0;
+    e.chipsPerModule = geom->getNumberOfModules(lay) ? geom->getNumberOfChipsPerModule(lay) : 0;
+  }
+  return mChipTable.size();
+}
+
 Int_t GeometryHandler::Init(Bool_t isSimulation)
 {
   //  Int_t geoVersion = CheckGeometryVersion();
@@ -8,7 +8,6 @@
 #pragma link C++ class AliceO2::ITS::V1Layer+;
 #pragma link C++ class AliceO2::ITS::Detector+;
 #pragma link C++ class AliceO2::ITS::GeometryHandler+;
-#pragma link C++ class AliceO2::ITS::DigitChip+;
 #pragma link C++ class AliceO2::ITS::DigitWriteoutBuffer+;
 #pragma link C++ class AliceO2::ITS::Digitizer+;
 #pragma link C++ class AliceO2::ITS::DigitizerTask+;
@@ -228,6 +228,29 @@ void V11Geometry::radiusOfCurvature(Double_t rc, Double_t theta0, Double_t z0, D
   return;
 }
 
+void V11Geometry::arcPoints(Int_t n, Double_t thetaFirst, Double_t step, Double_t r, Double_t xc,
+                            Double_t yc, Double_t *x, Double_t *y) const
+{
+  if (n < 1) {
+    return;
+  }
+  // one trig evaluation for the first point and one for the step, the
+  // remaining points follow from the angle-addition rotation
+  Double_t cosPoint = TMath::Cos(thetaFirst * TMath::DegToRad());
+  Double_t sinPoint = TMath::Sin(thetaFirst * TMath::DegToRad());
+  const Double_t cosStep = TMath::Cos(step * TMath::DegToRad());
+  const Double_t sinStep = TMath::Sin(step * TMath::DegToRad());
+
+  for (Int_t i = 0; i < n; i++) {
+    x[i] = r * cosPoint + xc;
+    y[i] = r * sinPoint + yc;
+    Double_t rotated = cosPoint * cosStep - sinPoint * sinStep;
+    sinPoint = sinPoint * cosStep + cosPoint * sinStep;
+    cosPoint = rotated;
+  }
+  return;
+}
+
 void V11Geometry::insidePoint(const TGeoPcon *p, Int_t i1, Int_t i2, Int_t i3, Double_t c,
                               TGeoPcon *q, Int_t j1, Bool_t max) const
 {
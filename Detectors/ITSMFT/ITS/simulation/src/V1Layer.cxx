@@ -22,6 +22,7 @@
 #include <TMath.h>                // for Sin, RadToDeg, DegToRad, Cos, Tan, etc
 
 #include <stdio.h>                // for snprintf
+#include <vector>                 // for the stave position tables
 
 class TGeoMedium;
 
@@ -293,10 +294,13 @@ void V1Layer::createLayer(TGeoVolume *motherVolume)
   // Now build up the layer
   alpha = 360. / mNumberOfStaves;
   Double_t r = mLayerRadius + ((TGeoBBox *) stavVol->GetShape())->GetDY();
+  // stave positions tabulated in one batch pass (see V11Geometry::arcPoints)
+  std::vector<Double_t> xStave(mNumberOfStaves), yStave(mNumberOfStaves);
+  arcPoints(mNumberOfStaves, mPhi0, alpha, r, 0., 0., xStave.data(), yStave.data());
   for (Int_t j = 0; j < mNumberOfStaves; j++) {
     Double_t phi = j * alpha + mPhi0;
-    xpos = r * cosD(phi); // r*sinD(-phi);
-    ypos = r * sinD(phi); // r*cosD(-phi);
+    xpos = xStave[j]; // r*sinD(-phi);
+    ypos = yStave[j]; // r*cosD(-phi);
     zpos = 0.;
     phi += 90;
     layerVolume->AddNode(stavVol, j,
@@ -336,10 +340,13 @@ void V1Layer::createLayerTurbo(TGeoVolume *motherVolume)
   // Now build up the layer
   alpha = 360. / mNumberOfStaves;
   Double_t r = mLayerRadius /* +chip thick ?! */;
+  // stave positions tabulated in one batch pass (see V11Geometry::arcPoints)
+  std::vector<Double_t> xStave(mNumberOfStaves), yStave(mNumberOfStaves);
+  arcPoints(mNumberOfStaves, mPhi0, alpha, r, 0., 0., xStave.data(), yStave.data());
   for (Int_t j = 0; j < mNumberOfStaves; j++) {
     Double_t phi = j * alpha + mPhi0;
-    xpos = r * cosD(phi); // r*sinD(-phi);
-    ypos = r * sinD(phi); // r*cosD(-phi);
+    xpos = xStave[j]; // r*sinD(-phi);
+    ypos = yStave[j]; // r*cosD(-phi);
     zpos = 0.;
     phi += 90;
     layerVolume->AddNode(
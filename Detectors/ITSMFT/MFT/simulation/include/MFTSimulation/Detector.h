@@ -68,6 +68,10 @@ public:
     else fDensitySupportOverSi = 1e-6; 
   }
 
+  /// Set the detail level of the passive volumes (see Geometry::DetailLevels);
+  /// must be called before the geometry is constructed
+  void SetGeometryDetailLevel(Int_t level);
+
   /// Constructing the geometry
 
   void ConstructGeometry();  // inherited from FairModule
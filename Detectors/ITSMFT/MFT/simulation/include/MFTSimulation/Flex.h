@@ -21,6 +21,7 @@ public:
   Flex(LadderSegmentation *ladder);
   virtual ~Flex();
   TGeoVolumeAssembly*  MakeFlex(Int_t nbsensors, Double_t length);
+  TGeoVolumeAssembly*  MakeFlexAveraged(Int_t nbsensors, Double_t length);
   void Make_ElectricComponents(TGeoVolumeAssembly*  flex, Int_t nbsensors, Double_t length, Double_t zvarnish);
 
 private:
@@ -25,7 +25,15 @@ class Geometry : public TNamed {
   void Build();
   
   enum ObjectTypes {kHalfType, kHalfDiskType, kPlaneType, kLadderType, kSensorType};
-  
+
+  enum DetailLevels {kDetailFull, kDetailAveraged, kDetailMinimal};
+
+  /// \brief Returns the detail level used when building the passive volumes
+  Int_t GetDetailLevel() const {return fDetailLevel;};
+  /// \brief Set the detail level of the passive volumes (see DetailLevels);
+  /// must be called before Build()
+  void SetDetailLevel(Int_t level) {fDetailLevel = level;};
+
   //virtual void GetGlobal(const RecPoint * p, TVector3 & pos, TMatrixF & mat) const {};
   //virtual void GetGlobal(const RecPoint * p, TVector3 & pos) const {};
   //virtual Bool_t Impact(const TParticle * particle) const {return kFALSE;};
@@ -64,6 +72,7 @@ private:
   GeometryBuilder* fBuilder;      ///< \brief Geometry Builder
   Segmentation*    fSegmentation; ///< \brief Segmentation of the detector
   Int_t fSensorVolumeID; ///< \brief ID of the volume describing the CMOS Sensor
+  Int_t fDetailLevel;    ///< \brief Detail level of the passive volumes (see DetailLevels)
 
   /// \cond CLASSIMP
   ClassDef(Geometry, 1)
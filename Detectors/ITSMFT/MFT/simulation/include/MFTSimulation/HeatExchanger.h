@@ -32,6 +32,8 @@ class HeatExchanger : public TNamed {
   void CreateHalfDisk3(Int_t half);
   void CreateHalfDisk4(Int_t half);
 
+  void CreateAveraged(Int_t half, Int_t disk);
+
   Double_t GetWaterRadius() { return fRWater; }
   void SetWaterRadius(Double_t &Rwater) { fRWater = Rwater; }
 
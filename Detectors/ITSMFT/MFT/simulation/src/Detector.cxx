@@ -417,6 +417,14 @@ void Detector::CreateMaterials()
 
 }
 
+//_____________________________________________________________________________
+void Detector::SetGeometryDetailLevel(Int_t level)
+{
+
+  Geometry::Instance()->SetDetailLevel(level);
+
+}
+
 //_____________________________________________________________________________
 void Detector::CreateGeometry()
 {
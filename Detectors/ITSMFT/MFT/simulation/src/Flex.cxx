@@ -104,6 +104,59 @@ TGeoVolumeAssembly* Flex::MakeFlex(Int_t nbsensors, Double_t length)
   return flex;
 }
 
+//_____________________________________________________________________________
+TGeoVolumeAssembly* Flex::MakeFlexAveraged(Int_t nbsensors, Double_t length)
+{
+  // Averaged-material version of MakeFlex: the five layers of the FPC are kept
+  // as plain full boxes at their nominal z, without the routing lines, the
+  // positioning holes and the electric components. Used at reduced geometry
+  // detail (see Geometry::SetDetailLevel), keeps the envelope of the detailed
+  // flex so the ladder and sensor placement is unchanged
+
+  // For the naming
+  Geometry * mftGeom = Geometry::Instance();
+  Int_t idHalfMFT = mftGeom->GetHalfID(fLadderSeg->GetUniqueID());
+  Int_t idHalfDisk = mftGeom->GetHalfDiskID(fLadderSeg->GetUniqueID());
+  Int_t idLadder = mftGeom->GetLadderID(fLadderSeg->GetUniqueID());
+
+  TGeoMedium *kMedAlu = gGeoManager->GetMedium("MFT_Alu$");
+  TGeoMedium *kMedKapton = gGeoManager->GetMedium("MFT_Kapton$");
+  TGeoMedium *kMedVarnish = gGeoManager->GetMedium("MFT_Epoxy$");  // we assume that varnish = epoxy ...
+
+  TGeoVolumeAssembly*  flex  = new TGeoVolumeAssembly(Form("flex_%d_%d_%d",idHalfMFT,idHalfDisk,idLadder));
+
+  TGeoVolume* lines = gGeoManager->MakeBox(Form("lineslayer_%d_%d_%d",idHalfMFT,idHalfDisk,idLadder), kMedAlu,
+					   (length-Constants::kClearance)/2, (Constants::kFlexHeight-Constants::kClearance)/2, Constants::kAluThickness/2);
+  lines->SetLineColor(kBlue);
+  TGeoVolume* agnd_dgnd = gGeoManager->MakeBox(Form("alulayer_%d_%d_%d",idHalfMFT,idHalfDisk,idLadder), kMedAlu,
+					       (length-Constants::kClearance)/2, (Constants::kFlexHeight-Constants::kClearance)/2, Constants::kAluThickness/2);
+  agnd_dgnd->SetLineColor(kBlue);
+  TGeoVolume* kaptonlayer = gGeoManager->MakeBox(Form("kaptonlayer_%d_%d_%d",idHalfMFT,idHalfDisk,idLadder), kMedKapton,
+						 length/2, Constants::kFlexHeight/2, Constants::kKaptonThickness/2);
+  kaptonlayer->SetLineColor(kYellow);
+  TGeoVolume* varnishlayerIn = gGeoManager->MakeBox(Form("varnishlayer_%d_%d_%d_0",idHalfMFT,idHalfDisk,idLadder), kMedVarnish,
+						    length/2, Constants::kFlexHeight/2, Constants::kVarnishThickness/2);
+  varnishlayerIn->SetLineColor(kGreen-1);
+  TGeoVolume* varnishlayerOut = gGeoManager->MakeBox(Form("varnishlayer_%d_%d_%d_1",idHalfMFT,idHalfDisk,idLadder), kMedVarnish,
+						     length/2, Constants::kFlexHeight/2, Constants::kVarnishThickness/2);
+  varnishlayerOut->SetLineColor(kGreen-1);
+
+  // same z stack as the detailed flex
+  Double_t zvarnishIn = Constants::kKaptonThickness/2+Constants::kAluThickness+Constants::kVarnishThickness/2-Constants::kGlueThickness;
+  Double_t zgnd = Constants::kKaptonThickness/2+Constants::kAluThickness/2-Constants::kGlueThickness;
+  Double_t zkaptonlayer = -Constants::kGlueThickness;
+  Double_t zlines = -Constants::kKaptonThickness/2-Constants::kAluThickness/2-Constants::kGlueThickness;
+  Double_t zvarnishOut = -Constants::kKaptonThickness/2-Constants::kAluThickness-Constants::kVarnishThickness/2-Constants::kGlueThickness;
+
+  flex->AddNode(varnishlayerIn,  1,  new TGeoTranslation(0., 0., zvarnishIn));    // inside, in front of the cold plate
+  flex->AddNode(agnd_dgnd,       1,  new TGeoTranslation(0., 0., zgnd));
+  flex->AddNode(kaptonlayer,     1,  new TGeoTranslation(0., 0., zkaptonlayer));
+  flex->AddNode(lines,           1,  new TGeoTranslation(0., 0., zlines));
+  flex->AddNode(varnishlayerOut, 1,  new TGeoTranslation(0., 0., zvarnishOut));   // outside
+
+  return flex;
+}
+
 
 //_____________________________________________________________________________
 void Flex::Make_ElectricComponents(TGeoVolumeAssembly*  flex, Int_t nbsensors, Double_t length, Double_t zvarnish) 
@@ -39,7 +39,8 @@ Geometry::Geometry():
 TNamed("MFT", "Muon Forward Tracker"),
 fBuilder(0),
 fSegmentation(0),
-fSensorVolumeID(0)
+fSensorVolumeID(0),
+fDetailLevel(kDetailFull)
 {
   // default constructor
 
@@ -124,6 +124,15 @@ TGeoVolumeAssembly* HeatExchanger::Create(Int_t half, Int_t disk)
   //Info("Create",Form("Creating HeatExchanger_%d_%d", disk, half),0,0);
   
   fHalfDisk = new TGeoVolumeAssembly(Form("HeatExchanger_%d_%d", disk, half));
+
+  // at reduced detail the exchanger is replaced by averaged slabs or omitted
+  Int_t detailLevel = Geometry::Instance()->GetDetailLevel();
+  if (detailLevel == Geometry::kDetailMinimal) return fHalfDisk;
+  if (detailLevel == Geometry::kDetailAveraged) {
+    CreateAveraged(half, disk);
+    return fHalfDisk;
+  }
+
     switch (disk) {
       case 0: CreateHalfDisk0(half);
         break;
@@ -141,6 +150,54 @@ TGeoVolumeAssembly* HeatExchanger::Create(Int_t half, Int_t disk)
   
 }
 
+/// \brief Averaged-material replacement of the detailed heat exchanger
+///
+/// Builds, for each support part of the half-disk, plain carbon and rohacell
+/// slabs covering the same envelope as the detailed plates, without the
+/// central holes and without the water pipes. Used at
+/// Geometry::kDetailAveraged to cut the geometry build time and the
+/// navigation cost in productions which do not look at the MFT.
+
+//_____________________________________________________________________________
+void HeatExchanger::CreateAveraged(Int_t half, Int_t disk) {
+
+  carbon   = gGeoManager->GetMedium("MFT_CarbonFiber$");
+  rohacell = gGeoManager->GetMedium("MFT_Rohacell");
+
+  Double_t deltaz = fHeatExchangerThickness - fCarbonThickness*2;  // distance between pair of carbon plates
+
+  TGeoVolumeAssembly *carbonPlate   = new TGeoVolumeAssembly(Form("carbonPlate_D%d_H%d",disk,half));
+  TGeoVolumeAssembly *rohacellPlate = new TGeoVolumeAssembly(Form("rohacellPlate_D%d_H%d",disk,half));
+
+  // same part positioning as the detailed CreateHalfDiskN builders
+  TGeoVolume *partCarbon0 = gGeoManager->MakeBox(Form("partCarbon_D%d_H%d_0", disk, half), carbon, fSupportXDimensions[disk][0]/2., fSupportYDimensions[disk][0]/2., fCarbonThickness);
+  partCarbon0->SetLineColor(kGray+3);
+  carbonPlate->AddNode(partCarbon0, 0, new TGeoTranslation(0., 0., fZPlan[disk]));
+
+  TGeoVolume *partRohacell0 = gGeoManager->MakeBox(Form("partRohacell_D%d_H%d_0", disk, half), rohacell, fSupportXDimensions[disk][0]/2., fSupportYDimensions[disk][0]/2., fRohacellThickness);
+  partRohacell0->SetLineColor(kGray);
+  rohacellPlate->AddNode(partRohacell0, 0, new TGeoTranslation(0., 0., fZPlan[disk]));
+
+  Double_t ty = fSupportYDimensions[disk][0];
+
+  for (Int_t ipart=1; ipart<fnPart[disk]; ipart ++) {
+    ty += fSupportYDimensions[disk][ipart]/2.;
+    TGeoVolume *partCarbon = gGeoManager->MakeBox(Form("partCarbon_D%d_H%d_%d", disk, half, ipart), carbon, fSupportXDimensions[disk][ipart]/2., fSupportYDimensions[disk][ipart]/2., fCarbonThickness);
+    partCarbon->SetLineColor(kGray+3);
+    carbonPlate->AddNode(partCarbon, ipart, new TGeoTranslation(0., ty + fHalfDiskGap, fZPlan[disk]));
+    TGeoVolume *partRohacell = gGeoManager->MakeBox(Form("partRohacell_D%d_H%d_%d", disk, half, ipart), rohacell, fSupportXDimensions[disk][ipart]/2., fSupportYDimensions[disk][ipart]/2., fRohacellThickness);
+    partRohacell->SetLineColor(kGray);
+    rohacellPlate->AddNode(partRohacell, ipart, new TGeoTranslation(0., ty + fHalfDiskGap, fZPlan[disk]));
+    ty += fSupportYDimensions[disk][ipart]/2.;
+  }
+
+  TGeoRotation *rotation = new TGeoRotation ("rotation", 180., 0., 0.);
+  fHalfDisk->AddNode(carbonPlate, 3, new TGeoCombiTrans(0., 0., deltaz/2., rotation));
+  fHalfDisk->AddNode(carbonPlate, 4, new TGeoCombiTrans(0., 0., -deltaz/2., rotation));
+  fHalfDisk->AddNode(rohacellPlate, 1, new TGeoCombiTrans(0., 0., 0., rotation));
+
+}
+
 //_____________________________________________________________________________
 void HeatExchanger::CreateHalfDisk0(Int_t half) {
   
@@ -76,7 +76,11 @@ TGeoVolume * Ladder::CreateVolume()
   fFlex = new Flex(fSegmentation);     
   Double_t kFlexLength = nChips*(Constants::kSensorLength+Constants::kSensorInterspace)+Constants::kLadderOffsetToEnd + Constants::kSensorSideOffset;
   Double_t kShiftY = 2*Constants::kSensorTopOffset+Constants::kSensorHeight-Constants::kFlexHeight/2; // strange
-  TGeoVolumeAssembly * flexVol = fFlex->MakeFlex(fSegmentation->GetNSensors(), kFlexLength);                               
+  TGeoVolumeAssembly * flexVol;
+  if (Geometry::Instance()->GetDetailLevel() == Geometry::kDetailFull)
+    flexVol = fFlex->MakeFlex(fSegmentation->GetNSensors(), kFlexLength);
+  else
+    flexVol = fFlex->MakeFlexAveraged(fSegmentation->GetNSensors(), kFlexLength);
   fLadderVolume->AddNode(flexVol, 1, new TGeoTranslation(kFlexLength/2+Constants::kSensorSideOffset/2, kShiftY, Constants::kFlexThickness/2));     
 
   // Create the CMOS Sensors
@@ -0,0 +1,67 @@
+/// \file FiredChipIndex.h
+/// \brief Definition of the fired-chip index of one digitized event
+#ifndef ALICEO2_ITSMFT_FIREDCHIPINDEX_H
+#define ALICEO2_ITSMFT_FIREDCHIPINDEX_H
+
+#include "TNamed.h"
+#include "Rtypes.h"
+
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2
+{
+namespace ITSMFT
+{
+/// \class FiredChipIndex
+/// \brief Compact list of the chips fired in one event with their digit counts
+///
+/// The digitizer writes the digits grouped by ascending chip; the index
+/// records, in the same order, which chips fired and how many digits each
+/// one got. A consumer iterating the digit array chip by chip can then slice
+/// it directly from the accumulated counts and touch only the occupied
+/// chips, instead of scanning all chips of the detector for content.
+class FiredChipIndex : public TNamed
+{
+ public:
+  FiredChipIndex();
+  virtual ~FiredChipIndex();
+
+  /// Drop the content, the capacity stays for the next event
+  void clear()
+  {
+    mChipIds.clear();
+    mCounts.clear();
+  }
+
+  /// Append one fired chip; the chips must arrive in the digit array order
+  /// @param chipId Global index of the chip
+  /// @param count Number of digits of the chip
+  void addChip(UShort_t chipId, Int_t count)
+  {
+    mChipIds.push_back(chipId);
+    mCounts.push_back(count);
+  }
+
+  /// Rebuild the index from a digit array grouped by chip
+  /// @param digits Array of AliceO2::ITSMFT::Digit grouped by chip
+  void buildFrom(const TClonesArray* digits);
+
+  Int_t getNumberOfChips() const { return mChipIds.size(); }
+  UShort_t getChipId(Int_t i) const { return mChipIds[i]; }
+  Int_t getNumberOfDigits(Int_t i) const { return mCounts[i]; }
+
+  /// Total number of digits over the fired chips
+  Int_t getTotalNumberOfDigits() const;
+
+ private:
+  std::vector<UShort_t> mChipIds; ///< Fired chips, in the digit array order
+  std::vector<Int_t> mCounts;     ///< Digits of each fired chip
+
+  ClassDef(FiredChipIndex, 1);
+};
+}
+}
+
+#endif /* ALICEO2_ITSMFT_FIREDCHIPINDEX_H */
@@ -0,0 +1,137 @@
+/// \file SegmentationPixelFast.h
+/// \brief Definition of the SegmentationPixelFast class
+
+#ifndef ALICEO2_ITSMFT_SEGMENTATIONPIXELFAST_H_
+#define ALICEO2_ITSMFT_SEGMENTATIONPIXELFAST_H_
+
+#include "ITSMFTBase/SegmentationPixel.h"
+
+namespace AliceO2
+{
+namespace ITSMFT
+{
+/// Sealed, header-only snapshot of a SegmentationPixel for the per-pixel hot
+/// loops. The coordinate transformations and pitch queries are plain inline
+/// calls on a concrete type, so code templated on the segmentation type (like
+/// the digitizer conversion loop) pays no vtable indirection per pixel. The
+/// diod-shift machinery and the chip-level queries stay on SegmentationPixel.
+class SegmentationPixelFast final
+{
+ public:
+  SegmentationPixelFast() = default;
+
+  explicit SegmentationPixelFast(const SegmentationPixel& seg)
+    : mShiftLocalX(seg.getShiftXLoc()),
+      mShiftLocalZ(seg.getShiftZLoc()),
+      mDxActive(seg.dxActive()),
+      mDzActive(seg.dzActive()),
+      mPitchX(seg.cellSizeX()),
+      mPitchZ(0.f),
+      mPitchZLeftColumn(seg.cellSizeZ(0)),
+      mPitchZRightColumn(0.f),
+      mChipSizeDZ(0.f),
+      mNumberOfColumnsPerChip(0),
+      mNumberOfRows(seg.getNumberOfRows()),
+      mNumberOfColumns(seg.getNumberOfColumns())
+  {
+    mNumberOfColumnsPerChip = seg.getNumberOfChips() ? mNumberOfColumns / seg.getNumberOfChips() : 0;
+    mPitchZ = seg.cellSizeZ(1);
+    mPitchZRightColumn = seg.cellSizeZ(mNumberOfColumnsPerChip - 1);
+    mChipSizeDZ = (mNumberOfColumnsPerChip - 2) * mPitchZ + mPitchZLeftColumn + mPitchZRightColumn;
+  }
+
+  /// Same conversion as SegmentationPixel::localToDetector, non-virtual
+  bool localToDetector(Float_t x, Float_t z, Int_t& ix, Int_t& iz) const
+  {
+    x += 0.5 * mDxActive + mShiftLocalX; // get X,Z wrt bottom/left corner
+    z += 0.5 * mDzActive + mShiftLocalZ;
+    ix = iz = -1;
+    if (x < 0 || x > mDxActive) {
+      return false;
+    }
+    if (z < 0 || z > mDzActive) {
+      return false;
+    }
+    ix = int(x / mPitchX);
+    iz = int(zToColumn(z));
+    return true;
+  }
+
+  /// Same conversion as SegmentationPixel::detectorToLocal, non-virtual
+  bool detectorToLocal(Int_t ix, Int_t iz, Float_t& x, Float_t& z) const
+  {
+    x = -0.5 * mDxActive; // default value.
+    z = -0.5 * mDzActive; // default value.
+    if (ix < 0 || ix >= mNumberOfRows) {
+      return false;
+    }
+    if (iz < 0 || iz >= mNumberOfColumns) {
+      return false;
+    }
+    x += (ix + 0.5) * mPitchX - mShiftLocalX;
+    z += columnToZ(iz) - mShiftLocalZ;
+    return true;
+  }
+
+  Float_t cellSizeX(Int_t = 0) const { return mPitchX; }
+  Float_t cellSizeZ(Int_t col) const
+  {
+    col %= mNumberOfColumnsPerChip;
+    if (!col) {
+      return mPitchZLeftColumn;
+    }
+    if (col == mNumberOfColumnsPerChip - 1) {
+      return mPitchZRightColumn;
+    }
+    return mPitchZ;
+  }
+
+  Int_t getNumberOfRows() const { return mNumberOfRows; }
+  Int_t getNumberOfColumns() const { return mNumberOfColumns; }
+
+ private:
+  Float_t zToColumn(Float_t z) const
+  {
+    int chip = int(z / mChipSizeDZ);
+    float col = chip * mNumberOfColumnsPerChip;
+    z -= chip * mChipSizeDZ;
+    if (z > mPitchZLeftColumn) {
+      col += 1 + (z - mPitchZLeftColumn) / mPitchZ;
+    }
+    return col;
+  }
+
+  Float_t columnToZ(Int_t col) const
+  {
+    int nchip = col / mNumberOfColumnsPerChip;
+    col %= mNumberOfColumnsPerChip;
+    float z = nchip * mChipSizeDZ;
+    if (col > 0) {
+      if (col < mNumberOfColumnsPerChip - 1) {
+        z += mPitchZLeftColumn + (col - 0.5) * mPitchZ;
+      } else {
+        z += mChipSizeDZ - mPitchZRightColumn / 2;
+      }
+    } else {
+      z += mPitchZLeftColumn / 2;
+    }
+    return z;
+  }
+
+  Float_t mShiftLocalX = 0.f;        ///< shift in local X of sensitive area wrt geometry center
+  Float_t mShiftLocalZ = 0.f;        ///< shift in local Z of sensitive area wrt geometry center
+  Float_t mDxActive = 0.f;           ///< size of active area in X
+  Float_t mDzActive = 0.f;           ///< size of active area in Z
+  Float_t mPitchX = 0.f;             ///< default pitch in X
+  Float_t mPitchZ = 0.f;             ///< default pitch in Z
+  Float_t mPitchZLeftColumn = 0.f;   ///< Z pitch of left column of each chip
+  Float_t mPitchZRightColumn = 0.f;  ///< Z pitch of right column of each chip
+  Float_t mChipSizeDZ = 0.f;         ///< aux: chip size along Z
+  Int_t mNumberOfColumnsPerChip = 0; ///< number of columns per chip
+  Int_t mNumberOfRows = 0;           ///< number of rows
+  Int_t mNumberOfColumns = 0;        ///< number of columns (total)
+};
+}
+}
+
+#endif
@@ -0,0 +1,35 @@
+/// \file FiredChipIndex.cxx
+/// \brief Implementation of the fired-chip index of one digitized event
+#include "ITSMFTBase/FiredChipIndex.h"
+#include "ITSMFTBase/Digit.h"
+
+#include "TClonesArray.h"
+
+ClassImp(AliceO2::ITSMFT::FiredChipIndex)
+
+using namespace AliceO2::ITSMFT;
+
+FiredChipIndex::FiredChipIndex() : TNamed("FiredChipIndex", "Fired chips of one event") {}
+
+FiredChipIndex::~FiredChipIndex() {}
+
+void FiredChipIndex::buildFrom(const TClonesArray* digits)
+{
+  clear();
+  const Int_t numOfDigits = digits->GetEntriesFast();
+  for (Int_t i = 0; i < numOfDigits; i++) {
+    const Digit* digit = static_cast<const Digit*>(digits->UncheckedAt(i));
+    if (mChipIds.empty() || digit->getChipIndex() != mChipIds.back()) {
+      addChip(digit->getChipIndex(), 0);
+    }
+    mCounts.back()++;
+  }
+}
+
+Int_t FiredChipIndex::getTotalNumberOfDigits() const
+{
+  Int_t total = 0;
+  for (Int_t count : mCounts)
+    total += count;
+  return total;
+}
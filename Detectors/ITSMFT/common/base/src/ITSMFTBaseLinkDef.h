@@ -6,6 +6,7 @@
 
 #pragma link C++ class AliceO2::ITSMFT::SDigit+;
 #pragma link C++ class AliceO2::ITSMFT::Digit+;
+#pragma link C++ class AliceO2::ITSMFT::FiredChipIndex+;
 #pragma link C++ class AliceO2::ITSMFT::SensMap+;
 //#pragma link C++ class AliceO2::ITS::GeometryTGeo+;
 //#pragma link C++ class AliceO2::ITS::GeometryManager+;
@@ -0,0 +1,73 @@
+/// \file AlpideDecoder.h
+/// \brief Decoder turning ALPIDE-like chip payloads back into pixel hits
+#ifndef ALICEO2_ITSMFT_AlpideDecoder_H_
+#define ALICEO2_ITSMFT_AlpideDecoder_H_
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace ITSMFT {
+
+    /// \struct PixelHit
+    /// \brief One decoded pixel hit
+    struct PixelHit {
+      UShort_t chipId; ///< global index of the chip
+      UShort_t row;    ///< pixel row within the chip
+      UShort_t col;    ///< pixel column within the chip
+    };
+
+    /// \class AlpideDecoder
+    /// \brief Decoder unpacking per-chip encoded streams into pixel hits
+    ///
+    /// The inverse of the AlpideEncoder: the buffer is scanned once for the
+    /// chip frame boundaries, the frames are then decoded concurrently on a
+    /// pool of worker threads in contiguous ranges with private output
+    /// buffers, concatenated in frame order. Every frame is checked against
+    /// its CRC before its hits are emitted; corrupted frames are dropped as
+    /// a whole and counted in getNumberOfCorruptFrames(). Truncated or
+    /// version-mismatched frames stop the scan with an error.
+
+    class AlpideDecoder {
+    public:
+      AlpideDecoder();
+
+      /// Set the number of worker threads used by decode
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by decode
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Decode a raw buffer into pixel hits appended to the output
+      /// @param raw Buffer with chip frames
+      /// @param size Size of the buffer in bytes
+      /// @param hits Output the decoded hits are appended to
+      /// @return Number of hits decoded
+      size_t decode(const UChar_t *raw, size_t size, std::vector<PixelHit> &hits);
+
+      /// Decode a raw buffer into a TClonesArray of digits; the stream
+      /// carries positions only, the digits get unit charge and time 0
+      /// @param raw Buffer with chip frames
+      /// @param size Size of the buffer in bytes
+      /// @param digits Output array the decoded digits are added to
+      /// @return Number of digits decoded
+      size_t decode(const UChar_t *raw, size_t size, TClonesArray *digits);
+
+      /// Get the number of frames dropped on a CRC mismatch in the last decode
+      /// @return Number of corrupted frames
+      size_t getNumberOfCorruptFrames() const {return mCorruptFrames;}
+
+    private:
+      Int_t  mNumThreads;    ///< number of worker threads used by decode
+      size_t mCorruptFrames; ///< frames dropped on a CRC mismatch in the last decode
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/// \file AlpideEncoder.h
+/// \brief Encoder producing ALPIDE-like chip payloads from pixel digits
+#ifndef ALICEO2_ITSMFT_AlpideEncoder_H_
+#define ALICEO2_ITSMFT_AlpideEncoder_H_
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace ITSMFT {
+
+    /// \class AlpideEncoder
+    /// \brief Encoder packing pixel digits into per-chip encoded streams
+    ///
+    /// The digits are bucketed by chip, brought into the priority-encoder
+    /// readout order and emitted as one CRC-protected chip frame per hit
+    /// chip, region-framed with delta-encoded hit keys (see AlpideFormat.h).
+    /// Chips are distributed over a pool of worker threads in contiguous
+    /// index ranges, i.e. stave-sized portions of the detector, each worker
+    /// appending to a private buffer; the buffers are concatenated in chip
+    /// order, so the output is independent of the thread count. Like the
+    /// real chip the stream carries hit positions only, charge and time of
+    /// the digits are not part of the payload.
+
+    class AlpideEncoder {
+    public:
+      AlpideEncoder();
+
+      /// Set the number of worker threads used by encode
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by encode
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Encode digits into chip frames appended to a raw buffer
+      /// The digits may arrive in any order; duplicates of one pixel
+      /// collapse into a single hit.
+      /// @param digits Container with pixel digits
+      /// @param raw Buffer the frames are appended to
+      /// @return Number of bytes appended
+      size_t encode(TClonesArray *digits, std::vector<UChar_t> &raw);
+
+    private:
+      Int_t mNumThreads;  ///< number of worker threads used by encode
+    };
+  }
+}
+
+#endif
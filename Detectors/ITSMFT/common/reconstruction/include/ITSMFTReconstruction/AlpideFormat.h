@@ -0,0 +1,120 @@
+/// \file AlpideFormat.h
+/// \brief Chip payload format of the ALPIDE-like encoded pixel data
+#ifndef ALICEO2_ITSMFT_AlpideFormat_H_
+#define ALICEO2_ITSMFT_AlpideFormat_H_
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace AliceO2 {
+  namespace ITSMFT {
+    namespace AlpideFormat {
+
+      /// An encoded buffer is a sequence of chip frames. Each frame is a
+      /// ChipHeader, the region frames of the chip, and a ChipTrailer with
+      /// a CRC-32 over the region bytes, so a corrupted frame is detected
+      /// before its hits reach the readout chain. A region frame is a
+      /// RegionHeader followed by the hit bytes of the region: the hits are
+      /// ordered like the on-chip priority encoder reads them out (double
+      /// column by double column, within a double column by the interleaved
+      /// encoder address) and stored as deltas of that ordering key, the
+      /// first hit absolute, the following ones as varint increments.
+
+      /// matrix and readout geometry of the chip
+      enum {
+        kNRows           = 512,  ///< pixel rows of the chip
+        kNCols           = 1024, ///< pixel columns of the chip
+        kNRegions        = 32,   ///< readout regions of the chip
+        kDColsPerRegion  = 16,   ///< double columns per region
+        kAddressesPerDCol = 2*kNRows, ///< priority-encoder addresses per double column
+        kKeyBits         = 14    ///< bits of the (double column, address) ordering key
+      };
+
+      /// \struct ChipHeader
+      /// \brief Header of one chip frame
+      struct ChipHeader {
+        UShort_t chipId;   ///< global index of the chip
+        UChar_t  version;  ///< format version
+        UChar_t  nRegions; ///< number of region frames following
+        UInt_t   nBytes;   ///< region bytes between header and trailer
+      };
+
+      static_assert(sizeof(ChipHeader) == 8, "the chip header must stay one 64-bit word");
+
+      /// \struct ChipTrailer
+      /// \brief Trailer of one chip frame
+      struct ChipTrailer {
+        UInt_t crc;        ///< CRC-32 over the region bytes of the frame
+      };
+
+      /// \struct RegionHeader
+      /// \brief Header of one region frame
+      struct RegionHeader {
+        UChar_t  region;   ///< region within the chip
+        UChar_t  reserved; ///< padding, written as 0
+        UShort_t nHits;    ///< hits of the region
+      };
+
+      static_assert(sizeof(RegionHeader) == 4, "the region header must stay one 32-bit word");
+
+      /// format version written by the encoder
+      const UChar_t kVersion = 1;
+
+      /// Priority-encoder ordering key of a pixel: double column within the
+      /// region (4 bits) and encoder address within the double column
+      /// (10 bits). The encoder walks the two columns of a double column
+      /// interleaved, which the address parity term reproduces.
+      /// @param row Pixel row within the chip
+      /// @param col Pixel column within the chip
+      /// @return Ordering key within the region of the pixel
+      inline UInt_t pixelKey(UInt_t row, UInt_t col) {
+        const UInt_t dcolInRegion = (col >> 1) % kDColsPerRegion;
+        const UInt_t address = (row << 1) | ((col & 0x1) ^ (row & 0x1));
+        return (dcolInRegion << 10) | address;
+      }
+
+      /// Region of a pixel within the chip
+      inline UInt_t regionOfPixel(UInt_t col) { return (col >> 1) / kDColsPerRegion; }
+
+      /// Row and column of an ordering key
+      /// @param region Region the key belongs to
+      /// @param key Ordering key within the region
+      /// @param row On output the pixel row within the chip
+      /// @param col On output the pixel column within the chip
+      inline void pixelOfKey(UInt_t region, UInt_t key, UInt_t &row, UInt_t &col) {
+        const UInt_t address = key & (kAddressesPerDCol - 1);
+        const UInt_t dcol = region*kDColsPerRegion + (key >> 10);
+        row = address >> 1;
+        col = (dcol << 1) | ((address & 0x1) ^ (row & 0x1));
+      }
+
+      /// Append a value as a 7-bit varint to the buffer
+      inline void putVarint(UInt_t value, std::vector<UChar_t> &buffer) {
+        while(value >= 0x80) {
+          buffer.push_back(static_cast<UChar_t>(value) | 0x80);
+          value >>= 7;
+        }
+        buffer.push_back(static_cast<UChar_t>(value));
+      }
+
+      /// Read a 7-bit varint, advancing the cursor; kFALSE on a truncated value
+      inline Bool_t getVarint(const UChar_t *buffer, size_t size, size_t &cursor, UInt_t &value) {
+        value = 0;
+        for(Int_t shift = 0; cursor < size; shift += 7) {
+          const UChar_t byte = buffer[cursor++];
+          value |= static_cast<UInt_t>(byte & 0x7F) << shift;
+          if((byte & 0x80) == 0) return kTRUE;
+        }
+        return kFALSE;
+      }
+
+      /// CRC-32 (reflected 0xEDB88320) over a byte range
+      UInt_t crc32(const UChar_t *data, size_t size);
+
+    }
+  }
+}
+
+#endif
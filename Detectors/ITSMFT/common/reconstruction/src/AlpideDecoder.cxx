@@ -0,0 +1,146 @@
+/// \file AlpideDecoder.cxx
+/// \brief Decoder turning ALPIDE-like chip payloads back into pixel hits
+#include "ITSMFTReconstruction/AlpideDecoder.h"
+#include "ITSMFTReconstruction/AlpideFormat.h"
+
+#include "ITSMFTBase/Digit.h"
+
+#include "TClonesArray.h"
+
+#include "FairLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace AliceO2::ITSMFT;
+
+namespace {
+  /// one chip frame located by the boundary scan
+  struct FrameRange {
+    size_t begin;  ///< offset of the chip header in the buffer
+    size_t size;   ///< bytes of the frame including header and trailer
+  };
+
+  /// decode one verified chip frame into the output; kFALSE on a CRC mismatch
+  Bool_t decodeFrame(const UChar_t *raw, const FrameRange &frame,
+                     std::vector<PixelHit> &out) {
+    AlpideFormat::ChipHeader header;
+    std::memcpy(&header, raw + frame.begin, sizeof(header));
+    const UChar_t *regions = raw + frame.begin + sizeof(header);
+
+    AlpideFormat::ChipTrailer trailer;
+    std::memcpy(&trailer, regions + header.nBytes, sizeof(trailer));
+    if(AlpideFormat::crc32(regions, header.nBytes) != trailer.crc) {
+      return kFALSE;
+    }
+
+    size_t cursor = 0;
+    for(Int_t iRegion = 0; iRegion < header.nRegions; ++iRegion) {
+      AlpideFormat::RegionHeader regionHeader;
+      std::memcpy(&regionHeader, regions + cursor, sizeof(regionHeader));
+      cursor += sizeof(regionHeader);
+
+      UInt_t key = 0;
+      for(UShort_t iHit = 0; iHit < regionHeader.nHits; ++iHit) {
+        UInt_t value = 0;
+        AlpideFormat::getVarint(regions, header.nBytes, cursor, value);
+        key = (iHit == 0) ? value : key + value;
+        UInt_t row, col;
+        AlpideFormat::pixelOfKey(regionHeader.region, key, row, col);
+        out.push_back(PixelHit{header.chipId,
+                               static_cast<UShort_t>(row), static_cast<UShort_t>(col)});
+      }
+    }
+    return kTRUE;
+  }
+}
+
+AlpideDecoder::AlpideDecoder() :
+mNumThreads(1),
+mCorruptFrames(0)
+{}
+
+size_t AlpideDecoder::decode(const UChar_t *raw, size_t size, std::vector<PixelHit> &hits) {
+  mCorruptFrames = 0;
+
+  // single scan over the frame boundaries; the region bytes are not touched
+  std::vector<FrameRange> frames;
+  size_t cursor = 0;
+  while(cursor < size) {
+    if(size - cursor < sizeof(AlpideFormat::ChipHeader) + sizeof(AlpideFormat::ChipTrailer)) {
+      LOG(ERROR) << "Truncated chip frame at byte " << cursor << ", stopping the scan"
+                 << FairLogger::endl;
+      return 0;
+    }
+    AlpideFormat::ChipHeader header;
+    std::memcpy(&header, raw + cursor, sizeof(header));
+    if(header.version != AlpideFormat::kVersion) {
+      LOG(ERROR) << "Chip frame version " << static_cast<Int_t>(header.version)
+                 << " does not match " << static_cast<Int_t>(AlpideFormat::kVersion)
+                 << ", stopping the scan" << FairLogger::endl;
+      return 0;
+    }
+    const size_t frameSize = sizeof(header) + header.nBytes + sizeof(AlpideFormat::ChipTrailer);
+    if(size - cursor < frameSize) {
+      LOG(ERROR) << "Truncated chip frame at byte " << cursor << ", stopping the scan"
+                 << FairLogger::endl;
+      return 0;
+    }
+    frames.push_back(FrameRange{cursor, frameSize});
+    cursor += frameSize;
+  }
+  if(frames.empty()) return 0;
+
+  // frames are decoded in contiguous ranges on the worker pool, each into a
+  // private buffer; concatenated in range order the output keeps frame order
+  const Int_t numThreads = std::min<Int_t>(mNumThreads, frames.size());
+  std::vector<std::vector<PixelHit>> buffers(numThreads > 1 ? numThreads : 1);
+  std::atomic<size_t> corrupt(0);
+
+  auto decodeRange = [&](size_t firstFrame, size_t lastFrame, std::vector<PixelHit> &out) {
+    for(size_t iFrame = firstFrame; iFrame < lastFrame; ++iFrame) {
+      if(!decodeFrame(raw, frames[iFrame], out)) {
+        ++corrupt;
+      }
+    }
+  };
+
+  if(numThreads > 1) {
+    std::vector<std::thread> workers;
+    const size_t blockSize = (frames.size() + numThreads - 1)/numThreads;
+    for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+      const size_t first = iThread*blockSize;
+      const size_t last = std::min(first + blockSize, frames.size());
+      workers.emplace_back(decodeRange, first, last, std::ref(buffers[iThread]));
+    }
+    for(auto &worker : workers) worker.join();
+  }
+  else {
+    decodeRange(0, frames.size(), buffers[0]);
+  }
+
+  mCorruptFrames = corrupt;
+  if(mCorruptFrames > 0) {
+    LOG(WARNING) << "Dropped " << mCorruptFrames << " chip frames on a CRC mismatch"
+                 << FairLogger::endl;
+  }
+
+  size_t decoded = 0;
+  for(const auto &buffer : buffers) decoded += buffer.size();
+  hits.reserve(hits.size() + decoded);
+  for(const auto &buffer : buffers) {
+    hits.insert(hits.end(), buffer.begin(), buffer.end());
+  }
+  return decoded;
+}
+
+size_t AlpideDecoder::decode(const UChar_t *raw, size_t size, TClonesArray *digits) {
+  std::vector<PixelHit> hits;
+  const size_t decoded = decode(raw, size, hits);
+  for(const auto &hit : hits) {
+    new ((*digits)[digits->GetEntriesFast()]) Digit(hit.chipId, hit.row, hit.col, 1., 0.);
+  }
+  return decoded;
+}
@@ -0,0 +1,156 @@
+/// \file AlpideEncoder.cxx
+/// \brief Encoder producing ALPIDE-like chip payloads from pixel digits
+#include "ITSMFTReconstruction/AlpideEncoder.h"
+#include "ITSMFTReconstruction/AlpideFormat.h"
+
+#include "ITSMFTBase/Digit.h"
+
+#include "TClonesArray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+using namespace AliceO2::ITSMFT;
+
+namespace {
+  /// append a POD header to a byte buffer
+  template <typename T>
+  void putStruct(const T &value, std::vector<UChar_t> &buffer) {
+    const UChar_t *bytes = reinterpret_cast<const UChar_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  /// encode the sorted region keys of one chip as a frame appended to out
+  void encodeChip(UShort_t chipId, const UInt_t *keys, size_t numOfKeys,
+                  std::vector<UChar_t> &out) {
+    // header first as a placeholder, backpatched once the sizes are known
+    const size_t headerStart = out.size();
+    AlpideFormat::ChipHeader header;
+    header.chipId = chipId;
+    header.version = AlpideFormat::kVersion;
+    header.nRegions = 0;
+    header.nBytes = 0;
+    putStruct(header, out);
+    const size_t regionStart = out.size();
+
+    size_t i = 0;
+    while(i < numOfKeys) {
+      const UInt_t region = keys[i] >> AlpideFormat::kKeyBits;
+      const size_t regionHeaderStart = out.size();
+      AlpideFormat::RegionHeader regionHeader;
+      regionHeader.region = static_cast<UChar_t>(region);
+      regionHeader.reserved = 0;
+      regionHeader.nHits = 0;
+      putStruct(regionHeader, out);
+
+      // the first hit carries its key absolute, the following ones the
+      // increment along the priority-encoder ordering; duplicates of one
+      // pixel collapse into a single hit
+      UInt_t previous = 0;
+      UShort_t nHits = 0;
+      Bool_t first = kTRUE;
+      for(; i < numOfKeys && (keys[i] >> AlpideFormat::kKeyBits) == region; ++i) {
+        const UInt_t key = keys[i] & ((1u << AlpideFormat::kKeyBits) - 1);
+        if(first) {
+          AlpideFormat::putVarint(key, out);
+          first = kFALSE;
+        }
+        else {
+          if(key == previous) continue;
+          AlpideFormat::putVarint(key - previous, out);
+        }
+        previous = key;
+        ++nHits;
+      }
+      std::memcpy(&out[regionHeaderStart + offsetof(AlpideFormat::RegionHeader, nHits)],
+                  &nHits, sizeof(nHits));
+      ++header.nRegions;
+    }
+
+    header.nBytes = static_cast<UInt_t>(out.size() - regionStart);
+    std::memcpy(&out[headerStart], &header, sizeof(header));
+
+    AlpideFormat::ChipTrailer trailer;
+    trailer.crc = AlpideFormat::crc32(&out[regionStart], header.nBytes);
+    putStruct(trailer, out);
+  }
+}
+
+AlpideEncoder::AlpideEncoder() :
+mNumThreads(1)
+{}
+
+size_t AlpideEncoder::encode(TClonesArray *digits, std::vector<UChar_t> &raw) {
+  const Int_t numOfDigits = digits->GetEntriesFast();
+  if(numOfDigits == 0) return 0;
+
+  // map every digit to its chip and ordering key (region and in-region key
+  // in one word, so one ascending sort establishes the readout order)
+  std::vector<std::pair<UShort_t, UInt_t>> hits(numOfDigits);
+  UShort_t maxChip = 0;
+  for(Int_t iDigit = 0; iDigit < numOfDigits; ++iDigit) {
+    const Digit *digit = static_cast<const Digit*>(digits->UncheckedAt(iDigit));
+    const UInt_t row = digit->getRow();
+    const UInt_t col = digit->getColumn();
+    hits[iDigit].first = digit->getChipIndex();
+    hits[iDigit].second = (AlpideFormat::regionOfPixel(col) << AlpideFormat::kKeyBits)
+                          | AlpideFormat::pixelKey(row, col);
+    maxChip = std::max(maxChip, hits[iDigit].first);
+  }
+
+  // bucket the keys by chip with a counting scatter
+  const Int_t numOfChips = maxChip + 1;
+  std::vector<UInt_t> counts(numOfChips, 0);
+  for(const auto &hit : hits) ++counts[hit.first];
+  std::vector<size_t> chipStart(numOfChips + 1, 0);
+  for(Int_t iChip = 0; iChip < numOfChips; ++iChip) {
+    chipStart[iChip + 1] = chipStart[iChip] + counts[iChip];
+  }
+  std::vector<UInt_t> keys(numOfDigits);
+  {
+    std::vector<size_t> cursor(chipStart.begin(), chipStart.end() - 1);
+    for(const auto &hit : hits) keys[cursor[hit.first]++] = hit.second;
+  }
+
+  // the chips are distributed over the workers in contiguous index ranges
+  // (stave-sized portions of the detector); each worker sorts its chips
+  // into readout order and encodes into a private buffer
+  const Int_t numThreads = std::min(mNumThreads, numOfChips);
+  std::vector<std::vector<UChar_t>> buffers(numThreads > 1 ? numThreads : 1);
+
+  auto encodeRange = [&](Int_t firstChip, Int_t lastChip, std::vector<UChar_t> &out) {
+    for(Int_t iChip = firstChip; iChip < lastChip; ++iChip) {
+      const size_t first = chipStart[iChip];
+      const size_t n = chipStart[iChip + 1] - first;
+      if(n == 0) continue;
+      std::sort(keys.begin() + first, keys.begin() + first + n);
+      encodeChip(static_cast<UShort_t>(iChip), &keys[first], n, out);
+    }
+  };
+
+  if(numThreads > 1) {
+    std::vector<std::thread> workers;
+    const Int_t blockSize = (numOfChips + numThreads - 1)/numThreads;
+    for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+      const Int_t first = iThread*blockSize;
+      const Int_t last = std::min(first + blockSize, numOfChips);
+      workers.emplace_back(encodeRange, first, last, std::ref(buffers[iThread]));
+    }
+    for(auto &worker : workers) worker.join();
+  }
+  else {
+    encodeRange(0, numOfChips, buffers[0]);
+  }
+
+  // concatenated in range order the output is independent of the thread count
+  size_t appended = 0;
+  for(const auto &buffer : buffers) appended += buffer.size();
+  raw.reserve(raw.size() + appended);
+  for(const auto &buffer : buffers) {
+    raw.insert(raw.end(), buffer.begin(), buffer.end());
+  }
+  return appended;
+}
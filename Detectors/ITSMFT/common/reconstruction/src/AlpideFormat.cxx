@@ -0,0 +1,33 @@
+/// \file AlpideFormat.cxx
+/// \brief CRC of the ALPIDE-like chip payload format
+#include "ITSMFTReconstruction/AlpideFormat.h"
+
+using namespace AliceO2::ITSMFT;
+
+namespace {
+  /// byte table of the reflected CRC-32 polynomial, built on first use
+  const UInt_t *crcTable() {
+    static UInt_t table[256];
+    static Bool_t ready = kFALSE;
+    if(!ready) {
+      for(UInt_t byte = 0; byte < 256; ++byte) {
+        UInt_t crc = byte;
+        for(Int_t bit = 0; bit < 8; ++bit) {
+          crc = (crc >> 1) ^ ((crc & 0x1) ? 0xEDB88320u : 0);
+        }
+        table[byte] = crc;
+      }
+      ready = kTRUE;
+    }
+    return table;
+  }
+}
+
+UInt_t AlpideFormat::crc32(const UChar_t *data, size_t size) {
+  const UInt_t *table = crcTable();
+  UInt_t crc = 0xFFFFFFFFu;
+  for(size_t i = 0; i < size; ++i) {
+    crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
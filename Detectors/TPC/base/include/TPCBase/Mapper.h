@@ -27,7 +27,7 @@ public:
   const PadCentre&  padCentre (GlobalPadNumber padNumber) const { return mMapGlobalPadCentre  [padNumber%mPadsInSector]; }
   const FECInfo&    fecInfo   (GlobalPadNumber padNumber) const { return mMapGlobalPadFECInfo [padNumber%mPadsInSector]; }
 
-  const GlobalPadNumber globalPadNumber(const PadPos& padPosition) const { return mMapPadPosGlobalPad.find(padPosition)->second; }
+  const GlobalPadNumber globalPadNumber(const PadPos& padPosition) const { return mMapRowPadToGlobalPad[(static_cast<size_t>(padPosition.getRow())<<8) + padPosition.getPad()]; }
 
   const PadRegionInfo& getPadRegionInfo(const unsigned char region) const { return mMapPadRegionInfo[region]; }
 
@@ -70,7 +70,7 @@ static LocalPosition3D GlobalToLocal(const GlobalPosition3D& pos, const double a
 }
 
 private:
-  Mapper() : mMapGlobalPadToPadPos(mPadsInSector),  mMapGlobalPadCentre(mPadsInSector), mMapPadPosGlobalPad(), mMapGlobalPadFECInfo(mPadsInSector), mMapPadRegionInfo(10) {load();}
+  Mapper() : mMapGlobalPadToPadPos(mPadsInSector),  mMapGlobalPadCentre(mPadsInSector), mMapPadPosGlobalPad(), mMapRowPadToGlobalPad(256*256), mMapGlobalPadFECInfo(mPadsInSector), mMapPadRegionInfo(10) {load();}
   // use old c++03 due to root
   Mapper(const Mapper&) {}
   void operator=(const Mapper&) {}
@@ -89,7 +89,8 @@ private:
   // ===| Pad Mappings |========================================================
   std::vector<PadPos>               mMapGlobalPadToPadPos; /// mapping of global pad number to row and pad
   std::vector<PadCentre>            mMapGlobalPadCentre;   /// pad coordinates
-  std::map<PadPos, GlobalPadNumber> mMapPadPosGlobalPad;   /// mapping pad position to global pad number, most probably needs to be changed to speed up
+  std::map<PadPos, GlobalPadNumber> mMapPadPosGlobalPad;   /// mapping pad position to global pad number, kept for slow consumers
+  std::vector<GlobalPadNumber>      mMapRowPadToGlobalPad; /// flat mapping (row<<8)+pad to global pad number for the hot lookup path
   std::vector<FECInfo>              mMapGlobalPadFECInfo;  /// map global pad number to FEC info
 
   // ===| Pad region mappings |=================================================
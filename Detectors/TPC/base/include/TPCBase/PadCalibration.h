@@ -0,0 +1,79 @@
+#ifndef AliceO2_TPC_PadCalibration_H
+#define AliceO2_TPC_PadCalibration_H
+
+#include <cstddef>
+#include <vector>
+
+#include "TPCBase/CRU.h"
+#include "TPCBase/Defs.h"
+
+namespace AliceO2 {
+namespace TPC {
+
+/// Per-pad calibration constants with a fused application kernel.
+/// The pedestals and gains of each CRU are stored in pad-index order
+/// (rowOffset[row] + pad, the order of the flat digit charge planes), so
+/// applying them is one contiguous sweep per time bin: pedestal
+/// subtraction, gain multiplication and the zero-suppression threshold are
+/// fused into a single pass over the charge array and the constants stream
+/// along with it. This is the pattern every per-pad correction stage is
+/// expected to follow.
+class PadCalibration {
+public:
+  PadCalibration() : mPedestal(CRU::MaxCRU), mGain(CRU::MaxCRU), mThreshold(0.f) {}
+
+  /// set the constants of one CRU, values in pad-index order;
+  /// both vectors must have one entry per pad of the CRU
+  void setCRUCalib(int cru, const std::vector<float>& pedestals, const std::vector<float>& gains);
+
+  /// fill every CRU with neutral constants (pedestal 0, gain 1),
+  /// sized from the pad-plane mapping
+  void initDefaults();
+
+  void setThreshold(float threshold) { mThreshold = threshold; }
+  float getThreshold() const { return mThreshold; }
+
+  float getPedestal(int cru, int padIndex) const { return mPedestal[cru][padIndex]; }
+  float getGain(int cru, int padIndex) const { return mGain[cru][padIndex]; }
+
+  /// number of pads the CRU constants were set for, 0 while unset
+  int getPadsPerCRU(int cru) const { return int(mPedestal[cru].size()); }
+
+  /// fused calibration kernel over the charge plane of one CRU:
+  /// charge = (charge - pedestal) * gain, zeroed below the threshold.
+  /// The plane is indexed by timeBin*padsPerCRU + padIndex (the layout of
+  /// the flat digit containers); size may cover any number of time bins
+  void applyPlane(int cru, float* charges, std::size_t size) const;
+
+private:
+  std::vector<std::vector<float>> mPedestal; /// per-CRU pedestals in pad-index order
+  std::vector<std::vector<float>> mGain;     /// per-CRU gains in pad-index order
+  float mThreshold{0.f};                     /// zero-suppression threshold after correction
+};
+
+inline
+void PadCalibration::applyPlane(int cru, float* charges, std::size_t size) const
+{
+  const std::vector<float>& pedestal = mPedestal[cru];
+  const std::vector<float>& gain = mGain[cru];
+  const std::size_t pads = pedestal.size();
+  if (pads == 0 || size < pads) return;
+  const float threshold = mThreshold;
+  // one fused sweep per time bin: the constants are in pad-index order, so
+  // the inner loop walks the plane and both constant arrays contiguously
+  // and vectorizes without gathers
+  for (std::size_t first = 0; first + pads <= size; first += pads) {
+    float* charge = charges + first;
+    const float* ped = pedestal.data();
+    const float* g = gain.data();
+    for (std::size_t i = 0; i < pads; ++i) {
+      const float value = (charge[i] - ped[i]) * g[i];
+      charge[i] = value > threshold ? value : 0.f;
+    }
+  }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,64 @@
+/// \file bench_MapperLookup.cxx
+/// \brief Benchmark for the per-digit Mapper lookup paths
+///
+/// Measures lookups/second of the hot Mapper accessors (globalPadNumber,
+/// padPos, fecInfo) so regressions in the per-digit translation path show
+/// up in absolute numbers.
+
+#include "TPCBase/Mapper.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace AliceO2::TPC;
+
+namespace {
+  double lookupsPerSecond(size_t nLookups, std::chrono::high_resolution_clock::time_point start)
+  {
+    const auto stop = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(stop-start).count();
+    return nLookups/seconds;
+  }
+}
+
+int main()
+{
+  const Mapper& mapper = Mapper::instance();
+  const size_t nLookups = 100000000;
+
+  // pre-generate the query keys so the loops measure only the lookups
+  std::vector<GlobalPadNumber> padNumbers(Mapper::getPadsInSector());
+  std::vector<PadPos> padPositions(Mapper::getPadsInSector());
+  for (GlobalPadNumber pad = 0; pad < Mapper::getPadsInSector(); ++pad) {
+    padNumbers[pad] = pad;
+    padPositions[pad] = mapper.padPos(pad);
+  }
+
+  // ===| globalPadNumber |=====================================================
+  unsigned long long checksum = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < nLookups; ++i) {
+    checksum += mapper.globalPadNumber(padPositions[i%padPositions.size()]);
+  }
+  printf("globalPadNumber: %10.3e lookups/s\n", lookupsPerSecond(nLookups, start));
+
+  // ===| padPos |==============================================================
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < nLookups; ++i) {
+    checksum += mapper.padPos(padNumbers[i%padNumbers.size()]).getRow();
+  }
+  printf("padPos:          %10.3e lookups/s\n", lookupsPerSecond(nLookups, start));
+
+  // ===| fecInfo |=============================================================
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < nLookups; ++i) {
+    checksum += mapper.fecInfo(padNumbers[i%padNumbers.size()]).getIndex();
+  }
+  printf("fecInfo:         %10.3e lookups/s\n", lookupsPerSecond(nLookups, start));
+
+  // keep the loops observable so they are not optimized away
+  printf("checksum: %llu\n", checksum);
+
+  return 0;
+}
@@ -89,6 +89,7 @@ bool Mapper::readMappingFile(std::string file)
 
       mMapGlobalPadToPadPos[padIndex]         = PadPos(padRow,pad);
       mMapPadPosGlobalPad[PadPos(padRow,pad)] = padIndex;
+      mMapRowPadToGlobalPad[(padRow<<8)+pad]  = padIndex;
       mMapGlobalPadFECInfo[padIndex]          = FECInfo(fecIndex, fecConnector, fecChannel, sampaChip, sampaChannel);
       mMapGlobalPadCentre[padIndex]           = PadCentre(localX, localY);
 
@@ -0,0 +1,27 @@
+#include "TPCBase/PadCalibration.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/PadRegionInfo.h"
+
+namespace AliceO2 {
+namespace TPC {
+
+void PadCalibration::setCRUCalib(int cru, const std::vector<float>& pedestals, const std::vector<float>& gains)
+{
+  if (pedestals.size() != gains.size()) return;
+  mPedestal[cru] = pedestals;
+  mGain[cru] = gains;
+}
+
+void PadCalibration::initDefaults()
+{
+  const Mapper& mapper = Mapper::instance();
+  for (int cru = 0; cru < CRU::MaxCRU; ++cru) {
+    const PadRegionInfo& region = mapper.getPadRegionInfo(CRU(cru).region());
+    const int pads = region.getNumberOfPads();
+    mPedestal[cru].assign(pads, 0.f);
+    mGain[cru].assign(pads, 1.f);
+  }
+}
+
+}
+}
@@ -14,6 +14,7 @@
 #pragma link C++ class AliceO2::TPC::DigitPos;
 #pragma link C++ class AliceO2::TPC::FECInfo;
 #pragma link C++ class AliceO2::TPC::Mapper;
+#pragma link C++ class AliceO2::TPC::PadCalibration;
 #pragma link C++ class AliceO2::TPC::PadCentre;
 #pragma link C++ class AliceO2::TPC::PadInfo;
 #pragma link C++ class AliceO2::TPC::PadPos;
@@ -0,0 +1,70 @@
+/// \file RawDecoder.h
+/// \brief Decoder turning CRU-link raw payloads back into TPC digits
+#ifndef ALICEO2_TPC_RawDecoder_H_
+#define ALICEO2_TPC_RawDecoder_H_
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace TPC {
+
+    class PackedDigit;
+
+    /// \class RawDecoder
+    /// \brief Decoder unpacking per-link raw payloads into TPC digits
+    ///
+    /// The inverse of the RawEncoder: the constructor builds a flat
+    /// (FEC, channel) to pad table from the Mapper, so decoding a sample is
+    /// one table lookup and a few shifts. The buffer is scanned once for
+    /// the payload boundaries and the payloads are then decoded concurrently
+    /// on a pool of worker threads, each writing into its precomputed slice
+    /// of the output.
+
+    class RawDecoder {
+    public:
+      /// Constructor, builds the channel-to-pad table from the Mapper
+      RawDecoder();
+
+      /// Set the number of worker threads used by decode
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by decode
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Decode a raw buffer into packed digits appended to the output
+      /// Truncated or version-mismatched payloads stop the scan with an
+      /// error; samples on unmapped channels decode to empty digits and are
+      /// counted in getNumberOfUnmappedChannels().
+      /// @param raw Buffer with link payloads
+      /// @param size Size of the buffer in bytes
+      /// @param digits Output the decoded digits are appended to
+      /// @return Number of digits decoded
+      size_t decode(const UChar_t *raw, size_t size, std::vector<PackedDigit> &digits);
+
+      /// Decode a raw buffer into a TClonesArray of digits
+      /// @param raw Buffer with link payloads
+      /// @param size Size of the buffer in bytes
+      /// @param digits Output array the decoded digits are added to
+      /// @return Number of digits decoded
+      size_t decode(const UChar_t *raw, size_t size, TClonesArray *digits);
+
+      /// Get the number of samples on unmapped channels in the last decode
+      /// @return Number of unmapped samples
+      size_t getNumberOfUnmappedChannels() const {return mUnmappedChannels;}
+
+    private:
+      Int_t                 mNumThreads;        ///< number of worker threads used by decode
+      size_t                mUnmappedChannels;  ///< unmapped samples in the last decode
+      std::vector<UShort_t> mChannelToPad;      ///< (FEC index << 8 | channel) to sector (row << 8 | pad), 0xffff if unmapped
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,52 @@
+/// \file RawEncoder.h
+/// \brief Encoder producing CRU-link raw payloads from TPC digits
+#ifndef ALICEO2_TPC_RawEncoder_H_
+#define ALICEO2_TPC_RawEncoder_H_
+
+#include "Rtypes.h"
+
+#include <cstddef>
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class RawEncoder
+    /// \brief Encoder packing TPC digits into per-link raw payloads
+    ///
+    /// The digits are mapped to their front-end channels through the Mapper
+    /// and grouped into one payload per (CRU, FEC) link, each a LinkHeader
+    /// followed by one sample word per digit (see RawFormat.h). The payload
+    /// offsets are precomputed from the per-link counts, so the links are
+    /// encoded concurrently on a pool of worker threads, each writing
+    /// directly into its slice of the output buffer.
+
+    class RawEncoder {
+    public:
+      RawEncoder();
+
+      /// Set the number of worker threads used by encode
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by encode
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Encode digits into link payloads appended to a raw buffer
+      /// Digits of the same link keep their container order, so the time
+      /// ordering within a channel survives the round trip.
+      /// @param digits Container with TPC digits
+      /// @param raw Buffer the payloads are appended to
+      /// @return Number of bytes appended
+      size_t encode(TClonesArray *digits, std::vector<UChar_t> &raw);
+
+    private:
+      Int_t mNumThreads;  ///< number of worker threads used by encode
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,67 @@
+/// \file RawFormat.h
+/// \brief Link payload format of the TPC raw data
+#ifndef ALICEO2_TPC_RawFormat_H_
+#define ALICEO2_TPC_RawFormat_H_
+
+#include "Rtypes.h"
+
+namespace AliceO2 {
+  namespace TPC {
+    namespace RawFormat {
+
+      /// \struct LinkHeader
+      /// \brief Header of one CRU-link payload
+      ///
+      /// A raw buffer is a sequence of link payloads, each a LinkHeader
+      /// followed by nWords sample words. The link is identified by the CRU
+      /// and the FEC index within the sector.
+      struct LinkHeader {
+        UShort_t cru;      ///< CRU the link belongs to
+        UChar_t  link;     ///< FEC index of the link within the sector
+        UChar_t  version;  ///< format version
+        UInt_t   nWords;   ///< number of sample words following the header
+      };
+
+      static_assert(sizeof(LinkHeader) == 8, "the link header must stay one 64-bit word");
+
+      /// format version written by the encoder
+      const UChar_t kVersion = 1;
+
+      /// One 32-bit word per sample: channel (8 bits, SAMPA chip times 32
+      /// plus SAMPA channel), time bin (14 bits) and ADC value (10 bits,
+      /// the full front-end range). Time bins beyond the 14-bit range
+      /// saturate at kTimeBinMax.
+      enum {
+        kAdcBits     = 10,
+        kTimeBits    = 14,
+        kChannelBits = 8,
+        kAdcMax      = (1 << kAdcBits) - 1,
+        kTimeBinMax  = (1 << kTimeBits) - 1,
+        kChannelMax  = (1 << kChannelBits) - 1
+      };
+
+      /// Pack one sample into a word
+      /// @param channel Channel of the sample on the link
+      /// @param timeBin Time bin of the sample
+      /// @param adc ADC value of the sample
+      /// @return Packed sample word
+      inline UInt_t packWord(UInt_t channel, UInt_t timeBin, UInt_t adc) {
+        if(timeBin > kTimeBinMax) timeBin = kTimeBinMax;
+        if(adc > kAdcMax) adc = kAdcMax;
+        return (channel << (kTimeBits + kAdcBits)) | (timeBin << kAdcBits) | adc;
+      }
+
+      /// Get the channel of a sample word
+      inline UInt_t channelOfWord(UInt_t word) { return word >> (kTimeBits + kAdcBits); }
+
+      /// Get the time bin of a sample word
+      inline UInt_t timeBinOfWord(UInt_t word) { return (word >> kAdcBits) & kTimeBinMax; }
+
+      /// Get the ADC value of a sample word
+      inline UInt_t adcOfWord(UInt_t word) { return word & kAdcMax; }
+
+    }
+  }
+}
+
+#endif
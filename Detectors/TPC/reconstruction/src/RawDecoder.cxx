@@ -0,0 +1,139 @@
+/// \file RawDecoder.cxx
+/// \brief Decoder turning CRU-link raw payloads back into TPC digits
+#include "TPCReconstruction/RawDecoder.h"
+#include "TPCReconstruction/RawFormat.h"
+
+#include "TPCBase/CRU.h"
+#include "TPCBase/Mapper.h"
+#include "TPCSimulation/PackedDigit.h"
+
+#include "TClonesArray.h"
+#include "FairLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace AliceO2::TPC;
+
+namespace {
+  /// one payload located by the scan pass
+  struct PayloadRange {
+    RawFormat::LinkHeader header;  ///< header of the payload
+    size_t wordOffset;             ///< byte offset of the first sample word
+    size_t digitOffset;            ///< index of the first decoded digit in the output
+  };
+}
+
+RawDecoder::RawDecoder() :
+mNumThreads(1),
+mUnmappedChannels(0),
+mChannelToPad(256*256, 0xffff)
+{
+  // invert the pad-to-FEC mapping once; the table is indexed with
+  // (FEC index << 8 | channel) and holds the sector (row << 8 | pad)
+  const Mapper &mapper = Mapper::instance();
+  for(GlobalPadNumber iPad = 0; iPad < Mapper::getPadsInSector(); ++iPad) {
+    const FECInfo &fec = mapper.fecInfo(iPad);
+    const PadPos &pos = mapper.padPos(iPad);
+    const UInt_t key = (static_cast<UInt_t>(fec.getIndex()) << 8)
+                     | (fec.getSampaChip()*32 + fec.getSampaChannel());
+    mChannelToPad[key] = (static_cast<UShort_t>(pos.getRow()) << 8) | pos.getPad();
+  }
+}
+
+size_t RawDecoder::decode(const UChar_t *raw, size_t size, std::vector<PackedDigit> &digits) {
+  const Mapper &mapper = Mapper::instance();
+  mUnmappedChannels = 0;
+
+  // scan the buffer once for the payload boundaries and the output offsets
+  std::vector<PayloadRange> payloads;
+  size_t numOfDigits = 0;
+  size_t offset = 0;
+  while(offset < size) {
+    if(offset + sizeof(RawFormat::LinkHeader) > size) {
+      LOG(ERROR) << "Truncated link header at byte " << offset << ", stopping the decoding" << FairLogger::endl;
+      return 0;
+    }
+    PayloadRange payload;
+    std::memcpy(&payload.header, raw + offset, sizeof(RawFormat::LinkHeader));
+    offset += sizeof(RawFormat::LinkHeader);
+    if(payload.header.version != RawFormat::kVersion) {
+      LOG(ERROR) << "Unsupported raw format version " << static_cast<Int_t>(payload.header.version)
+                 << ", stopping the decoding" << FairLogger::endl;
+      return 0;
+    }
+    if(offset + payload.header.nWords*sizeof(UInt_t) > size) {
+      LOG(ERROR) << "Truncated link payload at byte " << offset << ", stopping the decoding" << FairLogger::endl;
+      return 0;
+    }
+    payload.wordOffset = offset;
+    payload.digitOffset = numOfDigits;
+    payloads.emplace_back(payload);
+    numOfDigits += payload.header.nWords;
+    offset += payload.header.nWords*sizeof(UInt_t);
+  }
+
+  const size_t base = digits.size();
+  digits.resize(base + numOfDigits);
+
+  // decode the payloads concurrently, each worker writing into its
+  // precomputed slice of the output
+  std::atomic<size_t> unmapped(0);
+  auto decodePayload = [&](const PayloadRange &payload) {
+    const CRU cru(payload.header.cru);
+    const Int_t rowOffset = mapper.getPadRegionInfo(cru.region()).getGlobalRowOffset();
+    size_t unmappedLocal = 0;
+    for(UInt_t iWord = 0; iWord < payload.header.nWords; ++iWord) {
+      UInt_t word;
+      std::memcpy(&word, raw + payload.wordOffset + iWord*sizeof(UInt_t), sizeof(UInt_t));
+      const UInt_t key = (static_cast<UInt_t>(payload.header.link) << 8) | RawFormat::channelOfWord(word);
+      const UShort_t pad = mChannelToPad[key];
+      PackedDigit &digit = digits[base + payload.digitOffset + iWord];
+      if(pad == 0xffff) {
+        // unmapped channel, leave the empty digit in place to keep the
+        // precomputed offsets valid
+        digit = PackedDigit();
+        ++unmappedLocal;
+        continue;
+      }
+      digit = PackedDigit(payload.header.cru, RawFormat::adcOfWord(word),
+                          (pad >> 8) - rowOffset, pad & 0xff, RawFormat::timeBinOfWord(word));
+    }
+    if(unmappedLocal > 0) unmapped += unmappedLocal;
+  };
+
+  const Int_t numThreads = std::min(mNumThreads, static_cast<Int_t>(payloads.size()));
+  if(numThreads > 1) {
+    std::vector<std::thread> workers;
+    for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+      workers.emplace_back([&, iThread]() {
+        for(size_t iPayload = iThread; iPayload < payloads.size(); iPayload += numThreads) {
+          decodePayload(payloads[iPayload]);
+        }
+      });
+    }
+    for(auto &worker : workers) worker.join();
+  }
+  else {
+    for(const auto &payload : payloads) decodePayload(payload);
+  }
+
+  mUnmappedChannels = unmapped;
+  if(mUnmappedChannels > 0) {
+    LOG(WARNING) << mUnmappedChannels << " samples on unmapped channels decoded to empty digits" << FairLogger::endl;
+  }
+  return numOfDigits;
+}
+
+size_t RawDecoder::decode(const UChar_t *raw, size_t size, TClonesArray *digits) {
+  std::vector<PackedDigit> packed;
+  const size_t numOfDigits = decode(raw, size, packed);
+
+  TClonesArray &clref = *digits;
+  for(const auto &digit : packed) {
+    new(clref[clref.GetEntriesFast()]) Digit(digit.unpack());
+  }
+  return numOfDigits;
+}
@@ -0,0 +1,128 @@
+/// \file RawEncoder.cxx
+/// \brief Encoder producing CRU-link raw payloads from TPC digits
+#include "TPCReconstruction/RawEncoder.h"
+#include "TPCReconstruction/RawFormat.h"
+
+#include "TPCBase/CRU.h"
+#include "TPCBase/Mapper.h"
+#include "TPCSimulation/Digit.h"
+
+#include "TClonesArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+using namespace AliceO2::TPC;
+
+namespace {
+  /// payload of one link in the output buffer
+  struct LinkRange {
+    UInt_t key;     ///< cru << 8 | FEC index
+    size_t first;   ///< first entry of the link in the sorted digit list
+    size_t count;   ///< number of digits on the link
+    size_t offset;  ///< byte offset of the payload in the appended output
+  };
+}
+
+RawEncoder::RawEncoder() :
+mNumThreads(1)
+{}
+
+size_t RawEncoder::encode(TClonesArray *digits, std::vector<UChar_t> &raw) {
+  const Mapper &mapper = Mapper::instance();
+  const Int_t numOfDigits = digits->GetEntriesFast();
+  if(numOfDigits == 0) return 0;
+
+  // map every digit to its link and pack its sample word; the expensive
+  // channel mapping runs on the worker pool over contiguous digit blocks,
+  // so the order within each block is preserved
+  std::vector<std::pair<UInt_t, UInt_t>> samples(numOfDigits);  // (link key, sample word)
+  const Int_t numThreads = std::min(mNumThreads, numOfDigits);
+
+  auto mapBlock = [&](Int_t first, Int_t last) {
+    for(Int_t iDigit = first; iDigit < last; ++iDigit) {
+      const Digit *digit = static_cast<const Digit*>(digits->UncheckedAt(iDigit));
+      const CRU cru(digit->getCRU());
+      const PadRegionInfo &region = mapper.getPadRegionInfo(cru.region());
+      const PadPos pad(region.getGlobalRowOffset() + digit->getRow(), digit->getPad());
+      const FECInfo &fec = mapper.fecInfo(mapper.globalPadNumber(pad));
+      const UInt_t channel = fec.getSampaChip()*32 + fec.getSampaChannel();
+      samples[iDigit].first = (static_cast<UInt_t>(digit->getCRU()) << 8) | fec.getIndex();
+      samples[iDigit].second = RawFormat::packWord(channel, digit->getTimeStamp(),
+                                                   static_cast<UInt_t>(digit->getCharge()));
+    }
+  };
+
+  if(numThreads > 1) {
+    std::vector<std::thread> workers;
+    const Int_t blockSize = (numOfDigits + numThreads - 1)/numThreads;
+    for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+      const Int_t first = iThread*blockSize;
+      const Int_t last = std::min(first + blockSize, numOfDigits);
+      workers.emplace_back(mapBlock, first, last);
+    }
+    for(auto &worker : workers) worker.join();
+  }
+  else {
+    mapBlock(0, numOfDigits);
+  }
+
+  // group the sample words by link with a counting scatter over the bounded
+  // key space; placing the samples in ascending order keeps the container
+  // order within each link, like a stable sort but in linear time
+  const UInt_t maxKeys = static_cast<UInt_t>(CRU::MaxCRU) << 8;
+  std::vector<UInt_t> counts(maxKeys, 0);
+  for(const auto &sample : samples) ++counts[sample.first];
+
+  std::vector<LinkRange> links;
+  std::vector<size_t> linkStart(maxKeys);
+  size_t bytes = 0;
+  size_t first = 0;
+  for(UInt_t key = 0; key < maxKeys; ++key) {
+    if(counts[key] == 0) continue;
+    links.emplace_back(LinkRange{key, first, counts[key], bytes});
+    linkStart[key] = first;
+    first += counts[key];
+    bytes += sizeof(RawFormat::LinkHeader) + counts[key]*sizeof(UInt_t);
+  }
+
+  std::vector<UInt_t> sortedWords(numOfDigits);
+  for(const auto &sample : samples) sortedWords[linkStart[sample.first]++] = sample.second;
+
+  const size_t base = raw.size();
+  raw.resize(base + bytes);
+
+  // encode the links concurrently, each worker writing its links' payloads
+  // directly at their precomputed offsets
+  auto encodeLink = [&](const LinkRange &link) {
+    UChar_t *out = raw.data() + base + link.offset;
+    RawFormat::LinkHeader header;
+    header.cru = link.key >> 8;
+    header.link = link.key & 0xff;
+    header.version = RawFormat::kVersion;
+    header.nWords = link.count;
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, sortedWords.data() + link.first, link.count*sizeof(UInt_t));
+  };
+
+  const Int_t numLinkThreads = std::min(mNumThreads, static_cast<Int_t>(links.size()));
+  if(numLinkThreads > 1) {
+    std::vector<std::thread> workers;
+    for(Int_t iThread = 0; iThread < numLinkThreads; ++iThread) {
+      workers.emplace_back([&, iThread]() {
+        for(size_t iLink = iThread; iLink < links.size(); iLink += numLinkThreads) {
+          encodeLink(links[iLink]);
+        }
+      });
+    }
+    for(auto &worker : workers) worker.join();
+  }
+  else {
+    for(const auto &link : links) encodeLink(link);
+  }
+
+  return bytes;
+}
@@ -4,6 +4,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
-
+#pragma link C++ class AliceO2::TPC::RawEncoder+;
+#pragma link C++ class AliceO2::TPC::RawDecoder+;
 
 #endif
@@ -0,0 +1,84 @@
+/// \file BackgroundEventCache.h
+/// \brief Shared in-memory cache of background events for embedding
+#ifndef _ALICEO2_TPC_BackgroundEventCache_
+#define _ALICEO2_TPC_BackgroundEventCache_
+
+#include "Rtypes.h"
+#include "TPCSimulation/PointCache.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class BackgroundEventCache
+    /// \brief Process-wide cache of background point sets for embedding
+    ///
+    /// The point sets of all events of a background sample are read once
+    /// and kept in memory as plain PointData vectors, so an embedding run
+    /// overlays the same background into many signal digitizations without
+    /// re-reading the file per signal event. Every event is held through a
+    /// shared pointer: acquireEvent hands out additional owners, so
+    /// concurrent digitizations can keep working on an event while the
+    /// cache itself is cleared or reloaded - the storage goes away with
+    /// the last owner. Loading the same file again is a no-op, all tasks
+    /// of a process share one resident copy.
+
+    class BackgroundEventCache {
+    public:
+
+      /// A cached event: shared ownership of an immutable point set
+      typedef std::shared_ptr<const std::vector<PointData>> Event;
+
+      /// Access to the cache shared between the tasks of the process
+      /// @return The cache instance
+      static BackgroundEventCache& instance() {
+        static BackgroundEventCache cache;
+        return cache;
+      }
+
+      /// Load all events of a background sample, once per process
+      /// @param filename Name of the background file
+      /// @param branchName Name of the point branch
+      /// @return Number of resident events, negative on failure
+      Int_t loadFile(const char *filename, const char *branchName = "TPCPoint");
+
+      /// Drop the cache; events still acquired by running digitizations
+      /// stay alive through their shared ownership
+      void clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEvents.clear();
+        mLoadedFile.clear();
+      }
+
+      /// Number of resident events
+      Int_t getNumberOfEvents() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEvents.size();
+      }
+
+      /// Acquire shared ownership of one event, thread safe
+      /// @param index Event index, wraps around at the number of events
+      /// @return The event, empty if the cache is not loaded
+      Event acquireEvent(ULong64_t index) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mEvents.empty()) return Event();
+        return mEvents[index % mEvents.size()];
+      }
+
+    private:
+      BackgroundEventCache() : mMutex(), mLoadedFile(), mEvents() {}
+      BackgroundEventCache(const BackgroundEventCache &);
+      void operator=(const BackgroundEventCache &);
+
+      mutable std::mutex mMutex; /// protects the event table
+      std::string        mLoadedFile; /// file currently resident
+      std::vector<Event> mEvents; /// point sets of the background events
+    };
+
+  }
+}
+
+#endif
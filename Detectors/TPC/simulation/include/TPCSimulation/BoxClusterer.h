@@ -3,71 +3,160 @@
 #ifndef ALICEO2_TPC_BoxClusterer_H_
 #define ALICEO2_TPC_BoxClusterer_H_
 
+#include "TPCSimulation/DigitContainerTiled.h"
+
 #include "Rtypes.h"
 #include "TObject.h"
 
+#include <vector>
+
 class TClonesArray;
 
 namespace AliceO2{
-  
+
   namespace TPC {
-    
+
     class ClusterContainer;
-    
+    class ClusterContainerFlat;
+
     class BoxClusterer : public TObject {
     public:
       BoxClusterer();
-      
+
       /// Destructor
       ~BoxClusterer();
-      
+
       // Should this really be a public member?
       // Maybe better to just call by process
       void Init();
-      
+
       /// Steer conversion of points to digits
       /// @param digits Container with TPC digits
       /// @return Container with clusters
       ClusterContainer* Process(TClonesArray *digits);
-      
+
+      /// Steer conversion of tiled digits to clusters; only the occupied
+      /// tiles of the container are expanded into the work arrays, so the
+      /// empty regions of the pad-time planes are skipped wholesale
+      /// @param digits Tiled container with TPC digits
+      /// @return Container with clusters
+      ClusterContainer* Process(DigitContainerTiled *digits);
+
+      /// Set the number of worker threads used by Process
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by Process
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Additionally fill the found clusters into a flat container; the
+      /// container is not owned and is reset at the start of each Process
+      /// @param container Flat cluster store, nullptr disables the filling
+      void setFlatContainer(ClusterContainerFlat *container) {mFlatContainer = container;}
+
     private:
       // To be done
       /* BoxClusterer(const BoxClusterer &); */
       /* BoxClusterer &operator=(const BoxClusterer &); */
-      
-      void FindLocalMaxima(const Int_t iCRU);
-      void CleanArrays();
+
+      /// \struct WorkArrays
+      /// \brief Expand arrays for the digits of one CRU
+      ///
+      /// The arrays are reusable scratch space: the signal lists grow on
+      /// demand with amortized reallocation, the touched rows are tracked
+      /// in a dirty list and clean() only resets the bins that were
+      /// touched, so the arrays can be recycled across CRUs, events and
+      /// worker threads without repeated allocation and without paying
+      /// full-matrix reset costs in low-occupancy events.
+      struct WorkArrays {
+        WorkArrays(Int_t rowsMax, Int_t padsMax, Int_t timeBinsMax);
+        ~WorkArrays();
+
+        /// Sparse reset of the bins touched since the last clean
+        void clean();
+
+        /// Record a signal bin, tracking the row as dirty on first touch
+        /// @param iRow Row of the signal
+        /// @param bin Expanded array bin of the signal
+        void addSignal(Int_t iRow, Int_t bin) {
+          if(sigBins[iRow].empty()) dirtyRows.emplace_back(iRow);
+          sigBins[iRow].emplace_back(bin);
+        }
+
+        Float_t** allBins;                     //!<! Array for digit using random access
+        std::vector<std::vector<Int_t>> sigBins; //!<! Per-row indexes over threshold, grown on demand
+        std::vector<Int_t> dirtyRows;          //!<! Rows with signal since the last clean
+        Int_t     rowsMax;      //!<! Maximum row number
+      };
+
+      /// \struct BoxClusterData
+      /// \brief Parameters of one found cluster, collected before container filling
+      struct BoxClusterData {
+        Int_t   cru;
+        Int_t   row;
+        Float_t qTot;
+        Float_t qMax;
+        Float_t meanP;
+        Float_t meanT;
+        Float_t sigmaP;
+        Float_t sigmaT;
+        Short_t pad;
+        Short_t timebin;
+        Short_t size;
+      };
+
+      /// Clustering of all digits of the CRUs on a pool of worker threads
+      /// @param digits Container with TPC digits
+      /// @return Container with clusters
+      ClusterContainer* ProcessParallel(TClonesArray *digits);
+
+      /// Clustering of the tiled digits of the CRUs on a pool of worker threads
+      /// @param digits Tiled container with TPC digits
+      /// @return Container with clusters
+      ClusterContainer* ProcessParallel(DigitContainerTiled *digits);
+
+      /// Expand the occupied tiles of one CRU into the work arrays,
+      /// converting the charges to ADC counts as in the digit output
+      /// @param tiles Occupied tiles of the CRU
+      /// @param work Expand arrays to fill
+      /// @return Number of accepted signals
+      Int_t ExpandTiles(const std::vector<DigitContainerTiled::Tile> &tiles,
+                        WorkArrays *work);
+
+      void FindLocalMaxima(const Int_t iCRU, WorkArrays *work,
+                           std::vector<BoxClusterData>& clusters);
       void GetPadAndTimeBin(Int_t bin, Short_t& iPad, Short_t& iTimeBin);
-      Int_t Update(const Int_t iCRU, const Int_t iRow, const Int_t iPad, 
-		   const Int_t iTimeBin, Float_t signal);
-      Float_t GetQ(const Float_t* adcArray, const Short_t time, 
-		   const Short_t pad, Short_t& timeMin, Short_t& timeMax, 
+      Int_t Update(WorkArrays *work, const Int_t iCRU, const Int_t iRow,
+		   const Int_t iPad, const Int_t iTimeBin, Float_t signal);
+      Float_t GetQ(const Float_t* adcArray, const Short_t time,
+		   const Short_t pad, Short_t& timeMin, Short_t& timeMax,
 		   Short_t& padMin, Short_t& padMax) const;
-      Bool_t UpdateCluster(Float_t charge, Int_t deltaPad, Int_t deltaTime, 
-			   Float_t& qTotal, Double_t& meanPad, 
-			   Double_t& sigmaPad, Double_t& meanTime, 
+      Bool_t UpdateCluster(Float_t charge, Int_t deltaPad, Int_t deltaTime,
+			   Float_t& qTotal, Double_t& meanPad,
+			   Double_t& sigmaPad, Double_t& meanTime,
 			   Double_t& sigmaTime);
-      
-      
+      void AddClustersToContainer(const std::vector<BoxClusterData>& clusters);
+
+
       ClusterContainer* mClusterContainer; ///< Internal cluster storage
-      
+      ClusterContainerFlat* mFlatContainer; ///< Optional flat cluster output, not owned
+
       Int_t mRowsMax;          //!<! Maximum row number
       Int_t mPadsMax;          //!<! Maximum pad number
       Int_t mTimeBinsMax;      //!<! Maximum time bin
       Float_t mMinQMax;        //|<| Minimun Qmax for cluster
       Bool_t  mRequirePositiveCharge;  //|<|If true, require charge > 0 (else all clusters are automatic 5x5)
       Bool_t  mRequireNeighbouringPad; //|<|If true, require 2+ pads minimum
-      //
-      //  Expand buffer
-      //
-      Float_t** mAllBins;      //!<! Array for digit using random access
-      Int_t**   mAllSigBins;   //!<! Array of pointers to the indexes over threshold
-      Int_t*    mAllNSigBins;  //!<! Array with number of signals in each row
-      
+      Int_t   mNumThreads;     //!<! Number of worker threads used by Process
+
+      WorkArrays* mWork;                     //!<! Expand arrays of the serial path
+      std::vector<WorkArrays*> mWorkPool;    //!<! Per-thread expand arrays of the parallel path
+
       ClassDef(BoxClusterer, 1);
     };
   }
 }
 
 
-#endif 
+#endif
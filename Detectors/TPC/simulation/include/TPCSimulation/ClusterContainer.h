@@ -42,7 +42,12 @@ namespace AliceO2 {
       void FillOutputContainer(TClonesArray *outputcont);
 
     private:
+      /// Report the container footprint to the memory accountant; no-op
+      /// unless accounting is enabled, see MemoryAccountant
+      void accountMemory();
+
       Int_t         mNclusters;        // number of clusters
+      Int_t         mMemoryScopeId;    // accounting scope, see accountMemory
       TClonesArray* mClusterArray;      // array for clusters
     };
   }
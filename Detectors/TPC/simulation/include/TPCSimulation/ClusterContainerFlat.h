@@ -0,0 +1,141 @@
+/// \file ClusterContainerFlat.h
+/// \brief Flat, contiguous container for the TPC clusters
+#ifndef _ALICEO2_TPC_ClusterContainerFlat_
+#define _ALICEO2_TPC_ClusterContainerFlat_
+
+#include "DataCompression/tpccluster_record.h"
+#include "Rtypes.h"
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class ClusterContainerFlat
+    /// \brief Flat cluster container class
+    ///
+    /// Replacement for the pointer-tree cluster output (container -> CRU ->
+    /// row -> cluster objects). All clusters live in one contiguous vector
+    /// of packed records, filled append-only, and a per-(CRU, row) offset
+    /// index exposes each pad row as a span into that vector. Downstream
+    /// track seeding iterates the clusters of a row as plain memory without
+    /// pointer indirection, and reset() only clears the touched index slots,
+    /// so it costs nothing on top of keeping the vector capacity.
+    /// sortClusters(), called at finalization, orders the store by
+    /// (CRU, row, pad); both the compression ratio and the seeding benefit
+    /// from the ordered walk.
+
+    class ClusterContainerFlat{
+    public:
+
+      /// \struct PackedCluster
+      /// \brief One cluster record in the flat store
+      ///
+      /// The cluster parameters live in a TPCClusterRecord, i.e. already
+      /// quantized to the bit widths of the compression model in
+      /// Utilities/DataCompression; encoding the store is a copy of the
+      /// integer fields and a decode-reencode cycle does not requantize.
+      /// The float accessors restore the fixed point values for the track
+      /// seeding, which sees exactly what a compression round trip would
+      /// deliver. The only lossy conversion happens here, once.
+      struct PackedCluster {
+        TPCClusterRecord record; ///< parameters at the model bit widths
+        Short_t padBin;          ///< pad of the center cell
+        Short_t timeBin;         ///< time bin of the center cell
+        Short_t size;            ///< box size, 10*nPads + nTimeBins
+
+        /// quantize the cluster parameters into the record
+        void setParameters(Short_t row, Float_t qTot, Float_t qMax,
+                           Float_t pad, Float_t time,
+                           Float_t sigmaPad, Float_t sigmaTime)
+        {
+          record.padrow = TPCClusterRecord::Pack(row, 0, TPCClusterWidth::kPadRow);
+          record.pad = TPCClusterRecord::Pack(pad, TPCClusterWidth::kPadFractionBits, TPCClusterWidth::kPad);
+          record.time = TPCClusterRecord::Pack(time, TPCClusterWidth::kTimeFractionBits, TPCClusterWidth::kTime);
+          record.sigmaY2 = TPCClusterRecord::Pack(sigmaPad, TPCClusterWidth::kSigmaFractionBits, TPCClusterWidth::kSigmaY2);
+          record.sigmaZ2 = TPCClusterRecord::Pack(sigmaTime, TPCClusterWidth::kSigmaFractionBits, TPCClusterWidth::kSigmaZ2);
+          record.charge = TPCClusterRecord::Pack(qTot, 0, TPCClusterWidth::kCharge);
+          record.qmax = TPCClusterRecord::Pack(qMax, 0, TPCClusterWidth::kQMax);
+        }
+
+        Int_t getRow() const { return record.padrow; }
+        Float_t getQTot() const { return record.charge; }
+        Float_t getQMax() const { return record.qmax; }
+        Float_t getPad() const { return TPCClusterRecord::Unpack(record.pad, TPCClusterWidth::kPadFractionBits); }
+        Float_t getTime() const { return TPCClusterRecord::Unpack(record.time, TPCClusterWidth::kTimeFractionBits); }
+        Float_t getSigmaPad() const { return TPCClusterRecord::Unpack(record.sigmaY2, TPCClusterWidth::kSigmaFractionBits); }
+        Float_t getSigmaTime() const { return TPCClusterRecord::Unpack(record.sigmaZ2, TPCClusterWidth::kSigmaFractionBits); }
+      };
+
+      /// Constructor
+      /// @param numOfCRUs Number of CRUs
+      /// @param rowsPerCRU Maximum number of pad rows of a CRU
+      ClusterContainerFlat(Int_t numOfCRUs, Int_t rowsPerCRU);
+
+      /// Destructor
+      ~ClusterContainerFlat();
+
+      /// Resets the container, keeping the allocated storage for reuse;
+      /// only the index slots touched since the last reset are cleared
+      void reset();
+
+      /// Append a cluster; the clusters of one (CRU, row) must be added
+      /// back to back, which the row-ordered cluster finder output satisfies
+      PackedCluster& addCluster(Int_t cru, Int_t row);
+
+      /// Total number of stored clusters
+      Int_t getNClusters() const { return static_cast<Int_t>(mClusters.size()); }
+
+      /// All clusters, in append order
+      const PackedCluster* getClusters() const { return mClusters.data(); }
+
+      /// Span of one pad row
+      /// @param cru CRU of the row
+      /// @param row Pad row
+      /// @param nclusters On output the number of clusters of the row
+      /// @return Pointer to the first cluster of the row, nullptr if empty
+      const PackedCluster* getRowClusters(Int_t cru, Int_t row, Int_t& nclusters) const;
+
+      /// Orders the store for the consumers: after the call the clusters of
+      /// every row are sorted by ascending pad key, and a linear walk over
+      /// getClusters() sees ascending (CRU, row). The per-row sort is a
+      /// stable two-pass radix sort over the packed records, parallel over
+      /// the filled rows; stability keeps the emission (time) order of
+      /// clusters on the same pad. To be called once at finalization, after
+      /// the last addCluster of the event.
+      void sortClusters(Int_t numOfThreads = 1);
+
+    private:
+      Int_t mRowsPerCRU;                    ///< pad rows per CRU, stride of the index
+      Int_t mLastSlice;                     ///< (CRU, row) slice the last cluster went to
+      std::vector<PackedCluster> mClusters; ///< all clusters, contiguous, grouped by (CRU, row)
+      std::vector<Int_t> mSliceStart;       ///< per-(CRU, row) offset of the first cluster, -1 if empty
+      std::vector<Int_t> mSliceSize;        ///< per-(CRU, row) number of clusters
+      std::vector<Int_t> mTouchedSlices;    ///< slices filled since the last reset
+    };
+
+    inline
+    ClusterContainerFlat::PackedCluster& ClusterContainerFlat::addCluster(Int_t cru, Int_t row)
+    {
+      const Int_t slice = cru*mRowsPerCRU + row;
+      if(slice != mLastSlice) {
+        mSliceStart[slice] = static_cast<Int_t>(mClusters.size());
+        mTouchedSlices.emplace_back(slice);
+        mLastSlice = slice;
+      }
+      ++mSliceSize[slice];
+      mClusters.emplace_back();
+      return mClusters.back();
+    }
+
+    inline
+    const ClusterContainerFlat::PackedCluster* ClusterContainerFlat::getRowClusters(Int_t cru, Int_t row, Int_t& nclusters) const
+    {
+      const Int_t slice = cru*mRowsPerCRU + row;
+      nclusters = mSliceSize[slice];
+      return nclusters > 0 ? &mClusters[mSliceStart[slice]] : nullptr;
+    }
+
+  }
+}
+
+#endif
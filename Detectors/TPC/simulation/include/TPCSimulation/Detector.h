@@ -2,6 +2,8 @@
 #define AliceO2_TPC_Detector_H_
 
 #include "DetectorsBase/Detector.h"   // for Detector
+#include "DetectorsBase/PointArena.h" // for PointArena
+#include "TPCSimulation/Point.h"      // for Point
 #include "Rtypes.h"          // for Int_t, Double32_t, Double_t, Bool_t, etc
 #include "TLorentzVector.h"  // for TLorentzVector
 #include "TVector3.h"        // for TVector3
@@ -80,6 +82,11 @@ class Detector: public AliceO2::Base::Detector {
                                Int_t offset) {;}
     virtual void   SetSpecialPhysicsCuts() {;}
     virtual void   EndOfEvent();
+
+    /// Copies the points accumulated in the arena into the registered
+    /// container; called before the output tree is filled
+    virtual void   FinishEvent();
+
     virtual void   FinishPrimary() {;}
     virtual void   FinishRun() {;}
     virtual void   BeginPrimary() {;}
@@ -117,6 +124,10 @@ class Detector: public AliceO2::Base::Detector {
     /** container for data points */
     TClonesArray*  mPointCollection;
 
+    /** arena the points are constructed into during the stepping; flushed
+        into mPointCollection once per event (see FinishEvent) */
+    Base::PointArena<Point> mPointArena; //!
+
     TString fGeoFileName;                  /// Name of the file containing the TPC geometry
 
     Detector(const Detector&);
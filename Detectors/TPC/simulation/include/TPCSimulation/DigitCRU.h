@@ -46,7 +46,21 @@ namespace AliceO2 {
       /// @param output Output container
       /// @param cruID CRU ID
       void fillOutputContainer(TClonesArray *output, Int_t cru);
-      
+
+      /// Get the time bin container
+      /// @return Time bin container
+      const std::vector<DigitTime*>& getTimeBins() {return mTimeBins;}
+
+      /// Fill output TClonesArray with all time bins before a given one and release them
+      /// @param output Output container
+      /// @param cru CRU ID
+      /// @param lastTimeBin First time bin that is kept
+      void fillCompletedTimeBins(TClonesArray *output, Int_t cru, Int_t lastTimeBin);
+
+      /// Get the memory footprint of the container
+      /// @return Allocated bytes over all time bins
+      size_t getMemoryUsage() const;
+
     private:
       UShort_t                 mCRU;
       Int_t                    mNTimeBins;
@@ -61,6 +75,16 @@ namespace AliceO2 {
         aTime->reset();
       }
     }
+
+    inline
+    size_t DigitCRU::getMemoryUsage() const {
+      size_t bytes = sizeof(*this) + mTimeBins.capacity() * sizeof(DigitTime*);
+      for(auto &aTime : mTimeBins) {
+        if(aTime == nullptr) continue;
+        bytes += aTime->getMemoryUsage();
+      }
+      return bytes;
+    }
     
     
   }
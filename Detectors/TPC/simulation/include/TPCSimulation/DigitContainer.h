@@ -13,7 +13,6 @@ class TClonesArray;
 namespace AliceO2 {
   namespace TPC {
     class Digit;
-    class DigitPad;
     class DigitRow;
     class DigitCRU;
     
@@ -38,13 +37,37 @@ namespace AliceO2 {
       /// @param timeBin Time bin of the digit
       /// @param charge Charge of the digit
       void addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Float_t charge);
-      
+
+      /// Merge the content of another container into this one
+      /// @param other Container to be merged, is not modified
+      void merge(DigitContainer *other);
+
+      /// Get the CRU container
+      /// @return CRU container
+      const std::vector<DigitCRU*>& getCRUs() {return mCRU;}
+
       /// Fill output TClonesArray
       /// @param outputcont Output container
       void fillOutputContainer(TClonesArray *output);
-      
+
+      /// Fill output TClonesArray with all time bins before a given one and release them
+      /// Used in continuous mode where completed time bins are emitted while
+      /// later ones are still being filled.
+      /// @param output Output container
+      /// @param lastTimeBin First time bin that is kept
+      void fillCompletedTimeBins(TClonesArray *output, Int_t lastTimeBin);
+
+      /// Get the memory footprint of the container
+      /// @return Allocated bytes over all CRUs
+      size_t getMemoryUsage() const;
+
     private:
+      /// Report the container footprint to the memory accountant; no-op
+      /// unless accounting is enabled, see MemoryAccountant
+      void accountMemory();
+
       UShort_t mNCRU;
+      Int_t mMemoryScopeId;          ///< Accounting scope, see accountMemory
       std::vector<DigitCRU*> mCRU;
     };
     
@@ -0,0 +1,107 @@
+/// \file DigitContainerFlat.h
+/// \brief Flat, arena-backed container for the CRU Digits
+#ifndef _ALICEO2_TPC_DigitContainerFlat_
+#define _ALICEO2_TPC_DigitContainerFlat_
+
+#include "TPCSimulation/Digit.h"
+#include "Rtypes.h"
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class DigitContainerFlat
+    /// \brief Flat digit container class
+    ///
+    /// Replacement for the pointer-tree DigitContainer (CRU -> time bin ->
+    /// row -> pad -> ADC). Each CRU owns a single contiguous charge plane
+    /// indexed by (timeBin, row, pad), grown in full drift-time chunks, so
+    /// charge accumulation is a single add into preallocated memory and no
+    /// per-digit heap allocations occur. Occupied bins are recorded on first
+    /// fill, which keeps the output loop proportional to the number of
+    /// digits instead of the container size.
+
+    class DigitContainerFlat{
+    public:
+
+      /// Default constructor
+      DigitContainerFlat();
+
+      /// Destructor
+      ~DigitContainerFlat();
+
+      /// Resets the container, keeping the allocated arenas for reuse
+      void reset();
+
+      /// Add digit to the container
+      /// @param cru CRU of the digit
+      /// @param timeBin Time bin of the digit
+      /// @param row Pad row of digit
+      /// @param pad Pad of digit
+      /// @param charge Charge of the digit
+      void addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Float_t charge);
+
+      /// Fill output TClonesArray
+      /// @param output Output container
+      void fillOutputContainer(TClonesArray *output);
+
+      /// Get the charge plane of a CRU, for in-place processing stages
+      /// @param cru CRU of the plane
+      /// @return Charge plane, indexed by timeBin*getPadsPerCRU(cru) + row offset + pad
+      std::vector<Float_t>& getChargeMap(Int_t cru) {return mChargeMap[cru];}
+
+      /// Get the linearized bins with signal of a CRU
+      /// @param cru CRU of the bins
+      /// @return Occupied bin list
+      const std::vector<Int_t>& getOccupiedBins(Int_t cru) const {return mOccupiedBins[cru];}
+
+      /// Get the linearized bins with signal of a CRU, for in-place
+      /// processing stages that fire additional bins
+      /// @param cru CRU of the bins
+      /// @return Occupied bin list
+      std::vector<Int_t>& getOccupiedBins(Int_t cru) {return mOccupiedBins[cru];}
+
+      /// Get the pad-row offsets of a CRU within one time bin of the plane
+      /// @param cru CRU of the offsets
+      /// @return Prefix sums of pads per row, empty while uninitialized
+      const std::vector<UShort_t>& getRowOffset(Int_t cru) const {return mRowOffset[cru];}
+
+      /// Get the number of pads of a CRU, the time-bin stride of the plane
+      /// @param cru CRU
+      /// @return Number of pads, 0 while uninitialized
+      Int_t getPadsPerCRU(Int_t cru) const {return mPadsPerCRU[cru];}
+
+    private:
+      /// Prepare the pad-row geometry and charge plane of a CRU
+      /// @param cru CRU to initialize
+      void initCRU(Int_t cru);
+
+      /// Number of time bins the charge planes grow by, one full drift time
+      static const Int_t mTimeBinChunk = 500;
+
+      std::vector<std::vector<Float_t>> mChargeMap;    /// per-CRU charge plane, indexed by timeBin*padsPerCRU + rowOffset[row] + pad
+      std::vector<std::vector<Int_t>>   mOccupiedBins; /// per-CRU list of linearized bins with signal
+      std::vector<std::vector<UShort_t>> mRowOffset;   /// per-CRU prefix sums of pads per row
+      std::vector<UShort_t>             mPadsPerCRU;   /// number of pads in each CRU, 0 while uninitialized
+    };
+
+    inline
+    void DigitContainerFlat::addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Float_t charge)
+    {
+      if(mPadsPerCRU[cru] == 0) initCRU(cru);
+      std::vector<Float_t> &chargePlane = mChargeMap[cru];
+      //if time bin outside specified range, the range of the plane is extended by one full drift time.
+      while(chargePlane.size() <= static_cast<size_t>(timeBin)*mPadsPerCRU[cru]) {
+        chargePlane.resize(chargePlane.size() + static_cast<size_t>(mTimeBinChunk)*mPadsPerCRU[cru], 0.f);
+      }
+      const Int_t bin = timeBin*mPadsPerCRU[cru] + mRowOffset[cru][row] + pad;
+      if(chargePlane[bin] == 0.f) mOccupiedBins[cru].emplace_back(bin);
+      chargePlane[bin] += charge;
+    }
+
+  }
+}
+
+#endif
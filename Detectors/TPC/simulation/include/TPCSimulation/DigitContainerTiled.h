@@ -0,0 +1,122 @@
+/// \file DigitContainerTiled.h
+/// \brief Tiled, pool-backed container for the CRU Digits
+#ifndef _ALICEO2_TPC_DigitContainerTiled_
+#define _ALICEO2_TPC_DigitContainerTiled_
+
+#include "Rtypes.h"
+#include <vector>
+
+class TClonesArray;
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class DigitContainerTiled
+    /// \brief Tiled digit container class
+    ///
+    /// Hybrid between the dense DigitContainerFlat and a sparse store, for
+    /// the low occupancies of the TPC: each pad row is covered by a grid of
+    /// 16x16 (time bin, pad) tiles, a tile is allocated from a shared pool
+    /// only on the first charge landing in it, and an occupancy bitmap per
+    /// row records which grid tiles exist. Charge accumulation keeps the
+    /// dense-array speed inside a tile, while empty regions of the
+    /// (pad, time) plane cost nothing but one bitmap bit. The occupied
+    /// tiles of a CRU can be iterated directly, so consumers like the
+    /// BoxClusterer skip empty tiles wholesale instead of scanning the
+    /// full plane.
+
+    class DigitContainerTiled{
+    public:
+
+      /// Tile edge length in pads and in time bins
+      static const Int_t mTileSize = 16;
+      /// Number of cells of one tile
+      static const Int_t mTileCells = mTileSize*mTileSize;
+
+      /// \struct Tile
+      /// \brief One occupied tile handed out by getOccupiedTiles
+      struct Tile {
+        Int_t row;            ///< pad row within the CRU
+        Int_t padOrigin;      ///< first pad covered by the tile
+        Int_t timeBinOrigin;  ///< first time bin covered by the tile
+        const Float_t *cells; ///< mTileCells charges, indexed by localTimeBin*mTileSize + localPad
+      };
+
+      /// Default constructor
+      DigitContainerTiled();
+
+      /// Destructor
+      ~DigitContainerTiled();
+
+      /// Resets the container, keeping the tile pool and the grids for reuse
+      void reset();
+
+      /// Add digit to the container
+      /// @param cru CRU of the digit
+      /// @param timeBin Time bin of the digit
+      /// @param row Pad row of digit
+      /// @param pad Pad of digit
+      /// @param charge Charge of the digit
+      void addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Float_t charge);
+
+      /// Fill output TClonesArray
+      /// @param output Output container
+      void fillOutputContainer(TClonesArray *output);
+
+      /// Collect the occupied tiles of a CRU, in row and grid order
+      /// @param cru CRU of the tiles
+      /// @param tiles Filled with the occupied tiles, cleared first
+      void getOccupiedTiles(Int_t cru, std::vector<Tile> &tiles) const;
+
+    private:
+      /// \struct RowGrid
+      /// \brief Tile grid of one pad row
+      struct RowGrid {
+        std::vector<Int_t>     tile;   ///< tile pool indexes, -1 while unallocated, indexed by timeBinTile*padTiles + padTile
+        std::vector<ULong64_t> bitmap; ///< occupancy bitmap, one bit per grid tile
+        UShort_t padTiles;             ///< number of tiles covering the pads of the row
+      };
+
+      /// Prepare the pad-row grids of a CRU
+      /// @param cru CRU to initialize
+      void initCRU(Int_t cru);
+
+      /// Number of time-bin tiles the grids grow by, about one full drift time
+      static const Int_t mTimeTileChunk = 32;
+      /// Number of tiles the pool grows by
+      static const Int_t mPoolChunk = 256;
+
+      std::vector<std::vector<RowGrid>> mRows; /// per-CRU, per-row tile grids, empty while uninitialized
+      std::vector<Float_t> mTilePool;          /// shared tile arena, mTileCells charges per tile
+      Int_t                mTilesUsed;         /// number of tiles allocated since the last reset
+    };
+
+    inline
+    void DigitContainerTiled::addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Float_t charge)
+    {
+      if(mRows[cru].empty()) initCRU(cru);
+      RowGrid &grid = mRows[cru][row];
+      const Int_t padTile = pad/mTileSize;
+      const Int_t timeBinTile = timeBin/mTileSize;
+      //if time bin outside specified range, the grid is extended by full drift times
+      while(grid.tile.size() <= static_cast<size_t>(timeBinTile)*grid.padTiles) {
+        grid.tile.resize(grid.tile.size() + static_cast<size_t>(mTimeTileChunk)*grid.padTiles, -1);
+        grid.bitmap.resize((grid.tile.size() + 63)/64, 0);
+      }
+      const Int_t gridBin = timeBinTile*grid.padTiles + padTile;
+      Int_t &tile = grid.tile[gridBin];
+      if(tile < 0) {
+        if(mTilePool.size() < static_cast<size_t>(mTilesUsed + 1)*mTileCells) {
+          mTilePool.resize(mTilePool.size() + static_cast<size_t>(mPoolChunk)*mTileCells, 0.f);
+        }
+        tile = mTilesUsed++;
+        grid.bitmap[gridBin/64] |= ULong64_t(1) << (gridBin%64);
+      }
+      mTilePool[static_cast<size_t>(tile)*mTileCells
+                + (timeBin%mTileSize)*mTileSize + pad%mTileSize] += charge;
+    }
+
+  }
+}
+
+#endif
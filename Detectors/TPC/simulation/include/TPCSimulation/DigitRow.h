@@ -4,64 +4,98 @@
 #define _ALICEO2_TPC_DigitRow_
 
 #include "Rtypes.h"
-#include "TPCSimulation/DigitPad.h"
+
+#include <algorithm>
+#include <vector>
 
 class TClonesArray;
 
 namespace AliceO2 {
   namespace TPC {
-    
+
     /// \class DigitRow
-    /// \brief Digit container class for the pad digits    
-    
+    /// \brief Digit container class for the pad digits
+    ///
+    /// The charge of a (pad, time) cell is accumulated in place: one float
+    /// per pad, updated additively for every electron, plus a list of the
+    /// pads fired since the last reset. This replaces the former per-electron
+    /// append into DigitPad/DigitADC objects, which multiplied the memory
+    /// traffic by the average number of electrons per cell before the sum
+    /// was taken anyway when the output was filled.
+
     class DigitRow{
     public:
-      
+
       /// Constructor
       /// @param mRow Row ID
       /// @param npads Number of pads in the row
       DigitRow(Int_t mRow, Int_t npads);
-      
+
       ///Destructor
       ~DigitRow();
-      
-      /// Resets the container
+
+      /// Resets the container, zeroing only the fired pads
       void reset();
-      
+
       /// Get the size of the container
       /// @return Size of the pad container
-      Int_t getSize() {return mPads.size();}
-      
+      Int_t getSize() {return mPadCharge.size();}
+
       /// Get the Row ID
       /// @return Row ID
       Int_t getRow() {return mRow;}
-      
+
       /// Add digit to the pad container
       /// @param pad Pad of the digit
       /// @param charge Charge of the digit
       void setDigit(Int_t pad, Float_t charge);
-      
+
       /// Fill output TClonesArray
       /// @param output Output container
       /// @param cruID CRU ID
       /// @param rowID Row ID
       void fillOutputContainer(TClonesArray *output, Int_t cru, Int_t timeBin, Int_t row);
-      
+
+      /// Get the accumulated charge of a pad
+      /// @param pad Pad of the digit
+      /// @return Accumulated charge of the pad
+      Float_t getCharge(Int_t pad) const {return mPadCharge[pad];}
+
+      /// Get the memory footprint of the container
+      /// @return Allocated bytes
+      size_t getMemoryUsage() const {
+        return sizeof(*this) + mPadCharge.capacity() * sizeof(Float_t)
+               + mFiredPads.capacity() * sizeof(UChar_t);
+      }
+
+      /// Get the pads fired since the last reset, in ascending pad order
+      /// @return Fired pad list
+      const std::vector<UChar_t>& getFiredPads() {
+        std::sort(mFiredPads.begin(), mFiredPads.end());
+        return mFiredPads;
+      }
+
     private:
       UChar_t                mRow;
-      UChar_t                mNPads;
-      std::vector<DigitPad*> mPads;
+      std::vector<Float_t>   mPadCharge;  ///< Accumulated charge per pad
+      std::vector<UChar_t>   mFiredPads;  ///< Pads with charge since the last reset
     };
-    
+
+    inline
+    void DigitRow::setDigit(Int_t pad, Float_t charge) {
+      if(mPadCharge[pad] == 0) mFiredPads.emplace_back(pad);
+      mPadCharge[pad] += charge;
+    }
+
     inline
     void DigitRow::reset() {
-      for(auto &aPad : mPads) {
-        if(aPad == nullptr) continue;
-        aPad->reset();
+      for(auto &aPad : mFiredPads) {
+        mPadCharge[aPad] = 0;
       }
+      mFiredPads.clear();
     }
-    
-    
+
+
   }
 }
 
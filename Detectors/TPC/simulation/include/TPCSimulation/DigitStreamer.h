@@ -0,0 +1,64 @@
+/// \file DigitStreamer.h
+/// \brief Columnar binary streaming of TPC digits
+#ifndef _ALICEO2_TPC_DigitStreamer_
+#define _ALICEO2_TPC_DigitStreamer_
+
+#include "Rtypes.h"
+#include <iosfwd>
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    class DigitContainer;
+
+    /// \class DigitStreamer
+    /// \brief Binary streaming of TPC digits without TClonesArray
+    ///
+    /// Serializes the digits of a DigitContainer into a compact columnar
+    /// record (CRU, row, pad, time bin and ADC as packed integers) directly
+    /// from the container's internal storage. The format starts with a small
+    /// header (magic word, version, number of digits) followed by one
+    /// contiguous block per column, and is readable back without ROOT
+    /// dictionaries.
+
+    class DigitStreamer{
+    public:
+
+      /// \struct DigitColumns
+      /// \brief Columnar digit record as read back from a stream
+      struct DigitColumns {
+        std::vector<UShort_t> cru;     ///< CRU of the digits
+        std::vector<UChar_t>  row;     ///< pad row of the digits
+        std::vector<UChar_t>  pad;     ///< pad of the digits
+        std::vector<UInt_t>   timeBin; ///< time bin of the digits
+        std::vector<UShort_t> adc;     ///< ADC value of the digits
+
+        /// Get the number of digits in the record
+        /// @return Number of digits
+        size_t getNDigits() const {return cru.size();}
+      };
+
+      /// Serialize the digits of a container into a binary stream
+      /// @param container Container with the digits
+      /// @param out Output stream
+      /// @return Number of digits written
+      static size_t streamDigits(DigitContainer *container, std::ostream &out);
+
+      /// Read a columnar digit record back from a binary stream
+      /// @param in Input stream
+      /// @param columns Columnar record to be filled
+      /// @return Number of digits read, 0 on format mismatch
+      static size_t readDigits(std::istream &in, DigitColumns &columns);
+
+    private:
+      /// Magic word identifying the digit stream format
+      static const UInt_t mMagicWord = 0x54504344; // 'TPCD'
+      /// Version of the digit stream format
+      static const UInt_t mVersion = 1;
+    };
+
+  }
+}
+
+#endif
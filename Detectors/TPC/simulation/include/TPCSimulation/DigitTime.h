@@ -49,7 +49,15 @@ namespace AliceO2 {
       /// @param padID Pad ID
       /// @param timeBin Time bin
       void fillOutputContainer(TClonesArray *output, Int_t cru, Int_t timeBin);
-      
+
+      /// Get the row container
+      /// @return Row container
+      const std::vector<DigitRow*>& getRows() {return mRows;}
+
+      /// Get the memory footprint of the container
+      /// @return Allocated bytes over all rows
+      size_t getMemoryUsage() const;
+
     private:
       UShort_t                mTimeBin;
       UChar_t                 mNRows;
@@ -63,6 +71,16 @@ namespace AliceO2 {
         aRow->reset();
       }
     }
+
+    inline
+    size_t DigitTime::getMemoryUsage() const {
+      size_t bytes = sizeof(*this) + mRows.capacity() * sizeof(DigitRow*);
+      for(auto &aRow : mRows) {
+        if(aRow == nullptr) continue;
+        bytes += aRow->getMemoryUsage();
+      }
+      return bytes;
+    }
     
   }
 }
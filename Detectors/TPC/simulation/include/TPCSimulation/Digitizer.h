@@ -4,7 +4,10 @@
 #define ALICEO2_TPC_Digitizer_H_
 
 #include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/GEMAmplification.h"
 #include "TPCSimulation/PadResponse.h"
+#include "TPCSimulation/PadResponseLUT.h"
+#include "TPCSimulation/PointCache.h"
 
 #include "Rtypes.h"
 #include "TObject.h"
@@ -16,11 +19,13 @@
 using std::vector;
 
 class TClonesArray;
+class TRandom3;
 
 namespace AliceO2{
   namespace TPC{
-    
+
     class DigitContainer;
+    class Point;
     
     /// \class Digitizer
     /// \brief Digitizer class for the TPC
@@ -36,16 +41,80 @@ namespace AliceO2{
       
       /// Initializer
       void init();
+
+      /// Set the size of the GEM amplification lookup table, to be called before init()
+      /// @param tableSize Number of entries in the lookup table
+      void setGEMLookupTableSize(size_t tableSize) {mGEMLookupTableSize = tableSize;}
+
+      /// Enable the precomputed pad-response lookup table
+      /// Charge spreading to neighboring pads then uses the cached coupling
+      /// fractions instead of the trivial single-pad response.
+      void enablePadResponseLUT();
+
+      /// Get the pad-response lookup table
+      /// @return Lookup table, nullptr if not enabled
+      PadResponseLUT *getPadResponseLUT() const {return mPadResponseLUT;}
       
       /// Steer conversion of points to digits
       /// @param points Container with TPC points
       /// @return digits container
       DigitContainer *Process(TClonesArray *points);
-      
+
+      /// Steer conversion of points handed over in memory to digits
+      /// Used with the PointCache, where the stepping code fills plain point
+      /// data instead of a TClonesArray.
+      /// @param points Point data of one event
+      /// @return digits container
+      DigitContainer *Process(const std::vector<PointData> &points);
+
+      /// Steer incremental conversion of a point batch for continuous readout
+      /// The digits are accumulated into the rolling container with time bins
+      /// relative to the absolute batch time; the container is not reset
+      /// between batches. Batches must be passed in increasing time order.
+      /// @param points Container with TPC points
+      /// @param batchTime Absolute time of the batch (us)
+      /// @return digits container
+      DigitContainer *ProcessBatch(TClonesArray *points, Float_t batchTime);
+
+      /// Emit all time bins whose drift window has closed and release them
+      /// A time bin is complete once the current batch time has passed it,
+      /// since drifting electrons can only add signal at later times.
+      /// @param output Output container
+      /// @param currentTime Absolute time up to which bins are emitted (us)
+      void fillCompletedTimeBins(TClonesArray *output, Float_t currentTime);
+
+      /// Set the number of worker threads used by Process
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Get the number of worker threads used by Process
+      /// @return Number of threads
+      Int_t getNumThreads() const {return mNumThreads;}
+
+      /// Use a private random generator instead of the shared gRandom
+      /// Required when several Digitizer instances process events
+      /// concurrently, since gRandom is not thread safe.
+      /// @param seed Seed of the private generator
+      void setRandomSeed(UInt_t seed);
+
       /// Drift of electrons in electric field taking into account diffusion
       /// @param *xyz Array with 3d position of the electrons
       /// @return Array with 3d position of the electrons after the drift taking into account diffusion
       void ElectronDrift(Float_t *xyz) const;
+
+      /// Drift of electrons in electric field taking into account diffusion, using a given random generator
+      /// @param *xyz Array with 3d position of the electrons
+      /// @param random Random generator to be used, must not be shared between threads
+      void ElectronDrift(Float_t *xyz, TRandom *random) const;
+
+      /// Batched drift of electrons in electric field taking into account diffusion
+      /// The diffusion smearing is drawn from a pre-generated ring of Gaussian
+      /// numbers, so the loop over the electrons is free of virtual TRandom
+      /// calls and vectorizes.
+      /// @param x x positions of the electrons, smeared in place
+      /// @param y y positions of the electrons, smeared in place
+      /// @param z z positions of the electrons, smeared in place
+      void ElectronDrift(std::vector<Float_t> &x, std::vector<Float_t> &y, std::vector<Float_t> &z) const;
       
       /// Simulation of the GEM response
       /// @return Number of electrons after GEM amplification taking into account exponential fluctuations of the gain
@@ -56,7 +125,7 @@ namespace AliceO2{
       /// @param nEle Number of incoming electrons
       /// @param gain Gain of the single GEM, should go to OCDB
       /// @return Number of electrons after GEM amplification taking into account fluctuations of the gain according to a Polya distribution
-      Int_t SingleGEMAmplification(Int_t nEle, Float_t gain) const;
+      Int_t SingleGEMAmplification(Int_t nEle, Float_t gain, TRandom *random = nullptr) const;
       
       
       /// Pad Response
@@ -73,7 +142,11 @@ namespace AliceO2{
       /// @param nElectrons Number of electrons in time bin
       /// @return ADC value
       Int_t ADCvalue(Float_t nElectrons) const;
-      
+
+      /// Number of electrons corresponding to one ADC count, the inverse of ADCvalue
+      /// @return Electrons per ADC count
+      static Float_t chargePerADCcount();
+
       /// Compute time bin from z position
       /// @param zPos z position of the charge
       /// @return Time bin of the charge
@@ -104,10 +177,54 @@ namespace AliceO2{
     private:
       Digitizer(const Digitizer &);
       Digitizer &operator=(const Digitizer &);
-      
+
+      /// Digitization of the points partitioned by sector on a pool of worker threads
+      /// @param points Container with TPC points
+      /// @return digits container
+      DigitContainer *ProcessParallel(TClonesArray *points);
+
+      /// Digitization of in-memory point data partitioned by sector on a pool of worker threads
+      /// @param points Point data of one event
+      /// @return digits container
+      DigitContainer *ProcessParallel(const std::vector<PointData> &points);
+
+      /// Presort key of a point, its (CRU, time bin) packed into one word
+      /// Sorting the points by this key before digitization makes the
+      /// accumulation stream through the digit container one time slice at a
+      /// time instead of writing at scattered time bins. The key is an
+      /// estimate taken before diffusion, which is fine since it only steers
+      /// the processing order. Points outside the active pad planes sort to
+      /// the end.
+      /// @param x x position of the point
+      /// @param y y position of the point
+      /// @param z z position of the point
+      /// @return Sort key, ascending in (CRU, time bin)
+      ULong64_t presortKey(Float_t x, Float_t y, Float_t z) const;
+
+      /// Conversion of a single point into digits
+      /// @param inputpoint Point to be digitized
+      /// @param digitContainer Container the digits are accumulated into
+      /// @param random Random generator to be used, must not be shared between threads
+      void digitizePoint(Point *inputpoint, DigitContainer *digitContainer, TRandom *random);
+
+      /// Conversion of a single point, given by its coordinates, into digits
+      /// @param x x position of the point
+      /// @param y y position of the point
+      /// @param z z position of the point
+      /// @param eLoss Energy deposit of the point (GeV)
+      /// @param digitContainer Container the digits are accumulated into
+      /// @param random Random generator to be used, must not be shared between threads
+      void digitizePoint(Float_t x, Float_t y, Float_t z, Float_t eLoss, DigitContainer *digitContainer, TRandom *random);
+
       TF1                     *mPolya;
       DigitContainer          *mDigitContainer;
+      GEMAmplification        *mGEMAmplification;
+      size_t                   mGEMLookupTableSize;
+      PadResponseLUT          *mPadResponseLUT;
+      Int_t                    mTimeBinOffset;
       std::vector<PadResponse> mPadResponse;
+      Int_t                    mNumThreads;
+      TRandom3                *mRandom;      //!< private random generator, nullptr uses gRandom
       ClassDef(Digitizer, 1);
     };
     
@@ -123,8 +240,12 @@ namespace AliceO2{
     }
     
     inline
-    Int_t Digitizer::SingleGEMAmplification(Int_t nEle, Float_t gain) const {
-      //   return static_cast<int>(static_cast<float>(nEle)*gain*mPolya->GetRandom());
+    Int_t Digitizer::SingleGEMAmplification(Int_t nEle, Float_t gain, TRandom *random) const {
+      // the gain fluctuations follow a Polya distribution, sampled from the
+      // lookup table instead of TF1::GetRandom
+      if(mGEMAmplification) {
+        return static_cast<int>(static_cast<float>(nEle)*gain*mGEMAmplification->getGainFluctuation(random));
+      }
       return static_cast<int>(static_cast<float>(nEle)*gain);
     }
     
@@ -138,10 +259,21 @@ namespace AliceO2{
       
       Int_t adcValue = static_cast<int>(nElectrons*Qel*1.e15*ChipGain*ADCSat/ADCDynRange);
       if(adcValue > ADCSat) adcValue = ADCSat;// saturation
-      
+
       return adcValue;
     }
-    
+
+    inline
+    Float_t Digitizer::chargePerADCcount() {
+      // TODO parameters to be stored someplace else
+      Float_t ADCSat = 1023;
+      Float_t Qel = 1.602e-19;
+      Float_t ChipGain = 20;
+      Float_t ADCDynRange = 2000;
+
+      return ADCDynRange/(Qel*1.e15*ChipGain*ADCSat);
+    }
+
     inline
     Int_t Digitizer::getTimeBin(Float_t zPos) const {
       // TODO parameters to be stored someplace else
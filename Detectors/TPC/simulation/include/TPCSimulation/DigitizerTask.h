@@ -4,41 +4,132 @@
 #define __ALICEO2_TPC_DigitizerTask__
 
 #include <stdio.h>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "FairTask.h"
 #include "Rtypes.h"
+#include "TPCSimulation/PointCache.h"
 class TClonesArray;
 namespace AliceO2 { namespace TPC { class Digitizer; } }
 
 namespace AliceO2 {
   namespace TPC {
-    
+
     class Digitizer;
-    
+    class DigitContainer;
+
     /// \class DigitizerTask
     /// \brief Digitizer task for the TPC
-    
+
     class DigitizerTask : public FairTask{
     public:
-      
+
       /// Default constructor
       DigitizerTask();
-      
+
       /// Destructor
       virtual ~DigitizerTask();
-      
+
       /// Inititializes the digitizer and connects input and output container
       virtual InitStatus Init();
-      
+
       /// Digitization
       /// @param option Option
       virtual void Exec(Option_t *option);
-      
+
+      /// Finish the task, drains pending events and closes the binary output stream if used
+      virtual void FinishTask();
+
+      /// Write the digits as columnar binary records instead of a TClonesArray
+      /// Bypasses the per-digit TObject materialization in the output path.
+      /// @param filename Name of the binary output file
+      void setBinaryOutputFile(const std::string &filename) {mBinaryOutputFileName = filename;}
+
+      /// Set the number of worker threads of the sector-parallel digitization
+      /// @param numThreads Number of threads, 1 means serial processing
+      void setNumThreads(Int_t numThreads) {mNumThreads = numThreads;}
+
+      /// Digitize several events concurrently instead of one per Exec call
+      /// Exec then only snapshots the event's points and returns, so the
+      /// transport of the next event overlaps with the digitization of the
+      /// previous ones and the cores stay busy across the alternating
+      /// transport/digitization phases of combined jobs. The completed digit
+      /// containers are delivered in event order. Requires the binary output,
+      /// since the TClonesArray branch is filled by FairRoot synchronously
+      /// with Exec; without it the task falls back to synchronous processing.
+      /// @param maxInFlight Number of events digitized concurrently, 0 restores
+      ///        the synchronous per-event processing
+      void setMaxInFlightEvents(Int_t maxInFlight) {mMaxInFlight = maxInFlight;}
+
+      /// Overlay cached background events into every signal digitization
+      /// The background sample is loaded once per process into the
+      /// BackgroundEventCache and shared by all tasks and by the concurrent
+      /// slots of the asynchronous mode; the cached events are cycled
+      /// through in order. The labels of the background tracks are taken
+      /// over unchanged, the disambiguation is up to the consumer.
+      /// @param filename Name of the background point file
+      /// @param eventsPerSignal Number of background events overlaid per signal event
+      void setBackgroundFile(const std::string &filename, Int_t eventsPerSignal = 1) {
+        mBackgroundFileName = filename;
+        mBackgroundEventsPerSignal = eventsPerSignal;
+      }
+
     private:
+      /// \struct AsyncSlot
+      /// \brief One in-flight event of the asynchronous digitization mode
+      struct AsyncSlot {
+        AsyncSlot() : digitizer(nullptr), digits(nullptr), hasJob(kFALSE), hasResult(kFALSE), shutdown(kFALSE) {}
+        Digitizer              *digitizer;  ///< digitizer of the slot, owns the digit container
+        std::thread             worker;     ///< worker thread of the slot
+        std::vector<PointData>  points;     ///< snapshot of the event's points
+        DigitContainer         *digits;     ///< completed digits, owned by the digitizer
+        Bool_t                  hasJob;     ///< points queued, worker busy
+        Bool_t                  hasResult;  ///< digits ready for delivery
+        Bool_t                  shutdown;   ///< request the worker to exit
+      };
+
+      /// Snapshot the current event's points and hand them to the next slot
+      /// Flushes completed events in order until the slot is free.
+      void enqueueEvent();
+
+      /// Copy the points of the current event out of the TClonesArray
+      void snapshotPoints(std::vector<PointData> &points);
+
+      /// Append the background events of the current embedding position
+      void overlayBackground(std::vector<PointData> &points);
+
+      /// Wait for the oldest in-flight event and stream its digits
+      void deliverNextResult();
+
+      /// Processing loop of one slot's worker thread
+      /// @param slot Slot served by this worker
+      void asyncWorkerLoop(AsyncSlot *slot);
+
       Digitizer           *mDigitizer;
-      
+
       TClonesArray        *mPointsArray;
       TClonesArray        *mDigitsArray;
-      
+
+      std::string          mBinaryOutputFileName;  ///< name of the binary output file, empty for TClonesArray output
+      std::ofstream       *mBinaryOutput;          //!< binary digit output stream
+
+      std::string          mBackgroundFileName;         ///< name of the background point file, empty without embedding
+      Int_t                mBackgroundEventsPerSignal;  ///< background events overlaid per signal event
+      ULong64_t            mBackgroundCursor;           //!< position in the cycled background sample
+
+      Int_t                    mNumThreads;      ///< number of threads of the sector-parallel digitization
+      Int_t                    mMaxInFlight;     ///< number of events digitized concurrently, 0 = synchronous
+      std::vector<AsyncSlot*>  mSlots;           //!< slots of the asynchronous mode, event n goes to slot n modulo size
+      ULong64_t                mNextSequence;    //!< sequence number of the next enqueued event
+      ULong64_t                mNextToDeliver;   //!< sequence number of the next event to stream out
+      std::mutex               mAsyncMutex;      //!< protects the slot states
+      std::condition_variable  mJobCondition;    //!< signals queued jobs and shutdown to the workers
+      std::condition_variable  mResultCondition; //!< signals completed events to the delivery side
+
       ClassDef(DigitizerTask, 1)
     };
   }
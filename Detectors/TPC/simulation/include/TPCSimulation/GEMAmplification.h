@@ -0,0 +1,76 @@
+/// \file GEMAmplification.h
+/// \brief GEM amplification fluctuations from a precomputed lookup table
+#ifndef _ALICEO2_TPC_GEMAmplification_
+#define _ALICEO2_TPC_GEMAmplification_
+
+#include "TPCSimulation/RandomRing.h"
+#include "Rtypes.h"
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class GEMAmplification
+    /// \brief GEM amplification engine based on an inverse-CDF lookup table
+    ///
+    /// The gain fluctuations of a GEM follow a Polya distribution. Instead
+    /// of drawing from it per electron through TF1::GetRandom, the inverse
+    /// CDF is tabulated once at construction time and a sample is obtained
+    /// from one uniform draw and one linear table interpolation. The table
+    /// size is configurable to trade memory for accuracy.
+    ///
+    /// The table is read-only after construction and shared; the flat
+    /// random ring feeding the draws is thread-local, the sector-parallel
+    /// digitization workers consume gain fluctuations concurrently.
+
+    class GEMAmplification {
+    public:
+
+      /// Constructor, builds the inverse-CDF lookup table
+      /// @param sigmaOverMu Relative width of the Polya distribution
+      /// @param tableSize Number of entries in the lookup table
+      GEMAmplification(Float_t sigmaOverMu = 0.78, size_t tableSize = 65536);
+
+      /// Destructor
+      ~GEMAmplification();
+
+      /// Draw one gain fluctuation from the tabulated Polya distribution
+      /// @param random Generator filling the thread-local random ring on its
+      ///               first use in the calling thread, nullptr uses gRandom;
+      ///               worker threads must pass their own generator
+      /// @return Gain fluctuation with mean 1
+      Float_t getGainFluctuation(TRandom *random = nullptr);
+
+      /// Get the size of the lookup table
+      /// @return Number of entries in the lookup table
+      size_t getTableSize() const {return mInverseCDF.size();}
+
+    private:
+      GEMAmplification(const GEMAmplification &);
+      GEMAmplification &operator=(const GEMAmplification &);
+
+      /// Tabulate the inverse CDF of the Polya distribution
+      /// @param sigmaOverMu Relative width of the Polya distribution
+      /// @param tableSize Number of entries in the lookup table
+      void initLookupTable(Float_t sigmaOverMu, size_t tableSize);
+
+      std::vector<Float_t> mInverseCDF;  /// inverse CDF of the Polya distribution, equidistant in probability
+    };
+
+    inline
+    Float_t GEMAmplification::getGainFluctuation(TRandom *random) {
+      // one ring per thread: a shared ring would race on its read position;
+      // the lazy fill draws from the caller's generator, not from gRandom,
+      // so constructing on a worker thread is safe as well
+      static thread_local RandomRing<> randomFlat(RandomRing<>::RandomType::Flat, random);
+      const Float_t position = randomFlat.getNextValue()*(mInverseCDF.size()-1);
+      size_t bin = static_cast<size_t>(position);
+      if(bin > mInverseCDF.size()-2) bin = mInverseCDF.size()-2;
+      const Float_t fraction = position - bin;
+      return mInverseCDF[bin]*(1.f-fraction) + mInverseCDF[bin+1]*fraction;
+    }
+
+  }
+}
+
+#endif
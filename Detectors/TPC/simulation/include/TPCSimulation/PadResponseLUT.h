@@ -0,0 +1,93 @@
+/// \file PadResponseLUT.h
+/// \brief Precomputed pad-response coupling fractions
+#ifndef ALICEO2_TPC_PadResponseLUT_H
+#define ALICEO2_TPC_PadResponseLUT_H
+
+#include "TPCSimulation/PadResponse.h"
+
+#include "Rtypes.h"
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class PadResponseLUT
+    /// \brief Lookup table for the pad-response coupling fractions
+    ///
+    /// For every pad region the coupling fractions of a charge avalanche to
+    /// the 3x3 stencil of neighboring pads are precomputed on a grid of
+    /// fractional positions within the pad. Charge spreading then becomes a
+    /// fixed-stencil multiply-add over cached fractions instead of repeated
+    /// evaluation of the pad-response function per electron. The table is
+    /// shared between the Digitizer and the clusterers.
+
+    class PadResponseLUT {
+    public:
+
+      /// Stencil extent in pads and rows around the central pad
+      enum { StencilHalfWidth = 1, StencilSize = 9 };
+
+      /// Default constructor
+      PadResponseLUT();
+
+      /// Destructor
+      ~PadResponseLUT();
+
+      /// Set the width of the pad response function, to be called before init()
+      /// @param sigmaX Gaussian width along the rows (cm)
+      /// @param sigmaY Gaussian width along the pads (cm)
+      void setSigma(Float_t sigmaX, Float_t sigmaY) {mSigmaX = sigmaX; mSigmaY = sigmaY;}
+
+      /// Set the granularity of the fractional-position grid, to be called before init()
+      /// @param nSubBins Number of sub-bins per pad in each direction
+      void setNSubBins(Int_t nSubBins) {mNSubBins = nSubBins;}
+
+      /// Precompute the coupling fractions for all pad regions
+      void init();
+
+      /// Get the pad response for a charge at a fractional pad position
+      /// @param region Pad region of the charge
+      /// @param fracX Fractional position within the pad row [0,1)
+      /// @param fracY Fractional position within the pad [0,1)
+      /// @param response Vector filled with the coupled pads and their fractions
+      void getPadResponse(UChar_t region, Float_t fracX, Float_t fracY, std::vector<PadResponse> &response) const;
+
+    private:
+      /// Index into the fraction table of a region
+      /// @param subX Sub-bin along the row direction
+      /// @param subY Sub-bin along the pad direction
+      /// @return Index of the first stencil weight
+      Int_t tableIndex(Int_t subX, Int_t subY) const {return (subX*mNSubBins + subY)*StencilSize;}
+
+      Float_t mSigmaX;     /// Gaussian width of the pad response along the rows (cm)
+      Float_t mSigmaY;     /// Gaussian width of the pad response along the pads (cm)
+      Int_t   mNSubBins;   /// number of sub-bins per pad in each direction
+      Float_t mMinWeight;  /// stencil weights below this value are dropped
+
+      std::vector<std::vector<Float_t>> mFractions; /// per-region coupling fractions, indexed by (subX, subY, stencil cell)
+    };
+
+    inline
+    void PadResponseLUT::getPadResponse(UChar_t region, Float_t fracX, Float_t fracY, std::vector<PadResponse> &response) const
+    {
+      response.resize(0);
+      Int_t subX = static_cast<Int_t>(fracX*mNSubBins);
+      Int_t subY = static_cast<Int_t>(fracY*mNSubBins);
+      if(subX < 0) subX = 0;
+      if(subY < 0) subY = 0;
+      if(subX > mNSubBins-1) subX = mNSubBins-1;
+      if(subY > mNSubBins-1) subY = mNSubBins-1;
+      const Float_t *fractions = &mFractions[region][tableIndex(subX, subY)];
+      Int_t cell = 0;
+      for(Int_t dRow = -StencilHalfWidth; dRow <= StencilHalfWidth; ++dRow) {
+        for(Int_t dPad = -StencilHalfWidth; dPad <= StencilHalfWidth; ++dPad, ++cell) {
+          if(fractions[cell] < mMinWeight) continue;
+          response.emplace_back(dPad, dRow, fractions[cell]);
+        }
+      }
+    }
+
+  }
+}
+
+#endif /* ALICEO2_TPC_PadResponseLUT_H */
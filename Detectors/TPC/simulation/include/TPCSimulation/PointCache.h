@@ -0,0 +1,78 @@
+/// \file PointCache.h
+/// \brief In-memory hand-off of MC points from Detector to DigitizerTask
+#ifndef _ALICEO2_TPC_PointCache_
+#define _ALICEO2_TPC_PointCache_
+
+#include "Rtypes.h"
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \struct PointData
+    /// \brief Plain data of one MC point as consumed by the digitizer
+    struct PointData {
+      Float_t x;        ///< x position at entrance to active volume (cm)
+      Float_t y;        ///< y position at entrance to active volume (cm)
+      Float_t z;        ///< z position at entrance to active volume (cm)
+      Float_t time;     ///< time since event start (ns)
+      Float_t eLoss;    ///< energy deposit (GeV)
+      Int_t   trackID;  ///< index of MCTrack
+      Int_t   detID;    ///< detector ID
+    };
+
+    /// \class PointCache
+    /// \brief Double-buffered in-memory store for MC points
+    ///
+    /// When enabled, the stepping code appends its points here instead of
+    /// materializing them in the TClonesArray that goes through the FairRoot
+    /// branch machinery, and the digitizer consumes them directly. The cache
+    /// keeps two buffers: while the digitizer works on the points of the
+    /// previous event, the stepping of the next event can already fill the
+    /// other buffer.
+
+    class PointCache {
+    public:
+
+      /// Access to the cache shared between Detector and DigitizerTask
+      /// @return The cache instance
+      static PointCache& instance() {
+        static PointCache cache;
+        return cache;
+      }
+
+      /// Enable or disable the in-memory hand-off
+      /// @param enabled True to bypass the TClonesArray path
+      void setEnabled(Bool_t enabled) {mEnabled = enabled;}
+
+      /// Check whether the in-memory hand-off is active
+      /// @return True if the stepping code should fill the cache
+      Bool_t isEnabled() const {return mEnabled;}
+
+      /// Append a point to the fill buffer
+      /// @param point Point data to be stored
+      void addPoint(const PointData &point) {mBuffers[mFillIndex].emplace_back(point);}
+
+      /// Hand the filled buffer to the consumer and open the other one for filling
+      /// @return Buffer with the points of the completed event
+      std::vector<PointData>& consumeBuffer() {
+        std::vector<PointData> &completed = mBuffers[mFillIndex];
+        mFillIndex = 1 - mFillIndex;
+        mBuffers[mFillIndex].clear();
+        return completed;
+      }
+
+    private:
+      PointCache() : mEnabled(kFALSE), mFillIndex(0), mBuffers() {}
+      PointCache(const PointCache &);
+      void operator=(const PointCache &);
+
+      Bool_t                 mEnabled;    /// true if the stepping code fills the cache
+      Int_t                  mFillIndex;  /// buffer currently being filled
+      std::vector<PointData> mBuffers[2]; /// double-buffered point storage
+    };
+
+  }
+}
+
+#endif
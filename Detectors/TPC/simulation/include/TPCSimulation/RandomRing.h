@@ -0,0 +1,76 @@
+/// \file RandomRing.h
+/// \brief Ring buffer with pre-generated random numbers
+#ifndef _ALICEO2_TPC_RandomRing_
+#define _ALICEO2_TPC_RandomRing_
+
+#include "Rtypes.h"
+#include "TRandom.h"
+
+#include <array>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    /// \class RandomRing
+    /// \brief Ring buffer of pre-generated random numbers
+    ///
+    /// The ring is filled once through TRandom and afterwards only read,
+    /// which removes the virtual TRandom calls from the digitization inner
+    /// loops and turns the consumption of random numbers into a plain
+    /// array access that the compiler can vectorize around.
+
+    template <size_t N = 4*100000>
+    class RandomRing {
+    public:
+
+      enum class RandomType : char {
+        Gaus,      ///< Gaussian distribution with mean 0 and sigma 1
+        Flat       ///< Flat distribution between 0 and 1
+      };
+
+      /// Constructor, fills the ring from the given generator
+      /// @param type Distribution of the pre-generated numbers
+      /// @param random Generator to fill from, nullptr uses gRandom; pass a
+      ///               per-thread generator when constructing on a worker
+      ///               thread, gRandom is not thread safe
+      RandomRing(const RandomType type = RandomType::Gaus, TRandom *random = nullptr) :
+      mRandomNumbers(),
+      mRingPosition(0)
+      {
+        if(random == nullptr) random = gRandom;
+        for(auto &value : mRandomNumbers) {
+          switch (type) {
+            case RandomType::Gaus:
+              value = random->Gaus(0, 1);
+              break;
+            case RandomType::Flat:
+              value = random->Rndm();
+              break;
+          }
+        }
+      }
+
+      /// Get the next value from the ring
+      /// @return Next pre-generated random number
+      Float_t getNextValue() {
+        const Float_t value = mRandomNumbers[mRingPosition];
+        if(++mRingPosition >= N) mRingPosition = 0;
+        return value;
+      }
+
+      /// Get the size of the ring
+      /// @return Number of pre-generated values
+      size_t getSize() const {return N;}
+
+    private:
+      RandomRing(const RandomRing &);
+      RandomRing &operator=(const RandomRing &);
+
+      std::array<Float_t, N> mRandomNumbers; /// pre-generated random numbers
+      size_t                 mRingPosition;  /// current read position in the ring
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,64 @@
+/// \file SAMPAShaper.h
+/// \brief SAMPA shaping and saturation stage for the flat digit container
+#ifndef _ALICEO2_TPC_SAMPAShaper_
+#define _ALICEO2_TPC_SAMPAShaper_
+
+#include "Rtypes.h"
+
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    class DigitContainerFlat;
+
+    /// \class SAMPAShaper
+    /// \brief Front-end shaping emulation on the flat digit container
+    ///
+    /// Applies the SAMPA impulse response (the Gamma4 semi-Gaussian with
+    /// 160 ns peaking time) as a short causal FIR over the time sequence of
+    /// every pad, followed by a clamp at the ADC full scale. The kernel is
+    /// precomputed once in fixed point (Q16, the taps sum to exactly one) by
+    /// sampling the impulse response at the time-bin centers, so the total
+    /// charge of a signal is preserved up to the quantization. The
+    /// convolution runs in place on the charge planes over the time window
+    /// with signal of each CRU: the time bins are processed in decreasing
+    /// order, so each output only reads inputs not yet overwritten and no
+    /// copy of the plane is needed. Per time bin the taps are accumulated
+    /// with plain elementwise loops across the pads of one row, written to
+    /// auto-vectorize. Bins fired by the shaping tail are registered with
+    /// the container so the output loop and the reset stay consistent.
+
+    class SAMPAShaper {
+    public:
+      SAMPAShaper();
+
+      /// Run the shaping in place on the container's charge planes
+      /// @param container Flat digit container after charge accumulation
+      void process(DigitContainerFlat *container);
+
+      /// Get the number of kernel taps
+      /// @return Length of the shaping kernel in time bins
+      static Int_t getKernelLength() {return mKernelLength;}
+
+    private:
+      /// Shape one pad row of one CRU
+      /// @param charge Charge of the row's first pad in the first active time bin
+      /// @param stride Distance between consecutive time bins of a pad
+      /// @param nPads Number of pads in the row
+      /// @param nTimeBins Number of time bins to fill, including the shaping tail
+      void processRow(Float_t *charge, Int_t stride, Int_t nPads, Int_t nTimeBins);
+
+      /// Number of kernel taps, covers the impulse response down to the per mille level
+      static const Int_t mKernelLength = 8;
+
+      Int_t   mKernel[mKernelLength]; ///< shaping kernel in Q16 fixed point, taps sum to 65536
+      Float_t mFullScale;             ///< saturation charge of the ADC full scale in electrons
+
+      std::vector<Float_t> mAcc;      //!<! scratch: tap accumulator of one time bin of a row
+      std::vector<UChar_t> mEmpty;    //!<! scratch: empty-cell mask of one row before shaping
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/// \file ZeroSuppression.h
+/// \brief Zero-suppression and common-mode stage for the flat digit container
+#ifndef _ALICEO2_TPC_ZeroSuppression_
+#define _ALICEO2_TPC_ZeroSuppression_
+
+#include "Rtypes.h"
+
+#include <vector>
+
+namespace AliceO2 {
+  namespace TPC {
+
+    class DigitContainerFlat;
+
+    /// \class ZeroSuppression
+    /// \brief Zero-suppression emulation on the flat digit container
+    ///
+    /// Runs in place on the charge planes of the DigitContainerFlat after
+    /// charge accumulation and before the output is filled, so the
+    /// unsuppressed data volume is never materialized. Per pad row the stage
+    /// applies an optional common-mode subtraction (a configurable fraction
+    /// of the mean row signal per time bin), a threshold comparison and a
+    /// glitch filter keeping only signals above threshold in a minimum
+    /// number of consecutive time bins. The kernels are plain elementwise
+    /// loops over contiguous pad spans, written to auto-vectorize, and only
+    /// the time window with signal of each CRU is touched.
+
+    class ZeroSuppression {
+    public:
+      ZeroSuppression();
+
+      /// Set the suppression threshold
+      /// @param thresholdADC Threshold in ADC counts, 0 disables the thresholding
+      void setThreshold(Float_t thresholdADC);
+
+      /// Set the glitch filter length
+      /// @param minSamples Minimum number of consecutive time bins above
+      ///        threshold, 1 disables the filter
+      void setGlitchFilter(Int_t minSamples) {mMinSamples = minSamples < 1 ? 1 : minSamples;}
+
+      /// Get the glitch filter length
+      /// @return Minimum number of consecutive time bins above threshold
+      Int_t getGlitchFilter() const {return mMinSamples;}
+
+      /// Set the common-mode coupling fraction
+      /// @param fraction Fraction of the mean row signal subtracted from
+      ///        every pad of the row per time bin, 0 disables the subtraction
+      void setCommonModeFraction(Float_t fraction) {mCommonModeFraction = fraction;}
+
+      /// Get the common-mode coupling fraction
+      /// @return Fraction of the mean row signal subtracted per pad
+      Float_t getCommonModeFraction() const {return mCommonModeFraction;}
+
+      /// Run the suppression in place on the container's charge planes
+      /// @param container Flat digit container after charge accumulation
+      void process(DigitContainerFlat *container);
+
+    private:
+      /// Suppress one pad row of one CRU
+      /// @param charge Charge of the row's first pad in the first active time bin
+      /// @param stride Distance between consecutive time bins of a pad
+      /// @param nPads Number of pads in the row
+      /// @param nTimeBins Number of active time bins
+      void processRow(Float_t *charge, Int_t stride, Int_t nPads, Int_t nTimeBins);
+
+      Float_t mThreshold;           ///< suppression threshold in electrons, 0 disables
+      Int_t   mMinSamples;          ///< glitch filter: minimum consecutive time bins above threshold
+      Float_t mCommonModeFraction;  ///< fraction of the mean row signal subtracted per pad
+
+      std::vector<UChar_t>  mAbove; //!<! scratch: above-threshold mask of one row
+      std::vector<UChar_t>  mKeep;  //!<! scratch: keep mask of one row after the glitch filter
+      std::vector<UShort_t> mCount; //!<! scratch: per-pad running above-threshold lengths
+    };
+  }
+}
+
+#endif
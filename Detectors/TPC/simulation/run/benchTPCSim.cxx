@@ -0,0 +1,188 @@
+/// \file benchTPCSim.cxx
+/// \brief Per-kernel benchmarks for the TPC simulation chain
+///
+/// Isolated harnesses for the hot kernels of the digitizer: electron
+/// drift, GEM amplification, pad-response lookup, digit accumulation and
+/// digit output. Each kernel reports ns per operation and the derived
+/// rate as one comma-separated line, so the numbers can be archived per
+/// release and compared without parsing free text:
+///
+///   kernel,nOps,occupancy,ns_per_op,ops_per_s
+///
+/// Usage: benchTPCSim [nElectrons] [occupancy]
+///   nElectrons  operations per kernel, default 10000000
+///   occupancy   fraction of fired (pad, time) cells in the accumulation
+///               and output benchmarks, default 0.05
+
+#include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/DigitContainerFlat.h"
+#include "TPCSimulation/GEMAmplification.h"
+#include "TPCSimulation/PadResponse.h"
+#include "TPCSimulation/PadResponseLUT.h"
+#include "TPCBase/CRU.h"
+#include "TPCBase/Mapper.h"
+
+#include "TClonesArray.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace AliceO2::TPC;
+
+namespace {
+  std::chrono::high_resolution_clock::time_point benchStart;
+
+  void start()
+  {
+    benchStart = std::chrono::high_resolution_clock::now();
+  }
+
+  void report(const char *kernel, size_t nOps, double occupancy)
+  {
+    const auto stop = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(stop-benchStart).count();
+    printf("%s,%zu,%.4f,%.3f,%10.3e\n", kernel, nOps, occupancy,
+           1e9*seconds/nOps, nOps/seconds);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const size_t nElectrons = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+  const double occupancy = argc > 2 ? atof(argv[2]) : 0.05;
+
+  std::mt19937 rng(12345);
+  double checksum = 0;
+
+  printf("kernel,nOps,occupancy,ns_per_op,ops_per_s\n");
+
+  // ===| ElectronDrift |=======================================================
+  {
+    Digitizer digitizer;
+    const size_t batch = std::min<size_t>(nElectrons, 1000000);
+    std::vector<Float_t> x(batch), y(batch), z(batch);
+    for(size_t i = 0; i < batch; ++i) {
+      x[i] = 100.f + 0.01f*(rng()%10000);
+      y[i] = -50.f + 0.01f*(rng()%10000);
+      z[i] = 0.025f*(rng()%10000);
+    }
+    size_t nOps = 0;
+    start();
+    while(nOps < nElectrons) {
+      digitizer.ElectronDrift(x, y, z);
+      nOps += batch;
+    }
+    report("ElectronDrift", nOps, 0);
+    checksum += x.front() + y.front() + z.front();
+  }
+
+  // ===| GEMAmplification |====================================================
+  {
+    GEMAmplification gem; // the lookup table is built outside the timed loop
+    start();
+    for(size_t i = 0; i < nElectrons; ++i) {
+      checksum += gem.getGainFluctuation();
+    }
+    report("GEMAmplification", nElectrons, 0);
+  }
+
+  // ===| PadResponse |=========================================================
+  {
+    PadResponseLUT lut;
+    lut.init();
+    // pre-generate the query positions so the loop measures only the lookup
+    const size_t nQueries = 65536;
+    std::vector<UChar_t> region(nQueries);
+    std::vector<Float_t> fracX(nQueries), fracY(nQueries);
+    for(size_t i = 0; i < nQueries; ++i) {
+      region[i] = rng()%CRU::CRUperSector;
+      fracX[i] = (rng()%1000)/1000.f;
+      fracY[i] = (rng()%1000)/1000.f;
+    }
+    std::vector<PadResponse> response;
+    start();
+    for(size_t i = 0; i < nElectrons; ++i) {
+      const size_t query = i%nQueries;
+      lut.getPadResponse(region[query], fracX[query], fracY[query], response);
+      checksum += response.size();
+    }
+    report("PadResponse::getPadResponse", nElectrons, 0);
+  }
+
+  // ===| digit accumulation and output |=======================================
+  {
+    // synthetic digits over one sector: per CRU the requested fraction of
+    // the (row, pad, time) cells of one drift time is fired, and each fired
+    // cell collects several charge additions as in a real avalanche
+    const Mapper& mapper = Mapper::instance();
+    const Int_t timeBins = 500;
+    const Int_t addsPerCell = 4;
+    struct DigitData {
+      UShort_t cru;
+      UShort_t timeBin;
+      UChar_t  row;
+      UChar_t  pad;
+    };
+    std::vector<DigitData> digits;
+    for(Int_t cru = 0; cru < CRU::CRUperSector; ++cru) {
+      const PadRegionInfo& region = mapper.getPadRegionInfo(CRU(cru).region());
+      Int_t pads = 0;
+      for(Int_t row = 0; row < region.getNumberOfPadRows(); ++row) {
+        pads += region.getPadsInRowRegion(row);
+      }
+      const size_t nCells = occupancy*pads*timeBins;
+      for(size_t iCell = 0; iCell < nCells; ++iCell) {
+        const Int_t row = rng()%region.getNumberOfPadRows();
+        const Int_t pad = rng()%region.getPadsInRowRegion(row);
+        const Int_t timeBin = rng()%timeBins;
+        for(Int_t add = 0; add < addsPerCell; ++add) {
+          digits.emplace_back(DigitData{static_cast<UShort_t>(cru),
+                                        static_cast<UShort_t>(timeBin),
+                                        static_cast<UChar_t>(row),
+                                        static_cast<UChar_t>(pad)});
+        }
+      }
+    }
+    std::shuffle(digits.begin(), digits.end(), rng);
+
+    DigitContainerFlat container;
+    // warm-up fill sizes the arenas, the timed rounds measure accumulation only
+    for(const auto &digit : digits) {
+      container.addDigit(digit.cru, digit.timeBin, digit.row, digit.pad, 100.f);
+    }
+    container.reset();
+
+    size_t nAdds = 0;
+    start();
+    while(nAdds < nElectrons) {
+      for(const auto &digit : digits) {
+        container.addDigit(digit.cru, digit.timeBin, digit.row, digit.pad, 100.f);
+      }
+      nAdds += digits.size();
+    }
+    report("DigitContainerFlat::addDigit", nAdds, occupancy);
+
+    size_t nCells = 0;
+    for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+      nCells += container.getOccupiedBins(cru).size();
+    }
+    TClonesArray output("AliceO2::TPC::Digit");
+    const Int_t rounds = 10;
+    start();
+    for(Int_t round = 0; round < rounds; ++round) {
+      output.Clear();
+      container.fillOutputContainer(&output);
+    }
+    report("fillOutputContainer", rounds*nCells, occupancy);
+    checksum += output.GetEntriesFast();
+  }
+
+  // keep the loops observable so they are not optimized away
+  printf("# checksum %f\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+/// \file BackgroundEventCache.cxx
+/// \brief Implementation of the background event cache
+#include "TPCSimulation/BackgroundEventCache.h"
+#include "TPCSimulation/Point.h"
+
+#include "TClonesArray.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "FairLogger.h"
+
+using namespace AliceO2::TPC;
+
+Int_t BackgroundEventCache::loadFile(const char *filename, const char *branchName)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mLoadedFile == filename && !mEvents.empty()) {
+    // the sample is already resident, share it
+    return mEvents.size();
+  }
+
+  TFile *file = TFile::Open(filename);
+  if (!file || file->IsZombie()) {
+    LOG(ERROR) << "Could not open background file " << filename << FairLogger::endl;
+    delete file;
+    return -1;
+  }
+  TTree *tree = dynamic_cast<TTree *>(file->Get("cbmsim"));
+  if (!tree) {
+    LOG(ERROR) << "No event tree in background file " << filename << FairLogger::endl;
+    delete file;
+    return -1;
+  }
+  TClonesArray *points = nullptr;
+  tree->SetBranchAddress(branchName, &points);
+
+  mEvents.clear();
+  mLoadedFile.clear();
+  Long64_t numberOfEvents = tree->GetEntries();
+  mEvents.reserve(numberOfEvents);
+  for (Long64_t iEvent = 0; iEvent < numberOfEvents; ++iEvent) {
+    tree->GetEntry(iEvent);
+    auto event = std::make_shared<std::vector<PointData>>();
+    event->reserve(points->GetEntriesFast());
+    for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter) {
+      Point *inputpoint = static_cast<Point *>(*pointiter);
+      event->emplace_back(PointData{static_cast<Float_t>(inputpoint->GetX()), static_cast<Float_t>(inputpoint->GetY()),
+                                    static_cast<Float_t>(inputpoint->GetZ()), static_cast<Float_t>(inputpoint->GetTime()),
+                                    static_cast<Float_t>(inputpoint->GetEnergyLoss()),
+                                    inputpoint->GetTrackID(), inputpoint->GetDetectorID()});
+    }
+    mEvents.emplace_back(std::move(event));
+  }
+  delete file;
+
+  mLoadedFile = filename;
+  LOG(INFO) << "Background cache holds " << mEvents.size() << " event(s) from " << filename << FairLogger::endl;
+  return mEvents.size();
+}
@@ -45,11 +45,12 @@
 ///
 /// Implementation:
 ///
-/// The data are expanded into 3 arrays CRU by CRU
+/// The data are expanded into 3 arrays CRU by CRU, bundled in a WorkArrays
+/// scratch structure
 /// ~~~
-/// Float_t** mAllBins       2d array [row][bin(pad, time)] ADC signal
-/// Int_t**   mAllSigBins    2d array [row][signal#] bin(with signal)
-/// Int_t*    mAllNSigBins;  1d array [row] Nsignals
+/// Float_t** allBins   2d array [row][bin(pad, time)] ADC signal
+/// vector<vector<Int_t>> sigBins  per row the bins with signal, grown on demand
+/// vector<Int_t> dirtyRows        rows touched since the last clean
 /// ~~~
 /// To make sure that one never has to check if one is inside the sector or not
 /// the arrays are larger than a sector. 2 pads and time bins are added both
@@ -59,6 +60,13 @@
 /// FindLocalMaxima is called on the data from the previous sector, and
 /// the clusters are created.
 ///
+/// Since CRUs are independent, Process can also run with a pool of worker
+/// threads (setNumThreads): the digits are first partitioned per CRU, the
+/// CRUs are distributed over the workers through a shared work queue, each
+/// worker expands and scans its CRUs with its own WorkArrays, and the
+/// cluster parameters are collected per CRU so the final container filling
+/// needs no locking.
+///
 
 /*
 
@@ -81,31 +89,83 @@
 
 #include "TPCSimulation/BoxClusterer.h"
 #include "TPCSimulation/Digit.h"
+#include "TPCSimulation/Digitizer.h"
 #include "TPCSimulation/ClusterContainer.h"
+#include "TPCSimulation/ClusterContainerFlat.h"
 #include "TPCSimulation/BoxCluster.h"
+#include "TPCBase/CRU.h"
 
 #include "FairLogger.h"
 #include "TMath.h"
 #include "TError.h"   // for R__ASSERT()
 #include "TClonesArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 ClassImp(AliceO2::TPC::BoxClusterer)
 
 using namespace AliceO2::TPC;
 
+//________________________________________________________________________
+BoxClusterer::WorkArrays::WorkArrays(Int_t rowsMax, Int_t padsMax, Int_t timeBinsMax):
+  allBins(nullptr),
+  sigBins(rowsMax),
+  dirtyRows(),
+  rowsMax(rowsMax)
+{
+  allBins = new Float_t*[rowsMax];
+
+  for (Int_t iRow = 0; iRow < rowsMax; iRow++) {
+    //
+    Int_t maxBin = (timeBinsMax+4)*(padsMax+4);
+    allBins[iRow] = new Float_t[maxBin];
+    for(Int_t i = 0; i < maxBin; i++)
+      allBins[iRow][i] = 0;
+  }
+}
+
+//________________________________________________________________________
+BoxClusterer::WorkArrays::~WorkArrays()
+{
+  for (Int_t iRow = 0; iRow < rowsMax; iRow++) {
+    delete [] allBins[iRow];
+  }
+  delete [] allBins;
+}
+
+//________________________________________________________________________
+void BoxClusterer::WorkArrays::clean()
+{
+  // only the bins of the rows touched since the last clean are reset; the
+  // signal lists keep their capacity for reuse in the next CRU or event
+
+  for (Int_t iRow : dirtyRows) {
+
+    Float_t* bins = allBins[iRow];
+    for(Int_t bin : sigBins[iRow])
+      bins[bin]=0;
+
+    sigBins[iRow].clear();
+  }
+  dirtyRows.clear();
+}
+
 //________________________________________________________________________
 BoxClusterer::BoxClusterer():
   TObject(),
   mClusterContainer(nullptr),
+  mFlatContainer(nullptr),
   mRowsMax(100),
   mPadsMax(200),
   mTimeBinsMax(1000),
   mMinQMax(5),
   mRequirePositiveCharge(kTRUE),
   mRequireNeighbouringPad(kTRUE),
-  mAllBins(nullptr),
-  mAllSigBins(nullptr),
-  mAllNSigBins(nullptr)
+  mNumThreads(1),
+  mWork(nullptr),
+  mWorkPool()
 {
 }
 
@@ -113,14 +173,10 @@ BoxClusterer::BoxClusterer():
 BoxClusterer::~BoxClusterer()
 {
   delete mClusterContainer;
-
-  for (Int_t iRow = 0; iRow < mRowsMax; iRow++) {
-    delete [] mAllBins[iRow];
-    delete [] mAllSigBins[iRow];
+  delete mWork;
+  for(auto &work : mWorkPool) {
+    delete work;
   }
-  delete [] mAllBins;
-  delete [] mAllSigBins;
-  delete [] mAllNSigBins;
 }
 
 //________________________________________________________________________
@@ -132,19 +188,7 @@ void BoxClusterer::Init()
   mClusterContainer = new ClusterContainer();
   mClusterContainer->InitArray("AliceO2::TPC::BoxCluster");
 
-  mAllBins = new Float_t*[mRowsMax];
-  mAllSigBins = new Int_t*[mRowsMax];
-  mAllNSigBins = new Int_t[mRowsMax];
-
-  for (Int_t iRow = 0; iRow < mRowsMax; iRow++) {
-    //
-    Int_t maxBin = (mTimeBinsMax+4)*(mPadsMax+4);
-    mAllBins[iRow] = new Float_t[maxBin];
-    for(Int_t i = 0; i < maxBin; i++)
-      mAllBins[iRow][i] = 0;
-    mAllSigBins[iRow] = new Int_t[maxBin];
-    mAllNSigBins[iRow] = 0;
-  }
+  mWork = new WorkArrays(mRowsMax, mPadsMax, mTimeBinsMax);
 }
 
 //________________________________________________________________________
@@ -152,6 +196,15 @@ ClusterContainer* BoxClusterer::Process(TClonesArray *digits)
 {
   R__ASSERT(mClusterContainer);
   mClusterContainer->Reset();
+  if(mFlatContainer) {
+    mFlatContainer->reset();
+  }
+
+  if(mNumThreads > 1) {
+    return ProcessParallel(digits);
+  }
+
+  std::vector<BoxClusterData> clusters;
 
   Int_t nSignals = 0;
   Int_t lastCRU = -1;
@@ -170,8 +223,8 @@ ClusterContainer* BoxClusterer::Process(TClonesArray *digits)
       if(iCRU != lastCRU) {
 
 	if(nSignals>0) {
-          FindLocalMaxima(lastCRU);
-	  CleanArrays();
+          FindLocalMaxima(lastCRU, mWork, clusters);
+	  mWork->clean();
 	}
         lastCRU = iCRU;
         nSignals = 0;
@@ -179,37 +232,229 @@ ClusterContainer* BoxClusterer::Process(TClonesArray *digits)
 
 	// while we wait for the time bin
 // 	Update(iCRU, iRow, iPad, iPad, charge);
-        Update(iCRU, iRow, iPad, iTimeBin, charge);
+        Update(mWork, iCRU, iRow, iPad, iTimeBin, charge);
         ++nSignals;
       }
     }
 
     // processing of last CRU
     if(nSignals>0) {
-      FindLocalMaxima(iCRU);
-      CleanArrays();
+      FindLocalMaxima(iCRU, mWork, clusters);
+      mWork->clean();
+    }
+
+  AddClustersToContainer(clusters);
+
+  if(mFlatContainer) {
+    mFlatContainer->sortClusters(mNumThreads);
+  }
+
+  return mClusterContainer;
+}
+
+//________________________________________________________________________
+ClusterContainer* BoxClusterer::ProcessParallel(TClonesArray *digits)
+{
+  /// \struct DigitData
+  /// \brief Compact copy of one digit in the per-CRU partitions
+  struct DigitData {
+    Int_t   row;
+    Int_t   pad;
+    Int_t   timeBin;
+    Float_t charge;
+  };
+
+  // partition the digits per CRU
+  std::vector<std::vector<DigitData>> digitsPerCRU(CRU::MaxCRU);
+  for (TIter digititer = TIter(digits).Begin(); digititer != TIter::End(); ++digititer)
+    {
+      Digit* digit = dynamic_cast<Digit*>(*digititer);
+      digitsPerCRU[digit->getCRU()].emplace_back(
+        DigitData{digit->getRow(), digit->getPad(), digit->getTimeStamp(), digit->getCharge()});
+    }
+
+  // CRUs are distributed over the workers through a shared queue; each
+  // worker writes the clusters of a CRU into its own slot, so no locking
+  // is needed for the result collection
+  std::vector<std::vector<BoxClusterData>> clustersPerCRU(CRU::MaxCRU);
+  std::atomic<Int_t> nextCRU(0);
+
+  const Int_t numThreads = TMath::Min(mNumThreads, static_cast<Int_t>(CRU::MaxCRU));
+  while(static_cast<Int_t>(mWorkPool.size()) < numThreads) {
+    mWorkPool.emplace_back(new WorkArrays(mRowsMax, mPadsMax, mTimeBinsMax));
+  }
+
+  std::vector<std::thread> workers;
+  for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+    workers.emplace_back([this, iThread, &nextCRU, &digitsPerCRU, &clustersPerCRU]() {
+      WorkArrays *work = mWorkPool[iThread];
+      while(true) {
+        const Int_t iCRU = nextCRU++;
+        if(iCRU >= CRU::MaxCRU) break;
+        if(digitsPerCRU[iCRU].empty()) continue;
+        for(const auto &digit : digitsPerCRU[iCRU]) {
+          Update(work, iCRU, digit.row, digit.pad, digit.timeBin, digit.charge);
+        }
+        FindLocalMaxima(iCRU, work, clustersPerCRU[iCRU]);
+        work->clean();
+      }
+    });
+  }
+
+  for(auto &worker : workers) {
+    worker.join();
+  }
+
+  for(const auto &clusters : clustersPerCRU) {
+    AddClustersToContainer(clusters);
+  }
+
+  if(mFlatContainer) {
+    mFlatContainer->sortClusters(mNumThreads);
+  }
+
+  return mClusterContainer;
+}
+
+//________________________________________________________________________
+ClusterContainer* BoxClusterer::Process(DigitContainerTiled *digits)
+{
+  R__ASSERT(mClusterContainer);
+  mClusterContainer->Reset();
+  if(mFlatContainer) {
+    mFlatContainer->reset();
+  }
+
+  if(mNumThreads > 1) {
+    return ProcessParallel(digits);
+  }
+
+  std::vector<BoxClusterData> clusters;
+  std::vector<DigitContainerTiled::Tile> tiles;
+
+  for(Int_t iCRU = 0; iCRU < CRU::MaxCRU; ++iCRU) {
+    digits->getOccupiedTiles(iCRU, tiles);
+    if(tiles.empty()) continue;
+    if(ExpandTiles(tiles, mWork) > 0) {
+      FindLocalMaxima(iCRU, mWork, clusters);
     }
+    mWork->clean();
+  }
+
+  AddClustersToContainer(clusters);
+
+  if(mFlatContainer) {
+    mFlatContainer->sortClusters(mNumThreads);
+  }
+
+  return mClusterContainer;
+}
+
+//________________________________________________________________________
+ClusterContainer* BoxClusterer::ProcessParallel(DigitContainerTiled *digits)
+{
+  // CRUs are distributed over the workers through a shared queue, as in
+  // the TClonesArray path; the per-CRU partitioning comes for free since
+  // the tiled container is already organized per CRU
+  std::vector<std::vector<BoxClusterData>> clustersPerCRU(CRU::MaxCRU);
+  std::atomic<Int_t> nextCRU(0);
+
+  const Int_t numThreads = TMath::Min(mNumThreads, static_cast<Int_t>(CRU::MaxCRU));
+  while(static_cast<Int_t>(mWorkPool.size()) < numThreads) {
+    mWorkPool.emplace_back(new WorkArrays(mRowsMax, mPadsMax, mTimeBinsMax));
+  }
+
+  std::vector<std::thread> workers;
+  for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+    workers.emplace_back([this, iThread, &nextCRU, digits, &clustersPerCRU]() {
+      WorkArrays *work = mWorkPool[iThread];
+      std::vector<DigitContainerTiled::Tile> tiles;
+      while(true) {
+        const Int_t iCRU = nextCRU++;
+        if(iCRU >= CRU::MaxCRU) break;
+        digits->getOccupiedTiles(iCRU, tiles);
+        if(tiles.empty()) continue;
+        if(ExpandTiles(tiles, work) > 0) {
+          FindLocalMaxima(iCRU, work, clustersPerCRU[iCRU]);
+        }
+        work->clean();
+      }
+    });
+  }
+
+  for(auto &worker : workers) {
+    worker.join();
+  }
+
+  for(const auto &clusters : clustersPerCRU) {
+    AddClustersToContainer(clusters);
+  }
+
+  if(mFlatContainer) {
+    mFlatContainer->sortClusters(mNumThreads);
+  }
 
   return mClusterContainer;
 }
 
 //_____________________________________________________________________
-void BoxClusterer::FindLocalMaxima(const Int_t iCRU)
+Int_t BoxClusterer::ExpandTiles(const std::vector<DigitContainerTiled::Tile> &tiles,
+                                WorkArrays *work)
+{
+  /// Only the occupied tiles are visited, so the empty regions of the
+  /// pad-time planes are skipped wholesale; inside a tile the cells are
+  /// scanned densely and converted to ADC counts as in the digit output
+
+  Digitizer digitizer;
+  Int_t nSignals = 0;
+  const Int_t tileSize = DigitContainerTiled::mTileSize;
+
+  for(const auto &tile : tiles) {
+    R__ASSERT(tile.row >= 0 && tile.row < mRowsMax);
+    R__ASSERT(tile.padOrigin >= 0 && tile.padOrigin < mPadsMax);
+    R__ASSERT(tile.timeBinOrigin >= 0 && tile.timeBinOrigin < mTimeBinsMax);
+    // a tile at the plane edge may reach beyond the expand arrays, its
+    // cells there are empty by construction
+    const Int_t padEnd = TMath::Min(tileSize, mPadsMax - tile.padOrigin);
+    const Int_t timeBinEnd = TMath::Min(tileSize, mTimeBinsMax - tile.timeBinOrigin);
+
+    Float_t *bins = work->allBins[tile.row];
+    for(Int_t localTimeBin = 0; localTimeBin < timeBinEnd; ++localTimeBin) {
+      const Float_t *cells = tile.cells + localTimeBin*tileSize;
+      for(Int_t localPad = 0; localPad < padEnd; ++localPad) {
+        if(cells[localPad] <= 0.f) continue;
+        const Int_t adc = digitizer.ADCvalue(cells[localPad]);
+        if(adc <= 0) continue;
+        const Int_t bin = (tile.padOrigin + localPad + 2)*(mTimeBinsMax + 4)
+                        + (tile.timeBinOrigin + localTimeBin + 2);
+        bins[bin] = adc;
+        work->addSignal(tile.row, bin);
+        ++nSignals;
+      }
+    }
+  }
+  return nSignals;
+}
+
+//_____________________________________________________________________
+void BoxClusterer::FindLocalMaxima(const Int_t iCRU, WorkArrays *work,
+                                   std::vector<BoxClusterData>& clusters)
 {
   /// This method is called after the data from each CRU has been
   /// exapanded into an array
-  /// Loop over the signals and identify local maxima and fill the
-  /// calibration objects with the information
+  /// Loop over the signals and identify local maxima and collect the
+  /// cluster parameters
 
-  R__ASSERT(mAllBins);
+  R__ASSERT(work);
 
   Int_t nLocalMaxima = 0;
-  // loop over rows
-  for (Int_t iRow = 0; iRow < mRowsMax; iRow++) {
+  // loop over the rows with signal, in row order
+  std::sort(work->dirtyRows.begin(), work->dirtyRows.end());
+  for (Int_t iRow : work->dirtyRows) {
 
-    Float_t* allBins = mAllBins[iRow];
-    Int_t* sigBins   = mAllSigBins[iRow];
-    const Int_t nSigBins   = mAllNSigBins[iRow];
+    Float_t* allBins = work->allBins[iRow];
+    const Int_t* sigBins   = work->sigBins[iRow].data();
+    const Int_t nSigBins   = work->sigBins[iRow].size();
 
     // loop over all signals
     for (Int_t iSig = 0; iSig < nSigBins; iSig++) {
@@ -318,31 +563,37 @@ void BoxClusterer::FindLocalMaxima(const Int_t iCRU)
 	Short_t nPad = maxP-minP+1;
 	Short_t nTimeBins = maxT-minT+1;
 	Short_t size = 10*nPad+nTimeBins;
-	BoxCluster* cluster = dynamic_cast<BoxCluster*>
-	  (mClusterContainer->AddCluster(iCRU, iRow, qTot, qMax, meanP, meanT,
-					 sigmaP, sigmaT));
-	cluster->setBoxParameters(pad, timebin, size);
+	clusters.emplace_back(BoxClusterData{iCRU, iRow,
+	                                     static_cast<Float_t>(qTot), qMax,
+	                                     static_cast<Float_t>(meanP), static_cast<Float_t>(meanT),
+	                                     static_cast<Float_t>(sigmaP), static_cast<Float_t>(sigmaT),
+	                                     pad, timebin, size});
       }
     } // end loop over signals
   } // end loop over rows
 }
 
-//_____________________________________________________________________
-void BoxClusterer::CleanArrays()
+//________________________________________________________________________
+void BoxClusterer::AddClustersToContainer(const std::vector<BoxClusterData>& clusters)
 {
-  // here it might be faster to do a memset for very large datasets
-
-  R__ASSERT(mAllBins);
-
-  for (Int_t iRow = 0; iRow < mRowsMax; iRow++) {
-
-    Float_t* allBins = mAllBins[iRow];
-    Int_t*   sigBins   = mAllSigBins[iRow];
-    const Int_t nSignals = mAllNSigBins[iRow];
-    for(Int_t i = 0; i < nSignals; i++)
-      allBins[sigBins[i]]=0;
-
-    mAllNSigBins[iRow]=0;
+  for(const auto &data : clusters) {
+    BoxCluster* cluster = dynamic_cast<BoxCluster*>
+      (mClusterContainer->AddCluster(data.cru, data.row, data.qTot, data.qMax,
+                                     data.meanP, data.meanT,
+                                     data.sigmaP, data.sigmaT));
+    cluster->setBoxParameters(data.pad, data.timebin, data.size);
+
+    // the clusters arrive ordered by CRU and row, so the flat store can be
+    // filled append-only
+    if(mFlatContainer) {
+      ClusterContainerFlat::PackedCluster &packed =
+        mFlatContainer->addCluster(data.cru, data.row);
+      packed.setParameters(data.row, data.qTot, data.qMax,
+                           data.meanP, data.meanT, data.sigmaP, data.sigmaT);
+      packed.padBin = data.pad;
+      packed.timeBin = data.timebin;
+      packed.size = data.size;
+    }
   }
 }
 
@@ -361,7 +612,8 @@ void BoxClusterer::GetPadAndTimeBin(Int_t bin, Short_t& iPad, Short_t& iTimeBin)
 }
 
 //_____________________________________________________________________
-Int_t BoxClusterer::Update(const Int_t iCRU,
+Int_t BoxClusterer::Update(WorkArrays *work,
+			   const Int_t iCRU,
 			   const Int_t iRow,
 			   const Int_t iPad,
 			   const Int_t iTimeBin,
@@ -384,9 +636,8 @@ Int_t BoxClusterer::Update(const Int_t iCRU,
   // array even for (0, 0) has a valid 5x5 matrix.
   Int_t bin = (iPad+2)*(mTimeBinsMax+4) + (iTimeBin+2);
 
-  mAllBins[iRow][bin] = signal;
-  mAllSigBins[iRow][mAllNSigBins[iRow]] = bin;
-  mAllNSigBins[iRow]++;
+  work->allBins[iRow][bin] = signal;
+  work->addSignal(iRow, bin);
 
   return 1; // signal was accepted
 }
@@ -1,5 +1,6 @@
 #include "TPCSimulation/ClusterContainer.h"
 #include "TPCSimulation/Cluster.h"
+#include "MemoryArena/MemoryAccountant.h"
 
 #include "FairLogger.h"
 
@@ -11,6 +12,7 @@ using namespace AliceO2::TPC;
 //________________________________________________________________________
 ClusterContainer::ClusterContainer():
   mNclusters(0),
+  mMemoryScopeId(-1),
   mClusterArray(nullptr)
 {}
 
@@ -70,4 +72,21 @@ void ClusterContainer::FillOutputContainer(TClonesArray *output)
     Cluster* cluster = dynamic_cast<Cluster*>(mClusterArray->At(n));
     new (outputRef[n]) Cluster(*cluster);
   }
+  accountMemory();
+}
+
+//________________________________________________________________________
+void ClusterContainer::accountMemory()
+{
+  if(!AliceO2::Memory::MemoryAccountant::IsEnabled()) return;
+  auto &accountant = AliceO2::Memory::MemoryAccountant::Instance();
+  if(mMemoryScopeId < 0) {
+    mMemoryScopeId = accountant.RegisterScope("TPC/ClusterContainer");
+  }
+  // allocated array slots at the stored cluster size
+  size_t bytes = 0;
+  if(mClusterArray && mClusterArray->GetClass()) {
+    bytes = mClusterArray->GetSize() * mClusterArray->GetClass()->Size();
+  }
+  accountant.Update(mMemoryScopeId, bytes);
 }
@@ -0,0 +1,102 @@
+#include "TPCSimulation/ClusterContainerFlat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace AliceO2::TPC;
+
+namespace {
+// one stable counting-sort pass over a radix byte of the pad key, in -> out
+void radixPass(const ClusterContainerFlat::PackedCluster* in,
+               ClusterContainerFlat::PackedCluster* out, Int_t n, Int_t shift)
+{
+  Int_t count[256] = {0};
+  for(Int_t i = 0; i < n; ++i) {
+    ++count[(in[i].record.pad >> shift) & 0xFF];
+  }
+  Int_t offset = 0;
+  for(Int_t bucket = 0; bucket < 256; ++bucket) {
+    const Int_t c = count[bucket];
+    count[bucket] = offset;
+    offset += c;
+  }
+  for(Int_t i = 0; i < n; ++i) {
+    out[count[(in[i].record.pad >> shift) & 0xFF]++] = in[i];
+  }
+}
+}
+
+ClusterContainerFlat::ClusterContainerFlat(Int_t numOfCRUs, Int_t rowsPerCRU):
+mRowsPerCRU(rowsPerCRU),
+mLastSlice(-1),
+mClusters(),
+mSliceStart(numOfCRUs*rowsPerCRU, -1),
+mSliceSize(numOfCRUs*rowsPerCRU, 0),
+mTouchedSlices()
+{}
+
+ClusterContainerFlat::~ClusterContainerFlat()
+{}
+
+void ClusterContainerFlat::reset() {
+  for(auto slice : mTouchedSlices) {
+    mSliceStart[slice] = -1;
+    mSliceSize[slice] = 0;
+  }
+  mTouchedSlices.clear();
+  mClusters.clear();
+  mLastSlice = -1;
+}
+
+void ClusterContainerFlat::sortClusters(Int_t numOfThreads) {
+  if(mTouchedSlices.empty()) return;
+
+  // pad order within the rows: a stable two-pass radix sort of every filled
+  // slice over the 16 bit pad key of the packed record; the filled slices
+  // are distributed over the workers through a shared counter
+  std::atomic<Int_t> nextSlice(0);
+  const Int_t numOfSlices = static_cast<Int_t>(mTouchedSlices.size());
+  auto sortSlices = [this, &nextSlice, numOfSlices]() {
+    std::vector<PackedCluster> scratch;
+    while(true) {
+      const Int_t i = nextSlice++;
+      if(i >= numOfSlices) break;
+      const Int_t slice = mTouchedSlices[i];
+      const Int_t n = mSliceSize[slice];
+      if(n < 2) continue;
+      scratch.resize(n);
+      PackedCluster* data = &mClusters[mSliceStart[slice]];
+      radixPass(data, scratch.data(), n, 0);
+      radixPass(scratch.data(), data, n, 8);
+    }
+  };
+  if(numOfThreads > 1) {
+    std::vector<std::thread> workers;
+    for(Int_t iThread = 0; iThread < numOfThreads; ++iThread) {
+      workers.emplace_back(sortSlices);
+    }
+    for(auto &worker : workers) {
+      worker.join();
+    }
+  }
+  else {
+    sortSlices();
+  }
+
+  // row order of the store: when the slices were not appended in (CRU, row)
+  // order, rebuild the vector in index order so a linear walk over
+  // getClusters() sees ascending (CRU, row) as well
+  if(!std::is_sorted(mTouchedSlices.begin(), mTouchedSlices.end())) {
+    std::sort(mTouchedSlices.begin(), mTouchedSlices.end());
+    std::vector<PackedCluster> ordered;
+    ordered.reserve(mClusters.size());
+    for(auto slice : mTouchedSlices) {
+      const Int_t start = mSliceStart[slice];
+      mSliceStart[slice] = static_cast<Int_t>(ordered.size());
+      ordered.insert(ordered.end(), mClusters.begin() + start,
+                     mClusters.begin() + start + mSliceSize[slice]);
+    }
+    mClusters.swap(ordered);
+  }
+}
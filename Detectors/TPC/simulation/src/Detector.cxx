@@ -1,5 +1,6 @@
 #include "TPCSimulation/Detector.h"
 #include "TPCSimulation/Point.h"
+#include "TPCSimulation/PointCache.h"
 
 #include "SimulationDataFormat/DetectorList.h"
 #include "SimulationDataFormat/Stack.h"
@@ -164,6 +165,16 @@ void Detector::EndOfEvent()
 
 }
 
+void Detector::FinishEvent()
+{
+
+  // flush the points accumulated during the stepping into the registered
+  // container; called by FairMCApplication before the output tree is filled
+  mPointArena.fillOutputContainer(mPointCollection);
+  mPointArena.clear();
+
+}
+
 
 
 void Detector::Register()
@@ -189,6 +200,7 @@ TClonesArray* Detector::GetCollection(Int_t iColl) const
 void Detector::Reset()
 {
   mPointCollection->Clear();
+  mPointArena.clear();
 }
 
 void Detector::ConstructGeometry()
@@ -2930,10 +2942,17 @@ Point* Detector::AddHit(Int_t trackID, Int_t detID,
                                       Double_t time, Double_t length,
                                       Double_t eLoss)
 {
-  TClonesArray& clref = *mPointCollection;
-  Int_t size = clref.GetEntriesFast();
-  return new(clref[size]) Point(trackID, detID, pos, mom,
-         time, length, eLoss);
+  PointCache &cache = PointCache::instance();
+  if(cache.isEnabled()) {
+    // in-memory hand-off to the digitizer, skipping the TClonesArray
+    // intermediary and the FairRoot branch round-trip
+    cache.addPoint(PointData{static_cast<Float_t>(pos.X()), static_cast<Float_t>(pos.Y()),
+                             static_cast<Float_t>(pos.Z()), static_cast<Float_t>(time),
+                             static_cast<Float_t>(eLoss), trackID, detID});
+    return nullptr;
+  }
+
+  return mPointArena.construct(trackID, detID, pos, mom, time, length, eLoss);
 }
 
 
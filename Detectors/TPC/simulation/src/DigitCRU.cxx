@@ -3,6 +3,7 @@
 #include "TPCBase/Mapper.h"
 
 #include "FairLogger.h"
+#include "TMath.h"
 using namespace AliceO2::TPC;
 
 #include <iostream>
@@ -36,6 +37,17 @@ void DigitCRU::setDigit(Int_t timeBin, Int_t row, Int_t pad, Float_t charge) {
   }
 }
 
+void DigitCRU::fillCompletedTimeBins(TClonesArray *output, Int_t cru, Int_t lastTimeBin) {
+  const Int_t nBins = TMath::Min(static_cast<Int_t>(mTimeBins.size()), lastTimeBin);
+  for(Int_t bin = 0; bin < nBins; ++bin) {
+    DigitTime *aTime = mTimeBins[bin];
+    if(aTime == nullptr) continue;
+    aTime->fillOutputContainer(output, cru, aTime->getTimeBin());
+    delete aTime;
+    mTimeBins[bin] = nullptr;
+  }
+}
+
 void DigitCRU::fillOutputContainer(TClonesArray *output, Int_t cru) {
   for(auto &aTime : mTimeBins) {
     if(aTime == nullptr) continue;
@@ -2,6 +2,7 @@
 #include "TPCSimulation/DigitCRU.h"
 #include "TPCBase/Mapper.h"
 #include "TPCBase/CRU.h"
+#include "MemoryArena/MemoryAccountant.h"
 
 #include "FairLogger.h"
 
@@ -10,6 +11,7 @@
 using namespace AliceO2::TPC;
 
 DigitContainer::DigitContainer():
+mMemoryScopeId(-1),
 mCRU(CRU::MaxCRU)
 {}
 
@@ -34,9 +36,54 @@ void DigitContainer::addDigit(Int_t cru, Int_t timeBin, Int_t row, Int_t pad, Fl
 }
 
 
+void DigitContainer::merge(DigitContainer *other)
+{
+  for(auto &aCRU : other->getCRUs()) {
+    if(aCRU == nullptr) continue;
+    const Int_t cru = aCRU->getCRUID();
+    for(auto &aTime : aCRU->getTimeBins()) {
+      if(aTime == nullptr) continue;
+      const Int_t timeBin = aTime->getTimeBin();
+      for(auto &aRow : aTime->getRows()) {
+        if(aRow == nullptr) continue;
+        const Int_t row = aRow->getRow();
+        for(auto &aPad : aRow->getFiredPads()) {
+          addDigit(cru, timeBin, row, aPad, aRow->getCharge(aPad));
+        }
+      }
+    }
+  }
+}
+
+void DigitContainer::fillCompletedTimeBins(TClonesArray *output, Int_t lastTimeBin) {
+  for(auto &aCRU : mCRU) {
+    if(aCRU == nullptr) continue;
+    aCRU->fillCompletedTimeBins(output, aCRU->getCRUID(), lastTimeBin);
+  }
+}
+
 void DigitContainer::fillOutputContainer(TClonesArray *output) {
     for(auto &aCRU : mCRU) {
     if(aCRU == nullptr) continue;
     aCRU->fillOutputContainer(output, aCRU->getCRUID());
   }
+  accountMemory();
+}
+
+size_t DigitContainer::getMemoryUsage() const {
+  size_t bytes = sizeof(*this) + mCRU.capacity() * sizeof(DigitCRU*);
+  for(const auto &aCRU : mCRU) {
+    if(aCRU == nullptr) continue;
+    bytes += aCRU->getMemoryUsage();
+  }
+  return bytes;
+}
+
+void DigitContainer::accountMemory() {
+  if(!AliceO2::Memory::MemoryAccountant::IsEnabled()) return;
+  auto &accountant = AliceO2::Memory::MemoryAccountant::Instance();
+  if(mMemoryScopeId < 0) {
+    mMemoryScopeId = accountant.RegisterScope("TPC/DigitContainer");
+  }
+  accountant.Update(mMemoryScopeId, getMemoryUsage());
 }
\ No newline at end of file
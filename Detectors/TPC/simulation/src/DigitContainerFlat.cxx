@@ -0,0 +1,66 @@
+#include "TPCSimulation/DigitContainerFlat.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/CRU.h"
+
+#include "FairLogger.h"
+
+#include "TClonesArray.h"
+
+#include <algorithm>
+
+using namespace AliceO2::TPC;
+
+DigitContainerFlat::DigitContainerFlat():
+mChargeMap(CRU::MaxCRU),
+mOccupiedBins(CRU::MaxCRU),
+mRowOffset(CRU::MaxCRU),
+mPadsPerCRU(CRU::MaxCRU)
+{}
+
+DigitContainerFlat::~DigitContainerFlat()
+{}
+
+void DigitContainerFlat::reset() {
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    for(auto bin : mOccupiedBins[cru]) {
+      mChargeMap[cru][bin] = 0.f;
+    }
+    mOccupiedBins[cru].clear();
+  }
+}
+
+void DigitContainerFlat::initCRU(Int_t cru) {
+  const Mapper& mapper = Mapper::instance();
+  const PadRegionInfo& region = mapper.getPadRegionInfo(CRU(cru).region());
+  const Int_t nRows = region.getNumberOfPadRows();
+  mRowOffset[cru].resize(nRows);
+  UShort_t offset = 0;
+  for(Int_t row = 0; row < nRows; ++row) {
+    mRowOffset[cru][row] = offset;
+    offset += region.getPadsInRowRegion(row);
+  }
+  mPadsPerCRU[cru] = offset;
+  mChargeMap[cru].resize(static_cast<size_t>(mTimeBinChunk)*offset, 0.f);
+}
+
+void DigitContainerFlat::fillOutputContainer(TClonesArray *output) {
+  Digitizer d;
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    if(mOccupiedBins[cru].empty()) continue;
+    // sort to recover the time bin -> row -> pad output order of the pointer-tree container
+    std::sort(mOccupiedBins[cru].begin(), mOccupiedBins[cru].end());
+    const std::vector<UShort_t> &rowOffset = mRowOffset[cru];
+    for(auto bin : mOccupiedBins[cru]) {
+      const Int_t timeBin = bin/mPadsPerCRU[cru];
+      const Int_t padInCRU = bin%mPadsPerCRU[cru];
+      Int_t row = std::upper_bound(rowOffset.begin(), rowOffset.end(), padInCRU) - rowOffset.begin() - 1;
+      const Int_t pad = padInCRU - rowOffset[row];
+      const Int_t adc = d.ADCvalue(mChargeMap[cru][bin]);
+      if(adc > 0) {
+        TClonesArray &clref = *output;
+        new(clref[clref.GetEntriesFast()]) Digit(cru, adc, row, pad, timeBin);
+      }
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#include "TPCSimulation/DigitContainerTiled.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/Digit.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/CRU.h"
+
+#include "TClonesArray.h"
+
+using namespace AliceO2::TPC;
+
+DigitContainerTiled::DigitContainerTiled():
+mRows(CRU::MaxCRU),
+mTilePool(),
+mTilesUsed(0)
+{}
+
+DigitContainerTiled::~DigitContainerTiled()
+{}
+
+void DigitContainerTiled::reset() {
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    for(auto &grid : mRows[cru]) {
+      Bool_t occupied = kFALSE;
+      for(auto word : grid.bitmap) occupied |= word != 0;
+      if(!occupied) continue;
+      grid.tile.assign(grid.tile.size(), -1);
+      grid.bitmap.assign(grid.bitmap.size(), 0);
+    }
+  }
+  // the allocated tiles are zeroed for reuse, the pool keeps its capacity
+  std::fill(mTilePool.begin(), mTilePool.begin() + static_cast<size_t>(mTilesUsed)*mTileCells, 0.f);
+  mTilesUsed = 0;
+}
+
+void DigitContainerTiled::initCRU(Int_t cru) {
+  const Mapper& mapper = Mapper::instance();
+  const PadRegionInfo& region = mapper.getPadRegionInfo(CRU(cru).region());
+  const Int_t nRows = region.getNumberOfPadRows();
+  mRows[cru].resize(nRows);
+  for(Int_t row = 0; row < nRows; ++row) {
+    RowGrid &grid = mRows[cru][row];
+    grid.padTiles = (region.getPadsInRowRegion(row) + mTileSize - 1)/mTileSize;
+    grid.tile.assign(static_cast<size_t>(mTimeTileChunk)*grid.padTiles, -1);
+    grid.bitmap.assign((grid.tile.size() + 63)/64, 0);
+  }
+}
+
+void DigitContainerTiled::getOccupiedTiles(Int_t cru, std::vector<Tile> &tiles) const {
+  tiles.clear();
+  for(size_t row = 0; row < mRows[cru].size(); ++row) {
+    const RowGrid &grid = mRows[cru][row];
+    for(size_t word = 0; word < grid.bitmap.size(); ++word) {
+      ULong64_t bits = grid.bitmap[word];
+      if(!bits) continue;
+      for(Int_t bit = 0; bits; ++bit, bits >>= 1) {
+        if(!(bits & 1)) continue;
+        const Int_t gridBin = word*64 + bit;
+        tiles.emplace_back(Tile{static_cast<Int_t>(row),
+                                (gridBin%grid.padTiles)*mTileSize,
+                                (gridBin/grid.padTiles)*mTileSize,
+                                mTilePool.data() + static_cast<size_t>(grid.tile[gridBin])*mTileCells});
+      }
+    }
+  }
+}
+
+void DigitContainerTiled::fillOutputContainer(TClonesArray *output) {
+  Digitizer d;
+  std::vector<Tile> tiles;
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    if(mRows[cru].empty()) continue;
+    getOccupiedTiles(cru, tiles);
+    if(tiles.empty()) continue;
+
+    // group the tiles into time-tile bands to recover the
+    // time bin -> row -> pad output order of the pointer-tree container;
+    // within a band the tiles already arrive in row and pad order
+    Int_t maxBand = 0;
+    for(const auto &tile : tiles) {
+      if(tile.timeBinOrigin/mTileSize > maxBand) maxBand = tile.timeBinOrigin/mTileSize;
+    }
+    std::vector<std::vector<const Tile*>> tilesOfBand(maxBand + 1);
+    for(const auto &tile : tiles) {
+      tilesOfBand[tile.timeBinOrigin/mTileSize].emplace_back(&tile);
+    }
+
+    for(Int_t band = 0; band <= maxBand; ++band) {
+      for(Int_t localTimeBin = 0; localTimeBin < mTileSize; ++localTimeBin) {
+        for(const Tile *tile : tilesOfBand[band]) {
+          const Float_t *cells = tile->cells + localTimeBin*mTileSize;
+          for(Int_t localPad = 0; localPad < mTileSize; ++localPad) {
+            if(cells[localPad] == 0.f) continue;
+            const Int_t adc = d.ADCvalue(cells[localPad]);
+            if(adc > 0) {
+              TClonesArray &clref = *output;
+              new(clref[clref.GetEntriesFast()]) Digit(cru, adc, tile->row,
+                                                       tile->padOrigin + localPad,
+                                                       tile->timeBinOrigin + localTimeBin);
+            }
+          }
+        }
+      }
+    }
+  }
+}
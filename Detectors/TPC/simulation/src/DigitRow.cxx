@@ -1,35 +1,25 @@
 #include "TPCSimulation/DigitRow.h"
-#include "TPCSimulation/DigitPad.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/Digit.h"
+
+#include "TClonesArray.h"
 #include "FairLogger.h"
 using namespace AliceO2::TPC;
 
 DigitRow::DigitRow(Int_t row, Int_t npads):
 mRow(row),
-mPads(npads)
+mPadCharge(npads)
 {}
 
-DigitRow::~DigitRow() {
-  for(auto &aPad : mPads) {
-    if(aPad == nullptr) continue;
-    delete aPad;
-  }
-}
-
-void DigitRow::setDigit(Int_t pad, Float_t charge) {
-  DigitPad *result = mPads[pad];
-  if(result != nullptr) {
-    mPads[pad]->setDigit(charge);
-  }
-  else{
-    mPads[pad] = new DigitPad(pad);
-    mPads[pad]->setDigit(charge);
-  }
-}
-
+DigitRow::~DigitRow() {}
 
 void DigitRow::fillOutputContainer(TClonesArray *output, Int_t cru, Int_t timeBin, Int_t row) {
-  for(auto &aPad : mPads) {
-    if(aPad == nullptr) continue;
-    aPad->fillOutputContainer(output, cru, timeBin, row, aPad->getPad());
+  Digitizer d;
+  for(auto &aPad : getFiredPads()) {
+    const Int_t mADC = d.ADCvalue(mPadCharge[aPad]);
+    if(mADC > 0) {
+      TClonesArray &clref = *output;
+      new(clref[clref.GetEntriesFast()]) Digit(cru, mADC, row, aPad, timeBin);
+    }
   }
 }
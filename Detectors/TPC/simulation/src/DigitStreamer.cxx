@@ -0,0 +1,90 @@
+#include "TPCSimulation/DigitStreamer.h"
+#include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/DigitCRU.h"
+#include "TPCSimulation/DigitTime.h"
+#include "TPCSimulation/DigitRow.h"
+#include "TPCSimulation/Digitizer.h"
+
+#include "FairLogger.h"
+
+#include <ostream>
+#include <istream>
+
+using namespace AliceO2::TPC;
+
+namespace {
+  template <typename T>
+  void writeColumn(std::ostream &out, const std::vector<T> &column) {
+    out.write(reinterpret_cast<const char*>(column.data()), column.size()*sizeof(T));
+  }
+
+  template <typename T>
+  void readColumn(std::istream &in, std::vector<T> &column, size_t nDigits) {
+    column.resize(nDigits);
+    in.read(reinterpret_cast<char*>(column.data()), nDigits*sizeof(T));
+  }
+}
+
+size_t DigitStreamer::streamDigits(DigitContainer *container, std::ostream &out)
+{
+  // gather the columns directly from the container storage, applying the
+  // same charge summation and ADC conversion as the TClonesArray output
+  DigitColumns columns;
+  Digitizer d;
+
+  for(auto &aCRU : container->getCRUs()) {
+    if(aCRU == nullptr) continue;
+    const Int_t cru = aCRU->getCRUID();
+    for(auto &aTime : aCRU->getTimeBins()) {
+      if(aTime == nullptr) continue;
+      const Int_t timeBin = aTime->getTimeBin();
+      for(auto &aRow : aTime->getRows()) {
+        if(aRow == nullptr) continue;
+        const Int_t row = aRow->getRow();
+        for(auto &aPad : aRow->getFiredPads()) {
+          const Int_t adc = d.ADCvalue(aRow->getCharge(aPad));
+          if(adc <= 0) continue;
+          columns.cru.emplace_back(cru);
+          columns.row.emplace_back(row);
+          columns.pad.emplace_back(aPad);
+          columns.timeBin.emplace_back(timeBin);
+          columns.adc.emplace_back(adc);
+        }
+      }
+    }
+  }
+
+  const UInt_t nDigits = columns.getNDigits();
+  out.write(reinterpret_cast<const char*>(&mMagicWord), sizeof(mMagicWord));
+  out.write(reinterpret_cast<const char*>(&mVersion), sizeof(mVersion));
+  out.write(reinterpret_cast<const char*>(&nDigits), sizeof(nDigits));
+  writeColumn(out, columns.cru);
+  writeColumn(out, columns.row);
+  writeColumn(out, columns.pad);
+  writeColumn(out, columns.timeBin);
+  writeColumn(out, columns.adc);
+
+  return nDigits;
+}
+
+size_t DigitStreamer::readDigits(std::istream &in, DigitColumns &columns)
+{
+  UInt_t magicWord = 0;
+  UInt_t version = 0;
+  UInt_t nDigits = 0;
+  in.read(reinterpret_cast<char*>(&magicWord), sizeof(magicWord));
+  in.read(reinterpret_cast<char*>(&version), sizeof(version));
+  in.read(reinterpret_cast<char*>(&nDigits), sizeof(nDigits));
+  if(!in || magicWord != mMagicWord || version != mVersion) {
+    LOG(ERROR) << "Not a TPC digit stream or unsupported version" << FairLogger::endl;
+    return 0;
+  }
+
+  readColumn(in, columns.cru, nDigits);
+  readColumn(in, columns.row, nDigits);
+  readColumn(in, columns.pad, nDigits);
+  readColumn(in, columns.timeBin, nDigits);
+  readColumn(in, columns.adc, nDigits);
+
+  return nDigits;
+}
@@ -3,10 +3,12 @@
 #include "TPCSimulation/Digitizer.h"
 #include "TPCSimulation/Point.h"
 #include "TPCSimulation/PadResponse.h"
+#include "TPCSimulation/RandomRing.h"
 
 #include "TPCBase/Mapper.h"
 
 #include "TRandom.h"
+#include "TRandom3.h"
 #include "TF1.h"
 #include "TClonesArray.h"
 #include "TCollection.h"
@@ -14,8 +16,11 @@
 
 #include "FairLogger.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <thread>
+#include <utility>
 
 ClassImp(AliceO2::TPC::Digitizer)
 
@@ -24,16 +29,37 @@ using namespace AliceO2::TPC;
 Digitizer::Digitizer():
 TObject(),
 mPolya(nullptr),
-mDigitContainer(nullptr)
+mDigitContainer(nullptr),
+mGEMAmplification(nullptr),
+mGEMLookupTableSize(65536),
+mPadResponseLUT(nullptr),
+mTimeBinOffset(0),
+mNumThreads(1),
+mRandom(nullptr)
 {}
 
 Digitizer::~Digitizer(){
   delete mDigitContainer;
+  delete mGEMAmplification;
+  delete mPadResponseLUT;
   delete mPolya;
+  delete mRandom;
+}
+
+void Digitizer::setRandomSeed(UInt_t seed){
+  if(mRandom == nullptr) mRandom = new TRandom3(seed);
+  else mRandom->SetSeed(seed);
+}
+
+void Digitizer::enablePadResponseLUT(){
+  if(mPadResponseLUT) return;
+  mPadResponseLUT = new PadResponseLUT();
+  mPadResponseLUT->init();
 }
 
 void Digitizer::init(){
   mDigitContainer = new DigitContainer();
+  mGEMAmplification = new GEMAmplification(0.78, mGEMLookupTableSize);
   Float_t SigmaOverMu = 0.78;
   Float_t kappa = 1/(SigmaOverMu*SigmaOverMu);
   Float_t s = 1/kappa;
@@ -43,93 +69,322 @@ void Digitizer::init(){
 //   mPolya = new TF1("polya", "1/x", 0, 1000);
 }
 
+ULong64_t Digitizer::presortKey(Float_t x, Float_t y, Float_t z) const {
+  const Mapper& mapper = Mapper::instance();
+  const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(GlobalPosition3D(x, y, z));
+  const UInt_t cru = digiPadPos.isValid() ? digiPadPos.getCRU().number() : CRU::MaxCRU;
+  const Int_t timeBin = getTimeBinFromTime(getTime(z));
+  return (static_cast<ULong64_t>(cru) << 32) | static_cast<UInt_t>(timeBin < 0 ? 0 : timeBin);
+}
+
+namespace {
+  // sort the (key, point) pairs collected by the presort stage; the sort is
+  // stable so points of the same cell keep their container order and the
+  // output is independent of the sort implementation
+  template <typename T>
+  void sortByKey(std::vector<std::pair<ULong64_t, T>> &points) {
+    std::stable_sort(points.begin(), points.end(),
+                     [](const std::pair<ULong64_t, T> &a, const std::pair<ULong64_t, T> &b) {
+                       return a.first < b.first;
+                     });
+  }
+}
+
 DigitContainer *Digitizer::Process(TClonesArray *points){
+  mDigitContainer->reset();
+
+  if(mNumThreads > 1) {
+    return ProcessParallel(points);
+  }
+
+  // presort by (CRU, time bin) so the accumulation streams through each time
+  // slice sequentially; the points then consume the shared random generator
+  // in sorted instead of container order, which only reshuffles the drawn
+  // numbers between statistically identical points
+  std::vector<std::pair<ULong64_t, Point*>> sortedPoints;
+  sortedPoints.reserve(points->GetEntriesFast());
+  for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter){
+    Point *inputpoint = static_cast<Point *>(*pointiter);
+    sortedPoints.emplace_back(presortKey(inputpoint->GetX(), inputpoint->GetY(), inputpoint->GetZ()), inputpoint);
+  }
+  sortByKey(sortedPoints);
+
+  TRandom *random = mRandom ? static_cast<TRandom*>(mRandom) : gRandom;
+  for(auto &point : sortedPoints) {
+    digitizePoint(point.second, mDigitContainer, random);
+  }
+  // end of loop over points
+
+  return mDigitContainer;
+}
+
+DigitContainer *Digitizer::Process(const std::vector<PointData> &points){
+  mDigitContainer->reset();
+
+  if(mNumThreads > 1) {
+    return ProcessParallel(points);
+  }
+
+  std::vector<std::pair<ULong64_t, const PointData*>> sortedPoints;
+  sortedPoints.reserve(points.size());
+  for(const auto &point : points) {
+    sortedPoints.emplace_back(presortKey(point.x, point.y, point.z), &point);
+  }
+  sortByKey(sortedPoints);
+
+  TRandom *random = mRandom ? static_cast<TRandom*>(mRandom) : gRandom;
+  for(const auto &point : sortedPoints) {
+    digitizePoint(point.second->x, point.second->y, point.second->z, point.second->eLoss, mDigitContainer, random);
+  }
+  // end of loop over points
+
+  return mDigitContainer;
+}
+
+DigitContainer *Digitizer::ProcessBatch(TClonesArray *points, Float_t batchTime){
+  mTimeBinOffset = getTimeBinFromTime(batchTime);
+
+  std::vector<std::pair<ULong64_t, Point*>> sortedPoints;
+  sortedPoints.reserve(points->GetEntriesFast());
+  for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter){
+    Point *inputpoint = static_cast<Point *>(*pointiter);
+    sortedPoints.emplace_back(presortKey(inputpoint->GetX(), inputpoint->GetY(), inputpoint->GetZ()), inputpoint);
+  }
+  sortByKey(sortedPoints);
+
+  TRandom *random = mRandom ? static_cast<TRandom*>(mRandom) : gRandom;
+  for(auto &point : sortedPoints) {
+    digitizePoint(point.second, mDigitContainer, random);
+  }
+  // end of loop over points
+
+  mTimeBinOffset = 0;
+  return mDigitContainer;
+}
+
+void Digitizer::fillCompletedTimeBins(TClonesArray *output, Float_t currentTime){
+  mDigitContainer->fillCompletedTimeBins(output, getTimeBinFromTime(currentTime));
+}
+
+DigitContainer *Digitizer::ProcessParallel(TClonesArray *points){
+  // TPC sectors are independent, so the points are partitioned by sector and
+  // each worker thread digitizes a disjoint set of sectors into its own
+  // container. The per-worker containers are merged at the end.
+  std::vector<std::vector<std::pair<ULong64_t, Point*>>> pointsPerSector(Sector::MaxSector);
+
+  for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter){
+    Point *inputpoint = static_cast<Point *>(*pointiter);
+    Double_t phi = TMath::ATan2(inputpoint->GetY(), inputpoint->GetX());
+    if(phi < 0.) phi += TWOPI;
+    const Int_t sector = static_cast<int>(phi/SECPHIWIDTH) + (inputpoint->GetZ() < 0)*SECTORSPERSIDE;
+    pointsPerSector[sector].emplace_back(presortKey(inputpoint->GetX(), inputpoint->GetY(), inputpoint->GetZ()), inputpoint);
+  }
+
+  // each sector streams through its time slices as well
+  for(auto &sectorPoints : pointsPerSector) {
+    sortByKey(sectorPoints);
+  }
+
+  const Int_t numThreads = TMath::Min(mNumThreads, static_cast<Int_t>(Sector::MaxSector));
+  std::vector<DigitContainer*> containers(numThreads);
+  std::vector<std::thread> workers;
+
+  // gRandom is not thread safe, each worker gets its own generator
+  const UInt_t seed = (mRandom ? static_cast<TRandom*>(mRandom) : gRandom)->Integer(kMaxInt);
+
+  for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+    containers[iThread] = new DigitContainer();
+    workers.emplace_back([this, iThread, numThreads, seed, &containers, &pointsPerSector]() {
+      TRandom3 random(seed + iThread);
+      for(Int_t sector = iThread; sector < Sector::MaxSector; sector += numThreads) {
+        for(auto &inputpoint : pointsPerSector[sector]) {
+          digitizePoint(inputpoint.second, containers[iThread], &random);
+        }
+      }
+    });
+  }
+
+  for(auto &worker : workers) {
+    worker.join();
+  }
+
+  for(auto &container : containers) {
+    mDigitContainer->merge(container);
+    delete container;
+  }
+
+  return mDigitContainer;
+}
+
+DigitContainer *Digitizer::ProcessParallel(const std::vector<PointData> &points){
+  // same sector partitioning as the TClonesArray version, operating on the
+  // in-memory point data
+  std::vector<std::vector<std::pair<ULong64_t, const PointData*>>> pointsPerSector(Sector::MaxSector);
+
+  for(const auto &point : points) {
+    Double_t phi = TMath::ATan2(point.y, point.x);
+    if(phi < 0.) phi += TWOPI;
+    const Int_t sector = static_cast<int>(phi/SECPHIWIDTH) + (point.z < 0)*SECTORSPERSIDE;
+    pointsPerSector[sector].emplace_back(presortKey(point.x, point.y, point.z), &point);
+  }
+
+  // each sector streams through its time slices as well
+  for(auto &sectorPoints : pointsPerSector) {
+    sortByKey(sectorPoints);
+  }
+
+  const Int_t numThreads = TMath::Min(mNumThreads, static_cast<Int_t>(Sector::MaxSector));
+  std::vector<DigitContainer*> containers(numThreads);
+  std::vector<std::thread> workers;
+
+  // gRandom is not thread safe, each worker gets its own generator
+  const UInt_t seed = (mRandom ? static_cast<TRandom*>(mRandom) : gRandom)->Integer(kMaxInt);
+
+  for(Int_t iThread = 0; iThread < numThreads; ++iThread) {
+    containers[iThread] = new DigitContainer();
+    workers.emplace_back([this, iThread, numThreads, seed, &containers, &pointsPerSector]() {
+      TRandom3 random(seed + iThread);
+      for(Int_t sector = iThread; sector < Sector::MaxSector; sector += numThreads) {
+        for(auto &inputpoint : pointsPerSector[sector]) {
+          digitizePoint(inputpoint.second->x, inputpoint.second->y, inputpoint.second->z,
+                        inputpoint.second->eLoss, containers[iThread], &random);
+        }
+      }
+    });
+  }
+
+  for(auto &worker : workers) {
+    worker.join();
+  }
+
+  for(auto &container : containers) {
+    mDigitContainer->merge(container);
+    delete container;
+  }
+
+  return mDigitContainer;
+}
+
+void Digitizer::digitizePoint(Point *inputpoint, DigitContainer *digitContainer, TRandom *random){
+  digitizePoint(inputpoint->GetX(), inputpoint->GetY(), inputpoint->GetZ(),
+                inputpoint->GetEnergyLoss(), digitContainer, random);
+}
+
+void Digitizer::digitizePoint(Float_t x, Float_t y, Float_t z, Float_t eLoss, DigitContainer *digitContainer, TRandom *random){
   // TODO should be parametrized
   Float_t wIon = 37.3e-6;
   Float_t attCoef = 250.;
   Float_t OxyCont = 5.e-6;
   Float_t driftV = 2.58;
   Float_t zBinWidth = 0.19379844961;
-  
-  mDigitContainer->reset();
+
+  const Mapper& mapper = Mapper::instance();
 
   Float_t posEle[4] = {0., 0., 0., 0.};
 
-  const Mapper& mapper = Mapper::instance();
-  
-  Int_t A = 0;
-  Int_t C = 0;
-  
-  for (TIter pointiter = TIter(points).Begin(); pointiter != TIter::End(); ++pointiter){
-    Point *inputpoint = static_cast<Point *>(*pointiter);
-    
-    posEle[0] = inputpoint->GetX();
-    posEle[1] = inputpoint->GetY();
-    posEle[2] = inputpoint->GetZ();
-    posEle[3] = static_cast<int>(inputpoint->GetEnergyLoss()/wIon);
-    
-    //Loop over electrons
-    for(Int_t iEle=0; iEle < posEle[3]; ++iEle){
-      
-      // Attachment
-      const Float_t attProb = attCoef * OxyCont * getTime(posEle[2]);
-      if((gRandom->Rndm(0)) < attProb) continue;
-
-      // Drift and Diffusion
-      ElectronDrift(posEle);
-
-      // remove electrons that end up outside the active volume
-      if(TMath::Abs(posEle[2]) > 250.) continue;
-
-      const GlobalPosition3D posElePad (posEle[0], posEle[1], posEle[2]);
-      const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posElePad);
-       
-      if(!digiPadPos.isValid()) continue;
-       
-      // GEM amplification
-      // Gain values taken from TDR addendum - to be put someplace else
-      Int_t nEleGEM1 = SingleGEMAmplification(1, 9.1);
-      Int_t nEleGEM2 = SingleGEMAmplification(nEleGEM1, 0.88);
-      Int_t nEleGEM3 = SingleGEMAmplification(nEleGEM2, 1.66);
-      Int_t nEleGEM4 = SingleGEMAmplification(nEleGEM3, 144);
-      
-      // Loop over all individual pads with signal due to pad response function
-      getPadResponse(posEle[0], posEle[1], mPadResponse);
-      for(auto &padresp : mPadResponse ) {
-        const Int_t pad = digiPadPos.getPadPos().getPad() + padresp.getPad();
-        const Int_t row = digiPadPos.getPadPos().getRow() + padresp.getRow();
-        const Float_t weight = padresp.getWeight();
-        
-        const Float_t startTime = getTime(posEle[2]);
-        
-        // Loop over all time bins with signal due to time response
-        for(Float_t bin = 0; bin<5; ++bin){
-          Double_t signal = 55*Gamma4(startTime+bin*zBinWidth, startTime, nEleGEM4*weight);
-          mDigitContainer->addDigit(digiPadPos.getCRU().number(), getTimeBinFromTime(startTime+bin*zBinWidth), row, pad, signal);
-        }
-        // end of loop over time bins
+  posEle[0] = x;
+  posEle[1] = y;
+  posEle[2] = z;
+  posEle[3] = static_cast<int>(eLoss/wIon);
+
+  //Loop over electrons
+  for(Int_t iEle=0; iEle < posEle[3]; ++iEle){
+
+    // Attachment
+    const Float_t attProb = attCoef * OxyCont * getTime(posEle[2]);
+    if((random->Rndm(0)) < attProb) continue;
+
+    // Drift and Diffusion
+    ElectronDrift(posEle, random);
+
+    // remove electrons that end up outside the active volume
+    if(TMath::Abs(posEle[2]) > 250.) continue;
+
+    const GlobalPosition3D posElePad (posEle[0], posEle[1], posEle[2]);
+    const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posElePad);
+
+    if(!digiPadPos.isValid()) continue;
+
+    // GEM amplification
+    // Gain values taken from TDR addendum - to be put someplace else
+    Int_t nEleGEM1 = SingleGEMAmplification(1, 9.1, random);
+    Int_t nEleGEM2 = SingleGEMAmplification(nEleGEM1, 0.88, random);
+    Int_t nEleGEM3 = SingleGEMAmplification(nEleGEM2, 1.66, random);
+    Int_t nEleGEM4 = SingleGEMAmplification(nEleGEM3, 144, random);
+
+    // Loop over all individual pads with signal due to pad response function
+    std::vector<PadResponse> padResponse;
+    if(mPadResponseLUT) {
+      // fractional position of the charge within the pad, same conventions
+      // as PadRegionInfo::findPad
+      const CRU cru = digiPadPos.getCRU();
+      const PadRegionInfo &region = mapper.getPadRegionInfo(cru.region());
+      const LocalPosition3D posLoc = Mapper::GlobalToLocal(posElePad, cru.sector().phi());
+      const Int_t rowInRegion = digiPadPos.getPadPos().getRow();
+      const Int_t padInRow = digiPadPos.getPadPos().getPad();
+      const Float_t fracX = (posLoc.getX()-region.getRadiusFirstRow())/region.getPadHeight() - rowInRegion;
+      const Float_t localYfactor = (cru.side()==Side::A)?-1.f:1.f;
+      const UInt_t npads = region.getPadsInRowRegion(rowInRegion);
+      const Float_t fracY = (npads/2*region.getPadWidth()-localYfactor*posLoc.getY())/region.getPadWidth() - padInRow;
+      mPadResponseLUT->getPadResponse(cru.region(), fracX, fracY, padResponse);
+    }
+    else {
+      getPadResponse(posEle[0], posEle[1], padResponse);
+    }
+    for(auto &padresp : padResponse ) {
+      const Int_t pad = digiPadPos.getPadPos().getPad() + padresp.getPad();
+      const Int_t row = digiPadPos.getPadPos().getRow() + padresp.getRow();
+      const Float_t weight = padresp.getWeight();
+
+      const Float_t startTime = getTime(posEle[2]);
+
+      // Loop over all time bins with signal due to time response
+      for(Float_t bin = 0; bin<5; ++bin){
+        Double_t signal = 55*Gamma4(startTime+bin*zBinWidth, startTime, nEleGEM4*weight);
+        digitContainer->addDigit(digiPadPos.getCRU().number(), getTimeBinFromTime(startTime+bin*zBinWidth)+mTimeBinOffset, row, pad, signal);
       }
-      // end of loop over pads
+      // end of loop over time bins
     }
-    //end of loop over electrons
+    // end of loop over pads
   }
-  // end of loop over points
+  //end of loop over electrons
+}
 
-  return mDigitContainer;
+void Digitizer::ElectronDrift(Float_t *posEle) const {
+  ElectronDrift(posEle, gRandom);
 }
 
+void Digitizer::ElectronDrift(std::vector<Float_t> &x, std::vector<Float_t> &y, std::vector<Float_t> &z) const {
+  // TODO parameters to be stored someplace else
+  Float_t DiffT = 0.0209;
+  Float_t DiffL = 0.0221;
 
-void Digitizer::ElectronDrift(Float_t *posEle) const {
+  static thread_local RandomRing<> randomGaus;
+
+  const size_t nElectrons = x.size();
+  for(size_t iEle = 0; iEle < nElectrons; ++iEle) {
+    Float_t driftl = z[iEle];
+    if(driftl < 0.01) driftl = 0.01;
+    driftl = TMath::Sqrt(driftl);
+    const Float_t sigT = driftl*DiffT;
+    const Float_t sigL = driftl*DiffL;
+    x[iEle] += sigT*randomGaus.getNextValue();
+    y[iEle] += sigT*randomGaus.getNextValue();
+    z[iEle] += sigL*randomGaus.getNextValue();
+  }
+}
+
+void Digitizer::ElectronDrift(Float_t *posEle, TRandom *random) const {
   // TODO parameters to be stored someplace else
   Float_t DiffT = 0.0209;
   Float_t DiffL = 0.0221;
-  
+
   Float_t driftl=posEle[2];
   if(driftl<0.01) driftl=0.01;
   driftl=TMath::Sqrt(driftl);
   Float_t sigT = driftl*DiffT;
   Float_t sigL = driftl*DiffL;
-  posEle[0]=gRandom->Gaus(posEle[0],sigT);
-  posEle[1]=gRandom->Gaus(posEle[1],sigT);
-  posEle[2]=gRandom->Gaus(posEle[2],sigL);
+  posEle[0]=random->Gaus(posEle[0],sigT);
+  posEle[1]=random->Gaus(posEle[1],sigT);
+  posEle[2]=random->Gaus(posEle[2],sigL);
 }
\ No newline at end of file
@@ -1,21 +1,46 @@
 #include "TPCSimulation/DigitizerTask.h"
+#include "TPCSimulation/BackgroundEventCache.h" // for BackgroundEventCache
 #include "TPCSimulation/DigitContainer.h"  // for DigitContainer
+#include "TPCSimulation/DigitStreamer.h"   // for DigitStreamer
+#include "TPCSimulation/PointCache.h"      // for PointCache
 #include "TPCSimulation/Digitizer.h"       // for Digitizer
+#include "TPCSimulation/Point.h"           // for Point
+#include "MathUtils/RandomStream.h"        // for RandomStream
 
 #include "TObject.h"
 #include "TClonesArray.h"
+#include "TCollection.h"
+#include "TRandom.h"
 #include "FairLogger.h"
 #include "FairRootManager.h"
 
+#include <utility>
+
 ClassImp(AliceO2::TPC::DigitizerTask)
 
 using namespace AliceO2::TPC;
+using AliceO2::MathUtils::RandomStream;
+
+namespace {
+// subsystem tag of the digitizer random streams ('TPCD')
+const UInt_t kDigitizerStreamTag = 0x54504344;
+}
 
 DigitizerTask::DigitizerTask():
 FairTask("TPCDigitizerTask"),
 mDigitizer(nullptr),
 mPointsArray(nullptr),
-mDigitsArray(nullptr)
+mDigitsArray(nullptr),
+mBinaryOutputFileName(),
+mBinaryOutput(nullptr),
+mBackgroundFileName(),
+mBackgroundEventsPerSignal(0),
+mBackgroundCursor(0),
+mNumThreads(1),
+mMaxInFlight(0),
+mSlots(),
+mNextSequence(0),
+mNextToDeliver(0)
 {
   mDigitizer = new Digitizer;
 }
@@ -24,6 +49,7 @@ DigitizerTask::~DigitizerTask()
 {
   delete mDigitizer;
   if (mDigitsArray) delete mDigitsArray;
+  delete mBinaryOutput;
 }
 
 
@@ -34,26 +60,215 @@ InitStatus DigitizerTask::Init()
     LOG(ERROR) << "Could not instantiate FairRootManager. Exiting ..." << FairLogger::endl;
     return kERROR;
   }
-  
+
   mPointsArray = dynamic_cast<TClonesArray *>(mgr->GetObject("TPCPoint"));
-  if (!mPointsArray) {
+  if (!mPointsArray && !PointCache::instance().isEnabled()) {
     LOG(ERROR) << "TPC points not registered in the FairRootManager. Exiting ..." << FairLogger::endl;
     return kERROR;
   }
-  
+
   // Register output container
   mDigitsArray = new TClonesArray("AliceO2::TPC::Digit");
   mgr->Register("TPCDigit", "TPC", mDigitsArray, kTRUE);
-  
+
+  if(!mBinaryOutputFileName.empty()) {
+    mBinaryOutput = new std::ofstream(mBinaryOutputFileName, std::ios::out | std::ios::binary);
+    if(!mBinaryOutput->good()) {
+      LOG(ERROR) << "Could not open binary digit output file " << mBinaryOutputFileName << ". Exiting ..." << FairLogger::endl;
+      return kERROR;
+    }
+  }
+
+  if (!mBackgroundFileName.empty()) {
+    // loaded once per process, all tasks share the resident sample
+    if (BackgroundEventCache::instance().loadFile(mBackgroundFileName.c_str()) < 1) {
+      LOG(ERROR) << "Could not load background events from " << mBackgroundFileName
+                 << ". Exiting ..." << FairLogger::endl;
+      return kERROR;
+    }
+  }
+
+  mDigitizer->setNumThreads(mNumThreads);
   mDigitizer->init();
+
+  if(mMaxInFlight > 0 && !mBinaryOutput) {
+    LOG(WARNING) << "Asynchronous digitization delivers the digits through the binary output,"
+                 << " falling back to synchronous processing" << FairLogger::endl;
+    mMaxInFlight = 0;
+  }
+
+  for(Int_t iSlot = 0; iSlot < mMaxInFlight; ++iSlot) {
+    AsyncSlot *slot = new AsyncSlot();
+    slot->digitizer = new Digitizer;
+    slot->digitizer->setNumThreads(mNumThreads);
+    // gRandom is not thread safe, each slot digitizer gets its own generator;
+    // the slot is reseeded per event in enqueueEvent, so the digits of an
+    // event do not depend on the slot (and thus thread) count
+    slot->digitizer->setRandomSeed(RandomStream::deriveSeed(0, kDigitizerStreamTag, iSlot + 1));
+    slot->digitizer->init();
+    slot->worker = std::thread(&DigitizerTask::asyncWorkerLoop, this, slot);
+    mSlots.emplace_back(slot);
+  }
+
   return kSUCCESS;
 }
 
 void DigitizerTask::Exec(Option_t *option)
 {
+  if(!mSlots.empty()) {
+    LOG(DEBUG) << "Queueing event " << mNextSequence << " for asynchronous digitization" << FairLogger::endl;
+    enqueueEvent();
+    return;
+  }
+
   mDigitsArray->Delete();
   LOG(DEBUG) << "Running digitization on new event" << FairLogger::endl;
-  
-  DigitContainer *digits = mDigitizer->Process(mPointsArray);
-  digits->fillOutputContainer(mDigitsArray);
-}
\ No newline at end of file
+
+  // same per-event stream keying as the asynchronous path, so synchronous
+  // and asynchronous runs digitize identically
+  mDigitizer->setRandomSeed(RandomStream::deriveSeed(mNextSequence, kDigitizerStreamTag, 0));
+  ++mNextSequence;
+
+  DigitContainer *digits = nullptr;
+  if(PointCache::instance().isEnabled()) {
+    // consume the points handed over in memory by the stepping code
+    std::vector<PointData> &points = PointCache::instance().consumeBuffer();
+    overlayBackground(points);
+    digits = mDigitizer->Process(points);
+  }
+  else if(!mBackgroundFileName.empty()) {
+    // the overlay needs a mutable point set, snapshot the array
+    std::vector<PointData> points;
+    snapshotPoints(points);
+    overlayBackground(points);
+    digits = mDigitizer->Process(points);
+  }
+  else {
+    digits = mDigitizer->Process(mPointsArray);
+  }
+  if(mBinaryOutput) {
+    // stream the digits directly from the container storage, bypassing the
+    // per-digit TObject materialization in the TClonesArray
+    DigitStreamer::streamDigits(digits, *mBinaryOutput);
+  }
+  else {
+    digits->fillOutputContainer(mDigitsArray);
+  }
+}
+
+void DigitizerTask::enqueueEvent()
+{
+  AsyncSlot *slot = mSlots[mNextSequence % mSlots.size()];
+
+  // the slot last held the event mNextSequence - size; deliver completed
+  // events in order until it has been flushed and the slot is free again
+  while(mNextToDeliver + static_cast<ULong64_t>(mSlots.size()) <= mNextSequence) {
+    deliverNextResult();
+  }
+
+  std::vector<PointData> points;
+  if(PointCache::instance().isEnabled()) {
+    points = std::move(PointCache::instance().consumeBuffer());
+  }
+  else {
+    // snapshot the points, the TClonesArray is refilled by the next event
+    snapshotPoints(points);
+  }
+  overlayBackground(points);
+
+  {
+    std::lock_guard<std::mutex> lock(mAsyncMutex);
+    slot->points = std::move(points);
+    // the stream of an event is keyed by its sequence number, so the digits
+    // are reproducible across runs and in-flight event counts
+    slot->digitizer->setRandomSeed(RandomStream::deriveSeed(mNextSequence, kDigitizerStreamTag, 0));
+    slot->hasJob = kTRUE;
+  }
+  mJobCondition.notify_all();
+  ++mNextSequence;
+}
+
+void DigitizerTask::snapshotPoints(std::vector<PointData> &points)
+{
+  points.reserve(mPointsArray->GetEntriesFast());
+  for (TIter pointiter = TIter(mPointsArray).Begin(); pointiter != TIter::End(); ++pointiter){
+    Point *inputpoint = static_cast<Point *>(*pointiter);
+    points.emplace_back(PointData{static_cast<Float_t>(inputpoint->GetX()), static_cast<Float_t>(inputpoint->GetY()),
+                                  static_cast<Float_t>(inputpoint->GetZ()), static_cast<Float_t>(inputpoint->GetTime()),
+                                  static_cast<Float_t>(inputpoint->GetEnergyLoss()),
+                                  inputpoint->GetTrackID(), inputpoint->GetDetectorID()});
+  }
+}
+
+void DigitizerTask::overlayBackground(std::vector<PointData> &points)
+{
+  if (mBackgroundFileName.empty()) return;
+  for (Int_t iBackground = 0; iBackground < mBackgroundEventsPerSignal; ++iBackground) {
+    // additional shared owner, the event stays valid while any slot uses it
+    BackgroundEventCache::Event event = BackgroundEventCache::instance().acquireEvent(mBackgroundCursor++);
+    if (!event) return;
+    points.insert(points.end(), event->begin(), event->end());
+  }
+}
+
+void DigitizerTask::deliverNextResult()
+{
+  AsyncSlot *slot = mSlots[mNextToDeliver % mSlots.size()];
+
+  std::unique_lock<std::mutex> lock(mAsyncMutex);
+  mResultCondition.wait(lock, [slot]{ return slot->hasResult == kTRUE; });
+  lock.unlock();
+
+  // the digits stay in the slot digitizer's container until its next job
+  DigitStreamer::streamDigits(slot->digits, *mBinaryOutput);
+
+  lock.lock();
+  slot->digits = nullptr;
+  slot->hasResult = kFALSE;
+  ++mNextToDeliver;
+}
+
+void DigitizerTask::asyncWorkerLoop(AsyncSlot *slot)
+{
+  std::unique_lock<std::mutex> lock(mAsyncMutex);
+  for(;;) {
+    mJobCondition.wait(lock, [slot]{ return slot->hasJob || slot->shutdown; });
+    if(!slot->hasJob) break;
+    lock.unlock();
+
+    DigitContainer *digits = slot->digitizer->Process(slot->points);
+
+    lock.lock();
+    slot->digits = digits;
+    slot->hasJob = kFALSE;
+    slot->hasResult = kTRUE;
+    mResultCondition.notify_all();
+  }
+}
+
+void DigitizerTask::FinishTask()
+{
+  if(!mSlots.empty()) {
+    // drain the in-flight events in order, then stop the workers
+    while(mNextToDeliver < mNextSequence) {
+      deliverNextResult();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mAsyncMutex);
+      for(auto *slot : mSlots) {
+        slot->shutdown = kTRUE;
+      }
+    }
+    mJobCondition.notify_all();
+    for(auto *slot : mSlots) {
+      slot->worker.join();
+      delete slot->digitizer;
+      delete slot;
+    }
+    mSlots.clear();
+  }
+
+  if(mBinaryOutput) {
+    mBinaryOutput->close();
+  }
+}
@@ -0,0 +1,46 @@
+#include "TPCSimulation/GEMAmplification.h"
+
+#include "TMath.h"
+
+using namespace AliceO2::TPC;
+
+GEMAmplification::GEMAmplification(Float_t sigmaOverMu, size_t tableSize):
+mInverseCDF()
+{
+  initLookupTable(sigmaOverMu, tableSize);
+}
+
+GEMAmplification::~GEMAmplification()
+{}
+
+void GEMAmplification::initLookupTable(Float_t sigmaOverMu, size_t tableSize) {
+  const Double_t kappa = 1/(sigmaOverMu*sigmaOverMu);
+  const Double_t s = 1/kappa;
+
+  // tabulate the CDF of the Polya distribution on a fine grid; a range of
+  // ten times the mean gain covers the distribution to well below the
+  // granularity of the lookup table
+  const size_t nSamplingPoints = 16*tableSize;
+  const Double_t xMax = 10.;
+  const Double_t dx = xMax/nSamplingPoints;
+
+  std::vector<Double_t> cdf(nSamplingPoints);
+  Double_t integral = 0.;
+  for(size_t i = 0; i < nSamplingPoints; ++i) {
+    const Double_t x = (i+0.5)*dx;
+    integral += TMath::Power(x/s, kappa-1)*TMath::Exp(-x/s);
+    cdf[i] = integral;
+  }
+  for(auto &value : cdf) {
+    value /= integral;
+  }
+
+  // invert the CDF on a grid equidistant in probability
+  mInverseCDF.resize(tableSize);
+  size_t sample = 0;
+  for(size_t bin = 0; bin < tableSize; ++bin) {
+    const Double_t probability = static_cast<Double_t>(bin)/(tableSize-1);
+    while(sample < nSamplingPoints-1 && cdf[sample] < probability) ++sample;
+    mInverseCDF[bin] = (sample+0.5)*dx;
+  }
+}
@@ -0,0 +1,66 @@
+#include "TPCSimulation/PadResponseLUT.h"
+#include "TPCBase/Mapper.h"
+
+#include "TMath.h"
+
+using namespace AliceO2::TPC;
+
+PadResponseLUT::PadResponseLUT():
+mSigmaX(0.06),
+mSigmaY(0.12),
+mNSubBins(10),
+mMinWeight(1e-3),
+mFractions()
+{}
+
+PadResponseLUT::~PadResponseLUT()
+{}
+
+namespace {
+  // fraction of a unit Gaussian centred at frac (in pad units) integrated
+  // over the pad at offset d
+  Double_t padCoupling(Double_t frac, Double_t d, Double_t sigma) {
+    const Double_t sqrt2sigma = TMath::Sqrt2()*sigma;
+    return 0.5*(TMath::Erf((d+0.5-frac)/sqrt2sigma) - TMath::Erf((d-0.5-frac)/sqrt2sigma));
+  }
+}
+
+void PadResponseLUT::init()
+{
+  const Mapper& mapper = Mapper::instance();
+  const Int_t nRegions = mapper.getMapPadRegionInfo().size();
+  mFractions.resize(nRegions);
+
+  for(Int_t region = 0; region < nRegions; ++region) {
+    const PadRegionInfo& regionInfo = mapper.getPadRegionInfo(region);
+    // widths in pad units of this region
+    const Double_t sigmaX = mSigmaX/regionInfo.getPadHeight();
+    const Double_t sigmaY = mSigmaY/regionInfo.getPadWidth();
+
+    std::vector<Float_t> &fractions = mFractions[region];
+    fractions.resize(mNSubBins*mNSubBins*StencilSize);
+
+    for(Int_t subX = 0; subX < mNSubBins; ++subX) {
+      // position relative to the pad centre in pad units
+      const Double_t fracX = (subX+0.5)/mNSubBins - 0.5;
+      for(Int_t subY = 0; subY < mNSubBins; ++subY) {
+        const Double_t fracY = (subY+0.5)/mNSubBins - 0.5;
+        Float_t *cell = &fractions[tableIndex(subX, subY)];
+        Double_t sum = 0.;
+        Int_t iCell = 0;
+        for(Int_t dRow = -StencilHalfWidth; dRow <= StencilHalfWidth; ++dRow) {
+          const Double_t couplingRow = padCoupling(fracX, dRow, sigmaX);
+          for(Int_t dPad = -StencilHalfWidth; dPad <= StencilHalfWidth; ++dPad, ++iCell) {
+            const Double_t weight = couplingRow*padCoupling(fracY, dPad, sigmaY);
+            cell[iCell] = weight;
+            sum += weight;
+          }
+        }
+        // renormalize so the charge contained in the stencil is conserved
+        for(iCell = 0; iCell < StencilSize; ++iCell) {
+          cell[iCell] /= sum;
+        }
+      }
+    }
+  }
+}
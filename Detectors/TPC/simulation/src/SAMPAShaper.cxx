@@ -0,0 +1,109 @@
+#include "TPCSimulation/SAMPAShaper.h"
+#include "TPCSimulation/DigitContainerFlat.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCBase/CRU.h"
+
+#include "TMath.h"
+
+using namespace AliceO2::TPC;
+
+SAMPAShaper::SAMPAShaper() :
+mKernel(),
+mFullScale(1023.f*Digitizer::chargePerADCcount()),
+mAcc(),
+mEmpty()
+{
+  // sample the Gamma4 impulse response at the time-bin centers and quantize
+  // it to Q16 fixed point with the taps summing to exactly one, so the
+  // shaping preserves the total charge up to the quantization
+  // TODO parameters to be stored someplace else
+  const Double_t peakingTime = 160e-3; // all times are in us
+  const Double_t zBinWidth = 0.19379844961;
+
+  Double_t weight[mKernelLength];
+  Double_t sum = 0.;
+  for(Int_t k = 0; k < mKernelLength; ++k) {
+    const Double_t time = (k + 0.5)*zBinWidth;
+    weight[k] = TMath::Exp(-4.*time/peakingTime)*TMath::Power(time/peakingTime, 4);
+    sum += weight[k];
+  }
+  Int_t quantized = 0;
+  Int_t peakTap = 0;
+  for(Int_t k = 0; k < mKernelLength; ++k) {
+    mKernel[k] = TMath::Nint(65536.*weight[k]/sum);
+    quantized += mKernel[k];
+    if(mKernel[k] > mKernel[peakTap]) peakTap = k;
+  }
+  // put the rounding remainder on the peak tap
+  mKernel[peakTap] += 65536 - quantized;
+}
+
+void SAMPAShaper::process(DigitContainerFlat *container) {
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    std::vector<Int_t> &occupied = container->getOccupiedBins(cru);
+    if(occupied.empty()) continue;
+    const Int_t stride = container->getPadsPerCRU(cru);
+
+    // active time window of the CRU, extended by the shaping tail
+    Int_t binMin = occupied.front();
+    Int_t binMax = occupied.front();
+    for(auto bin : occupied) {
+      if(bin < binMin) binMin = bin;
+      if(bin > binMax) binMax = bin;
+    }
+    const Int_t timeBinMin = binMin/stride;
+    const Int_t timeBinMax = binMax/stride + mKernelLength - 1;
+    const Int_t nTimeBins = timeBinMax - timeBinMin + 1;
+
+    std::vector<Float_t> &plane = container->getChargeMap(cru);
+    const size_t needed = static_cast<size_t>(timeBinMax + 1)*stride;
+    if(plane.size() < needed) plane.resize(needed, 0.f);
+
+    const std::vector<UShort_t> &rowOffset = container->getRowOffset(cru);
+    for(size_t row = 0; row < rowOffset.size(); ++row) {
+      const Int_t rowStart = rowOffset[row];
+      const Int_t nPads = (row + 1 < rowOffset.size() ? rowOffset[row + 1] : stride) - rowStart;
+      Float_t *charge = plane.data() + static_cast<size_t>(timeBinMin)*stride + rowStart;
+
+      // record the cells without signal: the shaping tail fires new cells,
+      // which have to be registered as occupied for the output and the reset
+      mEmpty.assign(static_cast<size_t>(nTimeBins)*nPads, 0);
+      for(Int_t t = 0; t < nTimeBins; ++t) {
+        const Float_t *q = charge + static_cast<size_t>(t)*stride;
+        UChar_t *empty = mEmpty.data() + static_cast<size_t>(t)*nPads;
+        for(Int_t pad = 0; pad < nPads; ++pad) empty[pad] = q[pad] == 0.f;
+      }
+
+      processRow(charge, stride, nPads, nTimeBins);
+
+      for(Int_t t = 0; t < nTimeBins; ++t) {
+        const Float_t *q = charge + static_cast<size_t>(t)*stride;
+        const UChar_t *empty = mEmpty.data() + static_cast<size_t>(t)*nPads;
+        const Int_t binStart = (timeBinMin + t)*stride + rowStart;
+        for(Int_t pad = 0; pad < nPads; ++pad) {
+          if(empty[pad] && q[pad] != 0.f) occupied.emplace_back(binStart + pad);
+        }
+      }
+    }
+  }
+}
+
+void SAMPAShaper::processRow(Float_t *charge, Int_t stride, Int_t nPads, Int_t nTimeBins) {
+  mAcc.resize(nPads);
+  // causal FIR in place: with the time bins processed in decreasing order
+  // each output only reads inputs of earlier bins not yet overwritten
+  for(Int_t t = nTimeBins - 1; t >= 0; --t) {
+    Float_t *out = charge + static_cast<size_t>(t)*stride;
+    const Int_t nTaps = t + 1 < mKernelLength ? t + 1 : mKernelLength;
+    std::fill(mAcc.begin(), mAcc.end(), 0.f);
+    for(Int_t k = 0; k < nTaps; ++k) {
+      const Float_t *in = out - static_cast<size_t>(k)*stride;
+      const Float_t weight = mKernel[k];
+      for(Int_t pad = 0; pad < nPads; ++pad) mAcc[pad] += weight*in[pad];
+    }
+    for(Int_t pad = 0; pad < nPads; ++pad) {
+      const Float_t shaped = mAcc[pad]*(1.f/65536.f);
+      out[pad] = shaped > mFullScale ? mFullScale : shaped;
+    }
+  }
+}
@@ -9,15 +9,19 @@
 #pragma link C++ class AliceO2::TPC::DigitizerTask+;
 #pragma link C++ class AliceO2::TPC::Digitizer+;
 #pragma link C++ class AliceO2::TPC::DigitContainer+;
+#pragma link C++ class AliceO2::TPC::DigitContainerFlat+;
+#pragma link C++ class AliceO2::TPC::DigitContainerTiled+;
+#pragma link C++ class AliceO2::TPC::ZeroSuppression+;
+#pragma link C++ class AliceO2::TPC::SAMPAShaper+;
 #pragma link C++ class AliceO2::TPC::DigitCRU+;
 #pragma link C++ class AliceO2::TPC::DigitRow+;
-#pragma link C++ class AliceO2::TPC::DigitPad+;
 #pragma link C++ class AliceO2::TPC::DigitTime+;
-#pragma link C++ class AliceO2::TPC::DigitADC+;
 #pragma link C++ class AliceO2::TPC::Digit+;
+#pragma link C++ class AliceO2::TPC::PackedDigit+;
 #pragma link C++ class AliceO2::TPC::Cluster+;
 #pragma link C++ class AliceO2::TPC::BoxCluster+;
 #pragma link C++ class AliceO2::TPC::ClusterContainer+;
+#pragma link C++ class AliceO2::TPC::ClusterContainerFlat+;
 #pragma link C++ class AliceO2::TPC::BoxClusterer+;
 #pragma link C++ class AliceO2::TPC::ClustererTask+;
 
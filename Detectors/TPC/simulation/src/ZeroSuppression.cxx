@@ -0,0 +1,111 @@
+#include "TPCSimulation/ZeroSuppression.h"
+#include "TPCSimulation/DigitContainerFlat.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCBase/CRU.h"
+
+using namespace AliceO2::TPC;
+
+ZeroSuppression::ZeroSuppression() :
+mThreshold(0.f),
+mMinSamples(1),
+mCommonModeFraction(0.f),
+mAbove(),
+mKeep(),
+mCount()
+{}
+
+void ZeroSuppression::setThreshold(Float_t thresholdADC) {
+  // the charge planes hold electrons, converted to ADC counts only at output
+  mThreshold = thresholdADC*Digitizer::chargePerADCcount();
+}
+
+void ZeroSuppression::process(DigitContainerFlat *container) {
+  for(Int_t cru = 0; cru < CRU::MaxCRU; ++cru) {
+    const std::vector<Int_t> &occupied = container->getOccupiedBins(cru);
+    if(occupied.empty()) continue;
+    const Int_t stride = container->getPadsPerCRU(cru);
+
+    // active time window of the CRU, the rest of the plane is empty
+    Int_t binMin = occupied.front();
+    Int_t binMax = occupied.front();
+    for(auto bin : occupied) {
+      if(bin < binMin) binMin = bin;
+      if(bin > binMax) binMax = bin;
+    }
+    const Int_t timeBinMin = binMin/stride;
+    const Int_t timeBinMax = binMax/stride;
+
+    std::vector<Float_t> &plane = container->getChargeMap(cru);
+    const std::vector<UShort_t> &rowOffset = container->getRowOffset(cru);
+    for(size_t row = 0; row < rowOffset.size(); ++row) {
+      const Int_t rowStart = rowOffset[row];
+      const Int_t nPads = (row + 1 < rowOffset.size() ? rowOffset[row + 1] : stride) - rowStart;
+      processRow(plane.data() + static_cast<size_t>(timeBinMin)*stride + rowStart,
+                 stride, nPads, timeBinMax - timeBinMin + 1);
+    }
+  }
+}
+
+void ZeroSuppression::processRow(Float_t *charge, Int_t stride, Int_t nPads, Int_t nTimeBins) {
+  // common-mode subtraction: a fraction of the mean row signal couples back
+  // onto every pad of the row; pads driven below zero clamp at zero
+  if(mCommonModeFraction > 0.f) {
+    for(Int_t t = 0; t < nTimeBins; ++t) {
+      Float_t *q = charge + static_cast<size_t>(t)*stride;
+      Float_t sum = 0.f;
+      for(Int_t pad = 0; pad < nPads; ++pad) sum += q[pad];
+      if(sum <= 0.f) continue;
+      const Float_t commonMode = mCommonModeFraction*sum/nPads;
+      for(Int_t pad = 0; pad < nPads; ++pad) {
+        const Float_t corrected = q[pad] - commonMode;
+        q[pad] = corrected > 0.f ? corrected : 0.f;
+      }
+    }
+  }
+
+  if(mThreshold <= 0.f) return;
+
+  // threshold mask, one byte per (time bin, pad)
+  mAbove.assign(static_cast<size_t>(nTimeBins)*nPads, 0);
+  for(Int_t t = 0; t < nTimeBins; ++t) {
+    const Float_t *q = charge + static_cast<size_t>(t)*stride;
+    UChar_t *above = mAbove.data() + static_cast<size_t>(t)*nPads;
+    for(Int_t pad = 0; pad < nPads; ++pad) above[pad] = q[pad] > mThreshold;
+  }
+
+  const UChar_t *keep = mAbove.data();
+  if(mMinSamples > 1) {
+    // glitch filter over consecutive time bins, elementwise across the pads
+    // of the row: the forward pass counts run lengths and seeds the keep
+    // mask where a run reaches the minimum, the backward pass extends each
+    // seed over its whole run
+    mKeep.assign(static_cast<size_t>(nTimeBins)*nPads, 0);
+    mCount.assign(nPads, 0);
+    for(Int_t t = 0; t < nTimeBins; ++t) {
+      const UChar_t *above = mAbove.data() + static_cast<size_t>(t)*nPads;
+      UChar_t *keepBin = mKeep.data() + static_cast<size_t>(t)*nPads;
+      for(Int_t pad = 0; pad < nPads; ++pad) {
+        mCount[pad] = above[pad] ? mCount[pad] + 1 : 0;
+        keepBin[pad] = mCount[pad] >= mMinSamples;
+      }
+    }
+    for(Int_t t = nTimeBins - 2; t >= 0; --t) {
+      const UChar_t *above = mAbove.data() + static_cast<size_t>(t)*nPads;
+      const UChar_t *keepNext = mKeep.data() + static_cast<size_t>(t + 1)*nPads;
+      UChar_t *keepBin = mKeep.data() + static_cast<size_t>(t)*nPads;
+      for(Int_t pad = 0; pad < nPads; ++pad) {
+        keepBin[pad] |= keepNext[pad] & above[pad];
+      }
+    }
+    keep = mKeep.data();
+  }
+
+  // zero the suppressed bins
+  for(Int_t t = 0; t < nTimeBins; ++t) {
+    Float_t *q = charge + static_cast<size_t>(t)*stride;
+    const UChar_t *keepBin = keep + static_cast<size_t>(t)*nPads;
+    for(Int_t pad = 0; pad < nPads; ++pad) {
+      if(!keepBin[pad]) q[pad] = 0.f;
+    }
+  }
+}
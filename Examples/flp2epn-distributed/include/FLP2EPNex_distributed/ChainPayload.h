@@ -0,0 +1,96 @@
+/**
+ * ChainPayload.h
+ *
+ * Payload format of the benchO2Chain topology: synthetic TPC clusters,
+ * bit-packed with the production bit widths (see tpccluster_record.h) by
+ * the DataDeflater. One event is a BenchEventHeader followed by the
+ * deflated symbol stream; the header carries a checksum over the packed
+ * symbols and the generation timestamp, so the receiving end of the chain
+ * can verify the decompressed content and measure the end-to-end latency
+ * without sharing state with the producer.
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_CHAINPAYLOAD_H_
+#define ALICEO2_DEVICES_CHAINPAYLOAD_H_
+
+#include <cstdint>
+#include <cstddef>
+
+#include "DataCompression/tpccluster_record.h"
+
+namespace AliceO2 {
+namespace Devices {
+
+/// uncompressed descriptor leading every event payload of the chain
+struct BenchEventHeader {
+  uint32_t numOfClusters;  ///< clusters in the deflated stream
+  uint32_t checksum;       ///< sum of the packed symbols mod 2^32
+  uint64_t generatedNs;    ///< steady clock at generation, single-node latency probe
+  uint32_t rawSize;        ///< uncompressed size in bytes (7 uint16 fields per cluster)
+  uint32_t compressedSize; ///< deflated bytes following this header
+};
+
+/// symbols of one cluster in stream order with their bit widths; the widths
+/// are the production widths of the TPC cluster alphabet
+struct ChainSymbolOrder {
+  enum { kSymbolsPerCluster = 7 };
+
+  /// bit width of the i-th symbol of a cluster
+  static uint16_t width(int i) {
+    static const uint16_t widths[kSymbolsPerCluster] = {
+      TPCClusterWidth::kPadRow, TPCClusterWidth::kPad, TPCClusterWidth::kTime,
+      TPCClusterWidth::kSigmaY2, TPCClusterWidth::kSigmaZ2,
+      TPCClusterWidth::kCharge, TPCClusterWidth::kQMax
+    };
+    return widths[i];
+  }
+
+  /// raw bits of one cluster
+  static size_t bitsPerCluster() {
+    size_t bits = 0;
+    for (int i = 0; i < kSymbolsPerCluster; ++i) bits += width(i);
+    return bits;
+  }
+};
+
+/// Fixed-width bit reader matching the register order of the DataDeflater:
+/// the first written bit sits in the most significant position of the first
+/// byte. Reads past the end return 0 and raise the overflow flag instead of
+/// touching memory outside the stream.
+class BitReader
+{
+public:
+  BitReader(const uint8_t* stream, size_t size)
+    : mStream(stream), mSize(size), mPosition(0), mOverflow(false) {}
+
+  /// read a value of the given bit length
+  uint32_t read(uint16_t bitlength) {
+    uint32_t value = 0;
+    for (uint16_t bit = 0; bit < bitlength; ++bit) {
+      size_t byte = mPosition >> 3;
+      if (byte >= mSize) {
+        mOverflow = true;
+        return 0;
+      }
+      value = (value << 1) | ((mStream[byte] >> (7 - (mPosition & 7))) & 0x1);
+      ++mPosition;
+    }
+    return value;
+  }
+
+  bool hasOverflowed() const { return mOverflow; }
+
+private:
+  const uint8_t* mStream; ///< deflated stream
+  size_t mSize;           ///< stream size in bytes
+  size_t mPosition;       ///< read position in bits
+  bool mOverflow;         ///< a read ran past the stream end
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * ChainProducer.h
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_CHAINPRODUCER_H_
+#define ALICEO2_DEVICES_CHAINPRODUCER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "O2Device/O2Device.h"
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Source of the benchO2Chain topology. Generates synthetic but
+/// statistically realistic TPC cluster payloads, deflates them with the
+/// production bit widths (DataDeflater over the tpccluster_record alphabet),
+/// frames the events through the O2 frame packing (O2Device::AddFrame, one
+/// header+payload pair per event) and ships one frame per sub-timeframe into
+/// the flpSender. Generation, deflation and framing are timed separately and
+/// the per-stage throughput is reported at the end of the run; correctness
+/// and the transport stages are measured by the chainValidator at the far
+/// end of the chain (see ChainValidator.h).
+
+class ChainProducer : public Base::O2Device
+{
+  public:
+    /// Default constructor
+    ChainProducer();
+
+    /// Default destructor
+    virtual ~ChainProducer();
+
+  protected:
+    /// Overloads the InitTask() method of FairMQDevice
+    virtual void InitTask();
+
+    /// Overloads the Run() method of FairMQDevice
+    virtual void Run();
+
+  private:
+    int fNumFrames; ///< Frames (sub-timeframes) to produce
+    int fEventsPerFrame; ///< Events batched into one frame
+    int fClustersPerEvent; ///< Synthetic clusters per event
+
+    std::string fOutChannelName; ///< Output channel towards the flpSender
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * ChainValidator.h
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_CHAINVALIDATOR_H_
+#define ALICEO2_DEVICES_CHAINVALIDATOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "O2Device/O2Device.h"
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Sink of the benchO2Chain topology. Receives the timeframes assembled by
+/// the epnReceiver, unpacks the frame (FrameReader), validates the data
+/// headers, inflates the cluster symbols and checks them against the
+/// checksum of every event, so a corruption anywhere along the chain fails
+/// the benchmark. Per-event end-to-end latency (producer generation to
+/// validation, single-node steady clock) and decompression throughput are
+/// accumulated; the run ends after the expected number of frames with a
+/// summary and a "chain benchmark PASSED"/"FAILED" verdict against the
+/// configured throughput and latency thresholds.
+
+class ChainValidator : public Base::O2Device
+{
+  public:
+    /// Default constructor
+    ChainValidator();
+
+    /// Default destructor
+    virtual ~ChainValidator();
+
+  protected:
+    /// Overloads the InitTask() method of FairMQDevice
+    virtual void InitTask();
+
+    /// Overloads the Run() method of FairMQDevice
+    virtual void Run();
+
+  private:
+    int fNumFrames; ///< Frames expected from the chain
+    double fMinThroughput; ///< End-to-end pass threshold in MB/s of raw data (0 - disabled)
+    double fMaxLatencyMs; ///< Mean-latency pass threshold in ms (0 - disabled)
+
+    std::string fInChannelName; ///< Input channel from the epnReceiver
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
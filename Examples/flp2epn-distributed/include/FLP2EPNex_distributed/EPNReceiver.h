@@ -8,26 +8,27 @@
 #ifndef ALICEO2_DEVICES_EPNRECEIVER_H_
 #define ALICEO2_DEVICES_EPNRECEIVER_H_
 
+#include <memory>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
-#include <chrono>
 
 #include "FairMQDevice.h"
 
+#include "EventLog/EventLog.h"
+#include "O2Device/ThreadPlacement.h"
+#include "TimeFrameBuilder/TimeFrameBuilder.h"
+
 namespace AliceO2 {
 namespace Devices {
 
-/// Container for (sub-)timeframes
-
-struct TFBuffer
-{
-  FairMQParts parts;
-  std::chrono::steady_clock::time_point start;
-  std::chrono::steady_clock::time_point end;
-};
-
 /// Receives sub-timeframes from the flpSenders and merges these into full timeframes.
+///
+/// The assembly itself is done by TimeFrameBuilder (Utilities/TimeFrameBuilder),
+/// which grew out of this device: partial timeframes live in a preallocated
+/// circular table indexed by timeframe ID modulo the table size, and a
+/// timeframe still incomplete when its slot is needed for a newer ID (or when
+/// its timeout expires) is discarded by reusing the slot. This device only
+/// does the transport: it feeds received parts into the builder and ships
+/// completed timeframes (or acknowledgements in test mode).
 
 class EPNReceiver : public FairMQDevice
 {
@@ -40,26 +41,25 @@ class EPNReceiver : public FairMQDevice
 
     virtual void InitTask();
 
-    /// Prints the contents of the timeframe container
-    void PrintBuffer(const std::unordered_map<uint16_t, TFBuffer> &buffer) const;
-
-    /// Discared incomplete timeframes after \p fBufferTimeoutInMs.
-    void DiscardIncompleteTimeframes();
-
   protected:
     /// Overloads the Run() method of FairMQDevice
     virtual void Run();
 
-    std::unordered_map<uint16_t, TFBuffer> fTimeframeBuffer; ///< Stores (sub-)timeframes
-    std::unordered_set<uint16_t> fDiscardedSet; ///< Set containing IDs of dropped timeframes
+    std::unique_ptr<TimeFrameBuilder<FairMQMessagePtr>> fBuilder; ///< Timeframe assembly
 
     int fNumFLPs; ///< Number of flpSenders
     int fBufferTimeoutInMs; ///< Time after which incomplete timeframes are dropped
     int fTestMode; ///< Run the device in test mode (only syncSampler+flpSender+epnReceiver)
+    int fIndex; ///< Index of the epnReceiver, stamped into its heartbeats
+    int fHeartbeatIntervalMs; ///< Interval between heartbeats to the flpSenders
 
     std::string fInChannelName;
     std::string fOutChannelName;
     std::string fAckChannelName;
+    std::string fHeartbeatChannelName; ///< Empty - heartbeats disabled
+
+    Diagnostics::EventLog fEventLog; ///< Binary event log, replaces the per-event text logging when enabled
+    Base::ThreadPlacement fPlacement; ///< Core placement of the device threads (role: poller)
 };
 
 } // namespace Devices
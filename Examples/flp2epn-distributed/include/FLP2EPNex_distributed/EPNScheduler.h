@@ -0,0 +1,177 @@
+/**
+ * EPNScheduler.h
+ *
+ * @since 2016-08-15
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_EPNSCHEDULER_H_
+#define ALICEO2_DEVICES_EPNSCHEDULER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FairMQLogger.h"
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Timeframe ID published by the flpSyncSampler, together with the EPN chosen
+/// by a sampler-side scheduling policy. epnIndex is -1 when the sampler does
+/// not schedule, in which case the flpSenders pick the EPN themselves.
+
+struct TimeframeSchedule
+{
+  uint16_t timeFrameId;
+  int16_t epnIndex;
+};
+
+/// Chooses the destination epnReceiver for a timeframe.
+///
+/// All flpSenders have to route the parts of one timeframe to the same
+/// epnReceiver. The round-robin and weighted-round-robin policies are pure
+/// functions of the timeframe ID (and the static weight configuration), so
+/// every flpSender arrives at the same choice independently. The
+/// least-outstanding policy uses the acknowledgements collected by
+/// FLPSyncSampler::ListenForAcks and therefore runs on the sampler, which
+/// distributes its choice with the timeframe ID (see TimeframeSchedule).
+
+class EPNScheduler
+{
+  public:
+    enum EPolicy {
+      kRoundRobin, ///< plain timeframeId % numEPNs
+      kWeightedRoundRobin, ///< like round-robin, EPNs appear according to their weight
+      kLeastOutstanding ///< EPN with the fewest unacknowledged timeframes (sampler only)
+    };
+
+    EPNScheduler()
+      : fPolicy(kRoundRobin)
+      , fNumEPNs(0)
+      , fScheduleTable()
+      , fOutstanding()
+      , fAssignedEPN()
+      , fMutex()
+    {}
+
+    /// Configures the policy ("round-robin", "weighted-round-robin",
+    /// "least-outstanding") for numEPNs nodes; weights is a comma-separated
+    /// list of relative EPN capacities for weighted-round-robin (empty: all 1)
+    void Init(const std::string& policy, int numEPNs, const std::string& weights)
+    {
+      fNumEPNs = numEPNs;
+
+      if (policy == "round-robin") {
+        fPolicy = kRoundRobin;
+      } else if (policy == "weighted-round-robin") {
+        fPolicy = kWeightedRoundRobin;
+      } else if (policy == "least-outstanding") {
+        fPolicy = kLeastOutstanding;
+      } else {
+        LOG(WARN) << "Unknown scheduling policy '" << policy << "', using round-robin";
+        fPolicy = kRoundRobin;
+      }
+
+      if (fPolicy == kWeightedRoundRobin) {
+        BuildScheduleTable(weights);
+      }
+
+      if (fPolicy == kLeastOutstanding) {
+        fOutstanding.assign(fNumEPNs, 0);
+        fAssignedEPN.assign(UINT16_MAX, -1);
+      }
+    }
+
+    EPolicy GetPolicy() const { return fPolicy; }
+
+    /// The destination EPN for the timeframe
+    int Schedule(uint16_t timeframeId)
+    {
+      switch (fPolicy) {
+        case kWeightedRoundRobin:
+          return fScheduleTable.at(timeframeId % fScheduleTable.size());
+        case kLeastOutstanding: {
+          std::lock_guard<std::mutex> lock(fMutex);
+          // an assignment still pending from the previous ID epoch counts as
+          // lost, release it before reusing the ID
+          if (fAssignedEPN.at(timeframeId) >= 0) {
+            --fOutstanding.at(fAssignedEPN.at(timeframeId));
+          }
+          int epn = 0;
+          for (int i = 1; i < fNumEPNs; ++i) {
+            if (fOutstanding.at(i) < fOutstanding.at(epn)) {
+              epn = i;
+            }
+          }
+          ++fOutstanding.at(epn);
+          fAssignedEPN.at(timeframeId) = epn;
+          return epn;
+        }
+        case kRoundRobin:
+        default:
+          return timeframeId % fNumEPNs;
+      }
+    }
+
+    /// Feeds an acknowledged timeframe back into the least-outstanding
+    /// accounting; no-op for the static policies
+    void MarkAcknowledged(uint16_t timeframeId)
+    {
+      if (fPolicy != kLeastOutstanding) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fAssignedEPN.at(timeframeId) >= 0) {
+        --fOutstanding.at(fAssignedEPN.at(timeframeId));
+        fAssignedEPN.at(timeframeId) = -1;
+      }
+    }
+
+  private:
+    void BuildScheduleTable(const std::string& weights)
+    {
+      std::vector<int> weightList;
+      std::stringstream ss(weights);
+      std::string token;
+      while (getline(ss, token, ',')) {
+        weightList.push_back(stoi(token));
+      }
+      if (static_cast<int>(weightList.size()) != fNumEPNs) {
+        if (!weights.empty()) {
+          LOG(WARN) << "Expected " << fNumEPNs << " EPN weights, got " << weightList.size()
+                    << ", using equal weights";
+        }
+        weightList.assign(fNumEPNs, 1);
+      }
+
+      // expand the weights into an explicit schedule, interleaved so that a
+      // heavy EPN does not receive long uninterrupted bursts
+      fScheduleTable.clear();
+      std::vector<int> remaining(weightList);
+      bool left = true;
+      while (left) {
+        left = false;
+        for (int i = 0; i < fNumEPNs; ++i) {
+          if (remaining.at(i) > 0) {
+            fScheduleTable.push_back(i);
+            left = (--remaining.at(i) > 0) || left;
+          }
+        }
+      }
+    }
+
+    EPolicy fPolicy; ///< Active scheduling policy
+    int fNumEPNs; ///< Number of epnReceivers
+    std::vector<int> fScheduleTable; ///< Expanded weighted-round-robin schedule
+    std::vector<int> fOutstanding; ///< Unacknowledged timeframes per EPN
+    std::vector<int16_t> fAssignedEPN; ///< EPN assigned per timeframe ID, -1 when none
+    std::mutex fMutex; ///< Guards the least-outstanding accounting
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
@@ -8,13 +8,21 @@
 #ifndef ALICEO2_DEVICES_FLPSENDER_H_
 #define ALICEO2_DEVICES_FLPSENDER_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint> // UINT16_MAX
+#include <memory>
 #include <string>
-#include <queue>
-#include <unordered_map>
-#include <chrono>
+#include <thread>
 
 #include "FairMQDevice.h"
 
+#include "EventLog/EventLog.h"
+#include "O2Device/ThreadPlacement.h"
+#include "FLP2EPNex_distributed/EPNScheduler.h"
+#include "FLP2EPNex_distributed/HeartbeatTable.h"
+#include "FLP2EPNex_distributed/STFRing.h"
+
 namespace AliceO2 {
 namespace Devices {
 
@@ -23,6 +31,14 @@ namespace Devices {
 /// Sub-timeframes are received from the previous step (or generated in test-mode)
 /// and are sent to epnReceivers. Target epnReceiver is determined from the timeframe ID:
 /// targetEpnReceiver = timeframeId % numEPNs (numEPNs is same for every flpSender, although some may be inactive).
+///
+/// Receiving and sending run on separate threads, decoupled by a bounded
+/// lock-free ring (see STFRing): a slow epnReceiver backs the ring up to its
+/// watermark and further sub-timeframes are dropped instead of accumulating.
+///
+/// When a heartbeat channel is configured, a third thread stamps the
+/// heartbeat table (see HeartbeatTable) and the send path reroutes
+/// sub-timeframes away from EPNs that stopped beating, without taking a lock.
 
 class FLPSender : public FairMQDevice
 {
@@ -41,11 +57,27 @@ class FLPSender : public FairMQDevice
     virtual void Run();
 
   private:
-    /// Sends the "oldest" element from the sub-timeframe container
-    void sendFrontData();
+    /// Drains the sub-timeframe ring towards the epnReceivers (sender thread)
+    void SendLoop();
+
+    /// Stamps the heartbeat table from the heartbeat channel (heartbeat thread)
+    void ReceiveHeartbeats();
+
+    /// Sends the given buffered sub-timeframe
+    void SendData(STFRing::Entry& entry);
 
-    std::queue<FairMQParts> fSTFBuffer; ///< Buffer for sub-timeframes
-    std::queue<std::chrono::steady_clock::time_point> fArrivalTime; ///< Stores arrival times of sub-timeframes
+    /// Logs ring occupancy and drop counters
+    void LogBufferStatus();
+
+    std::unique_ptr<STFRing> fSTFBuffer; ///< Buffer for sub-timeframes, sized in InitTask()
+    std::thread fSendThread; ///< Drains fSTFBuffer while the device loop keeps receiving
+    std::thread fHeartbeatThread; ///< Stamps fHeartbeats from the heartbeat channel
+
+    HeartbeatTable fHeartbeats; ///< Last heartbeat per EPN, read wait-free on the send path
+    int fHeartbeatTimeoutMs; ///< EPNs without a heartbeat for this long are skipped
+
+    EPNScheduler fScheduler; ///< Destination EPN selection for the static policies
+    std::array<std::atomic<int16_t>, UINT16_MAX> fScheduledEPN; ///< EPN chosen by the sampler per timeframe ID, -1 when none
 
     int fNumEPNs; ///< Number of epnReceivers
     unsigned int fIndex; ///< Index of the flpSender among other flpSenders
@@ -58,6 +90,10 @@ class FLPSender : public FairMQDevice
 
     std::string fInChannelName;
     std::string fOutChannelName;
+    std::string fHeartbeatChannelName; ///< Empty - heartbeat tracking disabled
+
+    Diagnostics::EventLog fEventLog; ///< Binary event log, replaces the per-event text logging when enabled
+    Base::ThreadPlacement fPlacement; ///< Core placement of the device threads (roles: poller, send, heartbeat)
 };
 
 } // namespace Devices
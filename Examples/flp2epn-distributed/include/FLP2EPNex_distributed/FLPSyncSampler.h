@@ -17,6 +17,10 @@
 
 #include "FairMQDevice.h"
 
+#include "EventLog/EventLog.h"
+#include "O2Device/ThreadPlacement.h"
+#include "FLP2EPNex_distributed/EPNScheduler.h"
+
 namespace AliceO2 {
 namespace Devices {
 
@@ -28,7 +32,11 @@ struct timeframeDuration
     std::chrono::steady_clock::time_point end;
 };
 
-/// Publishes timeframes IDs for flpSenders (used only in test mode)
+/// Publishes timeframes IDs for flpSenders (used only in test mode).
+/// The ids are generated on a TSC-based periodic schedule: the deadlines
+/// advance on a fixed cycle grid and after every wakeup all the ids due by
+/// now are published as one multipart batch, so a late wakeup is caught up
+/// in one send instead of accumulating as jitter.
 
 class FLPSyncSampler : public FairMQDevice
 {
@@ -39,9 +47,6 @@ class FLPSyncSampler : public FairMQDevice
     /// Default destructor
     virtual ~FLPSyncSampler();
 
-    /// Controls the send rate of the timeframe IDs
-    void ResetEventCounter();
-
     /// Listens for acknowledgements from the epnReceivers when they collected full timeframe
     void ListenForAcks();
 
@@ -55,17 +60,24 @@ class FLPSyncSampler : public FairMQDevice
     virtual void PostRun();
 
     std::array<timeframeDuration, UINT16_MAX> fTimeframeRTT; ///< Container for the roundtrip values per timeframe ID
+    EPNScheduler fScheduler; ///< Chooses the destination EPN when the least-outstanding policy is active
+    int fNumEPNs; ///< Number of epnReceivers (0 - sampler-side scheduling disabled)
     int fEventRate; ///< Publishing rate of the timeframe IDs
     int fMaxEvents; ///< Maximum number of events to send (0 - unlimited)
     int fStoreRTTinFile; ///< Store round trip time measurements in a file.
-    int fEventCounter; ///< Controls the send rate of the timeframe IDs
     uint16_t fTimeFrameId;
+    uint64_t fCyclesPerSecond; ///< TSC frequency calibrated against the steady clock
+    uint64_t fCyclesPerPeriod; ///< TSC cycles per timeframe period
+    uint64_t fNextDue; ///< TSC deadline of the next timeframe id
+    uint64_t fEventsPublished; ///< Total ids published, bounds max-events
     std::thread fAckListener;
-    std::thread fResetEventCounter;
     std::atomic<bool> fLeaving;
 
     std::string fAckChannelName;
     std::string fOutChannelName;
+
+    Diagnostics::EventLog fEventLog; ///< Binary event log, replaces the per-event text logging when enabled
+    Base::ThreadPlacement fPlacement; ///< Core placement of the device threads (roles: poller, ack)
 };
 
 } // namespace Devices
@@ -0,0 +1,47 @@
+/**
+ * FlowEvents.h
+ *
+ * @since 2016-08-11
+ * @author A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_FLOWEVENTS_H_
+#define ALICEO2_DEVICES_FLOWEVENTS_H_
+
+#include <cstdint>
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Event types written by the flow devices to their binary event log
+/// (Diagnostics::EventLog, enabled with the --event-log option). These
+/// replace the per-event text logging that has to be disabled at production
+/// rates. The device id stamped into the records is the flp index for the
+/// flpSenders and 0 for the sampler and the epnReceivers (each device writes
+/// its own file). Decode the files with the eventLogDump converter.
+
+enum FlowEvent : uint32_t {
+  // flpSyncSampler
+  kScheduleSent = 1, ///< timeframe id published; value: timeframe id
+  kAckReceived = 2, ///< timeframe acknowledged; value: round trip time in microseconds
+
+  // flpSender
+  kStfBuffered = 10, ///< sub-timeframe accepted into the send ring; value: timeframe id
+  kStfSent = 11, ///< sub-timeframe queued to an EPN; value: timeframe id
+  kStfSendError = 12, ///< sub-timeframe could not be queued; value: timeframe id
+  kStfDropped = 13, ///< ring watermark reached; value: sub-timeframes dropped since the last record
+  kBufferOccupancy = 14, ///< periodic ring status; value: current occupancy
+  kStfRerouted = 15, ///< destination EPN had no recent heartbeat, sub-timeframe rerouted; value: timeframe id
+
+  // epnReceiver
+  kTimeframeComplete = 20, ///< all parts arrived; value: timeframe id
+  kTimeframeDiscarded = 21, ///< incomplete timeframe dropped; value: timeframe id
+  kDuplicatePart = 22, ///< part arrived twice; value: timeframe id
+  kLatePart = 23, ///< part of an already discarded timeframe; value: timeframe id
+  kAckSendError = 24 ///< acknowledgement could not be queued; value: timeframe id
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * HeartbeatTable.h
+ *
+ * @since 2016-08-15
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_HEARTBEATTABLE_H_
+#define ALICEO2_DEVICES_HEARTBEATTABLE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Wait-free table of the last heartbeat received per EPN.
+///
+/// The heartbeat thread of the flpSender stamps the entry of the beating
+/// EPN, the sender thread reads it on the send path of every sub-timeframe.
+/// The entries are epoch stamped (milliseconds of the steady clock) and one
+/// cache line each, so the two threads never share a line and neither side
+/// takes a lock: a stale or missing heartbeat can never block a send, it
+/// only steers the sub-timeframe to another EPN. Stale observations are
+/// counted per EPN for the end-of-run report.
+
+class HeartbeatTable
+{
+  public:
+    HeartbeatTable()
+      : fEntries()
+      , fSize(0)
+    {}
+
+    HeartbeatTable(const HeartbeatTable&) = delete;
+    HeartbeatTable& operator=(const HeartbeatTable&) = delete;
+
+    /// Sizes the table and stamps every entry with the current epoch, so
+    /// EPNs that have not beaten yet get a startup grace period instead of
+    /// being skipped immediately.
+    void Init(int numEPNs)
+    {
+      fSize = numEPNs;
+      fEntries.reset(new Entry[numEPNs]);
+      uint64_t now = NowMs();
+      for (int i = 0; i < numEPNs; ++i) {
+        fEntries[i].lastBeatMs.store(now, std::memory_order_relaxed);
+        fEntries[i].staleObservations.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    /// Heartbeat thread: stamp the entry of the beating EPN
+    void Beat(int epn, uint64_t epochMs)
+    {
+      if (epn < 0 || epn >= fSize) {
+        return;
+      }
+      fEntries[epn].lastBeatMs.store(epochMs, std::memory_order_release);
+    }
+
+    /// Sender thread: whether the EPN has beaten within the timeout.
+    /// A stale observation is counted on the entry.
+    bool IsAlive(int epn, uint64_t nowMs, uint64_t timeoutMs)
+    {
+      uint64_t last = fEntries[epn].lastBeatMs.load(std::memory_order_acquire);
+      if (nowMs > last + timeoutMs) {
+        fEntries[epn].staleObservations.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      return true;
+    }
+
+    uint64_t GetStaleCount(int epn) const
+    {
+      return fEntries[epn].staleObservations.load(std::memory_order_relaxed);
+    }
+
+    int GetSize() const { return fSize; }
+
+    /// Milliseconds of the steady clock, the epoch the entries are stamped with
+    static uint64_t NowMs()
+    {
+      using namespace std::chrono;
+      return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+  private:
+    /// One cache line per EPN: the heartbeat thread writes the stamp, the
+    /// sender thread writes the stale counter, no line is shared. Padded
+    /// explicitly, operator new does not honor extended alignment in C++11.
+    struct Entry
+    {
+      std::atomic<uint64_t> lastBeatMs;
+      std::atomic<uint64_t> staleObservations;
+      char padding[64 - 2 * sizeof(std::atomic<uint64_t>)];
+    };
+
+    std::unique_ptr<Entry[]> fEntries;
+    int fSize;
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
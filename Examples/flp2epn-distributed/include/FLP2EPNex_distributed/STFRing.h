@@ -0,0 +1,152 @@
+/**
+ * STFRing.h
+ *
+ * @since 2016-08-15
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#ifndef ALICEO2_DEVICES_STFRING_H_
+#define ALICEO2_DEVICES_STFRING_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "FairMQParts.h"
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Bounded single-producer/single-consumer ring buffer for sub-timeframes.
+///
+/// The receiving loop of the flpSender pushes sub-timeframes, a separate
+/// sending thread pops them, synchronized only through the two atomic
+/// indices - neither side takes a lock, so enqueueing new data never waits
+/// on a send in progress. The capacity is fixed: when occupancy reaches the
+/// high watermark, pushes fail (and the producer drops the sub-timeframe)
+/// until the sender has drained the ring below the low watermark again,
+/// bounding the memory a slow or stuck EPN can pin on the FLP.
+
+class STFRing
+{
+  public:
+    /// A buffered sub-timeframe together with its arrival time
+    struct Entry
+    {
+      FairMQParts parts;
+      std::chrono::steady_clock::time_point arrivalTime;
+    };
+
+    /// The capacity is rounded up to a power of two; the high watermark is
+    /// 7/8 of the capacity, the low watermark half of it.
+    STFRing(size_t capacity)
+      : fCapacity(RoundUpToPowerOfTwo(capacity))
+      , fHighWatermark(fCapacity - fCapacity / 8)
+      , fLowWatermark(fCapacity / 2)
+      , fSlots(fCapacity)
+      , fHead(0)
+      , fTail(0)
+      , fAboveWatermark(false)
+      , fAcceptedCount(0)
+      , fDroppedCount(0)
+      , fMaxOccupancy(0)
+    {}
+
+    STFRing(const STFRing&) = delete;
+    STFRing& operator=(const STFRing&) = delete;
+
+    /// Producer side: buffer a sub-timeframe, stamping its arrival time.
+    /// Returns false (and counts the sub-timeframe as dropped) while the
+    /// watermark backpressure is active.
+    bool TryPush(FairMQParts&& parts)
+    {
+      uint64_t tail = fTail.load(std::memory_order_relaxed);
+      uint64_t occupancy = tail - fHead.load(std::memory_order_acquire);
+
+      if (fAboveWatermark) {
+        if (occupancy > fLowWatermark) {
+          ++fDroppedCount;
+          return false;
+        }
+        fAboveWatermark = false;
+      } else if (occupancy >= fHighWatermark) {
+        fAboveWatermark = true;
+        ++fDroppedCount;
+        return false;
+      }
+
+      Entry& slot = fSlots[tail & (fCapacity - 1)];
+      slot.parts = std::move(parts);
+      slot.arrivalTime = std::chrono::steady_clock::now();
+      fTail.store(tail + 1, std::memory_order_release);
+
+      ++fAcceptedCount;
+      if (occupancy + 1 > fMaxOccupancy) {
+        fMaxOccupancy = occupancy + 1;
+      }
+      return true;
+    }
+
+    /// Consumer side: the oldest buffered entry, nullptr when the ring is
+    /// empty. The entry stays valid until Pop().
+    Entry* Front()
+    {
+      uint64_t head = fHead.load(std::memory_order_relaxed);
+      if (fTail.load(std::memory_order_acquire) == head) {
+        return nullptr;
+      }
+      return &fSlots[head & (fCapacity - 1)];
+    }
+
+    /// Consumer side: release the oldest entry. Only valid after Front()
+    /// returned non-null.
+    void Pop()
+    {
+      uint64_t head = fHead.load(std::memory_order_relaxed);
+      fSlots[head & (fCapacity - 1)].parts.fParts.clear();
+      fHead.store(head + 1, std::memory_order_release);
+    }
+
+    /// Current occupancy; exact for the two ring threads, a snapshot for
+    /// anybody else
+    size_t GetOccupancy() const
+    {
+      return fTail.load(std::memory_order_acquire) - fHead.load(std::memory_order_acquire);
+    }
+
+    size_t GetCapacity() const { return fCapacity; }
+
+    /// Producer-side counters for occupancy metrics
+    uint64_t GetAcceptedCount() const { return fAcceptedCount; }
+    uint64_t GetDroppedCount() const { return fDroppedCount; }
+    size_t GetMaxOccupancy() const { return fMaxOccupancy; }
+
+  private:
+    static size_t RoundUpToPowerOfTwo(size_t n)
+    {
+      size_t result = 2;
+      while (result < n) {
+        result <<= 1;
+      }
+      return result;
+    }
+
+    const size_t fCapacity; ///< Number of slots, always a power of two
+    const size_t fHighWatermark; ///< Occupancy at which pushes start failing
+    const size_t fLowWatermark; ///< Occupancy below which pushes resume
+
+    std::vector<Entry> fSlots; ///< The ring storage
+    std::atomic<uint64_t> fHead; ///< Pop position, owned by the consumer
+    std::atomic<uint64_t> fTail; ///< Push position, owned by the producer
+
+    bool fAboveWatermark; ///< Backpressure state, producer only
+    uint64_t fAcceptedCount; ///< Sub-timeframes buffered, producer only
+    uint64_t fDroppedCount; ///< Sub-timeframes dropped, producer only
+    size_t fMaxOccupancy; ///< Highest occupancy seen, producer only
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif
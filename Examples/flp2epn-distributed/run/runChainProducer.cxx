@@ -0,0 +1,27 @@
+/**
+ * runChainProducer.cxx
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#include "runFairMQDevice.h"
+#include "FLP2EPNex_distributed/ChainProducer.h"
+
+#include <string>
+
+namespace bpo = boost::program_options;
+
+void addCustomOptions(bpo::options_description& options)
+{
+  options.add_options()
+    ("num-frames", bpo::value<int>()->default_value(100), "Number of frames (sub-timeframes) to produce")
+    ("events-per-frame", bpo::value<int>()->default_value(10), "Events batched into one frame")
+    ("clusters-per-event", bpo::value<int>()->default_value(10000), "Synthetic TPC clusters per event")
+    ("out-chan-name", bpo::value<std::string>()->default_value("stf1"), "Name of the output channel (towards the flpSender)");
+}
+
+FairMQDevice* getDevice(const FairMQProgOptions& config)
+{
+  return new AliceO2::Devices::ChainProducer();
+}
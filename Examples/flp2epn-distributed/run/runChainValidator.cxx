@@ -0,0 +1,27 @@
+/**
+ * runChainValidator.cxx
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#include "runFairMQDevice.h"
+#include "FLP2EPNex_distributed/ChainValidator.h"
+
+#include <string>
+
+namespace bpo = boost::program_options;
+
+void addCustomOptions(bpo::options_description& options)
+{
+  options.add_options()
+    ("num-frames", bpo::value<int>()->default_value(100), "Number of frames expected from the chain")
+    ("min-throughput", bpo::value<double>()->default_value(0.), "End-to-end pass threshold in MB/s of raw data (0 - disabled)")
+    ("max-latency-ms", bpo::value<double>()->default_value(0.), "Mean-latency pass threshold in milliseconds (0 - disabled)")
+    ("in-chan-name", bpo::value<std::string>()->default_value("tf"), "Name of the input channel (timeframes from the epnReceiver)");
+}
+
+FairMQDevice* getDevice(const FairMQProgOptions& config)
+{
+  return new AliceO2::Devices::ChainValidator();
+}
@@ -16,11 +16,17 @@ void addCustomOptions(bpo::options_description& options)
 {
   options.add_options()
     ("buffer-timeout", bpo::value<int>()->default_value(1000), "Buffer timeout in milliseconds")
+    ("tf-buffer-slots", bpo::value<int>()->default_value(1024), "Slots of the timeframe reassembly table (rounded up to a power of two)")
     ("num-flps", bpo::value<int>()->required(), "Number of FLPs")
     ("test-mode", bpo::value<int>()->default_value(0), "Run in test mode")
     ("in-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the input channel (sub-time frames)")
     ("out-chan-name", bpo::value<std::string>()->default_value("tf"), "Name of the output channel (time frames)")
-    ("ack-chan-name", bpo::value<std::string>()->default_value("ack"), "Name of the acknowledgement channel");
+    ("ack-chan-name", bpo::value<std::string>()->default_value("ack"), "Name of the acknowledgement channel")
+    ("epn-index", bpo::value<int>()->default_value(0), "Index of the EPN, stamped into its heartbeats")
+    ("hb-chan-name", bpo::value<std::string>()->default_value(""), "Name of the heartbeat channel (empty - heartbeats disabled)")
+    ("hb-interval", bpo::value<int>()->default_value(100), "Heartbeat interval in milliseconds")
+    ("event-log", bpo::value<std::string>()->default_value(""), "Path of the binary event log ring file (empty - disabled)")
+    ("thread-placement", bpo::value<std::string>()->default_value(""), "Core placement of the device threads, role:cpus[;role:cpus] with roles poller (empty - left to the OS)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
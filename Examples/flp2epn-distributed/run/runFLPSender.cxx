@@ -21,8 +21,15 @@ void addCustomOptions(bpo::options_description& options)
     ("test-mode", bpo::value<int>()->default_value(0), "Run in test mode")
     ("send-offset", bpo::value<int>()->default_value(0), "Offset for staggered sending")
     ("send-delay", bpo::value<int>()->default_value(8), "Delay for staggered sending")
+    ("stf-buffer-size", bpo::value<int>()->default_value(256), "Capacity of the sub-timeframe buffer (rounded up to a power of two)")
+    ("sched-policy", bpo::value<std::string>()->default_value("round-robin"), "EPN scheduling policy (round-robin/weighted-round-robin/least-outstanding)")
+    ("epn-weights", bpo::value<std::string>()->default_value(""), "Comma-separated EPN weights for weighted-round-robin")
     ("in-chan-name", bpo::value<std::string>()->default_value("stf1"), "Name of the input channel (sub-time frames)")
-    ("out-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the output channel (sub-time frames)");
+    ("out-chan-name", bpo::value<std::string>()->default_value("stf2"), "Name of the output channel (sub-time frames)")
+    ("hb-chan-name", bpo::value<std::string>()->default_value(""), "Name of the EPN heartbeat channel (empty - heartbeat tracking disabled)")
+    ("hb-timeout", bpo::value<int>()->default_value(1000), "Heartbeat timeout in milliseconds, stale EPNs are skipped")
+    ("event-log", bpo::value<std::string>()->default_value(""), "Path of the binary event log ring file (empty - disabled)")
+    ("thread-placement", bpo::value<std::string>()->default_value(""), "Core placement of the device threads, role:cpus[;role:cpus] with roles poller, send, heartbeat (empty - left to the OS)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
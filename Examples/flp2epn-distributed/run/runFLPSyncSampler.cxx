@@ -18,8 +18,13 @@ void addCustomOptions(bpo::options_description& options)
     ("event-rate", bpo::value<int>()->default_value(0), "Event rate limit in maximum number of events per second")
     ("max-events", bpo::value<int>()->default_value(0), "Maximum number of events to send (0 - unlimited)")
     ("store-rtt-in-file", bpo::value<int>()->default_value(0), "Store round trip time measurements in a file (1/0)")
+    ("num-epns", bpo::value<int>()->default_value(0), "Number of EPNs (0 - no sampler-side scheduling)")
+    ("sched-policy", bpo::value<std::string>()->default_value("round-robin"), "EPN scheduling policy (round-robin/weighted-round-robin/least-outstanding)")
+    ("epn-weights", bpo::value<std::string>()->default_value(""), "Comma-separated EPN weights for weighted-round-robin")
     ("ack-chan-name", bpo::value<std::string>()->default_value("ack"), "Name of the acknowledgement channel")
-    ("out-chan-name", bpo::value<std::string>()->default_value("stf1"), "Name of the output channel (sub-time frames)");
+    ("out-chan-name", bpo::value<std::string>()->default_value("stf1"), "Name of the output channel (sub-time frames)")
+    ("event-log", bpo::value<std::string>()->default_value(""), "Path of the binary event log ring file (empty - disabled)")
+    ("thread-placement", bpo::value<std::string>()->default_value(""), "Core placement of the device threads, role:cpus[;role:cpus] with roles poller, ack (empty - left to the OS)");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
@@ -0,0 +1,200 @@
+/**
+ * ChainProducer.cxx
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iostream> // DataDeflater.h expects it from the includer
+#include <random>
+#include <vector>
+
+#include "FairMQLogger.h"
+#include "FairMQProgOptions.h"
+
+#include "DataCompression/DataDeflater.h"
+#include "Headers/DataHeader.h"
+
+#include "FLP2EPNex_distributed/ChainPayload.h"
+#include "FLP2EPNex_distributed/ChainProducer.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace AliceO2::Devices;
+
+namespace {
+
+// a codec is required by the deflater interface, the chain packs raw
+// fixed-width symbols
+struct DummyCodec {};
+typedef AliceO2::DataDeflater<uint64_t, uint8_t, DummyCodec> Deflater_t;
+
+/// generate the packed symbols of one event; clusters follow the shapes
+/// seen in data: flat pad/row occupancy, gaussian widths around one pad
+/// (time bin) and a steeply falling charge spectrum
+uint32_t generateEvent(int eventIndex, int numOfClusters, vector<uint16_t>& symbols)
+{
+  // seeded per event, so the content only depends on the event index
+  mt19937 rng(0x4348u + eventIndex);
+  uniform_real_distribution<float> flat(0.f, 1.f);
+  normal_distribution<float> width(1.f, 0.3f);
+  exponential_distribution<float> charge(1.f / 120.f);
+
+  uint32_t checksum = 0;
+  symbols.clear();
+  symbols.reserve(numOfClusters * ChainSymbolOrder::kSymbolsPerCluster);
+  for (int i = 0; i < numOfClusters; i++) {
+    const float qTot = 10.f + charge(rng);
+    const uint16_t cluster[ChainSymbolOrder::kSymbolsPerCluster] = {
+      AliceO2::TPCClusterRecord::Pack(flat(rng) * 62.f, 0,
+                                      AliceO2::TPCClusterWidth::kPadRow),
+      AliceO2::TPCClusterRecord::Pack(flat(rng) * 138.f,
+                                      AliceO2::TPCClusterWidth::kPadFractionBits,
+                                      AliceO2::TPCClusterWidth::kPad),
+      AliceO2::TPCClusterRecord::Pack(flat(rng) * 445.f,
+                                      AliceO2::TPCClusterWidth::kTimeFractionBits,
+                                      AliceO2::TPCClusterWidth::kTime),
+      AliceO2::TPCClusterRecord::Pack(width(rng),
+                                      AliceO2::TPCClusterWidth::kSigmaFractionBits,
+                                      AliceO2::TPCClusterWidth::kSigmaY2),
+      AliceO2::TPCClusterRecord::Pack(width(rng),
+                                      AliceO2::TPCClusterWidth::kSigmaFractionBits,
+                                      AliceO2::TPCClusterWidth::kSigmaZ2),
+      AliceO2::TPCClusterRecord::Pack(qTot, 0, AliceO2::TPCClusterWidth::kCharge),
+      AliceO2::TPCClusterRecord::Pack(qTot * 0.3f, 0, AliceO2::TPCClusterWidth::kQMax)
+    };
+    for (int s = 0; s < ChainSymbolOrder::kSymbolsPerCluster; s++) {
+      symbols.push_back(cluster[s]);
+      checksum += cluster[s];
+    }
+  }
+  return checksum;
+}
+
+}
+
+ChainProducer::ChainProducer()
+  : fNumFrames(0)
+  , fEventsPerFrame(0)
+  , fClustersPerEvent(0)
+  , fOutChannelName()
+{
+}
+
+ChainProducer::~ChainProducer()
+{
+}
+
+void ChainProducer::InitTask()
+{
+  fNumFrames = fConfig->GetValue<int>("num-frames");
+  fEventsPerFrame = fConfig->GetValue<int>("events-per-frame");
+  fClustersPerEvent = fConfig->GetValue<int>("clusters-per-event");
+  fOutChannelName = fConfig->GetValue<string>("out-chan-name");
+}
+
+void ChainProducer::Run()
+{
+  FairMQChannel& outChannel = fChannels.at(fOutChannelName).at(0);
+
+  const size_t rawEventSize = fClustersPerEvent
+    * ChainSymbolOrder::kSymbolsPerCluster * sizeof(uint16_t);
+  const size_t deflatedCapacity = (fClustersPerEvent
+    * ChainSymbolOrder::bitsPerCluster() + 7) / 8 + 8;
+  const size_t frameCapacity = fEventsPerFrame
+    * (sizeof(AliceO2::Header::DataHeader) + sizeof(BenchEventHeader)
+       + deflatedCapacity + 64) + 256;
+
+  vector<uint16_t> symbols;
+  vector<uint8_t> payload(sizeof(BenchEventHeader) + deflatedCapacity);
+  Deflater_t deflater;
+
+  uint64_t generateNs = 0, deflateNs = 0, frameNs = 0, sendNs = 0;
+  uint64_t rawBytes = 0, sentBytes = 0;
+  int eventIndex = 0;
+  int framesSent = 0;
+
+  for (int frame = 0; frame < fNumFrames && CheckCurrentState(RUNNING); frame++) {
+    Base::FrameBuilder builder(frameCapacity);
+
+    for (int event = 0; event < fEventsPerFrame; event++, eventIndex++) {
+      // stage 1: digit/cluster generation
+      auto t0 = steady_clock::now();
+      const uint32_t checksum = generateEvent(eventIndex, fClustersPerEvent, symbols);
+      auto t1 = steady_clock::now();
+
+      // stage 2: compression with the production bit widths
+      deflater.Init(payload.data() + sizeof(BenchEventHeader), deflatedCapacity);
+      for (size_t s = 0; s < symbols.size(); s++) {
+        deflater.WriteRaw(symbols[s],
+                          ChainSymbolOrder::width(s % ChainSymbolOrder::kSymbolsPerCluster));
+      }
+      const int deflatedSize = deflater.Close();
+      auto t2 = steady_clock::now();
+      if (deflatedSize < 0) {
+        LOG(ERROR) << "Deflater ran out of space, aborting";
+        return;
+      }
+
+      // stage 3: header framing
+      BenchEventHeader eventHeader;
+      eventHeader.numOfClusters = fClustersPerEvent;
+      eventHeader.checksum = checksum;
+      eventHeader.generatedNs = duration_cast<nanoseconds>(t0.time_since_epoch()).count();
+      eventHeader.rawSize = rawEventSize;
+      eventHeader.compressedSize = deflatedSize;
+      memcpy(payload.data(), &eventHeader, sizeof(eventHeader));
+
+      AliceO2::Header::DataHeader dataHeader;
+      dataHeader = AliceO2::Header::gDataOriginTPC;
+      dataHeader = AliceO2::Header::DataDescription("BENCHCLUSTERS");
+      dataHeader.payloadSize = sizeof(eventHeader) + deflatedSize;
+
+      if (!builder.addPair(&dataHeader, sizeof(dataHeader),
+                           payload.data(), sizeof(eventHeader) + deflatedSize)) {
+        LOG(ERROR) << "Frame capacity exceeded, aborting";
+        return;
+      }
+      auto t3 = steady_clock::now();
+
+      generateNs += duration_cast<nanoseconds>(t1 - t0).count();
+      deflateNs += duration_cast<nanoseconds>(t2 - t1).count();
+      frameNs += duration_cast<nanoseconds>(t3 - t2).count();
+      rawBytes += rawEventSize;
+    }
+
+    // stage 4: hand the sealed frame to the transport as one message part
+    Base::O2Message parts;
+    if (!AddFrame(parts, move(builder))) {
+      LOG(ERROR) << "Could not seal the frame, aborting";
+      return;
+    }
+    sentBytes += parts.At(0)->GetSize();
+    auto sendStart = steady_clock::now();
+    if (outChannel.Send(parts.At(0)) < 0) {
+      LOG(ERROR) << "Could not send frame " << frame;
+      return;
+    }
+    framesSent++;
+    sendNs += duration_cast<nanoseconds>(steady_clock::now() - sendStart).count();
+  }
+
+  const double toMBps = 1.0e9 / (1024.0 * 1024.0);
+  LOG(INFO) << "chain producer: " << framesSent << " frames, "
+            << eventIndex << " events, " << rawBytes << " raw bytes ("
+            << sentBytes << " on the wire)";
+  if (generateNs > 0) {
+    LOG(INFO) << "chain stage generate: " << (double)rawBytes / generateNs * toMBps << " MB/s";
+  }
+  if (deflateNs > 0) {
+    LOG(INFO) << "chain stage deflate:  " << (double)rawBytes / deflateNs * toMBps << " MB/s";
+  }
+  if (frameNs > 0) {
+    LOG(INFO) << "chain stage frame:    " << (double)rawBytes / frameNs * toMBps << " MB/s";
+  }
+  if (sendNs > 0) {
+    LOG(INFO) << "chain stage send:     " << (double)sentBytes / sendNs * toMBps << " MB/s";
+  }
+}
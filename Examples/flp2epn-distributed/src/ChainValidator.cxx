@@ -0,0 +1,152 @@
+/**
+ * ChainValidator.cxx
+ *
+ * @since 2016-11-08
+ * @author M. Al-Turany, A. Rybalchenko
+ */
+
+#include <chrono>
+#include <cstring>
+
+#include "FairMQLogger.h"
+#include "FairMQProgOptions.h"
+
+#include "Headers/DataHeader.h"
+#include "O2Device/MessageFrame.h"
+
+#include "FLP2EPNex_distributed/ChainPayload.h"
+#include "FLP2EPNex_distributed/ChainValidator.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace AliceO2::Devices;
+
+ChainValidator::ChainValidator()
+  : fNumFrames(0)
+  , fMinThroughput(0.)
+  , fMaxLatencyMs(0.)
+  , fInChannelName()
+{
+}
+
+ChainValidator::~ChainValidator()
+{
+}
+
+void ChainValidator::InitTask()
+{
+  fNumFrames = fConfig->GetValue<int>("num-frames");
+  fMinThroughput = fConfig->GetValue<double>("min-throughput");
+  fMaxLatencyMs = fConfig->GetValue<double>("max-latency-ms");
+  fInChannelName = fConfig->GetValue<string>("in-chan-name");
+}
+
+void ChainValidator::Run()
+{
+  uint64_t inflateNs = 0, latencyNs = 0;
+  uint64_t rawBytes = 0, wireBytes = 0;
+  uint64_t events = 0, clusters = 0, corruptEvents = 0;
+  int framesReceived = 0;
+  auto runStart = steady_clock::now();
+
+  while (framesReceived < fNumFrames && CheckCurrentState(RUNNING)) {
+    // one timeframe from the epnReceiver; with one FLP in the topology it
+    // carries the producer frame as its single part
+    FairMQParts timeframe;
+    if (Receive(timeframe, fInChannelName, 0, 100) < 0) {
+      continue;
+    }
+    framesReceived++;
+    auto received = steady_clock::now();
+
+    for (int p = 0; p < timeframe.Size(); p++) {
+      wireBytes += timeframe.At(p)->GetSize();
+      Base::FrameReader reader(reinterpret_cast<const byte*>(timeframe.At(p)->GetData()),
+                               timeframe.At(p)->GetSize());
+      if (!reader.isValid()) {
+        LOG(ERROR) << "Received a malformed frame in timeframe " << framesReceived;
+        corruptEvents++;
+        continue;
+      }
+
+      for (size_t pair = 0; pair < reader.getPairCount(); pair++) {
+        const byte* headerBuffer; size_t headerSize;
+        const byte* payloadBuffer; size_t payloadSize;
+        reader.getPair(pair, headerBuffer, headerSize, payloadBuffer, payloadSize);
+
+        AliceO2::Header::DataHeader dataHeader;
+        if (headerSize < sizeof(dataHeader)) {
+          corruptEvents++;
+          continue;
+        }
+        memcpy(&dataHeader, headerBuffer, sizeof(dataHeader));
+        if (!(dataHeader == AliceO2::Header::gDataOriginTPC)
+            || dataHeader.payloadSize != payloadSize
+            || payloadSize < sizeof(BenchEventHeader)) {
+          corruptEvents++;
+          continue;
+        }
+
+        BenchEventHeader eventHeader;
+        memcpy(&eventHeader, payloadBuffer, sizeof(eventHeader));
+        if (sizeof(eventHeader) + eventHeader.compressedSize > payloadSize) {
+          corruptEvents++;
+          continue;
+        }
+
+        // inflate and verify against the producer checksum
+        auto t0 = steady_clock::now();
+        BitReader bits(reinterpret_cast<const uint8_t*>(payloadBuffer) + sizeof(eventHeader),
+                       eventHeader.compressedSize);
+        uint32_t checksum = 0;
+        for (uint32_t c = 0; c < eventHeader.numOfClusters; c++) {
+          for (int s = 0; s < ChainSymbolOrder::kSymbolsPerCluster; s++) {
+            checksum += bits.read(ChainSymbolOrder::width(s));
+          }
+        }
+        inflateNs += duration_cast<nanoseconds>(steady_clock::now() - t0).count();
+
+        if (bits.hasOverflowed() || checksum != eventHeader.checksum) {
+          corruptEvents++;
+          continue;
+        }
+
+        events++;
+        clusters += eventHeader.numOfClusters;
+        rawBytes += eventHeader.rawSize;
+        latencyNs += duration_cast<nanoseconds>(received.time_since_epoch()).count()
+                     - eventHeader.generatedNs;
+      }
+    }
+  }
+
+  const uint64_t elapsedNs = duration_cast<nanoseconds>(steady_clock::now() - runStart).count();
+  const double toMBps = 1.0e9 / (1024.0 * 1024.0);
+  const double throughput = elapsedNs > 0 ? (double)rawBytes / elapsedNs * toMBps : 0.;
+  const double meanLatencyMs = events > 0 ? (double)latencyNs / events / 1.0e6 : 0.;
+
+  LOG(INFO) << "chain validator: " << framesReceived << " frames, " << events
+            << " events, " << clusters << " clusters, " << rawBytes << " raw bytes ("
+            << wireBytes << " on the wire), " << corruptEvents << " corrupt";
+  if (inflateNs > 0) {
+    LOG(INFO) << "chain stage inflate:  " << (double)rawBytes / inflateNs * toMBps << " MB/s";
+  }
+  LOG(INFO) << "chain end-to-end: " << throughput << " MB/s, mean latency "
+            << meanLatencyMs << " ms";
+
+  bool passed = (corruptEvents == 0) && (framesReceived == fNumFrames) && (events > 0);
+  if (fMinThroughput > 0. && throughput < fMinThroughput) {
+    LOG(ERROR) << "throughput " << throughput << " MB/s below threshold " << fMinThroughput;
+    passed = false;
+  }
+  if (fMaxLatencyMs > 0. && meanLatencyMs > fMaxLatencyMs) {
+    LOG(ERROR) << "mean latency " << meanLatencyMs << " ms above threshold " << fMaxLatencyMs;
+    passed = false;
+  }
+
+  if (passed) {
+    LOG(INFO) << "chain benchmark PASSED";
+  } else {
+    LOG(ERROR) << "chain benchmark FAILED";
+  }
+}
@@ -6,12 +6,13 @@
  */
 
 #include <cstddef> // size_t
-#include <fstream> // writing to file (DEBUG)
+#include <cstring> // memcpy
 
 #include "FairMQLogger.h"
 #include "FairMQProgOptions.h"
 
 #include "FLP2EPNex_distributed/EPNReceiver.h"
+#include "FLP2EPNex_distributed/FlowEvents.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -23,14 +24,16 @@ struct f2eHeader {
 };
 
 EPNReceiver::EPNReceiver()
-  : fTimeframeBuffer()
-  , fDiscardedSet()
+  : fBuilder()
   , fNumFLPs(0)
   , fBufferTimeoutInMs(5000)
   , fTestMode(0)
+  , fIndex(0)
+  , fHeartbeatIntervalMs(100)
   , fInChannelName()
   , fOutChannelName()
   , fAckChannelName()
+  , fHeartbeatChannelName()
 {
 }
 
@@ -46,59 +49,67 @@ void EPNReceiver::InitTask()
   fInChannelName = fConfig->GetValue<string>("in-chan-name");
   fOutChannelName = fConfig->GetValue<string>("out-chan-name");
   fAckChannelName = fConfig->GetValue<string>("ack-chan-name");
-}
-
-void EPNReceiver::PrintBuffer(const unordered_map<uint16_t, TFBuffer>& buffer) const
-{
-  string header = "===== ";
+  fIndex = fConfig->GetValue<int>("epn-index");
+  fHeartbeatIntervalMs = fConfig->GetValue<int>("hb-interval");
+  fHeartbeatChannelName = fConfig->GetValue<string>("hb-chan-name");
 
-  for (int i = 1; i <= fNumFLPs; ++i) {
-    stringstream out;
-    out << i % 10;
-    header += out.str();
-    //i > 9 ? header += " " : header += "  ";
+  string eventLogPath = fConfig->GetValue<string>("event-log");
+  if (!eventLogPath.empty() && !fEventLog.Open(eventLogPath, 0)) {
+    LOG(WARN) << "Could not open event log file '" << eventLogPath << "', event logging disabled";
   }
-  LOG(INFO) << header;
 
-  for (auto& it : buffer) {
-    string stars = "";
-    for (unsigned int j = 1; j <= (it.second).parts.Size(); ++j) {
-      stars += "*";
+  string placementSpec = fConfig->GetValue<string>("thread-placement");
+  if (!placementSpec.empty()) {
+    if (fPlacement.parse(placementSpec)) {
+      // echo the applied placement into the monitoring stream
+      LOG(INFO) << "Thread placement: " << fPlacement.describe();
+    } else {
+      LOG(WARN) << "Could not parse thread placement spec '" << placementSpec << "', placement disabled";
     }
-    LOG(INFO) << setw(4) << it.first << ": " << stars;
   }
-}
 
-void EPNReceiver::DiscardIncompleteTimeframes()
-{
-  auto it = fTimeframeBuffer.begin();
-
-  while (it != fTimeframeBuffer.end()) {
-    if (duration_cast<milliseconds>(steady_clock::now() - (it->second).start).count() > fBufferTimeoutInMs) {
-      LOG(WARN) << "Timeframe #" << it->first << " incomplete after " << fBufferTimeoutInMs << " milliseconds, discarding";
-      fDiscardedSet.insert(it->first);
-      fTimeframeBuffer.erase(it++);
-      LOG(WARN) << "Number of discarded timeframes: " << fDiscardedSet.size();
-    } else {
-      // LOG(INFO) << "Timeframe #" << it->first << " within timeout, buffering...";
-      ++it;
+  fBuilder.reset(new TimeFrameBuilder<FairMQMessagePtr>(
+    fNumFLPs, fConfig->GetValue<int>("tf-buffer-slots")));
+  fBuilder->SetDiscardHandler([this](int32_t id, size_t parts, const char* reason) {
+    if (fEventLog.IsOpen()) {
+      // production rates: no per-event text formatting
+      fEventLog.Record(kTimeframeDiscarded, id);
+      return;
     }
-  }
+    LOG(WARN) << "Timeframe #" << id << " incomplete (" << parts << "/" << fNumFLPs
+              << " parts), discarding (" << reason << ")";
+    LOG(WARN) << "Number of discarded timeframes: " << fBuilder->GetDiscardedCount() + 1;
+  });
 }
 
 void EPNReceiver::Run()
 {
-  // DEBUG: store receive intervals per FLP
-  // vector<vector<int>> rcvIntervals(fNumFLPs, vector<int>());
-  // vector<std::chrono::steady_clock::time_point> rcvTimestamp(fNumFLPs);
-  // end DEBUG
+  if (fPlacement.hasRole("poller") && !fPlacement.apply("poller")) {
+    LOG(WARN) << "Could not place the poller thread";
+  }
+
+  using Builder = TimeFrameBuilder<FairMQMessagePtr>;
 
-  // f2eHeader* header; // holds the header of the currently arrived message.
   uint16_t id = 0; // holds the timeframe id of the currently arrived sub-timeframe.
 
   FairMQChannel& ackOutChannel = fChannels.at(fAckChannelName).at(0);
 
+  const bool heartbeats = !fHeartbeatChannelName.empty();
+  auto lastHeartbeat = steady_clock::now() - milliseconds(fHeartbeatIntervalMs);
+
   while (CheckCurrentState(RUNNING)) {
+    if (heartbeats) {
+      // liveness signal for the flpSenders; the receive below has a 100 ms
+      // timeout, so the loop comes back here regardless of traffic
+      auto now = steady_clock::now();
+      if (duration_cast<milliseconds>(now - lastHeartbeat).count() >= fHeartbeatIntervalMs) {
+        unique_ptr<FairMQMessage> beat(NewMessage(sizeof(int)));
+        memcpy(beat->GetData(), &fIndex, sizeof(int));
+        fChannels.at(fHeartbeatChannelName).at(0).Send(beat, 0);
+        lastHeartbeat = now;
+      }
+    }
+
     FairMQParts parts;
 
     if (Receive(parts, fInChannelName, 0, 100) > 0) {
@@ -107,76 +118,54 @@ void EPNReceiver::Run()
       id = header.timeFrameId;
       // LOG(INFO) << "Received sub-time frame #" << id << " from FLP" << header.flpIndex;
 
-      // DEBUG:: store receive intervals per FLP
-      // if (fTestMode > 0) {
-      //   int flpId = header.flpIndex;
-      //   rcvIntervals.at(flpId).push_back(duration_cast<milliseconds>(steady_clock::now() - rcvTimestamp.at(flpId)).count());
-      //   LOG(WARN) << rcvIntervals.at(flpId).back();
-      //   rcvTimestamp.at(flpId) = steady_clock::now();
-      // }
-      // end DEBUG
-
-      if (fDiscardedSet.find(id) == fDiscardedSet.end())
-      {
-        if (fTimeframeBuffer.find(id) == fTimeframeBuffer.end())
-        {
-          // if this is the first part with this ID, save the receive time.
-          fTimeframeBuffer[id].start = steady_clock::now();
-        }
-        // if the received ID has not previously been discarded,
-        // store the data part in the buffer
-        fTimeframeBuffer[id].parts.AddPart(move(parts.At(1)));
-        // PrintBuffer(fTimeframeBuffer);
-      }
-      else
-      {
-        // if received ID has been previously discarded.
-        LOG(WARN) << "Received part from an already discarded timeframe with id " << id;
-      }
-
-      if (fTimeframeBuffer[id].parts.Size() == fNumFLPs) {
-        if (fTestMode > 0) {
-          // Send an acknowledgement back to the sampler to measure the round trip time
-          unique_ptr<FairMQMessage> ack(NewMessage(sizeof(uint16_t)));
-          memcpy(ack->GetData(), &id, sizeof(uint16_t));
-
-          if (ackOutChannel.Send(ack, 0) <= 0) {
-            LOG(ERROR) << "Could not send acknowledgement without blocking";
+      switch (fBuilder->AddPart(id, header.flpIndex, move(parts.At(1)))) {
+        case Builder::AddResult::kLate:
+          if (fEventLog.IsOpen()) {
+            fEventLog.Record(kLatePart, id);
+          } else {
+            LOG(WARN) << "Received part from an already discarded timeframe with id " << id;
           }
+          break;
+        case Builder::AddResult::kDuplicate:
+          if (fEventLog.IsOpen()) {
+            fEventLog.Record(kDuplicatePart, id);
+          } else {
+            LOG(WARN) << "Received duplicated part of timeframe #" << id << " from FLP" << header.flpIndex;
+          }
+          break;
+        case Builder::AddResult::kCompleted: {
+          fEventLog.Record(kTimeframeComplete, id);
+          if (fTestMode > 0) {
+            // drop the assembled parts, send an acknowledgement back to the
+            // sampler to measure the round trip time
+            fBuilder->TakeCompleted();
+            unique_ptr<FairMQMessage> ack(NewMessage(sizeof(uint16_t)));
+            memcpy(ack->GetData(), &id, sizeof(uint16_t));
+
+            if (ackOutChannel.Send(ack, 0) <= 0) {
+              fEventLog.Record(kAckSendError, id);
+              LOG(ERROR) << "Could not send acknowledgement without blocking";
+            }
+          } else {
+            // LOG(INFO) << "Collected all parts for timeframe #" << id;
+            // move the collected parts into a single message and ship it,
+            // no payload is copied
+            FairMQParts timeframe;
+            timeframe.fParts = fBuilder->TakeCompleted();
+            Send(timeframe, fOutChannelName);
+          }
+          break;
         }
-        else
-        {
-          // LOG(INFO) << "Collected all parts for timeframe #" << id;
-          // when all parts are collected send them to the output channel
-          Send(fTimeframeBuffer[id].parts, fOutChannelName);
-        }
-
-        // fTimeframeBuffer[id].end = steady_clock::now();
-
-        fTimeframeBuffer.erase(id);
+        case Builder::AddResult::kPending:
+          break;
       }
-
-      // LOG(WARN) << "Buffer size: " << fTimeframeBuffer.size();
     }
 
-    // check if any incomplete timeframes in the buffer are older than timeout period, and discard them if they are
-    DiscardIncompleteTimeframes();
+    // check whether the next slot of the sweep holds a timeframe older than the timeout period
+    fBuilder->Sweep(milliseconds(fBufferTimeoutInMs));
   }
 
-  // DEBUG: save
-  // if (fTestMode > 0) {
-  //   std::time_t t = system_clock::to_time_t(system_clock::now());
-  //   tm utc = *gmtime(&t);
-  //   std::stringstream s;
-  //   s << utc.tm_year + 1900 << "-" << utc.tm_mon + 1 << "-" << utc.tm_mday << "-" << utc.tm_hour << "-" << utc.tm_min << "-" << utc.tm_sec;
-  //   string name = s.str();
-  //   for (int x = 0; x < fNumFLPs; ++x) {
-  //     ofstream flpRcvTimes(fId + "-" + name + "-flp-" + to_string(x) + ".log");
-  //     for (auto it = rcvIntervals.at(x).begin() ; it != rcvIntervals.at(x).end(); ++it) {
-  //       flpRcvTimes << *it << endl;
-  //     }
-  //     flpRcvTimes.close();
-  //   }
-  // }
-  // end DEBUG
+  LOG(INFO) << "Discarded timeframes: " << fBuilder->GetDiscardedCount()
+            << ", duplicated parts: " << fBuilder->GetDuplicatedCount()
+            << ", late parts: " << fBuilder->GetLatePartsCount();
 }
@@ -14,6 +14,7 @@
 #include "FairMQProgOptions.h"
 
 #include "FLP2EPNex_distributed/FLPSender.h"
+#include "FLP2EPNex_distributed/FlowEvents.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -26,7 +27,12 @@ struct f2eHeader {
 
 FLPSender::FLPSender()
   : fSTFBuffer()
-  , fArrivalTime()
+  , fSendThread()
+  , fHeartbeatThread()
+  , fHeartbeats()
+  , fHeartbeatTimeoutMs(1000)
+  , fScheduler()
+  , fScheduledEPN()
   , fNumEPNs(0)
   , fIndex(0)
   , fSendOffset(0)
@@ -36,6 +42,7 @@ FLPSender::FLPSender()
   , fTimeFrameId(0)
   , fInChannelName()
   , fOutChannelName()
+  , fHeartbeatChannelName()
 {
 }
 
@@ -53,87 +60,225 @@ void FLPSender::InitTask()
   fSendDelay = fConfig->GetValue<int>("send-delay");
   fInChannelName = fConfig->GetValue<string>("in-chan-name");
   fOutChannelName = fConfig->GetValue<string>("out-chan-name");
+  fHeartbeatChannelName = fConfig->GetValue<string>("hb-chan-name");
+  fHeartbeatTimeoutMs = fConfig->GetValue<int>("hb-timeout");
+
+  fSTFBuffer.reset(new STFRing(fConfig->GetValue<int>("stf-buffer-size")));
+
+  if (!fHeartbeatChannelName.empty()) {
+    fHeartbeats.Init(fNumEPNs);
+  }
+
+  fScheduler.Init(fConfig->GetValue<string>("sched-policy"), fNumEPNs, fConfig->GetValue<string>("epn-weights"));
+  for (auto& epn : fScheduledEPN) {
+    epn.store(-1);
+  }
+
+  string eventLogPath = fConfig->GetValue<string>("event-log");
+  if (!eventLogPath.empty() && !fEventLog.Open(eventLogPath, fIndex)) {
+    LOG(WARN) << "Could not open event log file '" << eventLogPath << "', event logging disabled";
+  }
+
+  string placementSpec = fConfig->GetValue<string>("thread-placement");
+  if (!placementSpec.empty()) {
+    if (fPlacement.parse(placementSpec)) {
+      // echo the applied placement into the monitoring stream
+      LOG(INFO) << "Thread placement: " << fPlacement.describe();
+    } else {
+      LOG(WARN) << "Could not parse thread placement spec '" << placementSpec << "', placement disabled";
+    }
+  }
 }
 
 void FLPSender::Run()
 {
+  if (fPlacement.hasRole("poller") && !fPlacement.apply("poller")) {
+    LOG(WARN) << "Could not place the poller thread";
+  }
+
   // base buffer, to be copied from for every timeframe body (zero-copy)
   FairMQMessagePtr baseMsg(NewMessage(fEventSize));
 
   // store the channel reference to avoid traversing the map on every loop iteration
   FairMQChannel& dataInChannel = fChannels.at(fInChannelName).at(0);
 
+  // the sending runs on its own thread, this loop only receives and buffers
+  fSendThread = thread(&FLPSender::SendLoop, this);
+
+  if (!fHeartbeatChannelName.empty()) {
+    fHeartbeatThread = thread(&FLPSender::ReceiveHeartbeats, this);
+  }
+
+  uint64_t lastDroppedCount = 0;
+  auto lastStatusTime = steady_clock::now();
+
   while (CheckCurrentState(RUNNING)) {
-    // initialize f2e header
-    f2eHeader* header = new f2eHeader;
     if (fTestMode > 0) {
-      // test-mode: receive and store id part in the buffer.
-      FairMQMessagePtr id(NewMessage());
-      if (dataInChannel.Receive(id) > 0) {
-        header->timeFrameId = *(static_cast<uint16_t*>(id->GetData()));
-        header->flpIndex = fIndex;
-      } else {
+      // test-mode: the sampler publishes the due ids as one multipart batch,
+      // one schedule per part; buffer one sub-timeframe per id
+      FairMQParts ids;
+      if (dataInChannel.Receive(ids) < 0) {
         // if nothing was received, try again
-        delete header;
         continue;
       }
+      for (int p = 0; p < ids.Size(); p++) {
+        if (ids.At(p)->GetSize() < sizeof(uint16_t)) {
+          continue;
+        }
+        f2eHeader* header = new f2eHeader;
+        header->timeFrameId = *(static_cast<uint16_t*>(ids.At(p)->GetData()));
+        header->flpIndex = fIndex;
+        // the sampler may have scheduled the destination EPN already
+        if (ids.At(p)->GetSize() >= sizeof(TimeframeSchedule)) {
+          TimeframeSchedule& schedule = *(static_cast<TimeframeSchedule*>(ids.At(p)->GetData()));
+          fScheduledEPN.at(schedule.timeFrameId).store(schedule.epnIndex);
+        }
+
+        FairMQParts parts;
+        parts.AddPart(NewMessage(header, sizeof(f2eHeader), [](void* data, void* hint){ delete static_cast<f2eHeader*>(hint); }, header));
+        parts.AddPart(NewMessage());
+        parts.At(1)->Copy(baseMsg);
+
+        uint16_t bufferedId = header->timeFrameId;
+        fSTFBuffer->TryPush(move(parts));
+        fEventLog.Record(kStfBuffered, bufferedId);
+      }
     } else {
       // regular mode: use the id generated locally
+      f2eHeader* header = new f2eHeader;
       header->timeFrameId = fTimeFrameId;
       header->flpIndex = fIndex;
 
       if (++fTimeFrameId == UINT16_MAX - 1) {
         fTimeFrameId = 0;
       }
-    }
 
-    FairMQParts parts;
+      FairMQParts parts;
+      parts.AddPart(NewMessage(header, sizeof(f2eHeader), [](void* data, void* hint){ delete static_cast<f2eHeader*>(hint); }, header));
+      parts.AddPart(NewMessage());
 
-    parts.AddPart(NewMessage(header, sizeof(f2eHeader), [](void* data, void* hint){ delete static_cast<f2eHeader*>(hint); }, header));
-    parts.AddPart(NewMessage());
+      uint16_t bufferedId = header->timeFrameId;
 
-    // save the arrival time of the message.
-    fArrivalTime.push(steady_clock::now());
-
-    if (fTestMode > 0) {
-      // test-mode: initialize and store data part in the buffer.
-      parts.At(1)->Copy(baseMsg);
-      fSTFBuffer.push(move(parts));
-    } else {
-      // regular mode: receive data part from input
+      // receive data part from input
       if (dataInChannel.Receive(parts.At(1)) >= 0) {
-        fSTFBuffer.push(move(parts));
+        fSTFBuffer->TryPush(move(parts));
+        fEventLog.Record(kStfBuffered, bufferedId);
       } else {
         // if nothing was received, try again
         continue;
       }
     }
 
-    // if offset is 0 - send data out without staggering.
-    if (fSendOffset == 0 && fSTFBuffer.size() > 0) {
-      sendFrontData();
-    } else if (fSTFBuffer.size() > 0) {
-      if (duration_cast<milliseconds>(steady_clock::now() - fArrivalTime.front()).count() >= (fSendDelay * fSendOffset)) {
-        sendFrontData();
-      } else {
-        // LOG(INFO) << "buffering...";
+    // occupancy metrics, and a warning while backpressure is dropping data
+    auto now = steady_clock::now();
+    if (duration_cast<seconds>(now - lastStatusTime).count() >= 5) {
+      LogBufferStatus();
+      if (fSTFBuffer->GetDroppedCount() > lastDroppedCount) {
+        fEventLog.Record(kStfDropped, fSTFBuffer->GetDroppedCount() - lastDroppedCount);
+        LOG(WARN) << "STF buffer watermark reached, dropped "
+                  << fSTFBuffer->GetDroppedCount() - lastDroppedCount
+                  << " sub-timeframes since last report";
+        lastDroppedCount = fSTFBuffer->GetDroppedCount();
+      }
+      lastStatusTime = now;
+    }
+  }
+
+  fSendThread.join();
+  if (fHeartbeatThread.joinable()) {
+    fHeartbeatThread.join();
+    for (int epn = 0; epn < fNumEPNs; ++epn) {
+      if (fHeartbeats.GetStaleCount(epn) > 0) {
+        LOG(WARN) << "EPN[" << epn << "] was stale for " << fHeartbeats.GetStaleCount(epn)
+                  << " send decisions";
       }
     }
   }
+  LogBufferStatus();
 }
 
-inline void FLPSender::sendFrontData()
+void FLPSender::ReceiveHeartbeats()
 {
-  f2eHeader header = *(static_cast<f2eHeader*>(fSTFBuffer.front().At(0)->GetData()));
-  uint16_t currentTimeframeId = header.timeFrameId;
+  if (fPlacement.hasRole("heartbeat") && !fPlacement.apply("heartbeat")) {
+    LOG(WARN) << "Could not place the heartbeat thread";
+  }
+
+  // one beat is an int with the index of the beating EPN; the thread only
+  // stamps the table, the send path never waits for it
+  while (CheckCurrentState(RUNNING)) {
+    FairMQMessagePtr msg(NewMessage());
+    if (Receive(msg, fHeartbeatChannelName, 0, 100) >= static_cast<int>(sizeof(int))) {
+      fHeartbeats.Beat(*(static_cast<int*>(msg->GetData())), HeartbeatTable::NowMs());
+    }
+  }
+}
+
+void FLPSender::SendLoop()
+{
+  if (fPlacement.hasRole("send") && !fPlacement.apply("send")) {
+    LOG(WARN) << "Could not place the send thread";
+  }
 
-  // for which EPN is the message?
-  int direction = currentTimeframeId % fNumEPNs;
-  // LOG(INFO) << "Sending event " << currentTimeframeId << " to EPN#" << direction << "...";
+  while (CheckCurrentState(RUNNING)) {
+    STFRing::Entry* entry = fSTFBuffer->Front();
+    if (entry == nullptr) {
+      this_thread::sleep_for(milliseconds(1));
+      continue;
+    }
 
-  if (Send(fSTFBuffer.front(), fOutChannelName, direction, 0) < 0) {
+    // if offset is 0 - send data out without staggering.
+    if (fSendOffset > 0
+        && duration_cast<milliseconds>(steady_clock::now() - entry->arrivalTime).count() < (fSendDelay * fSendOffset)) {
+      // buffering...
+      this_thread::sleep_for(milliseconds(1));
+      continue;
+    }
+
+    SendData(*entry);
+    fSTFBuffer->Pop();
+  }
+}
+
+inline void FLPSender::SendData(STFRing::Entry& entry)
+{
+  f2eHeader header = *(static_cast<f2eHeader*>(entry.parts.At(0)->GetData()));
+  uint16_t currentTimeframeId = header.timeFrameId;
+
+  // for which EPN is the message? use the sampler's choice when it scheduled,
+  // the local (deterministic) policy otherwise
+  int direction = fScheduledEPN.at(currentTimeframeId).exchange(-1);
+  if (direction < 0 || direction >= fNumEPNs) {
+    direction = fScheduler.Schedule(currentTimeframeId);
+  }
+  if (!fHeartbeatChannelName.empty()) {
+    // wait-free staleness check: reroute around EPNs that stopped beating,
+    // falling back to the original choice when none is alive
+    uint64_t now = HeartbeatTable::NowMs();
+    int chosen = direction;
+    for (int attempt = 0; attempt < fNumEPNs; ++attempt) {
+      if (fHeartbeats.IsAlive(chosen, now, fHeartbeatTimeoutMs)) {
+        break;
+      }
+      chosen = (chosen + 1) % fNumEPNs;
+    }
+    if (chosen != direction) {
+      fEventLog.Record(kStfRerouted, currentTimeframeId);
+      direction = chosen;
+    }
+  }
+  if (Send(entry.parts, fOutChannelName, direction, 0) < 0) {
+    fEventLog.Record(kStfSendError, currentTimeframeId);
     LOG(ERROR) << "Failed to queue sub-timeframe #" << currentTimeframeId << " to EPN[" << direction << "]";
+  } else {
+    fEventLog.Record(kStfSent, currentTimeframeId);
   }
-  fSTFBuffer.pop();
-  fArrivalTime.pop();
+}
+
+void FLPSender::LogBufferStatus()
+{
+  fEventLog.Record(kBufferOccupancy, fSTFBuffer->GetOccupancy());
+  LOG(DEBUG) << "STF buffer: " << fSTFBuffer->GetOccupancy() << "/" << fSTFBuffer->GetCapacity()
+             << " (max " << fSTFBuffer->GetMaxOccupancy()
+             << "), accepted: " << fSTFBuffer->GetAcceptedCount()
+             << ", dropped: " << fSTFBuffer->GetDroppedCount();
 }
@@ -11,21 +11,34 @@
 #include "FairMQLogger.h"
 #include "FairMQProgOptions.h"
 
+#include "Instrumentation/Probe.h"
+
 #include "FLP2EPNex_distributed/FLPSyncSampler.h"
+#include "FLP2EPNex_distributed/FlowEvents.h"
 
 using namespace std;
 using namespace std::chrono;
 using namespace AliceO2::Devices;
+using AliceO2::Instrumentation::Cycles;
+
+namespace {
+// ids published in one batch at most; bounds the catch-up after a stall
+const uint64_t kMaxBatch = 512;
+}
 
 FLPSyncSampler::FLPSyncSampler()
   : fTimeframeRTT()
+  , fScheduler()
+  , fNumEPNs(0)
   , fEventRate(1)
   , fMaxEvents(0)
   , fStoreRTTinFile(0)
-  , fEventCounter(0)
   , fTimeFrameId(0)
+  , fCyclesPerSecond(0)
+  , fCyclesPerPeriod(0)
+  , fNextDue(0)
+  , fEventsPublished(0)
   , fAckListener()
-  , fResetEventCounter()
   , fLeaving(false)
   , fAckChannelName()
   , fOutChannelName()
@@ -46,34 +59,114 @@ void FLPSyncSampler::InitTask()
   fStoreRTTinFile = fConfig->GetValue<int>("store-rtt-in-file");
   fAckChannelName = fConfig->GetValue<string>("ack-chan-name");
   fOutChannelName = fConfig->GetValue<string>("out-chan-name");
+
+  fNumEPNs = fConfig->GetValue<int>("num-epns");
+  if (fNumEPNs > 0) {
+    fScheduler.Init(fConfig->GetValue<string>("sched-policy"), fNumEPNs, fConfig->GetValue<string>("epn-weights"));
+  }
+
+  string eventLogPath = fConfig->GetValue<string>("event-log");
+  if (!eventLogPath.empty() && !fEventLog.Open(eventLogPath, 0)) {
+    LOG(WARN) << "Could not open event log file '" << eventLogPath << "', event logging disabled";
+  }
+
+  string placementSpec = fConfig->GetValue<string>("thread-placement");
+  if (!placementSpec.empty()) {
+    if (fPlacement.parse(placementSpec)) {
+      // echo the applied placement into the monitoring stream
+      LOG(INFO) << "Thread placement: " << fPlacement.describe();
+    } else {
+      LOG(WARN) << "Could not parse thread placement spec '" << placementSpec << "', placement disabled";
+    }
+  }
 }
 
 void FLPSyncSampler::PreRun()
 {
+  if (fPlacement.hasRole("poller") && !fPlacement.apply("poller")) {
+    LOG(WARN) << "Could not place the poller thread";
+  }
+
   fLeaving = false;
   fAckListener = thread(&FLPSyncSampler::ListenForAcks, this);
-  fResetEventCounter = thread(&FLPSyncSampler::ResetEventCounter, this);
+
+  // calibrate the cycle counter against the steady clock once; the period
+  // bookkeeping then runs on raw counter reads
+  auto t0 = steady_clock::now();
+  uint64_t c0 = Cycles();
+  this_thread::sleep_for(milliseconds(50));
+  uint64_t c1 = Cycles();
+  auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - t0).count();
+  fCyclesPerSecond = (c1 - c0) * 1000000000ULL / elapsed;
+  fCyclesPerPeriod = fCyclesPerSecond / (fEventRate > 0 ? fEventRate : 1);
+  if (fCyclesPerPeriod == 0) {
+    fCyclesPerPeriod = 1;
+  }
+  fNextDue = Cycles();
+  fEventsPublished = 0;
+  LOG(INFO) << "Cycle counter calibration: " << fCyclesPerSecond << " cycles/s, "
+            << fCyclesPerPeriod << " cycles per timeframe";
 }
 
 bool FLPSyncSampler::ConditionalRun()
 {
-  FairMQMessagePtr msg(NewSimpleMessage(fTimeFrameId));
-
-  if (fChannels.at(fOutChannelName).at(0).Send(msg) >= 0) {
-    fTimeframeRTT[fTimeFrameId].start = steady_clock::now();
+  uint64_t now = Cycles();
+  if (now < fNextDue) {
+    // sleep towards the next deadline; an oversleep is repaired by the batch
+    // catch-up below, so no jitter accumulates across periods
+    uint64_t waitUs = (fNextDue - now) * 1000000ULL / fCyclesPerSecond;
+    if (waitUs > 0) {
+      this_thread::sleep_for(microseconds(waitUs));
+    }
+    now = Cycles();
+    if (now < fNextDue) {
+      return true;
+    }
+  }
 
-    if (++fTimeFrameId == UINT16_MAX - 1) {
-      fTimeFrameId = 0;
+  // every period elapsed by now is due; the deadlines advance on the fixed
+  // cycle grid, independent of when this wakeup actually happened
+  uint64_t due = (now - fNextDue) / fCyclesPerPeriod + 1;
+  if (due > kMaxBatch) {
+    due = kMaxBatch;
+  }
+  if (fMaxEvents > 0 && fEventsPublished + due > static_cast<uint64_t>(fMaxEvents)) {
+    due = fMaxEvents - fEventsPublished;
+  }
+  fNextDue += due * fCyclesPerPeriod;
+
+  // one part per due id, published as a single multipart message
+  FairMQParts parts;
+  uint16_t id = fTimeFrameId;
+  for (uint64_t i = 0; i < due; i++) {
+    TimeframeSchedule schedule;
+    schedule.timeFrameId = id;
+    // the dynamic policy can only run here, where the acknowledgements
+    // arrive; the static policies are evaluated by the flpSenders themselves
+    if (fNumEPNs > 0 && fScheduler.GetPolicy() == EPNScheduler::kLeastOutstanding) {
+      schedule.epnIndex = fScheduler.Schedule(id);
+    } else {
+      schedule.epnIndex = -1;
+    }
+    parts.AddPart(NewSimpleMessage(schedule));
+    if (++id == UINT16_MAX - 1) {
+      id = 0;
     }
   }
 
-  // rate limiting
-  --fEventCounter;
-  while (fEventCounter == 0) {
-    this_thread::sleep_for(milliseconds(1));
+  if (Send(parts, fOutChannelName) >= 0) {
+    auto start = steady_clock::now();
+    for (uint64_t i = 0; i < due; i++) {
+      fTimeframeRTT[fTimeFrameId].start = start;
+      fEventLog.Record(kScheduleSent, fTimeFrameId);
+      if (++fTimeFrameId == UINT16_MAX - 1) {
+        fTimeFrameId = 0;
+      }
+    }
+    fEventsPublished += due;
   }
 
-  if (fMaxEvents > 0 && fTimeFrameId >= fMaxEvents) {
+  if (fMaxEvents > 0 && fEventsPublished >= static_cast<uint64_t>(fMaxEvents)) {
     LOG(INFO) << "Reached configured maximum number of events (" << fMaxEvents << "). Exiting Run().";
     return false;
   }
@@ -84,12 +177,15 @@ bool FLPSyncSampler::ConditionalRun()
 void FLPSyncSampler::PostRun()
 {
     fLeaving = true;
-    fResetEventCounter.join();
     fAckListener.join();
 }
 
 void FLPSyncSampler::ListenForAcks()
 {
+  if (fPlacement.hasRole("ack") && !fPlacement.apply("ack")) {
+    LOG(WARN) << "Could not place the ack thread";
+  }
+
   uint16_t id = 0;
 
   ofstream ofsFrames;
@@ -111,6 +207,7 @@ void FLPSyncSampler::ListenForAcks()
 
     if (Receive(idMsg, fAckChannelName, 0, 1000) >= 0) {
       id = *(static_cast<uint16_t*>(idMsg->GetData()));
+      fScheduler.MarkAcknowledged(id);
       fTimeframeRTT.at(id).end = steady_clock::now();
       // store values in a file
       auto elapsed = duration_cast<microseconds>(fTimeframeRTT.at(id).end - fTimeframeRTT.at(id).start);
@@ -120,7 +217,12 @@ void FLPSyncSampler::ListenForAcks()
         ofsTimes  << elapsed.count() << "\n";
       }
 
-      LOG(INFO) << "Timeframe #" << id << " acknowledged after " << elapsed.count() << " μs.";
+      if (fEventLog.IsOpen()) {
+        // production rates: no per-event text formatting
+        fEventLog.Record(kAckReceived, elapsed.count());
+      } else {
+        LOG(INFO) << "Timeframe #" << id << " acknowledged after " << elapsed.count() << " μs.";
+      }
     }
   }
 
@@ -131,12 +233,3 @@ void FLPSyncSampler::ListenForAcks()
   }
   LOG(INFO) << "Exiting Ack listener";
 }
-
-void FLPSyncSampler::ResetEventCounter()
-{
-  while (!fLeaving) {
-    fEventCounter = fEventRate / 100;
-    this_thread::sleep_for(milliseconds(10));
-  }
-  LOG(INFO) << "Exiting ResetEventCounter";
-}
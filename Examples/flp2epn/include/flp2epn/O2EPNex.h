@@ -8,6 +8,10 @@
 #ifndef O2EPNEX_H_
 #define O2EPNEX_H_
 
+#include <random>
+#include <string>
+#include <vector>
+
 #include "FairMQDevice.h"
 
 class O2EPNex : public FairMQDevice
@@ -18,6 +22,31 @@ class O2EPNex : public FairMQDevice
     virtual ~O2EPNex();
 
     bool Process(std::unique_ptr<FairMQMessage>&, int);
+
+  protected:
+    // synthetic compute load applied per received time frame, so the
+    // topology tests exercise the transport-compute interaction and not
+    // only the transport
+    std::string fKernel;       // "none", "membw", "cache" or "mixed"
+    std::string fDistribution; // "fixed", "exponential" or "normal"
+    double fMeanMs;            // mean kernel duration per time frame
+    double fSigmaMs;           // width of the duration distribution
+
+    virtual void InitTask();
+    virtual void PostRun();
+
+  private:
+    double NextDurationMs();
+    void RunKernel(double durationMs);
+    void SweepLarge(); // one streaming pass over the large buffer
+    void SweepSmall(); // one arithmetic pass over the cache-resident buffer
+
+    std::vector<double> fLargeBuffer; // sized well beyond the caches
+    std::vector<double> fSmallBuffer; // stays resident in L1/L2
+    std::mt19937_64 fRng;
+    double fSink; // keeps the kernel loops observable to the compiler
+    unsigned long fFrames;
+    double fBusyMs;
 };
 
 #endif
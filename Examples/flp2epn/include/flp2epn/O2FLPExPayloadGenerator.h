@@ -0,0 +1,121 @@
+/**
+ * O2FLPExPayloadGenerator.h
+ *
+ * Generator of message payloads with configurable size distribution and
+ * content entropy. Production sub-time frames are not fixed-size: their
+ * sizes follow a broad log-normal distribution and differ between FLPs, and
+ * their compressibility depends on the detector. Shaping the test traffic
+ * the same way makes the throughput measured on the prototype topology
+ * predictive of production behaviour.
+ */
+
+#ifndef O2FLPEXPAYLOADGENERATOR_H_
+#define O2FLPEXPAYLOADGENERATOR_H_
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+class O2FLPExPayloadGenerator
+{
+  public:
+    O2FLPExPayloadGenerator()
+      : fSizeMean(0)
+      , fSizeSigma(0.5)
+      , fSkew(1.)
+      , fEntropy(1.)
+      , fMinBytes(64)
+      , fMaxBytes(64 * 1024 * 1024)
+      , fRng(std::random_device{}())
+      , fSizeDist()
+      , fUniform(0., 1.)
+    {}
+
+    /// mean message size in bytes and log-normal sigma (in log space)
+    void SetSizeDistribution(size_t meanBytes, double sigma)
+    {
+      fSizeMean = meanBytes;
+      fSizeSigma = sigma > 0. ? sigma : 0.;
+      UpdateDistribution();
+    }
+
+    /// per-FLP scale factor: the whole size distribution of this FLP is
+    /// multiplied by it, modelling detectors with different data rates
+    void SetSkew(double skew)
+    {
+      fSkew = skew > 0. ? skew : 1.;
+      UpdateDistribution();
+    }
+
+    /// fraction of incompressible content, 0 (constant payload) to 1 (random)
+    void SetEntropy(double entropy)
+    {
+      fEntropy = entropy < 0. ? 0. : (entropy > 1. ? 1. : entropy);
+    }
+
+    void SetSizeLimits(size_t minBytes, size_t maxBytes)
+    {
+      fMinBytes = minBytes > 0 ? minBytes : 1;
+      fMaxBytes = maxBytes > fMinBytes ? maxBytes : fMinBytes;
+    }
+
+    size_t GetMaxBytes() const { return fMaxBytes; }
+
+    /// reproducible runs: reseed the generator
+    void Seed(unsigned long seed) { fRng.seed(seed); }
+
+    /// next message size in bytes, log-normal around mean * skew, clamped to
+    /// the size limits
+    size_t NextSize()
+    {
+      if (fSizeMean == 0) {
+        return fMinBytes;
+      }
+      double size = fSizeDist(fRng);
+      if (size < fMinBytes) {
+        return fMinBytes;
+      }
+      if (size > fMaxBytes) {
+        return fMaxBytes;
+      }
+      return static_cast<size_t>(size);
+    }
+
+    /// fills the buffer word by word: a fraction entropy of the 64-bit words
+    /// is drawn from the generator, the rest is a constant run, so the
+    /// compression path downstream sees the requested compressibility
+    void Fill(unsigned char* buffer, size_t bytes)
+    {
+      size_t numOfWords = bytes / sizeof(unsigned long long);
+      unsigned long long* words = reinterpret_cast<unsigned long long*>(buffer);
+      for (size_t i = 0; i < numOfWords; ++i) {
+        words[i] = (fUniform(fRng) < fEntropy) ? fRng() : 0;
+      }
+      for (size_t i = numOfWords * sizeof(unsigned long long); i < bytes; ++i) {
+        buffer[i] = 0;
+      }
+    }
+
+  private:
+    void UpdateDistribution()
+    {
+      if (fSizeMean == 0) {
+        return;
+      }
+      // for a log-normal, mean = exp(mu + sigma^2 / 2)
+      double mu = std::log(static_cast<double>(fSizeMean) * fSkew) - 0.5 * fSizeSigma * fSizeSigma;
+      fSizeDist = std::lognormal_distribution<double>(mu, fSizeSigma);
+    }
+
+    size_t fSizeMean;
+    double fSizeSigma;
+    double fSkew;
+    double fEntropy;
+    size_t fMinBytes;
+    size_t fMaxBytes;
+    std::mt19937_64 fRng;
+    std::lognormal_distribution<double> fSizeDist;
+    std::uniform_real_distribution<double> fUniform;
+};
+
+#endif /* O2FLPEXPAYLOADGENERATOR_H_ */
@@ -8,7 +8,12 @@
 #ifndef O2FLPEX_H_
 #define O2FLPEX_H_
 
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
 #include "FairMQDevice.h"
+#include "flp2epn/O2FLPExPayloadGenerator.h"
 
 class O2FLPex : public FairMQDevice
 {
@@ -19,9 +24,26 @@ class O2FLPex : public FairMQDevice
 
   protected:
     int fNumContent;
+    bool fUsePool;
+    int fPoolSize;
+    int fSizeMean; // mean STF size in bytes; 0 keeps the fixed-size payload
+    O2FLPExPayloadGenerator fPayload;
 
     virtual void InitTask();
     virtual bool ConditionalRun();
+
+  private:
+    // free-list message pool: buffers come back from the transport after
+    // sending, so a pool sized to the send-queue depth keeps the device
+    // allocation-free at wire speed
+    static void FreeBuffer(void* data, void* hint);
+    unsigned char* AcquireBuffer();
+    void ReleaseBuffer(unsigned char* buffer);
+
+    std::vector<unsigned char*> fAllBuffers;
+    std::vector<unsigned char*> fFreeBuffers;
+    std::mutex fPoolMutex;
+    std::condition_variable fPoolCondition;
 };
 
 #endif
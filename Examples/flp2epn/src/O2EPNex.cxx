@@ -5,15 +5,55 @@
  * @author D. Klein, A. Rybalchenko, M.Al-Turany
  */
 
+#include <chrono>
+
 #include "FairMQLogger.h"
+#include "FairMQProgOptions.h"
 #include "flp2epn/O2EPNex.h"
 #include "O2FLPExContent.h"
 
-O2EPNex::O2EPNex()
+O2EPNex::O2EPNex() :
+  fKernel("none"),
+  fDistribution("fixed"),
+  fMeanMs(0.),
+  fSigmaMs(0.),
+  fLargeBuffer(),
+  fSmallBuffer(),
+  fRng(std::random_device{}()),
+  fSink(0.),
+  fFrames(0),
+  fBusyMs(0.)
 {
   OnData("data", &O2EPNex::Process);
 }
 
+void O2EPNex::InitTask()
+{
+  fKernel = fConfig->GetValue<std::string>("compute-kernel");
+  fDistribution = fConfig->GetValue<std::string>("compute-dist");
+  fMeanMs = fConfig->GetValue<double>("compute-mean");
+  fSigmaMs = fConfig->GetValue<double>("compute-sigma");
+
+  if (fKernel == "none" || fMeanMs <= 0.) {
+    fKernel = "none";
+    return;
+  }
+
+  if (fKernel == "membw" || fKernel == "mixed") {
+    // working set far beyond the last-level cache, every pass streams from
+    // main memory
+    int bufferMB = fConfig->GetValue<int>("compute-buffer-size");
+    fLargeBuffer.assign(bufferMB * 1024 * 1024 / sizeof(double), 1.);
+  }
+  if (fKernel == "cache" || fKernel == "mixed") {
+    // 128 KB working set, resident in L2 after the first pass
+    fSmallBuffer.assign(128 * 1024 / sizeof(double), 1.);
+  }
+
+  LOG(INFO) << "Compute kernel \"" << fKernel << "\", duration " << fDistribution
+            << ", mean " << fMeanMs << " ms, sigma " << fSigmaMs << " ms.";
+}
+
 bool O2EPNex::Process(FairMQMessagePtr& msg, int index)
 {
   // int numInput = msg->GetSize() / sizeof(O2FLPExContent);
@@ -23,9 +63,82 @@ bool O2EPNex::Process(FairMQMessagePtr& msg, int index)
   //     LOG(INFO) << (&input[i])->x << " " << (&input[i])->y << " " << (&input[i])->z << " " << (&input[i])->a << " " << (&input[i])->b;
   // }
 
+  ++fFrames;
+  if (fKernel != "none") {
+    // the device is busy here and not polling the channel, so the queues
+    // fill and backpressure builds exactly as with a real reconstruction
+    // kernel of the same duration
+    RunKernel(NextDurationMs());
+  }
+
   return true;
 }
 
+double O2EPNex::NextDurationMs()
+{
+  double duration = fMeanMs;
+  if (fDistribution == "exponential") {
+    duration = std::exponential_distribution<double>(1. / fMeanMs)(fRng);
+  } else if (fDistribution == "normal") {
+    duration = std::normal_distribution<double>(fMeanMs, fSigmaMs)(fRng);
+  }
+  return duration > 0. ? duration : 0.;
+}
+
+void O2EPNex::RunKernel(double durationMs)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + std::chrono::duration<double, std::milli>(durationMs);
+  bool large = (fKernel != "cache");
+  do {
+    if (large) {
+      SweepLarge();
+    } else {
+      SweepSmall();
+    }
+    if (fKernel == "mixed") {
+      large = !large;
+    }
+  } while (std::chrono::steady_clock::now() < deadline);
+  fBusyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void O2EPNex::SweepLarge()
+{
+  // read-modify-write over the full buffer: bound by memory bandwidth, the
+  // arithmetic per element is negligible
+  double sum = 0.;
+  for (size_t i = 0; i < fLargeBuffer.size(); ++i) {
+    sum += fLargeBuffer[i];
+    fLargeBuffer[i] += 1.;
+  }
+  fSink += sum;
+}
+
+void O2EPNex::SweepSmall()
+{
+  // many arithmetic operations per element on a resident working set:
+  // bound by the core, the memory system is idle
+  double sum = 0.;
+  for (size_t i = 0; i < fSmallBuffer.size(); ++i) {
+    double x = fSmallBuffer[i];
+    for (int j = 0; j < 16; ++j) {
+      x = x * 1.000001 + 0.000001;
+    }
+    fSmallBuffer[i] = x;
+    sum += x;
+  }
+  fSink += sum;
+}
+
+void O2EPNex::PostRun()
+{
+  if (fFrames > 0 && fKernel != "none") {
+    LOG(INFO) << "Processed " << fFrames << " time frames, kernel busy " << fBusyMs
+              << " ms (" << fBusyMs / fFrames << " ms/frame), checksum " << fSink << ".";
+  }
+}
+
 O2EPNex::~O2EPNex()
 {
 }
@@ -15,12 +15,19 @@
 #include "O2FLPExContent.h"
 
 O2FLPex::O2FLPex() :
-  fNumContent(10000)
+  fNumContent(10000),
+  fUsePool(false),
+  fPoolSize(0),
+  fSizeMean(0),
+  fPayload()
 {
 }
 
 O2FLPex::~O2FLPex()
 {
+  for (auto buffer : fAllBuffers) {
+    delete [] buffer;
+  }
 }
 
 void O2FLPex::InitTask()
@@ -28,11 +35,90 @@ void O2FLPex::InitTask()
   srand(time(NULL));
 
   fNumContent = fConfig->GetValue<int>("num-content");
-  LOG(INFO) << "Message size (num-content * sizeof(O2FLPExContent)): " << fNumContent * sizeof(O2FLPExContent) << " bytes.";
+  fUsePool = fConfig->GetValue<bool>("pool");
+  fPoolSize = fConfig->GetValue<int>("pool-size");
+  fSizeMean = fConfig->GetValue<int>("stf-size-mean");
+
+  size_t bufferSize = fNumContent * sizeof(O2FLPExContent);
+  if (fSizeMean > 0) {
+    int sizeMax = fConfig->GetValue<int>("stf-size-max");
+    const double skew = fConfig->GetValue<double>("flp-skew");
+    if (sizeMax <= 0) {
+      // generous default: the log-normal tail is clamped an order of
+      // magnitude above the (skewed) mean
+      sizeMax = 16 * fSizeMean * (skew > 1. ? skew : 1.);
+    }
+    fPayload.SetSizeLimits(sizeof(O2FLPExContent), sizeMax);
+    fPayload.SetSizeDistribution(fSizeMean, fConfig->GetValue<double>("stf-size-sigma"));
+    fPayload.SetSkew(skew);
+    fPayload.SetEntropy(fConfig->GetValue<double>("entropy"));
+    bufferSize = fPayload.GetMaxBytes();
+    LOG(INFO) << "Variable message sizes: log-normal, mean " << fSizeMean << " bytes, sigma "
+              << fConfig->GetValue<double>("stf-size-sigma") << ", skew " << skew << ", max "
+              << bufferSize << " bytes, entropy " << fConfig->GetValue<double>("entropy") << ".";
+  } else {
+    LOG(INFO) << "Message size (num-content * sizeof(O2FLPExContent)): " << fNumContent * sizeof(O2FLPExContent) << " bytes.";
+  }
+
+  if (fUsePool) {
+    // size the pool to the send-queue depth: once every queue slot holds a
+    // message, sending blocks anyway, so more buffers would only idle
+    if (fPoolSize <= 0) {
+      fPoolSize = fChannels.at("data").at(0).GetSndBufSize();
+    }
+    if (fPoolSize <= 0) {
+      fPoolSize = 1;
+    }
+
+    for (int i = 0; i < fPoolSize; ++i) {
+      unsigned char* buffer = new unsigned char[bufferSize];
+      fAllBuffers.push_back(buffer);
+      fFreeBuffers.push_back(buffer);
+    }
+
+    LOG(INFO) << "Message pool enabled with " << fPoolSize << " buffers.";
+  }
 }
 
 bool O2FLPex::ConditionalRun()
 {
+  if (fSizeMean > 0) {
+    // variable-size payload: one log-normal draw per message, content with
+    // the configured entropy
+    const size_t size = fPayload.NextSize();
+    if (fUsePool) {
+      unsigned char* buffer = AcquireBuffer();
+      fPayload.Fill(buffer, size);
+      FairMQMessagePtr msg(NewMessage(buffer, size, &O2FLPex::FreeBuffer, this));
+      fChannels.at("data").at(0).Send(msg);
+    } else {
+      FairMQMessagePtr msg(NewMessage(size));
+      fPayload.Fill(static_cast<unsigned char*>(msg->GetData()), size);
+      fChannels.at("data").at(0).Send(msg);
+    }
+    return true;
+  }
+
+  if (fUsePool) {
+    unsigned char* buffer = AcquireBuffer();
+    O2FLPExContent* content = reinterpret_cast<O2FLPExContent*>(buffer);
+
+    // generate the payload in place, no staging vector and no memcpy
+    for (int i = 0; i < fNumContent; ++i) {
+      content[i].x = rand() % 100 + 1;
+      content[i].y = rand() % 100 + 1;
+      content[i].z = rand() % 100 + 1;
+      content[i].a = (rand() % 100 + 1) / (rand() % 100 + 1);
+      content[i].b = (rand() % 100 + 1) / (rand() % 100 + 1);
+    }
+
+    FairMQMessagePtr msg(NewMessage(buffer, fNumContent * sizeof(O2FLPExContent), &O2FLPex::FreeBuffer, this));
+
+    fChannels.at("data").at(0).Send(msg);
+
+    return true;
+  }
+
   std::vector<O2FLPExContent> payload(fNumContent);
 
   for (int i = 0; i < fNumContent; ++i) {
@@ -51,3 +137,28 @@ bool O2FLPex::ConditionalRun()
 
   return true;
 }
+
+void O2FLPex::FreeBuffer(void* data, void* hint)
+{
+  static_cast<O2FLPex*>(hint)->ReleaseBuffer(static_cast<unsigned char*>(data));
+}
+
+unsigned char* O2FLPex::AcquireBuffer()
+{
+  std::unique_lock<std::mutex> lock(fPoolMutex);
+  fPoolCondition.wait(lock, [this] { return !fFreeBuffers.empty(); });
+
+  unsigned char* buffer = fFreeBuffers.back();
+  fFreeBuffers.pop_back();
+
+  return buffer;
+}
+
+void O2FLPex::ReleaseBuffer(unsigned char* buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock(fPoolMutex);
+    fFreeBuffers.push_back(buffer);
+  }
+  fPoolCondition.notify_one();
+}
@@ -5,6 +5,12 @@ namespace bpo = boost::program_options;
 
 void addCustomOptions(bpo::options_description& options)
 {
+  options.add_options()
+    ("compute-kernel", bpo::value<std::string>()->default_value("none"), "Synthetic compute kernel per time frame: none, membw (memory-bandwidth-bound), cache (cache-resident) or mixed")
+    ("compute-dist", bpo::value<std::string>()->default_value("fixed"), "Kernel duration distribution: fixed, exponential or normal")
+    ("compute-mean", bpo::value<double>()->default_value(0.), "Mean kernel duration per time frame in ms, 0 disables the kernel")
+    ("compute-sigma", bpo::value<double>()->default_value(0.), "Sigma of the duration distribution in ms (normal only)")
+    ("compute-buffer-size", bpo::value<int>()->default_value(256), "Working set of the membw kernel in MB");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
@@ -6,7 +6,14 @@ namespace bpo = boost::program_options;
 void addCustomOptions(bpo::options_description& options)
 {
   options.add_options()
-    ("num-content", bpo::value<int>()->default_value(1000), "Number of data entries in one message");
+    ("num-content", bpo::value<int>()->default_value(1000), "Number of data entries in one message")
+    ("pool", bpo::value<bool>()->default_value(false), "Recycle message buffers from a free list instead of allocating per message")
+    ("pool-size", bpo::value<int>()->default_value(0), "Number of pooled buffers, 0 sizes the pool to the send-queue depth")
+    ("stf-size-mean", bpo::value<int>()->default_value(0), "Mean message size in bytes for log-normal STF sizes, 0 keeps the fixed num-content payload")
+    ("stf-size-sigma", bpo::value<double>()->default_value(0.5), "Sigma of the log-normal size distribution (in log space)")
+    ("stf-size-max", bpo::value<int>()->default_value(0), "Clamp for the size distribution tail, 0 derives it from the mean")
+    ("flp-skew", bpo::value<double>()->default_value(1.0), "Per-FLP scale factor applied to the size distribution")
+    ("entropy", bpo::value<double>()->default_value(1.0), "Fraction of incompressible payload content, 0 to 1");
 }
 
 FairMQDevice* getDevice(const FairMQProgOptions& config)
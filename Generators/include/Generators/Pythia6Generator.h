@@ -71,6 +71,8 @@
 #include "Rtypes.h"         // for Int_t, Pythia6Generator::Class, Bool_t, etc
 class FairPrimaryGenerator;  // lines 68-68
 
+namespace AliceO2 { namespace Data { class Stack; } }
+
 
 class Pythia6Generator : public FairGenerator  
 {
@@ -99,12 +101,18 @@ class Pythia6Generator : public FairGenerator
 
   void SetVerbose (Int_t verb) { fVerbose = verb; };
 
+  /** hand whole events to the O2 stack in one bulk PushTracks call instead
+   ** of per-track FairPrimaryGenerator::AddTrack calls. Note: no beam-spot
+   ** smearing or rotation is applied on this path **/
+  void SetDirectTransfer(AliceO2::Data::Stack* stack) { fTargetStack = stack; };
+
  private:
 
   //ifstream* fInputFile;               //! Input file stream
   const Char_t * fFileName;           //! Input file Name
   FILE *fInputFile;                   //! File
   Int_t fVerbose;                     //! Verbose Level
+  AliceO2::Data::Stack* fTargetStack; //! bulk-transfer target, not owned
 
   /** Private method CloseInput. Just for convenience. Closes the 
    ** input file properly. Called from destructor and from ReadEvent. **/
@@ -26,9 +26,16 @@
 #include "TRandom.h"         // for TRandom
 #include "TRandom1.h"        // for TRandom1
 #include "TRandom3.h"        // for TRandom3, gRandom
+
+#include <string>
+#include <vector>
+
 class FairPrimaryGenerator;  // lines 22-22
 
 class FairPrimaryGenerator;
+class P8EventPrefetcher;
+
+namespace AliceO2 { namespace Data { class Stack; } }
 using namespace Pythia8;
 
 class PyTr1Rng : public RndmEngine
@@ -82,10 +89,24 @@ class Pythia8Generator : public FairGenerator
   void UseRandom3() { fUseRandom1 = kFALSE; fUseRandom3 = kTRUE; };
   void GetPythiaInstance(int);
 
+  /** pre-generate events on producer threads, each with its own Pythia
+   ** instance, so ReadEvent only pops ready events. Event n is always the
+   ** (n / workers)-th event of the worker seeded with seed + (n % workers),
+   ** so the generated sample does not depend on thread timing **/
+  void EnablePrefetch(Int_t numberOfWorkers, Int_t queueCapacity = 8);
+
+  /** hand generated events to the O2 stack in one bulk PushTracks call
+   ** instead of per-track FairPrimaryGenerator::AddTrack calls. Note: no
+   ** beam-spot smearing or rotation is applied on this path **/
+  void SetDirectTransfer(AliceO2::Data::Stack* stack) { fTargetStack = stack; };
+
  private:
 
   Pythia fPythia;             //!
   RndmEngine* fRandomEngine;  //!
+  P8EventPrefetcher* fPrefetcher; //! producer thread pool, owned
+  AliceO2::Data::Stack* fTargetStack; //! bulk-transfer target, not owned
+  std::vector<std::string> fSettings; //! parameters to replay on the workers
 
  protected:
 
@@ -94,6 +115,8 @@ class Pythia8Generator : public FairGenerator
   Int_t    fId;       // target type
   Bool_t fUseRandom1;  // flag to use TRandom1
   Bool_t fUseRandom3;  // flag to use TRandom3 (default)
+  Int_t fPrefetchWorkers;  // number of producer threads, 0 generates synchronously
+  Int_t fPrefetchCapacity; // pre-generated events buffered per worker
 
   ClassDef(Pythia8Generator,1);
 };
@@ -13,18 +13,22 @@
 // -----          Created 08/08/08  by S. Spataro                      -----
 // -------------------------------------------------------------------------
 #include "Generators/Pythia6Generator.h"
+#include "SimulationDataFormat/Stack.h"
 
 #include "FairPrimaryGenerator.h"
 
 #include <iostream>
 #include <cstdio>
+#include <vector>
 
 using std::cout;
 using std::endl;
 using std::max;
 
 // -----   Default constructor   ------------------------------------------
-Pythia6Generator::Pythia6Generator() {}
+Pythia6Generator::Pythia6Generator() {
+  fTargetStack = 0;
+}
 // ------------------------------------------------------------------------
 
 
@@ -33,6 +37,7 @@ Pythia6Generator::Pythia6Generator() {}
 Pythia6Generator::Pythia6Generator(const char* fileName) {
   fFileName  = fileName;
   fVerbose = 0;
+  fTargetStack = 0;
   cout << "-I Pythia6Generator: Opening input file " << fileName << endl;
   if ((fInputFile = fopen(fFileName,"r"))==NULL)
     //  fInputFile = new ifstream(fFileName);
@@ -82,14 +87,40 @@ Bool_t Pythia6Generator::ReadEvent(FairPrimaryGenerator* primGen) {
 
     if (fVerbose>0) cout << "Event number: " << eventID << "\tNtracks: " << ntracks << endl;
 
+    // collected for the bulk transfer path, unused otherwise
+    std::vector<AliceO2::Data::Stack::ParticleRecord> records;
+
     for (Int_t ll=0; ll<ntracks; ll++)
       {
 	ncols = fscanf(fInputFile,"%d %d %d %d %d %d %f %f %f %f %f %f %f %f %f", &nLev, &pdgID, &nM1, &nM2, &nDF, &nDL, &fPx, &fPy, &fPz, &fE, &fM, &fVx, &fVy, &fVz, &fT);
 	if (fVerbose>0) cout << nLev << "\t" << pdgID << "\t" << nM1 << "\t" << nM2 << "\t" << nDF << "\t" << nDL <<
 	  "\t" << fPx << "\t" << fPy << "\t" << fPz << "\t" << fE << "\t" << fM << "\t" << fVx << "\t" << fVy << "\t" << fVz << "\t" << fT <<  endl;
-	if (nLev==1)
-	  primGen->AddTrack(pdgID, fPx, fPy, fPz, fVx, fVy, fVz);
+	if (nLev==1) {
+	  if (fTargetStack) {
+	    AliceO2::Data::Stack::ParticleRecord record;
+	    record.pdgCode = pdgID;
+	    record.parentId = -1;
+	    record.px = fPx;
+	    record.py = fPy;
+	    record.pz = fPz;
+	    record.e  = fE;
+	    record.vx = fVx;
+	    record.vy = fVy;
+	    record.vz = fVz;
+	    record.time = fT;
+	    record.weight = 1.;
+	    record.toBeDone = kTRUE;
+	    records.push_back(record);
+	  }
+	  else
+	    primGen->AddTrack(pdgID, fPx, fPy, fPz, fVx, fVy, fVz);
+	}
       }
+
+    // hand the whole event over in one call, no per-particle virtual
+    // dispatch and no stepwise TClonesArray growth
+    if (fTargetStack && !records.empty())
+      fTargetStack->PushTracks(records.data(), (Int_t)records.size());
   }
   else {
     cout << "-I Pythia6Generator: End of input file reached " << endl;
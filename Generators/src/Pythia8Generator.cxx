@@ -17,9 +17,199 @@
 //#include "FairGenerator.h"
 
 #include "Generators/Pythia8Generator.h"
+#include "SimulationDataFormat/Stack.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 using namespace Pythia8;
 
+// a primary extracted from a generated event, ready for AddTrack
+struct P8Track
+{
+  Int_t id;
+  Double_t px, py, pz, e, x, y, z;
+  Int_t parent;
+  Bool_t wanttracking;
+};
+
+// -----   Extracting the primaries of one event   -------------------------
+// Walks a generated event with the same selection as the original ReadEvent
+// loop and fills the AddTrack candidates; returns the number of particles
+// that count towards a non-empty event (for HNL only decay products within
+// the hardcoded decay volume)
+static Int_t ExtractTracks(Event& event, Int_t hnl, std::vector<P8Track>& tracks)
+{
+  Int_t npart = 0;
+  tracks.clear();
+
+  for(int i=0; i<event.size(); i++)
+    {
+      if(event[i].isFinal())
+	{
+// only send HNL decay products to G4
+          if (hnl != 0){
+            Int_t im = event[i].mother1();
+            if (event[im].id()==hnl ){
+// for the moment, hardcode 110m is maximum decay length
+             Double_t z = event[i].zProd();
+             Double_t x = abs(event[i].xProd());
+             Double_t y = abs(event[i].yProd());
+             if ( z < 11000. && z > 7000. && x<250. && y<250.) {
+               npart++;
+             }
+           }
+          }
+	  else {npart++;}
+	};
+    };
+
+  for(Int_t ii=0; ii<event.size(); ii++){
+    if(event[ii].isFinal())
+      {
+        Bool_t wanttracking=true;
+        if (hnl != 0){
+           Int_t im = event[ii].mother1();
+           if (event[im].id() != hnl) {wanttracking=false;}
+        }
+        if (  wanttracking ) {
+          tracks.push_back(P8Track{(Int_t)event[ii].id(),
+                                   event[ii].px(), event[ii].py(), event[ii].pz(), event[ii].e(),
+                                   event[ii].xProd(), event[ii].yProd(), event[ii].zProd(),
+                                   (Int_t)event[ii].mother1(), wanttracking});
+        }
+    };
+    if (hnl != 0 && event[ii].id() == hnl){
+         Int_t im = (Int_t)event[ii].mother1();
+         Double_t z  = event[ii].zProd();
+         Double_t x  = event[ii].xProd();
+         Double_t y  = event[ii].yProd();
+         Double_t pz = event[ii].pz();
+         Double_t px = event[ii].px();
+         Double_t py = event[ii].py();
+         Double_t e  = event[ii].e();
+         tracks.push_back(P8Track{(Int_t)event[im].id(), px, py, pz, e, x, y, z, 0, false});
+         tracks.push_back(P8Track{(Int_t)event[ii].id(), px, py, pz, e, x, y, z, im, false});
+      };
+  }
+
+  return npart;
+}
+// -------------------------------------------------------------------------
+
+// -----   Producer thread pool   ------------------------------------------
+// Each worker runs its own Pythia instance with a distinct seed and fills a
+// bounded queue of converted events. ReadEvent pops the queues round robin,
+// so event n is always the (n / workers)-th event of worker (n % workers)
+// and the sample is reproducible independent of thread timing.
+class P8EventPrefetcher
+{
+ public:
+  P8EventPrefetcher(const std::vector<std::string>& settings, Int_t id, Double_t mom,
+                    Int_t hnl, UInt_t baseSeed, Int_t numberOfWorkers, Int_t queueCapacity)
+    : fHNL(hnl),
+      fCapacity(queueCapacity < 1 ? 1 : queueCapacity),
+      fNextEvent(0),
+      fRunning(kTRUE),
+      fWorkers(numberOfWorkers < 1 ? 1 : numberOfWorkers)
+  {
+    for (size_t workerNdx = 0; workerNdx < fWorkers.size(); ++workerNdx) {
+      Worker& worker = fWorkers[workerNdx];
+      worker.pythia.settings.mode("Beams:idA", id);
+      worker.pythia.settings.mode("Beams:idB", 2212);
+      worker.pythia.settings.mode("Beams:frameType", 3);
+      worker.pythia.settings.parm("Beams:pxA", 0.);
+      worker.pythia.settings.parm("Beams:pyA", 0.);
+      worker.pythia.settings.parm("Beams:pzA", mom);
+      worker.pythia.settings.parm("Beams:pxB", 0.);
+      worker.pythia.settings.parm("Beams:pyB", 0.);
+      worker.pythia.settings.parm("Beams:pzB", 0.);
+      for (const auto& setting : settings) {
+        worker.pythia.readString(setting);
+      }
+      // distinct, deterministic seed per worker (Pythia wants 1..900000000)
+      worker.pythia.readString("Random:setSeed = on");
+      worker.pythia.settings.mode("Random:seed", (baseSeed + workerNdx) % 900000000 + 1);
+      worker.pythia.init();
+    }
+
+    for (auto& worker : fWorkers) {
+      worker.thread = std::thread(&P8EventPrefetcher::WorkerLoop, this, &worker);
+    }
+  }
+
+  ~P8EventPrefetcher()
+  {
+    for (auto& worker : fWorkers) {
+      {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        fRunning = kFALSE;
+      }
+      worker.notFull.notify_one();
+    }
+    for (auto& worker : fWorkers) {
+      worker.thread.join();
+    }
+  }
+
+  void PopNextEvent(std::vector<P8Track>& tracks)
+  {
+    Worker& worker = fWorkers[fNextEvent % fWorkers.size()];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.notEmpty.wait(lock, [&worker] { return !worker.queue.empty(); });
+    tracks.swap(worker.queue.front());
+    worker.queue.pop_front();
+    lock.unlock();
+    worker.notFull.notify_one();
+    ++fNextEvent;
+  }
+
+ private:
+  struct Worker
+  {
+    Pythia pythia;
+    std::deque<std::vector<P8Track>> queue;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::thread thread;
+  };
+
+  void WorkerLoop(Worker* worker)
+  {
+    std::vector<P8Track> tracks;
+    while (kTRUE) {
+      Int_t npart = 0;
+      while (npart == 0) {
+        worker->pythia.next();
+        npart = ExtractTracks(worker->pythia.event, fHNL, tracks);
+      }
+
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      worker->notFull.wait(lock, [this, worker] {
+        return !fRunning || worker->queue.size() < (size_t)fCapacity;
+      });
+      if (!fRunning) {
+        return;
+      }
+      worker->queue.push_back(std::move(tracks));
+      lock.unlock();
+      worker->notEmpty.notify_one();
+      tracks.clear();
+    }
+  }
+
+  Int_t fHNL;
+  Int_t fCapacity;
+  ULong64_t fNextEvent;       // only touched by the event-loop thread
+  std::atomic<bool> fRunning; // cleared once, when the pool shuts down
+  std::deque<Worker> fWorkers;
+};
+// -------------------------------------------------------------------------
+
 // -----   Default constructor   -------------------------------------------
 Pythia8Generator::Pythia8Generator()
 {
@@ -28,6 +218,10 @@ Pythia8Generator::Pythia8Generator()
   fId         = 2212; // proton
   fMom        = 400;  // proton
   fHNL        = 0;    // HNL  if set to !=0, for example 9900014, only track
+  fPrefetcher = 0;
+  fTargetStack = 0;
+  fPrefetchWorkers  = 0;
+  fPrefetchCapacity = 8;
 }
 // -------------------------------------------------------------------------
 
@@ -51,6 +245,13 @@ Bool_t Pythia8Generator::Init()
   fPythia.settings.parm("Beams:pyB",    0.);
   fPythia.settings.parm("Beams:pzB",    0.);
   fPythia.init();
+
+  if (fPrefetchWorkers > 0) {
+    cout<<"Pre-generating events with "<<fPrefetchWorkers<<" worker(s), "
+        <<fPrefetchCapacity<<" event(s) buffered per worker"<<endl;
+    fPrefetcher = new P8EventPrefetcher(fSettings, fId, fMom, fHNL,
+                                        gRandom->GetSeed(), fPrefetchWorkers, fPrefetchCapacity);
+  }
   return kTRUE;
 }
 // -------------------------------------------------------------------------
@@ -59,75 +260,60 @@ Bool_t Pythia8Generator::Init()
 // -----   Destructor   ----------------------------------------------------
 Pythia8Generator::~Pythia8Generator()
 {
+  delete fPrefetcher;
 }
 // -------------------------------------------------------------------------
 
 // -----   Passing the event   ---------------------------------------------
 Bool_t Pythia8Generator::ReadEvent(FairPrimaryGenerator* cpg)
 {
-  Int_t npart = 0;
-  while(npart == 0)
-    {
-      fPythia.next();
-      for(int i=0; i<fPythia.event.size(); i++)
-	{
-	  if(fPythia.event[i].isFinal())
-	    {
-// only send HNL decay products to G4
-              if (fHNL != 0){
-                Int_t im = fPythia.event[i].mother1();
-                if (fPythia.event[im].id()==fHNL ){
-// for the moment, hardcode 110m is maximum decay length
-                 Double_t z = fPythia.event[i].zProd();
-                 Double_t x = abs(fPythia.event[i].xProd());
-                 Double_t y = abs(fPythia.event[i].yProd());
-                 // cout<<"debug HNL decay pos "<<x<<" "<< y<<" "<< z <<endl;
-                 if ( z < 11000. && z > 7000. && x<250. && y<250.) {
-                   npart++;
-                 }
-               }
-              }
-	      else {npart++;}
-	    };
-	};
+  std::vector<P8Track> tracks;
+
+  if (fPrefetcher) {
+    // transport never waits for generation, the workers keep the queues full
+    fPrefetcher->PopNextEvent(tracks);
+  }
+  else {
+    Int_t npart = 0;
+    while(npart == 0)
+      {
+        fPythia.next();
+        npart = ExtractTracks(fPythia.event, fHNL, tracks);
 // happens if a charm particle being produced which does decay without producing a HNL. Try another event.
 //       if (npart == 0){ fPythia.event.list();}
-    };
-// cout<<"debug p8 event 0 " << fPythia.event[0].id()<< " "<< fPythia.event[1].id()<< " "<< fPythia.event[2].id()<< " "<< npart <<endl;
-  for(Int_t ii=0; ii<fPythia.event.size(); ii++){
-    if(fPythia.event[ii].isFinal())
-      {
-        Bool_t wanttracking=true;
-        if (fHNL != 0){
-           Int_t im = fPythia.event[ii].mother1();
-           if (fPythia.event[im].id() != fHNL) {wanttracking=false;}
-        }
-        if (  wanttracking ) {
-          Double_t z  = fPythia.event[ii].zProd();
-          Double_t x  = fPythia.event[ii].xProd();
-          Double_t y  = fPythia.event[ii].yProd();
-          Double_t pz = fPythia.event[ii].pz();
-          Double_t px = fPythia.event[ii].px();
-          Double_t py = fPythia.event[ii].py();
-	  cpg->AddTrack((Int_t)fPythia.event[ii].id(),px,py,pz,x,y,z,
-		      (Int_t)fPythia.event[ii].mother1(),wanttracking);
-          // cout<<"debug p8->geant4 "<< wanttracking << " "<< ii <<  " " << fPythia.event[ii].id()<< " "<< fPythia.event[ii].mother1()<<" "<<x<<" "<< y<<" "<< z <<endl;
-        }
+      };
+  }
+
+  if (fTargetStack) {
+    // bulk transfer: the whole event goes to the stack in one call, no
+    // per-particle virtual dispatch and no stepwise TClonesArray growth
+    std::vector<AliceO2::Data::Stack::ParticleRecord> records;
+    records.reserve(tracks.size());
+    for (const auto& track : tracks) {
+      AliceO2::Data::Stack::ParticleRecord record;
+      record.pdgCode = track.id;
+      record.parentId = track.parent;
+      record.px = track.px;
+      record.py = track.py;
+      record.pz = track.pz;
+      record.e  = track.e;
+      record.vx = track.x;
+      record.vy = track.y;
+      record.vz = track.z;
+      record.time = 0.;
+      record.weight = 1.;
+      record.toBeDone = track.wanttracking;
+      records.push_back(record);
+    }
+    fTargetStack->PushTracks(records.data(), (Int_t)records.size());
+    return kTRUE;
+  }
+
+  for (const auto& track : tracks) {
+    cpg->AddTrack(track.id, track.px, track.py, track.pz, track.x, track.y, track.z,
+                  track.parent, track.wanttracking);
 //    virtual void AddTrack(Int_t pdgid, Double_t px, Double_t py, Double_t pz,
 //                          Double_t vx, Double_t vy, Double_t vz, Int_t parent=-1,Bool_t wanttracking=true,Double_t e=-9e9);
-    };
-    if (fHNL != 0 && fPythia.event[ii].id() == fHNL){
-         Int_t im = (Int_t)fPythia.event[ii].mother1();
-         Double_t z  = fPythia.event[ii].zProd();
-         Double_t x  = fPythia.event[ii].xProd();
-         Double_t y  = fPythia.event[ii].yProd();
-         Double_t pz = fPythia.event[ii].pz();
-         Double_t px = fPythia.event[ii].px();
-         Double_t py = fPythia.event[ii].py();
-	 cpg->AddTrack((Int_t)fPythia.event[im].id(),px,py,pz,x,y,z,0,false);
-	 cpg->AddTrack((Int_t)fPythia.event[ii].id(),px,py,pz,x,y,z, im,false);
-         //cout<<"debug p8->geant4 "<< 0 << " "<< ii <<  " " << fake<< " "<< fPythia.event[ii].mother1()<<endl;
-      };
   }
 
 // make separate container ??
@@ -137,10 +323,20 @@ Bool_t Pythia8Generator::ReadEvent(FairPrimaryGenerator* cpg)
   return kTRUE;
 }
 // -------------------------------------------------------------------------
+
+// -----   Enabling the producer thread pool   ------------------------------
+void Pythia8Generator::EnablePrefetch(Int_t numberOfWorkers, Int_t queueCapacity)
+{
+  // has to be called before Init(), the workers are started there
+  fPrefetchWorkers  = numberOfWorkers;
+  fPrefetchCapacity = queueCapacity;
+}
+// -------------------------------------------------------------------------
 void Pythia8Generator::SetParameters(char* par)
 {
   // Set Parameters
     fPythia.readString(par);
+    fSettings.push_back(par); // replayed on the prefetch workers
     cout<<"fPythia.readString(\""<<par<<"\")"<<endl;
 }
 
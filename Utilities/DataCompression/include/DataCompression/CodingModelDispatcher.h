@@ -23,6 +23,10 @@
 #include "runtime_container.h"
 #include <iostream>
 #include <fstream>
+#include <functional> // task list of the parallel tree generation
+#include <thread>
+#include <atomic>
+#include <vector>
 #include <boost/type.hpp>
 #include <boost/mpl/for_each.hpp>
 
@@ -136,10 +140,16 @@ public:
   /**
    * TODO: this is tailored to HuffmanCodec for the moment, some generic interface
    * has to come
+   *
+   * The functor collects one task per model instead of generating
+   * immediately, the tasks are then distributed to worker threads in
+   * generate(). The models are distinct objects in the runtime container,
+   * so the generation of the trees is independent per model.
    */
   class generateFctr {
   public:
-    generateFctr(container_type& container) : mContainer(container) {}
+    generateFctr(container_type& container, std::vector<std::function<int()>>& tasks)
+      : mContainer(container), mTasks(tasks) {}
     ~generateFctr() {}
 
     typedef int return_type;
@@ -147,18 +157,39 @@ public:
     template<typename T>
     return_type operator()(boost::type<T>) {
       T& stage = static_cast<T&>(mContainer);
-      return (*stage).GenerateHuffmanTree();
+      mTasks.push_back([&stage]() {return (*stage).GenerateHuffmanTree();});
+      return 0;
     }
 
   private:
     container_type& mContainer;
+    std::vector<std::function<int()>>& mTasks;
   };
 
   /**
    * TODO: maybe 'generate' is not the appropriate name
+   *
+   * The trees of the individual models are generated in parallel, one
+   * task per model dispatched to up to hardware_concurrency threads.
    */
   int generate() {
-    boost::mpl::for_each<typename container_type::types , boost::type<boost::mpl::_> >(generateFctr(mContainer));
+    std::vector<std::function<int()>> tasks;
+    boost::mpl::for_each<typename container_type::types , boost::type<boost::mpl::_> >(generateFctr(mContainer, tasks));
+    unsigned nofThreads = std::thread::hardware_concurrency();
+    if (nofThreads > tasks.size()) nofThreads = tasks.size();
+    if (nofThreads < 2) {
+      for (auto& task : tasks) task();
+      return 0;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < nofThreads; i++) {
+      workers.emplace_back([&tasks, &next]() {
+          size_t index = 0;
+          while ((index = next++) < tasks.size()) tasks[index]();
+        });
+    }
+    for (auto& worker : workers) worker.join();
     return 0;
   }
 
@@ -197,6 +228,55 @@ public:
     return result;
   }
 
+  /// Recursive helper for the compile time unrolled record encoding.
+  /// The recursion advances over the stage types of the runtime container,
+  /// every step resolves one model statically and hands the code to the
+  /// writer, the specialization for the end of the list terminates.
+  template<typename StageIterator, typename StageEnd>
+  struct encodeRecordImpl {
+    template<typename InputIterator, typename Writer>
+    static bool apply(container_type& container, InputIterator input, Writer& writer) {
+      typedef typename boost::mpl::deref<StageIterator>::type stage_type;
+      stage_type& stage = static_cast<stage_type&>(container);
+      uint16_t codeLength = 0;
+      typename stage_type::wrapped_type::code_type code = (*stage).Encode(*input, codeLength);
+      if (!writer(code, codeLength)) return false;
+      return encodeRecordImpl<typename boost::mpl::next<StageIterator>::type
+                              , StageEnd
+                              >::apply(container, ++input, writer);
+    }
+  };
+  // end of the model list terminates the recursion
+  template<typename StageEnd>
+  struct encodeRecordImpl<StageEnd, StageEnd> {
+    template<typename InputIterator, typename Writer>
+    static bool apply(container_type&, InputIterator, Writer&) {return true;}
+  };
+
+  /**
+   * Encode one record, i.e. one value per model of the definition
+   *
+   * In contrast to the cyclic per-value interface, the loop over the models
+   * is unrolled at compile time, the Encode call of every model is resolved
+   * statically and can be inlined together with its code type and bit width.
+   * The per-parameter runtime dispatch through the container does not appear
+   * in the encoding path at all.
+   *
+   * The writer is called for every code, signature
+   *   bool writer(code_type code, uint16_t codeLength)
+   * returning false aborts the record.
+   *
+   * The record interface does not touch the position of the cyclic
+   * dispatch, both interfaces can be mixed at record boundaries.
+   */
+  template<typename InputIterator, typename Writer>
+  bool encodeRecord(InputIterator input, Writer writer) {
+    return encodeRecordImpl<
+      typename boost::mpl::begin<typename container_type::types>::type
+      , typename boost::mpl::end<typename container_type::types>::type
+      >::apply(mContainer, input, writer);
+  }
+
   /// Functor to execute decoding on runtime container level
   template<typename CodeType, typename ValueType>
   class decodeFctr {
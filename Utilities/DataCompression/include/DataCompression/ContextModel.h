@@ -0,0 +1,225 @@
+//-*- Mode: C++ -*-
+
+#ifndef CONTEXTMODEL_H
+#define CONTEXTMODEL_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   ContextModel.h
+//  @author Matthias Richter
+//  @since  2016-09-20
+//  @brief  Context-conditioned probability model layer
+
+// The templates in dc_primitives.h implement order-0 models, every symbol
+// is coded with one probability table. The context layer conditions the
+// model on a configurable context: one probability table and one Huffman
+// code per context value. The context policy determines the context from
+// the symbol history (e.g. previous symbol) or from external information
+// (e.g. the padrow a cluster parameter belongs to). The ContextModel
+// template implements the same interface as the model it wraps, so it can
+// be used as model definition in the CodingModelDispatcher like a plain
+// model.
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace AliceO2 {
+
+/**
+ * @class PreviousSymbolContext
+ * @brief Context policy deriving the context from the previously coded symbol
+ *
+ * The context of the first symbol is 0, the caller has to reset the policy
+ * at block boundaries to keep encoder and decoder in sync.
+ */
+template<typename ValueT, unsigned _nofContexts>
+class PreviousSymbolContext {
+public:
+  PreviousSymbolContext() : mContext(0) {}
+  ~PreviousSymbolContext() {}
+
+  static constexpr unsigned nofContexts = _nofContexts;
+
+  /// get context for the next symbol
+  unsigned current() const {return mContext;}
+
+  /// advance the context after a symbol has been processed
+  void update(ValueT symbol) {mContext = unsigned(symbol) % _nofContexts;}
+
+  /// reset to the initial context, to be called at block boundaries
+  void reset() {mContext = 0;}
+
+private:
+  unsigned mContext;
+};
+
+/**
+ * @class ExternalContext
+ * @brief Context policy for a context set by the caller
+ *
+ * The context does not depend on the coded symbols but on external
+ * information like the padrow number, the caller sets it via set() before
+ * coding the corresponding symbols.
+ */
+template<unsigned _nofContexts>
+class ExternalContext {
+public:
+  ExternalContext() : mContext(0) {}
+  ~ExternalContext() {}
+
+  static constexpr unsigned nofContexts = _nofContexts;
+
+  /// get context for the next symbol
+  unsigned current() const {return mContext;}
+
+  /// the context changes only via set
+  template<typename ValueT>
+  void update(ValueT /*symbol*/) {}
+
+  /// set the context from external information
+  void set(unsigned context) {mContext = context % _nofContexts;}
+
+  /// reset to the initial context
+  void reset() {mContext = 0;}
+
+private:
+  unsigned mContext;
+};
+
+/**
+ * @class ContextModel
+ * @brief Probability model conditioned on a context
+ *
+ * The class wraps one model instance (e.g. a HuffmanModel specialization)
+ * per context value of the policy and routes training, encoding and
+ * decoding to the instance selected by the policy. It implements the
+ * interface expected by the CodingModelDispatcher, so conditioning a
+ * parameter is a matter of wrapping its model definition into ContextModel
+ * in the model sequence.
+ *
+ * Encoder and decoder derive the context from the same information, the
+ * symbol sequence itself or external data available on both sides, so no
+ * additional information needs to be stored. The configuration write/read
+ * stores the tables of all contexts in sequence.
+ */
+template<typename ModelT, typename ContextPolicyT>
+class ContextModel {
+public:
+  ContextModel() : mModels(ContextPolicyT::nofContexts), mContext() {}
+  ~ContextModel() {}
+
+  typedef ContextModel<ModelT, ContextPolicyT> self_type;
+  // the dispatcher accesses addWeight through the base_type cast, route
+  // it through the context selection by defining the class itself as base
+  typedef self_type base_type;
+  typedef ModelT model_type;
+  typedef ContextPolicyT context_policy_type;
+  typedef typename ModelT::value_type value_type;
+  typedef typename ModelT::code_type code_type;
+  typedef typename ModelT::base_type::weight_type weight_type;
+  static constexpr bool orderMSB = ModelT::orderMSB;
+  static constexpr unsigned nofContexts = ContextPolicyT::nofContexts;
+
+  constexpr const char* getName() const {return mModels[0].getName();}
+
+  /// access the context policy, e.g. to set an external context
+  ContextPolicyT& getContextPolicy() {return mContext;}
+
+  /// reset the context to the initial value, to be called at block
+  /// boundaries on both the encoding and the decoding side
+  void resetContext() {mContext.reset();}
+
+  /// init all context models
+  int init(double v = 1.) {
+    int result = 0;
+    for (auto& model : mModels) {
+      int iResult = model.init(v);
+      if (iResult < 0 && result == 0) result = iResult;
+    }
+    mContext.reset();
+    return result;
+  }
+
+  /// add weight to the model of the current context
+  int addWeight(value_type v, weight_type w = 1.) {
+    int result = mModels[mContext.current()].addWeight(v, w);
+    mContext.update(v);
+    return result;
+  }
+
+  /// encode symbol with the Huffman table of the current context
+  code_type Encode(value_type v, uint16_t& codeLength) {
+    code_type code = mModels[mContext.current()].Encode(v, codeLength);
+    mContext.update(v);
+    return code;
+  }
+
+  /// decode bit pattern with the Huffman table of the current context
+  value_type Decode(code_type code, uint16_t& codeLength) {
+    value_type v = mModels[mContext.current()].Decode(code, codeLength);
+    mContext.update(v);
+    return v;
+  }
+
+  /// generate the Huffman trees of all context models
+  bool GenerateHuffmanTree() {
+    bool result = true;
+    for (auto& model : mModels) {
+      if (!model.GenerateHuffmanTree()) result = false;
+    }
+    return result;
+  }
+
+  /// generate the decoding tables of all context models
+  bool GenerateDecodingTable(uint16_t nBits = 10) {
+    bool result = true;
+    for (auto& model : mModels) {
+      if (!model.GenerateDecodingTable(nBits)) result = false;
+    }
+    return result;
+  }
+
+  /// write the tables of all contexts in sequence, separated by blank
+  /// lines as expected by the read method of the wrapped model
+  int write(std::ostream& out) {
+    for (unsigned context = 0; context < nofContexts; context++) {
+      if (context > 0) out << std::endl;
+      mModels[context].write(out);
+    }
+    return 0;
+  }
+
+  /// read the tables of all contexts in sequence
+  int read(std::istream& in) {
+    for (unsigned context = 0; context < nofContexts; context++) {
+      if (mModels[context].read(in) < 0) return -1;
+    }
+    return 0;
+  }
+
+  void print() const {
+    for (auto& model : mModels) {
+      model.print();
+    }
+  }
+
+private:
+  // one wrapped model per context value
+  std::vector<ModelT> mModels;
+  // the policy tracking the current context
+  ContextPolicyT mContext;
+};
+
+}; // namespace AliceO2
+
+#endif
@@ -40,9 +40,12 @@ template<
   >
 class DataDeflater {
  public:
-  DataDeflater() : mBegin(nullptr), mEnd(nullptr), mCurrent(mEnd), mBitPosition(0), mCodec() {}
+  DataDeflater() : mBegin(nullptr), mEnd(nullptr), mCurrent(mEnd), mRegister(0), mRegisterBits(0), mCodec() {}
   ~DataDeflater() {}
 
+  /// number of bits of one target buffer element
+  static const uint16_t TargetBitWidth = 8*sizeof(_TargetType);
+
   /**
    * Init target
    * TODO: think about other targets than a buffer
@@ -52,7 +55,9 @@ class DataDeflater {
     mBegin = buffer;
     mEnd = mBegin + size;
     mCurrent = mBegin;
-    mBitPosition = 0;
+    mRegister = 0;
+    mRegisterBits = 0;
+    return size;
   }
 
   /**
@@ -61,12 +66,18 @@ class DataDeflater {
    * @return Number of written elements
    */
   int Close() {
-    if (mBitPosition > 0) mCurrent++;
+    if (mRegisterBits > 0) {
+      // after every write the register holds less than one target element,
+      // flush it padded with zero bits
+      if (mCurrent == mEnd) return -ENOSPC;
+      *mCurrent++ = _TargetType(mRegister >> (64 - TargetBitWidth));
+    }
     int nElements = mCurrent - mBegin;
     mBegin = nullptr;
     mEnd = mBegin;
     mCurrent = mEnd;
-    mBitPosition = 0;
+    mRegister = 0;
+    mRegisterBits = 0;
     return nElements;
   }
 
@@ -74,6 +85,12 @@ class DataDeflater {
    * Write number of bits
    * value contains number of valid LSBs given by bitlength
    *
+   * Bits are accumulated in a 64 bit register, the first written bit in the
+   * highest position, and complete target elements are spilled to the buffer
+   * in one store each. Per-bit shifting into the target elements is avoided
+   * entirely, the cost per code is a shift-or into the register plus one
+   * store per filled element.
+   *
    * TODO: that function might be renamed to simply 'Write' in conjunction
    * with a mixin approach. Every deflater mixin instance has only one
    * 'Write' function and does internally the necessary conversions to
@@ -87,27 +104,25 @@ class DataDeflater {
       bitlength = 8*sizeof(ValueType);
     }
     while (bitsWritten < bitlength) {
-      if (mCurrent == mEnd) {
-        //break; // depending on error policy
-        return -ENOSPC;
-      }
-      _TargetType& current = *mCurrent;
-      // write at max what is left to be written
+      // append at max what is left in the register
       uint16_t writeNow = bitlength - bitsWritten;
-      ValueType mask = 1<<(writeNow); mask -= 1;
-      // write one element of the target buffer at a time
-      if (writeNow > 8*sizeof(_TargetType)) writeNow = 8*sizeof(_TargetType);
-      // write the remaining space in the current element
-      uint16_t capacity=8*sizeof(_TargetType)-mBitPosition;
-      if (writeNow > capacity) writeNow = capacity;
-      ValueType activebits=(value&mask)>>(bitlength-bitsWritten-writeNow);
-      activebits<<(capacity-writeNow);
-      mBitPosition+=writeNow;
-      bitsWritten+=writeNow;
-      if (mBitPosition==8*sizeof(_TargetType)) {
-        mBitPosition=0;
-        mCurrent++;
-      } // pedantic check: should never exceed the taget type size
+      uint16_t room = 64 - mRegisterBits;
+      if (writeNow > room) writeNow = room;
+      uint64_t activebits = uint64_t(value) >> (bitlength - bitsWritten - writeNow);
+      if (writeNow < 64) activebits &= (uint64_t(1) << writeNow) - 1;
+      mRegister |= activebits << (64 - mRegisterBits - writeNow);
+      mRegisterBits += writeNow;
+      bitsWritten += writeNow;
+      // spill complete target elements
+      while (mRegisterBits >= TargetBitWidth) {
+        if (mCurrent == mEnd) {
+          //break; // depending on error policy
+          return -ENOSPC;
+        }
+        *mCurrent++ = _TargetType(mRegister >> (64 - TargetBitWidth));
+        mRegister <<= TargetBitWidth;
+        mRegisterBits -= TargetBitWidth;
+      }
     }
     return bitsWritten;
   }
@@ -123,15 +138,66 @@ class DataDeflater {
                          );
   }
 
+  /**
+   * Bulk write of a sequence of values
+   *
+   * Every value is encoded through the dispatcher, cycling over the models
+   * of the multi-parameter definition as in the per-value interface, and the
+   * codes are packed through the register. The encode-pack loop stays in the
+   * cache without per-value call overhead to the outside.
+   *
+   * @return number of values written, neg. error code on failure
+   */
+  template <typename InputIterator, typename DispatcherType>
+  int WriteArray(InputIterator begin, InputIterator end, DispatcherType& dispatcher) {
+    typedef typename DispatcherType::code_type dispatcher_code_type;
+    int count = 0;
+    for (InputIterator it = begin; it != end; ++it, ++count) {
+      dispatcher_code_type code;
+      uint16_t codeLength = 0;
+      dispatcher.encode(*it, code, codeLength);
+      int result = WriteRaw(code.to_ullong(), codeLength);
+      if (result < 0) return result;
+    }
+    return count;
+  }
+
+  /**
+   * Write one record of a multi-parameter model, one value per model
+   *
+   * The codec calls are unrolled at compile time by the dispatcher, see
+   * CodingModelDispatcher::encodeRecord, the codes are packed through the
+   * register as in WriteArray.
+   *
+   * @return number of values written, neg. error code on failure
+   */
+  template <typename InputIterator, typename DispatcherType>
+  int WriteRecord(InputIterator begin, DispatcherType& dispatcher) {
+    typedef typename DispatcherType::code_type dispatcher_code_type;
+    int result = 0;
+    dispatcher.encodeRecord(begin, [this, &result] (dispatcher_code_type code, uint16_t codeLength) -> bool {
+        int written = this->WriteRaw(code.to_ullong(), codeLength);
+        if (written < 0) {
+          result = written;
+          return false;
+        }
+        ++result;
+        return true;
+      });
+    return result;
+  }
+
   /**
    * Align bit output
    * @return number of forward bits
    */
   int Align() {
-    if (mBitPosition == 0 || mCurrent == mEnd) return 0;
-    int nforward = sizeof(_TargetType) - mBitPosition;
-    mBitPosition = 0;
-    mCurrent++;
+    if (mRegisterBits == 0) return 0;
+    if (mCurrent == mEnd) return -ENOSPC;
+    int nforward = TargetBitWidth - mRegisterBits;
+    *mCurrent++ = _TargetType(mRegister >> (64 - TargetBitWidth));
+    mRegister = 0;
+    mRegisterBits = 0;
     return nforward;
   }
 
@@ -140,7 +206,7 @@ class DataDeflater {
     int filledSize = mCurrent - mBegin;
     std::cout << "DataDeflater: " << bufferSize << " elements of bit width " << 8*sizeof(_TargetType) << std::endl;
     if (bufferSize > 0)
-      std::cout << "    position: " << filledSize << " (bit " << mBitPosition << ")" << std::endl;
+      std::cout << "    position: " << filledSize << " (bit " << mRegisterBits << ")" << std::endl;
   }
 
  private:
@@ -150,8 +216,11 @@ class DataDeflater {
   _TargetType* mEnd;
   /// current target position
   _TargetType* mCurrent;
-  /// current bit position
-  int           mBitPosition;
+  /// 64 bit accumulator, first written bit in the highest position
+  uint64_t      mRegister;
+  /// number of valid bits in the accumulator, less than the target bit
+  /// width outside of WriteRaw
+  int           mRegisterBits;
   /// codec instance
   Codec         mCodec;
 
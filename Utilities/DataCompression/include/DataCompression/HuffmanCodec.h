@@ -21,6 +21,9 @@
 
 #include <cstdint>
 #include <cerrno>
+#include <cstring> // memcmp in canonical format header check
+#include <algorithm> // sort, stable_partition
+#include <utility> // pair
 #include <set>
 #include <map>
 #include <vector>
@@ -177,6 +180,9 @@ public:
   typedef typename _NodeType::CodeType code_type;
   static constexpr bool orderMSB = _orderMSB;
 
+  /// version of the canonical binary model format, see writeCanonical
+  static constexpr uint8_t CANONICAL_VERSION = 1;
+
   int init(double v = 1.) {return _BASE::initWeight(mAlphabet, v);}
 
   /**
@@ -225,6 +231,29 @@ public:
     // from their parents in the tree.
     const _NodeType* node = (*mTreeNodes.begin()).get();
     uint16_t codeMSB = code.size() - 1;
+    if (!mDecodingTable.empty()) {
+      // table-driven fast path: the first table-bits of the code select an
+      // entry which either holds the decoded symbol directly (short codes)
+      // or the subtree node where the bit-by-bit walk continues (long codes)
+      size_t index = 0;
+      if (orderMSB) {// note: this is a compile time switch
+        index = ((code >> (code.size() - mDecodingTableBits)).to_ulong());
+      } else {
+        for (uint16_t bit = 0; bit < mDecodingTableBits; ++bit) {
+          index <<= 1;
+          if (code.test(bit)) index |= 1;
+        }
+      }
+      const DecodingTableEntry& entry = mDecodingTable[index];
+      if (entry.codeLength > 0) {
+        codeLength = entry.codeLength;
+        return _BASE::alphabet_type::getSymbol(entry.index);
+      }
+      // code is longer than the table, continue in the tree below the
+      // already consumed prefix
+      node = entry.node;
+      codeLength = mDecodingTableBits;
+    }
     while (node) {
       // N.B.: nodes have either both child nodes or none of them
       if (node->getLeftChild() == nullptr) {
@@ -281,38 +310,86 @@ public:
 
   /**
    * Combine and sort nodes to build a binary tree
-   * TODO: separate data structures for tree and leaf nodes to optimize
-   * storage
+   *
+   * Two-queue construction: the leave nodes are sorted once by ascending
+   * weight, combined nodes are appended to a second queue. Since combined
+   * nodes are created with non-decreasing weight, the node with the lowest
+   * weight is always at the head of one of the two queues and each of the
+   * n-1 combinations is O(1). For the large alphabets this replaces the
+   * per-node insert/erase in an ordered set. The combined nodes live in one
+   * pooled allocation, the tree references them via aliasing shared
+   * pointers owning the pool.
    */
   bool GenerateHuffmanTree() {
     mLeaveNodes.clear();
+    mTreeNodes.clear();
+    if (!buildTree(mLeaveNodes, mTreeNodes)) return false;
+    // a previously generated decoding table refers to the old tree
+    mDecodingTable.clear();
+    return true;
+  }
 
-    // probability model provides map of {symbol, weight}-pairs
-    _BASE& model = *this;
-    for ( auto i : model) {
-      // create nodes knowing about their index and the symbol weight
-      mLeaveNodes.push_back(std::make_shared<_NodeType>(i.second, _BASE::alphabet_type::getIndex(i.first)));
+  /**
+   * @brief Incorporate statistics accumulated via count() into the codes
+   *
+   * The pending update counters of the probability model are merged, the
+   * present weights scaled by the aging factor, and a new tree is built
+   * into shadow storage while the active tree stays in place; the final
+   * swap is O(1), so encoding is never blocked by the rebuild. When no
+   * code length changes the swap is skipped entirely and the codes and
+   * the decoding table stay stable across small statistics updates.
+   *
+   * @return number of symbols with changed code length, neg. error code
+   */
+  int UpdateHuffmanTree(double agingFactor = 1.) {
+    if (!(_BASE::getUpdateWeight() > 0)) return 0;
+    _BASE::mergeUpdates(agingFactor);
+    std::vector<std::shared_ptr<_NodeType>> shadowLeaves;
+    std::multiset<std::shared_ptr<_NodeType>, isless<std::shared_ptr<_NodeType>>> shadowTree;
+    if (!buildTree(shadowLeaves, shadowTree)) return -1;
+    int changed = 0;
+    if (shadowLeaves.size() != mLeaveNodes.size()) {
+      changed = shadowLeaves.size();
+    } else {
+      for (unsigned index = 0; index < shadowLeaves.size(); index++) {
+        uint16_t currentLen = mLeaveNodes[index]? mLeaveNodes[index]->getBinaryCodeLength() : 0;
+        uint16_t shadowLen = shadowLeaves[index]? shadowLeaves[index]->getBinaryCodeLength() : 0;
+        if (currentLen != shadowLen) ++changed;
+      }
     }
+    if (changed == 0 && mLeaveNodes.size() > 0) return 0;
+    mLeaveNodes.swap(shadowLeaves);
+    mTreeNodes.swap(shadowTree);
+    // the decoding table refers to the replaced tree, refresh it if the
+    // table-driven fast path was in use
+    uint16_t tableBits = mDecodingTableBits;
+    mDecodingTable.clear();
+    if (tableBits > 0) GenerateDecodingTable(tableBits);
+    return changed;
+  }
 
-    // insert pointer to nodes into ordered structure to build tree
-    // since the type is a pointer, a specific 'less' functor needs to
-    // be provided to dereference before applying operator<
-    for ( auto &i : mLeaveNodes) {
-      mTreeNodes.insert(i);
-    }
-    while (mTreeNodes.size() > 1) {
-      // create new node combining the two with lowest probability
-      std::shared_ptr<_NodeType> combinedNode = std::make_shared<_NodeType>(*mTreeNodes.begin(), *++mTreeNodes.begin());
-      // remove those two nodes from the list
-      mTreeNodes.erase(mTreeNodes.begin());
-      mTreeNodes.erase(mTreeNodes.begin());
-      // insert the new node according to the less functor
-      mTreeNodes.insert(combinedNode);
-    }
-    //assign value, method works on pointer
-    // dereference iterator and shared_ptr to get the raw pointer
-    // TODO: change method to work on shared instead of raw pointers
-    assignCode((*mTreeNodes.begin()).get());
+  /**
+   * @brief Build the prefix lookup table for table-driven decoding
+   *
+   * The table has one entry per combination of the first nBits code bits.
+   * Symbols with a code of up to nBits are decoded with a single table
+   * access, for longer codes the entry points to the tree node below the
+   * consumed prefix, where the bit-by-bit walk continues. nBits is clamped
+   * to the longest code in the tree; for the typically steep probability
+   * distributions a small table covers all frequent symbols.
+   *
+   * To be called after GenerateHuffmanTree or read.
+   */
+  bool GenerateDecodingTable(uint16_t nBits = 10) {
+    mDecodingTable.clear();
+    if (mTreeNodes.size() == 0) return false;
+    const _NodeType* topNode = (*mTreeNodes.begin()).get();
+    uint16_t maxCodeLength = maxCodeLengthBelow(topNode, 0);
+    if (nBits > maxCodeLength) nBits = maxCodeLength;
+    if (nBits == 0) return false;
+    mDecodingTableBits = nBits;
+    mDecodingTable.resize(size_t(1) << nBits);
+    fillDecodingTable(topNode, 0, 0);
     return true;
   }
 
@@ -383,6 +460,7 @@ public:
   int read(std::istream& in) {
     mLeaveNodes.clear();
     mTreeNodes.clear();
+    mDecodingTable.clear();
     int lineNo = -1;
     std::string node, left, right, parameters;
     std::set<int> nodeIndices;
@@ -492,7 +570,175 @@ public:
     }
   };
 
+  /**
+   * @brief Write the model in the compact canonical binary format
+   *
+   * Only the code length per symbol index is stored, a few bytes per symbol;
+   * the canonical codes are rebuilt deterministically by readCanonical. The
+   * format starts with a versioned header (magic 'O2HC', format version,
+   * code order flag, number of symbols), multi-byte fields are written
+   * little-endian. Symbol weights are not part of the format, they do not
+   * influence coding once the code lengths are fixed.
+   *
+   * @return number of symbols written, neg. error code on failure
+   */
+  int writeCanonical(std::ostream& out) const {
+    if (mLeaveNodes.size() == 0) return 0;
+    static const char magic[4] = {'O', '2', 'H', 'C'};
+    out.write(magic, 4);
+    out.put(char(CANONICAL_VERSION));
+    out.put(char(orderMSB? 1 : 0));
+    uint16_t nSymbols = mLeaveNodes.size();
+    out.put(char(nSymbols & 0xff));
+    out.put(char((nSymbols >> 8) & 0xff));
+    int count = 0;
+    for (auto& node : mLeaveNodes) {
+      uint16_t codeLen = node? node->getBinaryCodeLength() : 0;
+      if (codeLen > 0xff) {
+        std::cerr << "error: code length " << codeLen << " exceeds canonical format range" << std::endl;
+        return -1;
+      }
+      out.put(char(codeLen));
+      if (codeLen > 0) ++count;
+    }
+    return (out.good())? count : -1;
+  }
+
+  /**
+   * @brief Read a model written by writeCanonical
+   *
+   * The canonical codes are assigned deterministically from the code
+   * lengths (symbols ordered by ascending length, index within one length)
+   * and the decoding tree is rebuilt from them, so every process loading
+   * the same table arrives at the identical codec without parsing text.
+   *
+   * @return number of symbols read, neg. error code on failure
+   */
+  int readCanonical(std::istream& in) {
+    mLeaveNodes.clear();
+    mTreeNodes.clear();
+    mDecodingTable.clear();
+    static const char magic[4] = {'O', '2', 'H', 'C'};
+    char buffer[4] = {0};
+    in.read(buffer, 4);
+    if (!in.good() || std::memcmp(buffer, magic, 4) != 0) {
+      std::cerr << "format error: missing canonical model magic" << std::endl;
+      return -1;
+    }
+    int version = in.get();
+    if (version != CANONICAL_VERSION) {
+      std::cerr << "format error: unsupported canonical model version " << version << std::endl;
+      return -1;
+    }
+    int msb = in.get();
+    if ((msb != 0) != orderMSB) {
+      std::cerr << "format error: code order of the stored model does not match" << std::endl;
+      return -1;
+    }
+    uint16_t nSymbols = in.get();
+    nSymbols |= uint16_t(in.get()) << 8;
+
+    // symbols ordered by ascending (code length, index) define the
+    // canonical code assignment
+    std::vector<std::pair<uint16_t, uint16_t>> lengths; // (length, index)
+    for (uint16_t index = 0; index < nSymbols; ++index) {
+      int codeLen = in.get();
+      if (codeLen < 0) {
+        std::cerr << "format error: truncated code length table" << std::endl;
+        return -1;
+      }
+      if (codeLen > 0) lengths.push_back(std::make_pair(uint16_t(codeLen), index));
+    }
+    std::sort(lengths.begin(), lengths.end());
+
+    mLeaveNodes.resize(nSymbols);
+    std::vector<std::pair<uint64_t, std::shared_ptr<_NodeType>>> coded;
+    uint64_t code = 0;
+    uint16_t prevLen = 0;
+    for (auto& entry : lengths) {
+      code <<= (entry.first - prevLen);
+      prevLen = entry.first;
+      if (prevLen < 64 && (code >> prevLen) != 0) {
+        std::cerr << "format error: code lengths do not form a Huffman code" << std::endl;
+        return -1;
+      }
+      // the canonical code reads MSB first; for LSB order the stored code
+      // has the first bit at position 0, i.e. the bits reversed
+      uint64_t stored = code;
+      if (!orderMSB) {// note: this is a compile time switch
+        stored = 0;
+        for (uint16_t b = 0; b < prevLen; ++b) {
+          stored = (stored << 1) | ((code >> b) & 1);
+        }
+      }
+      mLeaveNodes[entry.second] = std::make_shared<_NodeType>(0., entry.second);
+      mLeaveNodes[entry.second]->setBinaryCode(prevLen, code_type(stored));
+      coded.push_back(std::make_pair(code, mLeaveNodes[entry.second]));
+      ++code;
+    }
+
+    // rebuild the decoding tree from the canonical codes
+    if (coded.size() == 0) return 0;
+    mTreeNodes.insert(buildTreeFromCodes(coded.begin(), coded.end(), 0));
+    return coded.size();
+  }
+
 private:
+  /**
+   * @brief Build leave nodes and tree from the current model statistics
+   *
+   * Works on the provided storage so the caller decides whether to build
+   * in place (GenerateHuffmanTree) or into shadow storage for a later
+   * swap (UpdateHuffmanTree). Code assignment is included.
+   */
+  bool buildTree(std::vector<std::shared_ptr<_NodeType>>& leaveNodes,
+                 std::multiset<std::shared_ptr<_NodeType>, isless<std::shared_ptr<_NodeType>>>& treeNodes) {
+    // probability model provides map of {symbol, weight}-pairs
+    _BASE& model = *this;
+    for ( auto i : model) {
+      // create nodes knowing about their index and the symbol weight
+      leaveNodes.push_back(std::make_shared<_NodeType>(i.second, _BASE::alphabet_type::getIndex(i.first)));
+    }
+    if (leaveNodes.size() == 0) return false;
+
+    // first queue: leave nodes sorted by ascending weight; since the type
+    // is a pointer, a specific 'less' functor needs to be provided to
+    // dereference before applying operator<
+    std::vector<std::shared_ptr<_NodeType>> sortedLeaves(leaveNodes);
+    std::sort(sortedLeaves.begin(), sortedLeaves.end(), isless<std::shared_ptr<_NodeType>>());
+    // second queue: combined nodes in one pooled allocation; the capacity
+    // must cover all n-1 combined nodes up front, a reallocation would
+    // invalidate the aliasing pointers into the pool
+    auto pool = std::make_shared<std::vector<_NodeType>>();
+    pool->reserve(sortedLeaves.size());
+    std::vector<std::shared_ptr<_NodeType>> combined;
+    combined.reserve(sortedLeaves.size());
+    size_t leaveHead = 0;
+    size_t combinedHead = 0;
+    auto takeLowest = [&sortedLeaves, &combined, &leaveHead, &combinedHead]() {
+      if (combinedHead >= combined.size() ||
+          (leaveHead < sortedLeaves.size() && *sortedLeaves[leaveHead] < *combined[combinedHead])) {
+        return sortedLeaves[leaveHead++];
+      }
+      return combined[combinedHead++];
+    };
+    size_t nofNodes = sortedLeaves.size();
+    while (nofNodes > 1) {
+      // create new node combining the two with lowest probability
+      std::shared_ptr<_NodeType> left = takeLowest();
+      std::shared_ptr<_NodeType> right = takeLowest();
+      pool->push_back(_NodeType(left, right));
+      combined.push_back(std::shared_ptr<_NodeType>(pool, &pool->back()));
+      --nofNodes;
+    }
+    treeNodes.insert(takeLowest());
+    //assign value, method works on pointer
+    // dereference iterator and shared_ptr to get the raw pointer
+    // TODO: change method to work on shared instead of raw pointers
+    assignCode((*treeNodes.begin()).get());
+    return true;
+  }
+
   /**
    * @brief Recursive write of the node content.
    *
@@ -517,12 +763,89 @@ private:
     return rightIndex + 1;
   }
 
+  /**
+   * Entry of the prefix lookup table: either a decoded symbol (codeLength > 0)
+   * or the tree node to continue the walk from (codeLength == 0)
+   */
+  struct DecodingTableEntry {
+    DecodingTableEntry() : node(nullptr), index(0), codeLength(0) {}
+    const _NodeType* node;
+    uint16_t index;
+    uint16_t codeLength;
+  };
+
+  /**
+   * @brief Recursive rebuild of the decoding tree from canonical codes
+   *
+   * All entries in the range share the first depth bits of their canonical
+   * code (MSB first). The range is partitioned by the next bit ('1' is the
+   * left branch as in assignCode) until a single symbol whose code is fully
+   * consumed remains.
+   */
+  typedef std::vector<std::pair<uint64_t, std::shared_ptr<_NodeType>>> coded_nodes_type;
+  std::shared_ptr<_NodeType> buildTreeFromCodes(typename coded_nodes_type::iterator begin,
+                                                typename coded_nodes_type::iterator end,
+                                                uint16_t depth) const {
+    if (begin == end) return nullptr;
+    if (end - begin == 1 && begin->second->getBinaryCodeLength() == depth) {
+      return begin->second;
+    }
+    auto mid = std::stable_partition(begin, end,
+                                     [depth](const typename coded_nodes_type::value_type& entry) {
+                                       uint16_t codeLen = entry.second->getBinaryCodeLength();
+                                       return ((entry.first >> (codeLen - 1 - depth)) & 1) != 0;
+                                     });
+    return std::make_shared<_NodeType>(buildTreeFromCodes(begin, mid, depth + 1),
+                                       buildTreeFromCodes(mid, end, depth + 1));
+  }
+
+  /// longest code length in the subtree below node
+  uint16_t maxCodeLengthBelow(const _NodeType* node, uint16_t depth) const {
+    if (node == nullptr) return depth;
+    if (node->getLeftChild() == nullptr) return depth;
+    uint16_t left = maxCodeLengthBelow(node->getLeftChild(), depth + 1);
+    uint16_t right = maxCodeLengthBelow(node->getRightChild(), depth + 1);
+    return (left > right)? left : right;
+  }
+
+  /**
+   * Recursive fill of the prefix lookup table
+   *
+   * prefix holds the code bits consumed so far, first bit in the highest
+   * position. A leave reached at depth <= table bits covers all entries
+   * sharing its prefix; a node still unresolved at table depth is stored
+   * for the tree fallback.
+   */
+  void fillDecodingTable(const _NodeType* node, size_t prefix, uint16_t depth) {
+    if (node == nullptr) return;
+    if (node->getLeftChild() == nullptr) {
+      // leave node: all indices starting with this prefix decode to the symbol
+      size_t nEntries = size_t(1) << (mDecodingTableBits - depth);
+      size_t firstEntry = prefix << (mDecodingTableBits - depth);
+      for (size_t i = 0; i < nEntries; ++i) {
+        mDecodingTable[firstEntry + i].index = node->getIndex();
+        mDecodingTable[firstEntry + i].codeLength = depth;
+      }
+      return;
+    }
+    if (depth == mDecodingTableBits) {
+      mDecodingTable[prefix].node = node;
+      return;
+    }
+    fillDecodingTable(node->getLeftChild(), (prefix << 1) | 1, depth + 1); // bit '1' branch
+    fillDecodingTable(node->getRightChild(), (prefix << 1), depth + 1);   // bit '0' branch
+  }
+
   // the alphabet, determined by template parameter
   typename _BASE::alphabet_type mAlphabet;
   // Huffman leave nodes containing symbol index to code mapping
   std::vector<std::shared_ptr<_NodeType>> mLeaveNodes;
   // multiset, order determined by less functor working on pointers
   std::multiset<std::shared_ptr<_NodeType>, isless<std::shared_ptr<_NodeType>>> mTreeNodes;
+  // prefix lookup table for table-driven decoding, empty when not generated
+  std::vector<DecodingTableEntry> mDecodingTable;
+  // number of code bits covered by the decoding table
+  uint16_t mDecodingTableBits = 0;
 };
 
 }; // namespace AliceO2
@@ -0,0 +1,233 @@
+//-*- Mode: C++ -*-
+
+#ifndef PARALLELBLOCKCODEC_H
+#define PARALLELBLOCKCODEC_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   ParallelBlockCodec.h
+//  @author Matthias Richter
+//  @since  2016-09-15
+//  @brief  Block-parallel compression engine over the coding model dispatcher
+
+#include "DataDeflater.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ALICE {
+namespace O2 {
+
+/**
+ * @class ParallelBlockCodec
+ * @brief Block-parallel compression and decompression
+ *
+ * The input is split by the caller into independent blocks, e.g. the
+ * clusters of one TPC padrow. Blocks are encoded concurrently on a pool of
+ * threads, every worker operating on a copy of the model dispatcher so the
+ * cyclic multi-parameter dispatch restarts at the first model for each
+ * block. The per-block bit streams are concatenated into one target buffer
+ * and a descriptor per block records offset, size and number of values, so
+ * decompression of the blocks is again embarrassingly parallel (and single
+ * blocks can be decoded without touching the rest).
+ *
+ * The worker pool follows the pattern of a shared atomic block counter,
+ * avoiding any further synchronization between the threads.
+ */
+template<
+  typename DispatcherType,
+  typename _TargetType = uint8_t
+  >
+class ParallelBlockCodec {
+public:
+  ParallelBlockCodec(const DispatcherType& dispatcher) : mDispatcher(dispatcher) {}
+  ~ParallelBlockCodec() {}
+
+  typedef typename DispatcherType::code_type code_type;
+  typedef _TargetType target_type;
+
+  /// number of bits of one target buffer element
+  static const uint16_t TargetBitWidth = 8*sizeof(_TargetType);
+
+  /**
+   * Descriptor of one compressed block in the target buffer
+   */
+  struct BlockDescriptor {
+    BlockDescriptor() : offset(0), size(0), nValues(0) {}
+    uint64_t offset; ///< start of the block, in target buffer elements
+    uint32_t size; ///< compressed size, in target buffer elements
+    uint32_t nValues; ///< number of encoded values
+  };
+
+  /**
+   * Encode blocks of values in parallel
+   *
+   * The target buffer and the descriptors are filled in block order,
+   * independent of the order in which the workers finish.
+   *
+   * @return number of blocks encoded, neg. error code on failure
+   */
+  template<typename ValueType>
+  int encode(const std::vector<std::vector<ValueType>>& blocks,
+             std::vector<_TargetType>& buffer,
+             std::vector<BlockDescriptor>& descriptors,
+             int nThreads = 4) const
+  {
+    // a codec is required by the deflater interface but not used, the
+    // dispatcher does the encoding
+    struct DummyCodec {};
+    typedef AliceO2::DataDeflater<uint64_t, _TargetType, DummyCodec> deflater_type;
+
+    size_t nBlocks = blocks.size();
+    std::vector<std::vector<_TargetType>> encodedBlocks(nBlocks);
+    std::vector<int> blockResults(nBlocks, 0);
+    std::atomic<size_t> nextBlock(0);
+
+    auto worker = [&]() {
+      // every worker encodes with its own dispatcher to keep the cyclic
+      // model position local to the block
+      while (true) {
+        size_t block = nextBlock++;
+        if (block >= nBlocks) break;
+        DispatcherType dispatcher(mDispatcher);
+        // worst case: every value uses the full code type width
+        size_t capacity = (blocks[block].size()*code_type().size())/TargetBitWidth + 1;
+        encodedBlocks[block].resize(capacity);
+        deflater_type deflater;
+        deflater.Init(encodedBlocks[block].data(), encodedBlocks[block].size());
+        int result = deflater.WriteArray(blocks[block].begin(), blocks[block].end(), dispatcher);
+        if (result < 0) {
+          blockResults[block] = result;
+          continue;
+        }
+        encodedBlocks[block].resize(deflater.Close());
+      }
+    };
+
+    runWorkers(worker, nBlocks, nThreads);
+
+    // concatenate in block order and record the offsets
+    descriptors.resize(nBlocks);
+    size_t totalSize = 0;
+    for (size_t block = 0; block < nBlocks; block++) {
+      if (blockResults[block] < 0) return blockResults[block];
+      totalSize += encodedBlocks[block].size();
+    }
+    buffer.clear();
+    buffer.reserve(totalSize);
+    for (size_t block = 0; block < nBlocks; block++) {
+      descriptors[block].offset = buffer.size();
+      descriptors[block].size = encodedBlocks[block].size();
+      descriptors[block].nValues = blocks[block].size();
+      buffer.insert(buffer.end(), encodedBlocks[block].begin(), encodedBlocks[block].end());
+    }
+    return nBlocks;
+  }
+
+  /**
+   * Decode blocks encoded by encode in parallel
+   *
+   * @return number of blocks decoded, neg. error code on failure
+   */
+  template<typename ValueType>
+  int decode(const std::vector<_TargetType>& buffer,
+             const std::vector<BlockDescriptor>& descriptors,
+             std::vector<std::vector<ValueType>>& blocks,
+             int nThreads = 4) const
+  {
+    size_t nBlocks = descriptors.size();
+    blocks.resize(nBlocks);
+    std::atomic<size_t> nextBlock(0);
+
+    auto worker = [&]() {
+      while (true) {
+        size_t block = nextBlock++;
+        if (block >= nBlocks) break;
+        DispatcherType dispatcher(mDispatcher);
+        const BlockDescriptor& descriptor = descriptors[block];
+        const _TargetType* blockStart = buffer.data() + descriptor.offset;
+        blocks[block].clear();
+        blocks[block].reserve(descriptor.nValues);
+        size_t bitPosition = 0;
+        for (uint32_t n = 0; n < descriptor.nValues; n++) {
+          uint64_t window = getWindow(blockStart, descriptor.size, bitPosition, code_type().size());
+          ValueType value;
+          uint16_t codeLength = 0;
+          dispatcher.decode(value, code_type(window), codeLength);
+          blocks[block].push_back(value);
+          bitPosition += codeLength;
+        }
+      }
+    };
+
+    runWorkers(worker, nBlocks, nThreads);
+    return nBlocks;
+  }
+
+private:
+  ParallelBlockCodec(); //forbidden
+
+  /**
+   * Extract nBits bits starting at bitPosition from the MSB-first bit
+   * stream, aligned to the LSBs of the return value, first bit in the
+   * highest of the nBits positions. Bits beyond the buffer read as zero.
+   */
+  static uint64_t getWindow(const _TargetType* buffer, size_t nElements,
+                            size_t bitPosition, uint16_t nBits)
+  {
+    uint64_t window = 0;
+    uint16_t collected = 0;
+    size_t element = bitPosition / TargetBitWidth;
+    uint16_t skip = bitPosition % TargetBitWidth;
+    while (collected < nBits) {
+      uint64_t value = (element < nElements)? uint64_t(buffer[element]) : 0;
+      uint16_t avail = TargetBitWidth - skip;
+      if (skip > 0) value &= (uint64_t(1) << avail) - 1;
+      uint16_t take = nBits - collected;
+      if (take > avail) take = avail;
+      window <<= take;
+      window |= value >> (avail - take);
+      collected += take;
+      skip = 0;
+      ++element;
+    }
+    return window;
+  }
+
+  /// run the worker function on a pool bounded by nThreads and the work size
+  template<typename WorkerType>
+  static void runWorkers(WorkerType& worker, size_t nBlocks, int nThreads)
+  {
+    size_t poolSize = nThreads;
+    if (poolSize > nBlocks) poolSize = nBlocks;
+    if (poolSize <= 1) {
+      worker();
+      return;
+    }
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < poolSize; i++) {
+      pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+      thread.join();
+    }
+  }
+
+  /// the model dispatcher prototype copied by every worker
+  DispatcherType mDispatcher;
+};
+
+}; // namespace O2
+}; // namespace ALICE
+
+#endif
@@ -18,14 +18,68 @@
 //  @author Matthias Richter
 //  @since  2015-08-08
 //  @brief  A simple converter producing truncated precision
-//          according to a data model 
+//          according to a data model
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
 
 namespace AliceO2 {
 
-template<class _ParameterModel>
+/**
+ * @brief No-op statistics policy, the default
+ * All calls compile away entirely.
+ */
+struct no_statistics {
+  template<typename T, typename _RegType, typename _ParameterModel>
+  void operator()(T /*value*/, _RegType /*content*/, uint8_t /*bitlength*/,
+                  const _ParameterModel& /*model*/) {}
+  void Reset() {}
+};
+
+/**
+ * @brief Accumulated error statistics of the precision truncation
+ *
+ * Collects count, mean, RMS and maximum absolute value of the difference
+ * between the original value and the value restored from the truncated
+ * representation, accumulated while converting without a second pass over
+ * the data. Requires the parameter model to implement
+ *   value_type Restore(content)
+ * inverting its Convert.
+ */
+class accumulated_error_statistics {
+public:
+  accumulated_error_statistics() : mCount(0), mSum(0.), mSumOfSquares(0.), mMaxAbs(0.) {}
+
+  template<typename T, typename _RegType, typename _ParameterModel>
+  void operator()(T value, _RegType content, uint8_t /*bitlength*/,
+                  const _ParameterModel& model) {
+    double error = double(value) - double(model.Restore(content));
+    ++mCount;
+    mSum += error;
+    mSumOfSquares += error*error;
+    double absError = std::abs(error);
+    if (absError > mMaxAbs) mMaxAbs = absError;
+  }
+
+  void Reset() {mCount = 0; mSum = 0.; mSumOfSquares = 0.; mMaxAbs = 0.;}
+
+  uint64_t GetCount() const {return mCount;}
+  double GetMean() const {return (mCount > 0)? mSum/mCount : 0.;}
+  double GetRMS() const {return (mCount > 0)? std::sqrt(mSumOfSquares/mCount) : 0.;}
+  double GetMaxAbs() const {return mMaxAbs;}
+
+private:
+  uint64_t mCount;
+  double mSum;
+  double mSumOfSquares;
+  double mMaxAbs;
+};
+
+template<class _ParameterModel, class _StatisticsPolicy = no_statistics>
 class TruncatedPrecisionConverter {
 public:
-  TruncatedPrecisionConverter() : mParameterModel() {}
+  TruncatedPrecisionConverter() : mParameterModel(), mStatistics() {}
   ~TruncatedPrecisionConverter() {}
 
   template <typename T, typename _RegType, typename _Writer>
@@ -33,9 +87,47 @@ public:
     uint8_t bitlength=0;
     _RegType content=0;
     mParameterModel.Convert(value, content, bitlength);
+    mStatistics(value, content, bitlength, mParameterModel);
     return writer(content, bitlength);
   }
 
+  /**
+   * Batched conversion of a contiguous sequence of values
+   *
+   * The conversion runs chunk-wise in a tight loop without calls to the
+   * outside, so when the model's Convert inlines to plain arithmetic the
+   * compiler can vectorize the truncation; the converted chunk is then fed
+   * to the writer and to the statistics policy.
+   *
+   * @return number of values converted, neg. error code from the writer
+   */
+  template <typename T, typename _RegType, typename _Writer>
+  int WriteBatch(const T* values, size_t nValues, _RegType /*dummy*/, _Writer writer) {
+    const size_t chunkSize = 64;
+    _RegType content[chunkSize];
+    uint8_t bitlength[chunkSize];
+    size_t converted = 0;
+    while (converted < nValues) {
+      size_t n = nValues - converted;
+      if (n > chunkSize) n = chunkSize;
+      const T* chunk = values + converted;
+      for (size_t i = 0; i < n; i++) {
+        content[i] = 0;
+        bitlength[i] = 0;
+        mParameterModel.Convert(chunk[i], content[i], bitlength[i]);
+      }
+      for (size_t i = 0; i < n; i++) {
+        mStatistics(chunk[i], content[i], bitlength[i], mParameterModel);
+      }
+      for (size_t i = 0; i < n; i++) {
+        int result = writer(content[i], bitlength[i]);
+        if (result < 0) return result;
+      }
+      converted += n;
+    }
+    return converted;
+  }
+
   void ResetParameterModel() {
     mParameterModel.Reset();
   }
@@ -43,6 +135,9 @@ public:
   const _ParameterModel& GetModel() const {return mParameterModel;}
   _ParameterModel& GetModel() {return mParameterModel;}
 
+  const _StatisticsPolicy& GetStatistics() const {return mStatistics;}
+  void ResetStatistics() {mStatistics.Reset();}
+
 private:
   /// forbidden in the first implementation
   TruncatedPrecisionConverter(const TruncatedPrecisionConverter&);
@@ -50,6 +145,8 @@ private:
   TruncatedPrecisionConverter& operator=(const TruncatedPrecisionConverter&);
   /// parameter model defines the conversion to the register type for writing bit pattern
   _ParameterModel mParameterModel;
+  /// statistics policy, monitoring the precision loss of the conversion
+  _StatisticsPolicy mStatistics;
 };
 };
 #endif
@@ -337,7 +337,7 @@ public:
   static const value_type _default0 = 0;
   static const value_type _default1 = _default0 + 1;
 
-  ProbabilityModel() : mProbabilityTable(), mTotalWeight(_default0) {}
+  ProbabilityModel() : mProbabilityTable(), mTotalWeight(_default0), mUpdateTable(), mUpdateWeight(_default0) {}
   ~ProbabilityModel() {}
 
   constexpr const char* getName() const { Alphabet tmp; return tmp.getName();}
@@ -357,6 +357,54 @@ public:
     return 0;
   }
 
+  /**
+   * Accumulate update statistics without changing the active weights
+   *
+   * The counters are collected in a separate table and folded into the
+   * probability table by mergeUpdates, so statistics of the current data
+   * can be collected while the active coding stays frozen.
+   */
+  int count(value_type value, weight_type weight = _default1) {
+    mUpdateTable[value] += weight;
+    mUpdateWeight += weight;
+    return 0;
+  }
+
+  /// get total weight accumulated via count since the last mergeUpdates
+  WeightType getUpdateWeight() const {
+    return mUpdateWeight;
+  }
+
+  /**
+   * Fold the accumulated update statistics into the probability table
+   *
+   * The present weights are scaled by the aging factor before the counts
+   * are added; an aging factor < 1 lets the model follow shifts of the
+   * distribution without a full re-normalization of the table.
+   * @return number of symbols with changed weight
+   */
+  int mergeUpdates(WeightType agingFactor = _default1) {
+    if (agingFactor != _default1) {
+      for (typename TableType::iterator i = mProbabilityTable.begin();
+           i != mProbabilityTable.end();
+           i++) {
+        i->second *= agingFactor;
+      }
+      mTotalWeight *= agingFactor;
+    }
+    int changed = 0;
+    for (typename TableType::const_iterator i = mUpdateTable.begin();
+         i != mUpdateTable.end();
+         i++) {
+      mProbabilityTable[i->first] += i->second;
+      ++changed;
+    }
+    mTotalWeight += mUpdateWeight;
+    mUpdateTable.clear();
+    mUpdateWeight = _default0;
+    return changed;
+  }
+
   WeightType normalize() {
     WeightType totalWeight = _default0;
     // TODO: handle division by zero, although that should not occur at all
@@ -395,6 +443,9 @@ public:
 private:
   TableType mProbabilityTable;
   WeightType mTotalWeight;
+  // statistics accumulated via count, pending until mergeUpdates
+  TableType mUpdateTable;
+  WeightType mUpdateWeight;
 };
 
 #endif
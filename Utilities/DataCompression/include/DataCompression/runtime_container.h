@@ -28,6 +28,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <new>
+#include <type_traits>
 #include <boost/mpl/equal.hpp>
 #include <boost/mpl/minus.hpp>
 #include <boost/mpl/less.hpp>
@@ -337,6 +339,78 @@ struct rc_dispatcher {
   }
 };
 
+/**
+ * @brief Filler for the apply jump table, see rc_apply_table
+ * This meta function recurses through the indices and stores the address of
+ * the specialized dispatcher function at every table position.
+ *
+ * @note internal meta function for rc_apply_table
+ */
+template<typename _ContainerT
+         , typename F
+         , typename _IndexT
+         , int _Index    // current index
+         , int _Size     // table size, terminates the recursion
+         >
+struct rc_apply_table_filler
+{
+  typedef typename F::return_type (*function_type)(_ContainerT&, _IndexT, F&);
+  static void fill(function_type* table)
+  {
+    table[_Index] = &rc_dispatcher<_ContainerT, F, boost::mpl::int_<_Index>, _IndexT>::apply;
+    rc_apply_table_filler<_ContainerT, F, _IndexT, _Index + 1, _Size>::fill(table);
+  }
+};
+// specialization: end of recursive loop, kicks in if _Index matches _Size
+template<typename _ContainerT
+         , typename F
+         , typename _IndexT
+         , int _Size
+         >
+struct rc_apply_table_filler<_ContainerT, F, _IndexT, _Size, _Size>
+{
+  typedef typename F::return_type (*function_type)(_ContainerT&, _IndexT, F&);
+  static void fill(function_type*) {}
+};
+
+/**
+ * @class rc_apply_table
+ * @brief Compile time generated jump table for the apply dispatch
+ *
+ * One table entry per container level, every entry pointing to the
+ * rc_dispatcher specialization which casts directly to that level. The
+ * dispatch is thus a single indexed indirect call independent of the
+ * container size, in contrast to the recursive rc_apply_at loop and
+ * without the fixed range limit of the manually unrolled switch.
+ */
+template<typename _ContainerT
+         , typename F
+         , typename _IndexT = int
+         >
+class rc_apply_table
+{
+public:
+  typedef typename F::return_type (*function_type)(_ContainerT&, _IndexT, F&);
+  static const int size = boost::mpl::size<typename _ContainerT::types>::value;
+
+  rc_apply_table()
+  {
+    rc_apply_table_filler<_ContainerT, F, _IndexT, 0, size>::fill(mTable);
+  }
+
+  typename F::return_type apply(_ContainerT& c, _IndexT position, F& f) const
+  {
+    if (position < 0 || position >= size) {
+      // same out of bound behavior as the recursive loop
+      return typename F::return_type(0);
+    }
+    return mTable[position](c, position, f);
+  }
+
+private:
+  function_type mTable[size];
+};
+
 /**
  * @class RuntimeContainer The base for the mixin class
  * @brief the technical base of the mixin class
@@ -489,6 +563,21 @@ public:
     return rc_dispatcher<mixin_type, F>::apply(*this, index, f);
   }
 
+  /*
+   * Apply a functor to the runtime container at index via a jump table
+   *
+   * The table covers all levels of the container and is generated at
+   * compile time, built once on first use per container/functor
+   * combination. Alternative to 'apply' for hot per-symbol dispatch where
+   * the recursive loop or the fixed range of the unrolled switch is a
+   * limitation.
+   */
+  template<typename F>
+  typename F::return_type applyTable(int index, F f) {
+    static const rc_apply_table<mixin_type, F> table;
+    return table.apply(*this, index, f);
+  }
+
 private:
   T mMember;
 };
@@ -564,6 +653,43 @@ struct create_rtc_types
     >::type type;
 };
 
+/**
+ * @class rc_arena
+ * @brief Aligned placement of a runtime container instance
+ *
+ * The mixin chain is by construction one contiguous object, every level a
+ * base class subobject of the next, so the levels can not land in separate
+ * heap chunks. What default allocation does not control is the alignment of
+ * that one object; the arena constructs the container into cache line
+ * aligned storage so the per-symbol apply calls walk a single aligned
+ * block.
+ *
+ * Usage: rc_arena<container_type> container; container->apply(...);
+ */
+template<typename _ContainerT, std::size_t _Alignment = 64>
+class rc_arena
+{
+public:
+  rc_arena() : mInstance(new (&mStorage) _ContainerT) {}
+  ~rc_arena() {mInstance->~_ContainerT();}
+
+  typedef _ContainerT container_type;
+  static const std::size_t alignment = _Alignment;
+
+  /// access to the embedded container instance
+  _ContainerT& operator*() {return *mInstance;}
+  const _ContainerT& operator*() const {return *mInstance;}
+  _ContainerT* operator->() {return mInstance;}
+  const _ContainerT* operator->() const {return mInstance;}
+
+private:
+  rc_arena(const rc_arena&); //forbidden
+  rc_arena& operator=(const rc_arena&); //forbidden
+
+  typename std::aligned_storage<sizeof(_ContainerT), _Alignment>::type mStorage;
+  _ContainerT* mInstance;
+};
+
 };// namespace gNeric
 
 #endif
@@ -0,0 +1,93 @@
+//-*- Mode: C++ -*-
+
+#ifndef TPCCLUSTER_RECORD_H
+#define TPCCLUSTER_RECORD_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   tpccluster_record.h
+//  @brief  Packed TPC cluster record at the bit widths of the parameter model
+
+// The cluster alphabet in tpccluster_parameter_model.h fixes the bit width
+// of every cluster parameter. When the cluster producer stores unpacked
+// floats, every compression pass has to quantize to these widths, and a
+// decode-reencode cycle quantizes twice. This header is the single source
+// of the widths: the alphabet definitions and the packed record below are
+// built from the same constants, so a record stored by the cluster finder
+// is already a valid symbol sequence of the model. Encoding is a copy of
+// the integer fields, decoding restores exactly the stored symbols, and
+// the only lossy conversion happens once, at cluster production.
+
+#include <cstdint>
+
+namespace AliceO2 {
+
+/**
+ * @brief Bit layout of the TPC cluster parameter alphabet
+ *
+ * Widths of the alphabet symbols and fixed point scales of the fractional
+ * parameters. The integer part of the pad width covers the longest pad row,
+ * the integer part of the time width covers the time frame length, and the
+ * sigma scale covers widths up to eight pads/time bins.
+ */
+struct TPCClusterWidth {
+  enum {
+    kPadRow  =  6, ///< pad row within the CRU
+    kPad     = 14, ///< pad position, fixed point
+    kTime    = 15, ///< time position, fixed point
+    kSigmaY2 =  8, ///< cluster width in pad direction, fixed point
+    kSigmaZ2 =  8, ///< cluster width in time direction, fixed point
+    kCharge  = 16, ///< total charge
+    kQMax    = 10, ///< maximum charge of a single cell
+    // fractional bits of the fixed point parameters
+    kPadFractionBits   = 6, ///< pad in 1/64 pad units, 8 integer bits
+    kTimeFractionBits  = 6, ///< time in 1/64 time bin units, 9 integer bits
+    kSigmaFractionBits = 5  ///< sigma in 1/32 units, 3 integer bits
+  };
+};
+
+/**
+ * @brief One TPC cluster at the bit widths of the compression model
+ *
+ * Plain record of unsigned integer fields, one per alphabet of
+ * tpccluster_parameter, each already clamped to its alphabet range. The
+ * fixed point fields are quantized with the scales of TPCClusterWidth;
+ * pack and unpack are inverse up to the quantization of pack, so reading
+ * a stored record back does not requantize.
+ */
+struct TPCClusterRecord {
+  uint16_t padrow;  ///< TPCClusterWidth::kPadRow bits
+  uint16_t pad;     ///< TPCClusterWidth::kPad bits, kPadFractionBits fractional
+  uint16_t time;    ///< TPCClusterWidth::kTime bits, kTimeFractionBits fractional
+  uint16_t sigmaY2; ///< TPCClusterWidth::kSigmaY2 bits, kSigmaFractionBits fractional
+  uint16_t sigmaZ2; ///< TPCClusterWidth::kSigmaZ2 bits, kSigmaFractionBits fractional
+  uint16_t charge;  ///< TPCClusterWidth::kCharge bits
+  uint16_t qmax;    ///< TPCClusterWidth::kQMax bits
+
+  /// quantize a non-negative value to a fixed point symbol, clamped to the
+  /// alphabet range
+  static uint16_t Pack(float value, unsigned fractionBits, unsigned widthBits)
+  {
+    if (value <= 0.f) return 0;
+    const uint32_t max = (1u << widthBits) - 1;
+    const uint32_t symbol = static_cast<uint32_t>(value * float(1u << fractionBits) + 0.5f);
+    return static_cast<uint16_t>(symbol < max ? symbol : max);
+  }
+
+  /// restore the value of a fixed point symbol
+  static float Unpack(uint16_t symbol, unsigned fractionBits)
+  {
+    return float(symbol) / float(1u << fractionBits);
+  }
+};
+
+} // namespace AliceO2
+
+#endif
@@ -23,6 +23,10 @@
 #include <utility>    // std::forward
 #include <random>     // random distribution
 #include <cmath>      // exp
+#include <cstdint>    // uint64_t stream positions
+#include <memory>     // pristine model copy per block
+#include <thread>     // parallel block generation
+#include <vector>     // thread list
 //#include <iostream> // lets see if needed, or keep class fre from output
 //#include <iomanip>  // lets see if needed, or keep class fre from output
 
@@ -223,16 +227,55 @@ public:
 
   const result_type mean;
 
-  int factorial(unsigned int n) const {
-    return (n <= 1)? 1 : factorial(n-1) * n;
-  }
-
   /// get theoretical probability of a value
+  // computed via logarithms, the factorial overflows integer types
+  // already at v = 13
   template<typename value_type>
   double getProbability(value_type v) const {
     if (v<0) return 0.;
-    return pow(mean, v) * exp(-mean) / factorial(v);
+    return exp(v * log(double(mean)) - mean - lgamma(v + 1.));
+  }
+};
+
+/**
+ * @class mixture_distribution
+ * @brief two-component mixture of distribution models
+ *
+ * Draws from the first component with the configured fraction and from the
+ * second component otherwise, e.g. a normal body with a poisson tail as in
+ * real ADC spectra. The components have to implement the analytic formula
+ * like the other models in this file, the mixture probability is the
+ * weighted sum.
+ */
+template <class ModelA
+          , class ModelB
+          >
+class mixture_distribution {
+public:
+  typedef typename ModelA::result_type result_type;
+
+  mixture_distribution(double _fraction, ModelA _componentA, ModelB _componentB)
+    : fraction(_fraction), mComponentA(_componentA), mComponentB(_componentB), mSelector(_fraction) {}
+
+  const double fraction;
+
+  /// draw from the selected component
+  template<typename Generator>
+  result_type operator()(Generator& generator) {
+    if (mSelector(generator)) return result_type(mComponentA(generator));
+    return result_type(mComponentB(generator));
   }
+
+  /// get theoretical probability of a value, weighted sum of the components
+  template<typename value_type>
+  double getProbability(value_type v) const {
+    return fraction * mComponentA.getProbability(v) + (1 - fraction) * mComponentB.getProbability(v);
+  }
+
+private:
+  ModelA mComponentA;
+  ModelB mComponentB;
+  std::bernoulli_distribution mSelector;
 };
 
 /**
@@ -257,6 +300,150 @@ public:
   }
 };
 
+/**
+ * @class DataStreamGenerator
+ * @brief Seekable, reproducible symbol stream at benchmark scale
+ *
+ * The stream is divided into blocks of fixed size and the engine of every
+ * block is seeded from the stream seed and the block index. Any block can
+ * thus be generated independently of the rest of the stream: the stream
+ * is seekable without generating all skipped symbols, two generators with
+ * the same configuration produce identical streams, and distinct blocks
+ * can be generated by several threads in parallel. Streams of billions of
+ * symbols can so serve as benchmark input without storing input files.
+ *
+ * Seeking within a block has to generate the preceding symbols of that
+ * block because of the rejection sampling, i.e. costs up to one block of
+ * symbol generations; the block size is the trade-off between seek
+ * granularity and parallelization overhead.
+ */
+template<typename ValueT
+         , typename ModelT>
+class DataStreamGenerator {
+public:
+  typedef ValueT value_type;
+  typedef ValueT result_type;
+  typedef std::mt19937_64 random_engine;
+
+  template<typename... Args>
+  DataStreamGenerator(result_type _min,
+                      result_type _max,
+                      result_type _step,
+                      uint64_t _seed,
+                      uint64_t _blockSize,
+                      Args&&... args)
+    : min(_min), max(_max), step(_step), seed(_seed), blockSize(_blockSize),
+      mModel(std::forward<Args>(args)...), mBlockModel(), mEngine(), mPosition(0) {
+    seek(0);
+  }
+  ~DataStreamGenerator() {}
+
+  const result_type min;
+  const result_type max;
+  const result_type step;
+  const uint64_t seed;
+  const uint64_t blockSize;
+
+  /// get current stream position
+  uint64_t tell() const {return mPosition;}
+
+  /// move the stream to an arbitrary position
+  void seek(uint64_t position) {
+    uint64_t blockStart = (position / blockSize) * blockSize;
+    startBlock(position / blockSize);
+    mPosition = blockStart;
+    while (mPosition < position) {
+      draw(mEngine, *mBlockModel);
+      ++mPosition;
+    }
+  }
+
+  /// get next symbol of the stream
+  value_type operator()() {
+    if (mPosition % blockSize == 0) startBlock(mPosition / blockSize);
+    value_type v = draw(mEngine, *mBlockModel);
+    ++mPosition;
+    return v;
+  }
+
+  /// generate one complete block into the provided buffer of blockSize
+  /// symbols; independent of the stream position and of other blocks,
+  /// can be called concurrently for distinct blocks
+  void fillBlock(uint64_t blockIndex, value_type* buffer) const {
+    random_engine engine(blockSeed(blockIndex));
+    ModelT model = mModel;
+    for (uint64_t i = 0; i < blockSize; i++) {
+      buffer[i] = draw(engine, model);
+    }
+  }
+
+  /// generate a range of blocks with several threads, buffer has to hold
+  /// nofBlocks * blockSize symbols
+  void fillBlocks(uint64_t firstBlock, unsigned nofBlocks, value_type* buffer,
+                  unsigned nofThreads = std::thread::hardware_concurrency()) const {
+    if (nofThreads > nofBlocks) nofThreads = nofBlocks;
+    if (nofThreads < 2) {
+      for (unsigned block = 0; block < nofBlocks; block++) {
+        fillBlock(firstBlock + block, buffer + block * blockSize);
+      }
+      return;
+    }
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < nofThreads; thread++) {
+      workers.emplace_back([this, firstBlock, nofBlocks, buffer, thread, nofThreads]() {
+          for (uint64_t block = thread; block < nofBlocks; block += nofThreads) {
+            fillBlock(firstBlock + block, buffer + block * blockSize);
+          }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+  }
+
+  /// get theoretical probability of a value
+  double getProbability(value_type v) const {
+    return mModel.getProbability(v);
+  }
+
+ private:
+  /// engine seed of a block, a bit mix of stream seed and block index
+  /// to decorrelate the seeds of consecutive blocks
+  uint64_t blockSeed(uint64_t blockIndex) const {
+    uint64_t z = seed + 0x9e3779b97f4a7c15ULL * (blockIndex + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  /// reseed engine and reset model state at a block boundary
+  void startBlock(uint64_t blockIndex) {
+    mEngine.seed(blockSeed(blockIndex));
+    // distribution models carry internal state (e.g. a cached second
+    // normal value), every block has to start from the pristine copy;
+    // the models are copy-constructible but not assignable because of
+    // their const configuration members
+    mBlockModel.reset(new ModelT(mModel));
+  }
+
+  /// draw one symbol, rejection sampling and binning as in DataGenerator
+  value_type draw(random_engine& engine, ModelT& model) const {
+    value_type v;
+    int trials = 0;
+    while ((v = model(engine)) < min || v >= max) {
+      if (trials++ > 1000) {
+        // this is a protection, just picked a reasonable threshold for number of trials
+        throw std::range_error("random value outside configured range for too many trials");
+      }
+    }
+    int bin = (v - min)/step;
+    return min + bin * step;
+  }
+
+  ModelT mModel;                      // pristine model configuration
+  std::unique_ptr<ModelT> mBlockModel; // working copy for the sequential access
+  random_engine mEngine;
+  uint64_t mPosition;
+};
+
 }; // namespace test
 }; // namespace AliceO2
 #endif
@@ -0,0 +1,210 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   bench_datacompression.cxx
+//  @author Matthias Richter
+//  @since  2016-09-17
+//  @brief  Throughput benchmark for the DataCompression stack
+//
+//  Measures encode and decode throughput (MB/s of uncompressed input) for
+//  Huffman models over different alphabet sizes and probability shapes from
+//  the DataGenerator distributions. Decoding is measured both with the
+//  bit-by-bit tree walk and with the table-driven decoder. Results are
+//  printed as a JSON array to be tracked run-over-run.
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -O2 -I$BOOST_ROOT/include -I../include -o bench_datacompression bench_datacompression.cxx
+*/
+
+#include <iostream>
+#include <vector>
+#include <bitset>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include "DataCompression/dc_primitives.h"
+#include "DataCompression/DataDeflater.h"
+#include "DataCompression/HuffmanCodec.h"
+#include "DataGenerator.h"
+
+namespace {
+
+/// extract a code window from the MSB-first bit stream, first bit in the
+/// highest of the nBits positions, bits beyond the buffer read as zero
+uint64_t getWindow(const uint8_t* buffer, size_t nElements, size_t bitPosition, uint16_t nBits)
+{
+  uint64_t window = 0;
+  uint16_t collected = 0;
+  size_t element = bitPosition / 8;
+  uint16_t skip = bitPosition % 8;
+  while (collected < nBits) {
+    uint64_t value = (element < nElements)? uint64_t(buffer[element]) : 0;
+    uint16_t avail = 8 - skip;
+    if (skip > 0) value &= (uint64_t(1) << avail) - 1;
+    uint16_t take = nBits - collected;
+    if (take > avail) take = avail;
+    window <<= take;
+    window |= value >> (avail - take);
+    collected += take;
+    skip = 0;
+    ++element;
+  }
+  return window;
+}
+
+double seconds(std::chrono::steady_clock::time_point start,
+               std::chrono::steady_clock::time_point stop)
+{
+  return std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count();
+}
+
+/**
+ * Run encode/decode measurement for one model and data generator
+ *
+ * The model is trained from the analytic probabilities of the generator,
+ * nRolls values are generated up front, then encoded through the deflater
+ * and decoded back from the bit stream.
+ */
+template<typename ModelType, typename GeneratorType>
+void runBenchmark(const char* name, GeneratorType& dg, int nRolls, bool& first)
+{
+  ModelType model;
+  model.init(0.);
+  int alphabetSize = 0;
+  for (auto s : dg) {
+    model.addWeight(s, dg.getProbability(s));
+    ++alphabetSize;
+  }
+  model.normalize();
+  model.GenerateHuffmanTree();
+
+  typedef typename GeneratorType::value_type value_type;
+  typedef typename ModelType::code_type code_type;
+  std::vector<value_type> values;
+  values.reserve(nRolls);
+  for (int n = 0; n < nRolls; n++) {
+    values.push_back(dg());
+  }
+  double inputMB = double(nRolls*sizeof(value_type))/(1024.*1024.);
+
+  // encode through the deflater into a worst-case sized buffer
+  struct DummyCodec {};
+  typedef AliceO2::DataDeflater<uint64_t, uint8_t, DummyCodec> Deflater_t;
+  std::vector<uint8_t> buffer((size_t(nRolls)*code_type().size())/8 + 1);
+  Deflater_t deflater;
+  deflater.Init(buffer.data(), buffer.size());
+  auto start = std::chrono::steady_clock::now();
+  for (auto v : values) {
+    uint16_t codeLength = 0;
+    code_type code = model.Encode(v, codeLength);
+    deflater.WriteRaw(code.to_ullong(), codeLength);
+  }
+  int nElements = deflater.Close();
+  auto stop = std::chrono::steady_clock::now();
+  double encodeMBps = inputMB/seconds(start, stop);
+
+  // decode, tree walk and table-driven
+  double decodeMBps[2] = {0., 0.};
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) model.GenerateDecodingTable();
+    size_t bitPosition = 0;
+    int errors = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto v : values) {
+      uint16_t codeLength = 0;
+      value_type decoded = model.Decode(code_type(getWindow(buffer.data(), nElements, bitPosition, code_type().size())), codeLength);
+      if (decoded != v) ++errors;
+      bitPosition += codeLength;
+    }
+    stop = std::chrono::steady_clock::now();
+    decodeMBps[pass] = inputMB/seconds(start, stop);
+    if (errors > 0) {
+      std::cerr << "error: " << errors << " decoding mismatch(es) in benchmark " << name << std::endl;
+    }
+  }
+
+  if (!first) std::cout << "," << std::endl;
+  first = false;
+  std::cout << "  {\"name\": \"" << name << "\""
+            << ", \"alphabet_size\": " << alphabetSize
+            << ", \"nvalues\": " << nRolls
+            << ", \"input_mb\": " << inputMB
+            << ", \"compressed_bytes\": " << nElements
+            << ", \"encode_mbps\": " << encodeMBps
+            << ", \"decode_tree_mbps\": " << decodeMBps[0]
+            << ", \"decode_table_mbps\": " << decodeMBps[1]
+            << "}";
+}
+
+} // anonymous namespace
+
+int main()
+{
+  typedef AliceO2::Test::normal_distribution<double> NormalDistribution_t;
+  typedef AliceO2::Test::geometric_distribution<int> GeometricDistribution_t;
+
+  const int nRolls = 1000000;
+  bool first = true;
+  std::cout << "[" << std::endl;
+
+  {
+    // small alphabet, flat-ish normal distribution
+    typedef AliceO2::Test::DataGenerator<int16_t, NormalDistribution_t> Generator_t;
+    Generator_t dg(-7.5, 10.5, 1., 0., 4.);
+    typedef AliceO2::HuffmanModel<
+      ProbabilityModel<ContiguousAlphabet<int16_t, -7, 10>>
+      , AliceO2::HuffmanNode<std::bitset<32>>
+      , true
+      > Model_t;
+    runBenchmark<Model_t>("normal_18_wide", dg, nRolls, first);
+  }
+
+  {
+    // small alphabet, steep normal distribution
+    typedef AliceO2::Test::DataGenerator<int16_t, NormalDistribution_t> Generator_t;
+    Generator_t dg(-7.5, 10.5, 1., 0., 1.);
+    typedef AliceO2::HuffmanModel<
+      ProbabilityModel<ContiguousAlphabet<int16_t, -7, 10>>
+      , AliceO2::HuffmanNode<std::bitset<32>>
+      , true
+      > Model_t;
+    runBenchmark<Model_t>("normal_18_steep", dg, nRolls, first);
+  }
+
+  {
+    // larger alphabet as for 10 bit parameters
+    typedef AliceO2::Test::DataGenerator<int16_t, NormalDistribution_t> Generator_t;
+    Generator_t dg(-511.5, 512.5, 1., 0., 128.);
+    typedef AliceO2::HuffmanModel<
+      ProbabilityModel<ContiguousAlphabet<int16_t, -511, 512>>
+      , AliceO2::HuffmanNode<std::bitset<64>>
+      , true
+      > Model_t;
+    runBenchmark<Model_t>("normal_1024", dg, nRolls, first);
+  }
+
+  {
+    // geometric distribution, very steep probability shape
+    typedef AliceO2::Test::DataGenerator<int16_t, GeometricDistribution_t> Generator_t;
+    Generator_t dg(0, 64., 1., 0.3);
+    typedef AliceO2::HuffmanModel<
+      ProbabilityModel<ContiguousAlphabet<int16_t, 0, 63>>
+      , AliceO2::HuffmanNode<std::bitset<64>>
+      , true
+      > Model_t;
+    runBenchmark<Model_t>("geometric_64", dg, nRolls, first);
+  }
+
+  std::cout << std::endl << "]" << std::endl;
+  return 0;
+}
@@ -0,0 +1,151 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   test_contextmodel.cxx
+//  @author Matthias Richter
+//  @since  2016-09-20
+//  @brief  Test program for the context-conditioned model layer
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -I../include -pthread -o test_contextmodel test_contextmodel.cxx
+*/
+
+#include <iostream>
+#include <bitset>
+#include <sstream>
+#include <vector>
+#include "DataCompression/dc_primitives.h"
+#include "DataCompression/HuffmanCodec.h"
+#include "DataCompression/ContextModel.h"
+#include "DataCompression/CodingModelDispatcher.h"
+
+int main()
+{
+  int nofErrors = 0;
+  typedef ContiguousAlphabet<int16_t, 0, 7> TestAlphabet_t;
+  typedef AliceO2::HuffmanModel<
+    ProbabilityModel<TestAlphabet_t>
+    , AliceO2::HuffmanNode<std::bitset<16> >
+    , true
+    > HuffmanModel_t;
+  typedef AliceO2::ContextModel<
+    HuffmanModel_t
+    , AliceO2::PreviousSymbolContext<int16_t, 4>
+    > ContextModel_t;
+
+  // a sequence with strong correlation to the previous symbol: after a
+  // small symbol a small one is likely, after a large one a large one
+  std::vector<int16_t> sequence;
+  for (int i = 0; i < 64; i++) {
+    int16_t value = (i / 8) % 2 == 0? i % 2 : 6 + i % 2;
+    sequence.push_back(value);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // train the conditioned model and generate the per-context tables
+  std::cout << "Training context model with " << ContextModel_t::nofContexts
+            << " context(s)" << std::endl;
+  ContextModel_t model;
+  model.init(1.);
+  model.resetContext();
+  for (auto value : sequence) {
+    model.addWeight(value);
+  }
+  model.GenerateHuffmanTree();
+  model.GenerateDecodingTable(4);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // encode and decode the sequence, encoder and decoder have to derive
+  // the same context from the symbol history
+  std::cout << "Checking encoding-decoding round trip" << std::endl;
+  std::vector<std::pair<ContextModel_t::code_type, uint16_t>> encoded;
+  model.resetContext();
+  for (auto value : sequence) {
+    uint16_t codeLength = 0;
+    ContextModel_t::code_type code = model.Encode(value, codeLength);
+    encoded.push_back(std::make_pair(code, codeLength));
+  }
+  model.resetContext();
+  for (unsigned i = 0; i < sequence.size(); i++) {
+    ContextModel_t::code_type code = encoded[i].first;
+    if (ContextModel_t::orderMSB) code <<= (code.size() - encoded[i].second);
+    uint16_t codeLength = 0;
+    int16_t value = model.Decode(code, codeLength);
+    if (value != sequence[i] || codeLength != encoded[i].second) {
+      std::cout << "mismatch at position " << i << ": got " << value
+                << "(" << codeLength << "), expected " << sequence[i]
+                << "(" << encoded[i].second << ")" << std::endl;
+      ++nofErrors;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // the configuration round trip has to restore the tables of all contexts
+  std::cout << "Checking configuration round trip" << std::endl;
+  std::stringstream configuration;
+  model.write(configuration);
+  configuration << std::endl;
+  ContextModel_t restored;
+  restored.init(1.);
+  if (restored.read(configuration) < 0) {
+    std::cout << "failed to read configuration" << std::endl;
+    ++nofErrors;
+  }
+  model.resetContext();
+  restored.resetContext();
+  for (auto value : sequence) {
+    uint16_t codeLength = 0;
+    ContextModel_t::code_type code = model.Encode(value, codeLength);
+    uint16_t restoredLength = 0;
+    ContextModel_t::code_type restoredCode = restored.Encode(value, restoredLength);
+    if (codeLength != restoredLength || code != restoredCode) {
+      std::cout << "mismatch in restored code for value " << value << std::endl;
+      ++nofErrors;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // the conditioned model works in the dispatcher like a plain model
+  std::cout << "Checking context model in the dispatcher" << std::endl;
+  typedef ALICE::O2::CodingModelDispatcher<ContextModel_t> Dispatcher_t;
+  Dispatcher_t dispatcher;
+  dispatcher.init();
+  for (auto value : sequence) {
+    dispatcher.addWeight(value, 1.);
+  }
+  dispatcher.generate();
+  (*(*dispatcher)).resetContext();
+  std::vector<std::pair<Dispatcher_t::code_type, uint16_t>> dispatched;
+  for (auto value : sequence) {
+    uint16_t codeLength = 0;
+    Dispatcher_t::code_type code;
+    dispatcher.encode(value, code, codeLength);
+    dispatched.push_back(std::make_pair(code, codeLength));
+  }
+  (*(*dispatcher)).resetContext();
+  for (unsigned i = 0; i < sequence.size(); i++) {
+    Dispatcher_t::code_type code = dispatched[i].first;
+    if (ContextModel_t::orderMSB) code <<= (code.size() - dispatched[i].second);
+    uint16_t codeLength = 0;
+    int16_t value = 0;
+    dispatcher.decode(value, code, codeLength);
+    if (value != sequence[i] || codeLength != dispatched[i].second) {
+      std::cout << "mismatch in dispatched value at position " << i << std::endl;
+      ++nofErrors;
+    }
+  }
+
+  if (nofErrors == 0) std::cout << "... all checks passed" << std::endl;
+  else std::cout << "... " << nofErrors << " error(s)" << std::endl;
+  return nofErrors == 0? 0 : 1;
+}
@@ -0,0 +1,184 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   test_datadeflater.cxx
+//  @author Matthias Richter
+//  @since  2016-08-17
+//  @brief  Test program for the DataDeflater bit packer
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -I../include -o test_datadeflater test_datadeflater.cxx
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <bitset>
+#include <string>
+#include <cstdint>
+#include "DataCompression/dc_primitives.h"
+#include "DataCompression/DataDeflater.h"
+#include "DataCompression/HuffmanCodec.h"
+#include "DataCompression/CodingModelDispatcher.h"
+#include "DataGenerator.h"
+
+/// reference packer: append codes to a string of '0'/'1' and convert to
+/// bytes, first bit in the MSB of the first byte
+template<typename BufferType>
+int checkAgainstBitstring(const std::string& bits, const std::vector<BufferType>& buffer, int nElements)
+{
+  int errors = 0;
+  const int width = 8*sizeof(BufferType);
+  int expectedElements = (bits.size() + width - 1)/width;
+  if (nElements != expectedElements) {
+    std::cout << "mismatch in number of elements: " << nElements << ", expected " << expectedElements << std::endl;
+    ++errors;
+  }
+  for (unsigned i = 0; i < bits.size(); i++) {
+    bool expected = bits[i] == '1';
+    bool written = (buffer[i/width] >> (width - 1 - i%width)) & 1;
+    if (expected != written) {
+      std::cout << "mismatch at bit " << i << std::endl;
+      ++errors;
+    }
+  }
+  return errors;
+}
+
+int main()
+{
+  // a codec is required by the deflater interface but not exercised here
+  struct DummyCodec {};
+  typedef AliceO2::DataDeflater<uint32_t, uint8_t, DummyCodec> Deflater_t;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // raw bit packing with known patterns, including codes longer than one
+  // buffer element and the zero padding of Close
+  int errors = 0;
+  {
+    std::vector<uint8_t> buffer(16, 0xa5);
+    Deflater_t deflater;
+    deflater.Init(buffer.data(), buffer.size());
+    std::string bits;
+    deflater.WriteRaw(uint8_t(0x5), 3);          bits += "101";
+    deflater.WriteRaw(uint16_t(0x0f0f), 13);     bits += "0111100001111";
+    deflater.WriteRaw(uint32_t(0x12345678), 29); bits += "10010001101000101011001111000";
+    deflater.WriteRaw(true);                     bits += "1";
+    int nElements = deflater.Close();
+    while (bits.size() % 8) bits += "0"; // padding of Close
+    errors += checkAgainstBitstring(bits, buffer, nElements);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // bulk write of Huffman encoded values through the model dispatcher,
+  // checked against the reference packing of the individual codes
+  typedef AliceO2::Test::normal_distribution<double> TestDistribution_t;
+  typedef AliceO2::Test::DataGenerator<int16_t, TestDistribution_t> DataGenerator_t;
+  DataGenerator_t dg(-7.5, 10.5, 1., 0., 1.);
+  typedef ContiguousAlphabet<DataGenerator_t::value_type, -7, 10> SimpleRangeAlphabet_t;
+
+  typedef AliceO2::HuffmanModel<
+    ProbabilityModel<SimpleRangeAlphabet_t>
+    , AliceO2::HuffmanNode<std::bitset<32> >
+    , true
+    > HuffmanModel_t;
+  typedef ALICE::O2::CodingModelDispatcher<HuffmanModel_t> Dispatcher_t;
+  Dispatcher_t dispatcher;
+  dispatcher.init();
+  SimpleRangeAlphabet_t alphabet;
+  for (auto s : alphabet) {
+    dispatcher.addWeight(s, dg.getProbability(s));
+  }
+  dispatcher.generate();
+
+  const int nRolls = 100000;
+  std::vector<DataGenerator_t::value_type> values;
+  values.reserve(nRolls);
+  for (int n = 0; n < nRolls; n++) {
+    values.push_back(dg());
+  }
+
+  std::string bits;
+  for (auto v : values) {
+    HuffmanModel_t::code_type code;
+    uint16_t codeLength = 0;
+    dispatcher.encode(v, code, codeLength);
+    for (int i = codeLength - 1; i >= 0; i--) {
+      bits += code.test(i)? "1" : "0";
+    }
+  }
+
+  std::vector<uint8_t> buffer(bits.size()/8 + 1, 0);
+  Deflater_t deflater;
+  deflater.Init(buffer.data(), buffer.size());
+  int count = deflater.WriteArray(values.begin(), values.end(), dispatcher);
+  if (count != nRolls) {
+    std::cout << "WriteArray wrote " << count << " value(s), expected " << nRolls << std::endl;
+    ++errors;
+  }
+  int nElements = deflater.Close();
+  while (bits.size() % 8) bits += "0";
+  errors += checkAgainstBitstring(bits, buffer, nElements);
+  std::cout << nRolls << " value(s) packed into " << nElements << " byte(s)" << std::endl;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // record encoding through a two-parameter model definition, the model
+  // loop is unrolled at compile time, checked against the cyclic per-value
+  // interface which has to produce the identical code sequence
+  typedef boost::mpl::vector<HuffmanModel_t, HuffmanModel_t> RecordDefinition_t;
+  typedef ALICE::O2::CodingModelDispatcher<RecordDefinition_t> RecordDispatcher_t;
+  RecordDispatcher_t recordDispatcher;
+  recordDispatcher.init();
+  for (auto s : alphabet) {
+    // addWeight cycles through the models, parameter 0 follows the
+    // generator distribution, parameter 1 is flat
+    recordDispatcher.addWeight(s, dg.getProbability(s));
+    recordDispatcher.addWeight(s, 1.);
+  }
+  recordDispatcher.generate();
+
+  const int nRecords = 1000;
+  std::string recordBits;
+  std::vector<uint8_t> recordBuffer(bits.size()/8 + 1, 0);
+  Deflater_t recordDeflater;
+  recordDeflater.Init(recordBuffer.data(), recordBuffer.size());
+  int nValues = 0;
+  for (int n = 0; n < nRecords; n++) {
+    DataGenerator_t::value_type record[2] = {values[2*n], values[2*n + 1]};
+    // reference codes from the cyclic per-value interface
+    for (auto v : record) {
+      HuffmanModel_t::code_type code;
+      uint16_t codeLength = 0;
+      recordDispatcher.encode(v, code, codeLength);
+      for (int i = codeLength - 1; i >= 0; i--) {
+        recordBits += code.test(i)? "1" : "0";
+      }
+    }
+    nValues += recordDeflater.WriteRecord(record, recordDispatcher);
+  }
+  if (nValues != 2*nRecords) {
+    std::cout << "WriteRecord wrote " << nValues << " value(s), expected " << 2*nRecords << std::endl;
+    ++errors;
+  }
+  nElements = recordDeflater.Close();
+  while (recordBits.size() % 8) recordBits += "0";
+  errors += checkAgainstBitstring(recordBits, recordBuffer, nElements);
+  std::cout << nRecords << " record(s) packed into " << nElements << " byte(s)" << std::endl;
+
+  if (errors == 0) {
+    std::cout << "... all checks passed" << std::endl;
+  } else {
+    std::cout << "... " << errors << " error(s)" << std::endl;
+  }
+  return (errors == 0)? 0 : 1;
+}
@@ -58,4 +58,70 @@ int main()
               << throws[bin]
               << std::endl;
   }
+
+  //////////////////////////////////////////////////////////////////////////
+  // stream generator: a mixture of a normal body and a poisson tail as in
+  // real ADC spectra, generated in seekable, reproducible blocks
+  int nofErrors = 0;
+  typedef AliceO2::Test::mixture_distribution<
+    AliceO2::Test::normal_distribution<double>
+    , AliceO2::Test::poisson_distribution<int>
+    > MixtureDistribution_t;
+  typedef AliceO2::Test::DataStreamGenerator<int, MixtureDistribution_t> StreamGenerator_t;
+  const uint64_t blockSize = 1024;
+  StreamGenerator_t sg(0, 64, 1, 20160815, blockSize,
+                       0.9,
+                       AliceO2::Test::normal_distribution<double>(8., 4.),
+                       AliceO2::Test::poisson_distribution<int>(40));
+
+  // two generators with identical configuration produce identical streams
+  StreamGenerator_t sg2(0, 64, 1, 20160815, blockSize,
+                        0.9,
+                        AliceO2::Test::normal_distribution<double>(8., 4.),
+                        AliceO2::Test::poisson_distribution<int>(40));
+  std::vector<int> sequential;
+  for (unsigned i = 0; i < 4 * blockSize; i++) {
+    sequential.push_back(sg());
+    if (sequential.back() != sg2()) {
+      std::cout << "mismatch between streams of identical configuration at " << i << std::endl;
+      ++nofErrors;
+      break;
+    }
+  }
+
+  // seeking into the stream reproduces the sequential values
+  const uint64_t seekPositions[] = {0, 1, blockSize - 1, blockSize, 2 * blockSize + 512};
+  for (auto position : seekPositions) {
+    sg.seek(position);
+    int value = sg();
+    if (value != sequential[position]) {
+      std::cout << "mismatch after seek to " << position << ": got " << value
+                << ", expected " << sequential[position] << std::endl;
+      ++nofErrors;
+    }
+  }
+
+  // parallel block generation matches the sequential stream
+  std::vector<int> parallel(4 * blockSize);
+  sg.fillBlocks(0, 4, &parallel[0], 4);
+  for (unsigned i = 0; i < parallel.size(); i++) {
+    if (parallel[i] != sequential[i]) {
+      std::cout << "mismatch between parallel and sequential stream at " << i << std::endl;
+      ++nofErrors;
+      break;
+    }
+  }
+
+  // the mixture probability is the weighted sum of the components
+  double integral = 0.;
+  for (int v = 0; v < 64; v++) {
+    integral += sg.getProbability(v);
+  }
+  if (integral < 0.95 || integral > 1.05) {
+    std::cout << "mixture probability does not integrate to ~1: " << integral << std::endl;
+    ++nofErrors;
+  }
+
+  if (nofErrors == 0) std::cout << "stream generator checks passed" << std::endl;
+  return nofErrors == 0? 0 : 1;
 }
@@ -146,6 +146,85 @@ int main()
     }
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  // repeat the encoding-decoding check with the table-driven decoder
+  std::cout << std::endl << "Checking table-driven decoding" << std::endl;
+  huffmanmodel.GenerateDecodingTable(4);
+  Codec_t tablecodec(huffmanmodel);
+  for ( auto i : huffmanmodel) {
+    uint16_t codeLen = 0;
+    HuffmanModel_t::code_type code;
+    tablecodec.Encode(i.first, code, codeLen);
+    if (HuffmanModel_t::orderMSB) code <<= (code.size()-codeLen);
+    uint16_t decodedLen = 0;
+    HuffmanModel_t::value_type value;
+    tablecodec.Decode(value, code, decodedLen);
+    if (codeLen != decodedLen || value != i.first) {
+      std::cout << "mismatch in table-decoded value: " << value << "(" << decodedLen << ")" << std::endl;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // canonical binary serialization round trip: code lengths must survive,
+  // and the restored model must encode and decode consistently
+  std::cout << std::endl << "Checking canonical binary model round trip" << std::endl;
+  std::stringstream canonicalBuffer;
+  huffmanmodel.writeCanonical(canonicalBuffer);
+  std::cout << "canonical model size: " << canonicalBuffer.str().size() << " byte(s)" << std::endl;
+  HuffmanModel_t restoredmodel;
+  restoredmodel.init(0.);
+  if (restoredmodel.readCanonical(canonicalBuffer) < 0) {
+    std::cout << "failed to read canonical model" << std::endl;
+  }
+  Codec_t restoredcodec(restoredmodel);
+  for ( auto i : huffmanmodel) {
+    uint16_t codeLen = 0;
+    HuffmanModel_t::code_type code;
+    codec.Encode(i.first, code, codeLen);
+    uint16_t restoredLen = 0;
+    HuffmanModel_t::code_type restoredCode;
+    restoredcodec.Encode(i.first, restoredCode, restoredLen);
+    if (codeLen != restoredLen) {
+      std::cout << "mismatch in restored code length for value " << i.first
+                << ": " << restoredLen << ", expected " << codeLen << std::endl;
+    }
+    if (HuffmanModel_t::orderMSB) restoredCode <<= (restoredCode.size()-restoredLen);
+    uint16_t decodedLen = 0;
+    HuffmanModel_t::value_type value;
+    restoredcodec.Decode(value, restoredCode, decodedLen);
+    if (restoredLen != decodedLen || value != i.first) {
+      std::cout << "mismatch in canonically decoded value: " << value << "(" << decodedLen << ")" << std::endl;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // adaptive update: accumulate counters for a shifted distribution, merge
+  // them with an aging factor and check that the refreshed codes still
+  // decode consistently; a second update without new statistics must be
+  // a no-op
+  std::cout << std::endl << "Checking adaptive model update" << std::endl;
+  for (auto s : alphabet) {
+    // emphasize the upper half of the range to shift the distribution
+    huffmanmodel.count(s, (s > 1)? 100. : 1.);
+  }
+  int nChangedCodes = huffmanmodel.UpdateHuffmanTree(0.5);
+  std::cout << "code length changed for " << nChangedCodes << " symbol(s)" << std::endl;
+  for ( auto i : huffmanmodel) {
+    uint16_t codeLen = 0;
+    HuffmanModel_t::code_type code = huffmanmodel.Encode(i.first, codeLen);
+    if (HuffmanModel_t::orderMSB) code <<= (code.size()-codeLen);
+    uint16_t decodedLen = 0;
+    HuffmanModel_t::value_type value = huffmanmodel.Decode(code, decodedLen);
+    if (codeLen != decodedLen || value != i.first) {
+      std::cout << "mismatch in decoded value after update: " << value << "(" << decodedLen << ")" << std::endl;
+    }
+  }
+  if (huffmanmodel.UpdateHuffmanTree() != 0) {
+    std::cout << "error: update without new statistics must not change codes" << std::endl;
+  }
+  // note: the codec objects hold a copy of the model made before the
+  // update, the random test below runs on the original codes
+
   ////////////////////////////////////////////////////////////////////////////
   // test loop for random values
   //
@@ -0,0 +1,96 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   test_parallelblockcodec.cxx
+//  @author Matthias Richter
+//  @since  2016-09-15
+//  @brief  Test program for the block-parallel compression engine
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -I../include -pthread -o test_parallelblockcodec test_parallelblockcodec.cxx
+*/
+
+#include <iostream>
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include "DataCompression/dc_primitives.h"
+#include "DataCompression/HuffmanCodec.h"
+#include "DataCompression/CodingModelDispatcher.h"
+#include "DataCompression/ParallelBlockCodec.h"
+#include "DataGenerator.h"
+
+int main()
+{
+  typedef AliceO2::Test::normal_distribution<double> TestDistribution_t;
+  typedef AliceO2::Test::DataGenerator<int16_t, TestDistribution_t> DataGenerator_t;
+  DataGenerator_t dg(-7.5, 10.5, 1., 0., 1.);
+  typedef ContiguousAlphabet<DataGenerator_t::value_type, -7, 10> SimpleRangeAlphabet_t;
+
+  typedef AliceO2::HuffmanModel<
+    ProbabilityModel<SimpleRangeAlphabet_t>
+    , AliceO2::HuffmanNode<std::bitset<32> >
+    , true
+    > HuffmanModel_t;
+  typedef ALICE::O2::CodingModelDispatcher<HuffmanModel_t> Dispatcher_t;
+  Dispatcher_t dispatcher;
+  dispatcher.init();
+  SimpleRangeAlphabet_t alphabet;
+  for (auto s : alphabet) {
+    dispatcher.addWeight(s, dg.getProbability(s));
+  }
+  dispatcher.generate();
+
+  // blocks of different sizes, e.g. the clusters of individual padrows
+  const int nBlocks = 64;
+  std::vector<std::vector<DataGenerator_t::value_type>> blocks(nBlocks);
+  for (int block = 0; block < nBlocks; block++) {
+    int nValues = 500 + 37*block;
+    blocks[block].reserve(nValues);
+    for (int n = 0; n < nValues; n++) {
+      blocks[block].push_back(dg());
+    }
+  }
+
+  typedef ALICE::O2::ParallelBlockCodec<Dispatcher_t> Codec_t;
+  Codec_t codec(dispatcher);
+
+  std::vector<Codec_t::target_type> buffer;
+  std::vector<Codec_t::BlockDescriptor> descriptors;
+  int errors = 0;
+  if (codec.encode(blocks, buffer, descriptors, 4) != nBlocks) {
+    std::cout << "encoding failed" << std::endl;
+    ++errors;
+  }
+  std::cout << nBlocks << " block(s) compressed into " << buffer.size() << " byte(s)" << std::endl;
+
+  std::vector<std::vector<DataGenerator_t::value_type>> restored;
+  if (codec.decode(buffer, descriptors, restored, 4) != nBlocks) {
+    std::cout << "decoding failed" << std::endl;
+    ++errors;
+  }
+
+  for (int block = 0; block < nBlocks; block++) {
+    if (restored[block] != blocks[block]) {
+      std::cout << "mismatch in decoded block " << block << std::endl;
+      ++errors;
+    }
+  }
+
+  if (errors == 0) {
+    std::cout << "... all checks passed" << std::endl;
+  } else {
+    std::cout << "... " << errors << " error(s)" << std::endl;
+  }
+  return (errors == 0)? 0 : 1;
+}
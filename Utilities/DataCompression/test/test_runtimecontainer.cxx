@@ -0,0 +1,81 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   test_runtimecontainer.cxx
+//  @author Matthias Richter
+//  @since  2016-09-17
+//  @brief  Test program for the runtime container arena and table dispatch
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -I../include -o test_runtimecontainer test_runtimecontainer.cxx
+*/
+
+#include <iostream>
+#include <cstdint>
+#include <boost/mpl/vector.hpp>
+#include "DataCompression/runtime_container.h"
+
+int main()
+{
+  typedef boost::mpl::vector<int, double, unsigned int, short> types;
+  typedef gNeric::create_rtc<types, gNeric::RuntimeContainer<>>::type container_type;
+
+  int errors = 0;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // aligned arena placement of the container instance
+  gNeric::rc_arena<container_type> container;
+  if (reinterpret_cast<uintptr_t>(&*container) % decltype(container)::alignment != 0) {
+    std::cout << "container instance not aligned to " << decltype(container)::alignment << std::endl;
+    ++errors;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // set values through the recursive dispatch and read them back through
+  // the jump table dispatch, and vice versa
+  const int nLevels = boost::mpl::size<types>::value;
+  for (int level = 0; level < nLevels; level++) {
+    container->apply(level, gNeric::set_value<int>(10 + level));
+  }
+  for (int level = 0; level < nLevels; level++) {
+    int value = container->applyTable(level, gNeric::get_value<int>());
+    if (value != 10 + level) {
+      std::cout << "table dispatch mismatch at level " << level << ": " << value << std::endl;
+      ++errors;
+    }
+  }
+  for (int level = 0; level < nLevels; level++) {
+    container->applyTable(level, gNeric::add_value<int>(1));
+  }
+  for (int level = 0; level < nLevels; level++) {
+    int value = container->apply(level, gNeric::get_value<int>());
+    if (value != 11 + level) {
+      std::cout << "mismatch at level " << level << ": " << value << std::endl;
+      ++errors;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // out of bound position returns default value as the recursive loop does
+  if (container->applyTable(nLevels, gNeric::get_value<int>()) != 0) {
+    std::cout << "out of bound position not handled" << std::endl;
+    ++errors;
+  }
+
+  if (errors == 0) {
+    std::cout << "... all checks passed" << std::endl;
+  } else {
+    std::cout << "... " << errors << " error(s)" << std::endl;
+  }
+  return (errors == 0)? 0 : 1;
+}
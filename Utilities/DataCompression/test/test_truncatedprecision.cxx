@@ -0,0 +1,135 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or        *
+//* (at your option) any later version.                                      *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   test_truncatedprecision.cxx
+//  @author Matthias Richter
+//  @since  2016-09-17
+//  @brief  Test program for the truncated precision converter
+
+// Compilation: make sure variable BOOST_ROOT points to your boost installation
+/*
+   g++ --std=c++11 -g -ggdb -I$BOOST_ROOT/include -I../include -o test_truncatedprecision test_truncatedprecision.cxx
+*/
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include "DataCompression/TruncatedPrecisionConverter.h"
+
+/**
+ * A simple fixed point parameter model for the test: values are rounded to
+ * a fixed step and stored as unsigned multiples of the step in a fixed
+ * number of bits.
+ */
+class FixedPointModel {
+public:
+  FixedPointModel() {}
+
+  typedef float value_type;
+  static const uint8_t BitLength = 10;
+  static constexpr float Step = 0.25;
+
+  template<typename T, typename _RegType>
+  void Convert(T value, _RegType& content, uint8_t& bitlength) const {
+    float scaled = value/Step + 0.5;
+    if (scaled < 0.) scaled = 0.;
+    _RegType max = (_RegType(1) << BitLength) - 1;
+    content = _RegType(scaled);
+    if (content > max) content = max;
+    bitlength = BitLength;
+  }
+
+  template<typename _RegType>
+  value_type Restore(_RegType content) const {
+    return content*Step;
+  }
+
+  void Reset() {}
+};
+
+int main()
+{
+  int errors = 0;
+
+  typedef AliceO2::TruncatedPrecisionConverter<
+    FixedPointModel
+    , AliceO2::accumulated_error_statistics
+    > Converter_t;
+  Converter_t converter;
+
+  std::vector<float> values;
+  for (int n = 0; n < 10000; n++) {
+    values.push_back(0.01*n);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // per-value and batched conversion have to produce the identical
+  // sequence of (content, bitlength) pairs
+  std::vector<std::pair<uint32_t, uint8_t>> reference;
+  {
+    Converter_t singleConverter;
+    for (auto v : values) {
+      singleConverter.Write(v, uint32_t(0), [&](uint32_t content, uint8_t bitlength) -> int {
+          reference.push_back(std::make_pair(content, bitlength));
+          return bitlength;
+        });
+    }
+  }
+
+  std::vector<std::pair<uint32_t, uint8_t>> batched;
+  int count = converter.WriteBatch(values.data(), values.size(), uint32_t(0),
+                                   [&](uint32_t content, uint8_t bitlength) -> int {
+                                       batched.push_back(std::make_pair(content, bitlength));
+                                       return bitlength;
+                                     });
+  if (count != (int)values.size()) {
+    std::cout << "WriteBatch converted " << count << " value(s), expected " << values.size() << std::endl;
+    ++errors;
+  }
+  if (batched != reference) {
+    std::cout << "mismatch between batched and per-value conversion" << std::endl;
+    ++errors;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // the accumulated error of the rounding conversion is bounded by half
+  // the step size, and the mean over the uniform input is close to zero
+  const auto& statistics = converter.GetStatistics();
+  if (statistics.GetCount() != values.size()) {
+    std::cout << "statistics count " << statistics.GetCount() << ", expected " << values.size() << std::endl;
+    ++errors;
+  }
+  if (statistics.GetMaxAbs() > FixedPointModel::Step/2 + 1e-6) {
+    std::cout << "max abs error " << statistics.GetMaxAbs() << " exceeds half step size" << std::endl;
+    ++errors;
+  }
+  if (std::abs(statistics.GetMean()) > FixedPointModel::Step/10) {
+    std::cout << "mean error " << statistics.GetMean() << " not centered" << std::endl;
+    ++errors;
+  }
+  std::cout << statistics.GetCount() << " value(s) converted, mean error " << statistics.GetMean()
+            << ", RMS " << statistics.GetRMS() << ", max " << statistics.GetMaxAbs() << std::endl;
+
+  converter.ResetStatistics();
+  if (converter.GetStatistics().GetCount() != 0) {
+    std::cout << "statistics not reset" << std::endl;
+    ++errors;
+  }
+
+  if (errors == 0) {
+    std::cout << "... all checks passed" << std::endl;
+  } else {
+    std::cout << "... " << errors << " error(s)" << std::endl;
+  }
+  return (errors == 0)? 0 : 1;
+}
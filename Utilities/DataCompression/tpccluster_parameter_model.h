@@ -1,5 +1,6 @@
 #include "DataCompression/dc_primitives.h"
 #include "DataCompression/HuffmanCodec.h"
+#include "DataCompression/tpccluster_record.h"
 #include <bitset>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/string.hpp>
@@ -7,15 +8,19 @@
 /**
  * Parameter model definitions
  * - boost mpl vector of alphabets
+ *
+ * The bit widths are defined in tpccluster_record.h, shared with the packed
+ * cluster record stored by the cluster finder; a stored record is a valid
+ * symbol sequence of this model without requantization.
  */
 typedef boost::mpl::vector<
-  BitRangeContiguousAlphabet<uint16_t,  6 , boost::mpl::string < 'p','a','d','r','o','w' >    >,
-  BitRangeContiguousAlphabet<uint16_t, 14 , boost::mpl::string < 'p','a','d' >                >,
-  BitRangeContiguousAlphabet<uint16_t, 15 , boost::mpl::string < 't','i','m','e' >            >,
-  BitRangeContiguousAlphabet<uint16_t,  8 , boost::mpl::string < 's','i','g','m','a','Y','2' >>,
-  BitRangeContiguousAlphabet<uint16_t,  8 , boost::mpl::string < 's','i','g','m','a','Z','2' >>,
-  BitRangeContiguousAlphabet<uint16_t, 16 , boost::mpl::string < 'c','h','a','r','g','e' >    >,
-  BitRangeContiguousAlphabet<uint16_t, 10 , boost::mpl::string < 'q','m','a','x' >            >
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kPadRow , boost::mpl::string < 'p','a','d','r','o','w' >    >,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kPad    , boost::mpl::string < 'p','a','d' >                >,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kTime   , boost::mpl::string < 't','i','m','e' >            >,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kSigmaY2, boost::mpl::string < 's','i','g','m','a','Y','2' >>,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kSigmaZ2, boost::mpl::string < 's','i','g','m','a','Z','2' >>,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kCharge , boost::mpl::string < 'c','h','a','r','g','e' >    >,
+  BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kQMax   , boost::mpl::string < 'q','m','a','x' >            >
   > tpccluster_parameter;
 /**
  * Definition of Huffman probability models for the above defined alphabets
@@ -24,13 +29,13 @@ typedef boost::mpl::vector<
  * from the list of alphabet types, but did not manage so far (see below)
  */
 typedef boost::mpl::vector<
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t,  6 , boost::mpl::string < 'p','a','d','r','o','w' >    >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, 14 , boost::mpl::string < 'p','a','d' >                >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, 15 , boost::mpl::string < 't','i','m','e' >            >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t,  8 , boost::mpl::string < 's','i','g','m','a','Y','2' >>>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t,  8 , boost::mpl::string < 's','i','g','m','a','Z','2' >>>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, 16 , boost::mpl::string < 'c','h','a','r','g','e' >    >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
-  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, 10 , boost::mpl::string < 'q','m','a','x' >            >>, AliceO2::HuffmanNode<std::bitset<64>>, true>
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kPadRow , boost::mpl::string < 'p','a','d','r','o','w' >    >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kPad    , boost::mpl::string < 'p','a','d' >                >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kTime   , boost::mpl::string < 't','i','m','e' >            >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kSigmaY2, boost::mpl::string < 's','i','g','m','a','Y','2' >>>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kSigmaZ2, boost::mpl::string < 's','i','g','m','a','Z','2' >>>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kCharge , boost::mpl::string < 'c','h','a','r','g','e' >    >>, AliceO2::HuffmanNode<std::bitset<64>>, true>,
+  AliceO2::HuffmanModel<ProbabilityModel<BitRangeContiguousAlphabet<uint16_t, AliceO2::TPCClusterWidth::kQMax   , boost::mpl::string < 'q','m','a','x' >            >>, AliceO2::HuffmanNode<std::bitset<64>>, true>
   > tpccluster_parameter_models;
 
 /**
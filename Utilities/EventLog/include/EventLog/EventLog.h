@@ -0,0 +1,137 @@
+/// \file EventLog.h
+/// \brief Binary structured event log (flight recorder) for the flow devices
+///
+/// Devices running at production rates cannot afford per-event text logging:
+/// the formatting alone costs more than the event being logged, so the log
+/// statements get disabled and the visibility is lost with them. EventLog
+/// replaces them with fixed-size binary records (timestamp, device id, event
+/// type, value) appended to a memory-mapped ring file. The hot path does no
+/// formatting and no system calls - one atomic index increment and a 32 byte
+/// store into the mapping. The file survives a device crash (the kernel
+/// writes the dirty pages back), so the last kCapacity events before a
+/// throughput collapse can be inspected offline with the eventLogDump
+/// converter.
+
+#ifndef ALICEO2_DIAGNOSTICS_EVENTLOG_H_
+#define ALICEO2_DIAGNOSTICS_EVENTLOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace AliceO2 {
+namespace Diagnostics {
+
+/// One entry of the event log. Fixed 32 byte size (power of two, no record
+/// straddles a page boundary), written in host byte order.
+struct EventRecord {
+  uint64_t timestampNs; ///< CLOCK_REALTIME in nanoseconds
+  uint32_t deviceId; ///< Numeric id of the writing device (e.g. flp index)
+  uint32_t eventType; ///< Event type, meaning defined by the writing device
+  uint64_t value; ///< Event payload (e.g. timeframe id, duration, occupancy)
+  uint64_t reserved; ///< Padding, written as zero
+};
+
+static_assert(sizeof(EventRecord) == 32, "EventRecord must stay fixed-size");
+
+/// File layout: one page of header followed by capacity records. writeIndex
+/// counts records ever written; the ring wraps at writeIndex % capacity.
+struct EventLogFileHeader {
+  uint32_t magic; ///< "O2EL"
+  uint32_t version;
+  uint64_t capacity; ///< Number of record slots in the ring
+  uint64_t writeIndex; ///< Total number of records written so far
+  uint8_t reserved[4072]; ///< Pads the header to one page
+};
+
+static_assert(sizeof(EventLogFileHeader) == 4096, "header must fill one page");
+
+/// Writer side of the flight recorder.
+///
+/// Record() is safe to call from several threads of one process; concurrent
+/// writers to the same file from different processes are not supported (give
+/// each device its own file). When the ring is full the oldest records are
+/// overwritten - this is a flight recorder, not an archive.
+class EventLog
+{
+  public:
+    /// Default ring size: 2^20 records, a 32 MiB file
+    static constexpr uint64_t kDefaultCapacity = 1 << 20;
+    static constexpr uint32_t kMagic = 0x4c45324f; // "O2EL" on little endian
+    static constexpr uint32_t kVersion = 1;
+
+    EventLog();
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /// Creates (or truncates) the ring file and maps it. capacity is rounded
+    /// up to a power of two. Returns false when the file cannot be set up;
+    /// the log then stays closed and Record() is a no-op.
+    bool Open(const std::string& path, uint32_t deviceId, uint64_t capacity = kDefaultCapacity);
+
+    /// Unmaps and closes the file. The header keeps the final write index.
+    void Close();
+
+    bool IsOpen() const { return fRecords != nullptr; }
+
+    /// Appends one record (hot path). No-op when the log is not open.
+    void Record(uint32_t eventType, uint64_t value);
+
+    uint64_t GetRecordCount() const { return fWriteIndex.load(std::memory_order_relaxed); }
+    uint64_t GetCapacity() const { return fCapacity; }
+
+  private:
+    EventLogFileHeader* fHeader; ///< Start of the mapping
+    EventRecord* fRecords; ///< Ring of records, directly after the header
+    uint64_t fCapacity; ///< Number of record slots (power of two)
+    uint64_t fIndexMask; ///< fCapacity - 1
+    uint32_t fDeviceId; ///< Stamped into every record
+    int fFileDescriptor;
+    std::atomic<uint64_t> fWriteIndex; ///< Next record index, shared by the writing threads
+};
+
+/// Reader side, used by the offline converter and the tests. Maps the file
+/// read-only and exposes the surviving records oldest-first.
+class EventLogReader
+{
+  public:
+    EventLogReader();
+    ~EventLogReader();
+
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+
+    /// Maps an existing ring file. Returns false when the file is missing,
+    /// too short or carries a wrong magic/version.
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return fRecords != nullptr; }
+
+    uint64_t GetCapacity() const { return fCapacity; }
+    uint64_t GetWriteIndex() const { return fWriteIndex; }
+
+    /// Index of the oldest record still in the ring
+    uint64_t GetFirstIndex() const
+    {
+      return (fWriteIndex > fCapacity) ? fWriteIndex - fCapacity : 0;
+    }
+
+    /// Record number i, valid for i in [GetFirstIndex(), GetWriteIndex())
+    const EventRecord& At(uint64_t i) const { return fRecords[i & (fCapacity - 1)]; }
+
+  private:
+    const EventLogFileHeader* fHeader;
+    const EventRecord* fRecords;
+    uint64_t fCapacity;
+    uint64_t fWriteIndex; ///< Snapshot taken when the file was opened
+    int fFileDescriptor;
+    size_t fMappedSize;
+};
+
+} // namespace Diagnostics
+} // namespace AliceO2
+
+#endif
@@ -0,0 +1,68 @@
+/// \file eventLogDump.cxx
+/// \brief Offline converter for the binary event log ring files
+///
+/// Reads a flight recorder file written by Diagnostics::EventLog and prints
+/// the surviving records oldest-first as text, one line per record. The
+/// meaning of the event type and value columns is defined by the device that
+/// wrote the file (see e.g. FLP2EPNex_distributed/FlowEvents.h).
+///
+/// Usage: eventLogDump <file> [<file> ...]
+
+#include "EventLog/EventLog.h"
+
+#include <cstdio>
+#include <ctime>
+
+using namespace AliceO2::Diagnostics;
+
+namespace {
+
+int dumpFile(const char* path)
+{
+  EventLogReader reader;
+  if (!reader.Open(path)) {
+    fprintf(stderr, "error: cannot open '%s' as an event log ring file\n", path);
+    return 1;
+  }
+
+  uint64_t first = reader.GetFirstIndex();
+  uint64_t last = reader.GetWriteIndex();
+  printf("# %s: %llu record(s) written, ring capacity %llu, showing %llu\n",
+         path,
+         (unsigned long long)last,
+         (unsigned long long)reader.GetCapacity(),
+         (unsigned long long)(last - first));
+  printf("# %-10s %-30s %-8s %-10s %s\n", "index", "timestamp (UTC)", "device", "type", "value");
+
+  for (uint64_t i = first; i < last; ++i) {
+    const EventRecord& record = reader.At(i);
+    time_t seconds = record.timestampNs / 1000000000ull;
+    unsigned long nanoseconds = record.timestampNs % 1000000000ull;
+    tm utc = *gmtime(&seconds);
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &utc);
+
+    printf("%-12llu %s.%09lu %-8u %-10u %llu\n",
+           (unsigned long long)i, timestamp, nanoseconds,
+           record.deviceId, record.eventType,
+           (unsigned long long)record.value);
+  }
+
+  return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <file> [<file> ...]\n", argv[0]);
+    return 1;
+  }
+
+  int result = 0;
+  for (int i = 1; i < argc; ++i) {
+    result |= dumpFile(argv[i]);
+  }
+  return result;
+}
@@ -0,0 +1,200 @@
+/// \file EventLog.cxx
+/// \brief Implementation of the mmapped binary event log
+
+#include "EventLog/EventLog.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace AliceO2::Diagnostics;
+
+constexpr uint64_t EventLog::kDefaultCapacity;
+constexpr uint32_t EventLog::kMagic;
+constexpr uint32_t EventLog::kVersion;
+
+namespace {
+
+uint64_t roundUpToPowerOfTwo(uint64_t value)
+{
+  uint64_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+uint64_t nowNs()
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+} // anonymous namespace
+
+//__________________________________________________________________________________________________
+EventLog::EventLog()
+  : fHeader(nullptr)
+  , fRecords(nullptr)
+  , fCapacity(0)
+  , fIndexMask(0)
+  , fDeviceId(0)
+  , fFileDescriptor(-1)
+  , fWriteIndex(0)
+{
+}
+
+//__________________________________________________________________________________________________
+EventLog::~EventLog()
+{
+  Close();
+}
+
+//__________________________________________________________________________________________________
+bool EventLog::Open(const std::string& path, uint32_t deviceId, uint64_t capacity)
+{
+  Close();
+
+  fCapacity = roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity);
+  fIndexMask = fCapacity - 1;
+  fDeviceId = deviceId;
+
+  fFileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fFileDescriptor < 0) {
+    return false;
+  }
+
+  size_t fileSize = sizeof(EventLogFileHeader) + fCapacity * sizeof(EventRecord);
+  if (ftruncate(fFileDescriptor, fileSize) != 0) {
+    Close();
+    return false;
+  }
+
+  void* mapping = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fFileDescriptor, 0);
+  if (mapping == MAP_FAILED) {
+    Close();
+    return false;
+  }
+
+  fHeader = static_cast<EventLogFileHeader*>(mapping);
+  fHeader->magic = kMagic;
+  fHeader->version = kVersion;
+  fHeader->capacity = fCapacity;
+  fHeader->writeIndex = 0;
+  fRecords = reinterpret_cast<EventRecord*>(fHeader + 1);
+  fWriteIndex.store(0, std::memory_order_relaxed);
+
+  return true;
+}
+
+//__________________________________________________________________________________________________
+void EventLog::Close()
+{
+  if (fHeader != nullptr) {
+    fHeader->writeIndex = fWriteIndex.load(std::memory_order_relaxed);
+    munmap(fHeader, sizeof(EventLogFileHeader) + fCapacity * sizeof(EventRecord));
+    fHeader = nullptr;
+    fRecords = nullptr;
+  }
+  if (fFileDescriptor >= 0) {
+    close(fFileDescriptor);
+    fFileDescriptor = -1;
+  }
+}
+
+//__________________________________________________________________________________________________
+void EventLog::Record(uint32_t eventType, uint64_t value)
+{
+  if (fRecords == nullptr) {
+    return;
+  }
+
+  uint64_t index = fWriteIndex.fetch_add(1, std::memory_order_relaxed);
+  EventRecord& record = fRecords[index & fIndexMask];
+  record.timestampNs = nowNs();
+  record.deviceId = fDeviceId;
+  record.eventType = eventType;
+  record.value = value;
+  record.reserved = 0;
+
+  // plain store: the header index is only read offline, an aligned 8 byte
+  // store does not tear on the supported platforms and a racing writer only
+  // publishes a slightly older index
+  fHeader->writeIndex = index + 1;
+}
+
+//__________________________________________________________________________________________________
+EventLogReader::EventLogReader()
+  : fHeader(nullptr)
+  , fRecords(nullptr)
+  , fCapacity(0)
+  , fWriteIndex(0)
+  , fFileDescriptor(-1)
+  , fMappedSize(0)
+{
+}
+
+//__________________________________________________________________________________________________
+EventLogReader::~EventLogReader()
+{
+  Close();
+}
+
+//__________________________________________________________________________________________________
+bool EventLogReader::Open(const std::string& path)
+{
+  Close();
+
+  fFileDescriptor = open(path.c_str(), O_RDONLY);
+  if (fFileDescriptor < 0) {
+    return false;
+  }
+
+  struct stat fileInfo;
+  if (fstat(fFileDescriptor, &fileInfo) != 0
+      || static_cast<size_t>(fileInfo.st_size) < sizeof(EventLogFileHeader)) {
+    Close();
+    return false;
+  }
+  fMappedSize = fileInfo.st_size;
+
+  void* mapping = mmap(nullptr, fMappedSize, PROT_READ, MAP_SHARED, fFileDescriptor, 0);
+  if (mapping == MAP_FAILED) {
+    Close();
+    return false;
+  }
+  fHeader = static_cast<const EventLogFileHeader*>(mapping);
+
+  if (fHeader->magic != EventLog::kMagic || fHeader->version != EventLog::kVersion
+      || fHeader->capacity == 0 || (fHeader->capacity & (fHeader->capacity - 1)) != 0
+      || fMappedSize < sizeof(EventLogFileHeader) + fHeader->capacity * sizeof(EventRecord)) {
+    Close();
+    return false;
+  }
+
+  fCapacity = fHeader->capacity;
+  fWriteIndex = fHeader->writeIndex;
+  fRecords = reinterpret_cast<const EventRecord*>(fHeader + 1);
+
+  return true;
+}
+
+//__________________________________________________________________________________________________
+void EventLogReader::Close()
+{
+  if (fHeader != nullptr) {
+    munmap(const_cast<EventLogFileHeader*>(fHeader), fMappedSize);
+    fHeader = nullptr;
+    fRecords = nullptr;
+  }
+  if (fFileDescriptor >= 0) {
+    close(fFileDescriptor);
+    fFileDescriptor = -1;
+  }
+  fMappedSize = 0;
+}
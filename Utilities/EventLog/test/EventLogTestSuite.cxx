@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE Test Utilities EventLog
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "EventLog/EventLog.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AliceO2 {
+namespace Diagnostics {
+
+namespace {
+
+// scratch file removed at the end of each test case
+struct TempFile {
+  TempFile(const char* n) : name(n) {}
+  ~TempFile() { remove(name.c_str()); }
+  std::string name;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(writeAndReadBack_test)
+{
+  TempFile file{"test_eventlog_basic.bin"};
+
+  EventLog log;
+  BOOST_REQUIRE(log.Open(file.name, 42, 1024));
+  for (uint64_t i = 0; i < 100; ++i) {
+    log.Record(7, i);
+  }
+  BOOST_CHECK_EQUAL(log.GetRecordCount(), 100);
+  log.Close();
+
+  EventLogReader reader;
+  BOOST_REQUIRE(reader.Open(file.name));
+  BOOST_CHECK_EQUAL(reader.GetWriteIndex(), 100);
+  BOOST_CHECK_EQUAL(reader.GetFirstIndex(), 0);
+  for (uint64_t i = 0; i < 100; ++i) {
+    const EventRecord& record = reader.At(i);
+    BOOST_CHECK_EQUAL(record.deviceId, 42);
+    BOOST_CHECK_EQUAL(record.eventType, 7);
+    BOOST_CHECK_EQUAL(record.value, i);
+    BOOST_CHECK(record.timestampNs > 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ringWrapAround_test)
+{
+  TempFile file{"test_eventlog_wrap.bin"};
+
+  EventLog log;
+  // capacity is rounded up to a power of two
+  BOOST_REQUIRE(log.Open(file.name, 1, 100));
+  BOOST_CHECK_EQUAL(log.GetCapacity(), 128);
+
+  // overwrite the ring twice, only the newest 128 records survive
+  for (uint64_t i = 0; i < 300; ++i) {
+    log.Record(1, i);
+  }
+  log.Close();
+
+  EventLogReader reader;
+  BOOST_REQUIRE(reader.Open(file.name));
+  BOOST_CHECK_EQUAL(reader.GetWriteIndex(), 300);
+  BOOST_CHECK_EQUAL(reader.GetFirstIndex(), 300 - 128);
+  for (uint64_t i = reader.GetFirstIndex(); i < reader.GetWriteIndex(); ++i) {
+    BOOST_CHECK_EQUAL(reader.At(i).value, i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(closedLogIsNoop_test)
+{
+  EventLog log;
+  BOOST_CHECK(!log.IsOpen());
+  log.Record(1, 2); // must not crash
+  BOOST_CHECK_EQUAL(log.GetRecordCount(), 0);
+
+  EventLogReader reader;
+  BOOST_CHECK(!reader.Open("test_eventlog_does_not_exist.bin"));
+}
+
+BOOST_AUTO_TEST_CASE(rejectForeignFile_test)
+{
+  TempFile file{"test_eventlog_foreign.bin"};
+
+  FILE* f = fopen(file.name.c_str(), "wb");
+  BOOST_REQUIRE(f != nullptr);
+  std::vector<char> junk(8192, 'x');
+  fwrite(junk.data(), 1, junk.size(), f);
+  fclose(f);
+
+  EventLogReader reader;
+  BOOST_CHECK(!reader.Open(file.name));
+}
+
+BOOST_AUTO_TEST_CASE(multiThreadedRecording_test)
+{
+  TempFile file{"test_eventlog_threads.bin"};
+
+  EventLog log;
+  BOOST_REQUIRE(log.Open(file.name, 3, 4096));
+
+  const int numThreads = 4;
+  const uint64_t perThread = 500;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&log, t]() {
+      for (uint64_t i = 0; i < perThread; ++i) {
+        log.Record(t, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(log.GetRecordCount(), numThreads * perThread);
+  log.Close();
+
+  // every thread's records are all present
+  EventLogReader reader;
+  BOOST_REQUIRE(reader.Open(file.name));
+  std::vector<uint64_t> counts(numThreads, 0);
+  for (uint64_t i = reader.GetFirstIndex(); i < reader.GetWriteIndex(); ++i) {
+    counts.at(reader.At(i).eventType)++;
+  }
+  for (int t = 0; t < numThreads; ++t) {
+    BOOST_CHECK_EQUAL(counts[t], perThread);
+  }
+}
+
+} // namespace Diagnostics
+} // namespace AliceO2
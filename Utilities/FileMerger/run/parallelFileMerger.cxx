@@ -0,0 +1,62 @@
+/// \file parallelFileMerger.cxx
+/// \brief Command line front end of the ParallelMerger, a parallel hadd
+
+#include "FileMerger/ParallelMerger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <TStopwatch.h>
+
+static void usage(const char* name)
+{
+  printf("usage: %s [-j workers] [-n fan-in] [-d workdir] output.root input1.root [input2.root ...]\n", name);
+  printf("  -j workers   concurrent merge workers (default 4)\n");
+  printf("  -n fan-in    files combined per merge task (default 8)\n");
+  printf("  -d workdir   directory for the intermediate files (default: alongside the output)\n");
+}
+
+int main(int argc, char** argv)
+{
+  AliceO2::Utilities::ParallelMerger merger;
+  int argument = 1;
+  while (argument < argc && argv[argument][0] == '-') {
+    if (strcmp(argv[argument], "-j") == 0 && argument + 1 < argc) {
+      merger.setNumWorkers(atoi(argv[++argument]));
+    } else if (strcmp(argv[argument], "-n") == 0 && argument + 1 < argc) {
+      merger.setFanIn(atoi(argv[++argument]));
+    } else if (strcmp(argv[argument], "-d") == 0 && argument + 1 < argc) {
+      merger.setWorkingDirectory(argv[++argument]);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+    ++argument;
+  }
+  if (argc - argument < 2) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::string output = argv[argument++];
+  std::vector<std::string> inputs;
+  for (; argument < argc; ++argument) {
+    inputs.push_back(argv[argument]);
+  }
+
+  TStopwatch timer;
+  timer.Start();
+  bool ok = merger.merge(inputs, output);
+  timer.Stop();
+
+  if (!ok) {
+    printf("merge failed: %s\n", merger.getLastError().c_str());
+    return 1;
+  }
+  printf("merged %zu files into %s in %.1f s (%.1f s cpu)\n",
+         inputs.size(), output.c_str(), timer.RealTime(), timer.CpuTime());
+  return 0;
+}
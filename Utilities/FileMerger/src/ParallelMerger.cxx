@@ -0,0 +1,148 @@
+/// \file ParallelMerger.cxx
+/// \brief Implementation of the ParallelMerger class
+
+#include "FileMerger/ParallelMerger.h"
+
+#include <atomic>
+#include <cstdio> // remove
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <TFileMerger.h>
+#include <TROOT.h>
+
+using namespace AliceO2::Utilities;
+
+ParallelMerger::ParallelMerger()
+  : mNumWorkers(4),
+    mFanIn(8),
+    mWorkingDirectory(),
+    mOutput(),
+    mLastError()
+{
+}
+
+bool ParallelMerger::merge(const std::vector<std::string>& inputs, const std::string& output)
+{
+  mLastError.clear();
+  mOutput = output;
+  if (inputs.empty()) {
+    mLastError = "no input files";
+    return false;
+  }
+
+  // concurrent TFile handling needs the ROOT global state locked internally
+  ROOT::EnableThreadSafety();
+
+  std::vector<std::string> current = inputs;
+  std::vector<std::string> intermediates; // of the previous round, inputs of this one
+  bool failed = false;
+
+  for (int round = 0; current.size() > 1 || round == 0; ++round) {
+    // partition the current list into tasks of fan-in files; the last round
+    // (a single task) writes the output directly instead of an intermediate
+    struct Task {
+      std::vector<std::string> inputs;
+      std::string output;
+    };
+    std::vector<Task> tasks;
+    for (std::size_t first = 0; first < current.size(); first += mFanIn) {
+      std::size_t last = first + mFanIn < current.size() ? first + mFanIn : current.size();
+      Task task;
+      task.inputs.assign(current.begin() + first, current.begin() + last);
+      tasks.push_back(std::move(task));
+    }
+    bool finalRound = (tasks.size() == 1);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].output = finalRound ? mOutput : intermediateName(round, i);
+    }
+
+    // worker pool over the tasks of this round; rounds are barriers, the
+    // intermediates of round N are only read in round N+1
+    std::atomic<std::size_t> nextTask(0);
+    std::mutex errorMutex;
+    auto work = [&]() {
+      for (;;) {
+        std::size_t task = nextTask.fetch_add(1);
+        if (task >= tasks.size() || failed) {
+          return;
+        }
+        if (!mergeSubset(tasks[task].inputs, tasks[task].output)) {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (mLastError.empty()) {
+            mLastError = "merging into " + tasks[task].output + " failed";
+          }
+          failed = true;
+        }
+      }
+    };
+
+    std::size_t numThreads = mNumWorkers < static_cast<int>(tasks.size())
+      ? mNumWorkers : tasks.size();
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < numThreads; ++i) {
+      workers.emplace_back(work);
+    }
+    work(); // this thread is a worker too
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    // the inputs of this round are not needed anymore
+    for (const auto& intermediate : intermediates) {
+      std::remove(intermediate.c_str());
+    }
+    intermediates.clear();
+
+    if (failed) {
+      break;
+    }
+    current.clear();
+    for (auto& task : tasks) {
+      current.push_back(task.output);
+    }
+    if (finalRound) {
+      break;
+    }
+    intermediates = current;
+  }
+
+  for (const auto& intermediate : intermediates) {
+    std::remove(intermediate.c_str());
+  }
+  return !failed;
+}
+
+bool ParallelMerger::mergeSubset(const std::vector<std::string>& inputs, const std::string& output)
+{
+  // TFileMerger streams the content key by key: trees are fast-cloned
+  // branch by branch (basket copies, no deserialization), histograms and
+  // collections - including the TList sets of the QC dumps - go through
+  // their Merge methods. No input is held in memory as a whole
+  TFileMerger merger(kFALSE, kFALSE);
+  merger.SetPrintLevel(0);
+  if (!merger.OutputFile(output.c_str(), "RECREATE")) {
+    return false;
+  }
+  for (const auto& input : inputs) {
+    if (!merger.AddFile(input.c_str(), kFALSE)) {
+      return false;
+    }
+  }
+  return merger.Merge();
+}
+
+std::string ParallelMerger::intermediateName(int round, std::size_t index) const
+{
+  std::ostringstream name;
+  if (!mWorkingDirectory.empty()) {
+    std::size_t basename = mOutput.find_last_of('/');
+    name << mWorkingDirectory << '/'
+         << (basename == std::string::npos ? mOutput : mOutput.substr(basename + 1));
+  } else {
+    name << mOutput;
+  }
+  name << ".merge" << round << '_' << index << ".root";
+  return name.str();
+}
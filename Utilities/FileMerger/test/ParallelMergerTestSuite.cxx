@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE Test Utilities FileMerger
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "FileMerger/ParallelMerger.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <TFile.h>
+#include <TH1F.h>
+#include <TTree.h>
+
+namespace AliceO2 {
+namespace Utilities {
+
+namespace {
+
+// scratch files removed at the end of each test case
+struct TempFiles {
+  ~TempFiles()
+  {
+    for (const auto& name : names) {
+      remove(name.c_str());
+    }
+  }
+  std::string add(const std::string& name)
+  {
+    names.push_back(name);
+    return name;
+  }
+  std::vector<std::string> names;
+};
+
+// one per-job file: a histogram with `entries` fills and a tree with
+// `entries` events, as the simulation and QC outputs have
+void writeInputFile(const std::string& name, int entries)
+{
+  TFile file(name.c_str(), "RECREATE");
+  TH1F histogram("spectrum", "spectrum", 100, 0., 100.);
+  Float_t value = 0.;
+  TTree tree("events", "events");
+  tree.Branch("value", &value, "value/F");
+  for (int i = 0; i < entries; ++i) {
+    value = i % 100;
+    histogram.Fill(value);
+    tree.Fill();
+  }
+  histogram.Write();
+  tree.Write();
+  file.Close();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(treeMerge_test)
+{
+  TempFiles files;
+  std::vector<std::string> inputs;
+  int totalEntries = 0;
+  for (int i = 0; i < 5; ++i) {
+    std::ostringstream name;
+    name << "test_parallelmerger_in" << i << ".root";
+    inputs.push_back(files.add(name.str()));
+    writeInputFile(inputs.back(), 100 * (i + 1));
+    totalEntries += 100 * (i + 1);
+  }
+  std::string output = files.add("test_parallelmerger_out.root");
+
+  // fan-in 2 over 5 files forces several rounds with intermediates
+  ParallelMerger merger;
+  merger.setNumWorkers(2);
+  merger.setFanIn(2);
+  BOOST_REQUIRE_MESSAGE(merger.merge(inputs, output), merger.getLastError());
+
+  TFile result(output.c_str());
+  BOOST_REQUIRE(!result.IsZombie());
+  TH1F* histogram = static_cast<TH1F*>(result.Get("spectrum"));
+  BOOST_REQUIRE(histogram != nullptr);
+  BOOST_CHECK_EQUAL(static_cast<int>(histogram->GetEntries()), totalEntries);
+  TTree* tree = static_cast<TTree*>(result.Get("events"));
+  BOOST_REQUIRE(tree != nullptr);
+  BOOST_CHECK_EQUAL(static_cast<int>(tree->GetEntries()), totalEntries);
+}
+
+BOOST_AUTO_TEST_CASE(failure_test)
+{
+  TempFiles files;
+  std::string output = files.add("test_parallelmerger_fail.root");
+
+  ParallelMerger merger;
+  BOOST_CHECK(!merger.merge({}, output));
+  BOOST_CHECK(!merger.getLastError().empty());
+
+  // a missing input must fail the merge, not silently produce less data
+  std::string input = files.add("test_parallelmerger_present.root");
+  writeInputFile(input, 10);
+  BOOST_CHECK(!merger.merge({input, "test_parallelmerger_missing.root"}, output));
+}
+
+} // namespace Utilities
+} // namespace AliceO2
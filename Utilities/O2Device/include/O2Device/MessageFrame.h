@@ -0,0 +1,198 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @headerfile MessageFrame.h
+///
+/// Packing of many small header stack + payload pairs into one frame buffer
+/// shipped as a single message part. A FairMQ message per part costs more
+/// than the part itself once parts shrink below the MTU; a frame allocates
+/// once and amortizes the per-message overhead over the whole batch.
+///
+/// Frame layout (all fields host byte order, offsets from the frame start):
+///   [FrameHeader][pair data: header stack bytes, payload bytes, ...][entry table]
+/// The entry table of FrameEntry records sits at the end so building is one
+/// append-only pass; the header is written on finalize. Every pair is
+/// addressable through the table without walking the frame.
+///
+/// @author M. Krzewicki <mkrzewic@cern.ch>
+
+#ifndef MESSAGEFRAME_H_
+#define MESSAGEFRAME_H_
+
+#include "Headers/DataHeader.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace AliceO2 {
+namespace Base {
+
+/// fixed-size frame prologue, written when the frame is sealed
+struct FrameHeader {
+  static const uint32_t sMagic = 0x4f324652; // "O2FR"
+  static const uint32_t sVersion = 1;
+
+  uint32_t magic;       ///< sMagic
+  uint32_t version;     ///< sVersion
+  uint32_t pairCount;   ///< number of header+payload pairs in the frame
+  uint32_t tableOffset; ///< byte offset of the entry table, 4-byte aligned
+};
+
+/// one record of the entry table: where a pair sits within the frame
+struct FrameEntry {
+  uint32_t headerOffset;
+  uint32_t headerSize;
+  uint32_t payloadOffset;
+  uint32_t payloadSize;
+};
+
+static_assert(sizeof(FrameHeader) == 16 && sizeof(FrameEntry) == 16,
+              "frame structures must be packed");
+
+/// Appends header stack + payload pairs into a preallocated frame buffer.
+/// The buffer is allocated once (or recycled from a previous frame) and
+/// sealed with finalize; O2Device::AddFrame then ships it as a single
+/// message part. A pair that does not fit the remaining capacity is
+/// rejected without touching the frame, so the caller can seal, send and
+/// start the next frame.
+class FrameBuilder
+{
+public:
+  using Buffer = std::unique_ptr<byte[]>;
+
+  explicit FrameBuilder(size_t capacity)
+    : mCapacity{capacity}, mBuffer{new byte[capacity]}, mFill{sizeof(FrameHeader)}, mEntries{}, mFrameSize{0} {}
+
+  /// like above, recycling a preallocated buffer of the given capacity
+  FrameBuilder(Buffer buffer, size_t capacity)
+    : mCapacity{capacity}, mBuffer{std::move(buffer)}, mFill{sizeof(FrameHeader)}, mEntries{}, mFrameSize{0} {}
+
+  FrameBuilder(FrameBuilder&&) = default;
+  FrameBuilder& operator=(FrameBuilder&&) = default;
+  FrameBuilder(const FrameBuilder&) = delete;
+  FrameBuilder& operator=(const FrameBuilder&) = delete;
+
+  /// appends one pair; false when the pair plus its table entry does not fit
+  /// the remaining capacity (or the frame is already sealed), in which case
+  /// the frame is unchanged
+  bool addPair(const void* headerStack, size_t headerSize, const void* payload, size_t payloadSize) {
+    if (mFrameSize != 0) return false;
+    // the table lands 4-byte aligned after the pair data, reserve the
+    // worst-case padding along with the entries written so far
+    size_t needed = headerSize + payloadSize + 3 + (mEntries.size() + 1) * sizeof(FrameEntry);
+    if (mFill + needed > mCapacity) return false;
+
+    FrameEntry entry;
+    entry.headerOffset = mFill;
+    entry.headerSize = headerSize;
+    if (headerSize > 0) std::memcpy(mBuffer.get() + mFill, headerStack, headerSize);
+    mFill += headerSize;
+    entry.payloadOffset = mFill;
+    entry.payloadSize = payloadSize;
+    if (payloadSize > 0) std::memcpy(mBuffer.get() + mFill, payload, payloadSize);
+    mFill += payloadSize;
+    mEntries.push_back(entry);
+    return true;
+  }
+
+  /// convenience for a composed header block
+  bool addPair(const AliceO2::Header::Block& headerBlock, const void* payload, size_t payloadSize) {
+    return addPair(headerBlock.data(), headerBlock.size(), payload, payloadSize);
+  }
+
+  /// seals the frame: appends the entry table and writes the frame header;
+  /// returns the total frame size, 0 for an empty frame. Idempotent
+  size_t finalize() {
+    if (mFrameSize != 0) return mFrameSize;
+    if (mEntries.empty()) return 0;
+
+    mFill = (mFill + 3) & ~size_t(3);
+    FrameHeader header;
+    header.magic = FrameHeader::sMagic;
+    header.version = FrameHeader::sVersion;
+    header.pairCount = mEntries.size();
+    header.tableOffset = mFill;
+    std::memcpy(mBuffer.get(), &header, sizeof(header));
+    std::memcpy(mBuffer.get() + mFill, mEntries.data(), mEntries.size() * sizeof(FrameEntry));
+    mFrameSize = mFill + mEntries.size() * sizeof(FrameEntry);
+    return mFrameSize;
+  }
+
+  size_t getPairCount() const { return mEntries.size(); }
+  size_t getCapacity() const { return mCapacity; }
+  byte* data() const { return mBuffer.get(); }
+
+  /// hands the frame memory over (e.g. to the transport); the builder is
+  /// empty afterwards
+  byte* releaseBuffer() { return mBuffer.release(); }
+
+private:
+  size_t mCapacity;
+  Buffer mBuffer;
+  size_t mFill;
+  std::vector<FrameEntry> mEntries;
+  size_t mFrameSize;
+};
+
+/// Read access to a received frame. The whole frame (header, table and
+/// every entry) is bounds-checked on construction, so a malformed or
+/// truncated frame yields isValid() == false instead of out-of-range reads
+/// during iteration.
+class FrameReader
+{
+public:
+  FrameReader(const byte* frame, size_t frameSize)
+    : mFrame{frame}, mEntries{nullptr}, mPairCount{0} {
+    if (frame == nullptr || frameSize < sizeof(FrameHeader) + sizeof(FrameEntry)) return;
+
+    FrameHeader header;
+    std::memcpy(&header, frame, sizeof(header));
+    if (header.magic != FrameHeader::sMagic || header.version != FrameHeader::sVersion) return;
+    if (header.pairCount == 0 || (header.tableOffset & 3) != 0) return;
+    if (header.tableOffset < sizeof(FrameHeader)) return;
+    if (header.tableOffset + static_cast<uint64_t>(header.pairCount) * sizeof(FrameEntry) != frameSize) return;
+
+    const FrameEntry* entries = reinterpret_cast<const FrameEntry*>(frame + header.tableOffset);
+    for (uint32_t i = 0; i < header.pairCount; ++i) {
+      uint64_t headerEnd = entries[i].headerOffset + static_cast<uint64_t>(entries[i].headerSize);
+      uint64_t payloadEnd = entries[i].payloadOffset + static_cast<uint64_t>(entries[i].payloadSize);
+      if (entries[i].headerOffset < sizeof(FrameHeader) || headerEnd > header.tableOffset) return;
+      if (entries[i].payloadOffset < sizeof(FrameHeader) || payloadEnd > header.tableOffset) return;
+    }
+    mEntries = entries;
+    mPairCount = header.pairCount;
+  }
+
+  bool isValid() const { return mEntries != nullptr; }
+  size_t getPairCount() const { return mPairCount; }
+
+  /// buffers of the pair at index, same buf,len convention as O2Device::ForEach
+  bool getPair(size_t index, const byte*& headerBuffer, size_t& headerSize,
+               const byte*& payloadBuffer, size_t& payloadSize) const {
+    if (!isValid() || index >= mPairCount) return false;
+    headerBuffer = mFrame + mEntries[index].headerOffset;
+    headerSize = mEntries[index].headerSize;
+    payloadBuffer = mFrame + mEntries[index].payloadOffset;
+    payloadSize = mEntries[index].payloadSize;
+    return true;
+  }
+
+private:
+  const byte* mFrame;
+  const FrameEntry* mEntries;
+  size_t mPairCount;
+};
+
+}
+}
+#endif /* MESSAGEFRAME_H_ */
@@ -0,0 +1,57 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @headerfile NumaPolicy.h
+///
+/// @since 2016-11-08
+/// @author M. Krzewicki <mkrzewic@cern.ch>
+
+#ifndef O2DEVICE_NUMAPOLICY_H_
+#define O2DEVICE_NUMAPOLICY_H_
+
+namespace AliceO2 {
+namespace Base {
+
+/// NUMA placement helpers for devices running on multi-socket nodes.
+/// The topology is read from sysfs and policies are applied through raw
+/// syscalls, so there is no dependency on libnuma. On platforms without
+/// NUMA support (and on single-node machines) everything degrades to a
+/// cheap no-op.
+namespace Numa {
+
+/// number of online NUMA nodes, 1 when the topology is not exposed
+int getNumberOfNodes();
+
+/// pin the calling thread to the cpus of a node
+/// @return false when the node is unknown or the affinity call failed
+bool bindThreadToNode(int node);
+
+/// Scoped first-touch placement: while the guard is alive, memory pages
+/// faulted in by the calling thread are preferentially allocated on the
+/// given node. Wrap it around allocation and initialization of buffers
+/// which are consumed node-locally, e.g. when warming up a BlockPool.
+/// A node of -1 makes the guard a no-op.
+class ScopedMemoryPolicy {
+public:
+  ScopedMemoryPolicy(int node);
+  ~ScopedMemoryPolicy();
+  ScopedMemoryPolicy(const ScopedMemoryPolicy&) = delete;
+  ScopedMemoryPolicy& operator=(const ScopedMemoryPolicy&) = delete;
+
+private:
+  bool mEngaged;
+};
+
+}
+}
+}
+#endif /* O2DEVICE_NUMAPOLICY_H_ */
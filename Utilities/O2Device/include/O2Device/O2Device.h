@@ -20,7 +20,16 @@
 
 #include "FairMQDevice.h"
 #include "Headers/DataHeader.h"
+#include "MemoryArena/MemoryAccountant.h"
+#include "O2Device/MessageFrame.h"
+#include "O2Device/NumaPolicy.h"
+#include <cstring>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace AliceO2 {
 namespace Base {
@@ -29,12 +38,110 @@ namespace Base {
 /// it has to follow the O2 convention of header-payload-header-payload
 using O2Message = FairMQParts;
 
+/// A pool of fixed-size buffers for header blocks. Blocks composed through the
+/// pool reuse buffers handed back by the transport after sending (see the
+/// BlockPool overloads of AddMessage), so high-rate header construction stops
+/// hitting the allocator once the pool is warm.
+/// Buffers can optionally be placed on a NUMA node: fresh allocations are
+/// faulted in under a preferred-node memory policy, so a pool serving a
+/// channel stays local to the socket processing that channel.
+class BlockPool
+{
+public:
+  BlockPool(size_t bufferSize = 256, int numaNode = -1)
+    : mBufferSize{bufferSize}, mNumaNode{numaNode}, mMutex{}, mFree{} {}
+  BlockPool(const BlockPool&) = delete;
+  BlockPool& operator=(const BlockPool&) = delete;
+  ~BlockPool() {
+    if (mMemoryScopeId >= 0) {
+      Memory::MemoryAccountant::Instance().Add(
+        mMemoryScopeId, -(long long)(mBuffersAllocated * mBufferSize));
+    }
+    for (auto buffer : mFree) delete[] buffer;
+  }
+
+  /// compose a header block into a pooled buffer; headers larger than the pool
+  /// buffer size get their own allocation (which is safe to return to the pool,
+  /// recycled buffers are never smaller than the pool buffer size)
+  template <typename... Headers>
+  AliceO2::Header::Block compose(const Headers&... headers) {
+    return AliceO2::Header::Block::composeInto(acquire(), mBufferSize, headers...);
+  }
+
+  /// hand a sent buffer back to the pool, signature as required by FairMQ
+  static void freefn(void* data, void* hint) {
+    static_cast<BlockPool*>(hint)->release(static_cast<byte*>(data));
+  }
+
+  void release(byte* buffer) {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mFree.push_back(buffer);
+  }
+
+  size_t getBufferSize() const { return mBufferSize; }
+
+private:
+  AliceO2::Header::Block::Buffer acquire() {
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      if (!mFree.empty()) {
+        AliceO2::Header::Block::Buffer buffer{mFree.back()};
+        mFree.pop_back();
+        return buffer;
+      }
+    }
+    Numa::ScopedMemoryPolicy policy{mNumaNode};
+    AliceO2::Header::Block::Buffer buffer{new byte[mBufferSize]};
+    // fault the pages in while the policy is active so they land on the
+    // configured node (first touch); only fresh allocations pay for this
+    if (mNumaNode >= 0) memset(buffer.get(), 0, mBufferSize);
+    ++mBuffersAllocated;
+    // the pool footprint only grows with fresh allocations, recycled
+    // buffers are already accounted
+    if (Memory::MemoryAccountant::IsEnabled()) {
+      if (mMemoryScopeId < 0) {
+        mMemoryScopeId = Memory::MemoryAccountant::Instance().RegisterScope("O2Device/BlockPool");
+      }
+      Memory::MemoryAccountant::Instance().Add(mMemoryScopeId, mBufferSize);
+    }
+    return buffer;
+  }
+
+  size_t mBufferSize;
+  int mNumaNode;
+  std::mutex mMutex;
+  std::vector<byte*> mFree;
+  size_t mBuffersAllocated{0};
+  int mMemoryScopeId{-1};
+};
+
 class O2Device : public FairMQDevice
 {
 public:
   using FairMQDevice::FairMQDevice;
   virtual ~O2Device() {}
 
+  /// Declare the preferred NUMA node of a channel. Processing threads bind
+  /// to that node via BindThreadForChannel and pools for the channel can be
+  /// constructed with the same node, so the header-payload pairs of an
+  /// O2Message stay node-local end to end. Call before Run.
+  void SetChannelNumaNode(const std::string& channelName, int node) {
+    mChannelNumaNodes[channelName] = node;
+  }
+
+  /// preferred node of a channel, -1 when no policy was configured
+  int GetChannelNumaNode(const std::string& channelName) const {
+    auto policy = mChannelNumaNodes.find(channelName);
+    return (policy != mChannelNumaNodes.end()) ? policy->second : -1;
+  }
+
+  /// pin the calling thread to the preferred node of a channel; meant to be
+  /// called once at the start of a processing callback or conditional run
+  /// loop. A no-op returning false when no policy was configured.
+  bool BindThreadForChannel(const std::string& channelName) {
+    return Numa::bindThreadToNode(GetChannelNumaNode(channelName));
+  }
+
   /// Here is how to add an annotated data part (with header);
   /// @param[in,out] parts is a reference to the message;
   /// @param[] incomingBlock header block must be MOVED in (rvalue ref)
@@ -58,6 +165,76 @@ public:
     return true;
   }
 
+  /// Like AddMessage, for a header block composed from a BlockPool: the header
+  /// buffer goes back to the pool once the transport has sent it. The pool must
+  /// outlive the message
+  bool AddMessage(O2Message& parts,
+                  BlockPool& pool,
+                  AliceO2::Header::Block&& incomingBlock,
+                  FairMQMessagePtr incomingDataMessage) {
+
+    AliceO2::Header::Block headerBlock{std::move(incomingBlock)};
+    FairMQMessagePtr dataMessage{std::move(incomingDataMessage)};
+
+    FairMQMessagePtr headerMessage = NewMessage(headerBlock.buffer.get(),
+                                                headerBlock.bufferSize,
+                                                &BlockPool::freefn,
+                                                &pool);
+    headerBlock.buffer.release();
+
+    parts.AddPart(std::move(headerMessage));
+    parts.AddPart(std::move(dataMessage));
+    return true;
+  }
+
+  /// Batched AddMessage: appends many header+payload pairs in one pass,
+  /// pre-sizing the part vector so it is allocated once instead of growing
+  /// per part. (No span type is available yet, see the note at ForEach, so
+  /// the pairs are moved in as a vector.)
+  bool AddMessages(O2Message& parts,
+                   std::vector<std::pair<AliceO2::Header::Block, FairMQMessagePtr>>&& messages) {
+
+    parts.fParts.reserve(parts.Size() + 2 * messages.size());
+    for (auto& message : messages) {
+      AddMessage(parts, std::move(message.first), std::move(message.second));
+    }
+    return true;
+  }
+
+  /// Batched AddMessage for header blocks composed from a BlockPool
+  bool AddMessages(O2Message& parts,
+                   BlockPool& pool,
+                   std::vector<std::pair<AliceO2::Header::Block, FairMQMessagePtr>>&& messages) {
+
+    parts.fParts.reserve(parts.Size() + 2 * messages.size());
+    for (auto& message : messages) {
+      AddMessage(parts, pool, std::move(message.first), std::move(message.second));
+    }
+    return true;
+  }
+
+  /// Ships a sealed frame of many small header+payload pairs (see
+  /// MessageFrame.h) as a single message part: for sub-MTU parts this
+  /// replaces one FairMQ message per part with one per frame, so the
+  /// per-message overhead amortizes over the batch. The frame memory moves
+  /// to the transport without a copy; the receiver unpacks with FrameReader.
+  /// Note that a frame is one part, so such messages do not follow the
+  /// header-payload part convention consumed by ForEach
+  bool AddFrame(O2Message& parts, FrameBuilder&& incomingBuilder) {
+    FrameBuilder builder{std::move(incomingBuilder)};
+    size_t frameSize = builder.finalize();
+    if (frameSize == 0) return false;
+
+    FairMQMessagePtr frameMessage = NewMessage(builder.data(),
+                                               frameSize,
+                                               &AliceO2::Header::Block::freefn,
+                                               builder.data());
+    builder.releaseBuffer();
+
+    parts.AddPart(std::move(frameMessage));
+    return true;
+  }
+
   /// The user needs to define a member function with correct signature
   /// currently this is old school: buf,len pairs;
   /// In the end I'd like to move to array_view
@@ -90,6 +267,9 @@ public:
     }
     return true;
   }
+
+private:
+  std::map<std::string, int> mChannelNumaNodes;
 };
 
 }
@@ -0,0 +1,65 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @headerfile ThreadPlacement.h
+///
+/// @since 2016-11-08
+/// @author M. Krzewicki <mkrzewic@cern.ch>
+
+#ifndef O2DEVICE_THREADPLACEMENT_H_
+#define O2DEVICE_THREADPLACEMENT_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AliceO2 {
+namespace Base {
+
+/// Core placement of the named threads of a device. A placement spec names
+/// the thread roles of the device and the cpus each one is pinned to,
+///
+///   role:cpus[;role:cpus ...]   e.g.  poller:0-3;send:4,5;heartbeat:6
+///
+/// The spec is parsed once at device init and every thread applies its own
+/// role when it starts, so individual device threads can be placed without
+/// wrapping the whole process in taskset. Roles absent from the spec are
+/// left to the OS scheduler; on platforms without thread affinity apply()
+/// is a no-op reporting failure.
+class ThreadPlacement {
+public:
+  /// parse a placement spec, replacing the current one
+  /// @return false when the spec is malformed, the placement is then empty
+  bool parse(const std::string& spec);
+
+  /// whether the spec names the role
+  bool hasRole(const std::string& role) const;
+
+  /// pin the calling thread to the cpus of its role
+  /// @return false when the role is absent or the affinity call failed
+  bool apply(const std::string& role) const;
+
+  /// normalized "role=cpu,cpu,..." rendering of the placement, for echoing
+  /// the applied placement into the monitoring stream
+  std::string describe() const;
+
+  /// whether no placement was configured
+  bool empty() const { return mRoles.empty(); }
+
+private:
+  /// cpus of each role, in the spec order
+  std::vector<std::pair<std::string, std::vector<int>>> mRoles;
+};
+
+}
+}
+#endif /* O2DEVICE_THREADPLACEMENT_H_ */
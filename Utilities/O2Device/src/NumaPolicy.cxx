@@ -0,0 +1,129 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @file NumaPolicy.cxx
+///
+/// @since 2016-11-08
+/// @author M.Krzewicki <mkrzewic@cern.ch>
+
+#include "O2Device/NumaPolicy.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+// mode constants of the mempolicy syscalls as defined by the kernel ABI;
+// numaif.h belongs to libnuma which is not a dependency of this module
+constexpr int kMpolDefault = 0;
+constexpr int kMpolPreferred = 1;
+
+long setMemPolicy(int mode, const unsigned long* nodeMask, unsigned long maxNode)
+{
+  return syscall(SYS_set_mempolicy, mode, nodeMask, maxNode);
+}
+
+}
+#endif
+
+//__________________________________________________________________________________________________
+int AliceO2::Base::Numa::getNumberOfNodes()
+{
+#ifdef __linux__
+  FILE* online = fopen("/sys/devices/system/node/online", "r");
+  if (online) {
+    char buffer[256];
+    long last = 0;
+    if (fgets(buffer, sizeof(buffer), online)) {
+      // the list ("0-1", "0,2-3", ...) is sorted, the highest node id is the
+      // last number in it
+      for (char* cursor = buffer; *cursor; ++cursor) {
+        if (*cursor >= '0' && *cursor <= '9') last = strtol(cursor, &cursor, 10);
+        if (!*cursor) break;
+      }
+    }
+    fclose(online);
+    return (int)last + 1;
+  }
+#endif
+  return 1;
+}
+
+//__________________________________________________________________________________________________
+bool AliceO2::Base::Numa::bindThreadToNode(int node)
+{
+#ifdef __linux__
+  if (node < 0) return false;
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+  FILE* cpulist = fopen(path, "r");
+  if (cpulist == NULL) return false;
+  char buffer[1024];
+  bool haveList = fgets(buffer, sizeof(buffer), cpulist) != NULL;
+  fclose(cpulist);
+  if (!haveList) return false;
+
+  // parse the cpu list of the form "0-15,32-47" into an affinity mask
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  int nCpus = 0;
+  char* cursor = buffer;
+  while (*cursor) {
+    char* end = cursor;
+    long first = strtol(cursor, &end, 10);
+    if (end == cursor) break;
+    long last = first;
+    if (*end == '-') {
+      cursor = end + 1;
+      last = strtol(cursor, &end, 10);
+    }
+    for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+      CPU_SET(cpu, &cpuSet);
+      ++nCpus;
+    }
+    if (*end != ',') break;
+    cursor = end + 1;
+  }
+  if (nCpus == 0) return false;
+
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  (void)node;
+  return false;
+#endif
+}
+
+//__________________________________________________________________________________________________
+AliceO2::Base::Numa::ScopedMemoryPolicy::ScopedMemoryPolicy(int node)
+  : mEngaged{false}
+{
+#ifdef __linux__
+  if (node < 0 || node >= (int)(8 * sizeof(unsigned long))) return;
+  unsigned long nodeMask = 1UL << node;
+  mEngaged = setMemPolicy(kMpolPreferred, &nodeMask, 8 * sizeof(nodeMask)) == 0;
+#else
+  (void)node;
+#endif
+}
+
+//__________________________________________________________________________________________________
+AliceO2::Base::Numa::ScopedMemoryPolicy::~ScopedMemoryPolicy()
+{
+#ifdef __linux__
+  if (mEngaged) setMemPolicy(kMpolDefault, nullptr, 0);
+#endif
+}
@@ -0,0 +1,126 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @file ThreadPlacement.cxx
+///
+/// @since 2016-11-08
+/// @author M.Krzewicki <mkrzewic@cern.ch>
+
+#include "O2Device/ThreadPlacement.h"
+
+#include <cstdlib>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace AliceO2::Base;
+
+namespace {
+
+// parse a cpu list of the form "0-3,8" into cpu numbers; false when nothing
+// parses or the list is malformed
+bool parseCpuList(const std::string& list, std::vector<int>& cpus)
+{
+  const char* cursor = list.c_str();
+  while (*cursor) {
+    char* end = nullptr;
+    long first = strtol(cursor, &end, 10);
+    if (end == cursor || first < 0) return false;
+    long last = first;
+    if (*end == '-') {
+      cursor = end + 1;
+      last = strtol(cursor, &end, 10);
+      if (end == cursor || last < first) return false;
+    }
+    for (long cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back((int)cpu);
+    }
+    if (*end == '\0') break;
+    if (*end != ',') return false;
+    cursor = end + 1;
+  }
+  return !cpus.empty();
+}
+
+}
+
+//__________________________________________________________________________________________________
+bool ThreadPlacement::parse(const std::string& spec)
+{
+  mRoles.clear();
+  std::istringstream stream(spec);
+  std::string entry;
+  while (std::getline(stream, entry, ';')) {
+    size_t colon = entry.find(':');
+    if (colon == std::string::npos || colon == 0) {
+      mRoles.clear();
+      return false;
+    }
+    std::vector<int> cpus;
+    if (!parseCpuList(entry.substr(colon + 1), cpus)) {
+      mRoles.clear();
+      return false;
+    }
+    mRoles.emplace_back(entry.substr(0, colon), std::move(cpus));
+  }
+  return !mRoles.empty();
+}
+
+//__________________________________________________________________________________________________
+bool ThreadPlacement::hasRole(const std::string& role) const
+{
+  for (const auto& entry : mRoles) {
+    if (entry.first == role) return true;
+  }
+  return false;
+}
+
+//__________________________________________________________________________________________________
+bool ThreadPlacement::apply(const std::string& role) const
+{
+#ifdef __linux__
+  for (const auto& entry : mRoles) {
+    if (entry.first != role) continue;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    int nCpus = 0;
+    for (int cpu : entry.second) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpuSet);
+        ++nCpus;
+      }
+    }
+    if (nCpus == 0) return false;
+    return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+  }
+#else
+  (void)role;
+#endif
+  return false;
+}
+
+//__________________________________________________________________________________________________
+std::string ThreadPlacement::describe() const
+{
+  std::ostringstream out;
+  for (size_t i = 0; i < mRoles.size(); ++i) {
+    if (i > 0) out << " ";
+    out << mRoles[i].first << "=";
+    for (size_t c = 0; c < mRoles[i].second.size(); ++c) {
+      if (c > 0) out << ",";
+      out << mRoles[i].second[c];
+    }
+  }
+  return out.str();
+}
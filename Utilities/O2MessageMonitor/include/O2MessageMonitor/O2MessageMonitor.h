@@ -28,6 +28,13 @@
 /// it will appropriately send requests, send/receive messages or send replies.
 /// All incoming traffic is dumped on screen in the form of a hex dump for both
 /// the header block and payload block.
+///
+/// With --bench the device becomes a transport benchmark instead: it sweeps
+/// over the configured payload sizes, exchanging O2 messages (header-payload
+/// pairs, --bench-parts pairs per message) in a ping-pong with a peer running
+/// on a "rep" socket, and reports latency and throughput per configuration as
+/// CSV. Each configuration starts with a warm-up phase that is excluded from
+/// the measurement.
 class O2MessageMonitor : public AliceO2::Base::O2Device
 {
 public:
@@ -41,6 +48,13 @@ protected:
   bool HandleO2frame(const byte* headerBuffer, size_t headerBufferSize,
       const byte* dataBuffer,   size_t dataBufferSize);
 
+  /// benchmark client: payload size sweep with warm-up and CSV output
+  void RunBenchmark();
+  /// benchmark peer: echo every received message back to the sender
+  void RunEchoServer();
+  /// one ping-pong exchange with the given payload size per part
+  void ExchangeMessage(size_t payloadSize);
+
 private:
   AliceO2::Header::DataHeader mDataHeader;
   std::string mPayload;
@@ -48,6 +62,13 @@ private:
   long long mDelay;
   long long mIterations;
   long long mLimitOutputCharacters;
+
+  bool mBenchmark;
+  std::vector<size_t> mBenchSizes;     // payload sizes of the sweep in bytes
+  int mBenchParts;                     // header-payload pairs per message
+  long long mBenchWarmup;              // unmeasured iterations per configuration
+  long long mBenchIterations;          // measured iterations per configuration
+  std::string mBenchOutputFile;        // CSV output file, empty logs to screen
 };
 
 #endif /* O2MESSAGEMONITOR_H_ */
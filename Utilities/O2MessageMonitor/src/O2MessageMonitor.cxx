@@ -17,6 +17,11 @@
 
 #include <thread> // this_thread::sleep_for
 #include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
 
 #include "O2MessageMonitor/O2MessageMonitor.h"
 #include "FairMQProgOptions.h"
@@ -37,6 +42,12 @@ O2MessageMonitor::O2MessageMonitor()
   , mDelay(1000)
   , mIterations(10)
   , mLimitOutputCharacters(1024)
+  , mBenchmark(false)
+  , mBenchSizes()
+  , mBenchParts(1)
+  , mBenchWarmup(100)
+  , mBenchIterations(1000)
+  , mBenchOutputFile()
 {
   mDataHeader = gDataOriginAny;
   mDataHeader = gDataDescriptionInfo;
@@ -52,6 +63,25 @@ void O2MessageMonitor::InitTask()
   std::string tmp = fConfig->GetValue<std::string>("name");
   if (!tmp.empty()) mName = tmp;
   mLimitOutputCharacters = fConfig->GetValue<int>("limit");
+
+  mBenchmark = fConfig->GetValue<bool>("bench");
+  mBenchParts = fConfig->GetValue<int>("bench-parts");
+  mBenchWarmup = fConfig->GetValue<int>("bench-warmup");
+  mBenchIterations = fConfig->GetValue<int>("bench-iterations");
+  mBenchOutputFile = fConfig->GetValue<std::string>("bench-output");
+
+  mBenchSizes.clear();
+  std::stringstream sizeList(fConfig->GetValue<std::string>("bench-sizes"));
+  std::string token;
+  while (std::getline(sizeList, token, ',')) {
+    if (!token.empty()) {
+      mBenchSizes.push_back(std::stoul(token));
+    }
+  }
+  if (mBenchSizes.empty()) {
+    mBenchSizes.push_back(1024);
+  }
+  if (mBenchParts < 1) mBenchParts = 1;
 }
 
 //__________________________________________________________________________________________________
@@ -64,6 +94,15 @@ void O2MessageMonitor::Run()
     type = subChannels[0].GetType();
   }
 
+  if (mBenchmark) {
+    if (type=="rep") {
+      RunEchoServer();
+    } else {
+      RunBenchmark();
+    }
+    return;
+  }
+
   while (CheckCurrentState(RUNNING) && (--mIterations)!=0) {
     this_thread::sleep_for(chrono::milliseconds(mDelay));
 
@@ -91,6 +130,98 @@ void O2MessageMonitor::Run()
   }
 }
 
+//__________________________________________________________________________________________________
+void O2MessageMonitor::ExchangeMessage(size_t payloadSize)
+{
+  O2Message message;
+
+  mDataHeader.payloadSize = payloadSize;
+  for (int part = 0; part < mBenchParts; ++part) {
+    FairMQMessagePtr payload = NewMessage(payloadSize);
+    memset(payload->GetData(), 0xaa, payloadSize);
+    AddMessage(message, {mDataHeader}, std::move(payload));
+  }
+
+  Send(message, "data");
+  message.fParts.clear();
+
+  Receive(message, "data");
+  message.fParts.clear();
+}
+
+//__________________________________________________________________________________________________
+void O2MessageMonitor::RunBenchmark()
+{
+  std::ofstream csvFile;
+  if (!mBenchOutputFile.empty()) {
+    csvFile.open(mBenchOutputFile);
+  }
+
+  auto emitLine = [&](const std::string& line) {
+    if (csvFile.is_open()) {
+      csvFile << line << "\n";
+    } else {
+      LOG(INFO) << line;
+    }
+  };
+
+  emitLine("payload_bytes,parts,iterations,total_ms,msgs_per_s,mb_per_s,"
+           "lat_min_us,lat_avg_us,lat_p50_us,lat_p99_us,lat_max_us");
+
+  for (auto payloadSize : mBenchSizes) {
+    if (!CheckCurrentState(RUNNING)) break;
+
+    // warm-up: populates transport buffers and caches, not measured
+    for (long long i = 0; i < mBenchWarmup && CheckCurrentState(RUNNING); ++i) {
+      ExchangeMessage(payloadSize);
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(mBenchIterations);
+
+    auto sweepStart = std::chrono::high_resolution_clock::now();
+    for (long long i = 0; i < mBenchIterations && CheckCurrentState(RUNNING); ++i) {
+      auto t0 = std::chrono::high_resolution_clock::now();
+      ExchangeMessage(payloadSize);
+      auto t1 = std::chrono::high_resolution_clock::now();
+      latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    auto sweepEnd = std::chrono::high_resolution_clock::now();
+
+    if (latencies.empty()) break;
+
+    double totalMs = std::chrono::duration<double, std::milli>(sweepEnd - sweepStart).count();
+    double msgsPerSecond = latencies.size() / (totalMs / 1000.);
+    double mbPerSecond = msgsPerSecond * payloadSize * mBenchParts / 1000000.;
+
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0.;
+    for (auto latency : latencies) sum += latency;
+
+    std::stringstream line;
+    line << payloadSize << "," << mBenchParts << "," << latencies.size() << ","
+         << totalMs << "," << msgsPerSecond << "," << mbPerSecond << ","
+         << latencies.front() << "," << sum / latencies.size() << ","
+         << latencies[latencies.size() / 2] << ","
+         << latencies[(latencies.size() * 99) / 100] << ","
+         << latencies.back();
+    emitLine(line.str());
+  }
+}
+
+//__________________________________________________________________________________________________
+void O2MessageMonitor::RunEchoServer()
+{
+  while (CheckCurrentState(RUNNING)) {
+    O2Message message;
+    if (Receive(message, "data") < 0) {
+      continue;
+    }
+    Send(message, "data");
+    message.fParts.clear();
+  }
+}
+
 //__________________________________________________________________________________________________
 bool O2MessageMonitor::HandleO2frame(const byte* headerBuffer, size_t headerBufferSize,
     const byte* dataBuffer,   size_t dataBufferSize)
@@ -33,6 +33,24 @@ void addCustomOptions(bpo::options_description& options)
      default_value("I am the info payload"), "the info string in the payload");
   options.add_options()
     ("name",bpo::value<std::string>()->default_value(""), "optional name in the header");
+  options.add_options()
+    ("bench",bpo::value<bool>()->default_value(false),
+     "benchmark mode: payload size sweep against an echoing rep peer");
+  options.add_options()
+    ("bench-sizes",bpo::value<std::string>()->default_value("64,1024,65536,1048576"),
+     "comma separated payload sizes in bytes for the sweep");
+  options.add_options()
+    ("bench-parts",bpo::value<int>()->default_value(1),
+     "header-payload pairs per message");
+  options.add_options()
+    ("bench-warmup",bpo::value<int>()->default_value(100),
+     "unmeasured iterations per configuration");
+  options.add_options()
+    ("bench-iterations",bpo::value<int>()->default_value(1000),
+     "measured iterations per configuration");
+  options.add_options()
+    ("bench-output",bpo::value<std::string>()->default_value(""),
+     "CSV output file, empty logs the lines to screen");
 }
 
 FairMQDevicePtr getDevice(const FairMQProgOptions& /*config*/)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstring>
+
+#include <TH1.h>
+#include <THnSparse.h>
+
+/// Encoding of histogram deltas for the producer - merger link.
+///
+/// A delta carries only the bins changed since the last publication, stored
+/// in a one dimensional THnSparseF over the global bin index of the source
+/// histogram. THnSparse has a ROOT dictionary, so the delta travels through
+/// the existing TMessage serialization without any custom streamer. The
+/// publication cycle number is stored in the unique ID of the object, the
+/// merger uses it to detect lost deltas and to wait for the next full
+/// snapshot for resynchronization.
+///
+/// Note: the merger identifies deltas by the THnSparseT<TArrayF> class name,
+/// no producer publishes plain THnSparse objects.
+class HistogramDeltaCodec
+{
+public:
+    /// Encode the difference between current and previous publication.
+    /// Both histograms must have the same binning. Returns nullptr when a
+    /// delta is not beneficial (half or more of the bins changed), the
+    /// caller is expected to publish the full histogram instead.
+    static TObject* encodeDelta(const TH1* current, const TH1* previous, unsigned int cycle)
+    {
+        Int_t ncells = current->GetNcells();
+        Int_t changedBins = 0;
+
+        for (Int_t cell = 0; cell < ncells; ++cell) {
+            if (current->GetBinContent(cell) != previous->GetBinContent(cell)) {
+                ++changedBins;
+            }
+        }
+
+        if (2 * changedBins >= ncells) {
+            return nullptr;
+        }
+
+        Double_t axisMin = 0.;
+        Double_t axisMax = ncells;
+        THnSparseF* delta = new THnSparseF(current->GetName(), current->GetTitle(), 1, &ncells, &axisMin, &axisMax);
+
+        for (Int_t cell = 0; cell < ncells; ++cell) {
+            Double_t difference = current->GetBinContent(cell) - previous->GetBinContent(cell);
+            if (difference != 0.) {
+                Double_t coordinate = cell + 0.5;
+                delta->Fill(&coordinate, difference);
+            }
+        }
+
+        delta->SetEntries(current->GetEntries() - previous->GetEntries());
+        delta->SetUniqueID(cycle);
+
+        return delta;
+    }
+
+    /// Check whether a received object is an encoded delta.
+    static bool isDelta(const TObject* object)
+    {
+        return strcmp(object->ClassName(), "THnSparseT<TArrayF>") == 0;
+    }
+
+    /// Apply a delta to the accumulated histogram, returns false when the
+    /// binning of delta and accumulated histogram do not match.
+    static bool applyDelta(const THnSparseF* delta, TH1* accumulated)
+    {
+        if (delta->GetAxis(0)->GetNbins() != accumulated->GetNcells()) {
+            return false;
+        }
+
+        for (Long64_t sparseBin = 0; sparseBin < delta->GetNbins(); ++sparseBin) {
+            Int_t axisBin;
+            Double_t difference = delta->GetBinContent(sparseBin, &axisBin);
+            // axis bins are numbered from 1, cell b of the source histogram
+            // is stored in axis bin b + 1
+            Int_t cell = axisBin - 1;
+            accumulated->SetBinContent(cell, accumulated->GetBinContent(cell) + difference);
+        }
+
+        accumulated->SetEntries(accumulated->GetEntries() + delta->GetEntries());
+        return true;
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+#include <string>
+
+/// Framing of named QC object messages on the merger - viewer link.
+///
+/// The object name is only available inside the serialized TMessage buffer,
+/// so a consumer would have to deserialize every message just to learn which
+/// object it carries. A small header in front of the TMessage buffer makes
+/// the name available without any ROOT work:
+///
+///   uint32_t magic | uint32_t nameLength | name | TMessage buffer
+///
+/// Messages without the magic word are treated as bare TMessage buffers, so
+/// consumers stay compatible with senders that do not frame their messages.
+class NamedObjectMessage
+{
+public:
+    /// total message size for a payload published under the given name
+    static size_t messageSize(const std::string & name, size_t payloadSize)
+    {
+        return 2 * sizeof(uint32_t) + name.size() + payloadSize;
+    }
+
+    /// write header and payload into a buffer of at least messageSize bytes
+    static void pack(void* destination, const std::string & name, const void* payload, size_t payloadSize)
+    {
+        char* cursor = static_cast<char*>(destination);
+        uint32_t magicWord = magic();
+        uint32_t nameLength = name.size();
+
+        std::memcpy(cursor, &magicWord, sizeof(magicWord));
+        cursor += sizeof(magicWord);
+        std::memcpy(cursor, &nameLength, sizeof(nameLength));
+        cursor += sizeof(nameLength);
+        std::memcpy(cursor, name.data(), nameLength);
+        cursor += nameLength;
+        std::memcpy(cursor, payload, payloadSize);
+    }
+
+    /// check whether a received buffer starts with the frame header
+    static bool hasHeader(const void* buffer, size_t size)
+    {
+        if (buffer == nullptr || size < 2 * sizeof(uint32_t)) {
+            return false;
+        }
+        uint32_t magicWord = magic();
+        return std::memcmp(buffer, &magicWord, sizeof(magicWord)) == 0;
+    }
+
+    /// extract name and payload location from a framed buffer, returns the
+    /// pointer to the payload or nullptr when the buffer is malformed
+    static const void* unpack(const void* buffer, size_t size, std::string & name, size_t & payloadSize)
+    {
+        if (!hasHeader(buffer, size)) {
+            return nullptr;
+        }
+
+        const char* cursor = static_cast<const char*>(buffer) + sizeof(uint32_t);
+        uint32_t nameLength = 0;
+        std::memcpy(&nameLength, cursor, sizeof(nameLength));
+        cursor += sizeof(nameLength);
+
+        if (2 * sizeof(uint32_t) + nameLength > size) {
+            return nullptr;
+        }
+
+        name.assign(cursor, nameLength);
+        payloadSize = size - 2 * sizeof(uint32_t) - nameLength;
+
+        return cursor + nameLength;
+    }
+
+private:
+    static uint32_t magic() { return 0x314f4351; } // "QCO1"
+};
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TH3D.h>
+
+/// Shared memory histogram channel for same node QC chains.
+///
+/// Producers place the bin contents of their histograms directly into a
+/// shared memory segment organized as a registry of named, versioned slots;
+/// the merger maps the segment read-only and sums the slots in place into
+/// the merged histogram. No TMessage serialization happens on the same node
+/// hop, serialization remains only at node boundaries (merger to viewer).
+///
+/// Each slot is protected by a seqlock: the sequence counter is odd while
+/// the single writer of the slot updates it, readers retry when they observe
+/// an odd or changing sequence. The version counter increments with every
+/// publication, so the merger can skip unchanged slots.
+
+struct ShmHistogramSlot
+{
+  std::atomic<uint32_t> sequence; // odd while the slot is being written
+  uint32_t version;               // incremented on every publication
+  char name[96];                  // unique slot key: "<producerId>:<title>"
+  char title[96];                 // histogram title, the merge key
+  uint32_t dimension;             // 1, 2 or 3
+  uint32_t nbinsx;
+  uint32_t nbinsy;
+  uint32_t nbinsz;
+  double xlow, xup;
+  double ylow, yup;
+  double zlow, zup;
+  double entries;
+  uint32_t ncells;                // number of cells including under/overflow
+
+  double* content() { return reinterpret_cast<double*>(this + 1); }
+  const double* content() const { return reinterpret_cast<const double*>(this + 1); }
+};
+
+struct ShmSegmentHeader
+{
+  uint32_t magic;
+  uint32_t slotCount;
+  uint32_t slotSize;
+  std::atomic<uint32_t> usedSlots;
+};
+
+class ShmHistogramChannel
+{
+public:
+  static const uint32_t MAGIC = 0x31534351; // "QCS1"
+
+  /// writer end of the channel, one instance per producer
+  class Writer
+  {
+  public:
+    /// create or attach the segment; maxCells bounds the largest histogram
+    /// (number of cells including under/overflow) a slot can hold
+    Writer(const std::string & segmentName, const std::string & producerId,
+           const uint32_t slotCount = 64, const uint32_t maxCells = 1100000)
+      : mSegmentName(segmentName), mProducerId(producerId), mHeader(nullptr), mSize(0)
+    {
+      uint32_t slotSize = sizeof(ShmHistogramSlot) + maxCells * sizeof(double);
+      size_t segmentSize = sizeof(ShmSegmentHeader) + static_cast<size_t>(slotCount) * slotSize;
+
+      int fd = shm_open(mSegmentName.c_str(), O_CREAT | O_RDWR, 0666);
+      if (fd < 0) {
+        return;
+      }
+      if (ftruncate(fd, segmentSize) < 0) {
+        close(fd);
+        return;
+      }
+
+      void* mapped = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+      if (mapped == MAP_FAILED) {
+        return;
+      }
+
+      mHeader = static_cast<ShmSegmentHeader*>(mapped);
+      mSize = segmentSize;
+
+      if (mHeader->magic != MAGIC) {
+        // first writer initializes the registry
+        mHeader->slotCount = slotCount;
+        mHeader->slotSize = slotSize;
+        mHeader->usedSlots = 0;
+        mHeader->magic = MAGIC;
+      }
+    }
+
+    ~Writer()
+    {
+      if (mHeader != nullptr) {
+        munmap(mHeader, mSize);
+      }
+    }
+
+    bool isOpen() const { return mHeader != nullptr; }
+
+    /// publish the bin contents of a histogram into the slot of this
+    /// producer and title, allocating the slot on first publication
+    bool publish(const TH1* histogram)
+    {
+      if (mHeader == nullptr) {
+        return false;
+      }
+
+      std::string slotName = mProducerId + ":" + histogram->GetTitle();
+      ShmHistogramSlot* slot = findSlot(slotName);
+      if (slot == nullptr) {
+        slot = allocateSlot(slotName);
+      }
+      if (slot == nullptr) {
+        return false;
+      }
+
+      uint32_t ncells = histogram->GetNcells();
+      if (sizeof(ShmHistogramSlot) + ncells * sizeof(double) > mHeader->slotSize) {
+        return false;
+      }
+
+      uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+      slot->sequence.store(sequence + 1, std::memory_order_release); // odd: write in progress
+
+      std::strncpy(slot->title, histogram->GetTitle(), sizeof(slot->title) - 1);
+      slot->title[sizeof(slot->title) - 1] = '\0';
+      slot->dimension = histogram->GetDimension();
+      slot->nbinsx = histogram->GetNbinsX();
+      slot->nbinsy = histogram->GetNbinsY();
+      slot->nbinsz = histogram->GetNbinsZ();
+      slot->xlow = histogram->GetXaxis()->GetXmin();
+      slot->xup = histogram->GetXaxis()->GetXmax();
+      slot->ylow = histogram->GetYaxis()->GetXmin();
+      slot->yup = histogram->GetYaxis()->GetXmax();
+      slot->zlow = histogram->GetZaxis()->GetXmin();
+      slot->zup = histogram->GetZaxis()->GetXmax();
+      slot->entries = histogram->GetEntries();
+      slot->ncells = ncells;
+
+      double* content = slot->content();
+      for (uint32_t cell = 0; cell < ncells; ++cell) {
+        content[cell] = histogram->GetBinContent(cell);
+      }
+
+      ++slot->version;
+      slot->sequence.store(sequence + 2, std::memory_order_release); // even: consistent
+
+      return true;
+    }
+
+  private:
+    ShmHistogramSlot* findSlot(const std::string & slotName)
+    {
+      uint32_t used = mHeader->usedSlots.load(std::memory_order_acquire);
+      for (uint32_t ndx = 0; ndx < used; ++ndx) {
+        ShmHistogramSlot* slot = slotAt(mHeader, ndx);
+        if (std::strncmp(slot->name, slotName.c_str(), sizeof(slot->name)) == 0) {
+          return slot;
+        }
+      }
+      return nullptr;
+    }
+
+    ShmHistogramSlot* allocateSlot(const std::string & slotName)
+    {
+      uint32_t ndx = mHeader->usedSlots.fetch_add(1, std::memory_order_acq_rel);
+      if (ndx >= mHeader->slotCount) {
+        return nullptr;
+      }
+
+      ShmHistogramSlot* slot = slotAt(mHeader, ndx);
+      slot->sequence = 0;
+      slot->version = 0;
+      std::strncpy(slot->name, slotName.c_str(), sizeof(slot->name) - 1);
+      slot->name[sizeof(slot->name) - 1] = '\0';
+
+      return slot;
+    }
+
+    std::string mSegmentName;
+    std::string mProducerId;
+    ShmSegmentHeader* mHeader;
+    size_t mSize;
+  };
+
+  /// reader end of the channel, maps the segment read-only
+  class Reader
+  {
+  public:
+    Reader(const std::string & segmentName) : mHeader(nullptr), mSize(0)
+    {
+      int fd = shm_open(segmentName.c_str(), O_RDONLY, 0666);
+      if (fd < 0) {
+        return;
+      }
+
+      struct stat segmentStat;
+      if (fstat(fd, &segmentStat) < 0 || static_cast<size_t>(segmentStat.st_size) < sizeof(ShmSegmentHeader)) {
+        close(fd);
+        return;
+      }
+
+      void* mapped = mmap(nullptr, segmentStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (mapped == MAP_FAILED) {
+        return;
+      }
+
+      const ShmSegmentHeader* header = static_cast<const ShmSegmentHeader*>(mapped);
+      if (header->magic != MAGIC) {
+        munmap(mapped, segmentStat.st_size);
+        return;
+      }
+
+      mHeader = header;
+      mSize = segmentStat.st_size;
+    }
+
+    ~Reader()
+    {
+      if (mHeader != nullptr) {
+        munmap(const_cast<void*>(static_cast<const void*>(mHeader)), mSize);
+      }
+    }
+
+    bool isOpen() const { return mHeader != nullptr; }
+
+    /// distinct titles currently registered in the segment
+    std::vector<std::string> getTitles() const
+    {
+      std::vector<std::string> titles;
+      if (mHeader == nullptr) {
+        return titles;
+      }
+
+      uint32_t used = usedSlots();
+      for (uint32_t ndx = 0; ndx < used; ++ndx) {
+        const ShmHistogramSlot* slot = slotAt(mHeader, ndx);
+        if (slot->version == 0) {
+          continue;
+        }
+        std::string title = slot->title;
+        bool known = false;
+        for (auto const & existing : titles) {
+          if (existing == title) {
+            known = true;
+            break;
+          }
+        }
+        if (!known) {
+          titles.push_back(title);
+        }
+      }
+
+      return titles;
+    }
+
+    /// sum all slots of a title in place into one histogram; returns the
+    /// merged histogram and the sum of the slot versions, the caller owns
+    /// the returned object. nullptr when the title is unknown or no slot
+    /// could be read consistently.
+    TH1* mergeByTitle(const std::string & title, uint64_t & combinedVersion) const
+    {
+      combinedVersion = 0;
+      if (mHeader == nullptr) {
+        return nullptr;
+      }
+
+      TH1* merged = nullptr;
+      uint32_t used = usedSlots();
+
+      for (uint32_t ndx = 0; ndx < used; ++ndx) {
+        const ShmHistogramSlot* slot = slotAt(mHeader, ndx);
+        if (slot->version == 0 || title != slot->title) {
+          continue;
+        }
+
+        ShmHistogramSlot descriptor;
+        std::vector<double> content;
+        if (!readSlot(slot, descriptor, content)) {
+          continue;
+        }
+
+        if (merged == nullptr) {
+          merged = createHistogram(descriptor);
+          if (merged == nullptr) {
+            return nullptr;
+          }
+        }
+
+        if (static_cast<uint32_t>(merged->GetNcells()) != descriptor.ncells) {
+          continue;
+        }
+
+        for (uint32_t cell = 0; cell < descriptor.ncells; ++cell) {
+          merged->SetBinContent(cell, merged->GetBinContent(cell) + content[cell]);
+        }
+        merged->SetEntries(merged->GetEntries() + descriptor.entries);
+        combinedVersion += descriptor.version;
+      }
+
+      return merged;
+    }
+
+  private:
+    uint32_t usedSlots() const
+    {
+      uint32_t used = mHeader->usedSlots.load(std::memory_order_acquire);
+      return used < mHeader->slotCount ? used : mHeader->slotCount;
+    }
+
+    /// consistent snapshot of one slot via the seqlock, bounded retries
+    bool readSlot(const ShmHistogramSlot* slot, ShmHistogramSlot & descriptor, std::vector<double> & content) const
+    {
+      for (int attempt = 0; attempt < 16; ++attempt) {
+        uint32_t before = slot->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+          continue;
+        }
+
+        std::memcpy(&descriptor, slot, sizeof(ShmHistogramSlot));
+        if (descriptor.ncells * sizeof(double) + sizeof(ShmHistogramSlot) > mHeader->slotSize) {
+          return false;
+        }
+        content.assign(slot->content(), slot->content() + descriptor.ncells);
+
+        uint32_t after = slot->sequence.load(std::memory_order_acquire);
+        if (before == after) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    static TH1* createHistogram(const ShmHistogramSlot & descriptor)
+    {
+      switch (descriptor.dimension) {
+        case 1:
+          return new TH1D(descriptor.title, descriptor.title,
+                          descriptor.nbinsx, descriptor.xlow, descriptor.xup);
+        case 2:
+          return new TH2D(descriptor.title, descriptor.title,
+                          descriptor.nbinsx, descriptor.xlow, descriptor.xup,
+                          descriptor.nbinsy, descriptor.ylow, descriptor.yup);
+        case 3:
+          return new TH3D(descriptor.title, descriptor.title,
+                          descriptor.nbinsx, descriptor.xlow, descriptor.xup,
+                          descriptor.nbinsy, descriptor.ylow, descriptor.yup,
+                          descriptor.nbinsz, descriptor.zlow, descriptor.zup);
+      }
+      return nullptr;
+    }
+
+    const ShmSegmentHeader* mHeader;
+    size_t mSize;
+  };
+
+  /// remove the segment from the system, to be called once on teardown
+  static void unlinkSegment(const std::string & segmentName)
+  {
+    shm_unlink(segmentName.c_str());
+  }
+
+private:
+  static ShmHistogramSlot* slotAt(ShmSegmentHeader* header, uint32_t ndx)
+  {
+    char* base = reinterpret_cast<char*>(header + 1);
+    return reinterpret_cast<ShmHistogramSlot*>(base + static_cast<size_t>(ndx) * header->slotSize);
+  }
+
+  static const ShmHistogramSlot* slotAt(const ShmSegmentHeader* header, uint32_t ndx)
+  {
+    const char* base = reinterpret_cast<const char*>(header + 1);
+    return reinterpret_cast<const ShmHistogramSlot*>(base + static_cast<size_t>(ndx) * header->slotSize);
+  }
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <unordered_map>
+
+#include "Merger.h"
+
+/// per object merge time statistics, times in milliseconds
+struct ObjectMergeMetrics
+{
+  unsigned int mergeCount {0};
+  double totalMergeTime {0.};
+  double maxMergeTime {0.};
+};
+
+/// Pool of merge workers for the merger device.
+///
+/// Inbound objects are hashed by title onto a fixed worker, each worker owns
+/// a private Merger instance and maintains the partial merges of its titles.
+/// Because one title always ends up on the same worker, the merged object is
+/// already complete on publication and no cross worker combine step is
+/// needed. Merged objects are queued together with their merge time for the
+/// device thread; FairMQ channels are not thread safe, all sending stays on
+/// the device thread.
+class MergeWorkerPool
+{
+public:
+  MergeWorkerPool(const int numberOfWorkers, const int numberOfQCObjectsForCompleteData);
+  ~MergeWorkerPool();
+
+  void start();
+  void stop();
+
+  /// dispatch a received object to the worker responsible for its title
+  void push(TObject* object);
+
+  /// take one merged object ready for publication, returns nullptr when
+  /// none is available; mergeTime receives the merge time in milliseconds
+  TObject* popMergedObject(double & mergeTime);
+
+  /// snapshot of the per object merge time metrics, keyed by object title
+  std::unordered_map<std::string, ObjectMergeMetrics> getObjectMetrics() const;
+
+private:
+  struct Worker
+  {
+    std::unique_ptr<Merger> merger;
+    std::queue<TObject*> inputQueue;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::thread thread;
+  };
+
+  void workerLoop(Worker & worker);
+  void recordMergedObject(const std::string & title, TObject* mergedObject, double mergeTime);
+
+  std::vector<std::unique_ptr<Worker>> mWorkers;
+  std::atomic<bool> mRunning;
+
+  std::queue<std::pair<TObject*, double>> mMergedObjects;
+  mutable std::mutex mMergedMutex;
+
+  std::unordered_map<std::string, ObjectMergeMetrics> mObjectMetrics;
+  mutable std::mutex mMetricsMutex;
+};
@@ -5,6 +5,8 @@
 
 #include <TList.h>
 
+class TH1;
+
 typedef std::unordered_map<std::string, TList*> TCollectionMap;
 
 class Merger
@@ -18,9 +20,19 @@ public:
   double getMergeTime();
   void dumpObjectsCollectionToFile(const char* title);
   void eraseCollection(const char* title);
+  int getNumberOfObjectsForCompleteData() const { return NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA; }
 
 private:
+  /// apply a received delta into the accumulated histogram of its title,
+  /// returns a copy of the updated histogram or nullptr when the delta
+  /// cannot be applied and a full snapshot is awaited
+  TObject* applyDeltaToAccumulatedObject(TObject* delta);
+  /// keep a merged full snapshot as the base for subsequent deltas
+  void updateAccumulatedObject(TObject* mergedObject);
+
   TCollectionMap mTitlesToDataObjectsMap;
+  std::unordered_map<std::string, TH1*> mAccumulatedObjectsMap;
+  std::unordered_map<std::string, unsigned int> mExpectedDeltaCycle;
   std::chrono::microseconds mMergeTime {0};
   unsigned int mNumberOfDumpedObjects {0};
   const int NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA;
@@ -14,11 +14,17 @@
 #include <dds_intercom.h>
 
 #include "Merger.h"
+#include "MergeWorkerPool.h"
+#include "QCCommon/ShmHistogramChannel.h"
 
 class MergerDevice : public FairMQDevice
 {
 public:
-  MergerDevice(std::unique_ptr<Merger> merger, std::string producerId, int numIoThreads);
+  /// With mergeThreads > 0 inbound objects are dispatched to a pool of merge
+  /// workers, hashed by title, and the device thread only receives,
+  /// publishes and collects per object merge time metrics. With the default
+  /// of 0 all objects are merged on the device thread as before.
+  MergerDevice(std::unique_ptr<Merger> merger, std::string producerId, int numIoThreads, const int mergeThreads = 0);
   virtual ~MergerDevice();
 
   static void deleteTMessage(void* data, void* hint);
@@ -30,6 +36,13 @@ public:
                         int sendBuffer);
   void executeRunLoop();
 
+  /// Merge histograms published by same node producers through the shared
+  /// memory segment: the slots are mapped read-only and summed in place,
+  /// serialization happens only towards the viewer. Titles are published
+  /// when any of their slots changed since the last check, at most every
+  /// checkIntervalMs milliseconds.
+  void enableShmChannel(const std::string & segmentName, const int checkIntervalMs = 1000);
+
 protected:
   virtual void Run() override;
 
@@ -41,6 +54,10 @@ private:
   boost::property_tree::ptree createGetMetricsResponse(const boost::property_tree::ptree & request);
 
   void handleReceivedDataObject();
+  /// publish the merged objects queued by the merge workers
+  void drainMergedObjects();
+  /// publish shared memory titles whose slots changed since the last check
+  void checkShmUpdates();
   TObject* receiveDataObjectFromProducer();
   TMessage* createTMessageForViewer(const TObject * objectToSend) const;
   size_t sendMergedObjectToViewer(TObject * dataObject);
@@ -50,10 +67,17 @@ private:
   double calculateAvgMegreTime();
   std::string calculateCpuUsage();
   double calculateNumberOfMergedObjectsPerSecond();
-  void updateMetrics();
+  void updateMetrics(double mergeTime);
   inline bool isObjectNotEmpty(const TObject * object) const;
 
   std::unique_ptr<Merger> mMerger;
+  std::unique_ptr<MergeWorkerPool> mMergeWorkerPool;
+
+  std::unique_ptr<ShmHistogramChannel::Reader> mShmReader;
+  std::string mShmSegmentName;
+  int mShmCheckIntervalMs {1000};
+  std::chrono::high_resolution_clock::time_point mLastShmCheckTime;
+  std::unordered_map<std::string, uint64_t> mShmPublishedVersions;
   dds::intercom_api::CIntercomService mService;
   std::unique_ptr<dds::intercom_api::CCustomCmd> ddsCustomCmd;
   std::deque<double> mMergeTimes;
@@ -0,0 +1,127 @@
+#include <functional>
+
+#include "QCMerger/MergeWorkerPool.h"
+
+using namespace std;
+
+MergeWorkerPool::MergeWorkerPool(const int numberOfWorkers, const int numberOfQCObjectsForCompleteData)
+  : mRunning(false)
+{
+  int workerCount = numberOfWorkers > 0 ? numberOfWorkers : 1;
+
+  for (int i = 0; i < workerCount; ++i) {
+    mWorkers.emplace_back(new Worker());
+    mWorkers.back()->merger.reset(new Merger(numberOfQCObjectsForCompleteData));
+  }
+}
+
+MergeWorkerPool::~MergeWorkerPool()
+{
+  if (mRunning) {
+    stop();
+  }
+
+  lock_guard<mutex> lock(mMergedMutex);
+  while (!mMergedObjects.empty()) {
+    delete mMergedObjects.front().first;
+    mMergedObjects.pop();
+  }
+}
+
+void MergeWorkerPool::start()
+{
+  mRunning = true;
+  for (auto & worker : mWorkers) {
+    worker->thread = thread(&MergeWorkerPool::workerLoop, this, ref(*worker));
+  }
+}
+
+void MergeWorkerPool::stop()
+{
+  mRunning = false;
+  for (auto & worker : mWorkers) {
+    {
+      // synchronize with the predicate check in workerLoop
+      lock_guard<mutex> lock(worker->queueMutex);
+    }
+    worker->queueCondition.notify_one();
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+void MergeWorkerPool::push(TObject* object)
+{
+  size_t workerNdx = hash<string>()(object->GetTitle()) % mWorkers.size();
+  Worker & worker = *mWorkers[workerNdx];
+
+  {
+    lock_guard<mutex> lock(worker.queueMutex);
+    worker.inputQueue.push(object);
+  }
+  worker.queueCondition.notify_one();
+}
+
+TObject* MergeWorkerPool::popMergedObject(double & mergeTime)
+{
+  lock_guard<mutex> lock(mMergedMutex);
+
+  if (mMergedObjects.empty()) {
+    return nullptr;
+  }
+
+  TObject* mergedObject = mMergedObjects.front().first;
+  mergeTime = mMergedObjects.front().second;
+  mMergedObjects.pop();
+
+  return mergedObject;
+}
+
+unordered_map<string, ObjectMergeMetrics> MergeWorkerPool::getObjectMetrics() const
+{
+  lock_guard<mutex> lock(mMetricsMutex);
+  return mObjectMetrics;
+}
+
+void MergeWorkerPool::workerLoop(Worker & worker)
+{
+  while (true) {
+    TObject* object = nullptr;
+    {
+      unique_lock<mutex> lock(worker.queueMutex);
+      worker.queueCondition.wait(lock, [this, &worker] { return !worker.inputQueue.empty() || !mRunning; });
+      if (worker.inputQueue.empty()) {
+        // queue drained and stop requested
+        break;
+      }
+      object = worker.inputQueue.front();
+      worker.inputQueue.pop();
+    }
+
+    // the object may be consumed by the merger, the title is needed for the
+    // metrics afterwards
+    const string title = object->GetTitle();
+    TObject* mergedObject = worker.merger->mergeObject(object);
+
+    if (mergedObject != nullptr) {
+      recordMergedObject(title, mergedObject, worker.merger->getMergeTime());
+    }
+  }
+}
+
+void MergeWorkerPool::recordMergedObject(const string & title, TObject* mergedObject, double mergeTime)
+{
+  {
+    lock_guard<mutex> lock(mMetricsMutex);
+    ObjectMergeMetrics & metrics = mObjectMetrics[title];
+    ++metrics.mergeCount;
+    metrics.totalMergeTime += mergeTime;
+    if (mergeTime > metrics.maxMergeTime) {
+      metrics.maxMergeTime = mergeTime;
+    }
+  }
+
+  lock_guard<mutex> lock(mMergedMutex);
+  mMergedObjects.push(make_pair(mergedObject, mergeTime));
+}
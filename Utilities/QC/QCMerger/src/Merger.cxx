@@ -6,6 +6,7 @@
 #include <THn.h>
 #include <TTree.h>
 
+#include "QCCommon/HistogramDeltaCodec.h"
 #include "QCMerger/Merger.h"
 
 using namespace std;
@@ -17,11 +18,16 @@ Merger::Merger (const int numberOfQCOgbjectForCompleteData) : NUMBER_OF_QC_OBJEC
 
 TObject* Merger::mergeObject(TObject* object)
 {
+  if (HistogramDeltaCodec::isDelta(object)) {
+    return applyDeltaToAccumulatedObject(object);
+  }
+
   auto foundEntry = mTitlesToDataObjectsMap.find(object->GetTitle());
 
   if (foundEntry != mTitlesToDataObjectsMap.end() && foundEntry->second->GetSize() >= NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA - 1 ) {
     TObject * output = mergeObjectWithGivenCollection(object);
     eraseCollection(object->GetTitle());
+    updateAccumulatedObject(output);
     return output;
   }  else {
     addReceivedObjectToMapByName(object);
@@ -29,6 +35,60 @@ TObject* Merger::mergeObject(TObject* object)
   }
 }
 
+TObject* Merger::applyDeltaToAccumulatedObject(TObject* delta)
+{
+  const char* title = delta->GetTitle();
+  auto foundAccumulated = mAccumulatedObjectsMap.find(title);
+
+  if (foundAccumulated == mAccumulatedObjectsMap.end()) {
+    LOG(DEBUG) << "Received delta for " << title << " without accumulated base, waiting for full snapshot.";
+    delete delta;
+    return nullptr;
+  }
+
+  if (delta->GetUniqueID() != mExpectedDeltaCycle[title]) {
+    LOG(ERROR) << "Delta cycle mismatch for " << title << ": expected " << mExpectedDeltaCycle[title]
+               << ", received " << delta->GetUniqueID() << ". Waiting for full snapshot to resynchronize.";
+    delete foundAccumulated->second;
+    mAccumulatedObjectsMap.erase(foundAccumulated);
+    delete delta;
+    return nullptr;
+  }
+
+  auto measureTime = chrono::high_resolution_clock::now();
+
+  if (!HistogramDeltaCodec::applyDelta(reinterpret_cast<THnSparseF*>(delta), foundAccumulated->second)) {
+    LOG(ERROR) << "Delta for " << title << " does not match the binning of the accumulated histogram.";
+    delete foundAccumulated->second;
+    mAccumulatedObjectsMap.erase(foundAccumulated);
+    delete delta;
+    return nullptr;
+  }
+
+  mMergeTime = chrono::duration_cast<std::chrono::microseconds>(chrono::high_resolution_clock::now() - measureTime);
+
+  ++mExpectedDeltaCycle[title];
+  delete delta;
+
+  return foundAccumulated->second->Clone();
+}
+
+void Merger::updateAccumulatedObject(TObject* mergedObject)
+{
+  if (!mergedObject->InheritsFrom("TH1")) {
+    return;
+  }
+
+  auto foundAccumulated = mAccumulatedObjectsMap.find(mergedObject->GetTitle());
+  if (foundAccumulated != mAccumulatedObjectsMap.end()) {
+    delete foundAccumulated->second;
+    mAccumulatedObjectsMap.erase(foundAccumulated);
+  }
+
+  mAccumulatedObjectsMap[mergedObject->GetTitle()] = reinterpret_cast<TH1*>(mergedObject->Clone());
+  mExpectedDeltaCycle[mergedObject->GetTitle()] = mergedObject->GetUniqueID() + 1;
+}
+
 void Merger::addReceivedObjectToMapByName(TObject* receivedObject)
 {
   auto foundList = mTitlesToDataObjectsMap.find(receivedObject->GetTitle());
@@ -120,4 +180,7 @@ Merger::~Merger()
   for (auto const & entry : mTitlesToDataObjectsMap) {
     entry.second->Delete();
   }
+  for (auto const & entry : mAccumulatedObjectsMap) {
+    delete entry.second;
+  }
 }
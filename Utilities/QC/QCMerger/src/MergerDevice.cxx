@@ -10,7 +10,9 @@
 
 #include <dds_intercom.h>
 
+#include "MemoryArena/MemoryAccountant.h"
 #include "QCMerger/MergerDevice.h"
+#include "QCCommon/NamedObjectMessage.h"
 #include "QCCommon/TMessageWrapper.h"
 
 using namespace std;
@@ -19,12 +21,16 @@ using namespace boost::property_tree;
 using namespace dds;
 using namespace dds::intercom_api;
 
-MergerDevice::MergerDevice(unique_ptr<Merger> merger, string mergerId, int numIoThreads) : mMerger(move(merger)), ddsCustomCmd(new CCustomCmd(mService))
+MergerDevice::MergerDevice(unique_ptr<Merger> merger, string mergerId, int numIoThreads, const int mergeThreads) : mMerger(move(merger)), ddsCustomCmd(new CCustomCmd(mService))
 {
   this->SetTransport(new FairMQTransportFactoryZMQ);
   this->SetProperty(Id, mergerId);
   this->SetProperty(NumIoThreads, numIoThreads);
 
+  if (mergeThreads > 0) {
+    mMergeWorkerPool.reset(new MergeWorkerPool(mergeThreads, mMerger->getNumberOfObjectsForCompleteData()));
+  }
+
   procSelfStatus.open("/proc/self/status");
 
   calculateCpuUsage();
@@ -149,6 +155,36 @@ boost::property_tree::ptree MergerDevice::createGetMetricsResponse(const ptree &
   response.put("cpu_clock", calculateCpuUsage());
   response.put("merged_objects_per_second", calculateNumberOfMergedObjectsPerSecond());
 
+  if (AliceO2::Memory::MemoryAccountant::IsEnabled()) {
+    auto & accountant = AliceO2::Memory::MemoryAccountant::Instance();
+    response.put("accounted_memory_total", accountant.GetTotalBytes());
+
+    // per-container byte counts and high-water marks, so RSS growth can be
+    // attributed to a subsystem instead of the process as a whole
+    ptree memoryScopes;
+    for (auto const & stats : accountant.GetStats()) {
+      ptree scopeNode;
+      scopeNode.put("bytes", stats.bytes);
+      scopeNode.put("high_water", stats.highWater);
+      memoryScopes.push_back(make_pair(stats.name, scopeNode));
+    }
+    response.add_child("memory_accounting", memoryScopes);
+  }
+
+  if (mMergeWorkerPool) {
+    ptree objectMergeTimes;
+
+    for (auto const & entry : mMergeWorkerPool->getObjectMetrics()) {
+      ptree objectNode;
+      objectNode.put("merge_count", entry.second.mergeCount);
+      objectNode.put("average_merge_time", entry.second.mergeCount > 0 ? entry.second.totalMergeTime / entry.second.mergeCount : 0.);
+      objectNode.put("max_merge_time", entry.second.maxMergeTime);
+      objectMergeTimes.push_back(make_pair(entry.first, objectNode));
+    }
+
+    response.add_child("object_merge_times", objectMergeTimes);
+  }
+
   mInternalMetricMessageId++;
 
   return response;
@@ -164,9 +200,18 @@ void MergerDevice::sendControlResponse(const ptree & response, string senderId)
 
 void MergerDevice::Run()
 {
+  if (mMergeWorkerPool) {
+    mMergeWorkerPool->start();
+  }
+
   while (CheckCurrentState(RUNNING)) {
     handleReceivedDataObject();
   }
+
+  if (mMergeWorkerPool) {
+    mMergeWorkerPool->stop();
+    drainMergedObjects();
+  }
 }
 
 void MergerDevice::handleReceivedDataObject()
@@ -174,14 +219,86 @@ void MergerDevice::handleReceivedDataObject()
   TObject * receivedObject = receiveDataObjectFromProducer();
 
   if (isObjectNotEmpty(receivedObject)) {
-    TObject * mergedObject = mMerger->mergeObject(receivedObject);
+    if (mMergeWorkerPool) {
+      mMergeWorkerPool->push(receivedObject);
+    } else {
+      TObject * mergedObject = mMerger->mergeObject(receivedObject);
+
+      if (isObjectNotEmpty(mergedObject)) {
+        updateMetrics(mMerger->getMergeTime());
+        size_t messageSize = sendMergedObjectToViewer(mergedObject);
+        delete mergedObject;
+      }
+    }
+  }
+
+  drainMergedObjects();
+  checkShmUpdates();
+}
 
-    if (isObjectNotEmpty(mergedObject)) {
-      updateMetrics();
-      size_t messageSize = sendMergedObjectToViewer(mergedObject);
+void MergerDevice::enableShmChannel(const string & segmentName, const int checkIntervalMs)
+{
+  mShmSegmentName = segmentName;
+  mShmCheckIntervalMs = checkIntervalMs > 0 ? checkIntervalMs : 1;
+  mLastShmCheckTime = high_resolution_clock::now();
+}
+
+void MergerDevice::checkShmUpdates()
+{
+  if (mShmSegmentName.empty()) {
+    return;
+  }
+
+  auto now = high_resolution_clock::now();
+  if (duration_cast<milliseconds>(now - mLastShmCheckTime).count() < mShmCheckIntervalMs) {
+    return;
+  }
+  mLastShmCheckTime = now;
+
+  // producers create the segment on their first publication, keep trying
+  // to attach until it is there
+  if (!mShmReader || !mShmReader->isOpen()) {
+    mShmReader.reset(new ShmHistogramChannel::Reader(mShmSegmentName));
+    if (!mShmReader->isOpen()) {
+      return;
+    }
+  }
+
+  for (auto const & title : mShmReader->getTitles()) {
+    auto measureTime = high_resolution_clock::now();
+    uint64_t combinedVersion = 0;
+    TObject* mergedObject = mShmReader->mergeByTitle(title, combinedVersion);
+
+    if (mergedObject == nullptr) {
+      continue;
+    }
+
+    if (combinedVersion == mShmPublishedVersions[title]) {
+      // nothing changed since the last publication
       delete mergedObject;
+      continue;
     }
 
+    mShmPublishedVersions[title] = combinedVersion;
+    updateMetrics(duration_cast<microseconds>(high_resolution_clock::now() - measureTime).count() / 1000.0);
+    sendMergedObjectToViewer(mergedObject);
+    delete mergedObject;
+  }
+}
+
+void MergerDevice::drainMergedObjects()
+{
+  if (!mMergeWorkerPool) {
+    return;
+  }
+
+  double mergeTime = 0.;
+  TObject* mergedObject = nullptr;
+
+  while ((mergedObject = mMergeWorkerPool->popMergedObject(mergeTime)) != nullptr) {
+    updateMetrics(mergeTime);
+    size_t messageSize = sendMergedObjectToViewer(mergedObject);
+    delete mergedObject;
   }
 }
 
@@ -190,7 +307,7 @@ bool MergerDevice::isObjectNotEmpty(const TObject *  object) const
   return object == nullptr ? false : true;
 }
 
-void MergerDevice::updateMetrics()
+void MergerDevice::updateMetrics(double mergeTime)
 {
   mNumberOfMergedObjects++;
 
@@ -198,7 +315,7 @@ void MergerDevice::updateMetrics()
      mMergeTimes.pop_back();
   }
 
-  mMergeTimes.push_front(mMerger->getMergeTime());
+  mMergeTimes.push_front(mergeTime);
 }
 
 TMessage* MergerDevice::createTMessageForViewer(const TObject * objectToSend) const
@@ -221,6 +338,10 @@ TObject* MergerDevice::receiveDataObjectFromProducer()
       LOG(DEBUG) << "Buffer of data-in channel is full. Waiting for free buffer...";
 
       while ((respondeCode = fChannels.at("data-in").at(0).ReceiveAsync(input)) == -2) {
+        // keep publishing what the merge workers finish and what same node
+        // producers place in shared memory while waiting
+        drainMergedObjects();
+        checkShmUpdates();
         this_thread::sleep_for(chrono::milliseconds(10));
       }
 
@@ -245,10 +366,14 @@ size_t MergerDevice::sendMergedObjectToViewer(TObject* dataObject)
 {
   int respondeCode;
   TMessage * viewerMessage = createTMessageForViewer(dataObject);
-  unique_ptr<FairMQMessage> viewerRequest(fTransportFactory->CreateMessage(viewerMessage->Buffer(),
-                                                                           viewerMessage->BufferSize(),
-                                                                           deleteTMessage,
-                                                                           viewerMessage));
+
+  // frame the serialized object with its name, the viewer keys its lazy
+  // store on it without deserializing the message
+  const string objectName = dataObject->GetTitle();
+  unique_ptr<FairMQMessage> viewerRequest(fTransportFactory->CreateMessage(NamedObjectMessage::messageSize(objectName, viewerMessage->BufferSize())));
+  NamedObjectMessage::pack(viewerRequest->GetData(), objectName, viewerMessage->Buffer(), viewerMessage->BufferSize());
+  delete viewerMessage;
+
   size_t messageSize = viewerRequest->GetSize();
   if ((respondeCode = fChannels.at("data-out").at(0).SendAsync(viewerRequest)) == -2) {
     if ((respondeCode = fChannels.at("data-out").at(0).SendAsync(viewerRequest)) == -2) {
@@ -69,7 +69,7 @@ int main(int argc, char** argv)
 
   keyValue.putValue(inputAddress, stringLocalAddress.c_str());
 
-  if (argc != NUMBER_OF_REQUIRED_PROGRAM_PARAMETERS + 1) {
+  if (argc < NUMBER_OF_REQUIRED_PROGRAM_PARAMETERS + 1) {
     LOG(ERROR) << "Not sufficient arguments value: " << NUMBER_OF_REQUIRED_PROGRAM_PARAMETERS;
     exit(-1);
   }
@@ -78,6 +78,7 @@ int main(int argc, char** argv)
   const int NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA = atoi(argv[3]);
   const int INPUT_BUFFER_SIZE = atoi(argv[5]);
   const char * OUTPUT_HOST = argv[6];
+  const int NUMBER_OF_MERGE_THREADS = argc > NUMBER_OF_REQUIRED_PROGRAM_PARAMETERS + 1 ? atoi(argv[7]) : 0;
 
   bpo::options_description options("task-custom-cmd options");
   options.add_options()("help,h", "Produce help message");
@@ -86,7 +87,7 @@ int main(int argc, char** argv)
   bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
   bpo::notify(vm);
 
-  MergerDevice mergerDevice(unique_ptr<Merger>(new Merger(NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA)), MERGER_DEVICE_ID, NUMBER_OF_IO_THREADS);
+  MergerDevice mergerDevice(unique_ptr<Merger>(new Merger(NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA)), MERGER_DEVICE_ID, NUMBER_OF_IO_THREADS, NUMBER_OF_MERGE_THREADS);
   mergerDevice.CatchSignals();
 
   LOG(INFO) << "PID: " << getpid();
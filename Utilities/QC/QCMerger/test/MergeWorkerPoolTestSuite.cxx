@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE MergeWorkerPool
+#define BOOST_TEST_MAIN
+
+#include <chrono>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+#include "QCMerger/MergeWorkerPool.h"
+
+using namespace std;
+
+namespace
+{
+  const int NUMBER_OF_WORKERS = 2;
+  const int NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA = 2;
+  const char * HISTOGRAM_NAME = "TEST_NAME";
+  const char * HISTOGRAM_TITLE = "HISTOGRAM_TITLE";
+  const char * RANDOM_GENERATION_TYPE = "gaus";
+  const int NUMBER_OF_BINS = 100;
+  const int NUMBER_OF_ENTRIES = 100;
+  const double X_LOW = -10.0;
+  const double X_UP = 10.0;
+
+  TObject* waitForMergedObject(MergeWorkerPool & pool, double & mergeTime)
+  {
+    for (int attempt = 0; attempt < 500; ++attempt) {
+      TObject* mergedObject = pool.popMergedObject(mergeTime);
+      if (mergedObject != nullptr) {
+        return mergedObject;
+      }
+      this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return nullptr;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MergeWorkerPoolTestSuite)
+
+BOOST_AUTO_TEST_CASE(mergeHistogramsOnWorkers)
+{
+  MergeWorkerPool pool(NUMBER_OF_WORKERS, NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA);
+  pool.start();
+
+  for (int i = 0; i < NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA; ++i) {
+    TH1F* histogram = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+    histogram->FillRandom(RANDOM_GENERATION_TYPE, NUMBER_OF_ENTRIES);
+    pool.push(histogram);
+  }
+
+  double mergeTime = 0.;
+  TObject* mergedObject = waitForMergedObject(pool, mergeTime);
+
+  BOOST_TEST(mergedObject != nullptr);
+  BOOST_TEST(mergedObject->GetName() == HISTOGRAM_NAME, "Wrong name of histogram: " << mergedObject->GetName());
+  BOOST_TEST(reinterpret_cast<TH1F*>(mergedObject)->GetEntries() == (NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA * NUMBER_OF_ENTRIES));
+
+  auto metrics = pool.getObjectMetrics();
+  BOOST_TEST(metrics.count(HISTOGRAM_TITLE) == 1);
+  BOOST_TEST(metrics[HISTOGRAM_TITLE].mergeCount == 1);
+
+  delete mergedObject;
+  pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(drainQueuesOnStop)
+{
+  MergeWorkerPool pool(NUMBER_OF_WORKERS, NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA);
+  pool.start();
+
+  for (int i = 0; i < 2 * NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA; ++i) {
+    TH1F* histogram = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+    histogram->FillRandom(RANDOM_GENERATION_TYPE, NUMBER_OF_ENTRIES);
+    pool.push(histogram);
+  }
+
+  // stop drains the input queues before the workers terminate
+  pool.stop();
+
+  double mergeTime = 0.;
+  int mergedObjects = 0;
+  TObject* mergedObject = nullptr;
+
+  while ((mergedObject = pool.popMergedObject(mergeTime)) != nullptr) {
+    ++mergedObjects;
+    delete mergedObject;
+  }
+
+  BOOST_TEST(mergedObjects == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
 #include <vector>
 #include <TH1F.h>
 
+#include "QCCommon/HistogramDeltaCodec.h"
 #include "QCMerger/MergerDevice.h"
 #include "QCMerger/Merger.h"
 
@@ -53,4 +54,61 @@ BOOST_AUTO_TEST_CASE(mergeTenHistograms)
 
 }
 
+BOOST_AUTO_TEST_CASE(applyHistogramDelta)
+{
+  unique_ptr<Merger> merger(new Merger(NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA));
+
+  TH1F* first = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  first->Fill(1.0);
+  TH1F* second = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  second->Fill(2.0);
+
+  BOOST_TEST(merger->mergeObject(first) == nullptr);
+  TH1F* merged = reinterpret_cast<TH1F*>(merger->mergeObject(second));
+  BOOST_TEST(merged != nullptr);
+
+  TH1F* current = reinterpret_cast<TH1F*>(merged->Clone());
+  current->Fill(3.0);
+  TObject* delta = HistogramDeltaCodec::encodeDelta(current, merged, 1);
+  BOOST_TEST(delta != nullptr);
+
+  TH1F* updated = reinterpret_cast<TH1F*>(merger->mergeObject(delta));
+  BOOST_TEST(updated != nullptr);
+  BOOST_TEST(updated->GetEntries() == 3);
+  BOOST_TEST(updated->GetBinContent(updated->FindBin(3.0)) == 1.0);
+
+  delete updated;
+  delete merged;
+  delete current;
+}
+
+BOOST_AUTO_TEST_CASE(discardOutOfSequenceDelta)
+{
+  unique_ptr<Merger> merger(new Merger(NUMBER_OF_QC_OBJECTS_FOR_COMPLETE_DATA));
+
+  TH1F* first = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  first->Fill(1.0);
+  TH1F* second = new TH1F(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  second->Fill(2.0);
+
+  BOOST_TEST(merger->mergeObject(first) == nullptr);
+  TH1F* merged = reinterpret_cast<TH1F*>(merger->mergeObject(second));
+  BOOST_TEST(merged != nullptr);
+
+  TH1F* current = reinterpret_cast<TH1F*>(merged->Clone());
+  current->Fill(3.0);
+
+  // a delta with an unexpected cycle number indicates lost deltas, it has
+  // to be discarded and the accumulated object dropped until the next full
+  // snapshot arrives
+  TObject* staleDelta = HistogramDeltaCodec::encodeDelta(current, merged, 5);
+  BOOST_TEST(merger->mergeObject(staleDelta) == nullptr);
+
+  TObject* followingDelta = HistogramDeltaCodec::encodeDelta(current, merged, 1);
+  BOOST_TEST(merger->mergeObject(followingDelta) == nullptr);
+
+  delete merged;
+  delete current;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE ShmHistogramChannel
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <TH1F.h>
+
+#include "QCCommon/ShmHistogramChannel.h"
+
+using namespace std;
+
+namespace
+{
+  const char * SEGMENT_NAME = "/qc_shm_channel_test";
+  const char * HISTOGRAM_NAME = "TEST_NAME";
+  const char * HISTOGRAM_TITLE = "HISTOGRAM_TITLE";
+  const int NUMBER_OF_BINS = 100;
+  const double X_LOW = -10.0;
+  const double X_UP = 10.0;
+
+  struct SegmentCleanup
+  {
+    SegmentCleanup() { ShmHistogramChannel::unlinkSegment(SEGMENT_NAME); }
+    ~SegmentCleanup() { ShmHistogramChannel::unlinkSegment(SEGMENT_NAME); }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(ShmHistogramChannelTestSuite)
+
+BOOST_AUTO_TEST_CASE(publishAndMergeTwoProducers)
+{
+  SegmentCleanup cleanup;
+
+  ShmHistogramChannel::Writer firstProducer(SEGMENT_NAME, "producer_1", 8, NUMBER_OF_BINS + 2);
+  ShmHistogramChannel::Writer secondProducer(SEGMENT_NAME, "producer_2", 8, NUMBER_OF_BINS + 2);
+  BOOST_TEST(firstProducer.isOpen());
+  BOOST_TEST(secondProducer.isOpen());
+
+  TH1F firstHistogram(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  firstHistogram.Fill(1.0);
+  TH1F secondHistogram(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  secondHistogram.Fill(2.0);
+  secondHistogram.Fill(2.0);
+
+  BOOST_TEST(firstProducer.publish(&firstHistogram));
+  BOOST_TEST(secondProducer.publish(&secondHistogram));
+
+  ShmHistogramChannel::Reader reader(SEGMENT_NAME);
+  BOOST_TEST(reader.isOpen());
+  BOOST_TEST(reader.getTitles().size() == 1);
+
+  uint64_t combinedVersion = 0;
+  TH1* merged = reader.mergeByTitle(HISTOGRAM_TITLE, combinedVersion);
+
+  BOOST_TEST(merged != nullptr);
+  BOOST_TEST(merged->GetEntries() == 3);
+  BOOST_TEST(merged->GetBinContent(merged->FindBin(1.0)) == 1.0);
+  BOOST_TEST(merged->GetBinContent(merged->FindBin(2.0)) == 2.0);
+  BOOST_TEST(combinedVersion == 2);
+
+  delete merged;
+}
+
+BOOST_AUTO_TEST_CASE(versionTracksRepublication)
+{
+  SegmentCleanup cleanup;
+
+  ShmHistogramChannel::Writer producer(SEGMENT_NAME, "producer_1", 8, NUMBER_OF_BINS + 2);
+  BOOST_TEST(producer.isOpen());
+
+  TH1F histogram(HISTOGRAM_NAME, HISTOGRAM_TITLE, NUMBER_OF_BINS, X_LOW, X_UP);
+  histogram.Fill(1.0);
+  BOOST_TEST(producer.publish(&histogram));
+
+  ShmHistogramChannel::Reader reader(SEGMENT_NAME);
+  BOOST_TEST(reader.isOpen());
+
+  uint64_t firstVersion = 0;
+  delete reader.mergeByTitle(HISTOGRAM_TITLE, firstVersion);
+
+  // an unchanged segment yields the same combined version, so the merger
+  // can skip the publication
+  uint64_t secondVersion = 0;
+  delete reader.mergeByTitle(HISTOGRAM_TITLE, secondVersion);
+  BOOST_TEST(firstVersion == secondVersion);
+
+  histogram.Fill(3.0);
+  BOOST_TEST(producer.publish(&histogram));
+
+  uint64_t thirdVersion = 0;
+  TH1* merged = reader.mergeByTitle(HISTOGRAM_TITLE, thirdVersion);
+  BOOST_TEST(thirdVersion > secondVersion);
+  BOOST_TEST(merged->GetEntries() == 2);
+
+  delete merged;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
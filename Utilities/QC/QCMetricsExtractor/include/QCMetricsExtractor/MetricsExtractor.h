@@ -1,30 +1,42 @@
-#pragma once
-
-#include <fstream>
-#include <string>
-
-#include <boost/property_tree/ptree.hpp>
-#include <dds_intercom.h>
-
-class MetricsExtractor
-{
-public:
-  MetricsExtractor(const char * testName);
-  ~MetricsExtractor();
-  void runMetricsExtractor();
-  
-private:
-  dds::intercom_api::CIntercomService mService;
-  std::unique_ptr<dds::intercom_api::CCustomCmd> ddsCustomCmd;
-  std::ofstream metricsOutputFile;
-  std::ofstream stateOutputFile;
-
-  unsigned int mInternalMetricId {0};
-  unsigned int mInternalStateId {0};
-  const char * mTestName;
-
-  std::string convertToString(boost::property_tree::ptree & command); 
-  void sendCheckStateDdsCustomCommand();
-  void sendGetMetrics();
-  void subscribeDdsCommands();
-};
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+#include <dds_intercom.h>
+
+#include "QCMetricsExtractor/MetricsRingBuffer.h"
+
+class MetricsExtractor
+{
+public:
+  MetricsExtractor(const char * testName);
+  ~MetricsExtractor();
+  void runMetricsExtractor();
+
+  /// high-frequency metrics sink; samples recorded here are aggregated per
+  /// time window and written in batches, see MetricsRingBuffer
+  MetricsRingBuffer & getMetricsSink() { return mMetricsSink; }
+
+private:
+  dds::intercom_api::CIntercomService mService;
+  std::unique_ptr<dds::intercom_api::CCustomCmd> ddsCustomCmd;
+  std::ofstream metricsOutputFile;
+  std::ofstream stateOutputFile;
+  std::ofstream windowedMetricsFile;
+
+  MetricsRingBuffer mMetricsSink;
+  int mMergeTimeMetricId {-1};
+  int mMergedObjectsMetricId {-1};
+  int mAccountedMemoryMetricId {-1};
+
+  unsigned int mInternalMetricId {0};
+  unsigned int mInternalStateId {0};
+  const char * mTestName;
+
+  std::string convertToString(boost::property_tree::ptree & command); 
+  void sendCheckStateDdsCustomCommand();
+  void sendGetMetrics();
+  void subscribeDdsCommands();
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Lock-free ring-buffer sink for high-frequency metrics.
+///
+/// The producer side is a single writer recording samples with one relaxed
+/// index increment and no allocation, so per-message quantities (e.g.
+/// latencies) can be recorded at MHz rates without backpressuring the
+/// monitored device; when the consumer falls behind, samples are dropped and
+/// counted instead of blocking the producer. A flusher thread drains the
+/// ring, aggregates the samples per metric and time window and emits one
+/// JSON line per window with count, min, max and average.
+class MetricsRingBuffer
+{
+public:
+  /// capacity is rounded up to a power of two
+  MetricsRingBuffer(const size_t capacity = 65536, const int windowMs = 1000);
+  ~MetricsRingBuffer();
+
+  /// register a metric name, returns the id to record under; not to be
+  /// called while recording is in progress
+  int registerMetric(const std::string & name);
+
+  /// record one sample, wait-free; returns false when the ring is full and
+  /// the sample was dropped
+  bool record(const int metricId, const double value);
+
+  /// start the flusher thread writing window aggregates to the stream
+  void start(std::ostream & output);
+  /// stop the flusher, remaining samples and open windows are flushed
+  void stop();
+
+  /// number of samples dropped because the ring was full
+  uint64_t getDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+  struct MetricSample
+  {
+    uint64_t timestampUs;
+    double value;
+    int metricId;
+  };
+
+  /// per metric aggregate of the currently open window
+  struct WindowAggregate
+  {
+    uint64_t windowNdx {0};
+    uint64_t count {0};
+    double minValue {0.};
+    double maxValue {0.};
+    double sum {0.};
+  };
+
+  void flusherLoop();
+  void drainAvailableSamples();
+  void flushWindow(const int metricId, WindowAggregate & window);
+  void flushExpiredWindows(const uint64_t nowUs);
+
+  std::vector<MetricSample> mBuffer;
+  size_t mIndexMask;
+  std::atomic<size_t> mHead;
+  std::atomic<size_t> mTail;
+  std::atomic<uint64_t> mDropped;
+
+  std::vector<std::string> mMetricNames;
+  std::vector<WindowAggregate> mWindows;
+  uint64_t mWindowUs;
+
+  std::ostream* mOutput;
+  std::atomic<bool> mRunning;
+  std::thread mFlusherThread;
+};
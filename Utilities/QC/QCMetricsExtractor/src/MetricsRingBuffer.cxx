@@ -0,0 +1,166 @@
+#include <chrono>
+
+#include "QCMetricsExtractor/MetricsRingBuffer.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+  uint64_t nowMicroseconds()
+  {
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  size_t roundUpToPowerOfTwo(size_t value)
+  {
+    size_t rounded = 1;
+    while (rounded < value) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+}
+
+MetricsRingBuffer::MetricsRingBuffer(const size_t capacity, const int windowMs)
+  : mBuffer(roundUpToPowerOfTwo(capacity > 1 ? capacity : 2)),
+    mIndexMask(mBuffer.size() - 1),
+    mHead(0),
+    mTail(0),
+    mDropped(0),
+    mWindowUs(static_cast<uint64_t>(windowMs > 0 ? windowMs : 1) * 1000),
+    mOutput(nullptr),
+    mRunning(false)
+{
+}
+
+MetricsRingBuffer::~MetricsRingBuffer()
+{
+  if (mRunning) {
+    stop();
+  }
+}
+
+int MetricsRingBuffer::registerMetric(const string & name)
+{
+  mMetricNames.push_back(name);
+  mWindows.push_back(WindowAggregate());
+  return mMetricNames.size() - 1;
+}
+
+bool MetricsRingBuffer::record(const int metricId, const double value)
+{
+  size_t head = mHead.load(memory_order_relaxed);
+
+  if (head - mTail.load(memory_order_acquire) >= mBuffer.size()) {
+    mDropped.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+
+  MetricSample & sample = mBuffer[head & mIndexMask];
+  sample.timestampUs = nowMicroseconds();
+  sample.value = value;
+  sample.metricId = metricId;
+
+  mHead.store(head + 1, memory_order_release);
+  return true;
+}
+
+void MetricsRingBuffer::start(ostream & output)
+{
+  mOutput = &output;
+  mRunning = true;
+  mFlusherThread = thread(&MetricsRingBuffer::flusherLoop, this);
+}
+
+void MetricsRingBuffer::stop()
+{
+  mRunning = false;
+  if (mFlusherThread.joinable()) {
+    mFlusherThread.join();
+  }
+}
+
+void MetricsRingBuffer::flusherLoop()
+{
+  while (mRunning) {
+    drainAvailableSamples();
+    flushExpiredWindows(nowMicroseconds());
+    this_thread::sleep_for(milliseconds(1));
+  }
+
+  // final drain, all open windows are closed
+  drainAvailableSamples();
+  for (size_t metricId = 0; metricId < mWindows.size(); ++metricId) {
+    flushWindow(metricId, mWindows[metricId]);
+  }
+  mOutput->flush();
+}
+
+void MetricsRingBuffer::drainAvailableSamples()
+{
+  size_t tail = mTail.load(memory_order_relaxed);
+  size_t head = mHead.load(memory_order_acquire);
+
+  while (tail != head) {
+    const MetricSample & sample = mBuffer[tail & mIndexMask];
+
+    if (sample.metricId >= 0 && static_cast<size_t>(sample.metricId) < mWindows.size()) {
+      WindowAggregate & window = mWindows[sample.metricId];
+      uint64_t windowNdx = sample.timestampUs / mWindowUs;
+
+      if (window.count > 0 && windowNdx != window.windowNdx) {
+        flushWindow(sample.metricId, window);
+      }
+
+      if (window.count == 0) {
+        window.windowNdx = windowNdx;
+        window.minValue = sample.value;
+        window.maxValue = sample.value;
+        window.sum = 0.;
+      }
+
+      ++window.count;
+      window.sum += sample.value;
+      if (sample.value < window.minValue) {
+        window.minValue = sample.value;
+      }
+      if (sample.value > window.maxValue) {
+        window.maxValue = sample.value;
+      }
+    }
+
+    ++tail;
+    mTail.store(tail, memory_order_release);
+  }
+}
+
+void MetricsRingBuffer::flushWindow(const int metricId, WindowAggregate & window)
+{
+  if (window.count == 0) {
+    return;
+  }
+
+  *mOutput << "{\"metric\":\"" << mMetricNames[metricId] << "\""
+           << ",\"window_start_ms\":" << (window.windowNdx * mWindowUs) / 1000
+           << ",\"count\":" << window.count
+           << ",\"min\":" << window.minValue
+           << ",\"max\":" << window.maxValue
+           << ",\"avg\":" << window.sum / window.count
+           << ",\"dropped\":" << mDropped.load(memory_order_relaxed)
+           << "}" << endl;
+
+  window.count = 0;
+}
+
+void MetricsRingBuffer::flushExpiredWindows(const uint64_t nowUs)
+{
+  uint64_t currentWindowNdx = nowUs / mWindowUs;
+
+  for (size_t metricId = 0; metricId < mWindows.size(); ++metricId) {
+    WindowAggregate & window = mWindows[metricId];
+    if (window.count > 0 && window.windowNdx < currentWindowNdx) {
+      flushWindow(metricId, window);
+    }
+  }
+}
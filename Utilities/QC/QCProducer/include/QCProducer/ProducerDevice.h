@@ -2,21 +2,52 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
 
 #include <FairMQDevice.h>
 
 #include <dds_intercom.h>
 
+#include "QCCommon/ShmHistogramChannel.h"
 #include "QCProducer/Producer.h"
 
+class TObject;
+class TH1;
+
 class ProducerDevice : public FairMQDevice
 {
 public:
-  ProducerDevice(const char * producerId, const int numIoThreads, std::shared_ptr<Producer> & producer);
+  /// The device produces monitoring objects on the main loop and hands them
+  /// to a pool of serialization workers; serialized objects are packed into
+  /// one multipart message per dispatch interval (or earlier when the batch
+  /// size is reached), so heavy histogram serialization does not add dead
+  /// time to the monitored device. The merger receives the parts one by one
+  /// and is not affected by the batching.
+  ProducerDevice(const char * producerId,
+                 const int numIoThreads,
+                 std::shared_ptr<Producer> & producer,
+                 const int serializationThreads = 2,
+                 const int batchSize = 10,
+                 const int dispatchIntervalMs = 1000);
   virtual ~ProducerDevice() = default;
 
   static void deleteTMessage(void* data, void* hint);
   void executeRunLoop();
+  /// Publish only the bins changed since the last publication for TH1 based
+  /// objects. A full snapshot is sent every resyncInterval cycles (and
+  /// whenever a delta would not be smaller than the full histogram) so the
+  /// merger can resynchronize after lost deltas.
+  void enableDeltaProtocol(const int resyncInterval = 100);
+  /// Publish TH1 based objects through a same node shared memory segment
+  /// instead of the serialized message channel. The bin contents are placed
+  /// directly in the segment, a merger on the same node maps them read-only;
+  /// no TMessage serialization happens on this hop.
+  void enableShmChannel(const std::string & segmentName);
   void establishChannel(std::string type, std::string method, std::string address, std::string channelName, const int bufferSize);
 
 protected:
@@ -34,12 +65,42 @@ private:
 
   void subscribeDdsCommands();
   void sendDataToMerger(std::unique_ptr<FairMQMessage> request);
+  void sendBatchToMerger(std::vector<std::unique_ptr<FairMQMessage>> & batch);
   bool outputLimitReached();
   int getCurrentSecond() const;
   void waitForLimitUnlock();
 
+  /// encode the produced object as a delta against the last publication
+  /// when the delta protocol is active, returns the object to publish
+  TObject* prepareForPublication(TObject* dataObject);
+
+  void startSerializationWorkers();
+  void stopSerializationWorkers();
+  /// worker loop: take produced objects from the queue, serialize them into
+  /// TMessages and append the wrapped messages to the ready batch
+  void serializationLoop();
+
   unsigned int mInternalStateMessageId {0};
   const int OUTPUT_LIMIT_PER_SECOND {100};
   int sentObjectsInCurrentSecond {0};
   int lastCheckedSecond {0};
+
+  int mSerializationThreads {2};
+  int mBatchSize {10};
+  int mDispatchIntervalMs {1000};
+
+  bool mDeltaProtocolEnabled {false};
+  int mResyncInterval {100};
+  std::unique_ptr<ShmHistogramChannel::Writer> mShmWriter;
+  std::unordered_map<std::string, TH1*> mPublishedSnapshots;
+  std::unordered_map<std::string, unsigned int> mPublicationCycle;
+
+  std::queue<TObject*> mSerializationQueue;
+  std::mutex mQueueMutex;
+  std::condition_variable mQueueCondition;
+  bool mWorkersRunning {false};
+  std::vector<std::thread> mSerializationWorkers;
+
+  std::vector<std::unique_ptr<FairMQMessage>> mReadyMessages;
+  std::mutex mReadyMutex;
 };
@@ -7,22 +7,32 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <TMessage.h>
+#include <TH1.h>
 #include <FairMQLogger.h>
 #include <FairMQTransportFactoryZMQ.h>
 
+#include "QCCommon/HistogramDeltaCodec.h"
 #include "QCProducer/ProducerDevice.h"
 
 using namespace std;
 using namespace dds;
 using namespace dds::intercom_api;
 
-ProducerDevice::ProducerDevice(const char * producerId, const int numIoThreads, shared_ptr<Producer> & producer) : ddsCustomCmd(new CCustomCmd(mService))
+ProducerDevice::ProducerDevice(const char * producerId,
+                               const int numIoThreads,
+                               shared_ptr<Producer> & producer,
+                               const int serializationThreads,
+                               const int batchSize,
+                               const int dispatchIntervalMs) : ddsCustomCmd(new CCustomCmd(mService))
 {
   this->SetTransport(new FairMQTransportFactoryZMQ);
   this->SetProperty(Id, producerId);
   this->SetProperty(NumIoThreads, numIoThreads);
   mProducer = producer;
   lastCheckedSecond = getCurrentSecond();
+  mSerializationThreads = serializationThreads > 0 ? serializationThreads : 1;
+  mBatchSize = batchSize > 0 ? batchSize : 1;
+  mDispatchIntervalMs = dispatchIntervalMs;
 }
 
 void ProducerDevice::deleteTMessage(void* data, void* hint)
@@ -32,21 +42,161 @@ void ProducerDevice::deleteTMessage(void* data, void* hint)
 
 void ProducerDevice::Run()
 {
+  startSerializationWorkers();
+  auto lastDispatchTime = chrono::steady_clock::now();
+
   while (CheckCurrentState(RUNNING)) {
     TObject* newDataObject = mProducer->produceData();
-    TMessage* message = new TMessage(kMESS_OBJECT);
-    message->WriteObject(newDataObject);
-
-    unique_ptr<FairMQMessage> request(NewMessage(message->Buffer(), message->BufferSize(), deleteTMessage, message));
 
     if (outputLimitReached()) {
       waitForLimitUnlock();
-    } 
+    }
 
     ++sentObjectsInCurrentSecond;
-    sendDataToMerger(move(request));
 
-    delete newDataObject;
+    // same node consumers read the bins directly from shared memory,
+    // nothing to serialize or send
+    if (mShmWriter && newDataObject->InheritsFrom("TH1")) {
+      mShmWriter->publish(reinterpret_cast<TH1*>(newDataObject));
+      delete newDataObject;
+      continue;
+    }
+
+    newDataObject = prepareForPublication(newDataObject);
+
+    // hand the object to the serialization workers, the main loop never
+    // touches the ROOT streamer
+    {
+      lock_guard<mutex> lock(mQueueMutex);
+      mSerializationQueue.push(newDataObject);
+    }
+    mQueueCondition.notify_one();
+
+    // dispatch the batch of serialized objects as one multipart message
+    // when the batch size is reached or the dispatch interval has elapsed
+    auto now = chrono::steady_clock::now();
+    bool intervalElapsed =
+      chrono::duration_cast<chrono::milliseconds>(now - lastDispatchTime).count() >= mDispatchIntervalMs;
+    vector<unique_ptr<FairMQMessage>> batch;
+    {
+      lock_guard<mutex> lock(mReadyMutex);
+      if (static_cast<int>(mReadyMessages.size()) >= mBatchSize ||
+          (intervalElapsed && !mReadyMessages.empty())) {
+        batch.swap(mReadyMessages);
+      }
+    }
+    if (!batch.empty()) {
+      sendBatchToMerger(batch);
+      lastDispatchTime = now;
+    }
+  }
+
+  stopSerializationWorkers();
+
+  // flush what the workers serialized until the stop
+  vector<unique_ptr<FairMQMessage>> batch;
+  {
+    lock_guard<mutex> lock(mReadyMutex);
+    batch.swap(mReadyMessages);
+  }
+  if (!batch.empty()) {
+    sendBatchToMerger(batch);
+  }
+}
+
+void ProducerDevice::enableShmChannel(const string & segmentName)
+{
+  mShmWriter.reset(new ShmHistogramChannel::Writer(segmentName, GetProperty(Id, "producer")));
+
+  if (!mShmWriter->isOpen()) {
+    LOG(ERROR) << "Could not open shared memory segment " << segmentName << ", falling back to the message channel.";
+    mShmWriter.reset();
+  }
+}
+
+void ProducerDevice::enableDeltaProtocol(const int resyncInterval)
+{
+  mDeltaProtocolEnabled = true;
+  mResyncInterval = resyncInterval > 0 ? resyncInterval : 1;
+}
+
+TObject* ProducerDevice::prepareForPublication(TObject* dataObject)
+{
+  if (!mDeltaProtocolEnabled || !dataObject->InheritsFrom("TH1")) {
+    return dataObject;
+  }
+
+  TH1* current = reinterpret_cast<TH1*>(dataObject);
+  const string title = current->GetTitle();
+  unsigned int cycle = mPublicationCycle[title]++;
+  auto snapshot = mPublishedSnapshots.find(title);
+
+  if (snapshot != mPublishedSnapshots.end() && (cycle % mResyncInterval) != 0) {
+    TObject* delta = HistogramDeltaCodec::encodeDelta(current, snapshot->second, cycle);
+    if (delta != nullptr) {
+      // the current histogram becomes the reference for the next delta
+      delete snapshot->second;
+      snapshot->second = current;
+      return delta;
+    }
+  }
+
+  // full snapshot, either a resync cycle or a delta would not be smaller
+  current->SetUniqueID(cycle);
+  if (snapshot != mPublishedSnapshots.end()) {
+    delete snapshot->second;
+    mPublishedSnapshots.erase(snapshot);
+  }
+  mPublishedSnapshots[title] = reinterpret_cast<TH1*>(current->Clone());
+
+  return current;
+}
+
+void ProducerDevice::startSerializationWorkers()
+{
+  mWorkersRunning = true;
+  for (int i = 0; i < mSerializationThreads; ++i) {
+    mSerializationWorkers.emplace_back(&ProducerDevice::serializationLoop, this);
+  }
+}
+
+void ProducerDevice::stopSerializationWorkers()
+{
+  {
+    lock_guard<mutex> lock(mQueueMutex);
+    mWorkersRunning = false;
+  }
+  mQueueCondition.notify_all();
+  for (auto & worker : mSerializationWorkers) {
+    worker.join();
+  }
+  mSerializationWorkers.clear();
+}
+
+void ProducerDevice::serializationLoop()
+{
+  while (true) {
+    TObject* dataObject = nullptr;
+    {
+      unique_lock<mutex> lock(mQueueMutex);
+      mQueueCondition.wait(lock, [this] { return !mSerializationQueue.empty() || !mWorkersRunning; });
+      if (mSerializationQueue.empty()) {
+        // queue drained and stop requested
+        break;
+      }
+      dataObject = mSerializationQueue.front();
+      mSerializationQueue.pop();
+    }
+
+    TMessage* message = new TMessage(kMESS_OBJECT);
+    message->WriteObject(dataObject);
+    delete dataObject;
+
+    unique_ptr<FairMQMessage> part(NewMessage(message->Buffer(), message->BufferSize(), deleteTMessage, message));
+    {
+      lock_guard<mutex> lock(mReadyMutex);
+      mReadyMessages.push_back(move(part));
+    }
   }
 }
 
@@ -104,6 +254,17 @@ void ProducerDevice::sendDataToMerger(unique_ptr<FairMQMessage> request)
   }
 }
 
+void ProducerDevice::sendBatchToMerger(vector<unique_ptr<FairMQMessage>> & batch)
+{
+  LOG(DEBUG) << "Sending batch of " << batch.size() << " object(s) as one multipart message";
+
+  if (fChannels.at("data-out").at(0).Send(batch) < 0) {
+    LOG(ERROR) << "Sending batch of " << batch.size() << " object(s) failed";
+  }
+
+  batch.clear();
+}
+
 void ProducerDevice::subscribeDdsCommands()
 {
   using namespace dds::intercom_api;
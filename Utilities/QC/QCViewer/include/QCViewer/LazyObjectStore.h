@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TObject;
+
+/// Lazy store of serialized QC objects.
+///
+/// Received TMessage buffers are kept raw and keyed by object name, so the
+/// viewer can subscribe to the full QC stream without deserializing every
+/// update. An object is deserialized only on the first display request; the
+/// deserialized objects are cached with LRU eviction, a newer buffer for a
+/// cached name invalidates the cached object.
+class LazyObjectStore
+{
+public:
+  LazyObjectStore(const size_t cacheCapacity = 10);
+  ~LazyObjectStore();
+
+  /// keep the raw serialized buffer of an object, replacing any older version
+  void storeBuffer(const std::string & name, const void* buffer, const size_t size);
+
+  /// deserialized object for display, nullptr when the name is unknown;
+  /// the store keeps ownership of the returned object
+  TObject* getObject(const std::string & name);
+
+  /// number of objects with a stored raw buffer
+  size_t getBufferCount() const { return mRawBuffers.size(); }
+  /// number of currently deserialized objects
+  size_t getCachedObjectCount() const { return mCachedObjects.size(); }
+
+private:
+  void dropCachedObject(const std::string & name);
+
+  struct CachedObject
+  {
+    TObject* object;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::unordered_map<std::string, std::vector<char>> mRawBuffers;
+  std::unordered_map<std::string, CachedObject> mCachedObjects;
+  /// most recently displayed name at the front
+  std::list<std::string> mLruOrder;
+  size_t mCacheCapacity;
+};
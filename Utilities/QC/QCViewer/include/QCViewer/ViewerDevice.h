@@ -9,6 +9,8 @@
 #include <TCanvas.h>
 #include <TList.h>
 
+#include "QCViewer/LazyObjectStore.h"
+
 class ViewerDevice : public FairMQDevice
 {
 public:
@@ -17,6 +19,11 @@ public:
 
   void executeRunLoop();
   void establishChannel(std::string type, std::string method, std::string address, std::string channelName);
+
+  /// deserialize the named object from the store and draw it; objects that
+  /// are never requested for display stay as raw buffers
+  void displayObject(const std::string & objectName);
+
 protected:
   ViewerDevice() = default;
   virtual void Run() override;
@@ -24,6 +31,7 @@ protected:
 private:
   std::unordered_map<std::string, std::shared_ptr<TCanvas>> objectsToDraw;
   std::string mDrawingOptions;
+  LazyObjectStore mObjectStore;
 
   std::unique_ptr<FairMQMessage> receiveMessageFromMerger();
   TObject* receiveDataObjectFromMerger();
@@ -0,0 +1,69 @@
+#include <TObject.h>
+
+#include "QCViewer/LazyObjectStore.h"
+#include "QCCommon/TMessageWrapper.h"
+
+using namespace std;
+
+LazyObjectStore::LazyObjectStore(const size_t cacheCapacity)
+  : mCacheCapacity(cacheCapacity > 0 ? cacheCapacity : 1)
+{
+}
+
+LazyObjectStore::~LazyObjectStore()
+{
+  for (auto const & entry : mCachedObjects) {
+    delete entry.second.object;
+  }
+}
+
+void LazyObjectStore::storeBuffer(const string & name, const void* buffer, const size_t size)
+{
+  vector<char> & rawBuffer = mRawBuffers[name];
+  rawBuffer.assign(static_cast<const char*>(buffer), static_cast<const char*>(buffer) + size);
+
+  // the cached object is outdated now, the next display request
+  // deserializes the new buffer
+  dropCachedObject(name);
+}
+
+TObject* LazyObjectStore::getObject(const string & name)
+{
+  auto cached = mCachedObjects.find(name);
+  if (cached != mCachedObjects.end()) {
+    mLruOrder.splice(mLruOrder.begin(), mLruOrder, cached->second.lruPosition);
+    return cached->second.object;
+  }
+
+  auto rawBuffer = mRawBuffers.find(name);
+  if (rawBuffer == mRawBuffers.end()) {
+    return nullptr;
+  }
+
+  TMessageWrapper message(rawBuffer->second.data(), rawBuffer->second.size());
+  TObject* object = reinterpret_cast<TObject*>(message.ReadObject(message.GetClass()));
+  if (object == nullptr) {
+    return nullptr;
+  }
+
+  if (mCachedObjects.size() >= mCacheCapacity) {
+    dropCachedObject(mLruOrder.back());
+  }
+
+  mLruOrder.push_front(name);
+  mCachedObjects[name] = CachedObject{object, mLruOrder.begin()};
+
+  return object;
+}
+
+void LazyObjectStore::dropCachedObject(const string & name)
+{
+  auto cached = mCachedObjects.find(name);
+  if (cached == mCachedObjects.end()) {
+    return;
+  }
+
+  delete cached->second.object;
+  mLruOrder.erase(cached->second.lruPosition);
+  mCachedObjects.erase(cached);
+}
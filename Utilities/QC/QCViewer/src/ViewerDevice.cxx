@@ -7,6 +7,7 @@
 #include <FairMQTransportFactoryZMQ.h>
 
 #include "QCViewer/ViewerDevice.h"
+#include "QCCommon/NamedObjectMessage.h"
 #include "QCCommon/TMessageWrapper.h"
 
 using namespace std;
@@ -22,14 +23,40 @@ ViewerDevice::ViewerDevice(std::string viewerId, int numIoThreads, string drawin
 void ViewerDevice::Run()
 {
   while (CheckCurrentState(RUNNING)) {
-    TObject* receivedObject = receiveDataObjectFromMerger();
-
-    if (receivedObject != nullptr) {
-      LOG(INFO) << "Received QC objects from Merger device";
-      //updateCanvas(receivedObject); // Visualization is disabled because there was no support of X11 protocol on the previous testing environment
+    unique_ptr<FairMQMessage> request(NewMessage());
+
+    if (fChannels.at("data-in").at(0).ReceiveAsync(request) >= 0) {
+      string objectName;
+      size_t payloadSize = 0;
+      const void* payload = NamedObjectMessage::unpack(request->GetData(), request->GetSize(), objectName, payloadSize);
+
+      if (payload != nullptr) {
+        // keep the raw buffer, deserialization happens on display request
+        mObjectStore.storeBuffer(objectName, payload, payloadSize);
+        LOG(INFO) << "Received QC object " << objectName << " from Merger device";
+        //displayObject(objectName); // Visualization is disabled because there was no support of X11 protocol on the previous testing environment
+      } else {
+        // bare TMessage from a sender without framing
+        TMessageWrapper tm(request->GetData(), request->GetSize());
+        TObject* receivedObject = reinterpret_cast<TObject*>(tm.ReadObject(tm.GetClass()));
+
+        if (receivedObject != nullptr) {
+          LOG(INFO) << "Received QC objects from Merger device";
+          //updateCanvas(receivedObject); // Visualization is disabled because there was no support of X11 protocol on the previous testing environment
+        }
+
+        delete receivedObject;
+      }
     }
+  }
+}
+
+void ViewerDevice::displayObject(const string & objectName)
+{
+  TObject* object = mObjectStore.getObject(objectName);
 
-    delete receivedObject;
+  if (object != nullptr) {
+    updateCanvas(object);
   }
 }
 
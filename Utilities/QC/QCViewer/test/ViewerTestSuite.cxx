@@ -4,6 +4,10 @@
 #include <boost/test/unit_test.hpp>
 #include <string>
 
+#include <TH1F.h>
+#include <TMessage.h>
+
+#include "QCViewer/LazyObjectStore.h"
 #include "QCViewer/ViewerDevice.h"
 
 BOOST_AUTO_TEST_SUITE(ViewerTestSuite)
@@ -30,4 +34,49 @@ BOOST_AUTO_TEST_CASE(establishChannelByViewerDevice)
   BOOST_TEST(viewer.fChannels.size() == 1, "Viewer device did not establish channel");
 }
 
+BOOST_AUTO_TEST_CASE(deserializeObjectOnDisplayRequest)
+{
+  LazyObjectStore store(2);
+
+  TH1F histogram("TEST_NAME", "TEST_TITLE", 100, -10.0, 10.0);
+  histogram.Fill(1.0);
+  TMessage message(kMESS_OBJECT);
+  message.WriteObject(&histogram);
+
+  store.storeBuffer("TEST_TITLE", message.Buffer(), message.BufferSize());
+
+  BOOST_TEST(store.getBufferCount() == 1);
+  BOOST_TEST(store.getCachedObjectCount() == 0, "Object was deserialized before any display request");
+
+  TObject* object = store.getObject("TEST_TITLE");
+  BOOST_TEST(object != nullptr);
+  BOOST_TEST(reinterpret_cast<TH1F*>(object)->GetEntries() == 1);
+  BOOST_TEST(store.getCachedObjectCount() == 1);
+
+  BOOST_TEST(store.getObject("UNKNOWN_TITLE") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(evictLeastRecentlyDisplayedObject)
+{
+  const size_t CACHE_CAPACITY = 2;
+  LazyObjectStore store(CACHE_CAPACITY);
+
+  for (int i = 0; i < 3; ++i) {
+    std::string title = "TEST_TITLE_" + std::to_string(i);
+    TH1F histogram("TEST_NAME", title.c_str(), 100, -10.0, 10.0);
+    TMessage message(kMESS_OBJECT);
+    message.WriteObject(&histogram);
+    store.storeBuffer(title, message.Buffer(), message.BufferSize());
+  }
+
+  BOOST_TEST(store.getObject("TEST_TITLE_0") != nullptr);
+  BOOST_TEST(store.getObject("TEST_TITLE_1") != nullptr);
+  BOOST_TEST(store.getObject("TEST_TITLE_2") != nullptr);
+
+  // the raw buffers are all retained, only the deserialized objects are
+  // bounded by the cache capacity
+  BOOST_TEST(store.getBufferCount() == 3);
+  BOOST_TEST(store.getCachedObjectCount() == CACHE_CAPACITY);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,261 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @headerfile TimeFrameBuilder.h
+///
+/// @since 2016-11-08
+/// @author A. Rybalchenko
+
+#ifndef ALICEO2_DEVICES_TIMEFRAMEBUILDER_H_
+#define ALICEO2_DEVICES_TIMEFRAMEBUILDER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace AliceO2 {
+namespace Devices {
+
+/// Per-FLP arrival bookkeeping of a TimeFrameBuilder
+struct FlpArrivalStats
+{
+  uint64_t partsReceived = 0;   ///< Parts accepted from this FLP
+  uint64_t duplicatedParts = 0; ///< Parts already present in their timeframe
+  uint64_t lateParts = 0;       ///< Parts of already discarded timeframes
+  double meanIntervalMs = 0.;   ///< Smoothed interval between arrivals (ms)
+  bool started = false;         ///< Whether a first arrival has been seen
+  std::chrono::steady_clock::time_point lastArrival; ///< Time of the last arrival
+
+  /// record an arrival and update the smoothed inter-arrival interval
+  void Update(std::chrono::steady_clock::time_point now);
+};
+
+/// State of a reassembly slot handed to the completion policy
+struct TFSlotStatus
+{
+  int32_t id;          ///< Timeframe ID assembled in the slot
+  size_t partsArrived; ///< Parts collected so far
+  int numFLPs;         ///< Expected number of contributing FLPs
+  std::chrono::milliseconds age; ///< Time since the first part arrived
+};
+
+/// Reusable time-frame assembly, promoted from the EPNReceiver example.
+///
+/// Collects the sub-timeframe parts sent by the FLPs into complete timeframes.
+/// Partial timeframes live in a preallocated circular table indexed by
+/// timeframe ID modulo the table size: lookup, completion detection and
+/// eviction are all O(1) with no map churn. A timeframe still incomplete when
+/// its slot is needed for a newer ID (or when its timeout expires) is
+/// discarded by reusing the slot.
+///
+/// The part type is a template parameter and only needs to be movable; with
+/// FairMQMessagePtr parts a completed timeframe is aggregated into a single
+/// O2Message by moving the message pointers, no payload is ever copied.
+/// Completion is decided by a pluggable policy called after every accepted
+/// part; the default policy CompleteWhenAllPartsArrived reproduces the
+/// EPNReceiver behavior. All time-dependent entry points take the current
+/// time as a parameter, so assembly is testable and benchmarkable without
+/// a real-time source.
+template <typename PartT>
+class TimeFrameBuilder
+{
+public:
+  using TimePoint = std::chrono::steady_clock::time_point;
+  using CompletionPolicy = std::function<bool(const TFSlotStatus&)>;
+  /// called when an incomplete timeframe is discarded (id, parts collected, reason)
+  using DiscardHandler = std::function<void(int32_t, size_t, const char*)>;
+
+  /// Result of adding a part to the builder
+  enum class AddResult {
+    kPending,   ///< part stored, timeframe not complete yet
+    kCompleted, ///< timeframe complete, collect it with TakeCompleted()
+    kDuplicate, ///< a part of this timeframe from this FLP was already stored
+    kLate       ///< part of a timeframe that has already been discarded
+  };
+
+  /// the default policy: a timeframe is complete when every FLP contributed
+  static CompletionPolicy CompleteWhenAllPartsArrived()
+  {
+    return [](const TFSlotStatus& status) {
+      return status.partsArrived == static_cast<size_t>(status.numFLPs);
+    };
+  }
+
+  /// policy for lossy links: a timeframe is complete once the given fraction
+  /// of the expected parts has arrived
+  static CompletionPolicy CompleteWhenFractionArrived(double fraction)
+  {
+    return [fraction](const TFSlotStatus& status) {
+      return status.partsArrived >= static_cast<size_t>(fraction * status.numFLPs + 0.5);
+    };
+  }
+
+  /// @param numFLPs   number of FLPs contributing to each timeframe
+  /// @param numSlots  requested size of the reassembly table, rounded up to a
+  ///                  power of two so the slot of an ID is a simple mask
+  /// @param policy    completion policy, all-parts-arrived by default
+  TimeFrameBuilder(int numFLPs, size_t numSlots,
+                   CompletionPolicy policy = CompleteWhenAllPartsArrived())
+    : mNumFLPs(numFLPs)
+    , mPolicy(std::move(policy))
+    , mDiscardHandler()
+    , mSlots()
+    , mCompleted()
+    , mFlpStats(numFLPs)
+    , mSweepIndex(0)
+    , mDiscardedCount(0)
+    , mDuplicatedCount(0)
+    , mLatePartsCount(0)
+  {
+    size_t size = 2;
+    while (size < numSlots) {
+      size <<= 1;
+    }
+    mSlots.resize(size);
+    for (auto& slot : mSlots) {
+      slot.flpSeen.assign(mNumFLPs, false);
+      slot.parts.reserve(mNumFLPs);
+    }
+  }
+
+  /// register a handler called whenever an incomplete timeframe is discarded,
+  /// e.g. for logging; the builder itself produces no output
+  void SetDiscardHandler(DiscardHandler handler) { mDiscardHandler = std::move(handler); }
+
+  /// Add the part received from an FLP to its timeframe.
+  /// On kCompleted the assembled timeframe is available via TakeCompleted().
+  AddResult AddPart(uint16_t id, int flpIndex, PartT&& part,
+                    TimePoint now = std::chrono::steady_clock::now())
+  {
+    mFlpStats.at(flpIndex).Update(now);
+
+    TFSlot& slot = mSlots[id & (mSlots.size() - 1)];
+
+    if (slot.id >= 0 && slot.id != id) {
+      // the slot is still occupied by an older incomplete timeframe:
+      // evict it by reuse, no erase/rehash involved
+      DiscardSlot(slot, "slot needed for newer timeframe");
+    }
+
+    if (slot.id < 0 && slot.lastDiscardedId == static_cast<int32_t>(id)) {
+      // a part of a timeframe this slot has already given up on
+      ++mLatePartsCount;
+      ++mFlpStats[flpIndex].lateParts;
+      return AddResult::kLate;
+    }
+
+    if (slot.id == id && slot.flpSeen[flpIndex]) {
+      ++mDuplicatedCount;
+      ++mFlpStats[flpIndex].duplicatedParts;
+      return AddResult::kDuplicate;
+    }
+
+    if (slot.id < 0) {
+      // first part with this ID: claim the slot and save the receive time
+      slot.id = id;
+      slot.start = now;
+    }
+    slot.parts.push_back(std::move(part));
+    slot.flpSeen[flpIndex] = true;
+    ++mFlpStats[flpIndex].partsReceived;
+
+    if (mPolicy(GetStatus(slot, now))) {
+      mCompleted = std::move(slot.parts);
+      FreeSlot(slot);
+      slot.lastDiscardedId = -1;
+      return AddResult::kCompleted;
+    }
+    return AddResult::kPending;
+  }
+
+  /// collect the timeframe assembled by the last kCompleted AddPart; the
+  /// parts are moved out in arrival order
+  std::vector<PartT> TakeCompleted() { return std::move(mCompleted); }
+
+  /// Check the next slot of a round-robin sweep and discard its timeframe if
+  /// it is incomplete for longer than the timeout. One slot per call: the
+  /// sweep touches every slot well within the timeout period without ever
+  /// scanning the whole table in one loop iteration.
+  /// @return number of timeframes discarded (0 or 1)
+  size_t Sweep(std::chrono::milliseconds timeout,
+               TimePoint now = std::chrono::steady_clock::now())
+  {
+    TFSlot& slot = mSlots[mSweepIndex & (mSlots.size() - 1)];
+    ++mSweepIndex;
+
+    if (slot.id >= 0 && now - slot.start > timeout) {
+      DiscardSlot(slot, "timeout");
+      return 1;
+    }
+    return 0;
+  }
+
+  int GetNumFLPs() const { return mNumFLPs; }
+  size_t GetNumSlots() const { return mSlots.size(); }
+  uint64_t GetDiscardedCount() const { return mDiscardedCount; }
+  uint64_t GetDuplicatedCount() const { return mDuplicatedCount; }
+  uint64_t GetLatePartsCount() const { return mLatePartsCount; }
+  const FlpArrivalStats& GetFlpStats(int flpIndex) const { return mFlpStats.at(flpIndex); }
+
+private:
+  /// Slot of the circular reassembly table, holding one timeframe under
+  /// construction. A slot is free when id is negative.
+  struct TFSlot
+  {
+    std::vector<PartT> parts;
+    TimePoint start;
+    std::vector<bool> flpSeen; ///< Which FLPs already contributed a part
+    int32_t id = -1;           ///< Timeframe ID assembled here, -1 when free
+    int32_t lastDiscardedId = -1; ///< Last timeframe ID discarded from this slot
+  };
+
+  TFSlotStatus GetStatus(const TFSlot& slot, TimePoint now) const
+  {
+    return TFSlotStatus{slot.id, slot.parts.size(), mNumFLPs,
+                        std::chrono::duration_cast<std::chrono::milliseconds>(now - slot.start)};
+  }
+
+  void DiscardSlot(TFSlot& slot, const char* reason)
+  {
+    if (mDiscardHandler) {
+      mDiscardHandler(slot.id, slot.parts.size(), reason);
+    }
+    slot.lastDiscardedId = slot.id;
+    ++mDiscardedCount;
+    FreeSlot(slot);
+  }
+
+  void FreeSlot(TFSlot& slot)
+  {
+    slot.id = -1;
+    slot.parts.clear();
+    slot.flpSeen.assign(mNumFLPs, false);
+  }
+
+  int mNumFLPs;
+  CompletionPolicy mPolicy;
+  DiscardHandler mDiscardHandler;
+  std::vector<TFSlot> mSlots; ///< Circular reassembly table, size is a power of two
+  std::vector<PartT> mCompleted; ///< Timeframe assembled by the last completed AddPart
+  std::vector<FlpArrivalStats> mFlpStats;
+  size_t mSweepIndex; ///< Position of the round-robin timeout sweep
+  uint64_t mDiscardedCount;
+  uint64_t mDuplicatedCount;
+  uint64_t mLatePartsCount;
+};
+
+} // namespace Devices
+} // namespace AliceO2
+
+#endif /* ALICEO2_DEVICES_TIMEFRAMEBUILDER_H_ */
@@ -0,0 +1,102 @@
+/// \file bench_TimeFrameBuilder.cxx
+/// \brief Benchmark of TimeFrameBuilder with synthetic FLP streams
+///
+/// Generates per-FLP part streams with a configurable rate and gaussian
+/// arrival jitter, merges them into one global arrival sequence and replays
+/// it through the builder with the simulated timestamps. Reports the
+/// assembly throughput together with the completion/discard balance, so the
+/// effect of jitter (deeper interleaving, slot evictions) on a given table
+/// size can be measured without a transport.
+///
+/// usage: bench_TimeFrameBuilder [numFLPs] [numTimeframes] [rateHz] [jitterFraction] [numSlots]
+
+#include "TimeFrameBuilder/TimeFrameBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace AliceO2::Devices;
+using std::chrono::steady_clock;
+
+namespace {
+
+// stand-in for a sub-timeframe message, only moved around by the builder
+struct SyntheticPart {
+  uint16_t timeframeId;
+  int flpIndex;
+};
+
+struct Arrival {
+  steady_clock::time_point time;
+  uint16_t timeframeId;
+  int flpIndex;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+  const int numFLPs = (argc > 1) ? atoi(argv[1]) : 40;
+  const int numTimeframes = (argc > 2) ? atoi(argv[2]) : 100000;
+  const double rateHz = (argc > 3) ? atof(argv[3]) : 50000.;
+  const double jitterFraction = (argc > 4) ? atof(argv[4]) : 0.2;
+  const int numSlots = (argc > 5) ? atoi(argv[5]) : 256;
+
+  printf("generating %i timeframes from %i FLPs at %.0f Hz, jitter %.0f%%, %i slots\n",
+         numTimeframes, numFLPs, rateHz, jitterFraction * 100., numSlots);
+
+  // each FLP emits one part per timeframe period, shifted by gaussian jitter
+  const double periodUs = 1e6 / rateHz;
+  std::mt19937 generator(12345);
+  std::normal_distribution<double> jitter(0., jitterFraction * periodUs);
+
+  std::vector<Arrival> arrivals;
+  arrivals.reserve(static_cast<size_t>(numTimeframes) * numFLPs);
+  const steady_clock::time_point origin = steady_clock::now();
+  for (int tf = 0; tf < numTimeframes; ++tf) {
+    for (int flp = 0; flp < numFLPs; ++flp) {
+      double offsetUs = tf * periodUs + jitter(generator);
+      if (offsetUs < 0.) offsetUs = 0.;
+      arrivals.push_back(Arrival{origin + std::chrono::microseconds(static_cast<int64_t>(offsetUs)),
+                                 static_cast<uint16_t>(tf), flp});
+    }
+  }
+  std::sort(arrivals.begin(), arrivals.end(),
+            [](const Arrival& a, const Arrival& b) { return a.time < b.time; });
+
+  TimeFrameBuilder<SyntheticPart> builder(numFLPs, numSlots);
+
+  uint64_t completed = 0;
+  uint64_t pending = 0;
+  const steady_clock::time_point wallStart = steady_clock::now();
+  for (const auto& arrival : arrivals) {
+    auto result = builder.AddPart(arrival.timeframeId, arrival.flpIndex,
+                                  SyntheticPart{arrival.timeframeId, arrival.flpIndex},
+                                  arrival.time);
+    if (result == TimeFrameBuilder<SyntheticPart>::AddResult::kCompleted) {
+      std::vector<SyntheticPart> timeframe = builder.TakeCompleted();
+      completed += (timeframe.size() == static_cast<size_t>(numFLPs)) ? 1 : 0;
+    } else if (result == TimeFrameBuilder<SyntheticPart>::AddResult::kPending) {
+      ++pending;
+    }
+  }
+  const double wallUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                          steady_clock::now() - wallStart).count();
+
+  printf("assembled %llu/%i timeframes, discarded %llu, duplicated %llu, late %llu\n",
+         (unsigned long long)completed, numTimeframes,
+         (unsigned long long)builder.GetDiscardedCount(),
+         (unsigned long long)builder.GetDuplicatedCount(),
+         (unsigned long long)builder.GetLatePartsCount());
+  printf("processed %zu parts in %.0f us: %.2f Mparts/s\n",
+         arrivals.size(), wallUs, arrivals.size() / wallUs);
+  printf("FLP0 mean arrival interval: %.3f ms (simulated clock)\n",
+         builder.GetFlpStats(0).meanIntervalMs);
+  (void)pending;
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+/// @copyright
+/// © Copyright 2014 Copyright Holders of the ALICE O2 collaboration.
+/// See https://aliceinfo.cern.ch/AliceO2 for details on the Copyright holders.
+/// This software is distributed under the terms of the
+/// GNU General Public License version 3 (GPL Version 3).
+///
+/// License text in a separate file.
+///
+/// In applying this license, CERN does not waive the privileges and immunities
+/// granted to it by virtue of its status as an Intergovernmental Organization
+/// or submit itself to any jurisdiction.
+
+/// @file TimeFrameBuilder.cxx
+///
+/// @since 2016-11-08
+/// @author A. Rybalchenko
+
+#include "TimeFrameBuilder/TimeFrameBuilder.h"
+
+using namespace AliceO2::Devices;
+
+//__________________________________________________________________________________________________
+void FlpArrivalStats::Update(std::chrono::steady_clock::time_point now)
+{
+  if (started) {
+    double intervalMs =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - lastArrival).count() / 1000.;
+    if (meanIntervalMs == 0.) {
+      // second arrival, seed the estimate
+      meanIntervalMs = intervalMs;
+    } else {
+      // exponential smoothing, recent arrivals dominate but a single outlier
+      // does not wipe out the history
+      constexpr double kWeight = 0.1;
+      meanIntervalMs = (1. - kWeight) * meanIntervalMs + kWeight * intervalMs;
+    }
+  }
+  started = true;
+  lastArrival = now;
+}
@@ -0,0 +1,92 @@
+#define BOOST_TEST_MODULE Test Utilities TimeFrameBuilder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TimeFrameBuilder/TimeFrameBuilder.h"
+
+#include <chrono>
+#include <string>
+
+namespace AliceO2 {
+namespace Devices {
+
+using Builder = TimeFrameBuilder<std::string>;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+BOOST_AUTO_TEST_CASE(completeTimeframe_test)
+{
+  Builder builder(3, 8);
+  const steady_clock::time_point t0 = steady_clock::now();
+
+  BOOST_CHECK(builder.AddPart(7, 0, "flp0", t0) == Builder::AddResult::kPending);
+  BOOST_CHECK(builder.AddPart(7, 2, "flp2", t0 + milliseconds(1)) == Builder::AddResult::kPending);
+  BOOST_CHECK(builder.AddPart(7, 1, "flp1", t0 + milliseconds(2)) == Builder::AddResult::kCompleted);
+
+  // parts come out in arrival order, moved, not copied
+  std::vector<std::string> timeframe = builder.TakeCompleted();
+  BOOST_REQUIRE_EQUAL(timeframe.size(), 3);
+  BOOST_CHECK_EQUAL(timeframe[0], "flp0");
+  BOOST_CHECK_EQUAL(timeframe[1], "flp2");
+  BOOST_CHECK_EQUAL(timeframe[2], "flp1");
+
+  BOOST_CHECK_EQUAL(builder.GetFlpStats(0).partsReceived, 1);
+  BOOST_CHECK_EQUAL(builder.GetDiscardedCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(duplicateAndLateParts_test)
+{
+  Builder builder(2, 8);
+  const steady_clock::time_point t0 = steady_clock::now();
+
+  BOOST_CHECK(builder.AddPart(1, 0, "a", t0) == Builder::AddResult::kPending);
+  BOOST_CHECK(builder.AddPart(1, 0, "a again", t0) == Builder::AddResult::kDuplicate);
+  BOOST_CHECK_EQUAL(builder.GetDuplicatedCount(), 1);
+  BOOST_CHECK_EQUAL(builder.GetFlpStats(0).duplicatedParts, 1);
+
+  // expire timeframe 1 via the sweep (slot 1 is the second slot checked)
+  BOOST_CHECK_EQUAL(builder.Sweep(milliseconds(100), t0 + milliseconds(500)), 0);
+  BOOST_CHECK_EQUAL(builder.Sweep(milliseconds(100), t0 + milliseconds(500)), 1);
+  BOOST_CHECK_EQUAL(builder.GetDiscardedCount(), 1);
+
+  // a straggler of the discarded timeframe is late, not a fresh assembly
+  BOOST_CHECK(builder.AddPart(1, 1, "b", t0 + milliseconds(600)) == Builder::AddResult::kLate);
+  BOOST_CHECK_EQUAL(builder.GetLatePartsCount(), 1);
+  BOOST_CHECK_EQUAL(builder.GetFlpStats(1).lateParts, 1);
+}
+
+BOOST_AUTO_TEST_CASE(slotEviction_test)
+{
+  Builder builder(2, 2);
+  const steady_clock::time_point t0 = steady_clock::now();
+
+  int32_t discardedId = -1;
+  std::string discardReason;
+  builder.SetDiscardHandler([&](int32_t id, size_t parts, const char* reason) {
+    discardedId = id;
+    discardReason = reason;
+    BOOST_CHECK_EQUAL(parts, 1);
+  });
+
+  // timeframe 2 maps to the same slot as timeframe 0 in a 2-slot table and
+  // evicts the older incomplete assembly
+  BOOST_CHECK(builder.AddPart(0, 0, "old", t0) == Builder::AddResult::kPending);
+  BOOST_CHECK(builder.AddPart(2, 0, "new", t0 + milliseconds(1)) == Builder::AddResult::kPending);
+  BOOST_CHECK_EQUAL(discardedId, 0);
+  BOOST_CHECK_EQUAL(discardReason, "slot needed for newer timeframe");
+  BOOST_CHECK(builder.AddPart(2, 1, "new2", t0 + milliseconds(2)) == Builder::AddResult::kCompleted);
+}
+
+BOOST_AUTO_TEST_CASE(fractionPolicy_test)
+{
+  // with 4 FLPs and a 0.5 completion fraction two parts complete a timeframe
+  Builder builder(4, 8, Builder::CompleteWhenFractionArrived(0.5));
+  const steady_clock::time_point t0 = steady_clock::now();
+
+  BOOST_CHECK(builder.AddPart(3, 0, "a", t0) == Builder::AddResult::kPending);
+  BOOST_CHECK(builder.AddPart(3, 3, "b", t0) == Builder::AddResult::kCompleted);
+  BOOST_CHECK_EQUAL(builder.TakeCompleted().size(), 2);
+}
+
+} // namespace Devices
+} // namespace AliceO2
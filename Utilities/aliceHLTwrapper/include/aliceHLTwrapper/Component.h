@@ -58,6 +58,13 @@ class SystemInterface;
 ///                 0  HOMER format
 ///                 1  blocks in multiple messages
 ///                 2  blocks concatenated in one message (default)
+/// --trim-interval number of events between buffer trim checks
+///                 The i/o buffers grow to the high-water mark of the
+///                 processed events and are retained at that size for
+///                 allocation-free steady state processing. Every interval
+///                 the buffers are shrunk back to the peak usage of the
+///                 elapsed period to release memory after bursts; 0
+///                 disables trimming
 ///
 class Component {
 public:
@@ -97,6 +104,12 @@ private:
   /// container for handling the i/o buffers
   AliceO2::AliceHLT::MessageFormat mFormatHandler;
   int mEventCount;
+  /// peak output buffer usage within the current trim period
+  unsigned mOutputBufferPeakSize;
+  /// number of events between buffer trim checks, 0 disables trimming
+  int mTrimInterval;
+  /// events processed since the last trim check
+  int mEventsSinceTrim;
 };
 
 } // namespace hlt
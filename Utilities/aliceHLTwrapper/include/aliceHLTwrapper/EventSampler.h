@@ -21,11 +21,62 @@
 
 #include "FairMQDevice.h"
 #include <vector>
+#include <cstdint>
+#include <ostream>
 
 namespace ALICE {
 namespace HLT {
 class Component;
 
+/// @class LatencyHistogram
+/// In-memory latency histogram with logarithmic major buckets and linear
+/// sub-buckets (HDR style). Recording is a couple of shifts and one
+/// counter increment, so the full latency distribution can be collected
+/// at production rates; percentiles are extracted from the counters on
+/// demand with the resolution of the sub-bucket width.
+class LatencyHistogram {
+public:
+  LatencyHistogram();
+  ~LatencyHistogram();
+
+  /// number of linear sub-buckets per major (power of two) bucket
+  static const int SubBucketCnt = 16;
+
+  /// record one latency value in us
+  void add(uint64_t latencyUSeconds);
+
+  /// reset all counters
+  void clear();
+
+  /// number of recorded values
+  uint64_t getCount() const {return mCount;}
+  /// smallest recorded value in us
+  uint64_t getMin() const {return (mCount > 0)? mMin : 0;}
+  /// largest recorded value in us
+  uint64_t getMax() const {return mMax;}
+  /// mean of the recorded values in us
+  uint64_t getMean() const {return (mCount > 0)? mSum/mCount : 0;}
+
+  /// value at the specified percentile in us, e.g. 99.99
+  uint64_t getPercentile(double percentile) const;
+
+  /// print a compact snapshot of the distribution on one line
+  void printSnapshot(std::ostream& out) const;
+
+private:
+  /// counter index for a value
+  int bucketNdx(uint64_t value) const;
+  /// lower bound of the value range of a counter
+  uint64_t bucketValue(int ndx) const;
+
+  /// bucket counters
+  std::vector<uint64_t> mBuckets;
+  uint64_t mCount;
+  uint64_t mSum;
+  uint64_t mMin;
+  uint64_t mMax;
+};
+
 /// @class EventSampler
 /// Sampler device for Alice HLT events in FairRoot/ALFA.
 ///
@@ -65,7 +116,7 @@ public:
 
   /////////////////////////////////////////////////////////////////
   // device property identifier
-  enum { Id = FairMQDevice::Last, PollingTimeout, SkipProcessing, EventPeriod, InitialDelay, OutputFile, Last };
+  enum { Id = FairMQDevice::Last, PollingTimeout, SkipProcessing, EventPeriod, InitialDelay, OutputFile, LogSampleRatio, SnapshotPeriod, Last };
 
 protected:
 
@@ -81,7 +132,10 @@ private:
   int mPollingTimeout;       // period of polling on input sockets in ms
   int mSkipProcessing;       // skip component processing
   int mVerbosity;            // verbosity level
+  int mLogSampleRatio;       // write every nth latency sample to the latency log, 0 disables per-event output
+  int mSnapshotPeriod;       // period of compact histogram snapshots in ms, 0 disables
   std::string mOutputFile;   // output file for logging of latency
+  LatencyHistogram mLatencyHistogram; // latency distribution of all events
 };
 
 } // namespace hlt
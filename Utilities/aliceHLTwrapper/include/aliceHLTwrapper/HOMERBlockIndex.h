@@ -0,0 +1,118 @@
+//-*- Mode: C++ -*-
+
+#ifndef HOMERBLOCKINDEX_H
+#define HOMERBLOCKINDEX_H
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or	     *
+//* (at your option) any later version.					     *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   HOMERBlockIndex.h
+//  @author Matthias Richter
+//  @since  2016-09-18
+//  @brief  Index-first access to the blocks of a HOMER event
+
+#include "AliHLTHOMERData.h"
+#include <vector>
+#include <cstddef>
+
+class AliHLTMonitoringReader;
+
+namespace AliceO2 {
+namespace AliceHLT {
+
+/// @class HOMERBlockIndex
+/// Index-first access to the data blocks of a HOMER event.
+///
+/// The HOMER reader interface is sequential, every access goes back to the
+/// reader and FindBlockNdx re-scans the descriptor table. For large merged
+/// events with many consumers this index parses the descriptor table in
+/// one pass into a flat array of entries and groups the block indices by
+/// data type and origin.
+///
+/// After the build, all access is read-only on plain arrays, so blocks or
+/// whole type groups can be handed to worker threads for parallel
+/// downstream processing without synchronization and without touching the
+/// reader again. The index remains valid as long as the reader holds the
+/// current event.
+class HOMERBlockIndex {
+public:
+  /// default constructor
+  HOMERBlockIndex();
+  /// destructor
+  ~HOMERBlockIndex();
+
+  /// flat descriptor of one block of the current event
+  struct BlockEntry_t {
+    /// block index within the event
+    unsigned long mNdx;
+    /// data type id
+    homer_uint64 mType;
+    /// data origin id
+    homer_uint32 mOrigin;
+    /// data specification
+    homer_uint32 mSpecification;
+    /// pointer to the block payload
+    const void* mP;
+    /// size of the block payload in byte
+    unsigned long mSize;
+  };
+
+  /// build the index for the current event of the reader in one pass
+  /// over the descriptor table
+  /// @return number of indexed blocks, neg. error code on failure
+  int build(const AliHLTMonitoringReader& reader);
+
+  /// cleanup, capacity of the internal arrays is retained
+  void clear();
+
+  /// number of indexed blocks
+  unsigned long getBlockCnt() const {return mEntries.size();}
+
+  /// access to the flat entry array
+  const BlockEntry_t& getEntry(unsigned long ndx) const {return mEntries[ndx];}
+  const std::vector<BlockEntry_t>& getEntries() const {return mEntries;}
+
+  /// number of distinct (type, origin) groups of the current event
+  unsigned long getTypeCnt() const {return mTypeGroups.size();}
+
+  /// entry indices of the group with the specified type and origin, empty
+  /// list if no such blocks are in the event
+  const std::vector<unsigned long>& getBlocksOfType(homer_uint64 type, homer_uint32 origin) const;
+
+  /// type and origin of the group at the specified position, for iterating
+  /// over all groups of the event
+  int getType(unsigned long pos, homer_uint64& type, homer_uint32& origin) const;
+
+private:
+  // copy constructor prohibited
+  HOMERBlockIndex(const HOMERBlockIndex&);
+  // assignment operator prohibited
+  HOMERBlockIndex& operator=(const HOMERBlockIndex&);
+
+  /// group of blocks of the same data type and origin
+  struct TypeGroup_t {
+    homer_uint64 mType;
+    homer_uint32 mOrigin;
+    /// positions in the flat entry array
+    std::vector<unsigned long> mBlocks;
+  };
+
+  /// flat array of block entries in event order
+  std::vector<BlockEntry_t> mEntries;
+  /// block indices grouped by data type and origin
+  std::vector<TypeGroup_t> mTypeGroups;
+  /// returned for groups not in the event
+  std::vector<unsigned long> mEmptyGroup;
+};
+
+} // namespace AliceHLT
+} // namespace AliceO2
+#endif // HOMERBLOCKINDEX_H
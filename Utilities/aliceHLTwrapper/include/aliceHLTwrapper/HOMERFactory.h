@@ -27,6 +27,7 @@
  * See cxx source for full Copyright notice                               */
 
 #include "AliHLTDataTypes.h"
+#include <vector>
 class AliHLTHOMERReader;
 class AliHLTHOMERWriter;
 
@@ -129,6 +130,24 @@ class HOMERFactory {
    */
   int DeleteWriter(AliHLTHOMERWriter* pWriter);
 
+  /**
+   * Open a writer, reusing a pooled instance when available.
+   * Writers returned through ReleaseWriter are Clear()ed and kept for
+   * reuse, so their internal descriptor arrays survive across events and
+   * the per-event allocation of the writer object disappears.
+   * Note that readers cannot be pooled the same way: the reader
+   * implementation lives in the external HOMER library and provides no
+   * entry to rebind an instance to a new buffer.
+   */
+  AliHLTHOMERWriter* OpenWriterPooled();
+
+  /**
+   * Return a writer to the pool for reuse instead of deleting it.
+   * The writer is Clear()ed; when the pool is full the writer is
+   * deleted.
+   */
+  int ReleaseWriter(AliHLTHOMERWriter* pWriter);
+
  protected:
 
  private:
@@ -174,6 +193,12 @@ static  int fgLibraryStatus; //!transient
   /** library handle returned by dlopen */
   void* fHandle;
 
+  /** Clear()ed writer instances kept for reuse by OpenWriterPooled. */
+  std::vector<AliHLTHOMERWriter*> fWriterPool; //!transient
+
+  /** maximum number of writers kept in the pool */
+  static const unsigned fgkMaxPooledWriters; //!transient
+
   static const char* fgkLibraries[]; /// List of libraries to try and load.
   static int fgkLibRefCount[]; /// The library reference count to control when to unload the library.
 };
@@ -21,6 +21,8 @@
 
 #include "AliHLTDataTypes.h"
 #include "HOMERFactory.h"
+#include <cstddef>
+#include <unordered_map>
 #include <vector>
 #include <boost/signals2.hpp>
 
@@ -48,11 +50,15 @@ public:
   struct BufferDesc_t {
     unsigned char* mP;
     unsigned mSize;
+    // payload resides in an external buffer, e.g. the component output
+    // buffer, and can be wrapped for transport without copy
+    bool mExternal;
 
-    BufferDesc_t(unsigned char* p, unsigned size)
+    BufferDesc_t(unsigned char* p, unsigned size, bool external = false)
     {
       mP = p;
       mSize = size;
+      mExternal = external;
     }
   };
 
@@ -63,12 +69,23 @@ public:
     kOutputModeMultiPart,
     // all blocks as sequence of header and payload
     kOutputModeSequence,
+    // like multi-part mode, but the block payload is not copied; the
+    // descriptor table is built fresh and every payload is referenced in
+    // its original location, directly following the header part as a
+    // separate part
+    kOutputModeZeroCopy,
     kOutputModeLast
   };
 
   // cleanup internal buffers
+  // capacity of the buffers is retained so that steady state operation
+  // runs without allocations
   void clear();
 
+  // release the retained capacity of the internal buffers, to be called
+  // periodically to give back memory after bursts
+  void trim();
+
   // set output mode
   void setOutputMode(unsigned mode) {mOutputMode=mode;}
 
@@ -96,6 +113,50 @@ public:
     return mBlockDescriptors;
   }
 
+  /// key of the input block index: data type and specification as plain
+  /// integers, the string members of AliHLTComponentDataType are copied
+  /// into the integers byte by byte
+  struct BlockKey {
+    AliHLTUInt64_t mId;            // fDataType.fID as 64 bit integer
+    AliHLTUInt32_t mOrigin;        // fDataType.fOrigin as 32 bit integer
+    AliHLTUInt32_t mSpecification; // block specification
+
+    bool operator==(const BlockKey& other) const
+    {
+      return mId == other.mId && mOrigin == other.mOrigin && mSpecification == other.mSpecification;
+    }
+  };
+  struct BlockKeyHash {
+    std::size_t operator()(const BlockKey& key) const
+    {
+      // fold the three fields; the multipliers spread the small origin and
+      // specification values over the full width
+      std::size_t hash = static_cast<std::size_t>(key.mId);
+      hash ^= static_cast<std::size_t>(key.mOrigin) * 0x9e3779b97f4a7c15ULL;
+      hash ^= static_cast<std::size_t>(key.mSpecification) * 0xff51afd7ed558ccdULL;
+      return hash;
+    }
+  };
+
+  // fill a key from a block descriptor data type and specification
+  static BlockKey makeBlockKey(const AliHLTComponentDataType& dt, AliHLTUInt32_t specification);
+
+  // build the index over the current block descriptor list in one pass,
+  // dropping the index of the previous event; returns the number of
+  // indexed blocks
+  // lookups through the index are exact matches, a query with the HLT
+  // wildcard type has to scan the descriptor list instead
+  unsigned buildBlockIndex();
+
+  // indices (into getBlockDescriptors()) of the blocks matching data type
+  // and specification, NULL if there are none; O(1) in the number of
+  // blocks of the event
+  const std::vector<unsigned>* findBlocks(const AliHLTComponentDataType& dt, AliHLTUInt32_t specification) const;
+
+  // indices of the blocks matching the data type with any specification,
+  // NULL if there are none
+  const std::vector<unsigned>* findBlocksOfType(const AliHLTComponentDataType& dt) const;
+
   // create message payloads in the internal buffer and return list
   // of decriptors
   std::vector<BufferDesc_t> createMessages(const AliHLTComponentBlockData* blocks, unsigned count,
@@ -106,6 +167,11 @@ public:
   // from a buffer
   int readBlockSequence(AliHLTUInt8_t* buffer, unsigned size, std::vector<AliHLTComponentBlockData>& descriptorList) const;
 
+  // read a header message consisting of optional event data header and one
+  // block descriptor, with the payload in a separate buffer, as produced
+  // by the zero-copy output mode
+  int readDescriptorMessage(AliHLTUInt8_t* buffer, unsigned size, AliHLTUInt8_t* payload, unsigned payloadSize);
+
   // read message payload in HOMER format
   int readHOMERFormat(AliHLTUInt8_t* buffer, unsigned size, std::vector<AliHLTComponentBlockData>& descriptorList) const;
 
@@ -133,6 +199,14 @@ private:
   MessageFormat& operator=(const MessageFormat&);
 
   std::vector<AliHLTComponentBlockData> mBlockDescriptors;
+  /// index of mBlockDescriptors keyed by (data type, specification),
+  /// built by buildBlockIndex
+  std::unordered_map<BlockKey, std::vector<unsigned>, BlockKeyHash> mBlockIndex;
+  /// like mBlockIndex, keyed by data type only (specification wildcard)
+  std::unordered_map<BlockKey, std::vector<unsigned>, BlockKeyHash> mTypeIndex;
+  /// scratch descriptor array of readBlockSequence, reused across
+  /// messages to avoid per-message allocation
+  mutable std::vector<AliHLTComponentBlockData> mParseBuffer;
   /// internal buffer to assemble message data
   std::vector<AliHLTUInt8_t>            mDataBuffer;
   /// list of message payload descriptors
@@ -20,9 +20,29 @@
 //  @brief  FairRoot/ALFA interface to ALICE HLT code
 
 #include "AliHLTDataTypes.h"
+#include <cstddef>
 namespace ALICE {
 namespace HLT {
 
+/// One event of a batched processEvents call: plain aggregate mirroring
+/// the arguments of the per-event ProcessEvent entry. An interface
+/// library providing the optional batched entry (see processEvents) has
+/// to use a binary compatible layout.
+struct EventBatchCall {
+  const AliHLTComponentEventData* fEvtData;
+  const AliHLTComponentBlockData* fBlocks;
+  AliHLTComponentTriggerData* fTrigData;
+  AliHLTUInt8_t* fOutputPtr;
+  AliHLTUInt32_t* fSize;
+  AliHLTUInt32_t* fOutputBlockCnt;
+  AliHLTComponentBlockData** fOutputBlocks;
+  AliHLTComponentEventDoneData** fEdd;
+};
+
+/// function pointer of the optional batched processing entry of the
+/// interface library
+typedef int (*AliHLTExtFctProcessEvents)(AliHLTComponentHandle, EventBatchCall*, unsigned);
+
 /// @class SystemInterface
 /// Tool class for the ALICE HLT external interface defined in
 /// AliHLTDataTypes.h
@@ -86,6 +106,30 @@ public:
 			AliHLTUInt32_t* outputBlockCnt,	AliHLTComponentBlockData** outputBlocks,
 			AliHLTComponentEventDoneData** edd );
 
+  /** process a batch of events
+   *  The batched entry of the interface library, when provided, crosses
+   *  the dlopen boundary once for the whole batch instead of once per
+   *  event; the fixed per-call cost then amortizes over the batch. If
+   *  the library does not export the entry the batch is processed with
+   *  one per-event call per entry, so callers can batch unconditionally.
+   *  Processing stops at the first failing event.
+   *  @param handle component handle
+   *  @param events array of per-event call descriptions
+   *  @param count  number of events in the batch
+   *  @return 0 on success
+   */
+  int processEvents(AliHLTComponentHandle handle, EventBatchCall* events, unsigned count);
+
+  /** whether the loaded interface library provides the batched entry */
+  bool hasBatchProcessing() const { return mpAliHLTExtFctProcessEvents != NULL; }
+
+  /** suggested number of events per batch for a given average event size
+   *  Batches enough small events to amortize the fixed cost of the
+   *  external wrapper transition while keeping the aggregated payload
+   *  bounded, so large events go through one by one.
+   */
+  static unsigned suggestEventBatchSize(unsigned long averageEventSize);
+
   /** get the output data type
    */
   int getOutputDataType(AliHLTComponentHandle handle, AliHLTComponentDataType* dataType);
@@ -119,6 +163,7 @@ private:
   AliHLTExtFctCreateComponent   mpAliHLTExtFctCreateComponent;
   AliHLTExtFctDestroyComponent  mpAliHLTExtFctDestroyComponent;
   AliHLTExtFctProcessEvent      mpAliHLTExtFctProcessEvent;
+  AliHLTExtFctProcessEvents     mpAliHLTExtFctProcessEvents;
   AliHLTExtFctGetOutputDataType mpAliHLTExtFctGetOutputDataType;
   AliHLTExtFctGetOutputSize     mpAliHLTExtFctGetOutputSize;
 
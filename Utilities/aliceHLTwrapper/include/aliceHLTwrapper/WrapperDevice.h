@@ -21,6 +21,7 @@
 
 #include "FairMQDevice.h"
 #include <vector>
+#include <atomic>
 
 class FairMQMessage;
 
@@ -81,6 +82,10 @@ private:
   /// create a new message with data buffer of specified size
   unsigned char* createMessageBuffer(unsigned size);
 
+  /// release callback for zero-copy payload messages, the hint parameter
+  /// carries the device instance
+  static void releasePayload(void* data, void* hint);
+
   Component* mComponent;     // component instance
   std::vector<char*> mArgv;       // array of arguments for the component
   std::vector<std::unique_ptr<FairMQMessage>> mMessages; // array of output messages
@@ -95,6 +100,8 @@ private:
   int mMaxReadCycles;        // max number of read cycles in statistic period
   int mNSamples;             // number of samples in statistic period
   int mVerbosity;            // verbosity level
+
+  std::atomic<int> mPayloadsInFlight; // zero-copy payload messages not yet released by the transport
 };
 
 } // namespace hlt
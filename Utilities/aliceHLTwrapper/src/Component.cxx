@@ -41,6 +41,9 @@ Component::Component()
   , mProcessor(kEmptyHLTComponentHandle)
   , mFormatHandler()
   , mEventCount(-1)
+  , mOutputBufferPeakSize(0)
+  , mTrimInterval(1000)
+  , mEventsSinceTrim(0)
 {
 }
 
@@ -61,6 +64,7 @@ int Component::init(int argc, char** argv)
     {"msgsize",     required_argument, 0, 's'},
     {"output-mode", required_argument, 0, 'm'},
     {"instance-id", required_argument, 0, 'i'},
+    {"trim-interval", required_argument, 0, 't'},
     {0, 0, 0, 0}
   };
 
@@ -83,7 +87,7 @@ int Component::init(int argc, char** argv)
   int runNumber = 0;
 
   optind = 1; // indicate new start of scanning, especially when getop has been used in a higher layer already
-  while ((c = getopt_long(argc, argv, "l:c:p:r:s:m:i:", programOptions, &iOption)) != -1) {
+  while ((c = getopt_long(argc, argv, "l:c:p:r:s:m:i:t:", programOptions, &iOption)) != -1) {
     switch (c) {
       case 'l':
         componentLibrary = optarg;
@@ -111,6 +115,9 @@ int Component::init(int argc, char** argv)
         instanceId=optarg;
         break;
       }
+      case 't':
+        std::stringstream(optarg) >> mTrimInterval;
+        break;
       case '?':
         // TODO: more error handling
         break;
@@ -175,6 +182,24 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
   if (!mpSystem) return -ENOSYS;
   int iResult = 0;
 
+  // the i/o buffers grow to the high-water mark of the processed events
+  // and are retained at that size, steady state processing then runs
+  // without allocations; every trim interval the buffers are shrunk back
+  // to the peak usage of the elapsed period to release memory after
+  // bursts
+  // Note: this is the safe point to reallocate, data of the previous
+  // event has been handed over to the transport before the next call
+  if (mTrimInterval > 0 && ++mEventsSinceTrim >= mTrimInterval) {
+    if (mOutputBuffer.capacity() > mOutputBufferPeakSize) {
+      std::vector<AliHLTUInt8_t> trimmed;
+      trimmed.reserve(mOutputBufferPeakSize);
+      mOutputBuffer.swap(trimmed);
+    }
+    mFormatHandler.trim();
+    mOutputBufferPeakSize = 0;
+    mEventsSinceTrim = 0;
+  }
+
   unsigned outputBufferSize = 0;
 
   AliHLTComponentEventData evtData;
@@ -269,6 +294,10 @@ int Component::process(vector<MessageFormat::BufferDesc_t>& dataArray,
 
   } while (iResult == ENOSPC && --nofTrials > 0);
 
+  if (mOutputBuffer.size() > mOutputBufferPeakSize) {
+    mOutputBufferPeakSize = mOutputBuffer.size();
+  }
+
   // prepare output
   { // keep this after removing condition to preserve formatting
     AliHLTUInt8_t* pOutputBufferStart = &mOutputBuffer[0];
@@ -29,6 +29,8 @@
 #include <memory>
 #include <chrono>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
 
 using std::string;
 using std::vector;
@@ -43,6 +45,92 @@ const std::chrono::time_point<system_clock, PeriodDay> dayref=std::chrono::time_
 
 using namespace ALICE::HLT;
 
+LatencyHistogram::LatencyHistogram()
+  : mBuckets()
+  , mCount(0)
+  , mSum(0)
+  , mMin(0)
+  , mMax(0)
+{
+  // one major bucket for the values resolved by the sub-bucket count
+  // directly, plus one per additional power of two of the 64 bit range
+  mBuckets.resize((64 - 4 + 1)*SubBucketCnt, 0);
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+int LatencyHistogram::bucketNdx(uint64_t value) const
+{
+  // logarithmic major bucket from the position of the highest set bit,
+  // linear sub-bucket from the four bits below
+  if (value < SubBucketCnt) return value;
+  int major = 63;
+  while ((value & (uint64_t(1) << major)) == 0) major--;
+  int sub = (value >> (major - 4)) & (SubBucketCnt - 1);
+  return (major - 4 + 1)*SubBucketCnt + sub;
+}
+
+uint64_t LatencyHistogram::bucketValue(int ndx) const
+{
+  // lower bound of the value range of a counter
+  if (ndx < SubBucketCnt) return ndx;
+  int major = ndx/SubBucketCnt + 4 - 1;
+  int sub = ndx % SubBucketCnt;
+  return (uint64_t(1) << major) | (uint64_t(sub) << (major - 4));
+}
+
+void LatencyHistogram::add(uint64_t latencyUSeconds)
+{
+  // record one latency value
+  mBuckets[bucketNdx(latencyUSeconds)]++;
+  if (mCount == 0 || latencyUSeconds < mMin) mMin = latencyUSeconds;
+  if (latencyUSeconds > mMax) mMax = latencyUSeconds;
+  mSum += latencyUSeconds;
+  mCount++;
+}
+
+void LatencyHistogram::clear()
+{
+  std::fill(mBuckets.begin(), mBuckets.end(), 0);
+  mCount = 0;
+  mSum = 0;
+  mMin = 0;
+  mMax = 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+  // value at the specified percentile, resolution of the sub-bucket width
+  if (mCount == 0) return 0;
+  uint64_t rank = (uint64_t)((percentile/100.)*mCount);
+  if (rank >= mCount) rank = mCount - 1;
+  uint64_t accumulated = 0;
+  for (unsigned ndx = 0; ndx < mBuckets.size(); ndx++) {
+    accumulated += mBuckets[ndx];
+    if (accumulated > rank) {
+      uint64_t value = bucketValue(ndx);
+      return (value < mMax)? value : mMax;
+    }
+  }
+  return mMax;
+}
+
+void LatencyHistogram::printSnapshot(std::ostream& out) const
+{
+  // compact snapshot of the distribution on one line, all values in us
+  out << "count " << getCount()
+      << " min " << getMin()
+      << " mean " << getMean()
+      << " p50 " << getPercentile(50.)
+      << " p90 " << getPercentile(90.)
+      << " p99 " << getPercentile(99.)
+      << " p99.9 " << getPercentile(99.9)
+      << " p99.99 " << getPercentile(99.99)
+      << " max " << getMax();
+}
+
 EventSampler::EventSampler(int verbosity)
   : mEventPeriod(1000)
   , mInitialDelay(1000)
@@ -50,7 +138,10 @@ EventSampler::EventSampler(int verbosity)
   , mPollingTimeout(10)
   , mSkipProcessing(0)
   , mVerbosity(verbosity)
+  , mLogSampleRatio(1)
+  , mSnapshotPeriod(10000)
   , mOutputFile()
+  , mLatencyHistogram()
 {
 }
 
@@ -88,6 +179,9 @@ void EventSampler::Run()
   int nReadCycles=0;
 
   std::ofstream latencyLog(mOutputFile);
+  mLatencyHistogram.clear();
+  uint64_t nLatencySamples = 0;
+  system_clock::time_point lastSnapshot = system_clock::now();
 
   while (CheckCurrentState(RUNNING)) {
 
@@ -141,11 +235,28 @@ void EventSampler::Run()
           LOG(DEBUG) << "received event " << evtData->fEventID << " at " << seconds.count() << "s  " << useconds.count() << "us - latency " << value << unit;
         }
         latencyUSeconds+=latencySeconds*1000000; // max 4294s, should be enough for latency
-        if (latencyLog.is_open()) {
+        // every event goes into the histogram, the per-event text output
+        // is downsampled by the configured ratio to support high rates
+        mLatencyHistogram.add(latencyUSeconds);
+        if (latencyLog.is_open() && mLogSampleRatio > 0 &&
+            (nLatencySamples % mLogSampleRatio) == 0) {
           latencyLog << evtData->fEventID << " " << latencyUSeconds << endl;
         }
+        nLatencySamples++;
       }
     }
+
+    if (mSnapshotPeriod > 0 &&
+        std::chrono::duration_cast<std::chrono::milliseconds>(timestamp - lastSnapshot).count() >= mSnapshotPeriod) {
+      // compact snapshot of the latency distribution collected so far
+      std::ostringstream snapshot;
+      mLatencyHistogram.printSnapshot(snapshot);
+      LOG(INFO) << "latency " << snapshot.str();
+      if (latencyLog.is_open()) {
+        latencyLog << "# latency " << snapshot.str() << endl;
+      }
+      lastSnapshot = timestamp;
+    }
     inputMessages.clear();
     for (vector<int>::iterator mcit=inputMessageCntPerSocket.begin();
          mcit!=inputMessageCntPerSocket.end(); mcit++) {
@@ -153,6 +264,16 @@ void EventSampler::Run()
     }
   }
 
+  if (mLatencyHistogram.getCount() > 0) {
+    // final snapshot covering the complete run
+    std::ostringstream snapshot;
+    mLatencyHistogram.printSnapshot(snapshot);
+    LOG(INFO) << "latency " << snapshot.str();
+    if (latencyLog.is_open()) {
+      latencyLog << "# latency " << snapshot.str() << endl;
+    }
+  }
+
   if (latencyLog.is_open()) {
     latencyLog.close();
   }
@@ -205,6 +326,12 @@ void EventSampler::SetProperty(const int key, const int value)
   case SkipProcessing:
     mSkipProcessing = value;
     return;
+  case LogSampleRatio:
+    mLogSampleRatio = value;
+    return;
+  case SnapshotPeriod:
+    mSnapshotPeriod = value;
+    return;
   }
   return FairMQDevice::SetProperty(key, value);
 }
@@ -222,6 +349,10 @@ int EventSampler::GetProperty(const int key, const int default_)
     return mPollingTimeout;
   case SkipProcessing:
     return mSkipProcessing;
+  case LogSampleRatio:
+    return mLogSampleRatio;
+  case SnapshotPeriod:
+    return mSnapshotPeriod;
   }
   return FairMQDevice::GetProperty(key, default_);
 }
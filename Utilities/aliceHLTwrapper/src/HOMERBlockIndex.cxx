@@ -0,0 +1,105 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or	     *
+//* (at your option) any later version.					     *
+//*                                                                          *
+//* Primary Authors: Matthias Richter <richterm@scieq.net>                   *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   HOMERBlockIndex.cxx
+//  @author Matthias Richter
+//  @since  2016-09-18
+//  @brief  Index-first access to the blocks of a HOMER event
+
+#include "aliceHLTwrapper/HOMERBlockIndex.h"
+#include "aliceHLTwrapper/AliHLTHOMERReader.h"
+
+#include <cerrno>
+
+using namespace AliceO2::AliceHLT;
+
+HOMERBlockIndex::HOMERBlockIndex()
+  : mEntries()
+  , mTypeGroups()
+  , mEmptyGroup()
+{
+}
+
+HOMERBlockIndex::~HOMERBlockIndex()
+{
+}
+
+int HOMERBlockIndex::build(const AliHLTMonitoringReader& reader)
+{
+  // build the index for the current event of the reader in one pass over
+  // the descriptor table; reader accesses happen only here, all further
+  // access is read-only on the flat arrays
+  clear();
+  unsigned long count = reader.GetBlockCnt();
+  mEntries.reserve(count);
+  for (unsigned long ndx = 0; ndx < count; ndx++) {
+    BlockEntry_t entry;
+    entry.mNdx = ndx;
+    entry.mType = reader.GetBlockDataType(ndx);
+    entry.mOrigin = reader.GetBlockDataOrigin(ndx);
+    entry.mSpecification = reader.GetBlockDataSpec(ndx);
+    entry.mP = reader.GetBlockData(ndx);
+    entry.mSize = reader.GetBlockDataLength(ndx);
+    if (entry.mP == NULL && entry.mSize > 0) {
+      // invalid descriptor, the index would hand out dangling blocks
+      clear();
+      return -ENODATA;
+    }
+    mEntries.push_back(entry);
+
+    // insert into the group of the same type and origin; the number of
+    // distinct types per event is small, linear search on the flat group
+    // array beats a map here
+    unsigned long pos = 0;
+    for (; pos < mTypeGroups.size(); pos++) {
+      if (mTypeGroups[pos].mType == entry.mType &&
+          mTypeGroups[pos].mOrigin == entry.mOrigin) {
+        break;
+      }
+    }
+    if (pos == mTypeGroups.size()) {
+      mTypeGroups.push_back(TypeGroup_t());
+      mTypeGroups.back().mType = entry.mType;
+      mTypeGroups.back().mOrigin = entry.mOrigin;
+    }
+    mTypeGroups[pos].mBlocks.push_back(mEntries.size() - 1);
+  }
+
+  return mEntries.size();
+}
+
+void HOMERBlockIndex::clear()
+{
+  mEntries.clear();
+  mTypeGroups.clear();
+}
+
+const std::vector<unsigned long>& HOMERBlockIndex::getBlocksOfType(homer_uint64 type, homer_uint32 origin) const
+{
+  // entry indices of the group with the specified type and origin
+  for (unsigned long pos = 0; pos < mTypeGroups.size(); pos++) {
+    if (mTypeGroups[pos].mType == type &&
+        mTypeGroups[pos].mOrigin == origin) {
+      return mTypeGroups[pos].mBlocks;
+    }
+  }
+  return mEmptyGroup;
+}
+
+int HOMERBlockIndex::getType(unsigned long pos, homer_uint64& type, homer_uint32& origin) const
+{
+  // type and origin of the group at the specified position
+  if (pos >= mTypeGroups.size()) return -ENOENT;
+  type = mTypeGroups[pos].mType;
+  origin = mTypeGroups[pos].mOrigin;
+  return 0;
+}
@@ -57,6 +57,8 @@ int HOMERFactory::fgLibraryStatus=0;
 const char* HOMERFactory::fgkLibraries[] = {"libAliHLTHOMER.so", "libHOMER.so", NULL};
 // The size of the list of reference counts must be one less than fgkLibraries.
 int HOMERFactory::fgkLibRefCount[] = {0, 0};
+// writers kept for reuse per factory instance, see OpenWriterPooled
+const unsigned HOMERFactory::fgkMaxPooledWriters = 4;
 
 HOMERFactory::HOMERFactory()
   :
@@ -66,7 +68,8 @@ HOMERFactory::HOMERFactory()
   fFctDeleteReader(NULL),
   fFctCreateWriter(NULL),
   fFctDeleteWriter(NULL),
-  fLoadedLib(NULL)
+  fLoadedLib(NULL),
+  fWriterPool()
 {
   // constructor
   // 
@@ -83,6 +86,15 @@ HOMERFactory::~HOMERFactory()
   // stabilize the runtime memory layout of AliRoot in an attemp to get control
   // over memory corruptions
   //  UnloadHOMERLibrary();
+
+  // delete the pooled writer instances while the deletion entry of the
+  // library is still available
+  for (unsigned i = 0; i < fWriterPool.size(); i++) {
+    if (fFctDeleteWriter != NULL) {
+      ((AliHLTHOMERWriterDelete_t)fFctDeleteWriter)(fWriterPool[i]);
+    }
+  }
+  fWriterPool.clear();
 }
 
 AliHLTHOMERReader* HOMERFactory::OpenReader(const char* hostname, unsigned short port )
@@ -194,6 +206,31 @@ int HOMERFactory::DeleteWriter(AliHLTHOMERWriter* pWriter)
   return 0;
 }
 
+AliHLTHOMERWriter* HOMERFactory::OpenWriterPooled()
+{
+  // open a writer, reusing a pooled instance when available
+  // pooled writers have been Clear()ed on release, their internal
+  // descriptor arrays stay allocated across events
+  if (!fWriterPool.empty()) {
+    AliHLTHOMERWriter* pWriter = fWriterPool.back();
+    fWriterPool.pop_back();
+    return pWriter;
+  }
+  return OpenWriter();
+}
+
+int HOMERFactory::ReleaseWriter(AliHLTHOMERWriter* pWriter)
+{
+  // return a writer to the pool for reuse instead of deleting it
+  if (pWriter == NULL) return -EINVAL;
+  if (fWriterPool.size() >= fgkMaxPooledWriters) {
+    return DeleteWriter(pWriter);
+  }
+  pWriter->Clear();
+  fWriterPool.push_back(pWriter);
+  return 0;
+}
+
 int HOMERFactory::LoadHOMERLibrary()
 {
   // delete a writer
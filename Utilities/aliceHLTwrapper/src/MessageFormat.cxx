@@ -38,6 +38,7 @@ using std::vector;
 
 MessageFormat::MessageFormat()
   : mBlockDescriptors()
+  , mParseBuffer()
   , mDataBuffer()
   , mMessages()
   , mpFactory(NULL)
@@ -55,11 +56,81 @@ MessageFormat::~MessageFormat()
 void MessageFormat::clear()
 {
   mBlockDescriptors.clear();
+  mBlockIndex.clear();
+  mTypeIndex.clear();
   mDataBuffer.clear();
   mMessages.clear();
   mListEvtData.clear();
 }
 
+void MessageFormat::trim()
+{
+  // release the retained capacity of the internal buffers, to be called
+  // periodically to give back memory after bursts
+  vector<AliHLTComponentBlockData>().swap(mBlockDescriptors);
+  std::unordered_map<BlockKey, vector<unsigned>, BlockKeyHash>().swap(mBlockIndex);
+  std::unordered_map<BlockKey, vector<unsigned>, BlockKeyHash>().swap(mTypeIndex);
+  vector<AliHLTComponentBlockData>().swap(mParseBuffer);
+  vector<AliHLTUInt8_t>().swap(mDataBuffer);
+  vector<BufferDesc_t>().swap(mMessages);
+  vector<AliHLTComponentEventData>().swap(mListEvtData);
+}
+
+MessageFormat::BlockKey MessageFormat::makeBlockKey(const AliHLTComponentDataType& dt,
+                                                    AliHLTUInt32_t specification)
+{
+  // fill a key from a block descriptor data type and specification
+  BlockKey key;
+  key.mId = 0;
+  key.mOrigin = 0;
+  key.mSpecification = specification;
+  memcpy(&key.mId, dt.fID,
+         sizeof(key.mId) > kAliHLTComponentDataTypefIDsize ? kAliHLTComponentDataTypefIDsize : sizeof(key.mId));
+  memcpy(&key.mOrigin, dt.fOrigin,
+         sizeof(key.mOrigin) > kAliHLTComponentDataTypefOriginSize ? kAliHLTComponentDataTypefOriginSize
+                                                                   : sizeof(key.mOrigin));
+  return key;
+}
+
+unsigned MessageFormat::buildBlockIndex()
+{
+  // build the index over the current block descriptor list in one pass
+  // every block is entered under its full (data type, specification) key
+  // and under the type-only key, so both exact and any-specification
+  // lookups are O(1) afterwards; with many blocks of one type (e.g. the
+  // 216 TPC sector/patch blocks) this replaces a scan of the whole list
+  // per query
+  mBlockIndex.clear();
+  mTypeIndex.clear();
+  unsigned count = mBlockDescriptors.size();
+  mBlockIndex.reserve(count);
+  mTypeIndex.reserve(count);
+  for (unsigned i = 0; i < count; i++) {
+    BlockKey key = makeBlockKey(mBlockDescriptors[i].fDataType, mBlockDescriptors[i].fSpecification);
+    mBlockIndex[key].push_back(i);
+    key.mSpecification = 0;
+    mTypeIndex[key].push_back(i);
+  }
+  return count;
+}
+
+const vector<unsigned>* MessageFormat::findBlocks(const AliHLTComponentDataType& dt,
+                                                  AliHLTUInt32_t specification) const
+{
+  // indices of the blocks matching data type and specification
+  auto entry = mBlockIndex.find(makeBlockKey(dt, specification));
+  if (entry == mBlockIndex.end()) return NULL;
+  return &entry->second;
+}
+
+const vector<unsigned>* MessageFormat::findBlocksOfType(const AliHLTComponentDataType& dt) const
+{
+  // indices of the blocks matching the data type with any specification
+  auto entry = mTypeIndex.find(makeBlockKey(dt, 0));
+  if (entry == mTypeIndex.end()) return NULL;
+  return &entry->second;
+}
+
 int MessageFormat::addMessage(AliHLTUInt8_t* buffer, unsigned size)
 {
   // add message
@@ -124,13 +195,23 @@ int MessageFormat::addMessages(const vector<BufferDesc_t>& list)
       int result = addMessage(data->mP, data->mSize);
       if (result >= 0)
         totalCount += result;
-      else {
+      else if ((data + 1) != list.end() &&
+               readDescriptorMessage(data->mP, data->mSize, (data + 1)->mP, (data + 1)->mSize) > 0) {
+        // header part followed by a separate payload part, as produced by
+        // the zero-copy output mode; the payload part is consumed together
+        // with its header
+        data++; i++;
+        totalCount++;
+      } else {
         cerr << "warning: no valid data blocks in message " << i << endl;
       }
     } else {
       cerr << "warning: ignoring message " << i << " with payload of size 0" << endl;
     }
   }
+  // index the collected blocks; the index has to be rebuilt if the
+  // descriptor list is modified afterwards
+  buildBlockIndex();
   return 0;
 }
 
@@ -141,7 +222,11 @@ int MessageFormat::readBlockSequence(AliHLTUInt8_t* buffer, unsigned size,
   // from a buffer
   if (buffer == NULL) return 0;
   unsigned position = 0;
-  vector<AliHLTComponentBlockData> input;
+  // the scratch array is a member reused across messages, all blocks of a
+  // message are collected there first so that nothing is added to the
+  // descriptor list if the buffer turns out not to be a valid sequence
+  vector<AliHLTComponentBlockData>& input = mParseBuffer;
+  input.clear();
   while (position + sizeof(AliHLTComponentBlockData) < size) {
     AliHLTComponentBlockData* p = reinterpret_cast<AliHLTComponentBlockData*>(buffer + position);
     if (p->fStructSize == 0 ||                         // no valid header
@@ -170,6 +255,41 @@ int MessageFormat::readBlockSequence(AliHLTUInt8_t* buffer, unsigned size,
   return input.size();
 }
 
+int MessageFormat::readDescriptorMessage(AliHLTUInt8_t* buffer, unsigned size,
+                                         AliHLTUInt8_t* payload, unsigned payloadSize)
+{
+  // read a header message consisting of optional event data header and one
+  // block descriptor, with the payload in a separate buffer, as produced
+  // by the zero-copy output mode
+  if (buffer == NULL) return -EINVAL;
+  unsigned position = 0;
+  AliHLTComponentEventData* evtData = reinterpret_cast<AliHLTComponentEventData*>(buffer + position);
+  if (position + sizeof(AliHLTComponentEventData) <= size &&
+      evtData->fStructSize == sizeof(AliHLTComponentEventData)) {
+    position += sizeof(AliHLTComponentEventData);
+  } else {
+    evtData = NULL;
+  }
+  if (position + sizeof(AliHLTComponentBlockData) != size) {
+    // a header message contains exactly one block descriptor
+    return -ENODATA;
+  }
+  AliHLTComponentBlockData* p = reinterpret_cast<AliHLTComponentBlockData*>(buffer + position);
+  if (p->fStructSize != sizeof(AliHLTComponentBlockData) ||
+      p->fSize != payloadSize) {
+    // no valid header or mismatch with the payload part
+    return -ENODATA;
+  }
+  int result = 0;
+  if (evtData && (result = insertEvtData(*evtData)) < 0) {
+    return result;
+  }
+  mBlockDescriptors.push_back(*p);
+  mBlockDescriptors.back().fPtr = (payloadSize > 0)? payload : NULL;
+  mBlockDescriptors.back().fOffset = 0;
+  return 1;
+}
+
 int MessageFormat::readHOMERFormat(AliHLTUInt8_t* buffer, unsigned size,
                                    vector<AliHLTComponentBlockData>& descriptorList) const
 {
@@ -182,6 +302,7 @@ int MessageFormat::readHOMERFormat(AliHLTUInt8_t* buffer, unsigned size,
   unsigned nofBlocks = 0;
   if (reader->ReadNextEvent() == 0) {
     nofBlocks = reader->GetBlockCnt();
+    descriptorList.reserve(descriptorList.size() + nofBlocks);
     for (unsigned i = 0; i < nofBlocks; i++) {
       AliHLTComponentBlockData block;
       memset(&block, 0, sizeof(AliHLTComponentBlockData));
@@ -233,7 +354,9 @@ vector<MessageFormat::BufferDesc_t> MessageFormat::createMessages(const AliHLTCo
       memcpy(pTarget + offset, &evtData, sizeof(evtData));
       offset+=sizeof(evtData);
       pWriter->Copy(pTarget + offset, 0, 0, 0, 0);
-      mpFactory->DeleteWriter(pWriter);
+      // hand the writer back to the pool, its descriptor arrays are
+      // reused for the next event
+      mpFactory->ReleaseWriter(pWriter);
       offset+=payloadSize;
       mMessages.push_back(MessageFormat::BufferDesc_t(pTarget, offset));
     }
@@ -334,6 +457,63 @@ vector<MessageFormat::BufferDesc_t> MessageFormat::createMessages(const AliHLTCo
       // send one single descriptor for all concatenated blocks
       mMessages.push_back(MessageFormat::BufferDesc_t(pTarget, offset));
     }
+  } else if (mOutputMode == kOutputModeZeroCopy) {
+    // only the descriptor table is built fresh, the payload of every block
+    // stays in its original location, e.g. the component output buffer,
+    // and is referenced as external message for the device to wrap for
+    // transport with a release callback instead of copying
+    //
+    // wire format like multi part mode, but the header of a block (event
+    // data structure for the first block, and the block descriptor) is a
+    // part of its own, directly followed by a separate part with the
+    // payload
+    AliHLTUInt32_t position = mDataBuffer.size();
+    if (cbAllocate==nullptr) {
+      // all headers are built in the internal buffer, resized to the full
+      // size at once to keep the already scheduled pointers valid
+      mDataBuffer.resize(position + sizeof(evtData) + count * sizeof(AliHLTComponentBlockData));
+    }
+    unsigned bi = 0;
+    const auto* pOutputBlock = pOutputBlocks;
+    do {
+      auto msgSize = (bi==0?sizeof(evtData):0) + (bi<count?sizeof(AliHLTComponentBlockData):0);
+      auto pTarget=&mDataBuffer[position];
+      if (cbAllocate!=nullptr) {
+	// use callback to create target
+	pTarget=*(*cbAllocate)(msgSize);
+	if (pTarget==nullptr) {
+	  throw std::bad_alloc();
+	}
+      }
+      AliHLTUInt32_t offset = 0;
+      if (bi==0) {
+	memcpy(pTarget + offset, &evtData, sizeof(evtData));
+	if (evtData.fBlockCnt>1) {
+	  // like in multi part mode, there is only one block per header part
+	  auto* pEvtData = reinterpret_cast<AliHLTComponentEventData*>(pTarget + offset);
+	  pEvtData->fBlockCnt=1;
+	}
+	offset+=sizeof(evtData);
+      }
+      if (bi<count) {
+	auto* bdTarget = reinterpret_cast<AliHLTComponentBlockData*>(pTarget + offset);
+	memcpy(bdTarget, pOutputBlock, sizeof(AliHLTComponentBlockData));
+	bdTarget->fOffset = 0;
+	bdTarget->fPtr = NULL;
+	offset += sizeof(AliHLTComponentBlockData);
+      }
+      mMessages.push_back(MessageFormat::BufferDesc_t(pTarget, offset));
+      position+=offset;
+      if (bi<count) {
+	// the payload is not copied, the original location is referenced
+	// and flagged external
+	AliHLTUInt8_t* pData = reinterpret_cast<AliHLTUInt8_t*>(pOutputBlock->fPtr);
+	pData += pOutputBlock->fOffset;
+	mMessages.push_back(MessageFormat::BufferDesc_t(pData, pOutputBlock->fSize, true));
+	pOutputBlock++;
+      }
+    }
+    while (++bi<count);
   } else {
     // invalid output mode
     cerr << "error ALICE::HLT::Component: invalid output mode " << mOutputMode << endl;
@@ -348,7 +528,7 @@ AliHLTHOMERWriter* MessageFormat::createHOMERFormat(const AliHLTComponentBlockDa
   int iResult = 0;
   if (mpFactory == NULL) const_cast<MessageFormat*>(this)->mpFactory = new ALICE::HLT::HOMERFactory;
   if (!mpFactory) return NULL;
-  unique_ptr<AliHLTHOMERWriter> writer(mpFactory->OpenWriter());
+  unique_ptr<AliHLTHOMERWriter> writer(mpFactory->OpenWriterPooled());
   if (writer.get() == NULL) return NULL;
 
   homer_uint64 homerHeader[kCount_64b_Words];
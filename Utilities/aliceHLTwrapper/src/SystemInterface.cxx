@@ -37,6 +37,7 @@ SystemInterface::SystemInterface()
   , mpAliHLTExtFctCreateComponent(NULL)
   , mpAliHLTExtFctDestroyComponent(NULL)
   , mpAliHLTExtFctProcessEvent(NULL)
+  , mpAliHLTExtFctProcessEvents(NULL)
   , mpAliHLTExtFctGetOutputDataType(NULL)
   , mpAliHLTExtFctGetOutputSize(NULL)
   , mEnvironment()
@@ -82,9 +83,17 @@ const char* gInterfaceCallSignatures[] = {
   // int AliHLTAnalysisGetOutputSize( AliHLTComponentHandle handle, unsigned long* constEventBase, unsigned long* constBlockBase, double* inputBlockMultiplier)
   "int AliHLTAnalysisGetOutputSize(AliHLTComponentHandle,unsigned long*,unsigned long*,double*)",
 
+  // optional batched entry, see SystemInterface::processEvents
+  // int AliHLTAnalysisProcessEvents( AliHLTComponentHandle handle, EventBatchCall* events, unsigned count)
+  "int AliHLTAnalysisProcessEvents(AliHLTComponentHandle,EventBatchCall*,unsigned)",
+
   NULL
 };
 
+// signatures from this index on are optional extensions, their absence in
+// the interface library is not an error
+const int gFirstOptionalCallSignature = 9;
+
 int SystemInterface::initSystem(unsigned long runNo)
 {
   /// init the system: load interface libraries and read function pointers
@@ -116,7 +125,11 @@ int SystemInterface::initSystem(unsigned long runNo)
   for (int i = 0; arrayCalls[i] != NULL; i++) {
     AliHLTExtFctInitSystem call = (AliHLTExtFctInitSystem) (*fctGetSystemCall)(arrayCalls[i]);
     if (call == NULL) {
-      cerr << "error: can not find function signature '" << arrayCalls[i] << "' in " << libraryPath.c_str() << endl;
+      if (i >= gFirstOptionalCallSignature) {
+        cout << "optional function signature '" << arrayCalls[i] << "' not provided by " << libraryPath.c_str() << endl;
+      } else {
+        cerr << "error: can not find function signature '" << arrayCalls[i] << "' in " << libraryPath.c_str() << endl;
+      }
     } else {
       cout << "function '" << arrayCalls[i] << "' loaded from " << libraryPath.c_str() << endl;
       switch (i) {
@@ -147,6 +160,9 @@ int SystemInterface::initSystem(unsigned long runNo)
         case 8:
           mpAliHLTExtFctGetOutputSize = (AliHLTExtFctGetOutputSize)call;
           break;
+        case 9:
+          mpAliHLTExtFctProcessEvents = (AliHLTExtFctProcessEvents)call;
+          break;
         default:
           cerr << "error: number of function signatures does not match expected number of functions" << endl;
       }
@@ -218,6 +234,46 @@ int SystemInterface::processEvent(AliHLTComponentHandle handle,
 				       outputPtr, size, outputBlockCnt, outputBlocks, edd);
 }
 
+int SystemInterface::processEvents(AliHLTComponentHandle handle, EventBatchCall* events, unsigned count)
+{
+  // process a batch of events in one transition across the dlopen boundary
+  // when the interface library provides the batched entry; the per-call
+  // cost then amortizes over the batch. Libraries without the entry get
+  // one per-event call per entry, so callers can batch unconditionally
+  if (count == 0) return 0;
+  if (events == NULL) return -EINVAL;
+  if (mpAliHLTExtFctProcessEvents) {
+    return (*mpAliHLTExtFctProcessEvents)(handle, events, count);
+  }
+  if (!mpAliHLTExtFctProcessEvent) return -ENOSYS;
+  for (unsigned i = 0; i < count; i++) {
+    int iResult = (*mpAliHLTExtFctProcessEvent)(handle, events[i].fEvtData, events[i].fBlocks,
+                                                events[i].fTrigData, events[i].fOutputPtr, events[i].fSize,
+                                                events[i].fOutputBlockCnt, events[i].fOutputBlocks,
+                                                events[i].fEdd);
+    if (iResult != 0) {
+      // stop at the first failing event, the entries processed so far
+      // carry their results
+      return iResult;
+    }
+  }
+  return 0;
+}
+
+unsigned SystemInterface::suggestEventBatchSize(unsigned long averageEventSize)
+{
+  // adapt the batch length to the event size: batch enough small events
+  // to amortize the fixed cost of the external wrapper transition, but
+  // keep the aggregated payload bounded so large events go one by one
+  const unsigned long kPayloadBudget = 8 * 1024 * 1024;
+  const unsigned kMaxBatchSize = 64;
+  if (averageEventSize == 0) return kMaxBatchSize;
+  unsigned long batchSize = kPayloadBudget / averageEventSize;
+  if (batchSize < 1) return 1;
+  if (batchSize > kMaxBatchSize) return kMaxBatchSize;
+  return batchSize;
+}
+
 int SystemInterface::getOutputDataType(AliHLTComponentHandle handle, AliHLTComponentDataType* dataType)
 {
   if (!mpAliHLTExtFctGetOutputDataType) return -ENOSYS;
@@ -241,6 +297,7 @@ void SystemInterface::clear(const char* /*option*/)
   mpAliHLTExtFctCreateComponent   = NULL;
   mpAliHLTExtFctDestroyComponent  = NULL;
   mpAliHLTExtFctProcessEvent      = NULL;
+  mpAliHLTExtFctProcessEvents     = NULL;
   mpAliHLTExtFctGetOutputDataType = NULL;
   mpAliHLTExtFctGetOutputSize     = NULL;
 }
@@ -59,6 +59,7 @@ WrapperDevice::WrapperDevice(int argc, char** argv, int verbosity)
   , mMaxReadCycles(-1)
   , mNSamples(-1)
   , mVerbosity(verbosity)
+  , mPayloadsInFlight(0)
 {
   mArgv.insert(mArgv.end(), argv, argv+argc);
 }
@@ -207,6 +208,13 @@ void WrapperDevice::Run()
       cbsignal.connect([this](unsigned int size){return this->createMessageBuffer(size);} );
       mMessages.clear();
 
+      // the component reuses its output buffer, processing must not start
+      // before the transport has released all zero-copy payloads of the
+      // previous event
+      while (mPayloadsInFlight > 0) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+      }
+
       // call the component
       if ((iResult=mComponent->process(dataArray, &cbsignal))<0) {
         LOG(ERROR) << "component processing failed with error code " << iResult;
@@ -230,7 +238,28 @@ void WrapperDevice::Run()
               break;
             }
           }
-          if (omsg==nullptr) {
+          if (omsg==nullptr && opayload.mExternal) {
+            // wrap the payload residing in the component output buffer
+            // without copy; the release callback keeps track of the
+            // messages in flight, the buffer is only reused after all of
+            // them have been released by the transport
+            unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
+            if (msg.get()) {
+              mPayloadsInFlight++;
+              msg->Rebuild(opayload.mP, opayload.mSize, &WrapperDevice::releasePayload, this);
+              if (mVerbosity > 2) {
+                LOG(DEBUG) << "scheduling zero-copy message of size " << opayload.mSize;
+              }
+              mMessages.push_back(move(msg));
+              continue;
+            } else {
+              if (errorCount == maxError && errorCount++ > 0)
+                LOG(ERROR) << "persistent error, suppressing further output";
+              else if (errorCount++ < maxError)
+                LOG(ERROR) << "can not get output message from framework";
+              iResult = -ENOMSG;
+            }
+          } else if (omsg==nullptr) {
             unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
             if (msg.get()) {
               msg->Rebuild(opayload.mSize);
@@ -347,3 +376,14 @@ unsigned char* WrapperDevice::createMessageBuffer(unsigned size)
   mMessages.push_back(move(msg));
   return reinterpret_cast<AliHLTUInt8_t*>(mMessages.back()->GetData());
 }
+
+void WrapperDevice::releasePayload(void* /*data*/, void* hint)
+{
+  /// release callback for zero-copy payload messages; the data is owned by
+  /// the component output buffer, nothing to be deallocated here, only the
+  /// bookkeeping of messages in flight is updated
+  WrapperDevice* device = reinterpret_cast<WrapperDevice*>(hint);
+  if (device) {
+    device->mPayloadsInFlight--;
+  }
+}
@@ -144,6 +144,8 @@ int main(int argc, char** argv)
   int eventPeriod = -1;
   int initialDelay = -1;
   int skipProcessing = 0;
+  int logSampleRatio = -1;
+  int snapshotPeriod = -1;
   bool bUseDDS = false;
 
   static struct option programOptions[] = {
@@ -156,6 +158,8 @@ int main(int argc, char** argv)
     { "polltimeout", required_argument, 0, '1' }, // polling timeout of the device in ms
     { "eventperiod", required_argument, 0, '2' }, // event period in us
     { "initialdelay",required_argument, 0, '3' }, // initial delay in ms
+    { "sample-ratio",required_argument, 0, '6' }, // write every nth latency sample to the log
+    { "snapshot-period",required_argument, 0, '7' }, // period of histogram snapshots in ms
     { "dry-run",     no_argument      , 0, 'n' }, // skip the component processing
     { "dds",         no_argument      , 0, 'd' }, // run in dds mode
     { 0, 0, 0, 0 }
@@ -244,6 +248,12 @@ int main(int argc, char** argv)
       case '3':
         std::stringstream(optarg) >> initialDelay;
         break;
+      case '6':
+        std::stringstream(optarg) >> logSampleRatio;
+        break;
+      case '7':
+        std::stringstream(optarg) >> snapshotPeriod;
+        break;
       case 'n':
         skipProcessing = 1;
         break;
@@ -310,6 +320,8 @@ int main(int argc, char** argv)
     cout << "        --poll-period,-p             period_in_ms" << endl;
     cout << "        --loginterval,-l             period_in_ms" << endl;
     cout << "        --verbosity,-v 0xhexval      verbosity level" << endl;
+    cout << "        --sample-ratio               write every nth latency sample to the log, 0 disables" << endl;
+    cout << "        --snapshot-period            period of latency histogram snapshots in ms, 0 disables" << endl;
     cout << "        --dry-run,-n                 skip the component processing" << endl;
     cout << "        Multiple slots can be defined by --input/--output options" << endl;
     cout << "        Sampler will send the event header on all outputs, inputs are treated as" << endl;
@@ -355,6 +367,8 @@ int main(int argc, char** argv)
     if (eventPeriod > 0) device.SetProperty(ALICE::HLT::EventSampler::EventPeriod, eventPeriod);
     if (initialDelay > 0) device.SetProperty(ALICE::HLT::EventSampler::InitialDelay, initialDelay);
     if (skipProcessing) device.SetProperty(ALICE::HLT::EventSampler::SkipProcessing, skipProcessing);
+    if (logSampleRatio >= 0) device.SetProperty(ALICE::HLT::EventSampler::LogSampleRatio, logSampleRatio);
+    if (snapshotPeriod >= 0) device.SetProperty(ALICE::HLT::EventSampler::SnapshotPeriod, snapshotPeriod);
     device.SetProperty(ALICE::HLT::EventSampler::OutputFile, outputFile);
     for (unsigned iInput = 0; iInput < numInputs; iInput++) {
       FairMQChannel inputChannel(inputSockets[iInput].type.c_str(), inputSockets[iInput].method.c_str(), inputSockets[iInput].address.c_str());
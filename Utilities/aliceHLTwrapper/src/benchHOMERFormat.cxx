@@ -0,0 +1,118 @@
+//****************************************************************************
+//* This file is free software: you can redistribute it and/or modify        *
+//* it under the terms of the GNU General Public License as published by     *
+//* the Free Software Foundation, either version 3 of the License, or	     *
+//* (at your option) any later version.					     *
+//*                                                                          *
+//* The authors make no claims about the suitability of this software for    *
+//* any purpose. It is provided "as is" without express or implied warranty. *
+//****************************************************************************
+
+//  @file   benchHOMERFormat.cxx
+//  @brief  Benchmark of events/second through the HOMER format layer
+//
+//  Formats synthetic events into HOMER format and parses them back
+//  through MessageFormat, timing both directions separately. The HOMER
+//  reader and writer objects come from the dynamically loaded HOMER
+//  library, so the benchmark needs a HOMER installation at runtime; it
+//  exercises the pooled writer reuse of HOMERFactory on the send side
+//  and the per-event reader creation on the receive side.
+//
+//  Usage: benchHOMERFormat [nevents] [nblocks] [blocksize]
+
+#include "aliceHLTwrapper/MessageFormat.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace AliceO2::AliceHLT;
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::vector;
+using TimeScale = std::chrono::milliseconds;
+
+int main(int argc, char** argv)
+{
+  unsigned nofEvents = 1000;
+  unsigned nofBlocks = 216; // TPC sector/patch count, the typical hard case
+  unsigned blockSize = 1024;
+  if (argc > 1) nofEvents = atoi(argv[1]);
+  if (argc > 2) nofBlocks = atoi(argv[2]);
+  if (argc > 3) blockSize = atoi(argv[3]);
+  if (nofEvents == 0 || nofBlocks == 0 || blockSize == 0) {
+    cerr << "usage: benchHOMERFormat [nevents] [nblocks] [blocksize]" << endl;
+    return 1;
+  }
+
+  // synthetic input: nofBlocks blocks of blockSize bytes
+  vector<AliHLTUInt8_t> payload(nofBlocks * blockSize);
+  for (unsigned i = 0; i < payload.size(); i++) payload[i] = i & 0xff;
+  vector<AliHLTComponentBlockData> blocks(nofBlocks);
+  for (unsigned i = 0; i < nofBlocks; i++) {
+    memset(&blocks[i], 0, sizeof(AliHLTComponentBlockData));
+    blocks[i].fStructSize = sizeof(AliHLTComponentBlockData);
+    blocks[i].fDataType.fStructSize = sizeof(AliHLTComponentDataType);
+    memcpy(blocks[i].fDataType.fID, "DUMMYDAT", kAliHLTComponentDataTypefIDsize);
+    memcpy(blocks[i].fDataType.fOrigin, "TST ", kAliHLTComponentDataTypefOriginSize);
+    blocks[i].fSpecification = i;
+    blocks[i].fPtr = &payload[i * blockSize];
+    blocks[i].fSize = blockSize;
+  }
+
+  AliHLTComponentEventData evtData;
+  memset(&evtData, 0, sizeof(evtData));
+  evtData.fStructSize = sizeof(evtData);
+  evtData.fBlockCnt = nofBlocks;
+
+  MessageFormat sender;
+  sender.setOutputMode(MessageFormat::kOutputModeHOMER);
+  MessageFormat receiver;
+
+  // send direction: format the blocks into a HOMER message per event
+  auto startFormat = std::chrono::system_clock::now();
+  unsigned messageSize = 0;
+  for (unsigned event = 0; event < nofEvents; event++) {
+    evtData.fEventID = event;
+    vector<MessageFormat::BufferDesc_t> messages =
+      sender.createMessages(&blocks[0], nofBlocks, nofBlocks * blockSize, evtData);
+    if (messages.size() != 1) {
+      cerr << "error: HOMER formatting failed, the benchmark needs the "
+           << "HOMER library (libAliHLTHOMER.so) at runtime" << endl;
+      return 1;
+    }
+    messageSize = messages[0].mSize;
+  }
+  auto durationFormat =
+    std::chrono::duration_cast<TimeScale>(std::chrono::system_clock::now() - startFormat);
+
+  // receive direction: parse the HOMER message back into block descriptors
+  evtData.fEventID = 0;
+  vector<MessageFormat::BufferDesc_t> messages =
+    sender.createMessages(&blocks[0], nofBlocks, nofBlocks * blockSize, evtData);
+  auto startParse = std::chrono::system_clock::now();
+  for (unsigned event = 0; event < nofEvents; event++) {
+    receiver.clear();
+    if (receiver.addMessage(messages[0].mP, messages[0].mSize) < 0 ||
+        receiver.getBlockDescriptors().size() != nofBlocks) {
+      cerr << "error: failed to parse HOMER message" << endl;
+      return 1;
+    }
+  }
+  auto durationParse =
+    std::chrono::duration_cast<TimeScale>(std::chrono::system_clock::now() - startParse);
+
+  auto rate = [nofEvents](TimeScale duration) {
+    return duration.count() > 0 ? (nofEvents * 1000.) / duration.count() : 0.;
+  };
+  cout << nofEvents << " event(s), " << nofBlocks << " block(s) of " << blockSize
+       << " byte(s), message size " << messageSize << endl;
+  cout << "format: " << durationFormat.count() << " ms, " << rate(durationFormat)
+       << " events/s" << endl;
+  cout << "parse:  " << durationParse.count() << " ms, " << rate(durationParse)
+       << " events/s" << endl;
+  return 0;
+}
@@ -0,0 +1,98 @@
+/// \file HoughTransform.h
+/// \brief Hough-transform track finder for TPC clusters
+/// \author Charis Kouzinopoulos
+
+#ifndef ALICEO2_HOUGH_HOUGHTRANSFORM_H
+#define ALICEO2_HOUGH_HOUGHTRANSFORM_H
+
+#include <vector>
+
+#include "DetectorsBase/Track.h"
+
+class TClonesArray;
+
+namespace AliceO2 {
+namespace Hough {
+
+/// \class HoughTransform
+/// \brief Conformal-mapping Hough transform producing TrackPar seeds
+///
+/// Space points are grouped per TPC sector (18 in azimuth per side) and
+/// rotated into the sector frame. The conformal mapping u=x/r^2, v=y/r^2
+/// turns circles through the origin into straight lines, so a track becomes
+/// a peak in the (psi, kappa) accumulator, where psi is the azimuth of the
+/// circle centre and kappa the signed curvature:
+///
+///   kappa = 2 * (u * cos(psi) + v * sin(psi))
+///
+/// The per-sector accumulators are filled by a pool of threads (one sector
+/// is never split between threads) and the fill loop is tiled over psi so
+/// the accumulator rows being written stay cache resident while the cluster
+/// arrays are streamed. A local-maximum search over the accumulators then
+/// converts every peak into an AliceO2::Base::Track::TrackPar seed at the
+/// inner radius of the TPC.
+class HoughTransform {
+public:
+  /// Constructor
+  /// @param nPsiBins Number of bins in the circle-centre azimuth psi
+  /// @param nKappaBins Number of bins in the signed curvature kappa
+  /// @param kappaMax Curvature range [-kappaMax, kappaMax] in 1/cm
+  /// @param bz Solenoid field in kGauss, used to express peaks as q/pT
+  HoughTransform(int nPsiBins = 180, int nKappaBins = 200, float kappaMax = 0.01f, float bz = 5.f);
+  ~HoughTransform() = default;
+
+  /// Add a single space point in the global frame; it is assigned to a
+  /// sector by azimuth and z side and stored in sector-local coordinates
+  void addSpacePoint(float x, float y, float z);
+
+  /// Load all clusters from a TClonesArray of AliceO2::TPC::Cluster, the
+  /// output format of ClusterContainer::FillOutputContainer. Pad/time
+  /// coordinates are converted with the TPCBase mapper geometry.
+  /// @return Number of accepted clusters
+  int loadClusters(const TClonesArray& clusters);
+
+  /// Fill the per-sector accumulators
+  /// @param numberOfThreads Worker threads, 0 uses the hardware concurrency
+  void transform(int numberOfThreads = 0);
+
+  /// Find accumulator peaks and convert them to track seeds
+  /// @param threshold Minimum number of clusters contributing to a peak
+  /// @return Track seeds at the TPC inner radius, in sector-frame alpha
+  std::vector<Base::Track::TrackPar> findPeaks(int threshold);
+
+  /// Drop all space points and clear the accumulators
+  void reset();
+
+  int getNumberOfSpacePoints() const;
+
+  /// Accumulator content of one bin, mainly for tests
+  int getAccumulatorBin(int sector, int psiBin, int kappaBin) const;
+
+private:
+  /// Space points of one sector in structure-of-arrays layout: the fill
+  /// loop streams u and v sequentially, one cache line at a time
+  struct SectorData {
+    std::vector<float> u;  ///< conformal x/r^2 in the sector frame
+    std::vector<float> v;  ///< conformal y/r^2 in the sector frame
+    std::vector<float> zr; ///< z over transverse radius, for the dip angle
+  };
+
+  void fillSector(int sector);
+  void findPeaksInSector(int sector, int threshold, std::vector<Base::Track::TrackPar>& seeds) const;
+
+  int mNPsiBins;    ///< bins in circle-centre azimuth
+  int mNKappaBins;  ///< bins in signed curvature
+  float mKappaMax;  ///< curvature range in 1/cm
+  float mBz;        ///< solenoid field in kGauss
+
+  std::vector<SectorData> mSectors;            ///< space points per sector
+  std::vector<std::vector<unsigned short>> mAccumulators; ///< per-sector (psi, kappa) counts
+  std::vector<std::vector<float>> mZrSums;     ///< per-bin sum of z/r, for the dip angle
+  std::vector<float> mCosPsi;                  ///< cos of the psi bin centres
+  std::vector<float> mSinPsi;                  ///< sin of the psi bin centres
+};
+
+}
+}
+
+#endif
@@ -1,7 +1,9 @@
 /// \file runHough.cxx
-/// \brief Implementation of a cluster loader
+/// \brief Cluster loader and entry point for the Hough-transform track finder
 /// \author Charis Kouzinopoulos
 
+#include "hough/HoughTransform.h"
+
 #include "AliHLTTPCTrackGeometry.h"
 #include "AliHLTTPCClusterDataFormat.h"
 #include "AliHLTTPCSpacePointContainer.h"
@@ -126,11 +128,16 @@ int processData(std::string dataPath, std::string dataType, std::string dataOrig
 
 int main(int argc, char** argv)
 {
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <event number>" << endl;
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <event number> [peak threshold]" << endl;
     std::exit(1);
   }
 
+  int peakThreshold = 40;
+  if (argc == 3) {
+    peakThreshold = std::stoi(argv[2]);
+  }
+
   // Create data path
   std::string dataFilename = "emulated-tpc-clusters/event";
   dataFilename += argv[1];
@@ -166,5 +173,21 @@ int main(int argc, char** argv)
 
   drawData(totalNumberOfClusters, dataFilename);
 
+  // Run the Hough transform on the loaded clusters and report the seeds
+  AliceO2::Hough::HoughTransform hough;
+  for (int i = 0; i < totalNumberOfClusters; i++) {
+    hough.addSpacePoint(clusterCoordinates[i * 4 + 1], clusterCoordinates[i * 4 + 2],
+                        clusterCoordinates[i * 4 + 3]);
+  }
+  hough.transform();
+  std::vector<AliceO2::Base::Track::TrackPar> seeds = hough.findPeaks(peakThreshold);
+
+  cout << "Found " << seeds.size() << " track seeds with at least " << peakThreshold
+       << " clusters per accumulator peak" << endl;
+
+  for (auto& seed : seeds) {
+    seed.PrintParam();
+  }
+
   return 0;
 }
@@ -0,0 +1,329 @@
+/// \file HoughTransform.cxx
+/// \brief Implementation of the Hough-transform track finder
+/// \author Charis Kouzinopoulos
+
+#include "hough/HoughTransform.h"
+
+#include "DetectorsBase/Constants.h"
+#include "DetectorsBase/Utils.h"
+#include "TPCBase/CRU.h"
+#include "TPCBase/Mapper.h"
+#include "TPCSimulation/Cluster.h"
+
+#include "TClonesArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace AliceO2::Hough;
+using namespace AliceO2::Base;
+using AliceO2::TPC::CRU;
+using AliceO2::TPC::Mapper;
+using AliceO2::TPC::PadRegionInfo;
+using AliceO2::TPC::Side;
+
+namespace {
+// sectors in azimuth per side, accumulators are kept per side as well
+constexpr int kSectorsPerSide = Constants::kNSectors;
+constexpr int kTotalSectors = 2 * kSectorsPerSide;
+
+// rotation angle of the sector frame, the sector centre azimuth in radians
+inline float sectorAlpha(int sector)
+{
+  return (sector % kSectorsPerSide + 0.5f) * (Constants::k2PI / kSectorsPerSide);
+}
+
+// psi band around pi/2: tracks from the origin cross their sector with a
+// local emission angle psi - pi/2 within +-45 degrees of the radial direction
+constexpr float kPsiMin = 0.25f * Constants::kPI;
+constexpr float kPsiMax = 0.75f * Constants::kPI;
+
+// psi rows processed per tile: the tile of accumulator rows written while
+// the cluster arrays are streamed fits in the first-level caches
+constexpr int kPsiTileSize = 32;
+
+// track seeds are expressed at the radius of the innermost pad row
+constexpr float kSeedRadius = 85.2f;
+
+// drift parameters, same values as used by the TPC digitizer
+constexpr float kDriftVelocity = 2.58f;         // cm/us
+constexpr float kZBinWidth = 0.19379844961f;    // us
+constexpr float kDriftLength = 250.f;           // cm
+}
+
+//________________________________________________________________________
+HoughTransform::HoughTransform(int nPsiBins, int nKappaBins, float kappaMax, float bz)
+  : mNPsiBins(nPsiBins),
+    mNKappaBins(nKappaBins),
+    mKappaMax(kappaMax),
+    mBz(bz),
+    mSectors(kTotalSectors),
+    mAccumulators(kTotalSectors),
+    mZrSums(kTotalSectors),
+    mCosPsi(nPsiBins),
+    mSinPsi(nPsiBins)
+{
+  const float psiBinWidth = (kPsiMax - kPsiMin) / mNPsiBins;
+  for (int psiBin = 0; psiBin < mNPsiBins; ++psiBin) {
+    const float psi = kPsiMin + (psiBin + 0.5f) * psiBinWidth;
+    mCosPsi[psiBin] = std::cos(psi);
+    mSinPsi[psiBin] = std::sin(psi);
+  }
+}
+
+//________________________________________________________________________
+void HoughTransform::addSpacePoint(float x, float y, float z)
+{
+  const float r2 = x * x + y * y;
+  if (r2 < Constants::kAlmost0) {
+    return;
+  }
+
+  float phi = std::atan2(y, x);
+  Utils::BringTo02Pi(phi);
+  const int sectorInPhi = Utils::Angle2Sector(phi);
+  const float alpha = sectorAlpha(sectorInPhi);
+  float sn, cs;
+  Utils::sincosf(alpha, sn, cs);
+
+  // rotate into the sector frame, then apply the conformal mapping
+  const float lx = x * cs + y * sn;
+  const float ly = -x * sn + y * cs;
+
+  SectorData& sector = mSectors[sectorInPhi + (z < 0.f ? kSectorsPerSide : 0)];
+  sector.u.push_back(lx / r2);
+  sector.v.push_back(ly / r2);
+  sector.zr.push_back(z / std::sqrt(r2));
+}
+
+//________________________________________________________________________
+int HoughTransform::loadClusters(const TClonesArray& clusters)
+{
+  const Mapper& mapper = Mapper::instance();
+  int accepted = 0;
+
+  for (int i = 0; i < clusters.GetEntriesFast(); ++i) {
+    const auto* cluster = static_cast<const AliceO2::TPC::Cluster*>(clusters.At(i));
+    if (cluster == nullptr) {
+      continue;
+    }
+
+    const CRU cru(cluster->getCRU());
+    const PadRegionInfo& region = mapper.getPadRegionInfo(cru.region());
+    const int row = cluster->getRow();
+    if (row < 0 || row >= region.getNumberOfPadRows()) {
+      continue;
+    }
+
+    // pad/time to sector-local position, inverting the conventions of
+    // Digitizer::getPadResponse and Digitizer::getTime
+    const float lx = region.getRadiusFirstRow() + (row + 0.5f) * region.getPadHeight();
+    const int padsInRow = region.getPadsInRowRegion(row);
+    const float localYfactor = (cru.side() == Side::A) ? -1.f : 1.f;
+    const float ly = (padsInRow / 2.f * region.getPadWidth() -
+                      cluster->getPadMean() * region.getPadWidth()) / localYfactor;
+
+    const float driftLength = kDriftLength - cluster->getTimeMean() * kZBinWidth * kDriftVelocity;
+    if (driftLength < 0.f || driftLength > kDriftLength) {
+      continue;
+    }
+    const float z = (cru.side() == Side::A) ? driftLength : -driftLength;
+
+    const float r2 = lx * lx + ly * ly;
+    SectorData& sector = mSectors[cru.sector().getSector() % kSectorsPerSide +
+                                  ((cru.side() == Side::A) ? 0 : kSectorsPerSide)];
+    sector.u.push_back(lx / r2);
+    sector.v.push_back(ly / r2);
+    sector.zr.push_back(z / std::sqrt(r2));
+    ++accepted;
+  }
+
+  return accepted;
+}
+
+//________________________________________________________________________
+void HoughTransform::fillSector(int sector)
+{
+  const SectorData& data = mSectors[sector];
+  if (data.u.empty()) {
+    return;
+  }
+
+  std::vector<unsigned short>& counts = mAccumulators[sector];
+  std::vector<float>& zrSums = mZrSums[sector];
+  counts.assign(mNPsiBins * mNKappaBins, 0);
+  zrSums.assign(mNPsiBins * mNKappaBins, 0.f);
+
+  const float invKappaBinWidth = mNKappaBins / (2.f * mKappaMax);
+  const size_t numberOfPoints = data.u.size();
+
+  // tile the psi rows: only kPsiTileSize accumulator rows are written while
+  // the u/v/zr arrays stream through sequentially
+  for (int tileStart = 0; tileStart < mNPsiBins; tileStart += kPsiTileSize) {
+    const int tileEnd = std::min(tileStart + kPsiTileSize, mNPsiBins);
+
+    for (size_t point = 0; point < numberOfPoints; ++point) {
+      const float u = data.u[point];
+      const float v = data.v[point];
+      const float zr = data.zr[point];
+
+      for (int psiBin = tileStart; psiBin < tileEnd; ++psiBin) {
+        const float kappa = 2.f * (u * mCosPsi[psiBin] + v * mSinPsi[psiBin]);
+        const int kappaBin = static_cast<int>((kappa + mKappaMax) * invKappaBinWidth);
+        if (kappaBin < 0 || kappaBin >= mNKappaBins) {
+          continue;
+        }
+        const int bin = psiBin * mNKappaBins + kappaBin;
+        ++counts[bin];
+        zrSums[bin] += zr;
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+void HoughTransform::transform(int numberOfThreads)
+{
+  if (numberOfThreads <= 0) {
+    numberOfThreads = std::thread::hardware_concurrency();
+  }
+  numberOfThreads = std::max(1, std::min(numberOfThreads, kTotalSectors));
+
+  // one sector is filled by exactly one thread, so the accumulators need no
+  // synchronization; the threads walk the sectors with a fixed stride
+  std::vector<std::thread> threads;
+  for (int threadNdx = 0; threadNdx < numberOfThreads; ++threadNdx) {
+    threads.emplace_back([this, threadNdx, numberOfThreads]() {
+      for (int sector = threadNdx; sector < kTotalSectors; sector += numberOfThreads) {
+        fillSector(sector);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+//________________________________________________________________________
+void HoughTransform::findPeaksInSector(int sector, int threshold,
+                                       std::vector<Track::TrackPar>& seeds) const
+{
+  const std::vector<unsigned short>& counts = mAccumulators[sector];
+  if (counts.empty()) {
+    return;
+  }
+  const std::vector<float>& zrSums = mZrSums[sector];
+
+  const float psiBinWidth = (kPsiMax - kPsiMin) / mNPsiBins;
+  const float kappaBinWidth = 2.f * mKappaMax / mNKappaBins;
+  const float alpha = sectorAlpha(sector);
+
+  for (int psiBin = 1; psiBin < mNPsiBins - 1; ++psiBin) {
+    for (int kappaBin = 1; kappaBin < mNKappaBins - 1; ++kappaBin) {
+      const int bin = psiBin * mNKappaBins + kappaBin;
+      const unsigned short value = counts[bin];
+      if (value < threshold) {
+        continue;
+      }
+
+      // local maximum over the 8 neighbours, plateaus are resolved towards
+      // the lowest bin index
+      if (value <= counts[bin - mNKappaBins - 1] || value <= counts[bin - mNKappaBins] ||
+          value <= counts[bin - mNKappaBins + 1] || value <= counts[bin - 1] ||
+          value < counts[bin + 1] || value < counts[bin + mNKappaBins - 1] ||
+          value < counts[bin + mNKappaBins] || value < counts[bin + mNKappaBins + 1]) {
+        continue;
+      }
+
+      const float kappa = -mKappaMax + (kappaBin + 0.5f) * kappaBinWidth;
+      const float tgl = zrSums[bin] / value;
+      const float x = kSeedRadius;
+      float y, snp;
+
+      if (std::abs(kappa) < 1e-6f) {
+        // straight line through the origin at azimuth psi - pi/2
+        const float phi0 = kPsiMin + (psiBin + 0.5f) * psiBinWidth - Constants::kPIHalf;
+        y = x * std::tan(phi0);
+        snp = std::sin(phi0);
+      } else {
+        // circle through the origin with centre (cos(psi), sin(psi))/kappa;
+        // of the two intersections with x = kSeedRadius take the one closer
+        // to the origin, the tangent there gives the local direction
+        const float a = mCosPsi[psiBin] / kappa;
+        const float b = mSinPsi[psiBin] / kappa;
+        const float radius = 1.f / std::abs(kappa);
+        const float discriminant = radius * radius - (x - a) * (x - a);
+        if (discriminant < 0.f) {
+          continue; // the circle turns back before the seed radius
+        }
+        const float root = std::sqrt(discriminant);
+        y = (std::abs(b - root) < std::abs(b + root)) ? b - root : b + root;
+
+        float tx = -(y - b);
+        float ty = x - a;
+        if (tx < 0.f) {
+          tx = -tx;
+          ty = -ty;
+        }
+        snp = ty / radius;
+      }
+
+      if (std::abs(y) > x || std::abs(snp) >= Constants::kAlmost1) {
+        continue;
+      }
+
+      // z via the straight-line approximation of the arc length, adequate
+      // for a seed that is refit anyway
+      const float z = tgl * std::sqrt(x * x + y * y);
+      const float q2pt = kappa / (mBz * Constants::kB2C);
+
+      seeds.emplace_back(x, alpha, std::array<float, Track::kNParams>{{y, z, snp, tgl, q2pt}});
+    }
+  }
+}
+
+//________________________________________________________________________
+std::vector<Track::TrackPar> HoughTransform::findPeaks(int threshold)
+{
+  std::vector<Track::TrackPar> seeds;
+  for (int sector = 0; sector < kTotalSectors; ++sector) {
+    findPeaksInSector(sector, threshold, seeds);
+  }
+  return seeds;
+}
+
+//________________________________________________________________________
+void HoughTransform::reset()
+{
+  for (int sector = 0; sector < kTotalSectors; ++sector) {
+    mSectors[sector].u.clear();
+    mSectors[sector].v.clear();
+    mSectors[sector].zr.clear();
+    mAccumulators[sector].clear();
+    mZrSums[sector].clear();
+  }
+}
+
+//________________________________________________________________________
+int HoughTransform::getNumberOfSpacePoints() const
+{
+  int numberOfPoints = 0;
+  for (const auto& sector : mSectors) {
+    numberOfPoints += sector.u.size();
+  }
+  return numberOfPoints;
+}
+
+//________________________________________________________________________
+int HoughTransform::getAccumulatorBin(int sector, int psiBin, int kappaBin) const
+{
+  if (sector < 0 || sector >= kTotalSectors || mAccumulators[sector].empty()) {
+    return 0;
+  }
+  if (psiBin < 0 || psiBin >= mNPsiBins || kappaBin < 0 || kappaBin >= mNKappaBins) {
+    return 0;
+  }
+  return mAccumulators[sector][psiBin * mNKappaBins + kappaBin];
+}
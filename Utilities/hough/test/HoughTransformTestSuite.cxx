@@ -0,0 +1,77 @@
+#define BOOST_TEST_MODULE HoughTransform
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+#include "hough/HoughTransform.h"
+
+using namespace AliceO2;
+
+namespace
+{
+  const float KAPPA = 0.004f;       // 1/cm, about 0.375 GeV at 5 kGauss
+  const float PSI = 1.65f;          // circle centre azimuth in the sector frame
+  const float TGL = 0.3f;
+  const float SECTOR_ALPHA = 4.5f * 2.f * M_PI / 18.f;
+  const float INNER_RADIUS = 85.f;
+  const float OUTER_RADIUS = 240.f;
+}
+
+BOOST_AUTO_TEST_SUITE(HoughTransformTestSuite)
+
+BOOST_AUTO_TEST_CASE(findSeedFromSyntheticTrack)
+{
+  Hough::HoughTransform hough;
+
+  // clusters along a circle through the origin, rotated into the global frame
+  const float a = std::cos(PSI) / KAPPA;
+  const float b = std::sin(PSI) / KAPPA;
+  const float radius = 1.f / KAPPA;
+  const float theta0 = std::atan2(-b, -a);
+
+  int generated = 0;
+  for (int i = 1; i <= 400; ++i) {
+    const float theta = theta0 + 0.004f * i;
+    const float lx = a + radius * std::cos(theta);
+    const float ly = b + radius * std::sin(theta);
+    const float r = std::sqrt(lx * lx + ly * ly);
+    if (r < INNER_RADIUS || r > OUTER_RADIUS) {
+      continue;
+    }
+
+    hough.addSpacePoint(lx * std::cos(SECTOR_ALPHA) - ly * std::sin(SECTOR_ALPHA),
+                        lx * std::sin(SECTOR_ALPHA) + ly * std::cos(SECTOR_ALPHA), TGL * r);
+    ++generated;
+  }
+
+  BOOST_CHECK_EQUAL(hough.getNumberOfSpacePoints(), generated);
+
+  hough.transform(4);
+  auto seeds = hough.findPeaks(generated / 2);
+
+  BOOST_REQUIRE_EQUAL(seeds.size(), 1);
+
+  // q/pT of the peak has to match the generated curvature at bin precision
+  const float expectedQ2Pt = KAPPA / (5.f * Base::Constants::kB2C);
+  BOOST_CHECK_CLOSE(seeds[0].GetQ2Pt(), expectedQ2Pt, 5.);
+  BOOST_CHECK_CLOSE(seeds[0].GetTgl(), TGL, 5.);
+}
+
+BOOST_AUTO_TEST_CASE(noSeedsWithoutSpacePoints)
+{
+  Hough::HoughTransform hough;
+
+  hough.transform(2);
+  BOOST_CHECK(hough.findPeaks(1).empty());
+
+  // a single point may not form a peak either
+  hough.addSpacePoint(100.f, 10.f, 20.f);
+  hough.transform(2);
+  BOOST_CHECK(hough.findPeaks(2).empty());
+
+  hough.reset();
+  BOOST_CHECK_EQUAL(hough.getNumberOfSpacePoints(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
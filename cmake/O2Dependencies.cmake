@@ -116,6 +116,7 @@ o2_define_bucket(
     ${OPTIONAL_DDS_LIBRARIES}
     Base
     Headers
+    MemoryArena
     FairTools
     FairMQ
     fairmq_logger
@@ -125,6 +126,7 @@ o2_define_bucket(
     INCLUDE_DIRECTORIES
     ${FAIRROOT_INCLUDE_DIR}
     ${OPTIONAL_DDS_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -150,6 +152,11 @@ o2_define_bucket(
     ${OPTIONAL_DDS_LIBRARIES}
     Base
     Headers
+    TimeFrameBuilder
+    EventLog
+    Instrumentation
+    O2Device
+    MemoryArena
     FairTools
     FairMQ
     fairmq_logger
@@ -159,6 +166,12 @@ o2_define_bucket(
     INCLUDE_DIRECTORIES
     ${FAIRROOT_INCLUDE_DIR}
     ${OPTIONAL_DDS_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Utilities/TimeFrameBuilder/include
+    ${CMAKE_SOURCE_DIR}/Utilities/EventLog/include
+    ${CMAKE_SOURCE_DIR}/Common/Instrumentation/include
+    ${CMAKE_SOURCE_DIR}/Utilities/O2Device/include
+    ${CMAKE_SOURCE_DIR}/Utilities/DataCompression/include
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -212,6 +225,7 @@ o2_define_bucket(
     Base
     FairTools
     ParBase
+    MemoryArena
     FairMQ ParMQ
     fairmq_logger pthread Core Tree XMLParser Hist Net RIO z
 
@@ -220,6 +234,7 @@ o2_define_bucket(
     ${ROOT_INCLUDE_DIR}
     ${PROTOBUF_INCLUDE_DIR}
     ${ZMQ_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -278,6 +293,10 @@ o2_define_bucket(
     DEPENDENCIES
     fairroot_base_bucket
     root_physics_bucket
+    MemoryArena
+
+    INCLUDE_DIRECTORIES
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -366,12 +385,14 @@ o2_define_bucket(
     ITSBase
     DetectorsBase
     SimulationDataFormat
+    MemoryArena
 
     INCLUDE_DIRECTORIES
     ${CMAKE_SOURCE_DIR}/Detectors/Base/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/common/base/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/common/simulation/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/ITS/base/include
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -385,6 +406,7 @@ o2_define_bucket(
     ITSBase
     ITSSimulation
     DetectorsBase
+    Instrumentation
 
     INCLUDE_DIRECTORIES
     ${CMAKE_SOURCE_DIR}/Detectors/Base/include
@@ -392,6 +414,7 @@ o2_define_bucket(
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/common/reconstruction/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/ITS/base/include
     ${CMAKE_SOURCE_DIR}/Detectors/ITSMFT/ITS/simulation/include
+    ${CMAKE_SOURCE_DIR}/Common/Instrumentation/include
 )
 
 o2_define_bucket(
@@ -425,6 +448,7 @@ o2_define_bucket(
     FairMQ
     fairmq_logger
     pthread
+    MemoryArena
     ${Boost_DATE_TIME_LIBRARY}
     ${OPTIONAL_DDS_LIBRARIES}
 
@@ -433,6 +457,7 @@ o2_define_bucket(
     ${ROOT_INCLUDE_DIR}
     ${FAIRROOT_INCLUDE_DIR}
     ${ZMQ_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
 )
 
 o2_define_bucket(
@@ -517,11 +542,32 @@ o2_define_bucket(
     TPCBase
     DetectorsBase
     SimulationDataFormat
+    MemoryArena
     ${GENERATORS_LIBRARY}
 
     INCLUDE_DIRECTORIES
     ${FAIRROOT_INCLUDE_DIR}
     ${CMAKE_SOURCE_DIR}/Detectors/Base/include
+    ${CMAKE_SOURCE_DIR}/Common/MathUtils/include
+    ${CMAKE_SOURCE_DIR}/Utilities/DataCompression/include
+    ${CMAKE_SOURCE_DIR}/Common/MemoryArena/include
+)
+
+o2_define_bucket(
+    NAME
+    tpc_reconstruction_bucket
+
+    DEPENDENCIES
+    root_base_bucket
+    fairroot_base_bucket
+    MathCore
+    RIO
+    TPCBase
+    TPCSimulation
+
+    INCLUDE_DIRECTORIES
+    ${FAIRROOT_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Detectors/TPC/simulation/include
 )
 
 o2_define_bucket(
@@ -575,6 +621,82 @@ o2_define_bucket(
 
     INCLUDE_DIRECTORIES
     ${ROOT_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Detectors/Base/include
+)
+
+o2_define_bucket(
+    NAME
+    concurrency_bucket
+
+    DEPENDENCIES
+    common_boost_bucket
+    pthread
+
+    INCLUDE_DIRECTORIES
+)
+
+o2_define_bucket(
+    NAME
+    instrumentation_bucket
+
+    DEPENDENCIES
+    common_boost_bucket
+    pthread
+
+    INCLUDE_DIRECTORIES
+)
+
+o2_define_bucket(
+    NAME
+    timeframe_builder_bucket
+
+    DEPENDENCIES
+    common_boost_bucket
+
+    INCLUDE_DIRECTORIES
+)
+
+o2_define_bucket(
+    NAME
+    event_log_bucket
+
+    DEPENDENCIES
+    common_boost_bucket
+    pthread
+
+    INCLUDE_DIRECTORIES
+)
+
+o2_define_bucket(
+    NAME
+    file_merger_bucket
+
+    DEPENDENCIES
+    root_base_bucket
+    common_boost_bucket
+    RIO Tree Hist # ROOT
+    pthread
+
+    INCLUDE_DIRECTORIES
+)
+
+o2_define_bucket(
+    NAME
+    hough_transform_bucket
+
+    DEPENDENCIES
+    root_base_bucket
+    common_boost_bucket
+    DetectorsBase
+    TPCBase
+    TPCSimulation
+    pthread
+
+    INCLUDE_DIRECTORIES
+    ${FAIRROOT_INCLUDE_DIR}
+    ${CMAKE_SOURCE_DIR}/Detectors/Base/include
+    ${CMAKE_SOURCE_DIR}/Detectors/TPC/base/include
+    ${CMAKE_SOURCE_DIR}/Detectors/TPC/simulation/include
 )
 
 o2_define_bucket(